@@ -0,0 +1,556 @@
+
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+#ifndef AW_APPROX_H
+#define AW_APPROX_H
+
+#include "aw-arith.h"
+#include "aw-simd.h"
+
+#if defined(__GNUC__)
+# define _approx_alwaysinline __attribute__((always_inline)) inline
+#elif defined(_MSC_VER)
+# define _approx_alwaysinline __forceinline
+#endif
+
+/* Reciprocal square root estimates have 8 bits on NEON and 12 bits
+   elsewhere; each Newton step doubles that. */
+#if defined(__ARM_NEON) || defined(_M_ARM64) || defined(_M_ARM64EC)
+# define _approx_rsqrt_steps 2
+#else
+# define _approx_rsqrt_steps 1
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Polynomial approximations of the elementary functions for f32, f32x4 and
+   f32x8 (AVX2 builds). They have no branches or table lookups; quadrants,
+   octants and exponents are picked with masks. Each function comes in two
+   tiers, and the errors below bound the largest found against libm in
+   double precision, with and without FMA contraction:
+
+                         default             fast prefix
+     sin, cos, sincos    1.5 ulp, 9e-8 abs   1.4e-5 abs
+     exp2, exp           1.2 ulp             1.1e-4 rel
+     flog2, log          2 ulp, 1e-7 abs     3.5e-5 abs
+     atan2               2.3 ulp             2.6e-4 rel
+     invsqrt             5 ulp               3.3e-4 rel (1.8e-3 without SSE)
+     pow                 2.8e-6 rel          4.4e-4 rel
+
+   The ulp bounds for sin and cos hold for |x| <= pi, while the absolute
+   bounds hold up to |x| = 8192, past which the reduction by multiples of
+   pi/2 (TWO_OVER_PI) slowly loses bits. The absolute bound of flog2 and log
+   holds for x in [0.5, 2], where the result is near zero. exp2 and exp
+   return denormals and infinity at the ends of the range. flog2, log and
+   pow require x > 0 and invsqrt a positive normal x; the invsqrt bounds
+   come from every such x and depend on the estimate of the CPU. pow is
+   exp2(y * flog2(x)) and its bounds are for |y| <= 16 and
+   |y * log2(x)| <= 33; past that pow loses bits with the size of the
+   product and fastpow with the size of y. NaN inputs give unspecified
+   results. flog2 is named apart from log2_f32, which returns the
+   exponent. */
+
+_approx_alwaysinline static u32 _approx_bits(f32 a) { union { f32 f; u32 u; } t; t.f = a; return t.u; }
+_approx_alwaysinline static f32 _approx_float(u32 a) { union { f32 f; u32 u; } t; t.u = a; return t.f; }
+
+/* f32 */
+_approx_alwaysinline static void _approx_sincos_f32(f32 x, f32 *s, f32 *c, bool fast) {
+	s32 q = round_f32(x * TWO_OVER_PI);
+	f32 qf = (f32) q;
+	f32 r = x - qf * 1.5703125f - qf * 4.837512969970703125e-4f - qf * 7.54978995489188216e-8f;
+	f32 z = r * r;
+	f32 ps, pc;
+	u32 swap, sb, cb;
+	if (fast) {
+		ps = z * 0.008163282f - 0.1666339f;
+		pc = (z * 0.04045845f - 0.49976056f) * z + 1.f;
+	} else {
+		ps = (z * -1.9515295891e-4f + 8.3321608736e-3f) * z - 1.6666654611e-1f;
+		pc = (((z * 2.443315711809948e-5f - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z - .5f) * z + 1.f;
+	}
+	ps = ps * z * r + r;
+	swap = -((u32) q & 1);
+	sb = (_approx_bits(pc) & swap) | (_approx_bits(ps) & ~swap);
+	cb = (_approx_bits(ps) & swap) | (_approx_bits(pc) & ~swap);
+	*s = _approx_float(sb ^ ((u32) q & 2) << 30);
+	*c = _approx_float(cb ^ ((u32) (q + 1) & 2) << 30);
+}
+
+_approx_alwaysinline static f32 _approx_exp2_f32(f32 x, bool fast) {
+	s32 n, h;
+	f32 f, p;
+	x = clamp_f32(x, -150.f, 128.f);
+	n = round_f32(x);
+	f = x - (f32) n;
+	if (fast)
+		p = ((f * 0.05500890f + 0.24221097f) * f + 0.69328293f) * f + 1.f;
+	else
+		p = (((((f * 1.535336188319500e-4f + 1.339887440266574e-3f) * f + 9.618437357674640e-3f) * f +
+			5.550332471162809e-2f) * f + 2.402264791363012e-1f) * f + 6.931472028550421e-1f) * f + 1.f;
+	h = n >> 1;
+	return p * _approx_float((u32) (h + 127) << 23) * _approx_float((u32) (n - h + 127) << 23);
+}
+
+_approx_alwaysinline static f32 _approx_exp_f32(f32 x, bool fast) {
+	s32 n, h;
+	f32 r, p;
+	if (fast)
+		return _approx_exp2_f32(x * LOG2_E, true);
+	x = clamp_f32(x, -104.f, 89.f);
+	n = round_f32(x * LOG2_E);
+	r = x - (f32) n * 0.693359375f + (f32) n * 2.12194440e-4f;
+	p = (((((r * 1.9875691500e-4f + 1.3981999507e-3f) * r + 8.3334519073e-3f) * r +
+		4.1665795894e-2f) * r + 1.6666665459e-1f) * r + 5.0000001201e-1f) * r * r + r + 1.f;
+	h = n >> 1;
+	return p * _approx_float((u32) (h + 127) << 23) * _approx_float((u32) (n - h + 127) << 23);
+}
+
+/* Splits x into 2^e * m with m in [sqrt(1/2), sqrt(2)) and returns
+   ln(m) = ln(1 + t). */
+_approx_alwaysinline static f32 _approx_logm_f32(f32 x, s32 *e, bool fast) {
+	u32 i = _approx_bits(x);
+	s32 k = (s32) (i - 0x3f3504f3) >> 23;
+	f32 t = _approx_float(i - ((u32) k << 23)) - 1.f;
+	f32 z = t * t;
+	f32 p;
+	*e = k;
+	if (fast)
+		return ((((t * 0.17840473f - 0.26991400f) * t + 0.33570733f) * t - 0.49953595f) * z) + t;
+	p = (((((((t * 7.0376836292e-2f - 1.1514610310e-1f) * t + 1.1676998740e-1f) * t - 1.2420140846e-1f) * t +
+		1.4249322787e-1f) * t - 1.6668057665e-1f) * t + 2.0000714765e-1f) * t - 2.4999993993e-1f) * t + 3.3333331174e-1f;
+	return (t * z * p - .5f * z) + t;
+}
+
+_approx_alwaysinline static f32 _approx_flog2_f32(f32 x, bool fast) {
+	s32 e;
+	f32 m = _approx_logm_f32(x, &e, fast);
+	return m * LOG2_E + (f32) e;
+}
+
+_approx_alwaysinline static f32 _approx_log_f32(f32 x, bool fast) {
+	s32 e;
+	f32 m = _approx_logm_f32(x, &e, fast);
+	return (m - (f32) e * 2.12194440e-4f) + (f32) e * 0.693359375f;
+}
+
+_approx_alwaysinline static f32 _approx_atan2_f32(f32 y, f32 x, bool fast) {
+	f32 ax = abs_f32(x);
+	f32 ay = abs_f32(y);
+	f32 a = min_f32(ax, ay) / max_f32(max_f32(ax, ay), 1.17549435e-38f);
+	f32 z = a * a;
+	f32 p, r;
+	if (fast)
+		p = (z * -0.04649618f + 0.15931381f) * z - 0.32762264f;
+	else
+		p = ((((((z * 0.0029206805f - 0.016367883f) * z + 0.043211792f) * z - 0.075522089f) * z +
+			0.10666002f) * z - 0.14211055f) * z + 0.19993773f) * z - 0.33333153f;
+	r = p * z * a + a;
+	r = _approx_float(sel_u32(_approx_bits(ax - ay), _approx_bits(r), _approx_bits(HALF_PI - r)));
+	r = _approx_float(sel_u32(_approx_bits(x), _approx_bits(r), _approx_bits(PI - r)));
+	return _approx_float(_approx_bits(r) ^ (_approx_bits(y) & 0x80000000u));
+}
+
+_approx_alwaysinline static f32 _approx_invsqrt_f32(f32 x, bool fast) {
+#if defined(_arith_sse2)
+	f32 r = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+	if (!fast)
+		r = r * (1.5f - .5f * x * r * r);
+#else
+	f32 r = _approx_float(0x5f375a86 - (_approx_bits(x) >> 1));
+	r = r * (1.5f - .5f * x * r * r);
+	if (!fast) {
+		r = r * (1.5f - .5f * x * r * r);
+		r = r * (1.5f - .5f * x * r * r);
+	}
+#endif
+	return r;
+}
+
+_approx_alwaysinline static void sincos_f32(f32 x, f32 *s, f32 *c) { _approx_sincos_f32(x, s, c, false); }
+_approx_alwaysinline static f32 sin_f32(f32 x) { f32 s, c; _approx_sincos_f32(x, &s, &c, false); return s; }
+_approx_alwaysinline static f32 cos_f32(f32 x) { f32 s, c; _approx_sincos_f32(x, &s, &c, false); return c; }
+_approx_alwaysinline static f32 exp2_f32(f32 x) { return _approx_exp2_f32(x, false); }
+_approx_alwaysinline static f32 exp_f32(f32 x) { return _approx_exp_f32(x, false); }
+_approx_alwaysinline static f32 flog2_f32(f32 x) { return _approx_flog2_f32(x, false); }
+_approx_alwaysinline static f32 log_f32(f32 x) { return _approx_log_f32(x, false); }
+_approx_alwaysinline static f32 atan2_f32(f32 y, f32 x) { return _approx_atan2_f32(y, x, false); }
+_approx_alwaysinline static f32 invsqrt_f32(f32 x) { return _approx_invsqrt_f32(x, false); }
+_approx_alwaysinline static f32 pow_f32(f32 x, f32 y) { return _approx_exp2_f32(y * _approx_flog2_f32(x, false), false); }
+
+_approx_alwaysinline static void fastsincos_f32(f32 x, f32 *s, f32 *c) { _approx_sincos_f32(x, s, c, true); }
+_approx_alwaysinline static f32 fastsin_f32(f32 x) { f32 s, c; _approx_sincos_f32(x, &s, &c, true); return s; }
+_approx_alwaysinline static f32 fastcos_f32(f32 x) { f32 s, c; _approx_sincos_f32(x, &s, &c, true); return c; }
+_approx_alwaysinline static f32 fastexp2_f32(f32 x) { return _approx_exp2_f32(x, true); }
+_approx_alwaysinline static f32 fastexp_f32(f32 x) { return _approx_exp_f32(x, true); }
+_approx_alwaysinline static f32 fastflog2_f32(f32 x) { return _approx_flog2_f32(x, true); }
+_approx_alwaysinline static f32 fastlog_f32(f32 x) { return _approx_log_f32(x, true); }
+_approx_alwaysinline static f32 fastatan2_f32(f32 y, f32 x) { return _approx_atan2_f32(y, x, true); }
+_approx_alwaysinline static f32 fastinvsqrt_f32(f32 x) { return _approx_invsqrt_f32(x, true); }
+_approx_alwaysinline static f32 fastpow_f32(f32 x, f32 y) { return _approx_exp2_f32(y * _approx_flog2_f32(x, true), true); }
+
+/* f32x4 */
+#if defined(_have_simd_ops)
+_approx_alwaysinline static f32x4 _approx_flipsign_f32x4(f32x4 a, u32x4 sign) { return bits_to_f32x4(xor_u32x4(f32x4_to_bits(a), sign)); }
+
+_approx_alwaysinline static f32x4 _approx_pow2i_f32x4(u32x4 n) { return bits_to_f32x4(sll_u32x4(add_u32x4(n, set1_u32x4(127)), 23)); }
+
+_approx_alwaysinline static void _approx_sincos_f32x4(f32x4 x, f32x4 *s, f32x4 *c, bool fast) {
+	u32x4 q = round_f32x4(mul_f32x4(x, set1_f32x4(TWO_OVER_PI)));
+	f32x4 qf = s32x4_to_f32x4(q);
+	f32x4 r = madd_f32x4(qf, set1_f32x4(-1.5703125f), x);
+	f32x4 z, ps, pc;
+	u32x4 swap;
+	r = madd_f32x4(qf, set1_f32x4(-4.837512969970703125e-4f), r);
+	r = madd_f32x4(qf, set1_f32x4(-7.54978995489188216e-8f), r);
+	z = mul_f32x4(r, r);
+	if (fast) {
+		ps = madd_f32x4(z, set1_f32x4(0.008163282f), set1_f32x4(-0.1666339f));
+		pc = madd_f32x4(z, set1_f32x4(0.04045845f), set1_f32x4(-0.49976056f));
+		pc = madd_f32x4(z, pc, set1_f32x4(1.f));
+	} else {
+		ps = madd_f32x4(z, set1_f32x4(-1.9515295891e-4f), set1_f32x4(8.3321608736e-3f));
+		ps = madd_f32x4(z, ps, set1_f32x4(-1.6666654611e-1f));
+		pc = madd_f32x4(z, set1_f32x4(2.443315711809948e-5f), set1_f32x4(-1.388731625493765e-3f));
+		pc = madd_f32x4(z, pc, set1_f32x4(4.166664568298827e-2f));
+		pc = madd_f32x4(z, pc, set1_f32x4(-.5f));
+		pc = madd_f32x4(z, pc, set1_f32x4(1.f));
+	}
+	ps = madd_f32x4(mul_f32x4(ps, z), r, r);
+	swap = sub_u32x4(zero_u32x4(), and_u32x4(q, set1_u32x4(1)));
+	*s = _approx_flipsign_f32x4(blend_f32x4(swap, pc, ps), sll_u32x4(and_u32x4(q, set1_u32x4(2)), 30));
+	*c = _approx_flipsign_f32x4(blend_f32x4(swap, ps, pc), sll_u32x4(and_u32x4(add_u32x4(q, set1_u32x4(1)), set1_u32x4(2)), 30));
+}
+
+_approx_alwaysinline static f32x4 _approx_scale_f32x4(f32x4 p, u32x4 n) {
+	u32x4 h = sra_u32x4(n, 1);
+	return mul_f32x4(mul_f32x4(p, _approx_pow2i_f32x4(h)), _approx_pow2i_f32x4(sub_u32x4(n, h)));
+}
+
+_approx_alwaysinline static f32x4 _approx_exp2_f32x4(f32x4 x, bool fast) {
+	u32x4 n;
+	f32x4 f, p;
+	x = clamp_f32x4(x, set1_f32x4(-150.f), set1_f32x4(128.f));
+	n = round_f32x4(x);
+	f = sub_f32x4(x, s32x4_to_f32x4(n));
+	if (fast) {
+		p = madd_f32x4(f, set1_f32x4(0.05500890f), set1_f32x4(0.24221097f));
+		p = madd_f32x4(f, p, set1_f32x4(0.69328293f));
+	} else {
+		p = madd_f32x4(f, set1_f32x4(1.535336188319500e-4f), set1_f32x4(1.339887440266574e-3f));
+		p = madd_f32x4(f, p, set1_f32x4(9.618437357674640e-3f));
+		p = madd_f32x4(f, p, set1_f32x4(5.550332471162809e-2f));
+		p = madd_f32x4(f, p, set1_f32x4(2.402264791363012e-1f));
+		p = madd_f32x4(f, p, set1_f32x4(6.931472028550421e-1f));
+	}
+	return _approx_scale_f32x4(madd_f32x4(f, p, set1_f32x4(1.f)), n);
+}
+
+_approx_alwaysinline static f32x4 _approx_exp_f32x4(f32x4 x, bool fast) {
+	u32x4 n;
+	f32x4 nf, r, p;
+	if (fast)
+		return _approx_exp2_f32x4(mul_f32x4(x, set1_f32x4(LOG2_E)), true);
+	x = clamp_f32x4(x, set1_f32x4(-104.f), set1_f32x4(89.f));
+	n = round_f32x4(mul_f32x4(x, set1_f32x4(LOG2_E)));
+	nf = s32x4_to_f32x4(n);
+	r = madd_f32x4(nf, set1_f32x4(-0.693359375f), x);
+	r = madd_f32x4(nf, set1_f32x4(2.12194440e-4f), r);
+	p = madd_f32x4(r, set1_f32x4(1.9875691500e-4f), set1_f32x4(1.3981999507e-3f));
+	p = madd_f32x4(r, p, set1_f32x4(8.3334519073e-3f));
+	p = madd_f32x4(r, p, set1_f32x4(4.1665795894e-2f));
+	p = madd_f32x4(r, p, set1_f32x4(1.6666665459e-1f));
+	p = madd_f32x4(r, p, set1_f32x4(5.0000001201e-1f));
+	p = add_f32x4(madd_f32x4(mul_f32x4(p, r), r, r), set1_f32x4(1.f));
+	return _approx_scale_f32x4(p, n);
+}
+
+_approx_alwaysinline static f32x4 _approx_logm_f32x4(f32x4 x, u32x4 *e, bool fast) {
+	u32x4 i = f32x4_to_bits(x);
+	u32x4 k = sra_u32x4(sub_u32x4(i, set1_u32x4(0x3f3504f3)), 23);
+	f32x4 t = sub_f32x4(bits_to_f32x4(sub_u32x4(i, sll_u32x4(k, 23))), set1_f32x4(1.f));
+	f32x4 z = mul_f32x4(t, t);
+	f32x4 p;
+	*e = k;
+	if (fast) {
+		p = madd_f32x4(t, set1_f32x4(0.17840473f), set1_f32x4(-0.26991400f));
+		p = madd_f32x4(t, p, set1_f32x4(0.33570733f));
+		p = madd_f32x4(t, p, set1_f32x4(-0.49953595f));
+		return madd_f32x4(p, z, t);
+	}
+	p = madd_f32x4(t, set1_f32x4(7.0376836292e-2f), set1_f32x4(-1.1514610310e-1f));
+	p = madd_f32x4(t, p, set1_f32x4(1.1676998740e-1f));
+	p = madd_f32x4(t, p, set1_f32x4(-1.2420140846e-1f));
+	p = madd_f32x4(t, p, set1_f32x4(1.4249322787e-1f));
+	p = madd_f32x4(t, p, set1_f32x4(-1.6668057665e-1f));
+	p = madd_f32x4(t, p, set1_f32x4(2.0000714765e-1f));
+	p = madd_f32x4(t, p, set1_f32x4(-2.4999993993e-1f));
+	p = madd_f32x4(t, p, set1_f32x4(3.3333331174e-1f));
+	return add_f32x4(madd_f32x4(z, set1_f32x4(-.5f), mul_f32x4(mul_f32x4(t, z), p)), t);
+}
+
+_approx_alwaysinline static f32x4 _approx_flog2_f32x4(f32x4 x, bool fast) {
+	u32x4 e;
+	f32x4 m = _approx_logm_f32x4(x, &e, fast);
+	return madd_f32x4(m, set1_f32x4(LOG2_E), s32x4_to_f32x4(e));
+}
+
+_approx_alwaysinline static f32x4 _approx_log_f32x4(f32x4 x, bool fast) {
+	u32x4 e;
+	f32x4 m = _approx_logm_f32x4(x, &e, fast);
+	f32x4 ef = s32x4_to_f32x4(e);
+	return madd_f32x4(ef, set1_f32x4(0.693359375f), madd_f32x4(ef, set1_f32x4(-2.12194440e-4f), m));
+}
+
+_approx_alwaysinline static f32x4 _approx_atan2_f32x4(f32x4 y, f32x4 x, bool fast) {
+	f32x4 ax = abs_f32x4(x);
+	f32x4 ay = abs_f32x4(y);
+	f32x4 a = div_f32x4(min_f32x4(ax, ay), max_f32x4(max_f32x4(ax, ay), set1_f32x4(1.17549435e-38f)));
+	f32x4 z = mul_f32x4(a, a);
+	f32x4 p, r;
+	if (fast) {
+		p = madd_f32x4(z, set1_f32x4(-0.04649618f), set1_f32x4(0.15931381f));
+		p = madd_f32x4(z, p, set1_f32x4(-0.32762264f));
+	} else {
+		p = madd_f32x4(z, set1_f32x4(0.0029206805f), set1_f32x4(-0.016367883f));
+		p = madd_f32x4(z, p, set1_f32x4(0.043211792f));
+		p = madd_f32x4(z, p, set1_f32x4(-0.075522089f));
+		p = madd_f32x4(z, p, set1_f32x4(0.10666002f));
+		p = madd_f32x4(z, p, set1_f32x4(-0.14211055f));
+		p = madd_f32x4(z, p, set1_f32x4(0.19993773f));
+		p = madd_f32x4(z, p, set1_f32x4(-0.33333153f));
+	}
+	r = madd_f32x4(mul_f32x4(p, z), a, a);
+	r = blend_f32x4(cmpgt_f32x4(ay, ax), sub_f32x4(set1_f32x4(HALF_PI), r), r);
+	r = blend_f32x4(sra_u32x4(f32x4_to_bits(x), 31), sub_f32x4(set1_f32x4(PI), r), r);
+	return _approx_flipsign_f32x4(r, and_u32x4(f32x4_to_bits(y), set1_u32x4(0x80000000u)));
+}
+
+_approx_alwaysinline static f32x4 _approx_invsqrt_f32x4(f32x4 x, bool fast) {
+	f32x4 h = mul_f32x4(x, set1_f32x4(-.5f));
+	f32x4 r = rsqrt_f32x4(x);
+	int i;
+	for (i = fast; i < _approx_rsqrt_steps; ++i)
+		r = mul_f32x4(r, madd_f32x4(mul_f32x4(h, r), r, set1_f32x4(1.5f)));
+	return r;
+}
+
+_approx_alwaysinline static void sincos_f32x4(f32x4 x, f32x4 *s, f32x4 *c) { _approx_sincos_f32x4(x, s, c, false); }
+_approx_alwaysinline static f32x4 sin_f32x4(f32x4 x) { f32x4 s, c; _approx_sincos_f32x4(x, &s, &c, false); return s; }
+_approx_alwaysinline static f32x4 cos_f32x4(f32x4 x) { f32x4 s, c; _approx_sincos_f32x4(x, &s, &c, false); return c; }
+_approx_alwaysinline static f32x4 exp2_f32x4(f32x4 x) { return _approx_exp2_f32x4(x, false); }
+_approx_alwaysinline static f32x4 exp_f32x4(f32x4 x) { return _approx_exp_f32x4(x, false); }
+_approx_alwaysinline static f32x4 flog2_f32x4(f32x4 x) { return _approx_flog2_f32x4(x, false); }
+_approx_alwaysinline static f32x4 log_f32x4(f32x4 x) { return _approx_log_f32x4(x, false); }
+_approx_alwaysinline static f32x4 atan2_f32x4(f32x4 y, f32x4 x) { return _approx_atan2_f32x4(y, x, false); }
+_approx_alwaysinline static f32x4 invsqrt_f32x4(f32x4 x) { return _approx_invsqrt_f32x4(x, false); }
+_approx_alwaysinline static f32x4 pow_f32x4(f32x4 x, f32x4 y) { return _approx_exp2_f32x4(mul_f32x4(y, _approx_flog2_f32x4(x, false)), false); }
+
+_approx_alwaysinline static void fastsincos_f32x4(f32x4 x, f32x4 *s, f32x4 *c) { _approx_sincos_f32x4(x, s, c, true); }
+_approx_alwaysinline static f32x4 fastsin_f32x4(f32x4 x) { f32x4 s, c; _approx_sincos_f32x4(x, &s, &c, true); return s; }
+_approx_alwaysinline static f32x4 fastcos_f32x4(f32x4 x) { f32x4 s, c; _approx_sincos_f32x4(x, &s, &c, true); return c; }
+_approx_alwaysinline static f32x4 fastexp2_f32x4(f32x4 x) { return _approx_exp2_f32x4(x, true); }
+_approx_alwaysinline static f32x4 fastexp_f32x4(f32x4 x) { return _approx_exp_f32x4(x, true); }
+_approx_alwaysinline static f32x4 fastflog2_f32x4(f32x4 x) { return _approx_flog2_f32x4(x, true); }
+_approx_alwaysinline static f32x4 fastlog_f32x4(f32x4 x) { return _approx_log_f32x4(x, true); }
+_approx_alwaysinline static f32x4 fastatan2_f32x4(f32x4 y, f32x4 x) { return _approx_atan2_f32x4(y, x, true); }
+_approx_alwaysinline static f32x4 fastinvsqrt_f32x4(f32x4 x) { return _approx_invsqrt_f32x4(x, true); }
+_approx_alwaysinline static f32x4 fastpow_f32x4(f32x4 x, f32x4 y) { return _approx_exp2_f32x4(mul_f32x4(y, _approx_flog2_f32x4(x, true)), true); }
+#endif /* defined(_have_simd_ops) */
+
+/* f32x8 */
+#if defined(_have_simd_ops_256) && defined(__AVX2__)
+_approx_alwaysinline static f32x8 _approx_flipsign_f32x8(f32x8 a, u32x8 sign) { return bits_to_f32x8(xor_u32x8(f32x8_to_bits(a), sign)); }
+
+_approx_alwaysinline static f32x8 _approx_pow2i_f32x8(u32x8 n) { return bits_to_f32x8(sll_u32x8(add_u32x8(n, set1_u32x8(127)), 23)); }
+
+_approx_alwaysinline static void _approx_sincos_f32x8(f32x8 x, f32x8 *s, f32x8 *c, bool fast) {
+	u32x8 q = round_f32x8(mul_f32x8(x, set1_f32x8(TWO_OVER_PI)));
+	f32x8 qf = s32x8_to_f32x8(q);
+	f32x8 r = madd_f32x8(qf, set1_f32x8(-1.5703125f), x);
+	f32x8 z, ps, pc;
+	u32x8 swap;
+	r = madd_f32x8(qf, set1_f32x8(-4.837512969970703125e-4f), r);
+	r = madd_f32x8(qf, set1_f32x8(-7.54978995489188216e-8f), r);
+	z = mul_f32x8(r, r);
+	if (fast) {
+		ps = madd_f32x8(z, set1_f32x8(0.008163282f), set1_f32x8(-0.1666339f));
+		pc = madd_f32x8(z, set1_f32x8(0.04045845f), set1_f32x8(-0.49976056f));
+		pc = madd_f32x8(z, pc, set1_f32x8(1.f));
+	} else {
+		ps = madd_f32x8(z, set1_f32x8(-1.9515295891e-4f), set1_f32x8(8.3321608736e-3f));
+		ps = madd_f32x8(z, ps, set1_f32x8(-1.6666654611e-1f));
+		pc = madd_f32x8(z, set1_f32x8(2.443315711809948e-5f), set1_f32x8(-1.388731625493765e-3f));
+		pc = madd_f32x8(z, pc, set1_f32x8(4.166664568298827e-2f));
+		pc = madd_f32x8(z, pc, set1_f32x8(-.5f));
+		pc = madd_f32x8(z, pc, set1_f32x8(1.f));
+	}
+	ps = madd_f32x8(mul_f32x8(ps, z), r, r);
+	swap = sub_u32x8(zero_u32x8(), and_u32x8(q, set1_u32x8(1)));
+	*s = _approx_flipsign_f32x8(blend_f32x8(swap, pc, ps), sll_u32x8(and_u32x8(q, set1_u32x8(2)), 30));
+	*c = _approx_flipsign_f32x8(blend_f32x8(swap, ps, pc), sll_u32x8(and_u32x8(add_u32x8(q, set1_u32x8(1)), set1_u32x8(2)), 30));
+}
+
+_approx_alwaysinline static f32x8 _approx_scale_f32x8(f32x8 p, u32x8 n) {
+	u32x8 h = sra_u32x8(n, 1);
+	return mul_f32x8(mul_f32x8(p, _approx_pow2i_f32x8(h)), _approx_pow2i_f32x8(sub_u32x8(n, h)));
+}
+
+_approx_alwaysinline static f32x8 _approx_exp2_f32x8(f32x8 x, bool fast) {
+	u32x8 n;
+	f32x8 f, p;
+	x = clamp_f32x8(x, set1_f32x8(-150.f), set1_f32x8(128.f));
+	n = round_f32x8(x);
+	f = sub_f32x8(x, s32x8_to_f32x8(n));
+	if (fast) {
+		p = madd_f32x8(f, set1_f32x8(0.05500890f), set1_f32x8(0.24221097f));
+		p = madd_f32x8(f, p, set1_f32x8(0.69328293f));
+	} else {
+		p = madd_f32x8(f, set1_f32x8(1.535336188319500e-4f), set1_f32x8(1.339887440266574e-3f));
+		p = madd_f32x8(f, p, set1_f32x8(9.618437357674640e-3f));
+		p = madd_f32x8(f, p, set1_f32x8(5.550332471162809e-2f));
+		p = madd_f32x8(f, p, set1_f32x8(2.402264791363012e-1f));
+		p = madd_f32x8(f, p, set1_f32x8(6.931472028550421e-1f));
+	}
+	return _approx_scale_f32x8(madd_f32x8(f, p, set1_f32x8(1.f)), n);
+}
+
+_approx_alwaysinline static f32x8 _approx_exp_f32x8(f32x8 x, bool fast) {
+	u32x8 n;
+	f32x8 nf, r, p;
+	if (fast)
+		return _approx_exp2_f32x8(mul_f32x8(x, set1_f32x8(LOG2_E)), true);
+	x = clamp_f32x8(x, set1_f32x8(-104.f), set1_f32x8(89.f));
+	n = round_f32x8(mul_f32x8(x, set1_f32x8(LOG2_E)));
+	nf = s32x8_to_f32x8(n);
+	r = madd_f32x8(nf, set1_f32x8(-0.693359375f), x);
+	r = madd_f32x8(nf, set1_f32x8(2.12194440e-4f), r);
+	p = madd_f32x8(r, set1_f32x8(1.9875691500e-4f), set1_f32x8(1.3981999507e-3f));
+	p = madd_f32x8(r, p, set1_f32x8(8.3334519073e-3f));
+	p = madd_f32x8(r, p, set1_f32x8(4.1665795894e-2f));
+	p = madd_f32x8(r, p, set1_f32x8(1.6666665459e-1f));
+	p = madd_f32x8(r, p, set1_f32x8(5.0000001201e-1f));
+	p = add_f32x8(madd_f32x8(mul_f32x8(p, r), r, r), set1_f32x8(1.f));
+	return _approx_scale_f32x8(p, n);
+}
+
+_approx_alwaysinline static f32x8 _approx_logm_f32x8(f32x8 x, u32x8 *e, bool fast) {
+	u32x8 i = f32x8_to_bits(x);
+	u32x8 k = sra_u32x8(sub_u32x8(i, set1_u32x8(0x3f3504f3)), 23);
+	f32x8 t = sub_f32x8(bits_to_f32x8(sub_u32x8(i, sll_u32x8(k, 23))), set1_f32x8(1.f));
+	f32x8 z = mul_f32x8(t, t);
+	f32x8 p;
+	*e = k;
+	if (fast) {
+		p = madd_f32x8(t, set1_f32x8(0.17840473f), set1_f32x8(-0.26991400f));
+		p = madd_f32x8(t, p, set1_f32x8(0.33570733f));
+		p = madd_f32x8(t, p, set1_f32x8(-0.49953595f));
+		return madd_f32x8(p, z, t);
+	}
+	p = madd_f32x8(t, set1_f32x8(7.0376836292e-2f), set1_f32x8(-1.1514610310e-1f));
+	p = madd_f32x8(t, p, set1_f32x8(1.1676998740e-1f));
+	p = madd_f32x8(t, p, set1_f32x8(-1.2420140846e-1f));
+	p = madd_f32x8(t, p, set1_f32x8(1.4249322787e-1f));
+	p = madd_f32x8(t, p, set1_f32x8(-1.6668057665e-1f));
+	p = madd_f32x8(t, p, set1_f32x8(2.0000714765e-1f));
+	p = madd_f32x8(t, p, set1_f32x8(-2.4999993993e-1f));
+	p = madd_f32x8(t, p, set1_f32x8(3.3333331174e-1f));
+	return add_f32x8(madd_f32x8(z, set1_f32x8(-.5f), mul_f32x8(mul_f32x8(t, z), p)), t);
+}
+
+_approx_alwaysinline static f32x8 _approx_flog2_f32x8(f32x8 x, bool fast) {
+	u32x8 e;
+	f32x8 m = _approx_logm_f32x8(x, &e, fast);
+	return madd_f32x8(m, set1_f32x8(LOG2_E), s32x8_to_f32x8(e));
+}
+
+_approx_alwaysinline static f32x8 _approx_log_f32x8(f32x8 x, bool fast) {
+	u32x8 e;
+	f32x8 m = _approx_logm_f32x8(x, &e, fast);
+	f32x8 ef = s32x8_to_f32x8(e);
+	return madd_f32x8(ef, set1_f32x8(0.693359375f), madd_f32x8(ef, set1_f32x8(-2.12194440e-4f), m));
+}
+
+_approx_alwaysinline static f32x8 _approx_atan2_f32x8(f32x8 y, f32x8 x, bool fast) {
+	f32x8 ax = abs_f32x8(x);
+	f32x8 ay = abs_f32x8(y);
+	f32x8 a = div_f32x8(min_f32x8(ax, ay), max_f32x8(max_f32x8(ax, ay), set1_f32x8(1.17549435e-38f)));
+	f32x8 z = mul_f32x8(a, a);
+	f32x8 p, r;
+	if (fast) {
+		p = madd_f32x8(z, set1_f32x8(-0.04649618f), set1_f32x8(0.15931381f));
+		p = madd_f32x8(z, p, set1_f32x8(-0.32762264f));
+	} else {
+		p = madd_f32x8(z, set1_f32x8(0.0029206805f), set1_f32x8(-0.016367883f));
+		p = madd_f32x8(z, p, set1_f32x8(0.043211792f));
+		p = madd_f32x8(z, p, set1_f32x8(-0.075522089f));
+		p = madd_f32x8(z, p, set1_f32x8(0.10666002f));
+		p = madd_f32x8(z, p, set1_f32x8(-0.14211055f));
+		p = madd_f32x8(z, p, set1_f32x8(0.19993773f));
+		p = madd_f32x8(z, p, set1_f32x8(-0.33333153f));
+	}
+	r = madd_f32x8(mul_f32x8(p, z), a, a);
+	r = blend_f32x8(cmpgt_f32x8(ay, ax), sub_f32x8(set1_f32x8(HALF_PI), r), r);
+	r = blend_f32x8(sra_u32x8(f32x8_to_bits(x), 31), sub_f32x8(set1_f32x8(PI), r), r);
+	return _approx_flipsign_f32x8(r, and_u32x8(f32x8_to_bits(y), set1_u32x8(0x80000000u)));
+}
+
+_approx_alwaysinline static f32x8 _approx_invsqrt_f32x8(f32x8 x, bool fast) {
+	f32x8 h = mul_f32x8(x, set1_f32x8(-.5f));
+	f32x8 r = rsqrt_f32x8(x);
+	int i;
+	for (i = fast; i < _approx_rsqrt_steps; ++i)
+		r = mul_f32x8(r, madd_f32x8(mul_f32x8(h, r), r, set1_f32x8(1.5f)));
+	return r;
+}
+
+_approx_alwaysinline static void sincos_f32x8(f32x8 x, f32x8 *s, f32x8 *c) { _approx_sincos_f32x8(x, s, c, false); }
+_approx_alwaysinline static f32x8 sin_f32x8(f32x8 x) { f32x8 s, c; _approx_sincos_f32x8(x, &s, &c, false); return s; }
+_approx_alwaysinline static f32x8 cos_f32x8(f32x8 x) { f32x8 s, c; _approx_sincos_f32x8(x, &s, &c, false); return c; }
+_approx_alwaysinline static f32x8 exp2_f32x8(f32x8 x) { return _approx_exp2_f32x8(x, false); }
+_approx_alwaysinline static f32x8 exp_f32x8(f32x8 x) { return _approx_exp_f32x8(x, false); }
+_approx_alwaysinline static f32x8 flog2_f32x8(f32x8 x) { return _approx_flog2_f32x8(x, false); }
+_approx_alwaysinline static f32x8 log_f32x8(f32x8 x) { return _approx_log_f32x8(x, false); }
+_approx_alwaysinline static f32x8 atan2_f32x8(f32x8 y, f32x8 x) { return _approx_atan2_f32x8(y, x, false); }
+_approx_alwaysinline static f32x8 invsqrt_f32x8(f32x8 x) { return _approx_invsqrt_f32x8(x, false); }
+_approx_alwaysinline static f32x8 pow_f32x8(f32x8 x, f32x8 y) { return _approx_exp2_f32x8(mul_f32x8(y, _approx_flog2_f32x8(x, false)), false); }
+
+_approx_alwaysinline static void fastsincos_f32x8(f32x8 x, f32x8 *s, f32x8 *c) { _approx_sincos_f32x8(x, s, c, true); }
+_approx_alwaysinline static f32x8 fastsin_f32x8(f32x8 x) { f32x8 s, c; _approx_sincos_f32x8(x, &s, &c, true); return s; }
+_approx_alwaysinline static f32x8 fastcos_f32x8(f32x8 x) { f32x8 s, c; _approx_sincos_f32x8(x, &s, &c, true); return c; }
+_approx_alwaysinline static f32x8 fastexp2_f32x8(f32x8 x) { return _approx_exp2_f32x8(x, true); }
+_approx_alwaysinline static f32x8 fastexp_f32x8(f32x8 x) { return _approx_exp_f32x8(x, true); }
+_approx_alwaysinline static f32x8 fastflog2_f32x8(f32x8 x) { return _approx_flog2_f32x8(x, true); }
+_approx_alwaysinline static f32x8 fastlog_f32x8(f32x8 x) { return _approx_log_f32x8(x, true); }
+_approx_alwaysinline static f32x8 fastatan2_f32x8(f32x8 y, f32x8 x) { return _approx_atan2_f32x8(y, x, true); }
+_approx_alwaysinline static f32x8 fastinvsqrt_f32x8(f32x8 x) { return _approx_invsqrt_f32x8(x, true); }
+_approx_alwaysinline static f32x8 fastpow_f32x8(f32x8 x, f32x8 y) { return _approx_exp2_f32x8(mul_f32x8(y, _approx_flog2_f32x8(x, true)), true); }
+#endif /* defined(_have_simd_ops_256) && defined(__AVX2__) */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* AW_APPROX_H */
+
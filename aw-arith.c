@@ -0,0 +1,729 @@
+
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+#include "aw-arith.h"
+#include "aw-simd.h"
+#include "aw-cpu.h"
+
+#if defined(__ARM_NEON) || defined(_M_ARM64) || defined(_M_ARM64EC)
+# include <arm_neon.h>
+# define _arith_neon 1
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64) || defined(_M_ARM64EC)
+# define _arith_a64 1
+#endif
+
+/* The largest float below 2^31, so clamped values convert without overflow. */
+#define ARITH_Q32_MAXF (2147483520.f)
+
+_arith_alwaysinline static q16 arith_f32_to_q16(f32 f, f32 scale) {
+	return (q16) round_f32(clamp_f32(f * scale, (f32) Q16_MIN, (f32) Q16_MAX));
+}
+
+_arith_alwaysinline static q32 arith_f32_to_q32(f32 f, f32 scale) {
+	return round_f32(clamp_f32(f * scale, (f32) Q32_MIN, ARITH_Q32_MAXF));
+}
+
+/* Kernels do whole vectors and return how many elements they did; the scalar
+   loops in the callers finish the tail. */
+typedef size_t (*arith_cvt_fn)(q32 *dst, const f32 *src, size_t count, f32 scale);
+typedef size_t (*arith_icvt_fn)(f32 *dst, const q32 *src, size_t count, f32 scale);
+typedef size_t (*arith_mul_fn)(q32 *dst, const q32 *x, const q32 *y, size_t count, s32 frac, bool sat);
+typedef size_t (*arith_round_fn)(s32 *dst, const f32 *src, size_t count, u32 mode);
+typedef size_t (*arith_fastdiv_fn)(u32 *dst, const u32 *src, size_t count, u32 mul, u32 shift, bool sgn, u32 dsign);
+
+enum {
+	ARITH_TRUNC,
+	ARITH_ROUND,
+	ARITH_FLOOR,
+	ARITH_CEIL,
+};
+
+#if defined(_cpu_dispatch_x86)
+_cpu_target("avx")
+static size_t arith_f32_to_q32_avx(q32 *dst, const f32 *src, size_t count, f32 scale) {
+	const __m256 s = _mm256_set1_ps(scale);
+	const __m256 lo = _mm256_set1_ps((f32) Q32_MIN);
+	const __m256 hi = _mm256_set1_ps(ARITH_Q32_MAXF);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256 v = _mm256_mul_ps(_mm256_loadu_ps(src + i), s);
+		v = _mm256_min_ps(_mm256_max_ps(v, lo), hi);
+		_mm256_storeu_si256((__m256i *) (dst + i), _mm256_cvtps_epi32(v));
+	}
+	return i;
+}
+
+_cpu_target("avx")
+static size_t arith_q32_to_f32_avx(f32 *dst, const q32 *src, size_t count, f32 scale) {
+	const __m256 s = _mm256_set1_ps(scale);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+		_mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(
+			_mm256_loadu_si256((const __m256i *) (src + i))), s));
+	return i;
+}
+
+_cpu_target("avx")
+static size_t arith_round_f32_avx(s32 *dst, const f32 *src, size_t count, u32 mode) {
+	size_t i = 0;
+	switch (mode) {
+	case ARITH_TRUNC:
+		for (; i + 8 <= count; i += 8)
+			_mm256_storeu_si256((__m256i *) (dst + i), _mm256_cvttps_epi32(_mm256_loadu_ps(src + i)));
+		break;
+	case ARITH_ROUND:
+		for (; i + 8 <= count; i += 8)
+			_mm256_storeu_si256((__m256i *) (dst + i), _mm256_cvtps_epi32(_mm256_loadu_ps(src + i)));
+		break;
+	case ARITH_FLOOR:
+		for (; i + 8 <= count; i += 8)
+			_mm256_storeu_si256((__m256i *) (dst + i), _mm256_cvttps_epi32(_mm256_floor_ps(_mm256_loadu_ps(src + i))));
+		break;
+	case ARITH_CEIL:
+		for (; i + 8 <= count; i += 8)
+			_mm256_storeu_si256((__m256i *) (dst + i), _mm256_cvttps_epi32(_mm256_ceil_ps(_mm256_loadu_ps(src + i))));
+		break;
+	}
+	return i;
+}
+
+/* The products are 64 bits wide. Their low 32 bits after a shift of at most
+   32 are the same for a logical and an arithmetic shift, so only saturation
+   needs the signed 64-bit compares. */
+_cpu_target("avx2")
+static size_t arith_mul_q32_avx2(q32 *dst, const q32 *x, const q32 *y, size_t count, s32 frac, bool sat) {
+	const __m128i shift = _mm_cvtsi32_si128(frac);
+	const __m256i lo = _mm256_set1_epi64x(-(imm_s64(1) << (31 + frac)));
+	const __m256i hi = _mm256_set1_epi64x((imm_s64(1) << (31 + frac)) - 1);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256i a = _mm256_loadu_si256((const __m256i *) (x + i));
+		__m256i b = _mm256_loadu_si256((const __m256i *) (y + i));
+		__m256i p0 = _mm256_mul_epi32(a, b);
+		__m256i p1 = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+		if (sat) {
+			p0 = _mm256_blendv_epi8(p0, hi, _mm256_cmpgt_epi64(p0, hi));
+			p0 = _mm256_blendv_epi8(p0, lo, _mm256_cmpgt_epi64(lo, p0));
+			p1 = _mm256_blendv_epi8(p1, hi, _mm256_cmpgt_epi64(p1, hi));
+			p1 = _mm256_blendv_epi8(p1, lo, _mm256_cmpgt_epi64(lo, p1));
+		}
+		p0 = _mm256_srl_epi64(p0, shift);
+		p1 = _mm256_slli_epi64(_mm256_srl_epi64(p1, shift), 32);
+		_mm256_storeu_si256((__m256i *) (dst + i), _mm256_blend_epi32(p0, p1, 0xaa));
+	}
+	return i;
+}
+
+_cpu_target("sse4.2")
+static size_t arith_mul_q32_sse42(q32 *dst, const q32 *x, const q32 *y, size_t count, s32 frac, bool sat) {
+	const __m128i shift = _mm_cvtsi32_si128(frac);
+	const __m128i lo = _mm_set1_epi64x(-(imm_s64(1) << (31 + frac)));
+	const __m128i hi = _mm_set1_epi64x((imm_s64(1) << (31 + frac)) - 1);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128i a = _mm_loadu_si128((const __m128i *) (x + i));
+		__m128i b = _mm_loadu_si128((const __m128i *) (y + i));
+		__m128i p0 = _mm_mul_epi32(a, b);
+		__m128i p1 = _mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+		if (sat) {
+			p0 = _mm_blendv_epi8(p0, hi, _mm_cmpgt_epi64(p0, hi));
+			p0 = _mm_blendv_epi8(p0, lo, _mm_cmpgt_epi64(lo, p0));
+			p1 = _mm_blendv_epi8(p1, hi, _mm_cmpgt_epi64(p1, hi));
+			p1 = _mm_blendv_epi8(p1, lo, _mm_cmpgt_epi64(lo, p1));
+		}
+		p0 = _mm_srl_epi64(p0, shift);
+		p1 = _mm_slli_epi64(_mm_srl_epi64(p1, shift), 32);
+		_mm_storeu_si128((__m128i *) (dst + i), _mm_blend_epi16(p0, p1, 0xcc));
+	}
+	return i;
+}
+
+/* The high halves of the even and odd lane products make the quotient
+   as (t + ((x - t) >> pre)) >> post, the 32-bit lanes form of fastdiv_u32.
+   Signed lanes divide their magnitude and take the sign of x ^ d. */
+_cpu_target("avx2")
+static size_t arith_fastdiv_avx2(u32 *dst, const u32 *src, size_t count, u32 mul, u32 shift, bool sgn, u32 dsign) {
+	const __m256i m = _mm256_set1_epi32((int) mul), odd = _mm256_set1_epi64x((s64) (~imm_u64(0) << 32));
+	const __m128i pre = _mm_cvtsi32_si128(shift != 0), post = _mm_cvtsi32_si128((int) shift - (shift != 0));
+	const __m256i ds = _mm256_set1_epi32((int) dsign);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256i x = _mm256_loadu_si256((const __m256i *) (src + i)), s = ds, t;
+		if (sgn) {
+			s = _mm256_srai_epi32(x, 31);
+			x = _mm256_sub_epi32(_mm256_xor_si256(x, s), s);
+			s = _mm256_xor_si256(s, ds);
+		}
+		t = _mm256_or_si256(_mm256_srli_epi64(_mm256_mul_epu32(x, m), 32),
+			_mm256_and_si256(_mm256_mul_epu32(_mm256_srli_epi64(x, 32), m), odd));
+		t = _mm256_srl_epi32(_mm256_add_epi32(t, _mm256_srl_epi32(_mm256_sub_epi32(x, t), pre)), post);
+		if (sgn)
+			t = _mm256_sub_epi32(_mm256_xor_si256(t, s), s);
+		_mm256_storeu_si256((__m256i *) (dst + i), t);
+	}
+	return i;
+}
+
+_cpu_target("sse2")
+static size_t arith_fastdiv_sse2(u32 *dst, const u32 *src, size_t count, u32 mul, u32 shift, bool sgn, u32 dsign) {
+	const __m128i m = _mm_set1_epi32((int) mul), odd = _mm_set_epi32(-1, 0, -1, 0);
+	const __m128i pre = _mm_cvtsi32_si128(shift != 0), post = _mm_cvtsi32_si128((int) shift - (shift != 0));
+	const __m128i ds = _mm_set1_epi32((int) dsign);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128i x = _mm_loadu_si128((const __m128i *) (src + i)), s = ds, t;
+		if (sgn) {
+			s = _mm_srai_epi32(x, 31);
+			x = _mm_sub_epi32(_mm_xor_si128(x, s), s);
+			s = _mm_xor_si128(s, ds);
+		}
+		t = _mm_or_si128(_mm_srli_epi64(_mm_mul_epu32(x, m), 32),
+			_mm_and_si128(_mm_mul_epu32(_mm_srli_epi64(x, 32), m), odd));
+		t = _mm_srl_epi32(_mm_add_epi32(t, _mm_srl_epi32(_mm_sub_epi32(x, t), pre)), post);
+		if (sgn)
+			t = _mm_sub_epi32(_mm_xor_si128(t, s), s);
+		_mm_storeu_si128((__m128i *) (dst + i), t);
+	}
+	return i;
+}
+
+static size_t arith_cvt_none(q32 *dst, const f32 *src, size_t count, f32 scale) {
+	(void) dst, (void) src, (void) count, (void) scale;
+	return 0;
+}
+
+static size_t arith_icvt_none(f32 *dst, const q32 *src, size_t count, f32 scale) {
+	(void) dst, (void) src, (void) count, (void) scale;
+	return 0;
+}
+
+static size_t arith_round_none(s32 *dst, const f32 *src, size_t count, u32 mode) {
+	(void) dst, (void) src, (void) count, (void) mode;
+	return 0;
+}
+
+static size_t arith_mul_none(q32 *dst, const q32 *x, const q32 *y, size_t count, s32 frac, bool sat) {
+	(void) dst, (void) x, (void) y, (void) count, (void) frac, (void) sat;
+	return 0;
+}
+
+static size_t arith_fastdiv_none(u32 *dst, const u32 *src, size_t count, u32 mul, u32 shift, bool sgn, u32 dsign) {
+	(void) dst, (void) src, (void) count, (void) mul, (void) shift, (void) sgn, (void) dsign;
+	return 0;
+}
+
+static size_t arith_f32_to_q32_resolve(q32 *dst, const f32 *src, size_t count, f32 scale);
+static size_t arith_q32_to_f32_resolve(f32 *dst, const q32 *src, size_t count, f32 scale);
+static size_t arith_mul_q32_resolve(q32 *dst, const q32 *x, const q32 *y, size_t count, s32 frac, bool sat);
+static size_t arith_round_f32_resolve(s32 *dst, const f32 *src, size_t count, u32 mode);
+static _cpu_ptr(arith_cvt_fn) arith_f32_to_q32_kernel_ptr = arith_f32_to_q32_resolve;
+#define arith_f32_to_q32_kernel _cpu_load_ptr(arith_f32_to_q32_kernel_ptr)
+static _cpu_ptr(arith_icvt_fn) arith_q32_to_f32_kernel_ptr = arith_q32_to_f32_resolve;
+#define arith_q32_to_f32_kernel _cpu_load_ptr(arith_q32_to_f32_kernel_ptr)
+static _cpu_ptr(arith_mul_fn) arith_mul_q32_kernel_ptr = arith_mul_q32_resolve;
+#define arith_mul_q32_kernel _cpu_load_ptr(arith_mul_q32_kernel_ptr)
+static _cpu_ptr(arith_round_fn) arith_round_f32_kernel_ptr = arith_round_f32_resolve;
+#define arith_round_f32_kernel _cpu_load_ptr(arith_round_f32_kernel_ptr)
+static size_t arith_fastdiv_resolve(u32 *dst, const u32 *src, size_t count, u32 mul, u32 shift, bool sgn, u32 dsign);
+static _cpu_ptr(arith_fastdiv_fn) arith_fastdiv_kernel_ptr = arith_fastdiv_resolve;
+#define arith_fastdiv_kernel _cpu_load_ptr(arith_fastdiv_kernel_ptr)
+
+static size_t arith_f32_to_q32_resolve(q32 *dst, const f32 *src, size_t count, f32 scale) {
+	arith_cvt_fn fn = cpu_has(CPU_AVX) ? arith_f32_to_q32_avx : arith_cvt_none;
+	_cpu_store_ptr(arith_f32_to_q32_kernel_ptr, fn);
+	return fn(dst, src, count, scale);
+}
+
+static size_t arith_q32_to_f32_resolve(f32 *dst, const q32 *src, size_t count, f32 scale) {
+	arith_icvt_fn fn = cpu_has(CPU_AVX) ? arith_q32_to_f32_avx : arith_icvt_none;
+	_cpu_store_ptr(arith_q32_to_f32_kernel_ptr, fn);
+	return fn(dst, src, count, scale);
+}
+
+static size_t arith_mul_q32_resolve(q32 *dst, const q32 *x, const q32 *y, size_t count, s32 frac, bool sat) {
+	arith_mul_fn fn = arith_mul_none;
+	if (cpu_has(CPU_AVX2))
+		fn = arith_mul_q32_avx2;
+	else if (cpu_has(CPU_SSE42))
+		fn = arith_mul_q32_sse42;
+	_cpu_store_ptr(arith_mul_q32_kernel_ptr, fn);
+	return fn(dst, x, y, count, frac, sat);
+}
+
+static size_t arith_round_f32_resolve(s32 *dst, const f32 *src, size_t count, u32 mode) {
+	arith_round_fn fn = cpu_has(CPU_AVX) ? arith_round_f32_avx : arith_round_none;
+	_cpu_store_ptr(arith_round_f32_kernel_ptr, fn);
+	return fn(dst, src, count, mode);
+}
+
+static size_t arith_fastdiv_resolve(u32 *dst, const u32 *src, size_t count, u32 mul, u32 shift, bool sgn, u32 dsign) {
+	arith_fastdiv_fn fn = arith_fastdiv_none;
+	if (cpu_has(CPU_AVX2))
+		fn = arith_fastdiv_avx2;
+	else if (cpu_has(CPU_SSE2))
+		fn = arith_fastdiv_sse2;
+	_cpu_store_ptr(arith_fastdiv_kernel_ptr, fn);
+	return fn(dst, src, count, mul, shift, sgn, dsign);
+}
+#elif defined(_arith_neon)
+static size_t arith_mul_q32_kernel(q32 *dst, const q32 *x, const q32 *y, size_t count, s32 frac, bool sat) {
+	const int64x2_t shift = vdupq_n_s64(-frac);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		int32x4_t a = vld1q_s32(x + i);
+		int32x4_t b = vld1q_s32(y + i);
+		int64x2_t p0 = vshlq_s64(vmull_s32(vget_low_s32(a), vget_low_s32(b)), shift);
+		int64x2_t p1 = vshlq_s64(vmull_s32(vget_high_s32(a), vget_high_s32(b)), shift);
+		if (sat)
+			vst1q_s32(dst + i, vcombine_s32(vqmovn_s64(p0), vqmovn_s64(p1)));
+		else
+			vst1q_s32(dst + i, vcombine_s32(vmovn_s64(p0), vmovn_s64(p1)));
+	}
+	return i;
+}
+
+static size_t arith_fastdiv_kernel(u32 *dst, const u32 *src, size_t count, u32 mul, u32 shift, bool sgn, u32 dsign) {
+	const uint32x2_t m = vdup_n_u32(mul);
+	const int32x4_t pre = vdupq_n_s32(-(s32) (shift != 0)), post = vdupq_n_s32((s32) (shift != 0) - (s32) shift);
+	const uint32x4_t ds = vdupq_n_u32(dsign);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		uint32x4_t x = vld1q_u32(src + i), s = ds, t;
+		if (sgn) {
+			s = vreinterpretq_u32_s32(vshrq_n_s32(vreinterpretq_s32_u32(x), 31));
+			x = vsubq_u32(veorq_u32(x, s), s);
+			s = veorq_u32(s, ds);
+		}
+		t = vcombine_u32(vshrn_n_u64(vmull_u32(vget_low_u32(x), m), 32), vshrn_n_u64(vmull_u32(vget_high_u32(x), m), 32));
+		t = vshlq_u32(vaddq_u32(t, vshlq_u32(vsubq_u32(x, t), pre)), post);
+		if (sgn)
+			t = vsubq_u32(veorq_u32(t, s), s);
+		vst1q_u32(dst + i, t);
+	}
+	return i;
+}
+#endif
+
+static void arith_round_f32_array(s32 *dst, const f32 *src, size_t count, u32 mode) {
+	size_t i = 0;
+#if defined(_cpu_dispatch_x86)
+	i = arith_round_f32_kernel(dst, src, count, mode);
+#endif
+#if defined(_have_simd_ops)
+	for (; i + 4 <= count; i += 4) {
+		f32x4 v = loadu_f32x4(src + i);
+		u32x4 r;
+		switch (mode) {
+		case ARITH_TRUNC: r = trunc_f32x4(v); break;
+		case ARITH_ROUND: r = round_f32x4(v); break;
+		case ARITH_FLOOR: r = floor_f32x4(v); break;
+		default: r = ceil_f32x4(v); break;
+		}
+		storeu_u32x4((u32 *) (dst + i), r);
+	}
+#endif
+	for (; i < count; ++i) {
+		switch (mode) {
+		case ARITH_TRUNC: dst[i] = trunc_f32(src[i]); break;
+		case ARITH_ROUND: dst[i] = round_f32(src[i]); break;
+		case ARITH_FLOOR: dst[i] = floor_f32(src[i]); break;
+		default: dst[i] = ceil_f32(src[i]); break;
+		}
+	}
+}
+
+void trunc_f32_array(s32 *dst, const f32 *src, size_t count) { arith_round_f32_array(dst, src, count, ARITH_TRUNC); }
+void round_f32_array(s32 *dst, const f32 *src, size_t count) { arith_round_f32_array(dst, src, count, ARITH_ROUND); }
+void floor_f32_array(s32 *dst, const f32 *src, size_t count) { arith_round_f32_array(dst, src, count, ARITH_FLOOR); }
+void ceil_f32_array(s32 *dst, const f32 *src, size_t count) { arith_round_f32_array(dst, src, count, ARITH_CEIL); }
+
+/* q16 */
+void f32_to_q16_array(q16 *dst, const f32 *src, size_t count, s16 frac) {
+	const f32 scale = ldexpf(1.f, frac);
+	size_t i = 0;
+#if defined(_arith_sse2)
+	const __m128 s = _mm_set1_ps(scale);
+	const __m128 lo = _mm_set1_ps((f32) Q16_MIN);
+	const __m128 hi = _mm_set1_ps((f32) Q16_MAX);
+	for (; i + 8 <= count; i += 8) {
+		__m128 a = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i), s), lo), hi);
+		__m128 b = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i + 4), s), lo), hi);
+		_mm_storeu_si128((__m128i *) (dst + i), _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b)));
+	}
+#elif defined(_arith_neon) && defined(_arith_a64)
+	for (; i + 8 <= count; i += 8) {
+		int32x4_t a = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(src + i), scale));
+		int32x4_t b = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(src + i + 4), scale));
+		vst1q_s16(dst + i, vcombine_s16(vqmovn_s32(a), vqmovn_s32(b)));
+	}
+#endif
+	for (; i < count; ++i)
+		dst[i] = arith_f32_to_q16(src[i], scale);
+}
+
+void q16_to_f32_array(f32 *dst, const q16 *src, size_t count, s16 frac) {
+	const f32 scale = ldexpf(1.f, -frac);
+	size_t i = 0;
+#if defined(_arith_sse2)
+	const __m128 s = _mm_set1_ps(scale);
+	for (; i + 8 <= count; i += 8) {
+		__m128i v = _mm_loadu_si128((const __m128i *) (src + i));
+		__m128i a = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+		__m128i b = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+		_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(a), s));
+		_mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(b), s));
+	}
+#elif defined(_arith_neon)
+	for (; i + 8 <= count; i += 8) {
+		int16x8_t v = vld1q_s16(src + i);
+		vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), scale));
+		vst1q_f32(dst + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), scale));
+	}
+#endif
+	for (; i < count; ++i)
+		dst[i] = (f32) src[i] * scale;
+}
+
+void add_q16_array(q16 *dst, const q16 *x, const q16 *y, size_t count) {
+	size_t i = 0;
+#if defined(_arith_sse2)
+	for (; i + 8 <= count; i += 8)
+		_mm_storeu_si128((__m128i *) (dst + i), _mm_add_epi16(
+			_mm_loadu_si128((const __m128i *) (x + i)), _mm_loadu_si128((const __m128i *) (y + i))));
+#elif defined(_arith_neon)
+	for (; i + 8 <= count; i += 8)
+		vst1q_s16(dst + i, vaddq_s16(vld1q_s16(x + i), vld1q_s16(y + i)));
+#endif
+	for (; i < count; ++i)
+		dst[i] = add_q16(x[i], y[i]);
+}
+
+void sub_q16_array(q16 *dst, const q16 *x, const q16 *y, size_t count) {
+	size_t i = 0;
+#if defined(_arith_sse2)
+	for (; i + 8 <= count; i += 8)
+		_mm_storeu_si128((__m128i *) (dst + i), _mm_sub_epi16(
+			_mm_loadu_si128((const __m128i *) (x + i)), _mm_loadu_si128((const __m128i *) (y + i))));
+#elif defined(_arith_neon)
+	for (; i + 8 <= count; i += 8)
+		vst1q_s16(dst + i, vsubq_s16(vld1q_s16(x + i), vld1q_s16(y + i)));
+#endif
+	for (; i < count; ++i)
+		dst[i] = sub_q16(x[i], y[i]);
+}
+
+void addsat_q16_array(q16 *dst, const q16 *x, const q16 *y, size_t count) {
+	size_t i = 0;
+#if defined(_arith_sse2)
+	for (; i + 8 <= count; i += 8)
+		_mm_storeu_si128((__m128i *) (dst + i), _mm_adds_epi16(
+			_mm_loadu_si128((const __m128i *) (x + i)), _mm_loadu_si128((const __m128i *) (y + i))));
+#elif defined(_arith_neon)
+	for (; i + 8 <= count; i += 8)
+		vst1q_s16(dst + i, vqaddq_s16(vld1q_s16(x + i), vld1q_s16(y + i)));
+#endif
+	for (; i < count; ++i)
+		dst[i] = addsat_q16(x[i], y[i]);
+}
+
+void subsat_q16_array(q16 *dst, const q16 *x, const q16 *y, size_t count) {
+	size_t i = 0;
+#if defined(_arith_sse2)
+	for (; i + 8 <= count; i += 8)
+		_mm_storeu_si128((__m128i *) (dst + i), _mm_subs_epi16(
+			_mm_loadu_si128((const __m128i *) (x + i)), _mm_loadu_si128((const __m128i *) (y + i))));
+#elif defined(_arith_neon)
+	for (; i + 8 <= count; i += 8)
+		vst1q_s16(dst + i, vqsubq_s16(vld1q_s16(x + i), vld1q_s16(y + i)));
+#endif
+	for (; i < count; ++i)
+		dst[i] = subsat_q16(x[i], y[i]);
+}
+
+/* Full 32-bit products from the low and high halves, shifted and narrowed
+   either by truncation or with saturation. */
+static size_t arith_mul_q16(q16 *dst, const q16 *x, const q16 *y, size_t count, s16 frac, bool sat) {
+	size_t i = 0;
+#if defined(_arith_sse2)
+	const __m128i shift = _mm_cvtsi32_si128(frac);
+	for (; i + 8 <= count; i += 8) {
+		__m128i a = _mm_loadu_si128((const __m128i *) (x + i));
+		__m128i b = _mm_loadu_si128((const __m128i *) (y + i));
+		__m128i l = _mm_mullo_epi16(a, b);
+		__m128i h = _mm_mulhi_epi16(a, b);
+		__m128i p0 = _mm_sra_epi32(_mm_unpacklo_epi16(l, h), shift);
+		__m128i p1 = _mm_sra_epi32(_mm_unpackhi_epi16(l, h), shift);
+		if (!sat) {
+			p0 = _mm_srai_epi32(_mm_slli_epi32(p0, 16), 16);
+			p1 = _mm_srai_epi32(_mm_slli_epi32(p1, 16), 16);
+		}
+		_mm_storeu_si128((__m128i *) (dst + i), _mm_packs_epi32(p0, p1));
+	}
+#elif defined(_arith_neon)
+	const int32x4_t shift = vdupq_n_s32(-frac);
+	for (; i + 8 <= count; i += 8) {
+		int16x8_t a = vld1q_s16(x + i);
+		int16x8_t b = vld1q_s16(y + i);
+		int32x4_t p0 = vshlq_s32(vmull_s16(vget_low_s16(a), vget_low_s16(b)), shift);
+		int32x4_t p1 = vshlq_s32(vmull_s16(vget_high_s16(a), vget_high_s16(b)), shift);
+		if (sat)
+			vst1q_s16(dst + i, vcombine_s16(vqmovn_s32(p0), vqmovn_s32(p1)));
+		else
+			vst1q_s16(dst + i, vcombine_s16(vmovn_s32(p0), vmovn_s32(p1)));
+	}
+#endif
+	(void) x, (void) y, (void) frac, (void) sat;
+	return i;
+}
+
+void mul_q16_array(q16 *dst, const q16 *x, const q16 *y, size_t count, s16 frac) {
+	size_t i = arith_mul_q16(dst, x, y, count, frac, false);
+	for (; i < count; ++i)
+		dst[i] = mul_q16(x[i], y[i], frac);
+}
+
+void mulsat_q16_array(q16 *dst, const q16 *x, const q16 *y, size_t count, s16 frac) {
+	size_t i = arith_mul_q16(dst, x, y, count, frac, true);
+	for (; i < count; ++i)
+		dst[i] = mulsat_q16(x[i], y[i], frac);
+}
+
+/* None of the vector units divide integers; the loops are left to the
+   compiler. */
+void div_q16_array(q16 *dst, const q16 *x, const q16 *y, size_t count, s16 frac) {
+	size_t i;
+	for (i = 0; i < count; ++i)
+		dst[i] = div_q16(x[i], y[i], frac);
+}
+
+void divsat_q16_array(q16 *dst, const q16 *x, const q16 *y, size_t count, s16 frac) {
+	size_t i;
+	for (i = 0; i < count; ++i)
+		dst[i] = divsat_q16(x[i], y[i], frac);
+}
+
+/* q32 */
+void f32_to_q32_array(q32 *dst, const f32 *src, size_t count, s32 frac) {
+	const f32 scale = ldexpf(1.f, frac);
+	size_t i = 0;
+#if defined(_cpu_dispatch_x86)
+	i = arith_f32_to_q32_kernel(dst, src, count, scale);
+#endif
+#if defined(_have_simd_ops)
+	{
+		const f32x4 s = set1_f32x4(scale);
+		const f32x4 lo = set1_f32x4((f32) Q32_MIN);
+		const f32x4 hi = set1_f32x4(ARITH_Q32_MAXF);
+		for (; i + 4 <= count; i += 4)
+			storeu_u32x4((u32 *) (dst + i), round_f32x4(clamp_f32x4(mul_f32x4(loadu_f32x4(src + i), s), lo, hi)));
+	}
+#endif
+	for (; i < count; ++i)
+		dst[i] = arith_f32_to_q32(src[i], scale);
+}
+
+void q32_to_f32_array(f32 *dst, const q32 *src, size_t count, s32 frac) {
+	const f32 scale = ldexpf(1.f, -frac);
+	size_t i = 0;
+#if defined(_cpu_dispatch_x86)
+	i = arith_q32_to_f32_kernel(dst, src, count, scale);
+#endif
+#if defined(_have_simd_ops)
+	{
+		const f32x4 s = set1_f32x4(scale);
+		for (; i + 4 <= count; i += 4)
+			storeu_f32x4(dst + i, mul_f32x4(s32x4_to_f32x4(loadu_u32x4((const u32 *) (src + i))), s));
+	}
+#endif
+	for (; i < count; ++i)
+		dst[i] = (f32) src[i] * scale;
+}
+
+void add_q32_array(q32 *dst, const q32 *x, const q32 *y, size_t count) {
+	size_t i = 0;
+#if defined(_have_simd_ops)
+	for (; i + 4 <= count; i += 4)
+		storeu_u32x4((u32 *) (dst + i), add_u32x4(loadu_u32x4((const u32 *) (x + i)), loadu_u32x4((const u32 *) (y + i))));
+#endif
+	for (; i < count; ++i)
+		dst[i] = (q32) ((u32) x[i] + (u32) y[i]);
+}
+
+void sub_q32_array(q32 *dst, const q32 *x, const q32 *y, size_t count) {
+	size_t i = 0;
+#if defined(_have_simd_ops)
+	for (; i + 4 <= count; i += 4)
+		storeu_u32x4((u32 *) (dst + i), sub_u32x4(loadu_u32x4((const u32 *) (x + i)), loadu_u32x4((const u32 *) (y + i))));
+#endif
+	for (; i < count; ++i)
+		dst[i] = (q32) ((u32) x[i] - (u32) y[i]);
+}
+
+/* Overflow happened when the result sign differs from both operands (add) or
+   from the minuend where the operands differ (sub); such lanes take
+   Q32_MAX or Q32_MIN from the sign of x. */
+void addsat_q32_array(q32 *dst, const q32 *x, const q32 *y, size_t count) {
+	size_t i = 0;
+#if defined(_have_simd_ops)
+	const u32x4 max = set1_u32x4(Q32_MAX);
+	for (; i + 4 <= count; i += 4) {
+		u32x4 a = loadu_u32x4((const u32 *) (x + i));
+		u32x4 b = loadu_u32x4((const u32 *) (y + i));
+		u32x4 r = add_u32x4(a, b);
+		u32x4 o = sra_u32x4(and_u32x4(xor_u32x4(a, r), xor_u32x4(b, r)), 31);
+		storeu_u32x4((u32 *) (dst + i), blend_u32x4(o, xor_u32x4(sra_u32x4(a, 31), max), r));
+	}
+#endif
+	for (; i < count; ++i)
+		dst[i] = addsat_q32(x[i], y[i]);
+}
+
+void subsat_q32_array(q32 *dst, const q32 *x, const q32 *y, size_t count) {
+	size_t i = 0;
+#if defined(_have_simd_ops)
+	const u32x4 max = set1_u32x4(Q32_MAX);
+	for (; i + 4 <= count; i += 4) {
+		u32x4 a = loadu_u32x4((const u32 *) (x + i));
+		u32x4 b = loadu_u32x4((const u32 *) (y + i));
+		u32x4 r = sub_u32x4(a, b);
+		u32x4 o = sra_u32x4(and_u32x4(xor_u32x4(a, b), xor_u32x4(a, r)), 31);
+		storeu_u32x4((u32 *) (dst + i), blend_u32x4(o, xor_u32x4(sra_u32x4(a, 31), max), r));
+	}
+#endif
+	for (; i < count; ++i)
+		dst[i] = subsat_q32(x[i], y[i]);
+}
+
+void mul_q32_array(q32 *dst, const q32 *x, const q32 *y, size_t count, s32 frac) {
+	size_t i = 0;
+#if defined(_cpu_dispatch_x86) || defined(_arith_neon)
+	i = arith_mul_q32_kernel(dst, x, y, count, frac, false);
+#endif
+	for (; i < count; ++i)
+		dst[i] = mul_q32(x[i], y[i], frac);
+}
+
+void mulsat_q32_array(q32 *dst, const q32 *x, const q32 *y, size_t count, s32 frac) {
+	size_t i = 0;
+#if defined(_cpu_dispatch_x86) || defined(_arith_neon)
+	i = arith_mul_q32_kernel(dst, x, y, count, frac, true);
+#endif
+	for (; i < count; ++i)
+		dst[i] = mulsat_q32(x[i], y[i], frac);
+}
+
+void div_q32_array(q32 *dst, const q32 *x, const q32 *y, size_t count, s32 frac) {
+	size_t i;
+	for (i = 0; i < count; ++i)
+		dst[i] = div_q32(x[i], y[i], frac);
+}
+
+void divsat_q32_array(q32 *dst, const q32 *x, const q32 *y, size_t count, s32 frac) {
+	size_t i;
+	for (i = 0; i < count; ++i)
+		dst[i] = divsat_q32(x[i], y[i], frac);
+}
+
+/* q64 has no vector multiply or conversion short of AVX-512DQ, so these are
+   plain loops over the scalar helpers. */
+void f64_to_q64_array(q64 *dst, const f64 *src, size_t count, s64 frac) {
+	const f64 scale = ldexp(1., (int) frac);
+	size_t i;
+	for (i = 0; i < count; ++i) {
+		f64 v = src[i] * scale;
+		dst[i] = v >= 9223372036854775808. ? Q64_MAX : v < -9223372036854775808. ? Q64_MIN : round_f64(v);
+	}
+}
+
+void q64_to_f64_array(f64 *dst, const q64 *src, size_t count, s64 frac) {
+	const f64 scale = ldexp(1., (int) -frac);
+	size_t i;
+	for (i = 0; i < count; ++i)
+		dst[i] = (f64) src[i] * scale;
+}
+
+void add_q64_array(q64 *dst, const q64 *x, const q64 *y, size_t count) {
+	size_t i;
+	for (i = 0; i < count; ++i)
+		dst[i] = (q64) ((u64) x[i] + (u64) y[i]);
+}
+
+void sub_q64_array(q64 *dst, const q64 *x, const q64 *y, size_t count) {
+	size_t i;
+	for (i = 0; i < count; ++i)
+		dst[i] = (q64) ((u64) x[i] - (u64) y[i]);
+}
+
+void mul_q64_array(q64 *dst, const q64 *x, const q64 *y, size_t count, s64 frac) {
+	size_t i;
+	for (i = 0; i < count; ++i)
+		dst[i] = mul_q64(x[i], y[i], frac);
+}
+
+void div_q64_array(q64 *dst, const q64 *x, const q64 *y, size_t count, s64 frac) {
+	size_t i;
+	for (i = 0; i < count; ++i)
+		dst[i] = div_q64(x[i], y[i], frac);
+}
+
+void addsat_q64_array(q64 *dst, const q64 *x, const q64 *y, size_t count) {
+	size_t i;
+	for (i = 0; i < count; ++i)
+		dst[i] = addsat_q64(x[i], y[i]);
+}
+
+void subsat_q64_array(q64 *dst, const q64 *x, const q64 *y, size_t count) {
+	size_t i;
+	for (i = 0; i < count; ++i)
+		dst[i] = subsat_q64(x[i], y[i]);
+}
+
+void mulsat_q64_array(q64 *dst, const q64 *x, const q64 *y, size_t count, s64 frac) {
+	size_t i;
+	for (i = 0; i < count; ++i)
+		dst[i] = mulsat_q64(x[i], y[i], frac);
+}
+
+void divsat_q64_array(q64 *dst, const q64 *x, const q64 *y, size_t count, s64 frac) {
+	size_t i;
+	for (i = 0; i < count; ++i)
+		dst[i] = divsat_q64(x[i], y[i], frac);
+}
+
+void fastdiv_u32_array(u32 *dst, const u32 *src, size_t count, struct divider_u32 d) {
+	size_t i = 0;
+#if defined(_cpu_dispatch_x86) || defined(_arith_neon)
+	i = arith_fastdiv_kernel(dst, src, count, d.mul, d.shift, false, 0);
+#endif
+	for (; i < count; ++i)
+		dst[i] = fastdiv_u32(src[i], d);
+}
+
+void fastdiv_s32_array(s32 *dst, const s32 *src, size_t count, struct divider_s32 d) {
+	size_t i = 0;
+#if defined(_cpu_dispatch_x86) || defined(_arith_neon)
+	i = arith_fastdiv_kernel((u32 *) dst, (const u32 *) src, count, d.mul, d.shift, true, (u32) d.sign);
+#endif
+	for (; i < count; ++i)
+		dst[i] = fastdiv_s32(src[i], d);
+}
@@ -26,6 +26,7 @@
 
 #include "aw-types.h"
 #include <math.h>
+#include <stddef.h>
 
 #if !defined(_MSC_VER) || _MSC_VER >= 1800
 # include <stdbool.h>
@@ -33,6 +34,31 @@
 # include <stddef.h>
 #endif
 
+#if defined(_arith_dllexport)
+# if defined(_MSC_VER)
+#  define _arith_api extern __declspec(dllexport)
+# elif defined(__GNUC__)
+#  define _arith_api __attribute__((visibility("default"))) extern
+# endif
+#elif defined(_arith_dllimport)
+# if defined(_MSC_VER)
+#  define _arith_api extern __declspec(dllimport)
+# endif
+#endif
+#ifndef _arith_api
+# define _arith_api extern
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define _arith_sse2 1
+#endif
+#if defined(__x86_64__) || defined(_M_X64)
+# define _arith_sse2_64 1
+#endif
+#if defined(__SSE4_1__) || defined(__AVX__)
+# define _arith_sse41 1
+#endif
+
 #if defined(__GNUC__)
 # define _arith_alwaysinline inline __attribute__((always_inline))
 # define _arith_likely(x) __builtin_expect(!!(x), 1)
@@ -61,6 +87,14 @@ extern "C" {
 #define MIN_NEG_FLOAT (-3.402823466e+38f)
 #define LOG_2 (0.69314718056f)
 #define LOG_10 (2.30258509299f)
+#define LOG2_E (1.44269504089f)
+
+#define Q16_MIN (-32767 - 1)
+#define Q16_MAX (32767)
+#define Q32_MIN (-2147483647 - 1)
+#define Q32_MAX (2147483647)
+#define Q64_MIN (-imm_s64(9223372036854775807) - 1)
+#define Q64_MAX (imm_s64(9223372036854775807))
 
 _arith_alwaysinline u32 lsr31(u32 a) { return a >> 31; }
 _arith_alwaysinline u64 lsr63(u64 a) { return a >> 63; }
@@ -88,19 +122,19 @@ _arith_alwaysinline f32 sel_f32(f32 x, f32 a, f32 b) { return __fsel(x, a, b); }
 _arith_alwaysinline f32 sel_f32(f32 x, f32 a, f32 b) { return x >= 0.f ? a : b; }
 #endif
 
-_arith_alwaysinline s32 sel_s32(s32 x, s32 a, s32 b) { return a + ((b - a) & asr31(x)); }
+_arith_alwaysinline s32 sel_s32(s32 x, s32 a, s32 b) { return (s32) ((u32) a + (((u32) b - (u32) a) & (u32) asr31(x))); }
 _arith_alwaysinline u32 sel_u32(u32 x, u32 a, u32 b) { return a + ((b - a) & asr31(x)); }
-_arith_alwaysinline s64 sel_s64(s64 x, s64 a, s64 b) { return a + ((b - a) & asr63(x)); }
+_arith_alwaysinline s64 sel_s64(s64 x, s64 a, s64 b) { return (s64) ((u64) a + (((u64) b - (u64) a) & (u64) asr63(x))); }
 _arith_alwaysinline u64 sel_u64(u64 x, u64 a, u64 b) { return a + ((b - a) & asr63(x)); }
 
-_arith_alwaysinline s32 selgtz_s32(s32 x, s32 a, s32 b) { return b + ((a - b) & -asr31(x)); }
-_arith_alwaysinline u32 selgtz_u32(u32 x, u32 a, u32 b) { return b + ((a - b) & -asr31(x)); }
-_arith_alwaysinline s64 selgtz_s64(s64 x, s64 a, s64 b) { return b + ((a - b) & -asr63(x)); }
-_arith_alwaysinline u64 selgtz_u64(u64 x, u64 a, u64 b) { return b + ((a - b) & -asr63(x)); }
+_arith_alwaysinline s32 selgtz_s32(s32 x, s32 a, s32 b) { return (s32) ((u32) b + (((u32) a - (u32) b) & (u32) asr31((s32) (-(u32) x & ~(u32) x)))); }
+_arith_alwaysinline u32 selgtz_u32(u32 x, u32 a, u32 b) { return b + ((a - b) & asr31((s32) (-x & ~x))); }
+_arith_alwaysinline s64 selgtz_s64(s64 x, s64 a, s64 b) { return (s64) ((u64) b + (((u64) a - (u64) b) & (u64) asr63((s64) (-(u64) x & ~(u64) x)))); }
+_arith_alwaysinline u64 selgtz_u64(u64 x, u64 a, u64 b) { return b + ((a - b) & asr63((s64) (-x & ~x))); }
 
-_arith_alwaysinline s32 selltz_s32(s32 x, s32 a, s32 b) { return b + ((a - b) & asr31(x)); }
+_arith_alwaysinline s32 selltz_s32(s32 x, s32 a, s32 b) { return (s32) ((u32) b + (((u32) a - (u32) b) & (u32) asr31(x))); }
 _arith_alwaysinline u32 selltz_u32(u32 x, u32 a, u32 b) { return b + ((a - b) & asr31(x)); }
-_arith_alwaysinline s64 selltz_s64(s64 x, s64 a, s64 b) { return b + ((a - b) & asr63(x)); }
+_arith_alwaysinline s64 selltz_s64(s64 x, s64 a, s64 b) { return (s64) ((u64) b + (((u64) a - (u64) b) & (u64) asr63(x))); }
 _arith_alwaysinline u64 selltz_u64(u64 x, u64 a, u64 b) { return b + ((a - b) & asr63(x)); }
 
 #if defined(__allegrex__)
@@ -113,11 +147,11 @@ _arith_alwaysinline u32 selz_u32(u32 x, u32 a, u32 b) {
 	return b;
 }
 #else
-_arith_alwaysinline s32 selz_s32(s32 x, s32 a, s32 b) { return a + ((b - a) & asr31(-(s32) x | x)); }
-_arith_alwaysinline u32 selz_u32(u32 x, u32 a, u32 b) { return a + ((b - a) & asr31(-(s32) x | x)); }
+_arith_alwaysinline s32 selz_s32(s32 x, s32 a, s32 b) { return (s32) ((u32) a + (((u32) b - (u32) a) & (u32) asr31((s32) (-(u32) x | (u32) x)))); }
+_arith_alwaysinline u32 selz_u32(u32 x, u32 a, u32 b) { return a + ((b - a) & (u32) asr31((s32) (-x | x))); }
 #endif
-_arith_alwaysinline s64 selz_s64(s64 x, s64 a, s64 b) { return a + ((b - a) & asr63(-(s64) x | x)); }
-_arith_alwaysinline u64 selz_u64(u64 x, u64 a, u64 b) { return a + ((b - a) & asr63(-(s64) x | x)); }
+_arith_alwaysinline s64 selz_s64(s64 x, s64 a, s64 b) { return (s64) ((u64) a + (((u64) b - (u64) a) & (u64) asr63((s64) (-(u64) x | (u64) x)))); }
+_arith_alwaysinline u64 selz_u64(u64 x, u64 a, u64 b) { return a + ((b - a) & (u64) asr63((s64) (-x | x))); }
 
 _arith_alwaysinline s32 incwrap_s32(s32 x, s32 mx) { return sel_s32(mx - (x + 1), x + 1, 0); }
 _arith_alwaysinline u32 incwrap_u32(u32 x, u32 mx) { return sel_s32(mx - (x + 1), x + 1, 0); }
@@ -131,17 +165,18 @@ _arith_alwaysinline u64 decwrap_u64(u64 x, u64 mx) { return sel_s64(x - 1, x - 1
 
 _arith_alwaysinline s32 min_s32(s32 a, s32 b) { return a < b ? a : b; }
 _arith_alwaysinline s64 min_s64(s64 a, s64 b) { return a < b ? a : b; }
-_arith_alwaysinline u32 min_u32(u32 a, u32 b) { return b + ((a - b) & asr31(a - b)); }
-_arith_alwaysinline u64 min_u64(u64 a, u64 b) { return b + ((a - b) & asr63(a - b)); }
+_arith_alwaysinline u32 min_u32(u32 a, u32 b) { return b + ((a - b) & -(u32) (a < b)); }
+_arith_alwaysinline u64 min_u64(u64 a, u64 b) { return b + ((a - b) & -(u64) (a < b)); }
 _arith_alwaysinline f32 min_f32(f32 a, f32 b) { return sel_f32(a - b, b, a); }
 
 _arith_alwaysinline s32 max_s32(s32 a, s32 b) { return a < b ? b : a; }
 _arith_alwaysinline s64 max_s64(s64 a, s64 b) { return a < b ? b : a; }
-_arith_alwaysinline u32 max_u32(u32 a, u32 b) { return a + ((b - a) & asr31(a - b)); }
-_arith_alwaysinline u64 max_u64(u64 a, u64 b) { return a + ((b - a) & asr63(a - b)); }
+_arith_alwaysinline u32 max_u32(u32 a, u32 b) { return a + ((b - a) & -(u32) (a < b)); }
+_arith_alwaysinline u64 max_u64(u64 a, u64 b) { return a + ((b - a) & -(u64) (a < b)); }
 _arith_alwaysinline f32 max_f32(f32 a, f32 b) { return sel_f32(a - b, a, b); }
 
 _arith_alwaysinline s32 clamp_s32(s32 a, s32 mn, s32 mx) { return min_s32(max_s32(a, mn), mx); }
+_arith_alwaysinline s64 clamp_s64(s64 a, s64 mn, s64 mx) { return min_s64(max_s64(a, mn), mx); }
 _arith_alwaysinline u32 clamp_u32(u32 a, u32 mn, u32 mx) { return min_u32(max_u32(a, mn), mx); }
 _arith_alwaysinline f32 clamp_f32(f32 a, f32 mn, f32 mx) { return min_f32(max_f32(a, mn), mx); }
 _arith_alwaysinline f32 saturate_f32(f32 a)  { return clamp_f32(a, 0.f, 1.f); }
@@ -152,47 +187,133 @@ _arith_alwaysinline f32 sgn_f32(f32 a) { return sel_f32(a, sel_f32(-abs_f32(a),
 _arith_alwaysinline s32 isgn_s32(s32 a, s32 b) { return abs_s32(a) * sgn_s32(b); }
 _arith_alwaysinline f32 isgn_f32(f32 a, f32 b) { return abs_f32(a) * sgn_f32(b); }
 
-_arith_alwaysinline s32 sgnflip_s32(s32 a) { return a ^ (-(s32) lsr31(a) | (1 << 31)); }
-_arith_alwaysinline s32 invsgnflip_s32(s32 a) { return a ^ ((lsr31(a) - 1) | (1 << 31)); }
+_arith_alwaysinline s32 sgnflip_s32(s32 a) { return (s32) ((u32) a ^ (-lsr31((u32) a) | 0x80000000u)); }
+_arith_alwaysinline s32 invsgnflip_s32(s32 a) { return (s32) ((u32) a ^ ((lsr31((u32) a) - 1) | 0x80000000u)); }
+_arith_alwaysinline s64 sgnflip_s64(s64 a) { return a ^ (s64) (-lsr63((u64) a) | imm_u64(0x8000000000000000)); }
+_arith_alwaysinline s64 invsgnflip_s64(s64 a) { return a ^ (s64) ((lsr63((u64) a) - 1) | imm_u64(0x8000000000000000)); }
 
+/* Bit counts are defined for zero: clz and ctz return the width. Builds for
+   a target with LZCNT, BMI or POPCNT get the single instruction, which also
+   needs no zero check; others fall back to BSR/BSF or a bit-parallel sum. */
 _arith_alwaysinline u32 clz_u32(u32 a) {
-        u32 r;
-
+#if defined(__LZCNT__) || (defined(_MSC_VER) && defined(__AVX2__))
+	return (u32) _lzcnt_u32(a);
+#else
 	if (_arith_unlikely(a == 0))
 		return 32;
 
-# if defined(__i386__) || defined(__x86_64__)
-        __asm__ ("bsr %0, %1" : "=r" (r) : "r" (a));
-	r = 31 - r;
-# elif defined(_M_IX86) || defined(_M_X64)
-        __asm bsr eax, a;
-        __asm mov r, eax;
-	r = 31 - r;
-# elif defined(__PPU__)
-        r = __cntlzw(a);
+# if defined(__PPU__)
+	return (u32) __cntlzw(a);
 # elif defined(__SPU__)
-        r = si_to_uint(si_clz(si_from_uint(a)));
-# elif defined(__arm__)
-        __asm__ ("clz %0, %1" : "=r" (r) : "r" (a) : "cc");
+	return (u32) si_to_uint(si_clz(si_from_uint(a)));
+# elif defined(__GNUC__)
+	return (u32) __builtin_clz(a);
+# elif defined(_MSC_VER)
+	{
+		unsigned long r;
+		_BitScanReverse(&r, a);
+		return 31 - (u32) r;
+	}
 # else
-# warning no clz
+#  warning no clz
 # endif
+#endif
+}
+
+_arith_alwaysinline u32 clz_u64(u64 a) {
+#if defined(_arith_sse2_64) && (defined(__LZCNT__) || (defined(_MSC_VER) && defined(__AVX2__)))
+	return (u32) _lzcnt_u64(a);
+#elif defined(__x86_64__) || defined(__aarch64__)
+	if (_arith_unlikely(a == 0))
+		return 64;
+
+	return (u32) __builtin_clzll(a);
+#elif defined(_M_X64) || defined(_M_ARM64) || defined(_M_ARM64EC)
+	unsigned long r;
+
+	if (_arith_unlikely(a == 0))
+		return 64;
 
-        return r;
+	_BitScanReverse64(&r, a);
+	return 63 - (u32) r;
+#else
+	u32 hi = (u32) (a >> 32);
+	return hi != 0 ? clz_u32(hi) : 32 + clz_u32((u32) a);
+#endif
 }
 
 _arith_alwaysinline u32 ctz_u32(u32 a) {
+#if defined(__BMI__) || (defined(_MSC_VER) && defined(__AVX2__))
+	return (u32) _tzcnt_u32(a);
+#else
 	if (_arith_unlikely(a == 0))
 		return 32;
 
-	return 31 - clz_u32(a & -(s32) a);
+# if defined(__GNUC__)
+	return (u32) __builtin_ctz(a);
+# elif defined(_MSC_VER)
+	{
+		unsigned long r;
+		_BitScanForward(&r, a);
+		return (u32) r;
+	}
+# else
+	return 31 - clz_u32(a & -a);
+# endif
+#endif
+}
+
+_arith_alwaysinline u32 ctz_u64(u64 a) {
+#if defined(_arith_sse2_64) && (defined(__BMI__) || (defined(_MSC_VER) && defined(__AVX2__)))
+	return (u32) _tzcnt_u64(a);
+#elif defined(__x86_64__) || defined(__aarch64__)
+	if (_arith_unlikely(a == 0))
+		return 64;
+
+	return (u32) __builtin_ctzll(a);
+#elif defined(_M_X64) || defined(_M_ARM64) || defined(_M_ARM64EC)
+	unsigned long r;
+
+	if (_arith_unlikely(a == 0))
+		return 64;
+
+	_BitScanForward64(&r, a);
+	return (u32) r;
+#else
+	u32 lo = (u32) a;
+	return lo != 0 ? ctz_u32(lo) : 32 + ctz_u32((u32) (a >> 32));
+#endif
+}
+
+_arith_alwaysinline u32 popcount_u32(u32 a) {
+#if defined(__POPCNT__) || defined(__aarch64__) || defined(__ARM_NEON)
+	return (u32) __builtin_popcount(a);
+#elif defined(_MSC_VER) && defined(__AVX__)
+	return (u32) __popcnt(a);
+#else
+	a = a - ((a >> 1) & 0x55555555);
+	a = (a & 0x33333333) + ((a >> 2) & 0x33333333);
+	return (((a + (a >> 4)) & 0x0f0f0f0f) * 0x01010101) >> 24;
+#endif
+}
+
+_arith_alwaysinline u32 popcount_u64(u64 a) {
+#if defined(__POPCNT__) || defined(__aarch64__) || defined(__ARM_NEON)
+	return (u32) __builtin_popcountll(a);
+#elif defined(_MSC_VER) && defined(__AVX__) && defined(_M_X64)
+	return (u32) __popcnt64(a);
+#else
+	a = a - ((a >> 1) & imm_u64(0x5555555555555555));
+	a = (a & imm_u64(0x3333333333333333)) + ((a >> 2) & imm_u64(0x3333333333333333));
+	return (u32) ((((a + (a >> 4)) & imm_u64(0x0f0f0f0f0f0f0f0f)) * imm_u64(0x0101010101010101)) >> 56);
+#endif
 }
 
 _arith_alwaysinline u32 floorpow2_u32(u32 a) {
 	if (_arith_unlikely(a == 0))
 		return 0;
 
-	return 1 << (31 - clz_u32(a));
+	return 1u << (31 - clz_u32(a));
 }
 
 _arith_alwaysinline u32 ceilpow2_u32(u32 a) {
@@ -208,7 +329,19 @@ _arith_alwaysinline u32 ceilpow2_u32(u32 a) {
 _arith_alwaysinline bool ispow2_u32(u32 a) { return !(a & (a - 1)); }
 
 _arith_alwaysinline u8 bitswap_u8(u8 v) {
-        return (u8) (((v * 0x0802 & 0x22110) | (v * 0x8020 & 0x88440)) * 0x10101 >> 16);
+        return (u8) ((((u32) v * 0x0802u & 0x22110u) | ((u32) v * 0x8020u & 0x88440u)) * 0x10101u >> 16);
+}
+
+_arith_alwaysinline u16 bitswap_u16(u16 v) {
+	return (u16) (bitswap_u8((u8) v) << 8 | bitswap_u8((u8) (v >> 8)));
+}
+
+_arith_alwaysinline u32 bitswap_u32(u32 v) {
+	return (u32) bitswap_u16((u16) v) << 16 | bitswap_u16((u16) (v >> 16));
+}
+
+_arith_alwaysinline u64 bitswap_u64(u64 v) {
+	return (u64) bitswap_u32((u32) v) << 32 | bitswap_u32((u32) (v >> 32));
 }
 
 _arith_alwaysinline f32 sqr_f32(f32 a) { return a * a; }
@@ -222,135 +355,451 @@ _arith_alwaysinline s32 log2_f32(f32 a) {
 	return (s32) ((t.u >> 23) & 0xff) - 127;
 }
 
+/* trunc rounds towards zero and round to nearest in the current rounding
+   mode (nearest even by default). floor and ceil are exact for results that
+   fit the integer type. On x86 these stay in the SSE registers: cvt(t)ss2si
+   and cvt(t)sd2si, and roundss/roundsd when SSE4.1 is enabled. */
 _arith_alwaysinline s32 trunc_f32(f32 a) {
-#if defined(__i386__) || defined(__x86_64__)
-	s32 t;
-
-	asm ("fisttpl %0" : "=g" (t) : "t" (a));
-	return t;
-#elif defined(_M_IX86) || defined(_M_X64)
-	s32 t;
-
-	__asm fisttp dword ptr[t];
-	return t;
+#if defined(_arith_sse2)
+	return _mm_cvttss_si32(_mm_set_ss(a));
 #else
 	return (s32) a;
 #endif
 }
 
 _arith_alwaysinline s64 trunc_f64(f64 a) {
-#if defined(__i386__) || defined(__x86_64__)
-	s64 t;
-
-	asm ("fisttpq %0" : "=g" (t) : "t" (a));
-	return t;
-#elif defined(_M_IX86) || defined(_M_X64)
-	s64 t;
-
-	__asm fisttp dword ptr[t];
-	return t;
+#if defined(_arith_sse2_64)
+	return _mm_cvttsd_si64(_mm_set_sd(a));
 #else
 	return (s64) a;
 #endif
 }
 
 _arith_alwaysinline s32 round_f32(f32 a) {
-#if defined(__i386__) || defined(__x86_64__)
-	s32 t;
-
-	asm("fistpl %0" : "=g" (t) : "t" (a));
-	return t;
-#elif defined(_M_IX86) || defined(_M_X64)
-	s32 t;
-
-	__asm fistp dword ptr[t];
-	return t;
+#if defined(_arith_sse2)
+	return _mm_cvtss_si32(_mm_set_ss(a));
 #else
-	return lroundf(a);
+	return (s32) lrintf(a);
 #endif
 }
 
 _arith_alwaysinline s64 round_f64(f64 a) {
-#if defined(__i386__) || defined(__x86_64__)
-	s64 t;
-
-	asm("fistpq %0" : "=g" (t) : "t" (a));
+#if defined(_arith_sse2_64)
+	return _mm_cvtsd_si64(_mm_set_sd(a));
+#else
+	return (s64) llrint(a);
+#endif
+}
 
-	return t;
-#elif defined(_M_IX86) || defined(_M_X64)
-	s64 t;
+_arith_alwaysinline s32 floor_f32(f32 a) {
+#if defined(_arith_sse41)
+	__m128 v = _mm_set_ss(a);
+	return _mm_cvttss_si32(_mm_round_ss(v, v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+#else
+	s32 t = trunc_f32(a);
+	return t - (a < (f32) t);
+#endif
+}
 
-	__asm fistp dword ptr[t];
-	return t;
+_arith_alwaysinline s64 floor_f64(f64 a) {
+#if defined(_arith_sse41) && defined(_arith_sse2_64)
+	__m128d v = _mm_set_sd(a);
+	return _mm_cvttsd_si64(_mm_round_sd(v, v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
 #else
-	return llroundf(a);
+	s64 t = trunc_f64(a);
+	return t - (a < (f64) t);
 #endif
 }
 
 _arith_alwaysinline s32 ceil_f32(f32 a) {
-	return -(round_f32(-0.5f - (a + a)) >> 1);
+#if defined(_arith_sse41)
+	__m128 v = _mm_set_ss(a);
+	return _mm_cvttss_si32(_mm_round_ss(v, v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+#else
+	s32 t = trunc_f32(a);
+	return t + (a > (f32) t);
+#endif
 }
 
 _arith_alwaysinline s64 ceil_f64(f64 a) {
-	return -(round_f64(-0.5f - (a + a)) >> 1);
+#if defined(_arith_sse41) && defined(_arith_sse2_64)
+	__m128d v = _mm_set_sd(a);
+	return _mm_cvttsd_si64(_mm_round_sd(v, v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+#else
+	s64 t = trunc_f64(a);
+	return t + (a > (f64) t);
+#endif
 }
 
-_arith_alwaysinline s32 floor_f32(f32 a) {
-	return round_f32(-0.5f + (a + a)) >> 1;
+/* Batch rounding of f32 to s32, in the same modes as the scalar functions. */
+_arith_api void trunc_f32_array(s32 *dst, const f32 *src, size_t count);
+_arith_api void round_f32_array(s32 *dst, const f32 *src, size_t count);
+_arith_api void floor_f32_array(s32 *dst, const f32 *src, size_t count);
+_arith_api void ceil_f32_array(s32 *dst, const f32 *src, size_t count);
+
+/* Full 128-bit products, returning the high half and storing the low. */
+_arith_alwaysinline u64 mulwide_u64(u64 a, u64 b, u64 *lo) {
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 p = (unsigned __int128) a * b;
+	*lo = (u64) p;
+	return (u64) (p >> 64);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+	*lo = a * b;
+	return __umulh(a, b);
+#else
+	u64 ll = (a & 0xffffffff) * (b & 0xffffffff);
+	u64 lh = (a & 0xffffffff) * (b >> 32);
+	u64 hl = (a >> 32) * (b & 0xffffffff);
+	u64 hh = (a >> 32) * (b >> 32);
+	u64 mid = (ll >> 32) + (lh & 0xffffffff) + (hl & 0xffffffff);
+	*lo = (mid << 32) | (ll & 0xffffffff);
+	return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
 }
 
-_arith_alwaysinline s64 floor_f64(f64 a) {
-	return round_f64(-0.5f + (a + a)) >> 1;
+_arith_alwaysinline s64 mulwide_s64(s64 a, s64 b, u64 *lo) {
+	u64 hi = mulwide_u64((u64) a, (u64) b, lo);
+	return (s64) (hi - ((u64) b & (u64) asr63(a)) - ((u64) a & (u64) asr63(b)));
+}
+
+/* 128-by-64-bit division of hi:lo, for hi < d so that the quotient fits;
+   returns the quotient and stores the remainder. */
+_arith_alwaysinline u64 divwide_u64(u64 hi, u64 lo, u64 d, u64 *rem) {
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 n = (unsigned __int128) hi << 64 | lo;
+	*rem = (u64) (n % d);
+	return (u64) (n / d);
+#else
+	u64 q = 0;
+	int i;
+	for (i = 0; i < 64; ++i) {
+		u64 top = hi >> 63;
+		hi = hi << 1 | lo >> 63;
+		lo <<= 1;
+		q <<= 1;
+		if (top != 0 || hi >= d) {
+			hi -= d;
+			q |= 1;
+		}
+	}
+	*rem = hi;
+	return q;
+#endif
+}
+
+/* Division by a run-time invariant divisor, as a multiply by a precomputed
+   reciprocal and a shift (Granlund and Montgomery, "Division by Invariant
+   Integers using Multiplication"). Making a divider costs about one
+   hardware division; dividing by it then costs a few cycles. Divisors must
+   not be zero, and signed division truncates like the / operator.
+
+   32-bit division takes the 33-bit reciprocal as a 64-bit product, with no
+   branches. 64-bit division uses a 64-bit reciprocal with the shorter
+   sequence when the divisor allows, as libdivide does; fastdiv branches on
+   which one that is, which is predictable in a loop, and fastdivbf masks
+   instead. fastmod gives the matching remainder.
+
+   reduce maps x to [0, n) as x * n / 2^32 (or 2^64) for hashing into a
+   table of any size (Lemire, "A fast alternative to the modulo
+   reduction"). It is not x % n and depends on the high bits of x, which
+   must be well mixed. */
+struct divider_u32 {
+	u32 mul;
+	u32 div;
+	u32 shift;
+};
+
+struct divider_s32 {
+	u32 mul;
+	u32 div;
+	u32 shift;
+	s32 sign;
+};
+
+struct divider_u64 {
+	u64 mul;
+	u64 div;
+	u64 add;
+	u32 pre;
+	u32 post;
+};
+
+struct divider_s64 {
+	u64 mul;
+	u64 div;
+	u64 add;
+	u32 pre;
+	u32 post;
+	s64 sign;
+};
+
+_arith_alwaysinline struct divider_u32 divider_u32_make(u32 d) {
+	struct divider_u32 r;
+	u32 l = d > 1 ? 32 - clz_u32(d - 1) : 0;
+	r.mul = (u32) ((((imm_u64(1) << l) - d) << 32) / d + 1);
+	r.div = d;
+	r.shift = l;
+	return r;
+}
+
+_arith_alwaysinline u32 fastdiv_u32(u32 x, struct divider_u32 d) {
+	return (u32) ((((u64) x * d.mul >> 32) + x) >> d.shift);
+}
+
+_arith_alwaysinline u32 fastmod_u32(u32 x, struct divider_u32 d) { return x - fastdiv_u32(x, d) * d.div; }
+
+_arith_alwaysinline struct divider_s32 divider_s32_make(s32 d) {
+	struct divider_s32 r;
+	u32 s = (u32) asr31(d);
+	struct divider_u32 u = divider_u32_make(((u32) d ^ s) - s);
+	r.mul = u.mul;
+	r.div = u.div;
+	r.shift = u.shift;
+	r.sign = asr31(d);
+	return r;
+}
+
+_arith_alwaysinline s32 fastdiv_s32(s32 x, struct divider_s32 d) {
+	u32 s = (u32) asr31(x), a = ((u32) x ^ s) - s;
+	u32 q = (u32) ((((u64) a * d.mul >> 32) + a) >> d.shift);
+	s ^= (u32) d.sign;
+	return (s32) ((q ^ s) - s);
+}
+
+_arith_alwaysinline s32 fastmod_s32(s32 x, struct divider_s32 d) {
+	u32 s = (u32) asr31(x), a = ((u32) x ^ s) - s;
+	u32 r = a - (u32) ((((u64) a * d.mul >> 32) + a) >> d.shift) * d.div;
+	return (s32) ((r ^ s) - s);
+}
+
+_arith_alwaysinline struct divider_u64 divider_u64_make(u64 d) {
+	struct divider_u64 r;
+	u32 l = 63 - clz_u64(d | 1);
+	u64 rem, m;
+	r.div = d;
+	if ((d & (d - 1)) != 0) {
+		m = divwide_u64(imm_u64(1) << l, 0, d, &rem);
+		if (d - rem < imm_u64(1) << l) {
+			r.mul = m + 1;
+			r.add = 0;
+			r.pre = 0;
+			r.post = l;
+			return r;
+		}
+		++l;
+	}
+	r.mul = divwide_u64((l < 64 ? imm_u64(1) << l : 0) - d, 0, d, &rem) + 1;
+	r.add = ~imm_u64(0);
+	r.pre = d > 1;
+	r.post = l - r.pre;
+	return r;
+}
+
+_arith_alwaysinline u64 fastdiv_u64(u64 x, struct divider_u64 d) {
+	u64 lo, t = mulwide_u64(x, d.mul, &lo);
+	if (d.add == 0)
+		return t >> d.post;
+	return (t + ((x - t) >> d.pre)) >> d.post;
+}
+
+_arith_alwaysinline u64 fastdivbf_u64(u64 x, struct divider_u64 d) {
+	u64 lo, t = mulwide_u64(x, d.mul, &lo);
+	return (t + (((x - t) >> d.pre) & d.add)) >> d.post;
+}
+
+_arith_alwaysinline u64 fastmod_u64(u64 x, struct divider_u64 d) { return x - fastdiv_u64(x, d) * d.div; }
+
+_arith_alwaysinline struct divider_s64 divider_s64_make(s64 d) {
+	struct divider_s64 r;
+	u64 s = (u64) asr63(d);
+	struct divider_u64 u = divider_u64_make(((u64) d ^ s) - s);
+	r.mul = u.mul;
+	r.div = u.div;
+	r.add = u.add;
+	r.pre = u.pre;
+	r.post = u.post;
+	r.sign = asr63(d);
+	return r;
+}
+
+_arith_alwaysinline s64 fastdiv_s64(s64 x, struct divider_s64 d) {
+	u64 s = (u64) asr63(x), a = ((u64) x ^ s) - s, lo, q = mulwide_u64(a, d.mul, &lo);
+	if (d.add != 0)
+		q += (a - q) >> d.pre;
+	q >>= d.post;
+	s ^= (u64) d.sign;
+	return (s64) ((q ^ s) - s);
+}
+
+_arith_alwaysinline s64 fastdivbf_s64(s64 x, struct divider_s64 d) {
+	u64 s = (u64) asr63(x), a = ((u64) x ^ s) - s, lo, q = mulwide_u64(a, d.mul, &lo);
+	q = (q + (((a - q) >> d.pre) & d.add)) >> d.post;
+	s ^= (u64) d.sign;
+	return (s64) ((q ^ s) - s);
 }
 
+_arith_alwaysinline s64 fastmod_s64(s64 x, struct divider_s64 d) {
+	u64 s = (u64) asr63(x), a = ((u64) x ^ s) - s, lo, q = mulwide_u64(a, d.mul, &lo);
+	if (d.add != 0)
+		q += (a - q) >> d.pre;
+	a -= (q >> d.post) * d.div;
+	return (s64) ((a ^ s) - s);
+}
+
+_arith_alwaysinline u32 reduce_u32(u32 x, u32 n) { return (u32) ((u64) x * n >> 32); }
+_arith_alwaysinline u64 reduce_u64(u64 x, u64 n) { u64 lo; return mulwide_u64(x, n, &lo); }
+
+/* Batch division of u32 and s32 by one divider, four or eight lanes at a
+   time with a widening multiply. */
+_arith_api void fastdiv_u32_array(u32 *dst, const u32 *src, size_t count, struct divider_u32 d);
+_arith_api void fastdiv_s32_array(s32 *dst, const s32 *src, size_t count, struct divider_s32 d);
+
 /* q16 */
 _arith_alwaysinline q16 s16_to_q16(s16 s, s16 frac) { return s << frac; }
 _arith_alwaysinline s16 q16_to_s16(q16 q, s16 frac) { return q >> frac; }
-_arith_alwaysinline q16 f32_to_q16(f32 f, s16 frac) {
-	return (trunc_f32(floor_f32(f)) << frac) | round_f32((f - floor_f32(f)) * (1 << frac));
-}
+_arith_alwaysinline q16 f32_to_q16(f32 f, s16 frac) { return (q16) round_f32(f * (f32) (1 << frac)); }
 _arith_alwaysinline f32 q16_to_f32(q16 x, s16 frac) {
 	return (x >> frac) + (x & ((1 << frac) - 1)) / (f32) (1 << frac);
 }
 _arith_alwaysinline q16 add_q16(q16 x, q16 y) { return x + y; }
 _arith_alwaysinline q16 sub_q16(q16 x, q16 y) { return x - y; }
 _arith_alwaysinline q16 mul_q16(q16 x, q16 y, s16 frac) { return (x * y) >> frac; }
-_arith_alwaysinline q16 div_q16(q16 x, q16 y, s16 frac) { return (x << frac) / y; }
+_arith_alwaysinline q16 div_q16(q16 x, q16 y, s16 frac) { return (x * (1 << frac)) / y; }
 _arith_alwaysinline q16 neg_q16(q16 x) { return -x; }
 _arith_alwaysinline q16 abs_q16(q16 x) { return abs_s32(x); }
 
+/* Saturating q16; division by zero saturates towards the sign of x. */
+_arith_alwaysinline q16 addsat_q16(q16 x, q16 y) { return (q16) clamp_s32(x + y, Q16_MIN, Q16_MAX); }
+_arith_alwaysinline q16 subsat_q16(q16 x, q16 y) { return (q16) clamp_s32(x - y, Q16_MIN, Q16_MAX); }
+_arith_alwaysinline q16 mulsat_q16(q16 x, q16 y, s16 frac) { return (q16) clamp_s32((x * y) >> frac, Q16_MIN, Q16_MAX); }
+_arith_alwaysinline q16 divsat_q16(q16 x, q16 y, s16 frac) {
+	if (_arith_unlikely(y == 0))
+		return x < 0 ? Q16_MIN : Q16_MAX;
+	return (q16) clamp_s32((x * (1 << frac)) / y, Q16_MIN, Q16_MAX);
+}
+
 /* q32 */
 _arith_alwaysinline q32 s32_to_q32(s32 s, s32 frac) { return s << frac; }
 _arith_alwaysinline s32 q32_to_s32(q32 q, s32 frac) { return q >> frac; }
-_arith_alwaysinline q32 f32_to_q32(f32 f, s32 frac) {
-	return (trunc_f32(floor_f32(f)) << frac) | round_f32((f - floor_f32(f)) * (1 << frac));
-}
+_arith_alwaysinline q32 f32_to_q32(f32 f, s32 frac) { return round_f32(f * (f32) (1u << frac)); }
 _arith_alwaysinline f32 q32_to_f32(q32 x, s32 frac) {
 	return (x >> frac) + (x & ((1 << frac) - 1)) / (f32) (1 << frac);
 }
 _arith_alwaysinline q32 add_q32(q32 x, q32 y) { return x + y; }
 _arith_alwaysinline q32 sub_q32(q32 x, q32 y) { return x - y; }
-_arith_alwaysinline q32 mul_q32(q32 x, q32 y, s32 frac) { return (x * y) >> frac; }
-_arith_alwaysinline q32 div_q32(q32 x, q32 y, s32 frac) { return (x << frac) / y; }
+_arith_alwaysinline q32 mul_q32(q32 x, q32 y, s32 frac) { return (q32) (((s64) x * y) >> frac); }
+_arith_alwaysinline q32 div_q32(q32 x, q32 y, s32 frac) { return (q32) ((s64) x * (imm_s64(1) << frac) / y); }
 _arith_alwaysinline q32 neg_q32(q32 x) { return -x; }
 _arith_alwaysinline q32 abs_q32(q32 x) { return abs_s32(x); }
 
+/* Saturating q32; division by zero saturates towards the sign of x. */
+_arith_alwaysinline q32 addsat_q32(q32 x, q32 y) { return (q32) clamp_s64((s64) x + y, Q32_MIN, Q32_MAX); }
+_arith_alwaysinline q32 subsat_q32(q32 x, q32 y) { return (q32) clamp_s64((s64) x - y, Q32_MIN, Q32_MAX); }
+_arith_alwaysinline q32 mulsat_q32(q32 x, q32 y, s32 frac) { return (q32) clamp_s64(((s64) x * y) >> frac, Q32_MIN, Q32_MAX); }
+_arith_alwaysinline q32 divsat_q32(q32 x, q32 y, s32 frac) {
+	if (_arith_unlikely(y == 0))
+		return x < 0 ? Q32_MIN : Q32_MAX;
+	return (q32) clamp_s64((s64) x * (imm_s64(1) << frac) / y, Q32_MIN, Q32_MAX);
+}
+
 /* q64 */
 _arith_alwaysinline q64 s64_to_q64(s64 s, s64 frac) { return s << frac; }
 _arith_alwaysinline s64 q64_to_s64(q64 q, s64 frac) { return q >> frac; }
-_arith_alwaysinline q64 f64_to_q64(f64 f, s64 frac) {
-	return (trunc_f64(floor_f64(f)) << frac) | round_f64((f - floor_f64(f)) * (imm_s64(1) << frac));
-}
+_arith_alwaysinline q64 f64_to_q64(f64 f, s64 frac) { return round_f64(f * (f64) (imm_u64(1) << frac)); }
 _arith_alwaysinline f64 q64_to_f64(q64 x, s64 frac) {
 	return (x >> frac) + (x & ((imm_s64(1) << frac) - 1)) / (f64) (imm_s64(1) << frac);
 }
 _arith_alwaysinline q64 add_q64(q64 x, q64 y) { return x + y; }
 _arith_alwaysinline q64 sub_q64(q64 x, q64 y) { return x - y; }
-_arith_alwaysinline q64 mul_q64(q64 x, q64 y, s64 frac) { return (x * y) >> frac; }
-_arith_alwaysinline q64 div_q64(q64 x, q64 y, s64 frac) { return (x << frac) / y; }
+_arith_alwaysinline q64 mul_q64(q64 x, q64 y, s64 frac) {
+	u64 lo;
+	s64 hi = mulwide_s64(x, y, &lo);
+	return (q64) ((u64) hi << 1 << (63 - frac) | lo >> frac);
+}
+
+/* |x| * 2^frac / |y| as a 128-bit dividend; returns the low 64 bits of the
+   quotient and stores the high ones. */
+_arith_alwaysinline u64 _arith_divq_u64(u64 x, u64 y, s64 frac, u64 *qhi) {
+	u64 hi = x >> 1 >> (63 - frac), rem;
+	*qhi = 0;
+	if (_arith_unlikely(hi >= y)) {
+		*qhi = hi / y;
+		hi %= y;
+	}
+	return divwide_u64(hi, x << frac, y, &rem);
+}
+
+/* Truncates like the / operator and wraps to 64 bits. */
+_arith_alwaysinline q64 div_q64(q64 x, q64 y, s64 frac) {
+	u64 sx = (u64) asr63(x), sy = (u64) asr63(y), s = sx ^ sy, qhi;
+	u64 q = _arith_divq_u64(((u64) x ^ sx) - sx, ((u64) y ^ sy) - sy, frac, &qhi);
+	return (q64) ((q ^ s) - s);
+}
+
 _arith_alwaysinline q64 neg_q64(q64 x) { return -x; }
 _arith_alwaysinline q64 abs_q64(q64 x) { return abs_s64(x); }
 
+/* Saturating q64; division by zero saturates towards the sign of x. */
+_arith_alwaysinline q64 addsat_q64(q64 x, q64 y) {
+	q64 r = (q64) ((u64) x + (u64) y);
+	return ((x ^ r) & (y ^ r)) < 0 ? asr63(x) ^ Q64_MAX : r;
+}
+_arith_alwaysinline q64 subsat_q64(q64 x, q64 y) {
+	q64 r = (q64) ((u64) x - (u64) y);
+	return ((x ^ y) & (x ^ r)) < 0 ? asr63(x) ^ Q64_MAX : r;
+}
+_arith_alwaysinline q64 mulsat_q64(q64 x, q64 y, s64 frac) {
+	u64 lo;
+	s64 hi = mulwide_s64(x, y, &lo);
+	q64 r = (q64) ((u64) hi << 1 << (63 - frac) | lo >> frac);
+	return (hi >> frac) == asr63(r) ? r : asr63(hi) ^ Q64_MAX;
+}
+_arith_alwaysinline q64 divsat_q64(q64 x, q64 y, s64 frac) {
+	u64 sx = (u64) asr63(x), sy = (u64) asr63(y), s = sx ^ sy, q, qhi;
+	if (_arith_unlikely(y == 0))
+		return x < 0 ? Q64_MIN : Q64_MAX;
+	q = _arith_divq_u64(((u64) x ^ sx) - sx, ((u64) y ^ sy) - sy, frac, &qhi);
+	if (qhi != 0 || q > (u64) Q64_MAX - s)
+		return (q64) (s ^ (u64) Q64_MAX);
+	return (q64) ((q ^ s) - s);
+}
+
+/* Batch conversions scale by 2^frac, round to nearest and saturate to the
+   range of the format; NaN gives an unspecified value. The batch arithmetic
+   matches the scalar helpers above. dst may be one of the sources. */
+_arith_api void f32_to_q16_array(q16 *dst, const f32 *src, size_t count, s16 frac);
+_arith_api void q16_to_f32_array(f32 *dst, const q16 *src, size_t count, s16 frac);
+_arith_api void add_q16_array(q16 *dst, const q16 *x, const q16 *y, size_t count);
+_arith_api void sub_q16_array(q16 *dst, const q16 *x, const q16 *y, size_t count);
+_arith_api void mul_q16_array(q16 *dst, const q16 *x, const q16 *y, size_t count, s16 frac);
+_arith_api void div_q16_array(q16 *dst, const q16 *x, const q16 *y, size_t count, s16 frac);
+_arith_api void addsat_q16_array(q16 *dst, const q16 *x, const q16 *y, size_t count);
+_arith_api void subsat_q16_array(q16 *dst, const q16 *x, const q16 *y, size_t count);
+_arith_api void mulsat_q16_array(q16 *dst, const q16 *x, const q16 *y, size_t count, s16 frac);
+_arith_api void divsat_q16_array(q16 *dst, const q16 *x, const q16 *y, size_t count, s16 frac);
+
+_arith_api void f32_to_q32_array(q32 *dst, const f32 *src, size_t count, s32 frac);
+_arith_api void q32_to_f32_array(f32 *dst, const q32 *src, size_t count, s32 frac);
+_arith_api void add_q32_array(q32 *dst, const q32 *x, const q32 *y, size_t count);
+_arith_api void sub_q32_array(q32 *dst, const q32 *x, const q32 *y, size_t count);
+_arith_api void mul_q32_array(q32 *dst, const q32 *x, const q32 *y, size_t count, s32 frac);
+_arith_api void div_q32_array(q32 *dst, const q32 *x, const q32 *y, size_t count, s32 frac);
+_arith_api void addsat_q32_array(q32 *dst, const q32 *x, const q32 *y, size_t count);
+_arith_api void subsat_q32_array(q32 *dst, const q32 *x, const q32 *y, size_t count);
+_arith_api void mulsat_q32_array(q32 *dst, const q32 *x, const q32 *y, size_t count, s32 frac);
+_arith_api void divsat_q32_array(q32 *dst, const q32 *x, const q32 *y, size_t count, s32 frac);
+
+_arith_api void f64_to_q64_array(q64 *dst, const f64 *src, size_t count, s64 frac);
+_arith_api void q64_to_f64_array(f64 *dst, const q64 *src, size_t count, s64 frac);
+_arith_api void add_q64_array(q64 *dst, const q64 *x, const q64 *y, size_t count);
+_arith_api void sub_q64_array(q64 *dst, const q64 *x, const q64 *y, size_t count);
+_arith_api void mul_q64_array(q64 *dst, const q64 *x, const q64 *y, size_t count, s64 frac);
+_arith_api void div_q64_array(q64 *dst, const q64 *x, const q64 *y, size_t count, s64 frac);
+_arith_api void addsat_q64_array(q64 *dst, const q64 *x, const q64 *y, size_t count);
+_arith_api void subsat_q64_array(q64 *dst, const q64 *x, const q64 *y, size_t count);
+_arith_api void mulsat_q64_array(q64 *dst, const q64 *x, const q64 *y, size_t count, s64 frac);
+_arith_api void divsat_q64_array(q64 *dst, const q64 *x, const q64 *y, size_t count, s64 frac);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -0,0 +1,398 @@
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+
+#include "aw-bitset.h"
+#include "aw-cpu.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_cpu_dispatch_x86) && (defined(__aarch64__) || defined(_M_ARM64))
+# include <arm_neon.h>
+# define _bitset_neon 1
+#endif
+
+/* Every kernel runs one of these over whole words; the ones from
+   BITSET_AND on also store their result. */
+enum {
+	BITSET_COUNT,
+	BITSET_AND_COUNT,
+	BITSET_AND,
+	BITSET_OR,
+	BITSET_XOR,
+	BITSET_ANDNOT,
+};
+
+typedef size_t (*bitset_fn)(u64 *dst, const u64 *x, const u64 *y, size_t n, int op);
+
+_bitset_alwaysinline static u64 bitset_op(u64 a, u64 b, int op) {
+	switch (op) {
+	case BITSET_AND_COUNT:
+	case BITSET_AND:
+		return a & b;
+	case BITSET_OR:
+		return a | b;
+	case BITSET_XOR:
+		return a ^ b;
+	case BITSET_ANDNOT:
+		return a & ~b;
+	default:
+		return a;
+	}
+}
+
+/* On x86 the scalar loop is built twice, for the baseline and for POPCNT;
+   the builtin only turns into the instruction in the latter. */
+_bitset_alwaysinline static u32 bitset_popcnt(u64 v) {
+#if defined(__GNUC__)
+	return (u32) __builtin_popcountll(v);
+#elif defined(_M_X64)
+	return (u32) __popcnt64(v);
+#else
+	return popcount_u64(v);
+#endif
+}
+
+_bitset_alwaysinline static size_t bitset_loop(u64 *dst, const u64 *x, const u64 *y, size_t n, int op, bool hw) {
+	size_t c = 0, i;
+	for (i = 0; i < n; ++i) {
+		u64 v = bitset_op(x[i], op != BITSET_COUNT ? y[i] : 0, op);
+		if (op >= BITSET_AND)
+			dst[i] = v;
+		c += hw ? bitset_popcnt(v) : popcount_u64(v);
+	}
+	return c;
+}
+
+#if !defined(_bitset_neon)
+static size_t bitset_run_scalar(u64 *dst, const u64 *x, const u64 *y, size_t n, int op) {
+	switch (op) {
+	case BITSET_AND_COUNT: return bitset_loop(dst, x, y, n, BITSET_AND_COUNT, false);
+	case BITSET_AND: return bitset_loop(dst, x, y, n, BITSET_AND, false);
+	case BITSET_OR: return bitset_loop(dst, x, y, n, BITSET_OR, false);
+	case BITSET_XOR: return bitset_loop(dst, x, y, n, BITSET_XOR, false);
+	case BITSET_ANDNOT: return bitset_loop(dst, x, y, n, BITSET_ANDNOT, false);
+	default: return bitset_loop(dst, x, y, n, BITSET_COUNT, false);
+	}
+}
+#endif
+
+#if defined(_cpu_dispatch_x86)
+_cpu_target("popcnt")
+static size_t bitset_run_popcnt(u64 *dst, const u64 *x, const u64 *y, size_t n, int op) {
+	switch (op) {
+	case BITSET_AND_COUNT: return bitset_loop(dst, x, y, n, BITSET_AND_COUNT, true);
+	case BITSET_AND: return bitset_loop(dst, x, y, n, BITSET_AND, true);
+	case BITSET_OR: return bitset_loop(dst, x, y, n, BITSET_OR, true);
+	case BITSET_XOR: return bitset_loop(dst, x, y, n, BITSET_XOR, true);
+	case BITSET_ANDNOT: return bitset_loop(dst, x, y, n, BITSET_ANDNOT, true);
+	default: return bitset_loop(dst, x, y, n, BITSET_COUNT, true);
+	}
+}
+
+_cpu_target("avx2")
+_bitset_alwaysinline static __m256i bitset_op_avx2(__m256i a, __m256i b, int op) {
+	switch (op) {
+	case BITSET_AND_COUNT:
+	case BITSET_AND:
+		return _mm256_and_si256(a, b);
+	case BITSET_OR:
+		return _mm256_or_si256(a, b);
+	case BITSET_XOR:
+		return _mm256_xor_si256(a, b);
+	case BITSET_ANDNOT:
+		return _mm256_andnot_si256(b, a);
+	default:
+		return a;
+	}
+}
+
+/* Counts nibbles with a shuffle lookup (Mula). Byte counts are at most 8
+   per vector, so they are summed in bytes for 31 vectors at a time before
+   widening with a sum of absolute differences. */
+_cpu_target("avx2,popcnt")
+_bitset_alwaysinline static size_t bitset_loop_avx2(u64 *dst, const u64 *x, const u64 *y, size_t n, int op) {
+	const __m256i lut = _mm256_setr_epi8(
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	const __m256i low = _mm256_set1_epi8(0x0f);
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i total = zero;
+	size_t i = 0;
+	u64 t[4];
+	while (i + 4 <= n) {
+		size_t end = n - i >= 4 * 31 ? i + 4 * 31 : n - (n - i) % 4;
+		__m256i acc = zero;
+		for (; i < end; i += 4) {
+			__m256i v = _mm256_loadu_si256((const __m256i *) (x + i));
+			if (op != BITSET_COUNT)
+				v = bitset_op_avx2(v, _mm256_loadu_si256((const __m256i *) (y + i)), op);
+			if (op >= BITSET_AND)
+				_mm256_storeu_si256((__m256i *) (dst + i), v);
+			acc = _mm256_add_epi8(acc, _mm256_shuffle_epi8(lut, _mm256_and_si256(v, low)));
+			acc = _mm256_add_epi8(acc, _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), low)));
+		}
+		total = _mm256_add_epi64(total, _mm256_sad_epu8(acc, zero));
+	}
+	_mm256_storeu_si256((__m256i *) t, total);
+	return (size_t) (t[0] + t[1] + t[2] + t[3]) + bitset_loop(dst + i, x + i, y + i, n - i, op, true);
+}
+
+_cpu_target("avx2,popcnt")
+static size_t bitset_run_avx2(u64 *dst, const u64 *x, const u64 *y, size_t n, int op) {
+	switch (op) {
+	case BITSET_AND_COUNT: return bitset_loop_avx2(dst, x, y, n, BITSET_AND_COUNT);
+	case BITSET_AND: return bitset_loop_avx2(dst, x, y, n, BITSET_AND);
+	case BITSET_OR: return bitset_loop_avx2(dst, x, y, n, BITSET_OR);
+	case BITSET_XOR: return bitset_loop_avx2(dst, x, y, n, BITSET_XOR);
+	case BITSET_ANDNOT: return bitset_loop_avx2(dst, x, y, n, BITSET_ANDNOT);
+	default: return bitset_loop_avx2(dst, x, y, n, BITSET_COUNT);
+	}
+}
+
+static size_t bitset_run_resolve(u64 *dst, const u64 *x, const u64 *y, size_t n, int op);
+static _cpu_ptr(bitset_fn) bitset_run_ptr = bitset_run_resolve;
+#define bitset_run _cpu_load_ptr(bitset_run_ptr)
+
+static size_t bitset_run_resolve(u64 *dst, const u64 *x, const u64 *y, size_t n, int op) {
+	bitset_fn fn = bitset_run_scalar;
+	if (cpu_has(CPU_AVX2 | CPU_POPCNT))
+		fn = bitset_run_avx2;
+	else if (cpu_has(CPU_POPCNT))
+		fn = bitset_run_popcnt;
+	_cpu_store_ptr(bitset_run_ptr, fn);
+	return fn(dst, x, y, n, op);
+}
+#elif defined(_bitset_neon)
+_bitset_alwaysinline static uint64x2_t bitset_op_neon(uint64x2_t a, uint64x2_t b, int op) {
+	switch (op) {
+	case BITSET_AND_COUNT:
+	case BITSET_AND:
+		return vandq_u64(a, b);
+	case BITSET_OR:
+		return vorrq_u64(a, b);
+	case BITSET_XOR:
+		return veorq_u64(a, b);
+	case BITSET_ANDNOT:
+		return vbicq_u64(a, b);
+	default:
+		return a;
+	}
+}
+
+/* Byte counts from cnt are summed for 31 vectors at a time, as on x86. */
+_bitset_alwaysinline static size_t bitset_loop_neon(u64 *dst, const u64 *x, const u64 *y, size_t n, int op) {
+	uint64x2_t total = vdupq_n_u64(0);
+	size_t i = 0;
+	while (i + 2 <= n) {
+		size_t end = n - i >= 2 * 31 ? i + 2 * 31 : n - (n - i) % 2;
+		uint8x16_t acc = vdupq_n_u8(0);
+		for (; i < end; i += 2) {
+			uint64x2_t v = vld1q_u64(x + i);
+			if (op != BITSET_COUNT)
+				v = bitset_op_neon(v, vld1q_u64(y + i), op);
+			if (op >= BITSET_AND)
+				vst1q_u64(dst + i, v);
+			acc = vaddq_u8(acc, vcntq_u8(vreinterpretq_u8_u64(v)));
+		}
+		total = vpadalq_u32(total, vpaddlq_u16(vpaddlq_u8(acc)));
+	}
+	return (size_t) (vgetq_lane_u64(total, 0) + vgetq_lane_u64(total, 1)) + bitset_loop(dst + i, x + i, y + i, n - i, op, false);
+}
+
+static size_t bitset_run(u64 *dst, const u64 *x, const u64 *y, size_t n, int op) {
+	switch (op) {
+	case BITSET_AND_COUNT: return bitset_loop_neon(dst, x, y, n, BITSET_AND_COUNT);
+	case BITSET_AND: return bitset_loop_neon(dst, x, y, n, BITSET_AND);
+	case BITSET_OR: return bitset_loop_neon(dst, x, y, n, BITSET_OR);
+	case BITSET_XOR: return bitset_loop_neon(dst, x, y, n, BITSET_XOR);
+	case BITSET_ANDNOT: return bitset_loop_neon(dst, x, y, n, BITSET_ANDNOT);
+	default: return bitset_loop_neon(dst, x, y, n, BITSET_COUNT);
+	}
+}
+#else
+# define bitset_run bitset_run_scalar
+#endif
+
+size_t bitset_count(const u64 *b, size_t words) {
+	return bitset_run(NULL, b, NULL, words, BITSET_COUNT);
+}
+
+size_t bitset_and_count(const u64 *x, const u64 *y, size_t words) {
+	return bitset_run(NULL, x, y, words, BITSET_AND_COUNT);
+}
+
+size_t bitset_and(u64 *dst, const u64 *x, const u64 *y, size_t words) {
+	return bitset_run(dst, x, y, words, BITSET_AND);
+}
+
+size_t bitset_or(u64 *dst, const u64 *x, const u64 *y, size_t words) {
+	return bitset_run(dst, x, y, words, BITSET_OR);
+}
+
+size_t bitset_xor(u64 *dst, const u64 *x, const u64 *y, size_t words) {
+	return bitset_run(dst, x, y, words, BITSET_XOR);
+}
+
+size_t bitset_andnot(u64 *dst, const u64 *x, const u64 *y, size_t words) {
+	return bitset_run(dst, x, y, words, BITSET_ANDNOT);
+}
+
+size_t bitset_next(const u64 *b, size_t words, size_t i) {
+	size_t w = i / 64;
+	u64 v;
+	if (w >= words)
+		return words * 64;
+	for (v = b[w] & (~imm_u64(0) << (i % 64)); v == 0; v = b[w])
+		if (++w == words)
+			return words * 64;
+	return w * 64 + ctz_u64(v);
+}
+
+size_t bitset_extract(u32 *dst, const u64 *b, size_t words, u32 base) {
+	u32 *p = dst;
+	size_t w;
+	for (w = 0; w < words; ++w, base += 64) {
+		u64 v = b[w];
+		for (; v != 0; v &= v - 1)
+			*p++ = base + ctz_u64(v);
+	}
+	return (size_t) (p - dst);
+}
+
+bool bitset_index_init(struct bitset_index *x, const u64 *b, size_t words) {
+	size_t blocks = words / 8 + 1, ones = 0, nsamples = 0, i, k;
+	memset(x, 0, sizeof *x);
+	if (blocks > UINT32_MAX || blocks > SIZE_MAX / (2 * sizeof *x->counts))
+		return false;
+	x->counts = (u64 *) malloc(blocks * 2 * sizeof *x->counts);
+	if (x->counts == NULL)
+		return false;
+	for (i = 0; i < blocks; ++i) {
+		u64 sub = 0;
+		size_t n = 0;
+		x->counts[i * 2] = ones;
+		for (k = 0; k < 8; ++k) {
+			if (k != 0)
+				sub |= (u64) n << (9 * k - 9);
+			if (i * 8 + k < words)
+				n += popcount_u64(b[i * 8 + k]);
+		}
+		x->counts[i * 2 + 1] = sub;
+		ones += n;
+	}
+
+	x->samples = (u32 *) malloc((ones / BITSET_SAMPLE + 1) * sizeof *x->samples);
+	if (x->samples == NULL) {
+		bitset_index_free(x);
+		return false;
+	}
+	for (i = 0; i < blocks; ++i) {
+		size_t end = i + 1 < blocks ? (size_t) x->counts[i * 2 + 2] : ones;
+		for (; nsamples * BITSET_SAMPLE < end; ++nsamples)
+			x->samples[nsamples] = (u32) i;
+	}
+
+	x->bits = b;
+	x->words = words;
+	x->blocks = blocks;
+	x->ones = ones;
+	return true;
+}
+
+void bitset_index_free(struct bitset_index *x) {
+	free(x->counts);
+	free(x->samples);
+	x->counts = NULL;
+	x->samples = NULL;
+}
+
+#define BITSET_ONES9 imm_u64(0x0040201008040201)
+#define BITSET_MSBS9 (BITSET_ONES9 << 8)
+
+/* Finds the last block that starts at or before the nth set bit, between
+   the samples on either side, then the word within it by comparing n with
+   all seven packed counts at once (Vigna's broadword <=). */
+_bitset_alwaysinline static size_t bitset_select_with(const struct bitset_index *x, size_t n, u32 (*nth)(u64 v, u32 n)) {
+	size_t j = n / BITSET_SAMPLE, lo, hi, w;
+	u64 sub, rem, le;
+	u32 k;
+	if (n >= x->ones)
+		return x->words * 64;
+	lo = x->samples[j];
+	hi = j + 1 < (x->ones + BITSET_SAMPLE - 1) / BITSET_SAMPLE ? x->samples[j + 1] : x->blocks - 1;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo + 1) / 2;
+		if (x->counts[mid * 2] <= n)
+			lo = mid;
+		else
+			hi = mid - 1;
+	}
+	rem = n - x->counts[lo * 2];
+	sub = x->counts[lo * 2 + 1];
+	le = rem * BITSET_ONES9;
+	le = ((((le | BITSET_MSBS9) - (sub & ~BITSET_MSBS9)) | (sub ^ le)) ^ (sub & ~le)) & BITSET_MSBS9;
+	k = (u32) (((le >> 8) * BITSET_ONES9) >> 54) & 7;
+	rem -= sub >> ((9 * k - 9) & 63) & (-(u64) (k != 0) & 511);
+	w = lo * 8 + k;
+	return w * 64 + nth(x->bits[w], (u32) rem);
+}
+
+static u32 bitset_nth(u64 v, u32 n) { return nthbit_u64(v, n); }
+
+#if defined(_cpu_dispatch_x86) && (defined(__x86_64__) || defined(_M_X64))
+typedef size_t (*bitset_select_fn)(const struct bitset_index *x, size_t n);
+
+static size_t bitset_select_generic(const struct bitset_index *x, size_t n) {
+	return bitset_select_with(x, n, bitset_nth);
+}
+
+_cpu_target("bmi,bmi2")
+static u32 bitset_nth_bmi2(u64 v, u32 n) { return (u32) _tzcnt_u64(_pdep_u64(imm_u64(1) << n, v)); }
+
+_cpu_target("bmi,bmi2")
+static size_t bitset_select_bmi2(const struct bitset_index *x, size_t n) {
+	return bitset_select_with(x, n, bitset_nth_bmi2);
+}
+
+static size_t bitset_select_resolve(const struct bitset_index *x, size_t n);
+static _cpu_ptr(bitset_select_fn) bitset_select_run_ptr = bitset_select_resolve;
+#define bitset_select_run _cpu_load_ptr(bitset_select_run_ptr)
+
+static size_t bitset_select_resolve(const struct bitset_index *x, size_t n) {
+	bitset_select_fn fn = bitset_select_generic;
+	if (cpu_has(CPU_BMI1 | CPU_BMI2))
+		fn = bitset_select_bmi2;
+	_cpu_store_ptr(bitset_select_run_ptr, fn);
+	return fn(x, n);
+}
+
+size_t bitset_select(const struct bitset_index *x, size_t n) {
+	return bitset_select_run(x, n);
+}
+#else
+size_t bitset_select(const struct bitset_index *x, size_t n) {
+	return bitset_select_with(x, n, bitset_nth);
+}
+#endif
@@ -0,0 +1,187 @@
+
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+#ifndef AW_BITSET_H
+#define AW_BITSET_H
+
+#include "aw-arith.h"
+
+#include <stddef.h>
+
+#if defined(_bitset_dllexport)
+# if defined(_MSC_VER)
+#  define _bitset_api extern __declspec(dllexport)
+# elif defined(__GNUC__)
+#  define _bitset_api __attribute__((visibility("default"))) extern
+# endif
+#elif defined(_bitset_dllimport)
+# if defined(_MSC_VER)
+#  define _bitset_api extern __declspec(dllimport)
+# endif
+#endif
+#ifndef _bitset_api
+# define _bitset_api extern
+#endif
+
+#if defined(__GNUC__)
+# define _bitset_alwaysinline __attribute__((always_inline)) inline
+#elif defined(_MSC_VER)
+# define _bitset_alwaysinline __forceinline
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A bitset is an array of 64-bit words with bit i at bit i % 64 of word
+   i / 64. Sizes are given in words; bits past the end of a set that is
+   not a whole number of words must be kept clear for the counts to hold. */
+#define BITSET_WORDS(bits) (((bits) + 63) / 64)
+
+_bitset_alwaysinline static bool bitset_test(const u64 *b, size_t i) { return (b[i / 64] >> (i % 64) & 1) != 0; }
+_bitset_alwaysinline static void bitset_set(u64 *b, size_t i) { b[i / 64] |= imm_u64(1) << (i % 64); }
+_bitset_alwaysinline static void bitset_clear(u64 *b, size_t i) { b[i / 64] &= ~(imm_u64(1) << (i % 64)); }
+_bitset_alwaysinline static void bitset_flip(u64 *b, size_t i) { b[i / 64] ^= imm_u64(1) << (i % 64); }
+
+_bitset_alwaysinline static void bitset_assign(u64 *b, size_t i, bool v) {
+	u64 m = imm_u64(1) << (i % 64);
+	b[i / 64] = (b[i / 64] & ~m) | (-(u64) v & m);
+}
+
+/* Position of the nth (from 0) set bit of a word; n must be below its
+   population count. Without BMI2 this takes two rounds of bytewise prefix
+   counts, first over the word and then over the bits of the byte found. */
+_bitset_alwaysinline static u32 nthbit_u64(u64 x, u32 n) {
+#if defined(__BMI2__) && defined(_arith_sse2_64)
+	return ctz_u64(_pdep_u64(imm_u64(1) << n, x));
+#else
+	const u64 ones = imm_u64(0x0101010101010101), msbs = ones << 7;
+	u64 c = x - ((x >> 1) & imm_u64(0x5555555555555555));
+	u32 i;
+	c = (c & imm_u64(0x3333333333333333)) + ((c >> 2) & imm_u64(0x3333333333333333));
+	c = ((c + (c >> 4)) & imm_u64(0x0f0f0f0f0f0f0f0f)) * ones;
+	/* Byte k of c counts the bits in bytes 0 to k; the first count above n
+	   marks the byte holding the bit. */
+	i = ctz_u64(((c | msbs) - (n + 1) * ones) & msbs) & ~7u;
+	n -= (u32) (c << 8 >> i) & 0xff;
+	/* Bit k of that byte, alone in byte k, then counted the same way. */
+	c = (((x >> i) & 0xff) * ones) & imm_u64(0x8040201008040201);
+	c = (((c | ((c & ~msbs) + ~msbs)) & msbs) >> 7) * ones;
+	return i + (ctz_u64(((c | msbs) - (n + 1) * ones) & msbs) >> 3);
+#endif
+}
+
+/* The bulk operations combine whole words, write the result to dst, which
+   may be either input, and return its population count. They run 256 bits
+   at a time with AVX2 and 128 with NEON. */
+_bitset_api size_t bitset_count(const u64 *b, size_t words);
+_bitset_api size_t bitset_and_count(const u64 *x, const u64 *y, size_t words);
+_bitset_api size_t bitset_and(u64 *dst, const u64 *x, const u64 *y, size_t words);
+_bitset_api size_t bitset_or(u64 *dst, const u64 *x, const u64 *y, size_t words);
+_bitset_api size_t bitset_xor(u64 *dst, const u64 *x, const u64 *y, size_t words);
+_bitset_api size_t bitset_andnot(u64 *dst, const u64 *x, const u64 *y, size_t words);
+
+/* Index of the first set bit at or after bit i, or words * 64 if none. */
+_bitset_api size_t bitset_next(const u64 *b, size_t words, size_t i);
+
+/* Writes the positions of all set bits in increasing order, plus base, and
+   returns how many there were; dst must have room for bitset_count(). */
+_bitset_api size_t bitset_extract(u32 *dst, const u64 *b, size_t words, u32 base);
+
+/* Visits set bits in increasing order, one word at a time:
+
+	struct bitset_iter it;
+	size_t i;
+
+	bitset_iter_init(&it, b, words);
+	while (bitset_iter_next(&it, &i))
+		...
+
+   Changes to words already loaded are not seen. */
+struct bitset_iter {
+	const u64 *bits;
+	size_t words;
+	size_t index;
+	u64 word;
+};
+
+_bitset_alwaysinline static void bitset_iter_init(struct bitset_iter *it, const u64 *b, size_t words) {
+	it->bits = b;
+	it->words = words;
+	it->index = 0;
+	it->word = words != 0 ? b[0] : 0;
+}
+
+_bitset_alwaysinline static bool bitset_iter_next(struct bitset_iter *it, size_t *i) {
+	while (it->word == 0) {
+		if (it->index + 1 >= it->words)
+			return false;
+		it->word = it->bits[++it->index];
+	}
+	*i = it->index * 64 + ctz_u64(it->word);
+	it->word &= it->word - 1;
+	return true;
+}
+
+/* A rank/select index over a bitset that no longer changes, in the style
+   of Vigna's rank9. Every 512-bit block keeps the count of set bits before
+   it and, packed in nine bits each, the counts before each of its words,
+   which adds 25% to the size of the set. Rank is then two loads and a
+   popcount. Select starts from a sample of the block holding every
+   512th set bit and searches the blocks up to the next sample, which is a
+   short distance unless the set is very sparse. */
+struct bitset_index {
+	const u64 *bits;
+	u64 *counts;
+	u32 *samples;
+	size_t words;
+	size_t blocks;
+	size_t ones;
+};
+
+#define BITSET_SAMPLE 512
+
+_bitset_api bool bitset_index_init(struct bitset_index *x, const u64 *b, size_t words);
+_bitset_api void bitset_index_free(struct bitset_index *x);
+
+_bitset_alwaysinline static size_t bitset_index_count(const struct bitset_index *x) { return x->ones; }
+
+/* Number of set bits before bit i, for i up to words * 64. */
+_bitset_alwaysinline static size_t bitset_rank(const struct bitset_index *x, size_t i) {
+	size_t w = i / 64, k = w % 8;
+	const u64 *c = x->counts + w / 8 * 2;
+	size_t r = (size_t) c[0] + (size_t) (c[1] >> ((9 * k - 9) & 63) & (-(u64) (k != 0) & 511));
+	if (i % 64 != 0)
+		r += popcount_u64(x->bits[w] & ((imm_u64(1) << (i % 64)) - 1));
+	return r;
+}
+
+/* Position of the nth (from 0) set bit, or words * 64 if there are not
+   that many. */
+_bitset_api size_t bitset_select(const struct bitset_index *x, size_t n);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* AW_BITSET_H */
@@ -0,0 +1,231 @@
+
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+#ifndef AW_BITSTREAM_H
+#define AW_BITSTREAM_H
+
+#include "aw-arith.h"
+#include "aw-endian.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__GNUC__)
+# define _bitstream_alwaysinline __attribute__((always_inline)) inline
+# define _bitstream_likely(x) __builtin_expect(!!(x), 1)
+#elif defined(_MSC_VER)
+# define _bitstream_alwaysinline __forceinline
+# define _bitstream_likely(x) (x)
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BITSTREAM_MAX_READ 57
+#define BITSTREAM_MAX_WRITE 56
+
+/* The reader refills its 64-bit buffer with a single unaligned load at the
+   current bit position, which leaves at least 57 bits to peek and consume
+   without further checks. The _lsb functions read fields starting at the
+   least significant bit of each byte (Deflate order), the _msb functions
+   starting at the most significant bit (JPEG order). Reading past the end
+   yields zeros and is reported by bitreader_ok(). */
+struct bitreader {
+	const u8 *data;
+	size_t size;
+	size_t pos;
+	u64 bits;
+	u32 count;
+};
+
+struct bitwriter {
+	u8 *data;
+	size_t size;
+	size_t pos;
+	u64 bits;
+	u32 count;
+	bool error;
+};
+
+_bitstream_alwaysinline static u64 _bitstream_mask(u32 n) { return (imm_u64(1) << n) - 1; }
+
+/* Reverses the order of the low n bits, for moving codes between orders;
+   n is at most 64, and 0 gives 0. */
+_bitstream_alwaysinline static u64 bitstream_bitreverse(u64 v, u32 n) { return n != 0 ? bitswap_u64(v) >> (64 - n) : 0; }
+
+_bitstream_alwaysinline static void bitreader_init(struct bitreader *r, const void *data, size_t size) {
+	r->data = (const u8 *) data;
+	r->size = size;
+	r->pos = 0;
+	r->bits = 0;
+	r->count = 0;
+}
+
+_bitstream_alwaysinline static size_t bitreader_tell(const struct bitreader *r) { return r->pos; }
+_bitstream_alwaysinline static bool bitreader_ok(const struct bitreader *r) { return r->pos <= r->size * 8; }
+
+_bitstream_alwaysinline static const u8 *_bitreader_window(const struct bitreader *r, u8 *tmp) {
+	size_t i = r->pos >> 3;
+	if (_bitstream_likely(i + 8 <= r->size))
+		return r->data + i;
+	memset(tmp, 0, 8);
+	if (i < r->size)
+		memcpy(tmp, r->data + i, r->size - i);
+	return tmp;
+}
+
+_bitstream_alwaysinline static void bitreader_refill_lsb(struct bitreader *r) {
+	u8 tmp[8];
+	r->bits = _load_le64(_bitreader_window(r, tmp)) >> (r->pos & 7);
+	r->count = 64 - (u32) (r->pos & 7);
+}
+
+_bitstream_alwaysinline static void bitreader_refill_msb(struct bitreader *r) {
+	u8 tmp[8];
+	r->bits = _load_be64(_bitreader_window(r, tmp)) << (r->pos & 7);
+	r->count = 64 - (u32) (r->pos & 7);
+}
+
+/* Peek and consume require 1 <= n <= count; a refill guarantees count >= 57. */
+_bitstream_alwaysinline static u64 bits_peek_lsb(const struct bitreader *r, u32 n) { return r->bits & _bitstream_mask(n); }
+_bitstream_alwaysinline static u64 bits_peek_msb(const struct bitreader *r, u32 n) { return r->bits >> (64 - n); }
+
+_bitstream_alwaysinline static void bits_consume_lsb(struct bitreader *r, u32 n) {
+	r->bits >>= n;
+	r->count -= n;
+	r->pos += n;
+}
+
+_bitstream_alwaysinline static void bits_consume_msb(struct bitreader *r, u32 n) {
+	r->bits <<= n;
+	r->count -= n;
+	r->pos += n;
+}
+
+_bitstream_alwaysinline static u64 bits_read_lsb(struct bitreader *r, u32 n) {
+	u64 v;
+	if (r->count < n)
+		bitreader_refill_lsb(r);
+	v = bits_peek_lsb(r, n);
+	bits_consume_lsb(r, n);
+	return v;
+}
+
+_bitstream_alwaysinline static u64 bits_read_msb(struct bitreader *r, u32 n) {
+	u64 v;
+	if (r->count < n)
+		bitreader_refill_msb(r);
+	v = bits_peek_msb(r, n);
+	bits_consume_msb(r, n);
+	return v;
+}
+
+/* Skips to the next byte boundary; the next read refills. */
+_bitstream_alwaysinline static void bitreader_align(struct bitreader *r) {
+	r->pos = (r->pos + 7) & ~(size_t) 7;
+	r->count = 0;
+}
+
+/* The writer stores its whole 64-bit buffer after every write and advances
+   by the completed bytes, so there is no per-byte loop or flush branch.
+   Writing past the end drops the data and sets the sticky error flag. */
+_bitstream_alwaysinline static void bitwriter_init(struct bitwriter *w, void *data, size_t size) {
+	w->data = (u8 *) data;
+	w->size = size;
+	w->pos = 0;
+	w->bits = 0;
+	w->count = 0;
+	w->error = false;
+}
+
+_bitstream_alwaysinline static bool bitwriter_ok(const struct bitwriter *w) { return !w->error; }
+
+_bitstream_alwaysinline static void _bitwriter_store(struct bitwriter *w, const u8 *tmp) {
+	size_t n = w->count >> 3;
+	if (w->pos + n > w->size) {
+		w->error = true;
+		n = w->size - w->pos;
+	}
+	memcpy(w->data + w->pos, tmp, n);
+	w->pos += n;
+}
+
+_bitstream_alwaysinline static void _bitwriter_flush_lsb(struct bitwriter *w) {
+	if (_bitstream_likely(w->pos + 8 <= w->size)) {
+		_store_le64(w->data + w->pos, w->bits);
+		w->pos += w->count >> 3;
+	} else {
+		u8 tmp[8];
+		_store_le64(tmp, w->bits);
+		_bitwriter_store(w, tmp);
+	}
+	w->bits >>= w->count & ~7u;
+	w->count &= 7;
+}
+
+_bitstream_alwaysinline static void _bitwriter_flush_msb(struct bitwriter *w) {
+	u64 top = w->bits << (64 - w->count);
+	if (_bitstream_likely(w->pos + 8 <= w->size)) {
+		_store_be64(w->data + w->pos, top);
+		w->pos += w->count >> 3;
+	} else {
+		u8 tmp[8];
+		_store_be64(tmp, top);
+		_bitwriter_store(w, tmp);
+	}
+	w->count &= 7;
+}
+
+/* Writes the low n bits of v, 1 <= n <= 56; higher bits of v must be zero. */
+_bitstream_alwaysinline static void bits_write_lsb(struct bitwriter *w, u64 v, u32 n) {
+	w->bits |= v << w->count;
+	w->count += n;
+	_bitwriter_flush_lsb(w);
+}
+
+_bitstream_alwaysinline static void bits_write_msb(struct bitwriter *w, u64 v, u32 n) {
+	w->bits = w->bits << n | v;
+	w->count += n;
+	_bitwriter_flush_msb(w);
+}
+
+/* Pads the last partial byte with zero bits and returns the size in bytes. */
+_bitstream_alwaysinline static size_t bitwriter_finish_lsb(struct bitwriter *w) {
+	if (w->count != 0)
+		bits_write_lsb(w, 0, 8 - w->count);
+	return w->pos;
+}
+
+_bitstream_alwaysinline static size_t bitwriter_finish_msb(struct bitwriter *w) {
+	if (w->count != 0)
+		bits_write_msb(w, 0, 8 - w->count);
+	return w->pos;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* AW_BITSTREAM_H */
+
@@ -0,0 +1,596 @@
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+#include "aw-bytes.h"
+#include "aw-cpu.h"
+
+#include <string.h>
+
+#if (defined(__aarch64__) || defined(_M_ARM64)) && !defined(__ARM_BIG_ENDIAN)
+# include <arm_neon.h>
+# define _bytes_neon 1
+#endif
+
+static const char HEX_DIGITS[2][17] = { "0123456789abcdef", "0123456789ABCDEF" };
+
+static const char BASE64_ENCODE[2][65] = {
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/",
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_",
+};
+
+/* Digit values, and 0xff for characters outside the alphabet. */
+static const u8 HEX_DECODE[256] = {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+};
+
+static const u8 BASE64_DECODE[2][256] = { {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3e, 0xff, 0xff, 0xff, 0x3f,
+	0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+	0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+	0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+}, {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3e, 0xff, 0xff,
+	0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+	0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xff, 0xff, 0xff, 0xff, 0x3f,
+	0xff, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+	0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+} };
+
+/* Vector kernels classify a character by its nibbles, as described by
+   Muła and Lemire: each high nibble is a bit in LO_INVALID for every low
+   nibble that makes no valid character with it, and a character is valid
+   when the two lookups share no bits. Its value is then the character plus
+   an offset picked by the high nibble, except for the character for 63,
+   which shares its high nibble with others. Encoding maps 6-bit values to
+   the same classes and back. */
+#if defined(_cpu_dispatch_x86)
+static const u8 BASE64_LO_INVALID[2][16] = {
+	{ 0x0b, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x07, 0x15, 0x17, 0x17, 0x17, 0x15 },
+	{ 0x0b, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x07, 0x37, 0x37, 0x35, 0x37, 0x27 },
+};
+
+static const u8 BASE64_HI_CLASS[2][16] = {
+	{ 0x01, 0x01, 0x02, 0x04, 0x08, 0x10, 0x08, 0x10, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01 },
+	{ 0x01, 0x01, 0x02, 0x04, 0x08, 0x10, 0x08, 0x20, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01 },
+};
+
+static const s8 BASE64_ROLL[2][16] = {
+	{ 0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0 },
+	{ 0, 0, 17, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0 },
+};
+
+static const char BASE64_CHAR63[2] = { '/', '_' };
+static const s8 BASE64_ROLL63[2] = { 16, -32 };
+
+/* Offsets from 6-bit values to characters, indexed by range: 0 for
+   'a'..'z', 1 to 10 for the digits, 11 and 12 for 62 and 63, 13 for
+   'A'..'Z'. */
+static const s8 BASE64_SHIFT[2][16] = {
+	{ 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 65, 0, 0 },
+	{ 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -17, 32, 65, 0, 0 },
+};
+#endif
+
+/*
+ * Scalar conversions, which also finish what the kernels leave
+ */
+
+static void hex_encode_scalar(char *dst, const u8 *src, size_t size, const char *digits) {
+	size_t i;
+	for (i = 0; i < size; ++i) {
+		dst[i * 2] = digits[src[i] >> 4];
+		dst[i * 2 + 1] = digits[src[i] & 0x0f];
+	}
+}
+
+static bool hex_decode_scalar(u8 *dst, const char *src, size_t len) {
+	u32 bad = 0;
+	size_t i;
+	for (i = 0; i < len; i += 2) {
+		u32 h = HEX_DECODE[(u8) src[i]], l = HEX_DECODE[(u8) src[i + 1]];
+		bad |= h | l;
+		dst[i / 2] = (u8) (h << 4 | l);
+	}
+	return (bad & 0xf0) == 0;
+}
+
+static void base64_encode_scalar(char *dst, const u8 *src, size_t size, const char *alphabet) {
+	size_t i;
+	for (i = 0; i + 3 <= size; i += 3, dst += 4) {
+		u32 v = (u32) src[i] << 16 | (u32) src[i + 1] << 8 | src[i + 2];
+		dst[0] = alphabet[v >> 18];
+		dst[1] = alphabet[v >> 12 & 0x3f];
+		dst[2] = alphabet[v >> 6 & 0x3f];
+		dst[3] = alphabet[v & 0x3f];
+	}
+}
+
+/* Whole groups of four characters only. */
+static bool base64_decode_scalar(u8 *dst, const char *src, size_t len, const u8 *table) {
+	u32 bad = 0;
+	size_t i;
+	for (i = 0; i < len; i += 4, dst += 3) {
+		u32 a = table[(u8) src[i]], b = table[(u8) src[i + 1]];
+		u32 c = table[(u8) src[i + 2]], d = table[(u8) src[i + 3]];
+		u32 v = a << 18 | b << 12 | c << 6 | d;
+		bad |= a | b | c | d;
+		dst[0] = (u8) (v >> 16);
+		dst[1] = (u8) (v >> 8);
+		dst[2] = (u8) v;
+	}
+	return (bad & 0xc0) == 0;
+}
+
+/*
+ * Kernels, which convert whole blocks and return the input they used. The
+ * decoders stop before a block with an invalid character and leave it to
+ * the scalar code, and keep a block short of the end because their stores
+ * run past the output of the last block they do.
+ */
+
+typedef size_t (*hex_encode_fn)(char *dst, const u8 *src, size_t size, const char *digits);
+typedef size_t (*hex_decode_fn)(u8 *dst, const char *src, size_t len);
+typedef size_t (*base64_encode_fn)(char *dst, const u8 *src, size_t size, u32 url);
+typedef size_t (*base64_decode_fn)(u8 *dst, const char *src, size_t len, u32 url);
+
+#if defined(_cpu_dispatch_x86)
+_cpu_target("ssse3")
+static size_t hex_encode_ssse3(char *dst, const u8 *src, size_t size, const char *digits) {
+	const __m128i lut = _mm_loadu_si128((const __m128i *) digits), nibble = _mm_set1_epi8(0x0f);
+	size_t i;
+	for (i = 0; i + 16 <= size; i += 16) {
+		__m128i in = _mm_loadu_si128((const __m128i *) (src + i));
+		__m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(in, 4), nibble));
+		__m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(in, nibble));
+		_mm_storeu_si128((__m128i *) (dst + i * 2), _mm_unpacklo_epi8(hi, lo));
+		_mm_storeu_si128((__m128i *) (dst + i * 2 + 16), _mm_unpackhi_epi8(hi, lo));
+	}
+	return i;
+}
+
+/* Digit values, or -1 in ok where a character is no digit. */
+_cpu_target("ssse3")
+_bytes_alwaysinline static __m128i hex_value_ssse3(__m128i in, __m128i *ok) {
+	__m128i d = _mm_sub_epi8(in, _mm_set1_epi8('0'));
+	__m128i l = _mm_sub_epi8(_mm_or_si128(in, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+	__m128i isd = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+	__m128i isl = _mm_cmpeq_epi8(_mm_min_epu8(l, _mm_set1_epi8(5)), l);
+	*ok = _mm_and_si128(*ok, _mm_or_si128(isd, isl));
+	return _mm_or_si128(_mm_and_si128(isd, d), _mm_and_si128(isl, _mm_add_epi8(l, _mm_set1_epi8(10))));
+}
+
+_cpu_target("ssse3")
+static size_t hex_decode_ssse3(u8 *dst, const char *src, size_t len) {
+	const __m128i weights = _mm_set1_epi16(0x0110);
+	size_t i;
+	for (i = 0; i + 32 <= len; i += 32) {
+		__m128i ok = _mm_set1_epi8(-1);
+		__m128i a = hex_value_ssse3(_mm_loadu_si128((const __m128i *) (src + i)), &ok);
+		__m128i b = hex_value_ssse3(_mm_loadu_si128((const __m128i *) (src + i + 16)), &ok);
+		if (_mm_movemask_epi8(ok) != 0xffff)
+			break;
+		_mm_storeu_si128((__m128i *) (dst + i / 2), _mm_packus_epi16(_mm_maddubs_epi16(a, weights), _mm_maddubs_epi16(b, weights)));
+	}
+	return i;
+}
+
+/* Spreads 12 bytes into 16 6-bit values (Muła) and looks up characters. */
+_cpu_target("ssse3")
+_bytes_alwaysinline static __m128i base64_encode_block_ssse3(__m128i in, __m128i shift) {
+	__m128i hi, lo, idx, r;
+	in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+	hi = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+	lo = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+	idx = _mm_or_si128(hi, lo);
+	r = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+	r = _mm_or_si128(r, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), idx), _mm_set1_epi8(13)));
+	return _mm_add_epi8(_mm_shuffle_epi8(shift, r), idx);
+}
+
+_cpu_target("ssse3")
+static size_t base64_encode_ssse3(char *dst, const u8 *src, size_t size, u32 url) {
+	const __m128i shift = _mm_loadu_si128((const __m128i *) BASE64_SHIFT[url]);
+	size_t i;
+	for (i = 0; i + 16 <= size; i += 12, dst += 16)
+		_mm_storeu_si128((__m128i *) dst, base64_encode_block_ssse3(_mm_loadu_si128((const __m128i *) (src + i)), shift));
+	return i;
+}
+
+_cpu_target("ssse3")
+static size_t base64_decode_ssse3(u8 *dst, const char *src, size_t len, u32 url) {
+	const __m128i lo_invalid = _mm_loadu_si128((const __m128i *) BASE64_LO_INVALID[url]);
+	const __m128i hi_class = _mm_loadu_si128((const __m128i *) BASE64_HI_CLASS[url]);
+	const __m128i roll = _mm_loadu_si128((const __m128i *) BASE64_ROLL[url]);
+	const __m128i char63 = _mm_set1_epi8(BASE64_CHAR63[url]), roll63 = _mm_set1_epi8(BASE64_ROLL63[url]);
+	const __m128i nibble = _mm_set1_epi8(0x0f), zero = _mm_setzero_si128();
+	const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+	size_t i;
+	for (i = 0; i + 16 + 8 <= len; i += 16, dst += 12) {
+		__m128i in = _mm_loadu_si128((const __m128i *) (src + i));
+		__m128i hi = _mm_and_si128(_mm_srli_epi32(in, 4), nibble);
+		__m128i bad = _mm_and_si128(_mm_shuffle_epi8(lo_invalid, _mm_and_si128(in, nibble)), _mm_shuffle_epi8(hi_class, hi));
+		__m128i is63 = _mm_cmpeq_epi8(in, char63), v;
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(bad, zero)) != 0xffff)
+			break;
+		v = _mm_add_epi8(in, _mm_or_si128(_mm_andnot_si128(is63, _mm_shuffle_epi8(roll, hi)), _mm_and_si128(is63, roll63)));
+		v = _mm_madd_epi16(_mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+		_mm_storeu_si128((__m128i *) dst, _mm_shuffle_epi8(v, pack));
+	}
+	return i;
+}
+
+_cpu_target("avx2")
+static size_t hex_encode_avx2(char *dst, const u8 *src, size_t size, const char *digits) {
+	const __m256i lut = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) digits));
+	const __m256i nibble = _mm256_set1_epi8(0x0f);
+	size_t i;
+	for (i = 0; i + 32 <= size; i += 32) {
+		__m256i in = _mm256_loadu_si256((const __m256i *) (src + i));
+		__m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(in, 4), nibble));
+		__m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(in, nibble));
+		__m256i a = _mm256_unpacklo_epi8(hi, lo), b = _mm256_unpackhi_epi8(hi, lo);
+		_mm256_storeu_si256((__m256i *) (dst + i * 2), _mm256_permute2x128_si256(a, b, 0x20));
+		_mm256_storeu_si256((__m256i *) (dst + i * 2 + 32), _mm256_permute2x128_si256(a, b, 0x31));
+	}
+	return i;
+}
+
+_cpu_target("avx2")
+_bytes_alwaysinline static __m256i hex_value_avx2(__m256i in, __m256i *ok) {
+	__m256i d = _mm256_sub_epi8(in, _mm256_set1_epi8('0'));
+	__m256i l = _mm256_sub_epi8(_mm256_or_si256(in, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+	__m256i isd = _mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(9)), d);
+	__m256i isl = _mm256_cmpeq_epi8(_mm256_min_epu8(l, _mm256_set1_epi8(5)), l);
+	*ok = _mm256_and_si256(*ok, _mm256_or_si256(isd, isl));
+	return _mm256_or_si256(_mm256_and_si256(isd, d), _mm256_and_si256(isl, _mm256_add_epi8(l, _mm256_set1_epi8(10))));
+}
+
+_cpu_target("avx2")
+static size_t hex_decode_avx2(u8 *dst, const char *src, size_t len) {
+	const __m256i weights = _mm256_set1_epi16(0x0110);
+	size_t i;
+	for (i = 0; i + 64 <= len; i += 64) {
+		__m256i ok = _mm256_set1_epi8(-1);
+		__m256i a = hex_value_avx2(_mm256_loadu_si256((const __m256i *) (src + i)), &ok);
+		__m256i b = hex_value_avx2(_mm256_loadu_si256((const __m256i *) (src + i + 32)), &ok);
+		if (_mm256_movemask_epi8(ok) != -1)
+			break;
+		a = _mm256_packus_epi16(_mm256_maddubs_epi16(a, weights), _mm256_maddubs_epi16(b, weights));
+		_mm256_storeu_si256((__m256i *) (dst + i / 2), _mm256_permute4x64_epi64(a, 0xd8));
+	}
+	return i;
+}
+
+_cpu_target("avx2")
+static size_t base64_encode_avx2(char *dst, const u8 *src, size_t size, u32 url) {
+	const __m256i shift = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) BASE64_SHIFT[url]));
+	const __m256i spread = _mm256_setr_epi8(
+		1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+		1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+	size_t i;
+	for (i = 0; i + 28 <= size; i += 24, dst += 32) {
+		__m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(
+			_mm_loadu_si128((const __m128i *) (src + i))), _mm_loadu_si128((const __m128i *) (src + i + 12)), 1);
+		__m256i hi, lo, idx, r;
+		in = _mm256_shuffle_epi8(in, spread);
+		hi = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+		lo = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+		idx = _mm256_or_si256(hi, lo);
+		r = _mm256_subs_epu8(idx, _mm256_set1_epi8(51));
+		r = _mm256_or_si256(r, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), idx), _mm256_set1_epi8(13)));
+		_mm256_storeu_si256((__m256i *) dst, _mm256_add_epi8(_mm256_shuffle_epi8(shift, r), idx));
+	}
+	return i;
+}
+
+_cpu_target("avx2")
+static size_t base64_decode_avx2(u8 *dst, const char *src, size_t len, u32 url) {
+	const __m256i lo_invalid = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) BASE64_LO_INVALID[url]));
+	const __m256i hi_class = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) BASE64_HI_CLASS[url]));
+	const __m256i roll = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) BASE64_ROLL[url]));
+	const __m256i char63 = _mm256_set1_epi8(BASE64_CHAR63[url]), roll63 = _mm256_set1_epi8(BASE64_ROLL63[url]);
+	const __m256i nibble = _mm256_set1_epi8(0x0f);
+	const __m256i pack = _mm256_setr_epi8(
+		2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+		2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+	size_t i;
+	for (i = 0; i + 32 + 16 <= len; i += 32, dst += 24) {
+		__m256i in = _mm256_loadu_si256((const __m256i *) (src + i));
+		__m256i hi = _mm256_and_si256(_mm256_srli_epi32(in, 4), nibble);
+		__m256i bad = _mm256_and_si256(_mm256_shuffle_epi8(lo_invalid, _mm256_and_si256(in, nibble)), _mm256_shuffle_epi8(hi_class, hi));
+		__m256i is63 = _mm256_cmpeq_epi8(in, char63), v;
+		if (!_mm256_testz_si256(bad, bad))
+			break;
+		v = _mm256_add_epi8(in, _mm256_blendv_epi8(_mm256_shuffle_epi8(roll, hi), roll63, is63));
+		v = _mm256_madd_epi16(_mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+		v = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(v, pack), _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+		_mm256_storeu_si256((__m256i *) dst, v);
+	}
+	return i;
+}
+
+static size_t hex_encode_none(char *dst, const u8 *src, size_t size, const char *digits) { (void) dst, (void) src, (void) size, (void) digits; return 0; }
+static size_t hex_decode_none(u8 *dst, const char *src, size_t len) { (void) dst, (void) src, (void) len; return 0; }
+static size_t base64_encode_none(char *dst, const u8 *src, size_t size, u32 url) { (void) dst, (void) src, (void) size, (void) url; return 0; }
+static size_t base64_decode_none(u8 *dst, const char *src, size_t len, u32 url) { (void) dst, (void) src, (void) len, (void) url; return 0; }
+
+static size_t hex_encode_resolve(char *dst, const u8 *src, size_t size, const char *digits);
+static size_t hex_decode_resolve(u8 *dst, const char *src, size_t len);
+static size_t base64_encode_resolve(char *dst, const u8 *src, size_t size, u32 url);
+static size_t base64_decode_resolve(u8 *dst, const char *src, size_t len, u32 url);
+static _cpu_ptr(hex_encode_fn) hex_encode_kernel_ptr = hex_encode_resolve;
+#define hex_encode_kernel _cpu_load_ptr(hex_encode_kernel_ptr)
+static _cpu_ptr(hex_decode_fn) hex_decode_kernel_ptr = hex_decode_resolve;
+#define hex_decode_kernel _cpu_load_ptr(hex_decode_kernel_ptr)
+static _cpu_ptr(base64_encode_fn) base64_encode_kernel_ptr = base64_encode_resolve;
+#define base64_encode_kernel _cpu_load_ptr(base64_encode_kernel_ptr)
+static _cpu_ptr(base64_decode_fn) base64_decode_kernel_ptr = base64_decode_resolve;
+#define base64_decode_kernel _cpu_load_ptr(base64_decode_kernel_ptr)
+
+static void bytes_resolve(void) {
+	if (cpu_has(CPU_AVX2)) {
+		_cpu_store_ptr(hex_encode_kernel_ptr, hex_encode_avx2);
+		_cpu_store_ptr(hex_decode_kernel_ptr, hex_decode_avx2);
+		_cpu_store_ptr(base64_encode_kernel_ptr, base64_encode_avx2);
+		_cpu_store_ptr(base64_decode_kernel_ptr, base64_decode_avx2);
+	} else if (cpu_has(CPU_SSSE3)) {
+		_cpu_store_ptr(hex_encode_kernel_ptr, hex_encode_ssse3);
+		_cpu_store_ptr(hex_decode_kernel_ptr, hex_decode_ssse3);
+		_cpu_store_ptr(base64_encode_kernel_ptr, base64_encode_ssse3);
+		_cpu_store_ptr(base64_decode_kernel_ptr, base64_decode_ssse3);
+	} else {
+		_cpu_store_ptr(hex_encode_kernel_ptr, hex_encode_none);
+		_cpu_store_ptr(hex_decode_kernel_ptr, hex_decode_none);
+		_cpu_store_ptr(base64_encode_kernel_ptr, base64_encode_none);
+		_cpu_store_ptr(base64_decode_kernel_ptr, base64_decode_none);
+	}
+}
+
+static size_t hex_encode_resolve(char *dst, const u8 *src, size_t size, const char *digits) {
+	bytes_resolve();
+	return hex_encode_kernel(dst, src, size, digits);
+}
+
+static size_t hex_decode_resolve(u8 *dst, const char *src, size_t len) {
+	bytes_resolve();
+	return hex_decode_kernel(dst, src, len);
+}
+
+static size_t base64_encode_resolve(char *dst, const u8 *src, size_t size, u32 url) {
+	bytes_resolve();
+	return base64_encode_kernel(dst, src, size, url);
+}
+
+static size_t base64_decode_resolve(u8 *dst, const char *src, size_t len, u32 url) {
+	bytes_resolve();
+	return base64_decode_kernel(dst, src, len, url);
+}
+#elif defined(_bytes_neon)
+static size_t hex_encode_kernel(char *dst, const u8 *src, size_t size, const char *digits) {
+	const uint8x16_t lut = vld1q_u8((const u8 *) digits), nibble = vdupq_n_u8(0x0f);
+	size_t i;
+	for (i = 0; i + 16 <= size; i += 16) {
+		uint8x16_t in = vld1q_u8(src + i);
+		uint8x16x2_t out;
+		out.val[0] = vqtbl1q_u8(lut, vshrq_n_u8(in, 4));
+		out.val[1] = vqtbl1q_u8(lut, vandq_u8(in, nibble));
+		vst2q_u8((u8 *) dst + i * 2, out);
+	}
+	return i;
+}
+
+_bytes_alwaysinline static uint8x16_t hex_value_neon(uint8x16_t in, uint8x16_t *ok) {
+	uint8x16_t d = vsubq_u8(in, vdupq_n_u8('0'));
+	uint8x16_t l = vsubq_u8(vorrq_u8(in, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+	uint8x16_t isd = vcleq_u8(d, vdupq_n_u8(9)), isl = vcleq_u8(l, vdupq_n_u8(5));
+	*ok = vandq_u8(*ok, vorrq_u8(isd, isl));
+	return vbslq_u8(isd, d, vaddq_u8(l, vdupq_n_u8(10)));
+}
+
+static size_t hex_decode_kernel(u8 *dst, const char *src, size_t len) {
+	size_t i;
+	for (i = 0; i + 32 <= len; i += 32) {
+		uint8x16x2_t in = vld2q_u8((const u8 *) src + i);
+		uint8x16_t ok = vdupq_n_u8(0xff);
+		uint8x16_t hi = hex_value_neon(in.val[0], &ok), lo = hex_value_neon(in.val[1], &ok);
+		if (vminvq_u8(ok) == 0)
+			break;
+		vst1q_u8(dst + i / 2, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+	}
+	return i;
+}
+
+static size_t base64_encode_kernel(char *dst, const u8 *src, size_t size, u32 url) {
+	const u8 *alphabet = (const u8 *) BASE64_ENCODE[url];
+	const uint8x16_t mask = vdupq_n_u8(0x3f);
+	uint8x16x4_t lut, out;
+	size_t i;
+	lut.val[0] = vld1q_u8(alphabet);
+	lut.val[1] = vld1q_u8(alphabet + 16);
+	lut.val[2] = vld1q_u8(alphabet + 32);
+	lut.val[3] = vld1q_u8(alphabet + 48);
+	for (i = 0; i + 48 <= size; i += 48, dst += 64) {
+		uint8x16x3_t in = vld3q_u8(src + i);
+		out.val[0] = vqtbl4q_u8(lut, vshrq_n_u8(in.val[0], 2));
+		out.val[1] = vqtbl4q_u8(lut, vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), mask));
+		out.val[2] = vqtbl4q_u8(lut, vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), mask));
+		out.val[3] = vqtbl4q_u8(lut, vandq_u8(in.val[2], mask));
+		vst4q_u8((u8 *) dst, out);
+	}
+	return i;
+}
+
+/* Characters from 128 up miss both lookups and are flagged separately. */
+_bytes_alwaysinline static uint8x16_t base64_value_neon(uint8x16_t c, const uint8x16x4_t *lo, const uint8x16x4_t *hi) {
+	uint8x16_t v = vqtbx4q_u8(vqtbl4q_u8(*lo, c), *hi, vsubq_u8(c, vdupq_n_u8(64)));
+	return vorrq_u8(v, vcgeq_u8(c, vdupq_n_u8(128)));
+}
+
+static size_t base64_decode_kernel(u8 *dst, const char *src, size_t len, u32 url) {
+	const u8 *table = BASE64_DECODE[url];
+	uint8x16x4_t lo, hi;
+	size_t i;
+	for (i = 0; i < 4; ++i) {
+		lo.val[i] = vld1q_u8(table + i * 16);
+		hi.val[i] = vld1q_u8(table + 64 + i * 16);
+	}
+	for (i = 0; i + 64 <= len; i += 64, dst += 48) {
+		uint8x16x4_t in = vld4q_u8((const u8 *) src + i);
+		uint8x16x3_t out;
+		uint8x16_t a = base64_value_neon(in.val[0], &lo, &hi), b = base64_value_neon(in.val[1], &lo, &hi);
+		uint8x16_t c = base64_value_neon(in.val[2], &lo, &hi), d = base64_value_neon(in.val[3], &lo, &hi);
+		if (vmaxvq_u8(vorrq_u8(vorrq_u8(a, b), vorrq_u8(c, d))) > 0x3f)
+			break;
+		out.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+		out.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+		out.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+		vst3q_u8(dst, out);
+	}
+	return i;
+}
+#else
+# define hex_encode_kernel(dst, src, size, digits) ((void) (digits), (size_t) 0)
+# define hex_decode_kernel(dst, src, len) ((size_t) 0)
+# define base64_encode_kernel(dst, src, size, url) ((void) (url), (size_t) 0)
+# define base64_decode_kernel(dst, src, len, url) ((size_t) 0)
+#endif
+
+size_t hex_encode(char *dst, const void *src, size_t size, bool upper) {
+	const u8 *p = (const u8 *) src;
+	const char *digits = HEX_DIGITS[upper];
+	size_t i = hex_encode_kernel(dst, p, size, digits);
+	hex_encode_scalar(dst + i * 2, p + i, size - i, digits);
+	return size * 2;
+}
+
+size_t hex_decode(void *dst, const char *src, size_t len) {
+	u8 *p = (u8 *) dst;
+	size_t i;
+	if (len % 2 != 0)
+		return BYTES_ERROR;
+	i = hex_decode_kernel(p, src, len);
+	return hex_decode_scalar(p + i / 2, src + i, len - i) ? len / 2 : BYTES_ERROR;
+}
+
+size_t base64_encode(char *dst, const void *src, size_t size, u32 flags) {
+	const u8 *p = (const u8 *) src;
+	const char *alphabet = BASE64_ENCODE[(flags & BASE64_URL) != 0];
+	size_t i = base64_encode_kernel(dst, p, size, (flags & BASE64_URL) != 0), rest;
+	char *q = dst + i / 3 * 4;
+	base64_encode_scalar(q, p + i, size - i, alphabet);
+	q += (size - i) / 3 * 4;
+	p += size - size % 3;
+	rest = size % 3;
+	if (rest != 0) {
+		u32 v = (u32) p[0] << 16 | (rest == 2 ? (u32) p[1] << 8 : 0);
+		*q++ = alphabet[v >> 18];
+		*q++ = alphabet[v >> 12 & 0x3f];
+		if (rest == 2)
+			*q++ = alphabet[v >> 6 & 0x3f];
+		if ((flags & BASE64_NOPAD) == 0) {
+			*q++ = '=';
+			if (rest == 1)
+				*q++ = '=';
+		}
+	}
+	return (size_t) (q - dst);
+}
+
+size_t base64_decode(void *dst, const char *src, size_t len, u32 flags) {
+	u32 url = (flags & BASE64_URL) != 0;
+	const u8 *table = BASE64_DECODE[url];
+	u8 *p = (u8 *) dst;
+	size_t body = len - len % 4, rest = len % 4, i;
+	u32 a, b, c = 0;
+
+	/* The last group is kept out of the body when it has padding, and
+	   then must have two or three characters before it. */
+	if ((flags & BASE64_NOPAD) != 0) {
+		if (rest == 1)
+			return BYTES_ERROR;
+	} else {
+		if (rest != 0)
+			return BYTES_ERROR;
+		if (len != 0 && src[len - 1] == '=') {
+			rest = src[len - 2] == '=' ? 2 : 3;
+			body -= 4;
+		}
+	}
+
+	i = base64_decode_kernel(p, src, body, url);
+	if (!base64_decode_scalar(p + i / 4 * 3, src + i, body - i, table))
+		return BYTES_ERROR;
+	p += body / 4 * 3;
+	src += body;
+	if (rest == 0)
+		return (size_t) (p - (u8 *) dst);
+
+	/* Bits past the last whole byte must be clear. */
+	a = table[(u8) src[0]];
+	b = table[(u8) src[1]];
+	if (rest == 3)
+		c = table[(u8) src[2]];
+	if (((a | b | c) & 0xc0) != 0 || (rest == 2 ? b & 0x0f : c & 0x03) != 0)
+		return BYTES_ERROR;
+	*p++ = (u8) (a << 2 | b >> 4);
+	if (rest == 3)
+		*p++ = (u8) (b << 4 | c >> 2);
+	return (size_t) (p - (u8 *) dst);
+}
@@ -0,0 +1,109 @@
+
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+#ifndef AW_BYTES_H
+#define AW_BYTES_H
+
+#include "aw-types.h"
+
+#if !defined(_MSC_VER) || _MSC_VER >= 1800
+# include <stdbool.h>
+#endif
+#include <stddef.h>
+
+#if defined(_bytes_dllexport)
+# if defined(_MSC_VER)
+#  define _bytes_api extern __declspec(dllexport)
+# elif defined(__GNUC__)
+#  define _bytes_api __attribute__((visibility("default"))) extern
+# endif
+#elif defined(_bytes_dllimport)
+# if defined(_MSC_VER)
+#  define _bytes_api extern __declspec(dllimport)
+# endif
+#endif
+#ifndef _bytes_api
+# define _bytes_api extern
+#endif
+
+#if defined(__GNUC__)
+# define _bytes_alwaysinline __attribute__((always_inline)) inline
+#elif defined(_MSC_VER)
+# define _bytes_alwaysinline __forceinline
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BYTES_ERROR ((size_t) -1)
+
+/* Text encodings of binary data. Encoders write exactly the size their
+   size function gives, with no terminator, and return it. Decoders return
+   the number of bytes written, or BYTES_ERROR for input that is not a
+   valid encoding, in which case dst holds partial output. Neither skips
+   whitespace. Blocks of 16 or 32 bytes are converted at once with table
+   lookups on SSSE3, AVX2 or NEON. */
+
+/* Hex is two digits per byte, high nibble first. Encoding is in lower or
+   upper case; decoding accepts either, and fails on an odd length. */
+_bytes_alwaysinline static size_t hex_encoded_size(size_t size) { return size * 2; }
+_bytes_alwaysinline static size_t hex_decoded_size(size_t len) { return len / 2; }
+
+_bytes_api size_t hex_encode(char *dst, const void *src, size_t size, bool upper);
+_bytes_api size_t hex_decode(void *dst, const char *src, size_t len);
+
+/* Base64 as in RFC 4648, with the standard alphabet or, with BASE64_URL,
+   the URL and filename safe one that has '-' and '_' for '+' and '/'.
+   Output is padded with '=' to a multiple of four characters unless
+   BASE64_NOPAD is given. Decoding is strict: the padding must be there
+   exactly when the flags call for it, other characters are errors, and
+   the bits left over in the last character must be zero, so that every
+   byte string has one encoding. The decoded size is exact for valid
+   input, and needs the input to count the padding. */
+#define BASE64_URL 1
+#define BASE64_NOPAD 2
+
+_bytes_alwaysinline static size_t base64_encoded_size(size_t size, u32 flags) {
+	size_t n = size / 3 * 4;
+	if (size % 3 != 0)
+		n += (flags & BASE64_NOPAD) != 0 ? size % 3 + 1 : 4;
+	return n;
+}
+
+_bytes_alwaysinline static size_t base64_decoded_size(const char *src, size_t len) {
+	size_t n = len / 4 * 3;
+	if (len % 4 > 1)
+		n += len % 4 - 1;
+	else if (len % 4 == 0 && len != 0)
+		n -= (src[len - 1] == '=') + (src[len - 1] == '=' && src[len - 2] == '=');
+	return n;
+}
+
+_bytes_api size_t base64_encode(char *dst, const void *src, size_t size, u32 flags);
+_bytes_api size_t base64_decode(void *dst, const char *src, size_t len, u32 flags);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* AW_BYTES_H */
@@ -0,0 +1,183 @@
+
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+#ifndef AW_BYTESTREAM_H
+#define AW_BYTESTREAM_H
+
+#include "aw-endian.h"
+
+#if !defined(_MSC_VER) || _MSC_VER >= 1800
+# include <stdbool.h>
+#endif
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__GNUC__)
+# define _bytestream_alwaysinline __attribute__((always_inline)) inline
+# define _bytestream_unlikely(x) __builtin_expect(!!(x), 0)
+#elif defined(_MSC_VER)
+# define _bytestream_alwaysinline __forceinline
+# define _bytestream_unlikely(x) (x)
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Reads past the end set the sticky error flag, move the cursor to the end and
+   yield zeros, so a message can be decoded as a straight run of reads and
+   checked once with bytereader_ok(). */
+struct bytereader {
+	const u8 *pos;
+	const u8 *end;
+	bool error;
+};
+
+struct bytewriter {
+	u8 *begin;
+	u8 *pos;
+	u8 *end;
+	bool error;
+};
+
+static const u8 _bytestream_zeros[8] = {0};
+
+_bytestream_alwaysinline static void bytereader_init(struct bytereader *r, const void *data, size_t size) {
+	r->pos = (const u8 *) data;
+	r->end = (const u8 *) data + size;
+	r->error = false;
+}
+
+_bytestream_alwaysinline static bool bytereader_ok(const struct bytereader *r) { return !r->error; }
+_bytestream_alwaysinline static size_t bytereader_remaining(const struct bytereader *r) { return (size_t) (r->end - r->pos); }
+
+_bytestream_alwaysinline static const u8 *_bytereader_take(struct bytereader *r, size_t n, const u8 *fail) {
+	const u8 *p = r->pos;
+	if (_bytestream_unlikely((size_t) (r->end - p) < n)) {
+		r->pos = r->end;
+		r->error = true;
+		return fail;
+	}
+	r->pos = p + n;
+	return p;
+}
+
+/* Returns a pointer to the next n bytes of the underlying buffer without
+   copying, or NULL on overrun. */
+_bytestream_alwaysinline static const void *read_span(struct bytereader *r, size_t n) {
+	return _bytereader_take(r, n, NULL);
+}
+
+_bytestream_alwaysinline static void read_bytes(struct bytereader *r, void *dst, size_t n) {
+	const u8 *p = _bytereader_take(r, n, NULL);
+	if (p != NULL)
+		memcpy(dst, p, n);
+	else
+		memset(dst, 0, n);
+}
+
+_bytestream_alwaysinline static void read_skip(struct bytereader *r, size_t n) { _bytereader_take(r, n, NULL); }
+
+_bytestream_alwaysinline static u8 read_u8(struct bytereader *r) { return *_bytereader_take(r, 1, _bytestream_zeros); }
+
+_bytestream_alwaysinline static u16 read_u16_le(struct bytereader *r) { return _load_le16(_bytereader_take(r, 2, _bytestream_zeros)); }
+_bytestream_alwaysinline static u32 read_u32_le(struct bytereader *r) { return _load_le32(_bytereader_take(r, 4, _bytestream_zeros)); }
+_bytestream_alwaysinline static u64 read_u64_le(struct bytereader *r) { return _load_le64(_bytereader_take(r, 8, _bytestream_zeros)); }
+
+_bytestream_alwaysinline static u16 read_u16_be(struct bytereader *r) { return _load_be16(_bytereader_take(r, 2, _bytestream_zeros)); }
+_bytestream_alwaysinline static u32 read_u32_be(struct bytereader *r) { return _load_be32(_bytereader_take(r, 4, _bytestream_zeros)); }
+_bytestream_alwaysinline static u64 read_u64_be(struct bytereader *r) { return _load_be64(_bytereader_take(r, 8, _bytestream_zeros)); }
+
+_bytestream_alwaysinline static s8 read_s8(struct bytereader *r) { return (s8) read_u8(r); }
+_bytestream_alwaysinline static s16 read_s16_le(struct bytereader *r) { return (s16) read_u16_le(r); }
+_bytestream_alwaysinline static s32 read_s32_le(struct bytereader *r) { return (s32) read_u32_le(r); }
+_bytestream_alwaysinline static s64 read_s64_le(struct bytereader *r) { return (s64) read_u64_le(r); }
+_bytestream_alwaysinline static s16 read_s16_be(struct bytereader *r) { return (s16) read_u16_be(r); }
+_bytestream_alwaysinline static s32 read_s32_be(struct bytereader *r) { return (s32) read_u32_be(r); }
+_bytestream_alwaysinline static s64 read_s64_be(struct bytereader *r) { return (s64) read_u64_be(r); }
+
+_bytestream_alwaysinline static f32 read_f32_le(struct bytereader *r) { u32 u = read_u32_le(r); f32 f; memcpy(&f, &u, 4); return f; }
+_bytestream_alwaysinline static f64 read_f64_le(struct bytereader *r) { u64 u = read_u64_le(r); f64 f; memcpy(&f, &u, 8); return f; }
+_bytestream_alwaysinline static f32 read_f32_be(struct bytereader *r) { u32 u = read_u32_be(r); f32 f; memcpy(&f, &u, 4); return f; }
+_bytestream_alwaysinline static f64 read_f64_be(struct bytereader *r) { u64 u = read_u64_be(r); f64 f; memcpy(&f, &u, 8); return f; }
+
+/* Writes past the end are dropped and set the sticky error flag. */
+_bytestream_alwaysinline static void bytewriter_init(struct bytewriter *w, void *data, size_t size) {
+	w->begin = (u8 *) data;
+	w->pos = (u8 *) data;
+	w->end = (u8 *) data + size;
+	w->error = false;
+}
+
+_bytestream_alwaysinline static bool bytewriter_ok(const struct bytewriter *w) { return !w->error; }
+_bytestream_alwaysinline static size_t bytewriter_size(const struct bytewriter *w) { return (size_t) (w->pos - w->begin); }
+_bytestream_alwaysinline static size_t bytewriter_remaining(const struct bytewriter *w) { return (size_t) (w->end - w->pos); }
+
+/* Reserves the next n bytes for the caller to fill in place, or returns NULL
+   on overrun. */
+_bytestream_alwaysinline static void *write_reserve(struct bytewriter *w, size_t n) {
+	u8 *p = w->pos;
+	if (_bytestream_unlikely((size_t) (w->end - p) < n)) {
+		w->pos = w->end;
+		w->error = true;
+		return NULL;
+	}
+	w->pos = p + n;
+	return p;
+}
+
+_bytestream_alwaysinline static void write_bytes(struct bytewriter *w, const void *src, size_t n) {
+	void *p = write_reserve(w, n);
+	if (p != NULL)
+		memcpy(p, src, n);
+}
+
+_bytestream_alwaysinline static void write_u8(struct bytewriter *w, u8 v) { u8 *p = (u8 *) write_reserve(w, 1); if (p) *p = v; }
+
+_bytestream_alwaysinline static void write_u16_le(struct bytewriter *w, u16 v) { void *p = write_reserve(w, 2); if (p) _store_le16(p, v); }
+_bytestream_alwaysinline static void write_u32_le(struct bytewriter *w, u32 v) { void *p = write_reserve(w, 4); if (p) _store_le32(p, v); }
+_bytestream_alwaysinline static void write_u64_le(struct bytewriter *w, u64 v) { void *p = write_reserve(w, 8); if (p) _store_le64(p, v); }
+
+_bytestream_alwaysinline static void write_u16_be(struct bytewriter *w, u16 v) { void *p = write_reserve(w, 2); if (p) _store_be16(p, v); }
+_bytestream_alwaysinline static void write_u32_be(struct bytewriter *w, u32 v) { void *p = write_reserve(w, 4); if (p) _store_be32(p, v); }
+_bytestream_alwaysinline static void write_u64_be(struct bytewriter *w, u64 v) { void *p = write_reserve(w, 8); if (p) _store_be64(p, v); }
+
+_bytestream_alwaysinline static void write_s8(struct bytewriter *w, s8 v) { write_u8(w, (u8) v); }
+_bytestream_alwaysinline static void write_s16_le(struct bytewriter *w, s16 v) { write_u16_le(w, (u16) v); }
+_bytestream_alwaysinline static void write_s32_le(struct bytewriter *w, s32 v) { write_u32_le(w, (u32) v); }
+_bytestream_alwaysinline static void write_s64_le(struct bytewriter *w, s64 v) { write_u64_le(w, (u64) v); }
+_bytestream_alwaysinline static void write_s16_be(struct bytewriter *w, s16 v) { write_u16_be(w, (u16) v); }
+_bytestream_alwaysinline static void write_s32_be(struct bytewriter *w, s32 v) { write_u32_be(w, (u32) v); }
+_bytestream_alwaysinline static void write_s64_be(struct bytewriter *w, s64 v) { write_u64_be(w, (u64) v); }
+
+_bytestream_alwaysinline static void write_f32_le(struct bytewriter *w, f32 f) { u32 u; memcpy(&u, &f, 4); write_u32_le(w, u); }
+_bytestream_alwaysinline static void write_f64_le(struct bytewriter *w, f64 f) { u64 u; memcpy(&u, &f, 8); write_u64_le(w, u); }
+_bytestream_alwaysinline static void write_f32_be(struct bytewriter *w, f32 f) { u32 u; memcpy(&u, &f, 4); write_u32_be(w, u); }
+_bytestream_alwaysinline static void write_f64_be(struct bytewriter *w, f64 f) { u64 u; memcpy(&u, &f, 8); write_u64_be(w, u); }
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* AW_BYTESTREAM_H */
+
@@ -0,0 +1,74 @@
+
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+#ifndef AW_CHECKSUM_H
+#define AW_CHECKSUM_H
+
+#include "aw-types.h"
+
+#include <stddef.h>
+
+#if defined(_checksum_dllexport)
+# if defined(_MSC_VER)
+#  define _checksum_api extern __declspec(dllexport)
+# elif defined(__GNUC__)
+#  define _checksum_api __attribute__((visibility("default"))) extern
+# endif
+#elif defined(_checksum_dllimport)
+# if defined(_MSC_VER)
+#  define _checksum_api extern __declspec(dllimport)
+# endif
+#endif
+#ifndef _checksum_api
+# define _checksum_api extern
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* CRC-32 as in zlib, PNG and Ethernet, CRC-32C (Castagnoli) as in iSCSI
+   and ext4, and Adler-32 as in zlib. Each call continues from the previous
+   result, so a buffer can be checked in pieces; CRCs start from 0 and
+   Adler-32 from 1.
+
+   On x86 the CRCs fold 64 bytes at a time with PCLMULQDQ, and CRC-32C uses
+   the SSE4.2 crc32 instruction for short input; on ARM they use the CRC32
+   and PMULL instructions when the compiler targets them. Elsewhere they
+   fall back to slicing-by-8 tables. Adler-32 uses SSSE3 where available. */
+_checksum_api u32 checksum_crc32(u32 crc, const void *ptr, size_t size);
+_checksum_api u32 checksum_crc32c(u32 crc, const void *ptr, size_t size);
+_checksum_api u32 checksum_adler32(u32 adler, const void *ptr, size_t size);
+
+/* Combine the checksums of two adjacent pieces into that of the whole,
+   given the size of the second piece, so that pieces can be checked on
+   separate threads. */
+_checksum_api u32 checksum_crc32_combine(u32 crc1, u32 crc2, u64 size2);
+_checksum_api u32 checksum_crc32c_combine(u32 crc1, u32 crc2, u64 size2);
+_checksum_api u32 checksum_adler32_combine(u32 adler1, u32 adler2, u64 size2);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* AW_CHECKSUM_H */
@@ -0,0 +1,195 @@
+
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+#ifndef _cpu_nofeatures
+# if defined(_WIN32)
+#  define _CRT_SECURE_NO_WARNINGS 1
+#  define WIN32_LEAN_AND_MEAN 1
+# elif defined(__linux__)
+#  define _GNU_SOURCE 1
+#  define _DEFAULT_SOURCE 1
+# endif
+#endif /* _cpu_nofeatures */
+
+#include "aw-cpu.h"
+
+#include <stdlib.h>
+
+#if defined(_WIN32)
+# include <windows.h>
+#endif
+#if (defined(__i386__) || defined(__x86_64__)) && defined(__GNUC__)
+# include <cpuid.h>
+#endif
+#if defined(__linux__) && (defined(__aarch64__) || defined(__arm__))
+# include <sys/auxv.h>
+#endif
+
+#define CPU_DETECTED (1u << 31)
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+static void cpu_cpuid(u32 leaf, u32 sub, u32 r[4]) {
+# if defined(_MSC_VER)
+	int t[4];
+	__cpuidex(t, (int) leaf, (int) sub);
+	r[0] = (u32) t[0], r[1] = (u32) t[1], r[2] = (u32) t[2], r[3] = (u32) t[3];
+# else
+	__cpuid_count(leaf, sub, r[0], r[1], r[2], r[3]);
+# endif
+}
+
+static u64 cpu_xgetbv(void) {
+# if defined(_MSC_VER)
+	return _xgetbv(0);
+# else
+	u32 lo, hi;
+	__asm__ ("xgetbv" : "=a" (lo), "=d" (hi) : "c" (0));
+	return (u64) hi << 32 | lo;
+# endif
+}
+
+static u32 cpu_detect(void) {
+	u32 f = 0;
+	u32 r[4];
+	u32 max;
+	u64 xcr0 = 0;
+
+	cpu_cpuid(0, 0, r);
+	max = r[0];
+	if (max < 1)
+		return 0;
+
+	cpu_cpuid(1, 0, r);
+	if (r[3] & (1u << 26)) f |= CPU_SSE2;
+	if (r[2] & (1u << 9)) f |= CPU_SSSE3;
+	if (r[2] & (1u << 19)) f |= CPU_SSE41;
+	if (r[2] & (1u << 20)) f |= CPU_SSE42;
+	if (r[2] & (1u << 23)) f |= CPU_POPCNT;
+	if (r[2] & (1u << 1)) f |= CPU_PCLMUL;
+	if (r[2] & (1u << 27))
+		xcr0 = cpu_xgetbv();
+	/* AVX state needs OS support for saving the YMM (and ZMM) registers. */
+	if ((r[2] & (1u << 28)) && (xcr0 & 0x06) == 0x06) {
+		f |= CPU_AVX;
+		if (r[2] & (1u << 12)) f |= CPU_FMA;
+	}
+
+	if (max >= 7) {
+		cpu_cpuid(7, 0, r);
+		if (r[1] & (1u << 3)) f |= CPU_BMI1;
+		if (r[1] & (1u << 8)) f |= CPU_BMI2;
+		if ((f & CPU_AVX) && (r[1] & (1u << 5))) f |= CPU_AVX2;
+		if ((f & CPU_AVX) && (xcr0 & 0xe6) == 0xe6) {
+			if (r[1] & (1u << 16)) f |= CPU_AVX512F;
+			if (r[1] & (1u << 30)) f |= CPU_AVX512BW;
+			if (r[1] & (1u << 31)) f |= CPU_AVX512VL;
+		}
+	}
+
+	cpu_cpuid(0x80000000u, 0, r);
+	if (r[0] >= 0x80000001u) {
+		cpu_cpuid(0x80000001u, 0, r);
+		if (r[2] & (1u << 5)) f |= CPU_LZCNT;
+	}
+
+	return f;
+}
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(_M_ARM64EC) || defined(__arm__)
+static u32 cpu_detect(void) {
+	u32 f = 0;
+# if defined(__aarch64__) || defined(_M_ARM64) || defined(_M_ARM64EC)
+	f |= CPU_NEON;
+# endif
+# if defined(__linux__) && defined(__aarch64__)
+	unsigned long hwcap = getauxval(AT_HWCAP);
+	if (hwcap & (1ul << 4)) f |= CPU_ARM_PMULL;
+	if (hwcap & (1ul << 7)) f |= CPU_ARM_CRC32;
+# elif defined(__linux__) && defined(__arm__)
+	unsigned long hwcap = getauxval(AT_HWCAP);
+	unsigned long hwcap2 = getauxval(AT_HWCAP2);
+	if (hwcap & (1ul << 12)) f |= CPU_NEON;
+	if (hwcap2 & (1ul << 1)) f |= CPU_ARM_PMULL;
+	if (hwcap2 & (1ul << 4)) f |= CPU_ARM_CRC32;
+# elif defined(_WIN32)
+	if (IsProcessorFeaturePresent(PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE)) f |= CPU_ARM_CRC32;
+	if (IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE)) f |= CPU_ARM_PMULL;
+# else
+#  if defined(__ARM_NEON)
+	f |= CPU_NEON;
+#  endif
+#  if defined(__ARM_FEATURE_CRC32)
+	f |= CPU_ARM_CRC32;
+#  endif
+#  if defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES)
+	f |= CPU_ARM_PMULL;
+#  endif
+# endif
+	return f;
+}
+#else
+static u32 cpu_detect(void) {
+	return 0;
+}
+#endif
+
+/* Parsed by hand: strtoul would also take spaces, a sign or 0x, and wraps
+   -1 to all ones. */
+static u32 cpu_mask(void) {
+	const char *s = getenv("AW_CPU_MASK");
+	u32 m = 0;
+	if (s == NULL || *s == 0)
+		return ~0u;
+	for (; *s != 0; ++s) {
+		u32 d;
+		if (*s >= '0' && *s <= '9')
+			d = (u32) (*s - '0');
+		else if ((*s | 0x20) >= 'a' && (*s | 0x20) <= 'f')
+			d = (u32) ((*s | 0x20) - 'a' + 10);
+		else
+			return ~0u;
+		if (m >> 28 != 0)
+			return ~0u;
+		m = m << 4 | d;
+	}
+	return m;
+}
+
+/* Racing first calls compute and store the same value. */
+#if defined(__GNUC__)
+static u32 cpu_cached;
+# define cpu_load() __atomic_load_n(&cpu_cached, __ATOMIC_RELAXED)
+# define cpu_store(x) __atomic_store_n(&cpu_cached, (x), __ATOMIC_RELAXED)
+#else
+static volatile u32 cpu_cached;
+# define cpu_load() (cpu_cached)
+# define cpu_store(x) (cpu_cached = (x))
+#endif
+
+u32 cpu_features(void) {
+	u32 f = cpu_load();
+	if (f == 0) {
+		f = (cpu_detect() & cpu_mask() & ~CPU_DETECTED) | CPU_DETECTED;
+		cpu_store(f);
+	}
+	return f & ~CPU_DETECTED;
+}
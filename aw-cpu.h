@@ -0,0 +1,119 @@
+
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+#ifndef AW_CPU_H
+#define AW_CPU_H
+
+#include "aw-types.h"
+
+#if !defined(_MSC_VER) || _MSC_VER >= 1800
+# include <stdbool.h>
+#endif
+
+#if defined(_cpu_dllexport)
+# if defined(_MSC_VER)
+#  define _cpu_api extern __declspec(dllexport)
+# elif defined(__GNUC__)
+#  define _cpu_api __attribute__((visibility("default"))) extern
+# endif
+#elif defined(_cpu_dllimport)
+# if defined(_MSC_VER)
+#  define _cpu_api extern __declspec(dllimport)
+# endif
+#endif
+#ifndef _cpu_api
+# define _cpu_api extern
+#endif
+
+#if defined(__GNUC__)
+# define _cpu_alwaysinline __attribute__((always_inline)) inline
+#elif defined(_MSC_VER)
+# define _cpu_alwaysinline __forceinline
+#endif
+
+/* Kernels for wider instruction sets than the translation unit is built for
+   are compiled with _cpu_target() and picked at run time, so x86 builds for
+   the baseline still use AVX2 and AVX-512 where the machine has them. */
+#if (defined(__i386__) || defined(__x86_64__)) && \
+	(defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+# define _cpu_dispatch_x86 1
+# define _cpu_target(x) __attribute__((target(x)))
+#elif defined(_M_IX86) || defined(_M_X64)
+# define _cpu_dispatch_x86 1
+# define _cpu_target(x)
+#else
+# define _cpu_target(x)
+#endif
+
+/* Dispatch pointers start out at a resolver that stores the kernel it picks
+   and then calls it. Any thread may be first, so the pointers are loaded and
+   stored atomically; racing resolvers store the same kernel, and a pointer to
+   code needs no ordering. */
+#if defined(__GNUC__)
+# define _cpu_ptr(type) type
+# define _cpu_load_ptr(p) __atomic_load_n(&(p), __ATOMIC_RELAXED)
+# define _cpu_store_ptr(p, fn) __atomic_store_n(&(p), (fn), __ATOMIC_RELAXED)
+#else
+# define _cpu_ptr(type) type volatile
+# define _cpu_load_ptr(p) (p)
+# define _cpu_store_ptr(p, fn) ((p) = (fn))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+	CPU_SSE2 = 1 << 0,
+	CPU_SSSE3 = 1 << 1,
+	CPU_SSE41 = 1 << 2,
+	CPU_SSE42 = 1 << 3,
+	CPU_POPCNT = 1 << 4,
+	CPU_PCLMUL = 1 << 5,
+	CPU_AVX = 1 << 6,
+	CPU_AVX2 = 1 << 7,
+	CPU_FMA = 1 << 8,
+	CPU_BMI1 = 1 << 9,
+	CPU_BMI2 = 1 << 10,
+	CPU_LZCNT = 1 << 11,
+	CPU_AVX512F = 1 << 12,
+	CPU_AVX512BW = 1 << 13,
+	CPU_AVX512VL = 1 << 14,
+	CPU_NEON = 1 << 16,
+	CPU_ARM_CRC32 = 1 << 17,
+	CPU_ARM_PMULL = 1 << 18,
+};
+
+/* Detected once and cached. Setting the AW_CPU_MASK environment variable to a
+   hexadecimal mask hides features, which forces narrower kernels; a value
+   that is empty, not entirely hex digits or wider than 32 bits is ignored. */
+_cpu_api u32 cpu_features(void);
+
+_cpu_alwaysinline static bool cpu_has(u32 features) { return (cpu_features() & features) == features; }
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* AW_CPU_H */
+
@@ -0,0 +1,168 @@
+
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+#include "aw-endian.h"
+#include "aw-cpu.h"
+
+#if defined(__ARM_NEON) || defined(_M_ARM64) || defined(_M_ARM64EC)
+# include <arm_neon.h>
+#endif
+
+typedef size_t (*endian_shuffle_fn)(void *dst, const void *src, size_t size, const u8 *shuffle);
+
+#if defined(_cpu_dispatch_x86)
+static const u8 endian_shuffle16[64] = {
+	1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+	1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+	1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+	1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+};
+static const u8 endian_shuffle32[64] = {
+	3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+	3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+	3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+	3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+};
+static const u8 endian_shuffle64[64] = {
+	7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+	7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+	7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+	7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+};
+
+/* Each kernel shuffles whole vectors and returns how many bytes it did; the
+   scalar loops in the callers finish the tail. */
+_cpu_target("avx512bw")
+static size_t endian_shuffle_avx512(void *dst, const void *src, size_t size, const u8 *shuffle) {
+	u8 *d = (u8 *) dst;
+	const u8 *s = (const u8 *) src;
+	const __m512i m = _mm512_loadu_si512((const void *) shuffle);
+	size_t i = 0;
+	for (; i + 128 <= size; i += 128) {
+		__m512i a = _mm512_loadu_si512((const void *) (s + i));
+		__m512i b = _mm512_loadu_si512((const void *) (s + i + 64));
+		_mm512_storeu_si512((void *) (d + i), _mm512_shuffle_epi8(a, m));
+		_mm512_storeu_si512((void *) (d + i + 64), _mm512_shuffle_epi8(b, m));
+	}
+	for (; i + 64 <= size; i += 64)
+		_mm512_storeu_si512((void *) (d + i), _mm512_shuffle_epi8(_mm512_loadu_si512((const void *) (s + i)), m));
+	return i;
+}
+
+_cpu_target("avx2")
+static size_t endian_shuffle_avx2(void *dst, const void *src, size_t size, const u8 *shuffle) {
+	u8 *d = (u8 *) dst;
+	const u8 *s = (const u8 *) src;
+	const __m256i m = _mm256_loadu_si256((const __m256i *) shuffle);
+	size_t i = 0;
+	for (; i + 64 <= size; i += 64) {
+		__m256i a = _mm256_loadu_si256((const __m256i *) (s + i));
+		__m256i b = _mm256_loadu_si256((const __m256i *) (s + i + 32));
+		_mm256_storeu_si256((__m256i *) (d + i), _mm256_shuffle_epi8(a, m));
+		_mm256_storeu_si256((__m256i *) (d + i + 32), _mm256_shuffle_epi8(b, m));
+	}
+	for (; i + 32 <= size; i += 32)
+		_mm256_storeu_si256((__m256i *) (d + i), _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *) (s + i)), m));
+	return i;
+}
+
+_cpu_target("ssse3")
+static size_t endian_shuffle_ssse3(void *dst, const void *src, size_t size, const u8 *shuffle) {
+	u8 *d = (u8 *) dst;
+	const u8 *s = (const u8 *) src;
+	const __m128i m = _mm_loadu_si128((const __m128i *) shuffle);
+	size_t i = 0;
+	for (; i + 32 <= size; i += 32) {
+		__m128i a = _mm_loadu_si128((const __m128i *) (s + i));
+		__m128i b = _mm_loadu_si128((const __m128i *) (s + i + 16));
+		_mm_storeu_si128((__m128i *) (d + i), _mm_shuffle_epi8(a, m));
+		_mm_storeu_si128((__m128i *) (d + i + 16), _mm_shuffle_epi8(b, m));
+	}
+	for (; i + 16 <= size; i += 16)
+		_mm_storeu_si128((__m128i *) (d + i), _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (s + i)), m));
+	return i;
+}
+
+static size_t endian_shuffle_none(void *dst, const void *src, size_t size, const u8 *shuffle) {
+	(void) dst, (void) src, (void) size, (void) shuffle;
+	return 0;
+}
+
+static size_t endian_shuffle_resolve(void *dst, const void *src, size_t size, const u8 *shuffle);
+static _cpu_ptr(endian_shuffle_fn) endian_shuffle_ptr = endian_shuffle_resolve;
+#define endian_shuffle _cpu_load_ptr(endian_shuffle_ptr)
+
+static size_t endian_shuffle_resolve(void *dst, const void *src, size_t size, const u8 *shuffle) {
+	endian_shuffle_fn fn = endian_shuffle_none;
+	if (cpu_has(CPU_AVX512BW))
+		fn = endian_shuffle_avx512;
+	else if (cpu_has(CPU_AVX2))
+		fn = endian_shuffle_avx2;
+	else if (cpu_has(CPU_SSSE3))
+		fn = endian_shuffle_ssse3;
+	_cpu_store_ptr(endian_shuffle_ptr, fn);
+	return fn(dst, src, size, shuffle);
+}
+#endif /* defined(_cpu_dispatch_x86) */
+
+void _byteswap16_array(void *dst, const void *src, size_t count) {
+	u8 *d = (u8 *) dst;
+	const u8 *s = (const u8 *) src;
+	size_t i = 0;
+#if defined(_cpu_dispatch_x86)
+	i = endian_shuffle(d, s, count * 2, endian_shuffle16) / 2;
+#elif defined(__ARM_NEON) || defined(_M_ARM64) || defined(_M_ARM64EC)
+	for (; i + 8 <= count; i += 8)
+		vst1q_u8(d + i * 2, vrev16q_u8(vld1q_u8(s + i * 2)));
+#endif
+	for (; i < count; ++i)
+		_store_le16(d + i * 2, _load_be16(s + i * 2));
+}
+
+void _byteswap32_array(void *dst, const void *src, size_t count) {
+	u8 *d = (u8 *) dst;
+	const u8 *s = (const u8 *) src;
+	size_t i = 0;
+#if defined(_cpu_dispatch_x86)
+	i = endian_shuffle(d, s, count * 4, endian_shuffle32) / 4;
+#elif defined(__ARM_NEON) || defined(_M_ARM64) || defined(_M_ARM64EC)
+	for (; i + 4 <= count; i += 4)
+		vst1q_u8(d + i * 4, vrev32q_u8(vld1q_u8(s + i * 4)));
+#endif
+	for (; i < count; ++i)
+		_store_le32(d + i * 4, _load_be32(s + i * 4));
+}
+
+void _byteswap64_array(void *dst, const void *src, size_t count) {
+	u8 *d = (u8 *) dst;
+	const u8 *s = (const u8 *) src;
+	size_t i = 0;
+#if defined(_cpu_dispatch_x86)
+	i = endian_shuffle(d, s, count * 8, endian_shuffle64) / 8;
+#elif defined(__ARM_NEON) || defined(_M_ARM64) || defined(_M_ARM64EC)
+	for (; i + 2 <= count; i += 2)
+		vst1q_u8(d + i * 8, vrev64q_u8(vld1q_u8(s + i * 8)));
+#endif
+	for (; i < count; ++i)
+		_store_le64(d + i * 8, _load_be64(s + i * 8));
+}
@@ -26,6 +26,24 @@
 
 #include "aw-types.h"
 
+#include <stddef.h>
+#include <string.h>
+
+#if defined(_endian_dllexport)
+# if defined(_MSC_VER)
+#  define _endian_api extern __declspec(dllexport)
+# elif defined(__GNUC__)
+#  define _endian_api __attribute__((visibility("default"))) extern
+# endif
+#elif defined(_endian_dllimport)
+# if defined(_MSC_VER)
+#  define _endian_api extern __declspec(dllimport)
+# endif
+#endif
+#ifndef _endian_api
+# define _endian_api extern
+#endif
+
 #if defined(__GNUC__)
 # define _endian_alwaysinline __attribute__((always_inline)) inline
 #elif defined(_MSC_VER)
@@ -65,6 +83,18 @@ static u64 _byteswap64(u64 v) {
                 (v >> 0x38 & 0x00000000000000ffull);
 }
 
+/* Swap count elements from src into dst. dst and src must either be the
+   same buffer (in-place) or not overlap at all; neither needs to be
+   aligned. */
+_endian_api void _byteswap16_array(void *dst, const void *src, size_t count);
+_endian_api void _byteswap32_array(void *dst, const void *src, size_t count);
+_endian_api void _byteswap64_array(void *dst, const void *src, size_t count);
+
+_endian_alwaysinline static void _bytecopy_array(void *dst, const void *src, size_t size) {
+	if (dst != src)
+		memcpy(dst, src, size);
+}
+
 #if defined(__BIG_ENDIAN__) || \
 	defined(__ARMEB__) || defined(__THUMBEB__) || \
 	defined(_M_PPC) || defined(__ppc64__) || \
@@ -84,6 +114,22 @@ _endian_alwaysinline static u64 _htob64(u64 v) { return v; }
 _endian_alwaysinline static u16 _htol16(u16 v) { return _byteswap16(v); }
 _endian_alwaysinline static u32 _htol32(u32 v) { return _byteswap32(v); }
 _endian_alwaysinline static u64 _htol64(u64 v) { return _byteswap64(v); }
+
+_endian_alwaysinline static void _btoh16_array(void *dst, const void *src, size_t n) { _bytecopy_array(dst, src, n * 2); }
+_endian_alwaysinline static void _btoh32_array(void *dst, const void *src, size_t n) { _bytecopy_array(dst, src, n * 4); }
+_endian_alwaysinline static void _btoh64_array(void *dst, const void *src, size_t n) { _bytecopy_array(dst, src, n * 8); }
+
+_endian_alwaysinline static void _ltoh16_array(void *dst, const void *src, size_t n) { _byteswap16_array(dst, src, n); }
+_endian_alwaysinline static void _ltoh32_array(void *dst, const void *src, size_t n) { _byteswap32_array(dst, src, n); }
+_endian_alwaysinline static void _ltoh64_array(void *dst, const void *src, size_t n) { _byteswap64_array(dst, src, n); }
+
+_endian_alwaysinline static void _htob16_array(void *dst, const void *src, size_t n) { _bytecopy_array(dst, src, n * 2); }
+_endian_alwaysinline static void _htob32_array(void *dst, const void *src, size_t n) { _bytecopy_array(dst, src, n * 4); }
+_endian_alwaysinline static void _htob64_array(void *dst, const void *src, size_t n) { _bytecopy_array(dst, src, n * 8); }
+
+_endian_alwaysinline static void _htol16_array(void *dst, const void *src, size_t n) { _byteswap16_array(dst, src, n); }
+_endian_alwaysinline static void _htol32_array(void *dst, const void *src, size_t n) { _byteswap32_array(dst, src, n); }
+_endian_alwaysinline static void _htol64_array(void *dst, const void *src, size_t n) { _byteswap64_array(dst, src, n); }
 #else
 _endian_alwaysinline static u16 _btoh16(u16 v) { return _byteswap16(v); }
 _endian_alwaysinline static u32 _btoh32(u32 v) { return _byteswap32(v); }
@@ -100,8 +146,42 @@ _endian_alwaysinline static u64 _htob64(u64 v) { return _byteswap64(v); }
 _endian_alwaysinline static u16 _htol16(u16 v) { return v; }
 _endian_alwaysinline static u32 _htol32(u32 v) { return v; }
 _endian_alwaysinline static u64 _htol64(u64 v) { return v; }
+
+_endian_alwaysinline static void _btoh16_array(void *dst, const void *src, size_t n) { _byteswap16_array(dst, src, n); }
+_endian_alwaysinline static void _btoh32_array(void *dst, const void *src, size_t n) { _byteswap32_array(dst, src, n); }
+_endian_alwaysinline static void _btoh64_array(void *dst, const void *src, size_t n) { _byteswap64_array(dst, src, n); }
+
+_endian_alwaysinline static void _ltoh16_array(void *dst, const void *src, size_t n) { _bytecopy_array(dst, src, n * 2); }
+_endian_alwaysinline static void _ltoh32_array(void *dst, const void *src, size_t n) { _bytecopy_array(dst, src, n * 4); }
+_endian_alwaysinline static void _ltoh64_array(void *dst, const void *src, size_t n) { _bytecopy_array(dst, src, n * 8); }
+
+_endian_alwaysinline static void _htob16_array(void *dst, const void *src, size_t n) { _byteswap16_array(dst, src, n); }
+_endian_alwaysinline static void _htob32_array(void *dst, const void *src, size_t n) { _byteswap32_array(dst, src, n); }
+_endian_alwaysinline static void _htob64_array(void *dst, const void *src, size_t n) { _byteswap64_array(dst, src, n); }
+
+_endian_alwaysinline static void _htol16_array(void *dst, const void *src, size_t n) { _bytecopy_array(dst, src, n * 2); }
+_endian_alwaysinline static void _htol32_array(void *dst, const void *src, size_t n) { _bytecopy_array(dst, src, n * 4); }
+_endian_alwaysinline static void _htol64_array(void *dst, const void *src, size_t n) { _bytecopy_array(dst, src, n * 8); }
 #endif
 
+/* Loads and stores at any byte address; memcpy keeps them free of alignment
+   and aliasing issues and compiles to a single (byte-swapping) move. */
+_endian_alwaysinline static u16 _load_be16(const void *p) { u16 v; memcpy(&v, p, 2); return _btoh16(v); }
+_endian_alwaysinline static u32 _load_be32(const void *p) { u32 v; memcpy(&v, p, 4); return _btoh32(v); }
+_endian_alwaysinline static u64 _load_be64(const void *p) { u64 v; memcpy(&v, p, 8); return _btoh64(v); }
+
+_endian_alwaysinline static u16 _load_le16(const void *p) { u16 v; memcpy(&v, p, 2); return _ltoh16(v); }
+_endian_alwaysinline static u32 _load_le32(const void *p) { u32 v; memcpy(&v, p, 4); return _ltoh32(v); }
+_endian_alwaysinline static u64 _load_le64(const void *p) { u64 v; memcpy(&v, p, 8); return _ltoh64(v); }
+
+_endian_alwaysinline static void _store_be16(void *p, u16 v) { v = _htob16(v); memcpy(p, &v, 2); }
+_endian_alwaysinline static void _store_be32(void *p, u32 v) { v = _htob32(v); memcpy(p, &v, 4); }
+_endian_alwaysinline static void _store_be64(void *p, u64 v) { v = _htob64(v); memcpy(p, &v, 8); }
+
+_endian_alwaysinline static void _store_le16(void *p, u16 v) { v = _htol16(v); memcpy(p, &v, 2); }
+_endian_alwaysinline static void _store_le32(void *p, u32 v) { v = _htol32(v); memcpy(p, &v, 4); }
+_endian_alwaysinline static void _store_le64(void *p, u64 v) { v = _htol64(v); memcpy(p, &v, 8); }
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -0,0 +1,961 @@
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+#include "aw-format.h"
+#include "aw-arith.h"
+
+#include <string.h>
+
+#if defined(__GNUC__)
+# define _format_alwaysinline __attribute__((always_inline)) inline
+#elif defined(_MSC_VER)
+# define _format_alwaysinline __forceinline
+#endif
+
+static const char FORMAT_DIGITS[201] =
+	"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+	"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+	"8081828384858687888990919293949596979899";
+
+static const u64 FORMAT_POW10[20] = {
+	imm_u64(1), imm_u64(10), imm_u64(100), imm_u64(1000), imm_u64(10000), imm_u64(100000),
+	imm_u64(1000000), imm_u64(10000000), imm_u64(100000000), imm_u64(1000000000),
+	imm_u64(10000000000), imm_u64(100000000000), imm_u64(1000000000000),
+	imm_u64(10000000000000), imm_u64(100000000000000), imm_u64(1000000000000000),
+	imm_u64(10000000000000000), imm_u64(100000000000000000), imm_u64(1000000000000000000),
+	imm_u64(10000000000000000000),
+};
+
+/* The bit length times log10(2) is the digit count or one short of it. */
+_format_alwaysinline static u32 format_len_u64(u64 v) {
+	u32 t = ((64 - clz_u64(v | 1)) * 1233) >> 12;
+	return t + 1 - ((v | 1) < FORMAT_POW10[t]);
+}
+
+/* Writes v backwards from end, two digits at a time, switching to 32-bit
+   division once the value fits. */
+_format_alwaysinline static void format_digits(char *end, u64 v) {
+	u32 w;
+	for (; v > 0xffffffffu; v /= 100)
+		memcpy(end -= 2, FORMAT_DIGITS + (v % 100) * 2, 2);
+	for (w = (u32) v; w >= 100; w /= 100)
+		memcpy(end -= 2, FORMAT_DIGITS + (w % 100) * 2, 2);
+	if (w >= 10)
+		memcpy(end - 2, FORMAT_DIGITS + w * 2, 2);
+	else
+		end[-1] = (char) ('0' + w);
+}
+
+size_t format_u64(char *buf, u64 value) {
+	u32 n = format_len_u64(value);
+	format_digits(buf + n, value);
+	return n;
+}
+
+size_t format_u32(char *buf, u32 value) {
+	return format_u64(buf, value);
+}
+
+size_t format_s64(char *buf, s64 value) {
+	if (value >= 0)
+		return format_u64(buf, (u64) value);
+	*buf = '-';
+	return 1 + format_u64(buf + 1, -(u64) value);
+}
+
+size_t format_s32(char *buf, s32 value) {
+	return format_s64(buf, value);
+}
+
+size_t format_x64(char *buf, u64 value) {
+	u32 n = (67 - clz_u64(value | 1)) >> 2;
+	char *p = buf + n;
+	do
+		*--p = "0123456789abcdef"[value & 15];
+	while ((value >>= 4) != 0);
+	return n;
+}
+
+size_t format_x32(char *buf, u32 value) {
+	return format_x64(buf, value);
+}
+
+/* Ryu (Adams 2018) finds the shortest decimal in the rounding interval of
+   the float with 125-bit approximations of powers of five. The tables are
+   the full-size ones for f64, and f32 goes through the same code, since
+   its interval is covered by them with precision to spare. */
+#define FORMAT_POW5_INV_BITCOUNT 125
+#define FORMAT_POW5_BITCOUNT 125
+
+static const u64 FORMAT_POW5_INV_SPLIT[342][2] = {
+	{ imm_u64(1), imm_u64(2305843009213693952) },
+	{ imm_u64(11068046444225730970), imm_u64(1844674407370955161) },
+	{ imm_u64(5165088340638674453), imm_u64(1475739525896764129) },
+	{ imm_u64(7821419487252849886), imm_u64(1180591620717411303) },
+	{ imm_u64(8824922364862649494), imm_u64(1888946593147858085) },
+	{ imm_u64(7059937891890119595), imm_u64(1511157274518286468) },
+	{ imm_u64(13026647942995916322), imm_u64(1208925819614629174) },
+	{ imm_u64(9774590264567735146), imm_u64(1934281311383406679) },
+	{ imm_u64(11509021026396098440), imm_u64(1547425049106725343) },
+	{ imm_u64(16585914450600699399), imm_u64(1237940039285380274) },
+	{ imm_u64(15469416676735388068), imm_u64(1980704062856608439) },
+	{ imm_u64(16064882156130220778), imm_u64(1584563250285286751) },
+	{ imm_u64(9162556910162266299), imm_u64(1267650600228229401) },
+	{ imm_u64(7281393426775805432), imm_u64(2028240960365167042) },
+	{ imm_u64(16893161185646375315), imm_u64(1622592768292133633) },
+	{ imm_u64(2446482504291369283), imm_u64(1298074214633706907) },
+	{ imm_u64(7603720821608101175), imm_u64(2076918743413931051) },
+	{ imm_u64(2393627842544570617), imm_u64(1661534994731144841) },
+	{ imm_u64(16672297533003297786), imm_u64(1329227995784915872) },
+	{ imm_u64(11918280793837635165), imm_u64(2126764793255865396) },
+	{ imm_u64(5845275820328197809), imm_u64(1701411834604692317) },
+	{ imm_u64(15744267100488289217), imm_u64(1361129467683753853) },
+	{ imm_u64(3054734472329800808), imm_u64(2177807148294006166) },
+	{ imm_u64(17201182836831481939), imm_u64(1742245718635204932) },
+	{ imm_u64(6382248639981364905), imm_u64(1393796574908163946) },
+	{ imm_u64(2832900194486363201), imm_u64(2230074519853062314) },
+	{ imm_u64(5955668970331000884), imm_u64(1784059615882449851) },
+	{ imm_u64(1075186361522890384), imm_u64(1427247692705959881) },
+	{ imm_u64(12788344622662355584), imm_u64(2283596308329535809) },
+	{ imm_u64(13920024512871794791), imm_u64(1826877046663628647) },
+	{ imm_u64(3757321980813615186), imm_u64(1461501637330902918) },
+	{ imm_u64(10384555214134712795), imm_u64(1169201309864722334) },
+	{ imm_u64(5547241898389809503), imm_u64(1870722095783555735) },
+	{ imm_u64(4437793518711847602), imm_u64(1496577676626844588) },
+	{ imm_u64(10928932444453298728), imm_u64(1197262141301475670) },
+	{ imm_u64(17486291911125277965), imm_u64(1915619426082361072) },
+	{ imm_u64(6610335899416401726), imm_u64(1532495540865888858) },
+	{ imm_u64(12666966349016942027), imm_u64(1225996432692711086) },
+	{ imm_u64(12888448528943286597), imm_u64(1961594292308337738) },
+	{ imm_u64(17689456452638449924), imm_u64(1569275433846670190) },
+	{ imm_u64(14151565162110759939), imm_u64(1255420347077336152) },
+	{ imm_u64(7885109000409574610), imm_u64(2008672555323737844) },
+	{ imm_u64(9997436015069570011), imm_u64(1606938044258990275) },
+	{ imm_u64(7997948812055656009), imm_u64(1285550435407192220) },
+	{ imm_u64(12796718099289049614), imm_u64(2056880696651507552) },
+	{ imm_u64(2858676849947419045), imm_u64(1645504557321206042) },
+	{ imm_u64(13354987924183666206), imm_u64(1316403645856964833) },
+	{ imm_u64(17678631863951955605), imm_u64(2106245833371143733) },
+	{ imm_u64(3074859046935833515), imm_u64(1684996666696914987) },
+	{ imm_u64(13527933681774397782), imm_u64(1347997333357531989) },
+	{ imm_u64(10576647446613305481), imm_u64(2156795733372051183) },
+	{ imm_u64(15840015586774465031), imm_u64(1725436586697640946) },
+	{ imm_u64(8982663654677661702), imm_u64(1380349269358112757) },
+	{ imm_u64(18061610662226169046), imm_u64(2208558830972980411) },
+	{ imm_u64(10759939715039024913), imm_u64(1766847064778384329) },
+	{ imm_u64(12297300586773130254), imm_u64(1413477651822707463) },
+	{ imm_u64(15986332124095098083), imm_u64(2261564242916331941) },
+	{ imm_u64(9099716884534168143), imm_u64(1809251394333065553) },
+	{ imm_u64(14658471137111155161), imm_u64(1447401115466452442) },
+	{ imm_u64(4348079280205103483), imm_u64(1157920892373161954) },
+	{ imm_u64(14335624477811986218), imm_u64(1852673427797059126) },
+	{ imm_u64(7779150767507678651), imm_u64(1482138742237647301) },
+	{ imm_u64(2533971799264232598), imm_u64(1185710993790117841) },
+	{ imm_u64(15122401323048503126), imm_u64(1897137590064188545) },
+	{ imm_u64(12097921058438802501), imm_u64(1517710072051350836) },
+	{ imm_u64(5988988032009131678), imm_u64(1214168057641080669) },
+	{ imm_u64(16961078480698431330), imm_u64(1942668892225729070) },
+	{ imm_u64(13568862784558745064), imm_u64(1554135113780583256) },
+	{ imm_u64(7165741412905085728), imm_u64(1243308091024466605) },
+	{ imm_u64(11465186260648137165), imm_u64(1989292945639146568) },
+	{ imm_u64(16550846638002330379), imm_u64(1591434356511317254) },
+	{ imm_u64(16930026125143774626), imm_u64(1273147485209053803) },
+	{ imm_u64(4951948911778577463), imm_u64(2037035976334486086) },
+	{ imm_u64(272210314680951647), imm_u64(1629628781067588869) },
+	{ imm_u64(3907117066486671641), imm_u64(1303703024854071095) },
+	{ imm_u64(6251387306378674625), imm_u64(2085924839766513752) },
+	{ imm_u64(16069156289328670670), imm_u64(1668739871813211001) },
+	{ imm_u64(9165976216721026213), imm_u64(1334991897450568801) },
+	{ imm_u64(7286864317269821294), imm_u64(2135987035920910082) },
+	{ imm_u64(16897537898041588005), imm_u64(1708789628736728065) },
+	{ imm_u64(13518030318433270404), imm_u64(1367031702989382452) },
+	{ imm_u64(6871453250525591353), imm_u64(2187250724783011924) },
+	{ imm_u64(9186511415162383406), imm_u64(1749800579826409539) },
+	{ imm_u64(11038557946871817048), imm_u64(1399840463861127631) },
+	{ imm_u64(10282995085511086630), imm_u64(2239744742177804210) },
+	{ imm_u64(8226396068408869304), imm_u64(1791795793742243368) },
+	{ imm_u64(13959814484210916090), imm_u64(1433436634993794694) },
+	{ imm_u64(11267656730511734774), imm_u64(2293498615990071511) },
+	{ imm_u64(5324776569667477496), imm_u64(1834798892792057209) },
+	{ imm_u64(7949170070475892320), imm_u64(1467839114233645767) },
+	{ imm_u64(17427382500606444826), imm_u64(1174271291386916613) },
+	{ imm_u64(5747719112518849781), imm_u64(1878834066219066582) },
+	{ imm_u64(15666221734240810795), imm_u64(1503067252975253265) },
+	{ imm_u64(12532977387392648636), imm_u64(1202453802380202612) },
+	{ imm_u64(5295368560860596524), imm_u64(1923926083808324180) },
+	{ imm_u64(4236294848688477220), imm_u64(1539140867046659344) },
+	{ imm_u64(7078384693692692099), imm_u64(1231312693637327475) },
+	{ imm_u64(11325415509908307358), imm_u64(1970100309819723960) },
+	{ imm_u64(9060332407926645887), imm_u64(1576080247855779168) },
+	{ imm_u64(14626963555825137356), imm_u64(1260864198284623334) },
+	{ imm_u64(12335095245094488799), imm_u64(2017382717255397335) },
+	{ imm_u64(9868076196075591040), imm_u64(1613906173804317868) },
+	{ imm_u64(15273158586344293478), imm_u64(1291124939043454294) },
+	{ imm_u64(13369007293925138595), imm_u64(2065799902469526871) },
+	{ imm_u64(7005857020398200553), imm_u64(1652639921975621497) },
+	{ imm_u64(16672732060544291412), imm_u64(1322111937580497197) },
+	{ imm_u64(11918976037903224966), imm_u64(2115379100128795516) },
+	{ imm_u64(5845832015580669650), imm_u64(1692303280103036413) },
+	{ imm_u64(12055363241948356366), imm_u64(1353842624082429130) },
+	{ imm_u64(841837113407818570), imm_u64(2166148198531886609) },
+	{ imm_u64(4362818505468165179), imm_u64(1732918558825509287) },
+	{ imm_u64(14558301248600263113), imm_u64(1386334847060407429) },
+	{ imm_u64(12225235553534690011), imm_u64(2218135755296651887) },
+	{ imm_u64(2401490813343931363), imm_u64(1774508604237321510) },
+	{ imm_u64(1921192650675145090), imm_u64(1419606883389857208) },
+	{ imm_u64(17831303500047873437), imm_u64(2271371013423771532) },
+	{ imm_u64(6886345170554478103), imm_u64(1817096810739017226) },
+	{ imm_u64(1819727321701672159), imm_u64(1453677448591213781) },
+	{ imm_u64(16213177116328979020), imm_u64(1162941958872971024) },
+	{ imm_u64(14873036941900635463), imm_u64(1860707134196753639) },
+	{ imm_u64(15587778368262418694), imm_u64(1488565707357402911) },
+	{ imm_u64(8780873879868024632), imm_u64(1190852565885922329) },
+	{ imm_u64(2981351763563108441), imm_u64(1905364105417475727) },
+	{ imm_u64(13453127855076217722), imm_u64(1524291284333980581) },
+	{ imm_u64(7073153469319063855), imm_u64(1219433027467184465) },
+	{ imm_u64(11317045550910502167), imm_u64(1951092843947495144) },
+	{ imm_u64(12742985255470312057), imm_u64(1560874275157996115) },
+	{ imm_u64(10194388204376249646), imm_u64(1248699420126396892) },
+	{ imm_u64(1553625868034358140), imm_u64(1997919072202235028) },
+	{ imm_u64(8621598323911307159), imm_u64(1598335257761788022) },
+	{ imm_u64(17965325103354776697), imm_u64(1278668206209430417) },
+	{ imm_u64(13987124906400001422), imm_u64(2045869129935088668) },
+	{ imm_u64(121653480894270168), imm_u64(1636695303948070935) },
+	{ imm_u64(97322784715416134), imm_u64(1309356243158456748) },
+	{ imm_u64(14913111714512307107), imm_u64(2094969989053530796) },
+	{ imm_u64(8241140556867935363), imm_u64(1675975991242824637) },
+	{ imm_u64(17660958889720079260), imm_u64(1340780792994259709) },
+	{ imm_u64(17189487779326395846), imm_u64(2145249268790815535) },
+	{ imm_u64(13751590223461116677), imm_u64(1716199415032652428) },
+	{ imm_u64(18379969808252713988), imm_u64(1372959532026121942) },
+	{ imm_u64(14650556434236701088), imm_u64(2196735251241795108) },
+	{ imm_u64(652398703163629901), imm_u64(1757388200993436087) },
+	{ imm_u64(11589965406756634890), imm_u64(1405910560794748869) },
+	{ imm_u64(7475898206584884855), imm_u64(2249456897271598191) },
+	{ imm_u64(2291369750525997561), imm_u64(1799565517817278553) },
+	{ imm_u64(9211793429904618695), imm_u64(1439652414253822842) },
+	{ imm_u64(18428218302589300235), imm_u64(2303443862806116547) },
+	{ imm_u64(7363877012587619542), imm_u64(1842755090244893238) },
+	{ imm_u64(13269799239553916280), imm_u64(1474204072195914590) },
+	{ imm_u64(10615839391643133024), imm_u64(1179363257756731672) },
+	{ imm_u64(2227947767661371545), imm_u64(1886981212410770676) },
+	{ imm_u64(16539753473096738529), imm_u64(1509584969928616540) },
+	{ imm_u64(13231802778477390823), imm_u64(1207667975942893232) },
+	{ imm_u64(6413489186596184024), imm_u64(1932268761508629172) },
+	{ imm_u64(16198837793502678189), imm_u64(1545815009206903337) },
+	{ imm_u64(5580372605318321905), imm_u64(1236652007365522670) },
+	{ imm_u64(8928596168509315048), imm_u64(1978643211784836272) },
+	{ imm_u64(18210923379033183008), imm_u64(1582914569427869017) },
+	{ imm_u64(7190041073742725760), imm_u64(1266331655542295214) },
+	{ imm_u64(436019273762630246), imm_u64(2026130648867672343) },
+	{ imm_u64(7727513048493924843), imm_u64(1620904519094137874) },
+	{ imm_u64(9871359253537050198), imm_u64(1296723615275310299) },
+	{ imm_u64(4726128361433549347), imm_u64(2074757784440496479) },
+	{ imm_u64(7470251503888749801), imm_u64(1659806227552397183) },
+	{ imm_u64(13354898832594820487), imm_u64(1327844982041917746) },
+	{ imm_u64(13989140502667892133), imm_u64(2124551971267068394) },
+	{ imm_u64(14880661216876224029), imm_u64(1699641577013654715) },
+	{ imm_u64(11904528973500979224), imm_u64(1359713261610923772) },
+	{ imm_u64(4289851098633925465), imm_u64(2175541218577478036) },
+	{ imm_u64(18189276137874781665), imm_u64(1740432974861982428) },
+	{ imm_u64(3483374466074094362), imm_u64(1392346379889585943) },
+	{ imm_u64(1884050330976640656), imm_u64(2227754207823337509) },
+	{ imm_u64(5196589079523222848), imm_u64(1782203366258670007) },
+	{ imm_u64(15225317707844309248), imm_u64(1425762693006936005) },
+	{ imm_u64(5913764258841343181), imm_u64(2281220308811097609) },
+	{ imm_u64(8420360221814984868), imm_u64(1824976247048878087) },
+	{ imm_u64(17804334621677718864), imm_u64(1459980997639102469) },
+	{ imm_u64(17932816512084085415), imm_u64(1167984798111281975) },
+	{ imm_u64(10245762345624985047), imm_u64(1868775676978051161) },
+	{ imm_u64(4507261061758077715), imm_u64(1495020541582440929) },
+	{ imm_u64(7295157664148372495), imm_u64(1196016433265952743) },
+	{ imm_u64(7982903447895485668), imm_u64(1913626293225524389) },
+	{ imm_u64(10075671573058298858), imm_u64(1530901034580419511) },
+	{ imm_u64(4371188443704728763), imm_u64(1224720827664335609) },
+	{ imm_u64(14372599139411386667), imm_u64(1959553324262936974) },
+	{ imm_u64(15187428126271019657), imm_u64(1567642659410349579) },
+	{ imm_u64(15839291315758726049), imm_u64(1254114127528279663) },
+	{ imm_u64(3206773216762499739), imm_u64(2006582604045247462) },
+	{ imm_u64(13633465017635730761), imm_u64(1605266083236197969) },
+	{ imm_u64(14596120828850494932), imm_u64(1284212866588958375) },
+	{ imm_u64(4907049252451240275), imm_u64(2054740586542333401) },
+	{ imm_u64(236290587219081897), imm_u64(1643792469233866721) },
+	{ imm_u64(14946427728742906810), imm_u64(1315033975387093376) },
+	{ imm_u64(16535586736504830250), imm_u64(2104054360619349402) },
+	{ imm_u64(5849771759720043554), imm_u64(1683243488495479522) },
+	{ imm_u64(15747863852001765813), imm_u64(1346594790796383617) },
+	{ imm_u64(10439186904235184007), imm_u64(2154551665274213788) },
+	{ imm_u64(15730047152871967852), imm_u64(1723641332219371030) },
+	{ imm_u64(12584037722297574282), imm_u64(1378913065775496824) },
+	{ imm_u64(9066413911450387881), imm_u64(2206260905240794919) },
+	{ imm_u64(10942479943902220628), imm_u64(1765008724192635935) },
+	{ imm_u64(8753983955121776503), imm_u64(1412006979354108748) },
+	{ imm_u64(10317025513452932081), imm_u64(2259211166966573997) },
+	{ imm_u64(874922781278525018), imm_u64(1807368933573259198) },
+	{ imm_u64(8078635854506640661), imm_u64(1445895146858607358) },
+	{ imm_u64(13841606313089133175), imm_u64(1156716117486885886) },
+	{ imm_u64(14767872471458792434), imm_u64(1850745787979017418) },
+	{ imm_u64(746251532941302978), imm_u64(1480596630383213935) },
+	{ imm_u64(597001226353042382), imm_u64(1184477304306571148) },
+	{ imm_u64(15712597221132509104), imm_u64(1895163686890513836) },
+	{ imm_u64(8880728962164096960), imm_u64(1516130949512411069) },
+	{ imm_u64(10793931984473187891), imm_u64(1212904759609928855) },
+	{ imm_u64(17270291175157100626), imm_u64(1940647615375886168) },
+	{ imm_u64(2748186495899949531), imm_u64(1552518092300708935) },
+	{ imm_u64(2198549196719959625), imm_u64(1242014473840567148) },
+	{ imm_u64(18275073973719576693), imm_u64(1987223158144907436) },
+	{ imm_u64(10930710364233751031), imm_u64(1589778526515925949) },
+	{ imm_u64(12433917106128911148), imm_u64(1271822821212740759) },
+	{ imm_u64(8826220925580526867), imm_u64(2034916513940385215) },
+	{ imm_u64(7060976740464421494), imm_u64(1627933211152308172) },
+	{ imm_u64(16716827836597268165), imm_u64(1302346568921846537) },
+	{ imm_u64(11989529279587987770), imm_u64(2083754510274954460) },
+	{ imm_u64(9591623423670390216), imm_u64(1667003608219963568) },
+	{ imm_u64(15051996368420132820), imm_u64(1333602886575970854) },
+	{ imm_u64(13015147745246481542), imm_u64(2133764618521553367) },
+	{ imm_u64(3033420566713364587), imm_u64(1707011694817242694) },
+	{ imm_u64(6116085268112601993), imm_u64(1365609355853794155) },
+	{ imm_u64(9785736428980163188), imm_u64(2184974969366070648) },
+	{ imm_u64(15207286772667951197), imm_u64(1747979975492856518) },
+	{ imm_u64(1097782973908629988), imm_u64(1398383980394285215) },
+	{ imm_u64(1756452758253807981), imm_u64(2237414368630856344) },
+	{ imm_u64(5094511021344956708), imm_u64(1789931494904685075) },
+	{ imm_u64(4075608817075965366), imm_u64(1431945195923748060) },
+	{ imm_u64(6520974107321544586), imm_u64(2291112313477996896) },
+	{ imm_u64(1527430471115325346), imm_u64(1832889850782397517) },
+	{ imm_u64(12289990821117991246), imm_u64(1466311880625918013) },
+	{ imm_u64(17210690286378213644), imm_u64(1173049504500734410) },
+	{ imm_u64(9090360384495590213), imm_u64(1876879207201175057) },
+	{ imm_u64(18340334751822203140), imm_u64(1501503365760940045) },
+	{ imm_u64(14672267801457762512), imm_u64(1201202692608752036) },
+	{ imm_u64(16096930852848599373), imm_u64(1921924308174003258) },
+	{ imm_u64(1809498238053148529), imm_u64(1537539446539202607) },
+	{ imm_u64(12515645034668249793), imm_u64(1230031557231362085) },
+	{ imm_u64(1578287981759648052), imm_u64(1968050491570179337) },
+	{ imm_u64(12330676829633449412), imm_u64(1574440393256143469) },
+	{ imm_u64(13553890278448669853), imm_u64(1259552314604914775) },
+	{ imm_u64(3239480371808320148), imm_u64(2015283703367863641) },
+	{ imm_u64(17348979556414297411), imm_u64(1612226962694290912) },
+	{ imm_u64(6500486015647617283), imm_u64(1289781570155432730) },
+	{ imm_u64(10400777625036187652), imm_u64(2063650512248692368) },
+	{ imm_u64(15699319729512770768), imm_u64(1650920409798953894) },
+	{ imm_u64(16248804598352126938), imm_u64(1320736327839163115) },
+	{ imm_u64(7551343283653851484), imm_u64(2113178124542660985) },
+	{ imm_u64(6041074626923081187), imm_u64(1690542499634128788) },
+	{ imm_u64(12211557331022285596), imm_u64(1352433999707303030) },
+	{ imm_u64(1091747655926105338), imm_u64(2163894399531684849) },
+	{ imm_u64(4562746939482794594), imm_u64(1731115519625347879) },
+	{ imm_u64(7339546366328145998), imm_u64(1384892415700278303) },
+	{ imm_u64(8053925371383123274), imm_u64(2215827865120445285) },
+	{ imm_u64(6443140297106498619), imm_u64(1772662292096356228) },
+	{ imm_u64(12533209867169019542), imm_u64(1418129833677084982) },
+	{ imm_u64(5295740528502789974), imm_u64(2269007733883335972) },
+	{ imm_u64(15304638867027962949), imm_u64(1815206187106668777) },
+	{ imm_u64(4865013464138549713), imm_u64(1452164949685335022) },
+	{ imm_u64(14960057215536570740), imm_u64(1161731959748268017) },
+	{ imm_u64(9178696285890871890), imm_u64(1858771135597228828) },
+	{ imm_u64(14721654658196518159), imm_u64(1487016908477783062) },
+	{ imm_u64(4398626097073393881), imm_u64(1189613526782226450) },
+	{ imm_u64(7037801755317430209), imm_u64(1903381642851562320) },
+	{ imm_u64(5630241404253944167), imm_u64(1522705314281249856) },
+	{ imm_u64(814844308661245011), imm_u64(1218164251424999885) },
+	{ imm_u64(1303750893857992017), imm_u64(1949062802279999816) },
+	{ imm_u64(15800395974054034906), imm_u64(1559250241823999852) },
+	{ imm_u64(5261619149759407279), imm_u64(1247400193459199882) },
+	{ imm_u64(12107939454356961969), imm_u64(1995840309534719811) },
+	{ imm_u64(5997002748743659252), imm_u64(1596672247627775849) },
+	{ imm_u64(8486951013736837725), imm_u64(1277337798102220679) },
+	{ imm_u64(2511075177753209390), imm_u64(2043740476963553087) },
+	{ imm_u64(13076906586428298482), imm_u64(1634992381570842469) },
+	{ imm_u64(14150874083884549109), imm_u64(1307993905256673975) },
+	{ imm_u64(4194654460505726958), imm_u64(2092790248410678361) },
+	{ imm_u64(18113118827372222859), imm_u64(1674232198728542688) },
+	{ imm_u64(3422448617672047318), imm_u64(1339385758982834151) },
+	{ imm_u64(16543964232501006678), imm_u64(2143017214372534641) },
+	{ imm_u64(9545822571258895019), imm_u64(1714413771498027713) },
+	{ imm_u64(15015355686490936662), imm_u64(1371531017198422170) },
+	{ imm_u64(5577825024675947042), imm_u64(2194449627517475473) },
+	{ imm_u64(11840957649224578280), imm_u64(1755559702013980378) },
+	{ imm_u64(16851463748863483271), imm_u64(1404447761611184302) },
+	{ imm_u64(12204946739213931940), imm_u64(2247116418577894884) },
+	{ imm_u64(13453306206113055875), imm_u64(1797693134862315907) },
+	{ imm_u64(3383947335406624054), imm_u64(1438154507889852726) },
+	{ imm_u64(16482362180876329456), imm_u64(2301047212623764361) },
+	{ imm_u64(9496540929959153242), imm_u64(1840837770099011489) },
+	{ imm_u64(11286581558709232917), imm_u64(1472670216079209191) },
+	{ imm_u64(5339916432225476010), imm_u64(1178136172863367353) },
+	{ imm_u64(4854517476818851293), imm_u64(1885017876581387765) },
+	{ imm_u64(3883613981455081034), imm_u64(1508014301265110212) },
+	{ imm_u64(14174937629389795797), imm_u64(1206411441012088169) },
+	{ imm_u64(11611853762797942306), imm_u64(1930258305619341071) },
+	{ imm_u64(5600134195496443521), imm_u64(1544206644495472857) },
+	{ imm_u64(15548153800622885787), imm_u64(1235365315596378285) },
+	{ imm_u64(6430302007287065643), imm_u64(1976584504954205257) },
+	{ imm_u64(16212288050055383484), imm_u64(1581267603963364205) },
+	{ imm_u64(12969830440044306787), imm_u64(1265014083170691364) },
+	{ imm_u64(9683682259845159889), imm_u64(2024022533073106183) },
+	{ imm_u64(15125643437359948558), imm_u64(1619218026458484946) },
+	{ imm_u64(8411165935146048523), imm_u64(1295374421166787957) },
+	{ imm_u64(17147214310975587960), imm_u64(2072599073866860731) },
+	{ imm_u64(10028422634038560045), imm_u64(1658079259093488585) },
+	{ imm_u64(8022738107230848036), imm_u64(1326463407274790868) },
+	{ imm_u64(9147032156827446534), imm_u64(2122341451639665389) },
+	{ imm_u64(11006974540203867551), imm_u64(1697873161311732311) },
+	{ imm_u64(5116230817421183718), imm_u64(1358298529049385849) },
+	{ imm_u64(15564666937357714594), imm_u64(2173277646479017358) },
+	{ imm_u64(1383687105660440706), imm_u64(1738622117183213887) },
+	{ imm_u64(12174996128754083534), imm_u64(1390897693746571109) },
+	{ imm_u64(8411947361780802685), imm_u64(2225436309994513775) },
+	{ imm_u64(6729557889424642148), imm_u64(1780349047995611020) },
+	{ imm_u64(5383646311539713719), imm_u64(1424279238396488816) },
+	{ imm_u64(1235136468979721303), imm_u64(2278846781434382106) },
+	{ imm_u64(15745504434151418335), imm_u64(1823077425147505684) },
+	{ imm_u64(16285752362063044992), imm_u64(1458461940118004547) },
+	{ imm_u64(5649904260166615347), imm_u64(1166769552094403638) },
+	{ imm_u64(5350498001524674232), imm_u64(1866831283351045821) },
+	{ imm_u64(591049586477829062), imm_u64(1493465026680836657) },
+	{ imm_u64(11540886113407994219), imm_u64(1194772021344669325) },
+	{ imm_u64(18673707743239135), imm_u64(1911635234151470921) },
+	{ imm_u64(14772334225162232601), imm_u64(1529308187321176736) },
+	{ imm_u64(8128518565387875758), imm_u64(1223446549856941389) },
+	{ imm_u64(1937583260394870242), imm_u64(1957514479771106223) },
+	{ imm_u64(8928764237799716840), imm_u64(1566011583816884978) },
+	{ imm_u64(14521709019723594119), imm_u64(1252809267053507982) },
+	{ imm_u64(8477339172590109297), imm_u64(2004494827285612772) },
+	{ imm_u64(17849917782297818407), imm_u64(1603595861828490217) },
+	{ imm_u64(6901236596354434079), imm_u64(1282876689462792174) },
+	{ imm_u64(18420676183650915173), imm_u64(2052602703140467478) },
+	{ imm_u64(3668494502695001169), imm_u64(1642082162512373983) },
+	{ imm_u64(10313493231639821582), imm_u64(1313665730009899186) },
+	{ imm_u64(9122891541139893884), imm_u64(2101865168015838698) },
+	{ imm_u64(14677010862395735754), imm_u64(1681492134412670958) },
+	{ imm_u64(673562245690857633), imm_u64(1345193707530136767) },
+};
+
+static const u64 FORMAT_POW5_SPLIT[326][2] = {
+	{ imm_u64(0), imm_u64(1152921504606846976) },
+	{ imm_u64(0), imm_u64(1441151880758558720) },
+	{ imm_u64(0), imm_u64(1801439850948198400) },
+	{ imm_u64(0), imm_u64(2251799813685248000) },
+	{ imm_u64(0), imm_u64(1407374883553280000) },
+	{ imm_u64(0), imm_u64(1759218604441600000) },
+	{ imm_u64(0), imm_u64(2199023255552000000) },
+	{ imm_u64(0), imm_u64(1374389534720000000) },
+	{ imm_u64(0), imm_u64(1717986918400000000) },
+	{ imm_u64(0), imm_u64(2147483648000000000) },
+	{ imm_u64(0), imm_u64(1342177280000000000) },
+	{ imm_u64(0), imm_u64(1677721600000000000) },
+	{ imm_u64(0), imm_u64(2097152000000000000) },
+	{ imm_u64(0), imm_u64(1310720000000000000) },
+	{ imm_u64(0), imm_u64(1638400000000000000) },
+	{ imm_u64(0), imm_u64(2048000000000000000) },
+	{ imm_u64(0), imm_u64(1280000000000000000) },
+	{ imm_u64(0), imm_u64(1600000000000000000) },
+	{ imm_u64(0), imm_u64(2000000000000000000) },
+	{ imm_u64(0), imm_u64(1250000000000000000) },
+	{ imm_u64(0), imm_u64(1562500000000000000) },
+	{ imm_u64(0), imm_u64(1953125000000000000) },
+	{ imm_u64(0), imm_u64(1220703125000000000) },
+	{ imm_u64(0), imm_u64(1525878906250000000) },
+	{ imm_u64(0), imm_u64(1907348632812500000) },
+	{ imm_u64(0), imm_u64(1192092895507812500) },
+	{ imm_u64(0), imm_u64(1490116119384765625) },
+	{ imm_u64(4611686018427387904), imm_u64(1862645149230957031) },
+	{ imm_u64(9799832789158199296), imm_u64(1164153218269348144) },
+	{ imm_u64(12249790986447749120), imm_u64(1455191522836685180) },
+	{ imm_u64(15312238733059686400), imm_u64(1818989403545856475) },
+	{ imm_u64(14528612397897220096), imm_u64(2273736754432320594) },
+	{ imm_u64(13692068767113150464), imm_u64(1421085471520200371) },
+	{ imm_u64(12503399940464050176), imm_u64(1776356839400250464) },
+	{ imm_u64(15629249925580062720), imm_u64(2220446049250313080) },
+	{ imm_u64(9768281203487539200), imm_u64(1387778780781445675) },
+	{ imm_u64(7598665485932036096), imm_u64(1734723475976807094) },
+	{ imm_u64(274959820560269312), imm_u64(2168404344971008868) },
+	{ imm_u64(9395221924704944128), imm_u64(1355252715606880542) },
+	{ imm_u64(2520655369026404352), imm_u64(1694065894508600678) },
+	{ imm_u64(12374191248137781248), imm_u64(2117582368135750847) },
+	{ imm_u64(14651398557727195136), imm_u64(1323488980084844279) },
+	{ imm_u64(13702562178731606016), imm_u64(1654361225106055349) },
+	{ imm_u64(3293144668132343808), imm_u64(2067951531382569187) },
+	{ imm_u64(18199116482078572544), imm_u64(1292469707114105741) },
+	{ imm_u64(8913837547316051968), imm_u64(1615587133892632177) },
+	{ imm_u64(15753982952572452864), imm_u64(2019483917365790221) },
+	{ imm_u64(12152082354571476992), imm_u64(1262177448353618888) },
+	{ imm_u64(15190102943214346240), imm_u64(1577721810442023610) },
+	{ imm_u64(9764256642163156992), imm_u64(1972152263052529513) },
+	{ imm_u64(17631875447420442880), imm_u64(1232595164407830945) },
+	{ imm_u64(8204786253993389888), imm_u64(1540743955509788682) },
+	{ imm_u64(1032610780636961552), imm_u64(1925929944387235853) },
+	{ imm_u64(2951224747111794922), imm_u64(1203706215242022408) },
+	{ imm_u64(3689030933889743652), imm_u64(1504632769052528010) },
+	{ imm_u64(13834660704216955373), imm_u64(1880790961315660012) },
+	{ imm_u64(17870034976990372916), imm_u64(1175494350822287507) },
+	{ imm_u64(17725857702810578241), imm_u64(1469367938527859384) },
+	{ imm_u64(3710578054803671186), imm_u64(1836709923159824231) },
+	{ imm_u64(26536550077201078), imm_u64(2295887403949780289) },
+	{ imm_u64(11545800389866720434), imm_u64(1434929627468612680) },
+	{ imm_u64(14432250487333400542), imm_u64(1793662034335765850) },
+	{ imm_u64(8816941072311974870), imm_u64(2242077542919707313) },
+	{ imm_u64(17039803216263454053), imm_u64(1401298464324817070) },
+	{ imm_u64(12076381983474541759), imm_u64(1751623080406021338) },
+	{ imm_u64(5872105442488401391), imm_u64(2189528850507526673) },
+	{ imm_u64(15199280947623720629), imm_u64(1368455531567204170) },
+	{ imm_u64(9775729147674874978), imm_u64(1710569414459005213) },
+	{ imm_u64(16831347453020981627), imm_u64(2138211768073756516) },
+	{ imm_u64(1296220121283337709), imm_u64(1336382355046097823) },
+	{ imm_u64(15455333206886335848), imm_u64(1670477943807622278) },
+	{ imm_u64(10095794471753144002), imm_u64(2088097429759527848) },
+	{ imm_u64(6309871544845715001), imm_u64(1305060893599704905) },
+	{ imm_u64(12499025449484531656), imm_u64(1631326116999631131) },
+	{ imm_u64(11012095793428276666), imm_u64(2039157646249538914) },
+	{ imm_u64(11494245889320060820), imm_u64(1274473528905961821) },
+	{ imm_u64(532749306367912313), imm_u64(1593091911132452277) },
+	{ imm_u64(5277622651387278295), imm_u64(1991364888915565346) },
+	{ imm_u64(7910200175544436838), imm_u64(1244603055572228341) },
+	{ imm_u64(14499436237857933952), imm_u64(1555753819465285426) },
+	{ imm_u64(8900923260467641632), imm_u64(1944692274331606783) },
+	{ imm_u64(12480606065433357876), imm_u64(1215432671457254239) },
+	{ imm_u64(10989071563364309441), imm_u64(1519290839321567799) },
+	{ imm_u64(9124653435777998898), imm_u64(1899113549151959749) },
+	{ imm_u64(8008751406574943263), imm_u64(1186945968219974843) },
+	{ imm_u64(5399253239791291175), imm_u64(1483682460274968554) },
+	{ imm_u64(15972438586593889776), imm_u64(1854603075343710692) },
+	{ imm_u64(759402079766405302), imm_u64(1159126922089819183) },
+	{ imm_u64(14784310654990170340), imm_u64(1448908652612273978) },
+	{ imm_u64(9257016281882937117), imm_u64(1811135815765342473) },
+	{ imm_u64(16182956370781059300), imm_u64(2263919769706678091) },
+	{ imm_u64(7808504722524468110), imm_u64(1414949856066673807) },
+	{ imm_u64(5148944884728197234), imm_u64(1768687320083342259) },
+	{ imm_u64(1824495087482858639), imm_u64(2210859150104177824) },
+	{ imm_u64(1140309429676786649), imm_u64(1381786968815111140) },
+	{ imm_u64(1425386787095983311), imm_u64(1727233711018888925) },
+	{ imm_u64(6393419502297367043), imm_u64(2159042138773611156) },
+	{ imm_u64(13219259225790630210), imm_u64(1349401336733506972) },
+	{ imm_u64(16524074032238287762), imm_u64(1686751670916883715) },
+	{ imm_u64(16043406521870471799), imm_u64(2108439588646104644) },
+	{ imm_u64(803757039314269066), imm_u64(1317774742903815403) },
+	{ imm_u64(14839754354425000045), imm_u64(1647218428629769253) },
+	{ imm_u64(4714634887749086344), imm_u64(2059023035787211567) },
+	{ imm_u64(9864175832484260821), imm_u64(1286889397367007229) },
+	{ imm_u64(16941905809032713930), imm_u64(1608611746708759036) },
+	{ imm_u64(2730638187581340797), imm_u64(2010764683385948796) },
+	{ imm_u64(10930020904093113806), imm_u64(1256727927116217997) },
+	{ imm_u64(18274212148543780162), imm_u64(1570909908895272496) },
+	{ imm_u64(4396021111970173586), imm_u64(1963637386119090621) },
+	{ imm_u64(5053356204195052443), imm_u64(1227273366324431638) },
+	{ imm_u64(15540067292098591362), imm_u64(1534091707905539547) },
+	{ imm_u64(14813398096695851299), imm_u64(1917614634881924434) },
+	{ imm_u64(13870059828862294966), imm_u64(1198509146801202771) },
+	{ imm_u64(12725888767650480803), imm_u64(1498136433501503464) },
+	{ imm_u64(15907360959563101004), imm_u64(1872670541876879330) },
+	{ imm_u64(14553786618154326031), imm_u64(1170419088673049581) },
+	{ imm_u64(4357175217410743827), imm_u64(1463023860841311977) },
+	{ imm_u64(10058155040190817688), imm_u64(1828779826051639971) },
+	{ imm_u64(7961007781811134206), imm_u64(2285974782564549964) },
+	{ imm_u64(14199001900486734687), imm_u64(1428734239102843727) },
+	{ imm_u64(13137066357181030455), imm_u64(1785917798878554659) },
+	{ imm_u64(11809646928048900164), imm_u64(2232397248598193324) },
+	{ imm_u64(16604401366885338411), imm_u64(1395248280373870827) },
+	{ imm_u64(16143815690179285109), imm_u64(1744060350467338534) },
+	{ imm_u64(10956397575869330579), imm_u64(2180075438084173168) },
+	{ imm_u64(6847748484918331612), imm_u64(1362547148802608230) },
+	{ imm_u64(17783057643002690323), imm_u64(1703183936003260287) },
+	{ imm_u64(17617136035325974999), imm_u64(2128979920004075359) },
+	{ imm_u64(17928239049719816230), imm_u64(1330612450002547099) },
+	{ imm_u64(17798612793722382384), imm_u64(1663265562503183874) },
+	{ imm_u64(13024893955298202172), imm_u64(2079081953128979843) },
+	{ imm_u64(5834715712847682405), imm_u64(1299426220705612402) },
+	{ imm_u64(16516766677914378815), imm_u64(1624282775882015502) },
+	{ imm_u64(11422586310538197711), imm_u64(2030353469852519378) },
+	{ imm_u64(11750802462513761473), imm_u64(1268970918657824611) },
+	{ imm_u64(10076817059714813937), imm_u64(1586213648322280764) },
+	{ imm_u64(12596021324643517422), imm_u64(1982767060402850955) },
+	{ imm_u64(5566670318688504437), imm_u64(1239229412751781847) },
+	{ imm_u64(2346651879933242642), imm_u64(1549036765939727309) },
+	{ imm_u64(7545000868343941206), imm_u64(1936295957424659136) },
+	{ imm_u64(4715625542714963254), imm_u64(1210184973390411960) },
+	{ imm_u64(5894531928393704067), imm_u64(1512731216738014950) },
+	{ imm_u64(16591536947346905892), imm_u64(1890914020922518687) },
+	{ imm_u64(17287239619732898039), imm_u64(1181821263076574179) },
+	{ imm_u64(16997363506238734644), imm_u64(1477276578845717724) },
+	{ imm_u64(2799960309088866689), imm_u64(1846595723557147156) },
+	{ imm_u64(10973347230035317489), imm_u64(1154122327223216972) },
+	{ imm_u64(13716684037544146861), imm_u64(1442652909029021215) },
+	{ imm_u64(12534169028502795672), imm_u64(1803316136286276519) },
+	{ imm_u64(11056025267201106687), imm_u64(2254145170357845649) },
+	{ imm_u64(18439230838069161439), imm_u64(1408840731473653530) },
+	{ imm_u64(13825666510731675991), imm_u64(1761050914342066913) },
+	{ imm_u64(3447025083132431277), imm_u64(2201313642927583642) },
+	{ imm_u64(6766076695385157452), imm_u64(1375821026829739776) },
+	{ imm_u64(8457595869231446815), imm_u64(1719776283537174720) },
+	{ imm_u64(10571994836539308519), imm_u64(2149720354421468400) },
+	{ imm_u64(6607496772837067824), imm_u64(1343575221513417750) },
+	{ imm_u64(17482743002901110588), imm_u64(1679469026891772187) },
+	{ imm_u64(17241742735199000331), imm_u64(2099336283614715234) },
+	{ imm_u64(15387775227926763111), imm_u64(1312085177259197021) },
+	{ imm_u64(5399660979626290177), imm_u64(1640106471573996277) },
+	{ imm_u64(11361262242960250625), imm_u64(2050133089467495346) },
+	{ imm_u64(11712474920277544544), imm_u64(1281333180917184591) },
+	{ imm_u64(10028907631919542777), imm_u64(1601666476146480739) },
+	{ imm_u64(7924448521472040567), imm_u64(2002083095183100924) },
+	{ imm_u64(14176152362774801162), imm_u64(1251301934489438077) },
+	{ imm_u64(3885132398186337741), imm_u64(1564127418111797597) },
+	{ imm_u64(9468101516160310080), imm_u64(1955159272639746996) },
+	{ imm_u64(15140935484454969608), imm_u64(1221974545399841872) },
+	{ imm_u64(479425281859160394), imm_u64(1527468181749802341) },
+	{ imm_u64(5210967620751338397), imm_u64(1909335227187252926) },
+	{ imm_u64(17091912818251750210), imm_u64(1193334516992033078) },
+	{ imm_u64(12141518985959911954), imm_u64(1491668146240041348) },
+	{ imm_u64(15176898732449889943), imm_u64(1864585182800051685) },
+	{ imm_u64(11791404716994875166), imm_u64(1165365739250032303) },
+	{ imm_u64(10127569877816206054), imm_u64(1456707174062540379) },
+	{ imm_u64(8047776328842869663), imm_u64(1820883967578175474) },
+	{ imm_u64(836348374198811271), imm_u64(2276104959472719343) },
+	{ imm_u64(7440246761515338900), imm_u64(1422565599670449589) },
+	{ imm_u64(13911994470321561530), imm_u64(1778206999588061986) },
+	{ imm_u64(8166621051047176104), imm_u64(2222758749485077483) },
+	{ imm_u64(2798295147690791113), imm_u64(1389224218428173427) },
+	{ imm_u64(17332926989895652603), imm_u64(1736530273035216783) },
+	{ imm_u64(17054472718942177850), imm_u64(2170662841294020979) },
+	{ imm_u64(8353202440125167204), imm_u64(1356664275808763112) },
+	{ imm_u64(10441503050156459005), imm_u64(1695830344760953890) },
+	{ imm_u64(3828506775840797949), imm_u64(2119787930951192363) },
+	{ imm_u64(86973725686804766), imm_u64(1324867456844495227) },
+	{ imm_u64(13943775212390669669), imm_u64(1656084321055619033) },
+	{ imm_u64(3594660960206173375), imm_u64(2070105401319523792) },
+	{ imm_u64(2246663100128858359), imm_u64(1293815875824702370) },
+	{ imm_u64(12031700912015848757), imm_u64(1617269844780877962) },
+	{ imm_u64(5816254103165035138), imm_u64(2021587305976097453) },
+	{ imm_u64(5941001823691840913), imm_u64(1263492066235060908) },
+	{ imm_u64(7426252279614801142), imm_u64(1579365082793826135) },
+	{ imm_u64(4671129331091113523), imm_u64(1974206353492282669) },
+	{ imm_u64(5225298841145639904), imm_u64(1233878970932676668) },
+	{ imm_u64(6531623551432049880), imm_u64(1542348713665845835) },
+	{ imm_u64(3552843420862674446), imm_u64(1927935892082307294) },
+	{ imm_u64(16055585193321335241), imm_u64(1204959932551442058) },
+	{ imm_u64(10846109454796893243), imm_u64(1506199915689302573) },
+	{ imm_u64(18169322836923504458), imm_u64(1882749894611628216) },
+	{ imm_u64(11355826773077190286), imm_u64(1176718684132267635) },
+	{ imm_u64(9583097447919099954), imm_u64(1470898355165334544) },
+	{ imm_u64(11978871809898874942), imm_u64(1838622943956668180) },
+	{ imm_u64(14973589762373593678), imm_u64(2298278679945835225) },
+	{ imm_u64(2440964573842414192), imm_u64(1436424174966147016) },
+	{ imm_u64(3051205717303017741), imm_u64(1795530218707683770) },
+	{ imm_u64(13037379183483547984), imm_u64(2244412773384604712) },
+	{ imm_u64(8148361989677217490), imm_u64(1402757983365377945) },
+	{ imm_u64(14797138505523909766), imm_u64(1753447479206722431) },
+	{ imm_u64(13884737113477499304), imm_u64(2191809349008403039) },
+	{ imm_u64(15595489723564518921), imm_u64(1369880843130251899) },
+	{ imm_u64(14882676136028260747), imm_u64(1712351053912814874) },
+	{ imm_u64(9379973133180550126), imm_u64(2140438817391018593) },
+	{ imm_u64(17391698254306313589), imm_u64(1337774260869386620) },
+	{ imm_u64(3292878744173340370), imm_u64(1672217826086733276) },
+	{ imm_u64(4116098430216675462), imm_u64(2090272282608416595) },
+	{ imm_u64(266718509671728212), imm_u64(1306420176630260372) },
+	{ imm_u64(333398137089660265), imm_u64(1633025220787825465) },
+	{ imm_u64(5028433689789463235), imm_u64(2041281525984781831) },
+	{ imm_u64(10060300083759496378), imm_u64(1275800953740488644) },
+	{ imm_u64(12575375104699370472), imm_u64(1594751192175610805) },
+	{ imm_u64(1884160825592049379), imm_u64(1993438990219513507) },
+	{ imm_u64(17318501580490888525), imm_u64(1245899368887195941) },
+	{ imm_u64(7813068920331446945), imm_u64(1557374211108994927) },
+	{ imm_u64(5154650131986920777), imm_u64(1946717763886243659) },
+	{ imm_u64(915813323278131534), imm_u64(1216698602428902287) },
+	{ imm_u64(14979824709379828129), imm_u64(1520873253036127858) },
+	{ imm_u64(9501408849870009354), imm_u64(1901091566295159823) },
+	{ imm_u64(12855909558809837702), imm_u64(1188182228934474889) },
+	{ imm_u64(2234828893230133415), imm_u64(1485227786168093612) },
+	{ imm_u64(2793536116537666769), imm_u64(1856534732710117015) },
+	{ imm_u64(8663489100477123587), imm_u64(1160334207943823134) },
+	{ imm_u64(1605989338741628675), imm_u64(1450417759929778918) },
+	{ imm_u64(11230858710281811652), imm_u64(1813022199912223647) },
+	{ imm_u64(9426887369424876662), imm_u64(2266277749890279559) },
+	{ imm_u64(12809333633531629769), imm_u64(1416423593681424724) },
+	{ imm_u64(16011667041914537212), imm_u64(1770529492101780905) },
+	{ imm_u64(6179525747111007803), imm_u64(2213161865127226132) },
+	{ imm_u64(13085575628799155685), imm_u64(1383226165704516332) },
+	{ imm_u64(16356969535998944606), imm_u64(1729032707130645415) },
+	{ imm_u64(15834525901571292854), imm_u64(2161290883913306769) },
+	{ imm_u64(2979049660840976177), imm_u64(1350806802445816731) },
+	{ imm_u64(17558870131333383934), imm_u64(1688508503057270913) },
+	{ imm_u64(8113529608884566205), imm_u64(2110635628821588642) },
+	{ imm_u64(9682642023980241782), imm_u64(1319147268013492901) },
+	{ imm_u64(16714988548402690132), imm_u64(1648934085016866126) },
+	{ imm_u64(11670363648648586857), imm_u64(2061167606271082658) },
+	{ imm_u64(11905663298832754689), imm_u64(1288229753919426661) },
+	{ imm_u64(1047021068258779650), imm_u64(1610287192399283327) },
+	{ imm_u64(15143834390605638274), imm_u64(2012858990499104158) },
+	{ imm_u64(4853210475701136017), imm_u64(1258036869061940099) },
+	{ imm_u64(1454827076199032118), imm_u64(1572546086327425124) },
+	{ imm_u64(1818533845248790147), imm_u64(1965682607909281405) },
+	{ imm_u64(3442426662494187794), imm_u64(1228551629943300878) },
+	{ imm_u64(13526405364972510550), imm_u64(1535689537429126097) },
+	{ imm_u64(3072948650933474476), imm_u64(1919611921786407622) },
+	{ imm_u64(15755650962115585259), imm_u64(1199757451116504763) },
+	{ imm_u64(15082877684217093670), imm_u64(1499696813895630954) },
+	{ imm_u64(9630225068416591280), imm_u64(1874621017369538693) },
+	{ imm_u64(8324733676974063502), imm_u64(1171638135855961683) },
+	{ imm_u64(5794231077790191473), imm_u64(1464547669819952104) },
+	{ imm_u64(7242788847237739342), imm_u64(1830684587274940130) },
+	{ imm_u64(18276858095901949986), imm_u64(2288355734093675162) },
+	{ imm_u64(16034722328366106645), imm_u64(1430222333808546976) },
+	{ imm_u64(1596658836748081690), imm_u64(1787777917260683721) },
+	{ imm_u64(6607509564362490017), imm_u64(2234722396575854651) },
+	{ imm_u64(1823850468512862308), imm_u64(1396701497859909157) },
+	{ imm_u64(6891499104068465790), imm_u64(1745876872324886446) },
+	{ imm_u64(17837745916940358045), imm_u64(2182346090406108057) },
+	{ imm_u64(4231062170446641922), imm_u64(1363966306503817536) },
+	{ imm_u64(5288827713058302403), imm_u64(1704957883129771920) },
+	{ imm_u64(6611034641322878003), imm_u64(2131197353912214900) },
+	{ imm_u64(13355268687681574560), imm_u64(1331998346195134312) },
+	{ imm_u64(16694085859601968200), imm_u64(1664997932743917890) },
+	{ imm_u64(11644235287647684442), imm_u64(2081247415929897363) },
+	{ imm_u64(4971804045566108824), imm_u64(1300779634956185852) },
+	{ imm_u64(6214755056957636030), imm_u64(1625974543695232315) },
+	{ imm_u64(3156757802769657134), imm_u64(2032468179619040394) },
+	{ imm_u64(6584659645158423613), imm_u64(1270292612261900246) },
+	{ imm_u64(17454196593302805324), imm_u64(1587865765327375307) },
+	{ imm_u64(17206059723201118751), imm_u64(1984832206659219134) },
+	{ imm_u64(6142101308573311315), imm_u64(1240520129162011959) },
+	{ imm_u64(3065940617289251240), imm_u64(1550650161452514949) },
+	{ imm_u64(8444111790038951954), imm_u64(1938312701815643686) },
+	{ imm_u64(665883850346957067), imm_u64(1211445438634777304) },
+	{ imm_u64(832354812933696334), imm_u64(1514306798293471630) },
+	{ imm_u64(10263815553021896226), imm_u64(1892883497866839537) },
+	{ imm_u64(17944099766707154901), imm_u64(1183052186166774710) },
+	{ imm_u64(13206752671529167818), imm_u64(1478815232708468388) },
+	{ imm_u64(16508440839411459773), imm_u64(1848519040885585485) },
+	{ imm_u64(12623618533845856310), imm_u64(1155324400553490928) },
+	{ imm_u64(15779523167307320387), imm_u64(1444155500691863660) },
+	{ imm_u64(1277659885424598868), imm_u64(1805194375864829576) },
+	{ imm_u64(1597074856780748586), imm_u64(2256492969831036970) },
+	{ imm_u64(5609857803915355770), imm_u64(1410308106144398106) },
+	{ imm_u64(16235694291748970521), imm_u64(1762885132680497632) },
+	{ imm_u64(1847873790976661535), imm_u64(2203606415850622041) },
+	{ imm_u64(12684136165428883219), imm_u64(1377254009906638775) },
+	{ imm_u64(11243484188358716120), imm_u64(1721567512383298469) },
+	{ imm_u64(219297180166231438), imm_u64(2151959390479123087) },
+	{ imm_u64(7054589765244976505), imm_u64(1344974619049451929) },
+	{ imm_u64(13429923224983608535), imm_u64(1681218273811814911) },
+	{ imm_u64(12175718012802122765), imm_u64(2101522842264768639) },
+	{ imm_u64(14527352785642408584), imm_u64(1313451776415480399) },
+	{ imm_u64(13547504963625622826), imm_u64(1641814720519350499) },
+	{ imm_u64(12322695186104640628), imm_u64(2052268400649188124) },
+	{ imm_u64(16925056528170176201), imm_u64(1282667750405742577) },
+	{ imm_u64(7321262604930556539), imm_u64(1603334688007178222) },
+	{ imm_u64(18374950293017971482), imm_u64(2004168360008972777) },
+	{ imm_u64(4566814905495150320), imm_u64(1252605225005607986) },
+	{ imm_u64(14931890668723713708), imm_u64(1565756531257009982) },
+	{ imm_u64(9441491299049866327), imm_u64(1957195664071262478) },
+	{ imm_u64(1289246043478778550), imm_u64(1223247290044539049) },
+	{ imm_u64(6223243572775861092), imm_u64(1529059112555673811) },
+	{ imm_u64(3167368447542438461), imm_u64(1911323890694592264) },
+	{ imm_u64(1979605279714024038), imm_u64(1194577431684120165) },
+	{ imm_u64(7086192618069917952), imm_u64(1493221789605150206) },
+	{ imm_u64(18081112809442173248), imm_u64(1866527237006437757) },
+	{ imm_u64(13606538515115052232), imm_u64(1166579523129023598) },
+	{ imm_u64(7784801107039039482), imm_u64(1458224403911279498) },
+	{ imm_u64(507629346944023544), imm_u64(1822780504889099373) },
+	{ imm_u64(5246222702107417334), imm_u64(2278475631111374216) },
+	{ imm_u64(3278889188817135834), imm_u64(1424047269444608885) },
+	{ imm_u64(8710297504448807696), imm_u64(1780059086805761106) },
+};
+
+/* Bit length of 5^e, floor(log10(2^e)) and floor(log10(5^e)). */
+_format_alwaysinline static s32 format_pow5bits(s32 e) { return (s32) (((u32) e * 1217359) >> 19) + 1; }
+_format_alwaysinline static u32 format_log10pow2(s32 e) { return ((u32) e * 78913) >> 18; }
+_format_alwaysinline static u32 format_log10pow5(s32 e) { return ((u32) e * 732923) >> 20; }
+
+_format_alwaysinline static bool format_pow5mul(u64 v, u32 p) {
+	u32 n = 0;
+	for (; v % 5 == 0; v /= 5)
+		++n;
+	return n >= p;
+}
+
+_format_alwaysinline static bool format_pow2mul(u64 v, u32 p) { return (v & ((imm_u64(1) << p) - 1)) == 0; }
+
+/* (m * mul) >> j for a 125-bit mul and 64 < j < 128. */
+_format_alwaysinline static u64 format_mulshift(u64 m, const u64 *mul, s32 j) {
+	u64 lo0, lo2, hi0 = mulwide_u64(m, mul[0], &lo0);
+	u64 hi2 = mulwide_u64(m, mul[1], &lo2);
+	u64 lo = lo2 + hi0;
+	u64 hi = hi2 + (lo < lo2);
+	j -= 64;
+	return hi << (64 - j) | lo >> j;
+}
+
+/* Returns the shortest digits and sets *exp so that the value is
+   digits * 10^exp, for a float of mbits explicit mantissa bits. */
+static u64 format_ryu(u64 mantissa, u32 exponent, u32 mbits, s32 bias, s32 *exp) {
+	s32 e2;
+	u64 m2, mv, vr, vp, vm, out;
+	u32 mmshift, q, removed = 0, last = 0;
+	bool accept, vmzeros = false, vrzeros = false;
+	s32 e10;
+
+	if (exponent == 0) {
+		e2 = 1 - bias - (s32) mbits - 2;
+		m2 = mantissa;
+	} else {
+		e2 = (s32) exponent - bias - (s32) mbits - 2;
+		m2 = imm_u64(1) << mbits | mantissa;
+	}
+	accept = (m2 & 1) == 0;
+	mv = 4 * m2;
+	mmshift = mantissa != 0 || exponent <= 1;
+
+	if (e2 >= 0) {
+		s32 k, i;
+		q = format_log10pow2(e2) - (e2 > 3);
+		e10 = (s32) q;
+		k = FORMAT_POW5_INV_BITCOUNT + format_pow5bits((s32) q) - 1;
+		i = -e2 + (s32) q + k;
+		vr = format_mulshift(4 * m2, FORMAT_POW5_INV_SPLIT[q], i);
+		vp = format_mulshift(4 * m2 + 2, FORMAT_POW5_INV_SPLIT[q], i);
+		vm = format_mulshift(4 * m2 - 1 - mmshift, FORMAT_POW5_INV_SPLIT[q], i);
+		if (q <= 21) {
+			if (mv % 5 == 0)
+				vrzeros = format_pow5mul(mv, q);
+			else if (accept)
+				vmzeros = format_pow5mul(mv - 1 - mmshift, q);
+			else
+				vp -= format_pow5mul(mv + 2, q);
+		}
+	} else {
+		s32 k, i, j;
+		q = format_log10pow5(-e2) - (-e2 > 1);
+		e10 = (s32) q + e2;
+		i = -e2 - (s32) q;
+		k = format_pow5bits(i) - FORMAT_POW5_BITCOUNT;
+		j = (s32) q - k;
+		vr = format_mulshift(4 * m2, FORMAT_POW5_SPLIT[i], j);
+		vp = format_mulshift(4 * m2 + 2, FORMAT_POW5_SPLIT[i], j);
+		vm = format_mulshift(4 * m2 - 1 - mmshift, FORMAT_POW5_SPLIT[i], j);
+		if (q <= 1) {
+			vrzeros = true;
+			if (accept)
+				vmzeros = mmshift == 1;
+			else
+				--vp;
+		} else if (q < 63)
+			vrzeros = format_pow2mul(mv, q);
+	}
+
+	if (vmzeros || vrzeros) {
+		for (; vp / 10 > vm / 10; ++removed) {
+			vmzeros &= vm % 10 == 0;
+			vrzeros &= last == 0;
+			last = (u32) (vr % 10);
+			vr /= 10;
+			vp /= 10;
+			vm /= 10;
+		}
+		if (vmzeros)
+			for (; vm % 10 == 0; ++removed) {
+				vrzeros &= last == 0;
+				last = (u32) (vr % 10);
+				vr /= 10;
+				vp /= 10;
+				vm /= 10;
+			}
+		if (vrzeros && last == 5 && vr % 2 == 0)
+			last = 4;
+		out = vr + ((vr == vm && (!accept || !vmzeros)) || last >= 5);
+	} else {
+		bool up = false;
+		for (; vp / 10 > vm / 10; ++removed) {
+			up = vr % 10 >= 5;
+			vr /= 10;
+			vp /= 10;
+			vm /= 10;
+		}
+		out = vr + (vr == vm || up);
+	}
+	*exp = e10 + (s32) removed;
+	return out;
+}
+
+static size_t format_float(char *buf, bool sign, u64 mantissa, u32 exponent, u32 mbits, u32 ebits) {
+	char digits[20];
+	char *p = buf;
+	s32 exp, k, n;
+	u64 v;
+
+	if (sign)
+		*p++ = '-';
+	if (exponent == (1u << ebits) - 1) {
+		if (mantissa != 0)
+			p = buf;
+		memcpy(p, mantissa != 0 ? "nan" : "inf", 3);
+		return (size_t) (p - buf) + 3;
+	}
+	if (exponent == 0 && mantissa == 0) {
+		*p = '0';
+		return (size_t) (p - buf) + 1;
+	}
+
+	v = format_ryu(mantissa, exponent, mbits, (1 << (ebits - 1)) - 1, &exp);
+	n = (s32) format_u64(digits, v);
+	k = n + exp;
+	if (k > 0 && k <= 21) {
+		if (exp >= 0) {
+			memcpy(p, digits, (size_t) n);
+			memset(p + n, '0', (size_t) exp);
+			p += k;
+		} else {
+			memcpy(p, digits, (size_t) k);
+			p[k] = '.';
+			memcpy(p + k + 1, digits + k, (size_t) (n - k));
+			p += n + 1;
+		}
+	} else if (k > -6 && k <= 0) {
+		p[0] = '0';
+		p[1] = '.';
+		memset(p + 2, '0', (size_t) -k);
+		memcpy(p + 2 - k, digits, (size_t) n);
+		p += 2 - k + n;
+	} else {
+		*p++ = digits[0];
+		if (n > 1) {
+			*p++ = '.';
+			memcpy(p, digits + 1, (size_t) (n - 1));
+			p += n - 1;
+		}
+		*p++ = 'e';
+		*p++ = k - 1 < 0 ? '-' : '+';
+		p += format_u32(p, (u32) (k - 1 < 0 ? 1 - k : k - 1));
+	}
+	return (size_t) (p - buf);
+}
+
+size_t format_f64(char *buf, f64 value) {
+	u64 bits;
+	memcpy(&bits, &value, sizeof bits);
+	return format_float(buf, bits >> 63 != 0, bits & ((imm_u64(1) << 52) - 1), (u32) (bits >> 52) & 0x7ff, 52, 11);
+}
+
+size_t format_f32(char *buf, f32 value) {
+	u32 bits;
+	memcpy(&bits, &value, sizeof bits);
+	return format_float(buf, bits >> 31 != 0, bits & ((1u << 23) - 1), (bits >> 23) & 0xff, 23, 8);
+}
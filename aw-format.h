@@ -0,0 +1,83 @@
+
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+#ifndef AW_FORMAT_H
+#define AW_FORMAT_H
+
+#include "aw-types.h"
+
+#include <stddef.h>
+
+#if defined(_format_dllexport)
+# if defined(_MSC_VER)
+#  define _format_api extern __declspec(dllexport)
+# elif defined(__GNUC__)
+#  define _format_api __attribute__((visibility("default"))) extern
+# endif
+#elif defined(_format_dllimport)
+# if defined(_MSC_VER)
+#  define _format_api extern __declspec(dllimport)
+# endif
+#endif
+#ifndef _format_api
+# define _format_api extern
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The most characters each writer produces. */
+#define FORMAT_MAX_U32 10
+#define FORMAT_MAX_S32 11
+#define FORMAT_MAX_U64 20
+#define FORMAT_MAX_S64 20
+#define FORMAT_MAX_X32 8
+#define FORMAT_MAX_X64 16
+#define FORMAT_MAX_F32 22
+#define FORMAT_MAX_F64 25
+
+/* Writers store the text at buf without a terminator and return its length.
+   They do not parse a format or look at the locale. Decimal output has no
+   leading zeros and hexadecimal output is lower case without a prefix. */
+_format_api size_t format_u32(char *buf, u32 value);
+_format_api size_t format_s32(char *buf, s32 value);
+_format_api size_t format_u64(char *buf, u64 value);
+_format_api size_t format_s64(char *buf, s64 value);
+_format_api size_t format_x32(char *buf, u32 value);
+_format_api size_t format_x64(char *buf, u64 value);
+
+/* Floats are written with the fewest digits that read back to the same
+   value (Ryu), laid out like JavaScript numbers: plain notation for
+   magnitudes from 1e-6 up to 1e21 and d.ddde+n outside it, as in 1.5,
+   0.001, 1e+21 and 5e-324. Infinities and NaN are written inf, -inf and
+   nan, and negative zero as -0. */
+_format_api size_t format_f32(char *buf, f32 value);
+_format_api size_t format_f64(char *buf, f64 value);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* AW_FORMAT_H */
+
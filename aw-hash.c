@@ -0,0 +1,532 @@
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+
+#include "aw-hash.h"
+#include "aw-arith.h"
+#include "aw-cpu.h"
+#include "aw-endian.h"
+
+#include <string.h>
+
+#if defined(__GNUC__)
+# define _hash_alwaysinline __attribute__((always_inline)) inline
+#elif defined(_MSC_VER)
+# define _hash_alwaysinline __forceinline
+#endif
+
+#if !defined(_cpu_dispatch_x86) && (defined(__aarch64__) || defined(_M_ARM64)) && !defined(__ARM_BIG_ENDIAN)
+# include <arm_neon.h>
+# define _hash_neon 1
+#endif
+
+#define HASH_P32_1 0x9e3779b1u
+#define HASH_P32_2 0x85ebca77u
+#define HASH_P32_3 0xc2b2ae3du
+#define HASH_P64_1 imm_u64(0x9e3779b185ebca87)
+#define HASH_P64_2 imm_u64(0xc2b2ae3d27d4eb4f)
+#define HASH_P64_3 imm_u64(0x165667b19e3779f9)
+#define HASH_P64_4 imm_u64(0x85ebca77c2b2ae63)
+#define HASH_P64_5 imm_u64(0x27d4eb2f165667c5)
+#define HASH_MX1 imm_u64(0x165667919e3779f9)
+#define HASH_MX2 imm_u64(0x9fb21c651e98df25)
+
+/* Long inputs go in stripes of 64 bytes, each keyed by the secret 8 bytes
+   further on, and the accumulators are scrambled after every block of 16
+   stripes. The last stripe of the input and the merge use secret offsets
+   that are off the 8-byte grid. */
+#define HASH_STRIPE 64
+#define HASH_BLOCK 16
+#define HASH_MIDSIZE 240
+#define HASH_LASTACC (sizeof HASH_SECRET - HASH_STRIPE - 7)
+#define HASH_MERGE 11
+
+static const u8 HASH_SECRET[192] = {
+	0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+	0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+	0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+	0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+	0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+	0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+	0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+	0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+	0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+	0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+	0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+	0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+static const u64 HASH_ACC[8] = {
+	HASH_P32_3, HASH_P64_1, HASH_P64_2, HASH_P64_3, HASH_P64_4, HASH_P32_2, HASH_P64_5, HASH_P32_1,
+};
+
+_hash_alwaysinline static u64 hash_rotl(u64 v, u32 r) { return v << r | v >> (64 - r); }
+
+_hash_alwaysinline static u64 hash_mulfold(u64 a, u64 b) {
+	u64 lo, hi = mulwide_u64(a, b, &lo);
+	return lo ^ hi;
+}
+
+_hash_alwaysinline static u64 hash_avalanche64(u64 h) {
+	h = (h ^ h >> 33) * HASH_P64_2;
+	h = (h ^ h >> 29) * HASH_P64_3;
+	return h ^ h >> 32;
+}
+
+_hash_alwaysinline static u64 hash_avalanche(u64 h) {
+	h = (h ^ h >> 37) * HASH_MX1;
+	return h ^ h >> 32;
+}
+
+_hash_alwaysinline static u64 hash_rrmxmx(u64 h, u64 len) {
+	h ^= hash_rotl(h, 49) ^ hash_rotl(h, 24);
+	h *= HASH_MX2;
+	h ^= (h >> 35) + len;
+	h *= HASH_MX2;
+	return h ^ h >> 28;
+}
+
+_hash_alwaysinline static u64 hash_mix16(const u8 *p, const u8 *k, u64 seed) {
+	return hash_mulfold(_load_le64(p) ^ (_load_le64(k) + seed), _load_le64(p + 8) ^ (_load_le64(k + 8) - seed));
+}
+
+_hash_alwaysinline static struct hash128 hash_mix32(struct hash128 acc, const u8 *p, const u8 *q, const u8 *k, u64 seed) {
+	acc.lo += hash_mix16(p, k, seed);
+	acc.lo ^= _load_le64(q) + _load_le64(q + 8);
+	acc.hi += hash_mix16(q, k + 16, seed);
+	acc.hi ^= _load_le64(p) + _load_le64(p + 8);
+	return acc;
+}
+
+/* Inputs up to HASH_MIDSIZE bytes always use the default secret. */
+static u64 hash64_small(const u8 *p, size_t n, u64 seed) {
+	const u8 *k = HASH_SECRET;
+	u64 acc, end;
+	u32 i;
+	if (n <= 16) {
+		if (n > 8) {
+			u64 lo = _load_le64(p) ^ ((_load_le64(k + 24) ^ _load_le64(k + 32)) + seed);
+			u64 hi = _load_le64(p + n - 8) ^ ((_load_le64(k + 40) ^ _load_le64(k + 48)) - seed);
+			return hash_avalanche(n + _byteswap64(lo) + hi + hash_mulfold(lo, hi));
+		}
+		if (n >= 4) {
+			u64 v = _load_le32(p + n - 4) + ((u64) _load_le32(p) << 32);
+			seed ^= (u64) _byteswap32((u32) seed) << 32;
+			return hash_rrmxmx(v ^ ((_load_le64(k + 8) ^ _load_le64(k + 16)) - seed), n);
+		}
+		if (n > 0) {
+			u32 c = (u32) p[0] << 16 | (u32) p[n >> 1] << 24 | p[n - 1] | (u32) n << 8;
+			return hash_avalanche64(c ^ ((_load_le32(k) ^ _load_le32(k + 4)) + seed));
+		}
+		return hash_avalanche64(seed ^ _load_le64(k + 56) ^ _load_le64(k + 64));
+	}
+	acc = n * HASH_P64_1;
+	if (n <= 128) {
+		i = (u32) (n - 1) / 32;
+		do {
+			acc += hash_mix16(p + 16 * i, k + 32 * i, seed);
+			acc += hash_mix16(p + n - 16 * (i + 1), k + 32 * i + 16, seed);
+		} while (i-- != 0);
+		return hash_avalanche(acc);
+	}
+	for (i = 0; i < 8; ++i)
+		acc += hash_mix16(p + 16 * i, k + 16 * i, seed);
+	end = hash_mix16(p + n - 16, k + 136 - 17, seed);
+	for (i = 8; i < n / 16; ++i)
+		end += hash_mix16(p + 16 * i, k + 16 * (i - 8) + 3, seed);
+	return hash_avalanche(hash_avalanche(acc) + end);
+}
+
+static struct hash128 hash128_small(const u8 *p, size_t n, u64 seed) {
+	const u8 *k = HASH_SECRET;
+	struct hash128 h, acc;
+	u32 i;
+	if (n <= 16) {
+		if (n > 8) {
+			u64 lo = _load_le64(p), hi = _load_le64(p + n - 8), mlo, mhi;
+			mhi = mulwide_u64(lo ^ hi ^ ((_load_le64(k + 32) ^ _load_le64(k + 40)) - seed), HASH_P64_1, &mlo);
+			mlo += (u64) (n - 1) << 54;
+			hi ^= (_load_le64(k + 48) ^ _load_le64(k + 56)) + seed;
+			mhi += hi + (hi & 0xffffffff) * (HASH_P32_2 - 1);
+			mlo ^= _byteswap64(mhi);
+			h.hi = mulwide_u64(mlo, HASH_P64_2, &h.lo) + mhi * HASH_P64_2;
+			h.lo = hash_avalanche(h.lo);
+			h.hi = hash_avalanche(h.hi);
+			return h;
+		}
+		if (n >= 4) {
+			u64 v = _load_le32(p) + ((u64) _load_le32(p + n - 4) << 32);
+			seed ^= (u64) _byteswap32((u32) seed) << 32;
+			h.hi = mulwide_u64(v ^ ((_load_le64(k + 16) ^ _load_le64(k + 24)) + seed), HASH_P64_1 + (n << 2), &h.lo);
+			h.hi += h.lo << 1;
+			h.lo ^= h.hi >> 3;
+			h.lo = (h.lo ^ h.lo >> 35) * HASH_MX2;
+			h.lo ^= h.lo >> 28;
+			h.hi = hash_avalanche(h.hi);
+			return h;
+		}
+		if (n > 0) {
+			u32 c = (u32) p[0] << 16 | (u32) p[n >> 1] << 24 | p[n - 1] | (u32) n << 8;
+			u32 d = _byteswap32(c);
+			d = d << 13 | d >> 19;
+			h.lo = hash_avalanche64(c ^ ((_load_le32(k) ^ _load_le32(k + 4)) + seed));
+			h.hi = hash_avalanche64(d ^ ((_load_le32(k + 8) ^ _load_le32(k + 12)) - seed));
+			return h;
+		}
+		h.lo = hash_avalanche64(seed ^ _load_le64(k + 64) ^ _load_le64(k + 72));
+		h.hi = hash_avalanche64(seed ^ _load_le64(k + 80) ^ _load_le64(k + 88));
+		return h;
+	}
+	acc.lo = n * HASH_P64_1;
+	acc.hi = 0;
+	if (n <= 128) {
+		i = (u32) (n - 1) / 32;
+		do
+			acc = hash_mix32(acc, p + 16 * i, p + n - 16 * (i + 1), k + 32 * i, seed);
+		while (i-- != 0);
+	} else {
+		for (i = 32; i < 160; i += 32)
+			acc = hash_mix32(acc, p + i - 32, p + i - 16, k + i - 32, seed);
+		acc.lo = hash_avalanche(acc.lo);
+		acc.hi = hash_avalanche(acc.hi);
+		for (i = 160; i <= n; i += 32)
+			acc = hash_mix32(acc, p + i - 32, p + i - 16, k + 3 + i - 160, seed);
+		acc = hash_mix32(acc, p + n - 16, p + n - 32, k + 136 - 17 - 16, 0 - seed);
+	}
+	h.lo = hash_avalanche(acc.lo + acc.hi);
+	h.hi = 0 - hash_avalanche(acc.lo * HASH_P64_1 + acc.hi * HASH_P64_4 + (n - seed) * HASH_P64_2);
+	return h;
+}
+
+/* Kernels accumulate n stripes keyed from k onwards and then, unless s is
+   NULL, scramble the accumulators with the key at s. */
+typedef void (*hash_stripes_fn)(u64 *acc, const u8 *p, size_t n, const u8 *k, const u8 *s);
+
+#if !defined(_hash_neon)
+static void hash_stripes_scalar(u64 *acc, const u8 *p, size_t n, const u8 *k, const u8 *s) {
+	size_t i, j;
+	for (j = 0; j < n; ++j, p += HASH_STRIPE, k += 8)
+		for (i = 0; i < 8; ++i) {
+			u64 v = _load_le64(p + i * 8), x = v ^ _load_le64(k + i * 8);
+			acc[i ^ 1] += v;
+			acc[i] += (x & 0xffffffff) * (x >> 32);
+		}
+	if (s != NULL)
+		for (i = 0; i < 8; ++i) {
+			u64 a = acc[i];
+			acc[i] = (a ^ a >> 47 ^ _load_le64(s + i * 8)) * HASH_P32_1;
+		}
+}
+#endif
+
+#if defined(_cpu_dispatch_x86)
+_cpu_target("avx512f")
+static void hash_stripes_avx512(u64 *acc, const u8 *p, size_t n, const u8 *k, const u8 *s) {
+	__m512i a = _mm512_loadu_si512((const void *) acc);
+	size_t j;
+	for (j = 0; j < n; ++j, p += HASH_STRIPE, k += 8) {
+		__m512i v = _mm512_loadu_si512((const void *) p);
+		__m512i x = _mm512_xor_si512(v, _mm512_loadu_si512((const void *) k));
+		a = _mm512_add_epi64(a, _mm512_mul_epu32(x, _mm512_srli_epi64(x, 32)));
+		a = _mm512_add_epi64(a, _mm512_shuffle_epi32(v, (_MM_PERM_ENUM) _MM_SHUFFLE(1, 0, 3, 2)));
+	}
+	if (s != NULL) {
+		const __m512i prime = _mm512_set1_epi32((int) HASH_P32_1);
+		__m512i x = _mm512_xor_si512(_mm512_xor_si512(a, _mm512_srli_epi64(a, 47)), _mm512_loadu_si512((const void *) s));
+		a = _mm512_add_epi64(_mm512_mul_epu32(x, prime), _mm512_slli_epi64(_mm512_mul_epu32(_mm512_srli_epi64(x, 32), prime), 32));
+	}
+	_mm512_storeu_si512((void *) acc, a);
+}
+
+_cpu_target("avx2")
+static void hash_stripes_avx2(u64 *acc, const u8 *p, size_t n, const u8 *k, const u8 *s) {
+	__m256i a[2];
+	size_t i, j;
+	for (i = 0; i < 2; ++i)
+		a[i] = _mm256_loadu_si256((const __m256i *) acc + i);
+	for (j = 0; j < n; ++j, p += HASH_STRIPE, k += 8)
+		for (i = 0; i < 2; ++i) {
+			__m256i v = _mm256_loadu_si256((const __m256i *) p + i);
+			__m256i x = _mm256_xor_si256(v, _mm256_loadu_si256((const __m256i *) k + i));
+			a[i] = _mm256_add_epi64(a[i], _mm256_mul_epu32(x, _mm256_srli_epi64(x, 32)));
+			a[i] = _mm256_add_epi64(a[i], _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+		}
+	if (s != NULL) {
+		const __m256i prime = _mm256_set1_epi32((int) HASH_P32_1);
+		for (i = 0; i < 2; ++i) {
+			__m256i x = _mm256_xor_si256(_mm256_xor_si256(a[i], _mm256_srli_epi64(a[i], 47)), _mm256_loadu_si256((const __m256i *) s + i));
+			a[i] = _mm256_add_epi64(_mm256_mul_epu32(x, prime), _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(x, 32), prime), 32));
+		}
+	}
+	for (i = 0; i < 2; ++i)
+		_mm256_storeu_si256((__m256i *) acc + i, a[i]);
+}
+
+_cpu_target("sse2")
+static void hash_stripes_sse2(u64 *acc, const u8 *p, size_t n, const u8 *k, const u8 *s) {
+	__m128i a[4];
+	size_t i, j;
+	for (i = 0; i < 4; ++i)
+		a[i] = _mm_loadu_si128((const __m128i *) acc + i);
+	for (j = 0; j < n; ++j, p += HASH_STRIPE, k += 8)
+		for (i = 0; i < 4; ++i) {
+			__m128i v = _mm_loadu_si128((const __m128i *) p + i);
+			__m128i x = _mm_xor_si128(v, _mm_loadu_si128((const __m128i *) k + i));
+			a[i] = _mm_add_epi64(a[i], _mm_mul_epu32(x, _mm_srli_epi64(x, 32)));
+			a[i] = _mm_add_epi64(a[i], _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+		}
+	if (s != NULL) {
+		const __m128i prime = _mm_set1_epi32((int) HASH_P32_1);
+		for (i = 0; i < 4; ++i) {
+			__m128i x = _mm_xor_si128(_mm_xor_si128(a[i], _mm_srli_epi64(a[i], 47)), _mm_loadu_si128((const __m128i *) s + i));
+			a[i] = _mm_add_epi64(_mm_mul_epu32(x, prime), _mm_slli_epi64(_mm_mul_epu32(_mm_srli_epi64(x, 32), prime), 32));
+		}
+	}
+	for (i = 0; i < 4; ++i)
+		_mm_storeu_si128((__m128i *) acc + i, a[i]);
+}
+
+static void hash_stripes_resolve(u64 *acc, const u8 *p, size_t n, const u8 *k, const u8 *s);
+static _cpu_ptr(hash_stripes_fn) hash_stripes_ptr = hash_stripes_resolve;
+#define hash_stripes _cpu_load_ptr(hash_stripes_ptr)
+
+static void hash_stripes_resolve(u64 *acc, const u8 *p, size_t n, const u8 *k, const u8 *s) {
+	hash_stripes_fn fn = hash_stripes_scalar;
+	if (cpu_has(CPU_AVX512F))
+		fn = hash_stripes_avx512;
+	else if (cpu_has(CPU_AVX2))
+		fn = hash_stripes_avx2;
+	else if (cpu_has(CPU_SSE2))
+		fn = hash_stripes_sse2;
+	_cpu_store_ptr(hash_stripes_ptr, fn);
+	fn(acc, p, n, k, s);
+}
+#elif defined(_hash_neon)
+static void hash_stripes_neon(u64 *acc, const u8 *p, size_t n, const u8 *k, const u8 *s) {
+	uint64x2_t a[4];
+	size_t i, j;
+	for (i = 0; i < 4; ++i)
+		a[i] = vld1q_u64(acc + i * 2);
+	for (j = 0; j < n; ++j, p += HASH_STRIPE, k += 8)
+		for (i = 0; i < 4; ++i) {
+			uint64x2_t v = vreinterpretq_u64_u8(vld1q_u8(p + i * 16));
+			uint64x2_t x = veorq_u64(v, vreinterpretq_u64_u8(vld1q_u8(k + i * 16)));
+			a[i] = vmlal_u32(vaddq_u64(a[i], vextq_u64(v, v, 1)), vmovn_u64(x), vshrn_n_u64(x, 32));
+		}
+	if (s != NULL) {
+		const uint32x2_t prime = vdup_n_u32(HASH_P32_1);
+		for (i = 0; i < 4; ++i) {
+			uint64x2_t x = veorq_u64(veorq_u64(a[i], vshrq_n_u64(a[i], 47)), vreinterpretq_u64_u8(vld1q_u8(s + i * 16)));
+			a[i] = vmlal_u32(vshlq_n_u64(vmull_u32(vshrn_n_u64(x, 32), prime), 32), vmovn_u64(x), prime);
+		}
+	}
+	for (i = 0; i < 4; ++i)
+		vst1q_u64(acc + i * 2, a[i]);
+}
+
+# define hash_stripes hash_stripes_neon
+#else
+# define hash_stripes hash_stripes_scalar
+#endif
+
+/* Accumulates n stripes, of which done were already taken in the current
+   block, and returns the end of the input used. */
+static const u8 *hash_consume(u64 *acc, u32 *done, const u8 *p, size_t n, const u8 *k) {
+	while (n != 0) {
+		size_t m = HASH_BLOCK - *done;
+		if (n < m) {
+			hash_stripes(acc, p, n, k + *done * 8, NULL);
+			*done += (u32) n;
+			return p + n * HASH_STRIPE;
+		}
+		hash_stripes(acc, p, m, k + *done * 8, k + sizeof HASH_SECRET - HASH_STRIPE);
+		*done = 0;
+		p += m * HASH_STRIPE;
+		n -= m;
+	}
+	return p;
+}
+
+_hash_alwaysinline static u64 hash_merge(const u64 *acc, const u8 *k, u64 h) {
+	u32 i;
+	for (i = 0; i < 4; ++i)
+		h += hash_mulfold(acc[i * 2] ^ _load_le64(k + i * 16), acc[i * 2 + 1] ^ _load_le64(k + i * 16 + 8));
+	return hash_avalanche(h);
+}
+
+/* A nonzero seed is folded into a copy of the secret for long inputs. */
+static void hash_secret(u8 *k, u64 seed) {
+	u32 i;
+	for (i = 0; i < sizeof HASH_SECRET; i += 16) {
+		_store_le64(k + i, _load_le64(HASH_SECRET + i) + seed);
+		_store_le64(k + i + 8, _load_le64(HASH_SECRET + i + 8) - seed);
+	}
+}
+
+static const u8 *hash_long(u64 *acc, const u8 *p, size_t n, u64 seed, u8 *tmp) {
+	const u8 *k = HASH_SECRET;
+	u32 done = 0;
+	if (seed != 0) {
+		hash_secret(tmp, seed);
+		k = tmp;
+	}
+	memcpy(acc, HASH_ACC, sizeof HASH_ACC);
+	hash_consume(acc, &done, p, (n - 1) / HASH_STRIPE, k);
+	hash_stripes(acc, p + n - HASH_STRIPE, 1, k + HASH_LASTACC, NULL);
+	return k;
+}
+
+u64 hash64(const void *ptr, size_t size, u64 seed) {
+	u64 acc[8];
+	u8 tmp[sizeof HASH_SECRET];
+	const u8 *k;
+	if (size <= HASH_MIDSIZE)
+		return hash64_small((const u8 *) ptr, size, seed);
+	k = hash_long(acc, (const u8 *) ptr, size, seed, tmp);
+	return hash_merge(acc, k + HASH_MERGE, size * HASH_P64_1);
+}
+
+struct hash128 hash128(const void *ptr, size_t size, u64 seed) {
+	struct hash128 h;
+	u64 acc[8];
+	u8 tmp[sizeof HASH_SECRET];
+	const u8 *k;
+	if (size <= HASH_MIDSIZE)
+		return hash128_small((const u8 *) ptr, size, seed);
+	k = hash_long(acc, (const u8 *) ptr, size, seed, tmp);
+	h.lo = hash_merge(acc, k + HASH_MERGE, size * HASH_P64_1);
+	h.hi = hash_merge(acc, k + sizeof HASH_SECRET - sizeof acc - HASH_MERGE, ~(size * HASH_P64_2));
+	return h;
+}
+
+static void hash_fold(u8 *dst, const u8 *src, size_t n) {
+	size_t i;
+	for (i = 0; i < n; ++i)
+		dst[i] = (u8) (src[i] + ((u8) (src[i] - 'A') < 26 ? 0x20 : 0));
+}
+
+u64 hash64_case(const void *ptr, size_t size, u64 seed) {
+	struct hash_state s;
+	u8 tmp[HASH_MIDSIZE];
+	if (size <= HASH_MIDSIZE) {
+		hash_fold(tmp, (const u8 *) ptr, size);
+		return hash64_small(tmp, size, seed);
+	}
+	hash_init(&s, seed);
+	hash_update_case(&s, ptr, size);
+	return hash_final64(&s);
+}
+
+struct hash128 hash128_case(const void *ptr, size_t size, u64 seed) {
+	struct hash_state s;
+	u8 tmp[HASH_MIDSIZE];
+	if (size <= HASH_MIDSIZE) {
+		hash_fold(tmp, (const u8 *) ptr, size);
+		return hash128_small(tmp, size, seed);
+	}
+	hash_init(&s, seed);
+	hash_update_case(&s, ptr, size);
+	return hash_final128(&s);
+}
+
+void hash_init(struct hash_state *s, u64 seed) {
+	memcpy(s->acc, HASH_ACC, sizeof HASH_ACC);
+	hash_secret(s->secret, seed);
+	s->seed = seed;
+	s->total = 0;
+	s->used = 0;
+	s->stripes = 0;
+}
+
+/* The buffer is only drained once more input follows it, so that the last
+   stripe is always at hand for the final functions. After a long update
+   the buffer tail keeps the stripe before the new contents. */
+void hash_update(struct hash_state *s, const void *ptr, size_t size) {
+	const u8 *p = (const u8 *) ptr, *end = p + size;
+	if (size == 0)
+		return;
+	s->total += size;
+	if (size <= sizeof s->buf - s->used) {
+		memcpy(s->buf + s->used, p, size);
+		s->used += (u32) size;
+		return;
+	}
+	if (s->used != 0) {
+		size_t fill = sizeof s->buf - s->used;
+		memcpy(s->buf + s->used, p, fill);
+		p += fill;
+		hash_consume(s->acc, &s->stripes, s->buf, sizeof s->buf / HASH_STRIPE, s->secret);
+	}
+	if ((size_t) (end - p) > sizeof s->buf) {
+		p = hash_consume(s->acc, &s->stripes, p, (size_t) (end - p - 1) / HASH_STRIPE, s->secret);
+		memcpy(s->buf + sizeof s->buf - HASH_STRIPE, p - HASH_STRIPE, HASH_STRIPE);
+	}
+	memcpy(s->buf, p, (size_t) (end - p));
+	s->used = (u32) (end - p);
+}
+
+void hash_update_case(struct hash_state *s, const void *ptr, size_t size) {
+	const u8 *p = (const u8 *) ptr;
+	u8 tmp[sizeof s->buf];
+	while (size != 0) {
+		size_t n = size < sizeof tmp ? size : sizeof tmp;
+		hash_fold(tmp, p, n);
+		hash_update(s, tmp, n);
+		p += n;
+		size -= n;
+	}
+}
+
+static void hash_final(const struct hash_state *s, u64 *acc) {
+	u8 last[HASH_STRIPE];
+	const u8 *p = last;
+	u32 done = s->stripes;
+	memcpy(acc, s->acc, sizeof s->acc);
+	if (s->used >= HASH_STRIPE) {
+		hash_consume(acc, &done, s->buf, (s->used - 1) / HASH_STRIPE, s->secret);
+		p = s->buf + s->used - HASH_STRIPE;
+	} else {
+		size_t n = HASH_STRIPE - s->used;
+		memcpy(last, s->buf + sizeof s->buf - n, n);
+		memcpy(last + n, s->buf, s->used);
+	}
+	hash_stripes(acc, p, 1, s->secret + HASH_LASTACC, NULL);
+}
+
+u64 hash_final64(const struct hash_state *s) {
+	u64 acc[8];
+	if (s->total <= HASH_MIDSIZE)
+		return hash64_small(s->buf, (size_t) s->total, s->seed);
+	hash_final(s, acc);
+	return hash_merge(acc, s->secret + HASH_MERGE, s->total * HASH_P64_1);
+}
+
+struct hash128 hash_final128(const struct hash_state *s) {
+	struct hash128 h;
+	u64 acc[8];
+	if (s->total <= HASH_MIDSIZE)
+		return hash128_small(s->buf, (size_t) s->total, s->seed);
+	hash_final(s, acc);
+	h.lo = hash_merge(acc, s->secret + HASH_MERGE, s->total * HASH_P64_1);
+	h.hi = hash_merge(acc, s->secret + sizeof s->secret - sizeof acc - HASH_MERGE, ~(s->total * HASH_P64_2));
+	return h;
+}
@@ -0,0 +1,90 @@
+
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+#ifndef AW_HASH_H
+#define AW_HASH_H
+
+#include "aw-types.h"
+
+#include <stddef.h>
+
+#if defined(_hash_dllexport)
+# if defined(_MSC_VER)
+#  define _hash_api extern __declspec(dllexport)
+# elif defined(__GNUC__)
+#  define _hash_api __attribute__((visibility("default"))) extern
+# endif
+#elif defined(_hash_dllimport)
+# if defined(_MSC_VER)
+#  define _hash_api extern __declspec(dllimport)
+# endif
+#endif
+#ifndef _hash_api
+# define _hash_api extern
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Non-cryptographic hashes of byte ranges, bit for bit XXH3 (64-bit) and
+   XXH128 with a seed, so values match other XXH3 implementations. Input is
+   read with little-endian loads, so the results are the same on every
+   target. Inputs up to 240 bytes take a few multiplies; longer inputs are
+   accumulated in 64-byte stripes with SSE2, AVX2 or NEON.
+
+   The case variants hash the bytes with ASCII letters folded to lower case,
+   so that strings equal under _strcasecmp hash alike. */
+struct hash128 {
+	u64 lo;
+	u64 hi;
+};
+
+_hash_api u64 hash64(const void *ptr, size_t size, u64 seed);
+_hash_api u64 hash64_case(const void *ptr, size_t size, u64 seed);
+_hash_api struct hash128 hash128(const void *ptr, size_t size, u64 seed);
+_hash_api struct hash128 hash128_case(const void *ptr, size_t size, u64 seed);
+
+/* Streaming gives the same values as hashing all the updates at once. The
+   final functions leave the state alone, so more data may follow. */
+struct hash_state {
+	u64 acc[8];
+	u8 secret[192];
+	u8 buf[256];
+	u64 seed;
+	u64 total;
+	u32 used;
+	u32 stripes;
+};
+
+_hash_api void hash_init(struct hash_state *s, u64 seed);
+_hash_api void hash_update(struct hash_state *s, const void *ptr, size_t size);
+_hash_api void hash_update_case(struct hash_state *s, const void *ptr, size_t size);
+_hash_api u64 hash_final64(const struct hash_state *s);
+_hash_api struct hash128 hash_final128(const struct hash_state *s);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* AW_HASH_H */
@@ -0,0 +1,1064 @@
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+
+#include "aw-parse.h"
+#include "aw-arith.h"
+#include "aw-endian.h"
+#include "aw-format.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__GNUC__)
+# define _parse_alwaysinline __attribute__((always_inline)) inline
+#elif defined(_MSC_VER)
+# define _parse_alwaysinline __forceinline
+#endif
+
+_parse_alwaysinline static u32 parse_digit(char c) { return (u32) (u8) (c - '0'); }
+
+_parse_alwaysinline static u32 parse_finish(size_t *used, const char *src, const char *p, u32 err) {
+	if (used != NULL)
+		*used = (size_t) (p - src);
+	return err;
+}
+
+/* All eight bytes are ASCII digits: each high nibble is 3, and adding 6 to
+   the low nibble does not carry into it. */
+_parse_alwaysinline static bool parse_is8(u64 v) {
+	const u64 hi = imm_u64(0xf0f0f0f0f0f0f0f0);
+	return ((v & hi) | (((v + imm_u64(0x0606060606060606)) & hi) >> 4)) == imm_u64(0x3333333333333333);
+}
+
+/* Converts eight digits loaded little-endian by combining neighbours into
+   pairs, then fours, then the whole number with three multiplies. */
+_parse_alwaysinline static u32 parse_8(u64 v) {
+	v = (v & imm_u64(0x0f0f0f0f0f0f0f0f)) * 2561 >> 8;
+	v = (v & imm_u64(0x00ff00ff00ff00ff)) * 6553601 >> 16;
+	return (u32) ((v & imm_u64(0x0000ffff0000ffff)) * imm_u64(42949672960001) >> 32);
+}
+
+/* Up to 19 significant digits always fit in 64 bits, the 20th is checked
+   and any more overflow. */
+static const char *parse_dec(const char *p, const char *end, u64 *v, bool *ovf) {
+	const char *s;
+	u64 x = 0;
+	while (p < end && *p == '0')
+		++p;
+	s = p;
+	for (; end - p >= 8 && p - s <= 11; p += 8) {
+		u64 w = _load_le64(p);
+		if (!parse_is8(w))
+			break;
+		x = x * 100000000 + parse_8(w);
+	}
+	for (; p < end && parse_digit(*p) < 10; ++p) {
+		u32 d = parse_digit(*p);
+		if (p - s < 19 || (p - s == 19 && x <= (~imm_u64(0) - d) / 10))
+			x = x * 10 + d;
+		else
+			*ovf = true;
+	}
+	*v = x;
+	return p;
+}
+
+_parse_alwaysinline static u32 parse_xdigit(char c) {
+	u32 d = parse_digit(c);
+	return d < 10 ? d : (u32) (u8) ((c | 0x20) - 'a') < 6 ? (u32) ((c | 0x20) - 'a' + 10) : 16;
+}
+
+static const char *parse_hex(const char *p, const char *end, u64 *v, bool *ovf) {
+	const char *s;
+	u64 x = 0;
+	u32 d;
+	while (p < end && *p == '0')
+		++p;
+	s = p;
+	for (; p < end && (d = parse_xdigit(*p)) < 16; ++p) {
+		if (p - s < 16)
+			x = x << 4 | d;
+		else
+			*ovf = true;
+	}
+	*v = x;
+	return p;
+}
+
+/* Reads an unsigned magnitude after an optional sign; a '-' is only taken
+   when neg is not NULL. Returns NULL when there are no digits. */
+static const char *parse_int(const char *p, const char *end, u64 *v, bool *neg, bool *ovf, bool hex) {
+	const char *d;
+	if (p < end && (*p == '+' || (*p == '-' && neg != NULL))) {
+		if (neg != NULL)
+			*neg = *p == '-';
+		++p;
+	}
+	if (hex && end - p >= 3 && p[0] == '0' && (p[1] | 0x20) == 'x' && parse_xdigit(p[2]) < 16)
+		p += 2;
+	d = p;
+	p = hex ? parse_hex(p, end, v, ovf) : parse_dec(p, end, v, ovf);
+	return p != d ? p : NULL;
+}
+
+static u32 parse_unsigned(u64 *v, size_t *used, const char *src, size_t size, u64 max, bool hex) {
+	bool ovf = false;
+	const char *p = parse_int(src, src + size, v, NULL, &ovf, hex);
+	if (p == NULL) {
+		*v = 0;
+		return parse_finish(used, src, src, PARSE_INVALID);
+	}
+	if (ovf || *v > max) {
+		*v = max;
+		return parse_finish(used, src, p, PARSE_OVERFLOW);
+	}
+	return parse_finish(used, src, p, PARSE_OK);
+}
+
+static u32 parse_signed(s64 *v, size_t *used, const char *src, size_t size, s64 max) {
+	bool neg = false, ovf = false;
+	u64 m;
+	const char *p = parse_int(src, src + size, &m, &neg, &ovf, false);
+	if (p == NULL) {
+		*v = 0;
+		return parse_finish(used, src, src, PARSE_INVALID);
+	}
+	if (ovf || m > (u64) max + neg) {
+		*v = neg ? -max - 1 : max;
+		return parse_finish(used, src, p, PARSE_OVERFLOW);
+	}
+	*v = neg && m != 0 ? -(s64) (m - 1) - 1 : (s64) m;
+	return parse_finish(used, src, p, PARSE_OK);
+}
+
+u32 parse_u64(u64 *v, size_t *used, const char *src, size_t size) {
+	return parse_unsigned(v, used, src, size, ~imm_u64(0), false);
+}
+
+u32 parse_x64(u64 *v, size_t *used, const char *src, size_t size) {
+	return parse_unsigned(v, used, src, size, ~imm_u64(0), true);
+}
+
+u32 parse_u32(u32 *v, size_t *used, const char *src, size_t size) {
+	u64 t;
+	u32 err = parse_unsigned(&t, used, src, size, 0xffffffffu, false);
+	*v = (u32) t;
+	return err;
+}
+
+u32 parse_x32(u32 *v, size_t *used, const char *src, size_t size) {
+	u64 t;
+	u32 err = parse_unsigned(&t, used, src, size, 0xffffffffu, true);
+	*v = (u32) t;
+	return err;
+}
+
+u32 parse_s64(s64 *v, size_t *used, const char *src, size_t size) {
+	return parse_signed(v, used, src, size, imm_s64(0x7fffffffffffffff));
+}
+
+u32 parse_s32(s32 *v, size_t *used, const char *src, size_t size) {
+	s64 t;
+	u32 err = parse_signed(&t, used, src, size, 0x7fffffff);
+	*v = (s32) t;
+	return err;
+}
+
+/* Eisel-Lemire: w * 10^q is rounded with a 128-bit truncated approximation
+   of 5^q, which is exact enough for every w of up to 19 digits (Mushtak and
+   Lemire 2023). The table holds the normalized 5^q for q in [-342, 308]. */
+static const u64 PARSE_POW5_128[651][2] = {
+	{ imm_u64(0xeef453d6923bd65a), imm_u64(0x113faa2906a13b3f) },
+	{ imm_u64(0x9558b4661b6565f8), imm_u64(0x4ac7ca59a424c507) },
+	{ imm_u64(0xbaaee17fa23ebf76), imm_u64(0x5d79bcf00d2df649) },
+	{ imm_u64(0xe95a99df8ace6f53), imm_u64(0xf4d82c2c107973dc) },
+	{ imm_u64(0x91d8a02bb6c10594), imm_u64(0x79071b9b8a4be869) },
+	{ imm_u64(0xb64ec836a47146f9), imm_u64(0x9748e2826cdee284) },
+	{ imm_u64(0xe3e27a444d8d98b7), imm_u64(0xfd1b1b2308169b25) },
+	{ imm_u64(0x8e6d8c6ab0787f72), imm_u64(0xfe30f0f5e50e20f7) },
+	{ imm_u64(0xb208ef855c969f4f), imm_u64(0xbdbd2d335e51a935) },
+	{ imm_u64(0xde8b2b66b3bc4723), imm_u64(0xad2c788035e61382) },
+	{ imm_u64(0x8b16fb203055ac76), imm_u64(0x4c3bcb5021afcc31) },
+	{ imm_u64(0xaddcb9e83c6b1793), imm_u64(0xdf4abe242a1bbf3d) },
+	{ imm_u64(0xd953e8624b85dd78), imm_u64(0xd71d6dad34a2af0d) },
+	{ imm_u64(0x87d4713d6f33aa6b), imm_u64(0x8672648c40e5ad68) },
+	{ imm_u64(0xa9c98d8ccb009506), imm_u64(0x680efdaf511f18c2) },
+	{ imm_u64(0xd43bf0effdc0ba48), imm_u64(0x0212bd1b2566def2) },
+	{ imm_u64(0x84a57695fe98746d), imm_u64(0x014bb630f7604b57) },
+	{ imm_u64(0xa5ced43b7e3e9188), imm_u64(0x419ea3bd35385e2d) },
+	{ imm_u64(0xcf42894a5dce35ea), imm_u64(0x52064cac828675b9) },
+	{ imm_u64(0x818995ce7aa0e1b2), imm_u64(0x7343efebd1940993) },
+	{ imm_u64(0xa1ebfb4219491a1f), imm_u64(0x1014ebe6c5f90bf8) },
+	{ imm_u64(0xca66fa129f9b60a6), imm_u64(0xd41a26e077774ef6) },
+	{ imm_u64(0xfd00b897478238d0), imm_u64(0x8920b098955522b4) },
+	{ imm_u64(0x9e20735e8cb16382), imm_u64(0x55b46e5f5d5535b0) },
+	{ imm_u64(0xc5a890362fddbc62), imm_u64(0xeb2189f734aa831d) },
+	{ imm_u64(0xf712b443bbd52b7b), imm_u64(0xa5e9ec7501d523e4) },
+	{ imm_u64(0x9a6bb0aa55653b2d), imm_u64(0x47b233c92125366e) },
+	{ imm_u64(0xc1069cd4eabe89f8), imm_u64(0x999ec0bb696e840a) },
+	{ imm_u64(0xf148440a256e2c76), imm_u64(0xc00670ea43ca250d) },
+	{ imm_u64(0x96cd2a865764dbca), imm_u64(0x380406926a5e5728) },
+	{ imm_u64(0xbc807527ed3e12bc), imm_u64(0xc605083704f5ecf2) },
+	{ imm_u64(0xeba09271e88d976b), imm_u64(0xf7864a44c633682e) },
+	{ imm_u64(0x93445b8731587ea3), imm_u64(0x7ab3ee6afbe0211d) },
+	{ imm_u64(0xb8157268fdae9e4c), imm_u64(0x5960ea05bad82964) },
+	{ imm_u64(0xe61acf033d1a45df), imm_u64(0x6fb92487298e33bd) },
+	{ imm_u64(0x8fd0c16206306bab), imm_u64(0xa5d3b6d479f8e056) },
+	{ imm_u64(0xb3c4f1ba87bc8696), imm_u64(0x8f48a4899877186c) },
+	{ imm_u64(0xe0b62e2929aba83c), imm_u64(0x331acdabfe94de87) },
+	{ imm_u64(0x8c71dcd9ba0b4925), imm_u64(0x9ff0c08b7f1d0b14) },
+	{ imm_u64(0xaf8e5410288e1b6f), imm_u64(0x07ecf0ae5ee44dd9) },
+	{ imm_u64(0xdb71e91432b1a24a), imm_u64(0xc9e82cd9f69d6150) },
+	{ imm_u64(0x892731ac9faf056e), imm_u64(0xbe311c083a225cd2) },
+	{ imm_u64(0xab70fe17c79ac6ca), imm_u64(0x6dbd630a48aaf406) },
+	{ imm_u64(0xd64d3d9db981787d), imm_u64(0x092cbbccdad5b108) },
+	{ imm_u64(0x85f0468293f0eb4e), imm_u64(0x25bbf56008c58ea5) },
+	{ imm_u64(0xa76c582338ed2621), imm_u64(0xaf2af2b80af6f24e) },
+	{ imm_u64(0xd1476e2c07286faa), imm_u64(0x1af5af660db4aee1) },
+	{ imm_u64(0x82cca4db847945ca), imm_u64(0x50d98d9fc890ed4d) },
+	{ imm_u64(0xa37fce126597973c), imm_u64(0xe50ff107bab528a0) },
+	{ imm_u64(0xcc5fc196fefd7d0c), imm_u64(0x1e53ed49a96272c8) },
+	{ imm_u64(0xff77b1fcbebcdc4f), imm_u64(0x25e8e89c13bb0f7a) },
+	{ imm_u64(0x9faacf3df73609b1), imm_u64(0x77b191618c54e9ac) },
+	{ imm_u64(0xc795830d75038c1d), imm_u64(0xd59df5b9ef6a2417) },
+	{ imm_u64(0xf97ae3d0d2446f25), imm_u64(0x4b0573286b44ad1d) },
+	{ imm_u64(0x9becce62836ac577), imm_u64(0x4ee367f9430aec32) },
+	{ imm_u64(0xc2e801fb244576d5), imm_u64(0x229c41f793cda73f) },
+	{ imm_u64(0xf3a20279ed56d48a), imm_u64(0x6b43527578c1110f) },
+	{ imm_u64(0x9845418c345644d6), imm_u64(0x830a13896b78aaa9) },
+	{ imm_u64(0xbe5691ef416bd60c), imm_u64(0x23cc986bc656d553) },
+	{ imm_u64(0xedec366b11c6cb8f), imm_u64(0x2cbfbe86b7ec8aa8) },
+	{ imm_u64(0x94b3a202eb1c3f39), imm_u64(0x7bf7d71432f3d6a9) },
+	{ imm_u64(0xb9e08a83a5e34f07), imm_u64(0xdaf5ccd93fb0cc53) },
+	{ imm_u64(0xe858ad248f5c22c9), imm_u64(0xd1b3400f8f9cff68) },
+	{ imm_u64(0x91376c36d99995be), imm_u64(0x23100809b9c21fa1) },
+	{ imm_u64(0xb58547448ffffb2d), imm_u64(0xabd40a0c2832a78a) },
+	{ imm_u64(0xe2e69915b3fff9f9), imm_u64(0x16c90c8f323f516c) },
+	{ imm_u64(0x8dd01fad907ffc3b), imm_u64(0xae3da7d97f6792e3) },
+	{ imm_u64(0xb1442798f49ffb4a), imm_u64(0x99cd11cfdf41779c) },
+	{ imm_u64(0xdd95317f31c7fa1d), imm_u64(0x40405643d711d583) },
+	{ imm_u64(0x8a7d3eef7f1cfc52), imm_u64(0x482835ea666b2572) },
+	{ imm_u64(0xad1c8eab5ee43b66), imm_u64(0xda3243650005eecf) },
+	{ imm_u64(0xd863b256369d4a40), imm_u64(0x90bed43e40076a82) },
+	{ imm_u64(0x873e4f75e2224e68), imm_u64(0x5a7744a6e804a291) },
+	{ imm_u64(0xa90de3535aaae202), imm_u64(0x711515d0a205cb36) },
+	{ imm_u64(0xd3515c2831559a83), imm_u64(0x0d5a5b44ca873e03) },
+	{ imm_u64(0x8412d9991ed58091), imm_u64(0xe858790afe9486c2) },
+	{ imm_u64(0xa5178fff668ae0b6), imm_u64(0x626e974dbe39a872) },
+	{ imm_u64(0xce5d73ff402d98e3), imm_u64(0xfb0a3d212dc8128f) },
+	{ imm_u64(0x80fa687f881c7f8e), imm_u64(0x7ce66634bc9d0b99) },
+	{ imm_u64(0xa139029f6a239f72), imm_u64(0x1c1fffc1ebc44e80) },
+	{ imm_u64(0xc987434744ac874e), imm_u64(0xa327ffb266b56220) },
+	{ imm_u64(0xfbe9141915d7a922), imm_u64(0x4bf1ff9f0062baa8) },
+	{ imm_u64(0x9d71ac8fada6c9b5), imm_u64(0x6f773fc3603db4a9) },
+	{ imm_u64(0xc4ce17b399107c22), imm_u64(0xcb550fb4384d21d3) },
+	{ imm_u64(0xf6019da07f549b2b), imm_u64(0x7e2a53a146606a48) },
+	{ imm_u64(0x99c102844f94e0fb), imm_u64(0x2eda7444cbfc426d) },
+	{ imm_u64(0xc0314325637a1939), imm_u64(0xfa911155fefb5308) },
+	{ imm_u64(0xf03d93eebc589f88), imm_u64(0x793555ab7eba27ca) },
+	{ imm_u64(0x96267c7535b763b5), imm_u64(0x4bc1558b2f3458de) },
+	{ imm_u64(0xbbb01b9283253ca2), imm_u64(0x9eb1aaedfb016f16) },
+	{ imm_u64(0xea9c227723ee8bcb), imm_u64(0x465e15a979c1cadc) },
+	{ imm_u64(0x92a1958a7675175f), imm_u64(0x0bfacd89ec191ec9) },
+	{ imm_u64(0xb749faed14125d36), imm_u64(0xcef980ec671f667b) },
+	{ imm_u64(0xe51c79a85916f484), imm_u64(0x82b7e12780e7401a) },
+	{ imm_u64(0x8f31cc0937ae58d2), imm_u64(0xd1b2ecb8b0908810) },
+	{ imm_u64(0xb2fe3f0b8599ef07), imm_u64(0x861fa7e6dcb4aa15) },
+	{ imm_u64(0xdfbdcece67006ac9), imm_u64(0x67a791e093e1d49a) },
+	{ imm_u64(0x8bd6a141006042bd), imm_u64(0xe0c8bb2c5c6d24e0) },
+	{ imm_u64(0xaecc49914078536d), imm_u64(0x58fae9f773886e18) },
+	{ imm_u64(0xda7f5bf590966848), imm_u64(0xaf39a475506a899e) },
+	{ imm_u64(0x888f99797a5e012d), imm_u64(0x6d8406c952429603) },
+	{ imm_u64(0xaab37fd7d8f58178), imm_u64(0xc8e5087ba6d33b83) },
+	{ imm_u64(0xd5605fcdcf32e1d6), imm_u64(0xfb1e4a9a90880a64) },
+	{ imm_u64(0x855c3be0a17fcd26), imm_u64(0x5cf2eea09a55067f) },
+	{ imm_u64(0xa6b34ad8c9dfc06f), imm_u64(0xf42faa48c0ea481e) },
+	{ imm_u64(0xd0601d8efc57b08b), imm_u64(0xf13b94daf124da26) },
+	{ imm_u64(0x823c12795db6ce57), imm_u64(0x76c53d08d6b70858) },
+	{ imm_u64(0xa2cb1717b52481ed), imm_u64(0x54768c4b0c64ca6e) },
+	{ imm_u64(0xcb7ddcdda26da268), imm_u64(0xa9942f5dcf7dfd09) },
+	{ imm_u64(0xfe5d54150b090b02), imm_u64(0xd3f93b35435d7c4c) },
+	{ imm_u64(0x9efa548d26e5a6e1), imm_u64(0xc47bc5014a1a6daf) },
+	{ imm_u64(0xc6b8e9b0709f109a), imm_u64(0x359ab6419ca1091b) },
+	{ imm_u64(0xf867241c8cc6d4c0), imm_u64(0xc30163d203c94b62) },
+	{ imm_u64(0x9b407691d7fc44f8), imm_u64(0x79e0de63425dcf1d) },
+	{ imm_u64(0xc21094364dfb5636), imm_u64(0x985915fc12f542e4) },
+	{ imm_u64(0xf294b943e17a2bc4), imm_u64(0x3e6f5b7b17b2939d) },
+	{ imm_u64(0x979cf3ca6cec5b5a), imm_u64(0xa705992ceecf9c42) },
+	{ imm_u64(0xbd8430bd08277231), imm_u64(0x50c6ff782a838353) },
+	{ imm_u64(0xece53cec4a314ebd), imm_u64(0xa4f8bf5635246428) },
+	{ imm_u64(0x940f4613ae5ed136), imm_u64(0x871b7795e136be99) },
+	{ imm_u64(0xb913179899f68584), imm_u64(0x28e2557b59846e3f) },
+	{ imm_u64(0xe757dd7ec07426e5), imm_u64(0x331aeada2fe589cf) },
+	{ imm_u64(0x9096ea6f3848984f), imm_u64(0x3ff0d2c85def7621) },
+	{ imm_u64(0xb4bca50b065abe63), imm_u64(0x0fed077a756b53a9) },
+	{ imm_u64(0xe1ebce4dc7f16dfb), imm_u64(0xd3e8495912c62894) },
+	{ imm_u64(0x8d3360f09cf6e4bd), imm_u64(0x64712dd7abbbd95c) },
+	{ imm_u64(0xb080392cc4349dec), imm_u64(0xbd8d794d96aacfb3) },
+	{ imm_u64(0xdca04777f541c567), imm_u64(0xecf0d7a0fc5583a0) },
+	{ imm_u64(0x89e42caaf9491b60), imm_u64(0xf41686c49db57244) },
+	{ imm_u64(0xac5d37d5b79b6239), imm_u64(0x311c2875c522ced5) },
+	{ imm_u64(0xd77485cb25823ac7), imm_u64(0x7d633293366b828b) },
+	{ imm_u64(0x86a8d39ef77164bc), imm_u64(0xae5dff9c02033197) },
+	{ imm_u64(0xa8530886b54dbdeb), imm_u64(0xd9f57f830283fdfc) },
+	{ imm_u64(0xd267caa862a12d66), imm_u64(0xd072df63c324fd7b) },
+	{ imm_u64(0x8380dea93da4bc60), imm_u64(0x4247cb9e59f71e6d) },
+	{ imm_u64(0xa46116538d0deb78), imm_u64(0x52d9be85f074e608) },
+	{ imm_u64(0xcd795be870516656), imm_u64(0x67902e276c921f8b) },
+	{ imm_u64(0x806bd9714632dff6), imm_u64(0x00ba1cd8a3db53b6) },
+	{ imm_u64(0xa086cfcd97bf97f3), imm_u64(0x80e8a40eccd228a4) },
+	{ imm_u64(0xc8a883c0fdaf7df0), imm_u64(0x6122cd128006b2cd) },
+	{ imm_u64(0xfad2a4b13d1b5d6c), imm_u64(0x796b805720085f81) },
+	{ imm_u64(0x9cc3a6eec6311a63), imm_u64(0xcbe3303674053bb0) },
+	{ imm_u64(0xc3f490aa77bd60fc), imm_u64(0xbedbfc4411068a9c) },
+	{ imm_u64(0xf4f1b4d515acb93b), imm_u64(0xee92fb5515482d44) },
+	{ imm_u64(0x991711052d8bf3c5), imm_u64(0x751bdd152d4d1c4a) },
+	{ imm_u64(0xbf5cd54678eef0b6), imm_u64(0xd262d45a78a0635d) },
+	{ imm_u64(0xef340a98172aace4), imm_u64(0x86fb897116c87c34) },
+	{ imm_u64(0x9580869f0e7aac0e), imm_u64(0xd45d35e6ae3d4da0) },
+	{ imm_u64(0xbae0a846d2195712), imm_u64(0x8974836059cca109) },
+	{ imm_u64(0xe998d258869facd7), imm_u64(0x2bd1a438703fc94b) },
+	{ imm_u64(0x91ff83775423cc06), imm_u64(0x7b6306a34627ddcf) },
+	{ imm_u64(0xb67f6455292cbf08), imm_u64(0x1a3bc84c17b1d542) },
+	{ imm_u64(0xe41f3d6a7377eeca), imm_u64(0x20caba5f1d9e4a93) },
+	{ imm_u64(0x8e938662882af53e), imm_u64(0x547eb47b7282ee9c) },
+	{ imm_u64(0xb23867fb2a35b28d), imm_u64(0xe99e619a4f23aa43) },
+	{ imm_u64(0xdec681f9f4c31f31), imm_u64(0x6405fa00e2ec94d4) },
+	{ imm_u64(0x8b3c113c38f9f37e), imm_u64(0xde83bc408dd3dd04) },
+	{ imm_u64(0xae0b158b4738705e), imm_u64(0x9624ab50b148d445) },
+	{ imm_u64(0xd98ddaee19068c76), imm_u64(0x3badd624dd9b0957) },
+	{ imm_u64(0x87f8a8d4cfa417c9), imm_u64(0xe54ca5d70a80e5d6) },
+	{ imm_u64(0xa9f6d30a038d1dbc), imm_u64(0x5e9fcf4ccd211f4c) },
+	{ imm_u64(0xd47487cc8470652b), imm_u64(0x7647c3200069671f) },
+	{ imm_u64(0x84c8d4dfd2c63f3b), imm_u64(0x29ecd9f40041e073) },
+	{ imm_u64(0xa5fb0a17c777cf09), imm_u64(0xf468107100525890) },
+	{ imm_u64(0xcf79cc9db955c2cc), imm_u64(0x7182148d4066eeb4) },
+	{ imm_u64(0x81ac1fe293d599bf), imm_u64(0xc6f14cd848405530) },
+	{ imm_u64(0xa21727db38cb002f), imm_u64(0xb8ada00e5a506a7c) },
+	{ imm_u64(0xca9cf1d206fdc03b), imm_u64(0xa6d90811f0e4851c) },
+	{ imm_u64(0xfd442e4688bd304a), imm_u64(0x908f4a166d1da663) },
+	{ imm_u64(0x9e4a9cec15763e2e), imm_u64(0x9a598e4e043287fe) },
+	{ imm_u64(0xc5dd44271ad3cdba), imm_u64(0x40eff1e1853f29fd) },
+	{ imm_u64(0xf7549530e188c128), imm_u64(0xd12bee59e68ef47c) },
+	{ imm_u64(0x9a94dd3e8cf578b9), imm_u64(0x82bb74f8301958ce) },
+	{ imm_u64(0xc13a148e3032d6e7), imm_u64(0xe36a52363c1faf01) },
+	{ imm_u64(0xf18899b1bc3f8ca1), imm_u64(0xdc44e6c3cb279ac1) },
+	{ imm_u64(0x96f5600f15a7b7e5), imm_u64(0x29ab103a5ef8c0b9) },
+	{ imm_u64(0xbcb2b812db11a5de), imm_u64(0x7415d448f6b6f0e7) },
+	{ imm_u64(0xebdf661791d60f56), imm_u64(0x111b495b3464ad21) },
+	{ imm_u64(0x936b9fcebb25c995), imm_u64(0xcab10dd900beec34) },
+	{ imm_u64(0xb84687c269ef3bfb), imm_u64(0x3d5d514f40eea742) },
+	{ imm_u64(0xe65829b3046b0afa), imm_u64(0x0cb4a5a3112a5112) },
+	{ imm_u64(0x8ff71a0fe2c2e6dc), imm_u64(0x47f0e785eaba72ab) },
+	{ imm_u64(0xb3f4e093db73a093), imm_u64(0x59ed216765690f56) },
+	{ imm_u64(0xe0f218b8d25088b8), imm_u64(0x306869c13ec3532c) },
+	{ imm_u64(0x8c974f7383725573), imm_u64(0x1e414218c73a13fb) },
+	{ imm_u64(0xafbd2350644eeacf), imm_u64(0xe5d1929ef90898fa) },
+	{ imm_u64(0xdbac6c247d62a583), imm_u64(0xdf45f746b74abf39) },
+	{ imm_u64(0x894bc396ce5da772), imm_u64(0x6b8bba8c328eb783) },
+	{ imm_u64(0xab9eb47c81f5114f), imm_u64(0x066ea92f3f326564) },
+	{ imm_u64(0xd686619ba27255a2), imm_u64(0xc80a537b0efefebd) },
+	{ imm_u64(0x8613fd0145877585), imm_u64(0xbd06742ce95f5f36) },
+	{ imm_u64(0xa798fc4196e952e7), imm_u64(0x2c48113823b73704) },
+	{ imm_u64(0xd17f3b51fca3a7a0), imm_u64(0xf75a15862ca504c5) },
+	{ imm_u64(0x82ef85133de648c4), imm_u64(0x9a984d73dbe722fb) },
+	{ imm_u64(0xa3ab66580d5fdaf5), imm_u64(0xc13e60d0d2e0ebba) },
+	{ imm_u64(0xcc963fee10b7d1b3), imm_u64(0x318df905079926a8) },
+	{ imm_u64(0xffbbcfe994e5c61f), imm_u64(0xfdf17746497f7052) },
+	{ imm_u64(0x9fd561f1fd0f9bd3), imm_u64(0xfeb6ea8bedefa633) },
+	{ imm_u64(0xc7caba6e7c5382c8), imm_u64(0xfe64a52ee96b8fc0) },
+	{ imm_u64(0xf9bd690a1b68637b), imm_u64(0x3dfdce7aa3c673b0) },
+	{ imm_u64(0x9c1661a651213e2d), imm_u64(0x06bea10ca65c084e) },
+	{ imm_u64(0xc31bfa0fe5698db8), imm_u64(0x486e494fcff30a62) },
+	{ imm_u64(0xf3e2f893dec3f126), imm_u64(0x5a89dba3c3efccfa) },
+	{ imm_u64(0x986ddb5c6b3a76b7), imm_u64(0xf89629465a75e01c) },
+	{ imm_u64(0xbe89523386091465), imm_u64(0xf6bbb397f1135823) },
+	{ imm_u64(0xee2ba6c0678b597f), imm_u64(0x746aa07ded582e2c) },
+	{ imm_u64(0x94db483840b717ef), imm_u64(0xa8c2a44eb4571cdc) },
+	{ imm_u64(0xba121a4650e4ddeb), imm_u64(0x92f34d62616ce413) },
+	{ imm_u64(0xe896a0d7e51e1566), imm_u64(0x77b020baf9c81d17) },
+	{ imm_u64(0x915e2486ef32cd60), imm_u64(0x0ace1474dc1d122e) },
+	{ imm_u64(0xb5b5ada8aaff80b8), imm_u64(0x0d819992132456ba) },
+	{ imm_u64(0xe3231912d5bf60e6), imm_u64(0x10e1fff697ed6c69) },
+	{ imm_u64(0x8df5efabc5979c8f), imm_u64(0xca8d3ffa1ef463c1) },
+	{ imm_u64(0xb1736b96b6fd83b3), imm_u64(0xbd308ff8a6b17cb2) },
+	{ imm_u64(0xddd0467c64bce4a0), imm_u64(0xac7cb3f6d05ddbde) },
+	{ imm_u64(0x8aa22c0dbef60ee4), imm_u64(0x6bcdf07a423aa96b) },
+	{ imm_u64(0xad4ab7112eb3929d), imm_u64(0x86c16c98d2c953c6) },
+	{ imm_u64(0xd89d64d57a607744), imm_u64(0xe871c7bf077ba8b7) },
+	{ imm_u64(0x87625f056c7c4a8b), imm_u64(0x11471cd764ad4972) },
+	{ imm_u64(0xa93af6c6c79b5d2d), imm_u64(0xd598e40d3dd89bcf) },
+	{ imm_u64(0xd389b47879823479), imm_u64(0x4aff1d108d4ec2c3) },
+	{ imm_u64(0x843610cb4bf160cb), imm_u64(0xcedf722a585139ba) },
+	{ imm_u64(0xa54394fe1eedb8fe), imm_u64(0xc2974eb4ee658828) },
+	{ imm_u64(0xce947a3da6a9273e), imm_u64(0x733d226229feea32) },
+	{ imm_u64(0x811ccc668829b887), imm_u64(0x0806357d5a3f525f) },
+	{ imm_u64(0xa163ff802a3426a8), imm_u64(0xca07c2dcb0cf26f7) },
+	{ imm_u64(0xc9bcff6034c13052), imm_u64(0xfc89b393dd02f0b5) },
+	{ imm_u64(0xfc2c3f3841f17c67), imm_u64(0xbbac2078d443ace2) },
+	{ imm_u64(0x9d9ba7832936edc0), imm_u64(0xd54b944b84aa4c0d) },
+	{ imm_u64(0xc5029163f384a931), imm_u64(0x0a9e795e65d4df11) },
+	{ imm_u64(0xf64335bcf065d37d), imm_u64(0x4d4617b5ff4a16d5) },
+	{ imm_u64(0x99ea0196163fa42e), imm_u64(0x504bced1bf8e4e45) },
+	{ imm_u64(0xc06481fb9bcf8d39), imm_u64(0xe45ec2862f71e1d6) },
+	{ imm_u64(0xf07da27a82c37088), imm_u64(0x5d767327bb4e5a4c) },
+	{ imm_u64(0x964e858c91ba2655), imm_u64(0x3a6a07f8d510f86f) },
+	{ imm_u64(0xbbe226efb628afea), imm_u64(0x890489f70a55368b) },
+	{ imm_u64(0xeadab0aba3b2dbe5), imm_u64(0x2b45ac74ccea842e) },
+	{ imm_u64(0x92c8ae6b464fc96f), imm_u64(0x3b0b8bc90012929d) },
+	{ imm_u64(0xb77ada0617e3bbcb), imm_u64(0x09ce6ebb40173744) },
+	{ imm_u64(0xe55990879ddcaabd), imm_u64(0xcc420a6a101d0515) },
+	{ imm_u64(0x8f57fa54c2a9eab6), imm_u64(0x9fa946824a12232d) },
+	{ imm_u64(0xb32df8e9f3546564), imm_u64(0x47939822dc96abf9) },
+	{ imm_u64(0xdff9772470297ebd), imm_u64(0x59787e2b93bc56f7) },
+	{ imm_u64(0x8bfbea76c619ef36), imm_u64(0x57eb4edb3c55b65a) },
+	{ imm_u64(0xaefae51477a06b03), imm_u64(0xede622920b6b23f1) },
+	{ imm_u64(0xdab99e59958885c4), imm_u64(0xe95fab368e45eced) },
+	{ imm_u64(0x88b402f7fd75539b), imm_u64(0x11dbcb0218ebb414) },
+	{ imm_u64(0xaae103b5fcd2a881), imm_u64(0xd652bdc29f26a119) },
+	{ imm_u64(0xd59944a37c0752a2), imm_u64(0x4be76d3346f0495f) },
+	{ imm_u64(0x857fcae62d8493a5), imm_u64(0x6f70a4400c562ddb) },
+	{ imm_u64(0xa6dfbd9fb8e5b88e), imm_u64(0xcb4ccd500f6bb952) },
+	{ imm_u64(0xd097ad07a71f26b2), imm_u64(0x7e2000a41346a7a7) },
+	{ imm_u64(0x825ecc24c873782f), imm_u64(0x8ed400668c0c28c8) },
+	{ imm_u64(0xa2f67f2dfa90563b), imm_u64(0x728900802f0f32fa) },
+	{ imm_u64(0xcbb41ef979346bca), imm_u64(0x4f2b40a03ad2ffb9) },
+	{ imm_u64(0xfea126b7d78186bc), imm_u64(0xe2f610c84987bfa8) },
+	{ imm_u64(0x9f24b832e6b0f436), imm_u64(0x0dd9ca7d2df4d7c9) },
+	{ imm_u64(0xc6ede63fa05d3143), imm_u64(0x91503d1c79720dbb) },
+	{ imm_u64(0xf8a95fcf88747d94), imm_u64(0x75a44c6397ce912a) },
+	{ imm_u64(0x9b69dbe1b548ce7c), imm_u64(0xc986afbe3ee11aba) },
+	{ imm_u64(0xc24452da229b021b), imm_u64(0xfbe85badce996168) },
+	{ imm_u64(0xf2d56790ab41c2a2), imm_u64(0xfae27299423fb9c3) },
+	{ imm_u64(0x97c560ba6b0919a5), imm_u64(0xdccd879fc967d41a) },
+	{ imm_u64(0xbdb6b8e905cb600f), imm_u64(0x5400e987bbc1c920) },
+	{ imm_u64(0xed246723473e3813), imm_u64(0x290123e9aab23b68) },
+	{ imm_u64(0x9436c0760c86e30b), imm_u64(0xf9a0b6720aaf6521) },
+	{ imm_u64(0xb94470938fa89bce), imm_u64(0xf808e40e8d5b3e69) },
+	{ imm_u64(0xe7958cb87392c2c2), imm_u64(0xb60b1d1230b20e04) },
+	{ imm_u64(0x90bd77f3483bb9b9), imm_u64(0xb1c6f22b5e6f48c2) },
+	{ imm_u64(0xb4ecd5f01a4aa828), imm_u64(0x1e38aeb6360b1af3) },
+	{ imm_u64(0xe2280b6c20dd5232), imm_u64(0x25c6da63c38de1b0) },
+	{ imm_u64(0x8d590723948a535f), imm_u64(0x579c487e5a38ad0e) },
+	{ imm_u64(0xb0af48ec79ace837), imm_u64(0x2d835a9df0c6d851) },
+	{ imm_u64(0xdcdb1b2798182244), imm_u64(0xf8e431456cf88e65) },
+	{ imm_u64(0x8a08f0f8bf0f156b), imm_u64(0x1b8e9ecb641b58ff) },
+	{ imm_u64(0xac8b2d36eed2dac5), imm_u64(0xe272467e3d222f3f) },
+	{ imm_u64(0xd7adf884aa879177), imm_u64(0x5b0ed81dcc6abb0f) },
+	{ imm_u64(0x86ccbb52ea94baea), imm_u64(0x98e947129fc2b4e9) },
+	{ imm_u64(0xa87fea27a539e9a5), imm_u64(0x3f2398d747b36224) },
+	{ imm_u64(0xd29fe4b18e88640e), imm_u64(0x8eec7f0d19a03aad) },
+	{ imm_u64(0x83a3eeeef9153e89), imm_u64(0x1953cf68300424ac) },
+	{ imm_u64(0xa48ceaaab75a8e2b), imm_u64(0x5fa8c3423c052dd7) },
+	{ imm_u64(0xcdb02555653131b6), imm_u64(0x3792f412cb06794d) },
+	{ imm_u64(0x808e17555f3ebf11), imm_u64(0xe2bbd88bbee40bd0) },
+	{ imm_u64(0xa0b19d2ab70e6ed6), imm_u64(0x5b6aceaeae9d0ec4) },
+	{ imm_u64(0xc8de047564d20a8b), imm_u64(0xf245825a5a445275) },
+	{ imm_u64(0xfb158592be068d2e), imm_u64(0xeed6e2f0f0d56712) },
+	{ imm_u64(0x9ced737bb6c4183d), imm_u64(0x55464dd69685606b) },
+	{ imm_u64(0xc428d05aa4751e4c), imm_u64(0xaa97e14c3c26b886) },
+	{ imm_u64(0xf53304714d9265df), imm_u64(0xd53dd99f4b3066a8) },
+	{ imm_u64(0x993fe2c6d07b7fab), imm_u64(0xe546a8038efe4029) },
+	{ imm_u64(0xbf8fdb78849a5f96), imm_u64(0xde98520472bdd033) },
+	{ imm_u64(0xef73d256a5c0f77c), imm_u64(0x963e66858f6d4440) },
+	{ imm_u64(0x95a8637627989aad), imm_u64(0xdde7001379a44aa8) },
+	{ imm_u64(0xbb127c53b17ec159), imm_u64(0x5560c018580d5d52) },
+	{ imm_u64(0xe9d71b689dde71af), imm_u64(0xaab8f01e6e10b4a6) },
+	{ imm_u64(0x9226712162ab070d), imm_u64(0xcab3961304ca70e8) },
+	{ imm_u64(0xb6b00d69bb55c8d1), imm_u64(0x3d607b97c5fd0d22) },
+	{ imm_u64(0xe45c10c42a2b3b05), imm_u64(0x8cb89a7db77c506a) },
+	{ imm_u64(0x8eb98a7a9a5b04e3), imm_u64(0x77f3608e92adb242) },
+	{ imm_u64(0xb267ed1940f1c61c), imm_u64(0x55f038b237591ed3) },
+	{ imm_u64(0xdf01e85f912e37a3), imm_u64(0x6b6c46dec52f6688) },
+	{ imm_u64(0x8b61313bbabce2c6), imm_u64(0x2323ac4b3b3da015) },
+	{ imm_u64(0xae397d8aa96c1b77), imm_u64(0xabec975e0a0d081a) },
+	{ imm_u64(0xd9c7dced53c72255), imm_u64(0x96e7bd358c904a21) },
+	{ imm_u64(0x881cea14545c7575), imm_u64(0x7e50d64177da2e54) },
+	{ imm_u64(0xaa242499697392d2), imm_u64(0xdde50bd1d5d0b9e9) },
+	{ imm_u64(0xd4ad2dbfc3d07787), imm_u64(0x955e4ec64b44e864) },
+	{ imm_u64(0x84ec3c97da624ab4), imm_u64(0xbd5af13bef0b113e) },
+	{ imm_u64(0xa6274bbdd0fadd61), imm_u64(0xecb1ad8aeacdd58e) },
+	{ imm_u64(0xcfb11ead453994ba), imm_u64(0x67de18eda5814af2) },
+	{ imm_u64(0x81ceb32c4b43fcf4), imm_u64(0x80eacf948770ced7) },
+	{ imm_u64(0xa2425ff75e14fc31), imm_u64(0xa1258379a94d028d) },
+	{ imm_u64(0xcad2f7f5359a3b3e), imm_u64(0x096ee45813a04330) },
+	{ imm_u64(0xfd87b5f28300ca0d), imm_u64(0x8bca9d6e188853fc) },
+	{ imm_u64(0x9e74d1b791e07e48), imm_u64(0x775ea264cf55347e) },
+	{ imm_u64(0xc612062576589dda), imm_u64(0x95364afe032a819e) },
+	{ imm_u64(0xf79687aed3eec551), imm_u64(0x3a83ddbd83f52205) },
+	{ imm_u64(0x9abe14cd44753b52), imm_u64(0xc4926a9672793543) },
+	{ imm_u64(0xc16d9a0095928a27), imm_u64(0x75b7053c0f178294) },
+	{ imm_u64(0xf1c90080baf72cb1), imm_u64(0x5324c68b12dd6339) },
+	{ imm_u64(0x971da05074da7bee), imm_u64(0xd3f6fc16ebca5e04) },
+	{ imm_u64(0xbce5086492111aea), imm_u64(0x88f4bb1ca6bcf585) },
+	{ imm_u64(0xec1e4a7db69561a5), imm_u64(0x2b31e9e3d06c32e6) },
+	{ imm_u64(0x9392ee8e921d5d07), imm_u64(0x3aff322e62439fd0) },
+	{ imm_u64(0xb877aa3236a4b449), imm_u64(0x09befeb9fad487c3) },
+	{ imm_u64(0xe69594bec44de15b), imm_u64(0x4c2ebe687989a9b4) },
+	{ imm_u64(0x901d7cf73ab0acd9), imm_u64(0x0f9d37014bf60a11) },
+	{ imm_u64(0xb424dc35095cd80f), imm_u64(0x538484c19ef38c95) },
+	{ imm_u64(0xe12e13424bb40e13), imm_u64(0x2865a5f206b06fba) },
+	{ imm_u64(0x8cbccc096f5088cb), imm_u64(0xf93f87b7442e45d4) },
+	{ imm_u64(0xafebff0bcb24aafe), imm_u64(0xf78f69a51539d749) },
+	{ imm_u64(0xdbe6fecebdedd5be), imm_u64(0xb573440e5a884d1c) },
+	{ imm_u64(0x89705f4136b4a597), imm_u64(0x31680a88f8953031) },
+	{ imm_u64(0xabcc77118461cefc), imm_u64(0xfdc20d2b36ba7c3e) },
+	{ imm_u64(0xd6bf94d5e57a42bc), imm_u64(0x3d32907604691b4d) },
+	{ imm_u64(0x8637bd05af6c69b5), imm_u64(0xa63f9a49c2c1b110) },
+	{ imm_u64(0xa7c5ac471b478423), imm_u64(0x0fcf80dc33721d54) },
+	{ imm_u64(0xd1b71758e219652b), imm_u64(0xd3c36113404ea4a9) },
+	{ imm_u64(0x83126e978d4fdf3b), imm_u64(0x645a1cac083126ea) },
+	{ imm_u64(0xa3d70a3d70a3d70a), imm_u64(0x3d70a3d70a3d70a4) },
+	{ imm_u64(0xcccccccccccccccc), imm_u64(0xcccccccccccccccd) },
+	{ imm_u64(0x8000000000000000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0xa000000000000000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0xc800000000000000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0xfa00000000000000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0x9c40000000000000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0xc350000000000000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0xf424000000000000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0x9896800000000000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0xbebc200000000000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0xee6b280000000000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0x9502f90000000000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0xba43b74000000000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0xe8d4a51000000000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0x9184e72a00000000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0xb5e620f480000000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0xe35fa931a0000000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0x8e1bc9bf04000000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0xb1a2bc2ec5000000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0xde0b6b3a76400000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0x8ac7230489e80000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0xad78ebc5ac620000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0xd8d726b7177a8000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0x878678326eac9000), imm_u64(0x0000000000000000) },
+	{ imm_u64(0xa968163f0a57b400), imm_u64(0x0000000000000000) },
+	{ imm_u64(0xd3c21bcecceda100), imm_u64(0x0000000000000000) },
+	{ imm_u64(0x84595161401484a0), imm_u64(0x0000000000000000) },
+	{ imm_u64(0xa56fa5b99019a5c8), imm_u64(0x0000000000000000) },
+	{ imm_u64(0xcecb8f27f4200f3a), imm_u64(0x0000000000000000) },
+	{ imm_u64(0x813f3978f8940984), imm_u64(0x4000000000000000) },
+	{ imm_u64(0xa18f07d736b90be5), imm_u64(0x5000000000000000) },
+	{ imm_u64(0xc9f2c9cd04674ede), imm_u64(0xa400000000000000) },
+	{ imm_u64(0xfc6f7c4045812296), imm_u64(0x4d00000000000000) },
+	{ imm_u64(0x9dc5ada82b70b59d), imm_u64(0xf020000000000000) },
+	{ imm_u64(0xc5371912364ce305), imm_u64(0x6c28000000000000) },
+	{ imm_u64(0xf684df56c3e01bc6), imm_u64(0xc732000000000000) },
+	{ imm_u64(0x9a130b963a6c115c), imm_u64(0x3c7f400000000000) },
+	{ imm_u64(0xc097ce7bc90715b3), imm_u64(0x4b9f100000000000) },
+	{ imm_u64(0xf0bdc21abb48db20), imm_u64(0x1e86d40000000000) },
+	{ imm_u64(0x96769950b50d88f4), imm_u64(0x1314448000000000) },
+	{ imm_u64(0xbc143fa4e250eb31), imm_u64(0x17d955a000000000) },
+	{ imm_u64(0xeb194f8e1ae525fd), imm_u64(0x5dcfab0800000000) },
+	{ imm_u64(0x92efd1b8d0cf37be), imm_u64(0x5aa1cae500000000) },
+	{ imm_u64(0xb7abc627050305ad), imm_u64(0xf14a3d9e40000000) },
+	{ imm_u64(0xe596b7b0c643c719), imm_u64(0x6d9ccd05d0000000) },
+	{ imm_u64(0x8f7e32ce7bea5c6f), imm_u64(0xe4820023a2000000) },
+	{ imm_u64(0xb35dbf821ae4f38b), imm_u64(0xdda2802c8a800000) },
+	{ imm_u64(0xe0352f62a19e306e), imm_u64(0xd50b2037ad200000) },
+	{ imm_u64(0x8c213d9da502de45), imm_u64(0x4526f422cc340000) },
+	{ imm_u64(0xaf298d050e4395d6), imm_u64(0x9670b12b7f410000) },
+	{ imm_u64(0xdaf3f04651d47b4c), imm_u64(0x3c0cdd765f114000) },
+	{ imm_u64(0x88d8762bf324cd0f), imm_u64(0xa5880a69fb6ac800) },
+	{ imm_u64(0xab0e93b6efee0053), imm_u64(0x8eea0d047a457a00) },
+	{ imm_u64(0xd5d238a4abe98068), imm_u64(0x72a4904598d6d880) },
+	{ imm_u64(0x85a36366eb71f041), imm_u64(0x47a6da2b7f864750) },
+	{ imm_u64(0xa70c3c40a64e6c51), imm_u64(0x999090b65f67d924) },
+	{ imm_u64(0xd0cf4b50cfe20765), imm_u64(0xfff4b4e3f741cf6d) },
+	{ imm_u64(0x82818f1281ed449f), imm_u64(0xbff8f10e7a8921a4) },
+	{ imm_u64(0xa321f2d7226895c7), imm_u64(0xaff72d52192b6a0d) },
+	{ imm_u64(0xcbea6f8ceb02bb39), imm_u64(0x9bf4f8a69f764490) },
+	{ imm_u64(0xfee50b7025c36a08), imm_u64(0x02f236d04753d5b4) },
+	{ imm_u64(0x9f4f2726179a2245), imm_u64(0x01d762422c946590) },
+	{ imm_u64(0xc722f0ef9d80aad6), imm_u64(0x424d3ad2b7b97ef5) },
+	{ imm_u64(0xf8ebad2b84e0d58b), imm_u64(0xd2e0898765a7deb2) },
+	{ imm_u64(0x9b934c3b330c8577), imm_u64(0x63cc55f49f88eb2f) },
+	{ imm_u64(0xc2781f49ffcfa6d5), imm_u64(0x3cbf6b71c76b25fb) },
+	{ imm_u64(0xf316271c7fc3908a), imm_u64(0x8bef464e3945ef7a) },
+	{ imm_u64(0x97edd871cfda3a56), imm_u64(0x97758bf0e3cbb5ac) },
+	{ imm_u64(0xbde94e8e43d0c8ec), imm_u64(0x3d52eeed1cbea317) },
+	{ imm_u64(0xed63a231d4c4fb27), imm_u64(0x4ca7aaa863ee4bdd) },
+	{ imm_u64(0x945e455f24fb1cf8), imm_u64(0x8fe8caa93e74ef6a) },
+	{ imm_u64(0xb975d6b6ee39e436), imm_u64(0xb3e2fd538e122b44) },
+	{ imm_u64(0xe7d34c64a9c85d44), imm_u64(0x60dbbca87196b616) },
+	{ imm_u64(0x90e40fbeea1d3a4a), imm_u64(0xbc8955e946fe31cd) },
+	{ imm_u64(0xb51d13aea4a488dd), imm_u64(0x6babab6398bdbe41) },
+	{ imm_u64(0xe264589a4dcdab14), imm_u64(0xc696963c7eed2dd1) },
+	{ imm_u64(0x8d7eb76070a08aec), imm_u64(0xfc1e1de5cf543ca2) },
+	{ imm_u64(0xb0de65388cc8ada8), imm_u64(0x3b25a55f43294bcb) },
+	{ imm_u64(0xdd15fe86affad912), imm_u64(0x49ef0eb713f39ebe) },
+	{ imm_u64(0x8a2dbf142dfcc7ab), imm_u64(0x6e3569326c784337) },
+	{ imm_u64(0xacb92ed9397bf996), imm_u64(0x49c2c37f07965404) },
+	{ imm_u64(0xd7e77a8f87daf7fb), imm_u64(0xdc33745ec97be906) },
+	{ imm_u64(0x86f0ac99b4e8dafd), imm_u64(0x69a028bb3ded71a3) },
+	{ imm_u64(0xa8acd7c0222311bc), imm_u64(0xc40832ea0d68ce0c) },
+	{ imm_u64(0xd2d80db02aabd62b), imm_u64(0xf50a3fa490c30190) },
+	{ imm_u64(0x83c7088e1aab65db), imm_u64(0x792667c6da79e0fa) },
+	{ imm_u64(0xa4b8cab1a1563f52), imm_u64(0x577001b891185938) },
+	{ imm_u64(0xcde6fd5e09abcf26), imm_u64(0xed4c0226b55e6f86) },
+	{ imm_u64(0x80b05e5ac60b6178), imm_u64(0x544f8158315b05b4) },
+	{ imm_u64(0xa0dc75f1778e39d6), imm_u64(0x696361ae3db1c721) },
+	{ imm_u64(0xc913936dd571c84c), imm_u64(0x03bc3a19cd1e38e9) },
+	{ imm_u64(0xfb5878494ace3a5f), imm_u64(0x04ab48a04065c723) },
+	{ imm_u64(0x9d174b2dcec0e47b), imm_u64(0x62eb0d64283f9c76) },
+	{ imm_u64(0xc45d1df942711d9a), imm_u64(0x3ba5d0bd324f8394) },
+	{ imm_u64(0xf5746577930d6500), imm_u64(0xca8f44ec7ee36479) },
+	{ imm_u64(0x9968bf6abbe85f20), imm_u64(0x7e998b13cf4e1ecb) },
+	{ imm_u64(0xbfc2ef456ae276e8), imm_u64(0x9e3fedd8c321a67e) },
+	{ imm_u64(0xefb3ab16c59b14a2), imm_u64(0xc5cfe94ef3ea101e) },
+	{ imm_u64(0x95d04aee3b80ece5), imm_u64(0xbba1f1d158724a12) },
+	{ imm_u64(0xbb445da9ca61281f), imm_u64(0x2a8a6e45ae8edc97) },
+	{ imm_u64(0xea1575143cf97226), imm_u64(0xf52d09d71a3293bd) },
+	{ imm_u64(0x924d692ca61be758), imm_u64(0x593c2626705f9c56) },
+	{ imm_u64(0xb6e0c377cfa2e12e), imm_u64(0x6f8b2fb00c77836c) },
+	{ imm_u64(0xe498f455c38b997a), imm_u64(0x0b6dfb9c0f956447) },
+	{ imm_u64(0x8edf98b59a373fec), imm_u64(0x4724bd4189bd5eac) },
+	{ imm_u64(0xb2977ee300c50fe7), imm_u64(0x58edec91ec2cb657) },
+	{ imm_u64(0xdf3d5e9bc0f653e1), imm_u64(0x2f2967b66737e3ed) },
+	{ imm_u64(0x8b865b215899f46c), imm_u64(0xbd79e0d20082ee74) },
+	{ imm_u64(0xae67f1e9aec07187), imm_u64(0xecd8590680a3aa11) },
+	{ imm_u64(0xda01ee641a708de9), imm_u64(0xe80e6f4820cc9495) },
+	{ imm_u64(0x884134fe908658b2), imm_u64(0x3109058d147fdcdd) },
+	{ imm_u64(0xaa51823e34a7eede), imm_u64(0xbd4b46f0599fd415) },
+	{ imm_u64(0xd4e5e2cdc1d1ea96), imm_u64(0x6c9e18ac7007c91a) },
+	{ imm_u64(0x850fadc09923329e), imm_u64(0x03e2cf6bc604ddb0) },
+	{ imm_u64(0xa6539930bf6bff45), imm_u64(0x84db8346b786151c) },
+	{ imm_u64(0xcfe87f7cef46ff16), imm_u64(0xe612641865679a63) },
+	{ imm_u64(0x81f14fae158c5f6e), imm_u64(0x4fcb7e8f3f60c07e) },
+	{ imm_u64(0xa26da3999aef7749), imm_u64(0xe3be5e330f38f09d) },
+	{ imm_u64(0xcb090c8001ab551c), imm_u64(0x5cadf5bfd3072cc5) },
+	{ imm_u64(0xfdcb4fa002162a63), imm_u64(0x73d9732fc7c8f7f6) },
+	{ imm_u64(0x9e9f11c4014dda7e), imm_u64(0x2867e7fddcdd9afa) },
+	{ imm_u64(0xc646d63501a1511d), imm_u64(0xb281e1fd541501b8) },
+	{ imm_u64(0xf7d88bc24209a565), imm_u64(0x1f225a7ca91a4226) },
+	{ imm_u64(0x9ae757596946075f), imm_u64(0x3375788de9b06958) },
+	{ imm_u64(0xc1a12d2fc3978937), imm_u64(0x0052d6b1641c83ae) },
+	{ imm_u64(0xf209787bb47d6b84), imm_u64(0xc0678c5dbd23a49a) },
+	{ imm_u64(0x9745eb4d50ce6332), imm_u64(0xf840b7ba963646e0) },
+	{ imm_u64(0xbd176620a501fbff), imm_u64(0xb650e5a93bc3d898) },
+	{ imm_u64(0xec5d3fa8ce427aff), imm_u64(0xa3e51f138ab4cebe) },
+	{ imm_u64(0x93ba47c980e98cdf), imm_u64(0xc66f336c36b10137) },
+	{ imm_u64(0xb8a8d9bbe123f017), imm_u64(0xb80b0047445d4184) },
+	{ imm_u64(0xe6d3102ad96cec1d), imm_u64(0xa60dc059157491e5) },
+	{ imm_u64(0x9043ea1ac7e41392), imm_u64(0x87c89837ad68db2f) },
+	{ imm_u64(0xb454e4a179dd1877), imm_u64(0x29babe4598c311fb) },
+	{ imm_u64(0xe16a1dc9d8545e94), imm_u64(0xf4296dd6fef3d67a) },
+	{ imm_u64(0x8ce2529e2734bb1d), imm_u64(0x1899e4a65f58660c) },
+	{ imm_u64(0xb01ae745b101e9e4), imm_u64(0x5ec05dcff72e7f8f) },
+	{ imm_u64(0xdc21a1171d42645d), imm_u64(0x76707543f4fa1f73) },
+	{ imm_u64(0x899504ae72497eba), imm_u64(0x6a06494a791c53a8) },
+	{ imm_u64(0xabfa45da0edbde69), imm_u64(0x0487db9d17636892) },
+	{ imm_u64(0xd6f8d7509292d603), imm_u64(0x45a9d2845d3c42b6) },
+	{ imm_u64(0x865b86925b9bc5c2), imm_u64(0x0b8a2392ba45a9b2) },
+	{ imm_u64(0xa7f26836f282b732), imm_u64(0x8e6cac7768d7141e) },
+	{ imm_u64(0xd1ef0244af2364ff), imm_u64(0x3207d795430cd926) },
+	{ imm_u64(0x8335616aed761f1f), imm_u64(0x7f44e6bd49e807b8) },
+	{ imm_u64(0xa402b9c5a8d3a6e7), imm_u64(0x5f16206c9c6209a6) },
+	{ imm_u64(0xcd036837130890a1), imm_u64(0x36dba887c37a8c0f) },
+	{ imm_u64(0x802221226be55a64), imm_u64(0xc2494954da2c9789) },
+	{ imm_u64(0xa02aa96b06deb0fd), imm_u64(0xf2db9baa10b7bd6c) },
+	{ imm_u64(0xc83553c5c8965d3d), imm_u64(0x6f92829494e5acc7) },
+	{ imm_u64(0xfa42a8b73abbf48c), imm_u64(0xcb772339ba1f17f9) },
+	{ imm_u64(0x9c69a97284b578d7), imm_u64(0xff2a760414536efb) },
+	{ imm_u64(0xc38413cf25e2d70d), imm_u64(0xfef5138519684aba) },
+	{ imm_u64(0xf46518c2ef5b8cd1), imm_u64(0x7eb258665fc25d69) },
+	{ imm_u64(0x98bf2f79d5993802), imm_u64(0xef2f773ffbd97a61) },
+	{ imm_u64(0xbeeefb584aff8603), imm_u64(0xaafb550ffacfd8fa) },
+	{ imm_u64(0xeeaaba2e5dbf6784), imm_u64(0x95ba2a53f983cf38) },
+	{ imm_u64(0x952ab45cfa97a0b2), imm_u64(0xdd945a747bf26183) },
+	{ imm_u64(0xba756174393d88df), imm_u64(0x94f971119aeef9e4) },
+	{ imm_u64(0xe912b9d1478ceb17), imm_u64(0x7a37cd5601aab85d) },
+	{ imm_u64(0x91abb422ccb812ee), imm_u64(0xac62e055c10ab33a) },
+	{ imm_u64(0xb616a12b7fe617aa), imm_u64(0x577b986b314d6009) },
+	{ imm_u64(0xe39c49765fdf9d94), imm_u64(0xed5a7e85fda0b80b) },
+	{ imm_u64(0x8e41ade9fbebc27d), imm_u64(0x14588f13be847307) },
+	{ imm_u64(0xb1d219647ae6b31c), imm_u64(0x596eb2d8ae258fc8) },
+	{ imm_u64(0xde469fbd99a05fe3), imm_u64(0x6fca5f8ed9aef3bb) },
+	{ imm_u64(0x8aec23d680043bee), imm_u64(0x25de7bb9480d5854) },
+	{ imm_u64(0xada72ccc20054ae9), imm_u64(0xaf561aa79a10ae6a) },
+	{ imm_u64(0xd910f7ff28069da4), imm_u64(0x1b2ba1518094da04) },
+	{ imm_u64(0x87aa9aff79042286), imm_u64(0x90fb44d2f05d0842) },
+	{ imm_u64(0xa99541bf57452b28), imm_u64(0x353a1607ac744a53) },
+	{ imm_u64(0xd3fa922f2d1675f2), imm_u64(0x42889b8997915ce8) },
+	{ imm_u64(0x847c9b5d7c2e09b7), imm_u64(0x69956135febada11) },
+	{ imm_u64(0xa59bc234db398c25), imm_u64(0x43fab9837e699095) },
+	{ imm_u64(0xcf02b2c21207ef2e), imm_u64(0x94f967e45e03f4bb) },
+	{ imm_u64(0x8161afb94b44f57d), imm_u64(0x1d1be0eebac278f5) },
+	{ imm_u64(0xa1ba1ba79e1632dc), imm_u64(0x6462d92a69731732) },
+	{ imm_u64(0xca28a291859bbf93), imm_u64(0x7d7b8f7503cfdcfe) },
+	{ imm_u64(0xfcb2cb35e702af78), imm_u64(0x5cda735244c3d43e) },
+	{ imm_u64(0x9defbf01b061adab), imm_u64(0x3a0888136afa64a7) },
+	{ imm_u64(0xc56baec21c7a1916), imm_u64(0x088aaa1845b8fdd0) },
+	{ imm_u64(0xf6c69a72a3989f5b), imm_u64(0x8aad549e57273d45) },
+	{ imm_u64(0x9a3c2087a63f6399), imm_u64(0x36ac54e2f678864b) },
+	{ imm_u64(0xc0cb28a98fcf3c7f), imm_u64(0x84576a1bb416a7dd) },
+	{ imm_u64(0xf0fdf2d3f3c30b9f), imm_u64(0x656d44a2a11c51d5) },
+	{ imm_u64(0x969eb7c47859e743), imm_u64(0x9f644ae5a4b1b325) },
+	{ imm_u64(0xbc4665b596706114), imm_u64(0x873d5d9f0dde1fee) },
+	{ imm_u64(0xeb57ff22fc0c7959), imm_u64(0xa90cb506d155a7ea) },
+	{ imm_u64(0x9316ff75dd87cbd8), imm_u64(0x09a7f12442d588f2) },
+	{ imm_u64(0xb7dcbf5354e9bece), imm_u64(0x0c11ed6d538aeb2f) },
+	{ imm_u64(0xe5d3ef282a242e81), imm_u64(0x8f1668c8a86da5fa) },
+	{ imm_u64(0x8fa475791a569d10), imm_u64(0xf96e017d694487bc) },
+	{ imm_u64(0xb38d92d760ec4455), imm_u64(0x37c981dcc395a9ac) },
+	{ imm_u64(0xe070f78d3927556a), imm_u64(0x85bbe253f47b1417) },
+	{ imm_u64(0x8c469ab843b89562), imm_u64(0x93956d7478ccec8e) },
+	{ imm_u64(0xaf58416654a6babb), imm_u64(0x387ac8d1970027b2) },
+	{ imm_u64(0xdb2e51bfe9d0696a), imm_u64(0x06997b05fcc0319e) },
+	{ imm_u64(0x88fcf317f22241e2), imm_u64(0x441fece3bdf81f03) },
+	{ imm_u64(0xab3c2fddeeaad25a), imm_u64(0xd527e81cad7626c3) },
+	{ imm_u64(0xd60b3bd56a5586f1), imm_u64(0x8a71e223d8d3b074) },
+	{ imm_u64(0x85c7056562757456), imm_u64(0xf6872d5667844e49) },
+	{ imm_u64(0xa738c6bebb12d16c), imm_u64(0xb428f8ac016561db) },
+	{ imm_u64(0xd106f86e69d785c7), imm_u64(0xe13336d701beba52) },
+	{ imm_u64(0x82a45b450226b39c), imm_u64(0xecc0024661173473) },
+	{ imm_u64(0xa34d721642b06084), imm_u64(0x27f002d7f95d0190) },
+	{ imm_u64(0xcc20ce9bd35c78a5), imm_u64(0x31ec038df7b441f4) },
+	{ imm_u64(0xff290242c83396ce), imm_u64(0x7e67047175a15271) },
+	{ imm_u64(0x9f79a169bd203e41), imm_u64(0x0f0062c6e984d386) },
+	{ imm_u64(0xc75809c42c684dd1), imm_u64(0x52c07b78a3e60868) },
+	{ imm_u64(0xf92e0c3537826145), imm_u64(0xa7709a56ccdf8a82) },
+	{ imm_u64(0x9bbcc7a142b17ccb), imm_u64(0x88a66076400bb691) },
+	{ imm_u64(0xc2abf989935ddbfe), imm_u64(0x6acff893d00ea435) },
+	{ imm_u64(0xf356f7ebf83552fe), imm_u64(0x0583f6b8c4124d43) },
+	{ imm_u64(0x98165af37b2153de), imm_u64(0xc3727a337a8b704a) },
+	{ imm_u64(0xbe1bf1b059e9a8d6), imm_u64(0x744f18c0592e4c5c) },
+	{ imm_u64(0xeda2ee1c7064130c), imm_u64(0x1162def06f79df73) },
+	{ imm_u64(0x9485d4d1c63e8be7), imm_u64(0x8addcb5645ac2ba8) },
+	{ imm_u64(0xb9a74a0637ce2ee1), imm_u64(0x6d953e2bd7173692) },
+	{ imm_u64(0xe8111c87c5c1ba99), imm_u64(0xc8fa8db6ccdd0437) },
+	{ imm_u64(0x910ab1d4db9914a0), imm_u64(0x1d9c9892400a22a2) },
+	{ imm_u64(0xb54d5e4a127f59c8), imm_u64(0x2503beb6d00cab4b) },
+	{ imm_u64(0xe2a0b5dc971f303a), imm_u64(0x2e44ae64840fd61d) },
+	{ imm_u64(0x8da471a9de737e24), imm_u64(0x5ceaecfed289e5d2) },
+	{ imm_u64(0xb10d8e1456105dad), imm_u64(0x7425a83e872c5f47) },
+	{ imm_u64(0xdd50f1996b947518), imm_u64(0xd12f124e28f77719) },
+	{ imm_u64(0x8a5296ffe33cc92f), imm_u64(0x82bd6b70d99aaa6f) },
+	{ imm_u64(0xace73cbfdc0bfb7b), imm_u64(0x636cc64d1001550b) },
+	{ imm_u64(0xd8210befd30efa5a), imm_u64(0x3c47f7e05401aa4e) },
+	{ imm_u64(0x8714a775e3e95c78), imm_u64(0x65acfaec34810a71) },
+	{ imm_u64(0xa8d9d1535ce3b396), imm_u64(0x7f1839a741a14d0d) },
+	{ imm_u64(0xd31045a8341ca07c), imm_u64(0x1ede48111209a050) },
+	{ imm_u64(0x83ea2b892091e44d), imm_u64(0x934aed0aab460432) },
+	{ imm_u64(0xa4e4b66b68b65d60), imm_u64(0xf81da84d5617853f) },
+	{ imm_u64(0xce1de40642e3f4b9), imm_u64(0x36251260ab9d668e) },
+	{ imm_u64(0x80d2ae83e9ce78f3), imm_u64(0xc1d72b7c6b426019) },
+	{ imm_u64(0xa1075a24e4421730), imm_u64(0xb24cf65b8612f81f) },
+	{ imm_u64(0xc94930ae1d529cfc), imm_u64(0xdee033f26797b627) },
+	{ imm_u64(0xfb9b7cd9a4a7443c), imm_u64(0x169840ef017da3b1) },
+	{ imm_u64(0x9d412e0806e88aa5), imm_u64(0x8e1f289560ee864e) },
+	{ imm_u64(0xc491798a08a2ad4e), imm_u64(0xf1a6f2bab92a27e2) },
+	{ imm_u64(0xf5b5d7ec8acb58a2), imm_u64(0xae10af696774b1db) },
+	{ imm_u64(0x9991a6f3d6bf1765), imm_u64(0xacca6da1e0a8ef29) },
+	{ imm_u64(0xbff610b0cc6edd3f), imm_u64(0x17fd090a58d32af3) },
+	{ imm_u64(0xeff394dcff8a948e), imm_u64(0xddfc4b4cef07f5b0) },
+	{ imm_u64(0x95f83d0a1fb69cd9), imm_u64(0x4abdaf101564f98e) },
+	{ imm_u64(0xbb764c4ca7a4440f), imm_u64(0x9d6d1ad41abe37f1) },
+	{ imm_u64(0xea53df5fd18d5513), imm_u64(0x84c86189216dc5ed) },
+	{ imm_u64(0x92746b9be2f8552c), imm_u64(0x32fd3cf5b4e49bb4) },
+	{ imm_u64(0xb7118682dbb66a77), imm_u64(0x3fbc8c33221dc2a1) },
+	{ imm_u64(0xe4d5e82392a40515), imm_u64(0x0fabaf3feaa5334a) },
+	{ imm_u64(0x8f05b1163ba6832d), imm_u64(0x29cb4d87f2a7400e) },
+	{ imm_u64(0xb2c71d5bca9023f8), imm_u64(0x743e20e9ef511012) },
+	{ imm_u64(0xdf78e4b2bd342cf6), imm_u64(0x914da9246b255416) },
+	{ imm_u64(0x8bab8eefb6409c1a), imm_u64(0x1ad089b6c2f7548e) },
+	{ imm_u64(0xae9672aba3d0c320), imm_u64(0xa184ac2473b529b1) },
+	{ imm_u64(0xda3c0f568cc4f3e8), imm_u64(0xc9e5d72d90a2741e) },
+	{ imm_u64(0x8865899617fb1871), imm_u64(0x7e2fa67c7a658892) },
+	{ imm_u64(0xaa7eebfb9df9de8d), imm_u64(0xddbb901b98feeab7) },
+	{ imm_u64(0xd51ea6fa85785631), imm_u64(0x552a74227f3ea565) },
+	{ imm_u64(0x8533285c936b35de), imm_u64(0xd53a88958f87275f) },
+	{ imm_u64(0xa67ff273b8460356), imm_u64(0x8a892abaf368f137) },
+	{ imm_u64(0xd01fef10a657842c), imm_u64(0x2d2b7569b0432d85) },
+	{ imm_u64(0x8213f56a67f6b29b), imm_u64(0x9c3b29620e29fc73) },
+	{ imm_u64(0xa298f2c501f45f42), imm_u64(0x8349f3ba91b47b8f) },
+	{ imm_u64(0xcb3f2f7642717713), imm_u64(0x241c70a936219a73) },
+	{ imm_u64(0xfe0efb53d30dd4d7), imm_u64(0xed238cd383aa0110) },
+	{ imm_u64(0x9ec95d1463e8a506), imm_u64(0xf4363804324a40aa) },
+	{ imm_u64(0xc67bb4597ce2ce48), imm_u64(0xb143c6053edcd0d5) },
+	{ imm_u64(0xf81aa16fdc1b81da), imm_u64(0xdd94b7868e94050a) },
+	{ imm_u64(0x9b10a4e5e9913128), imm_u64(0xca7cf2b4191c8326) },
+	{ imm_u64(0xc1d4ce1f63f57d72), imm_u64(0xfd1c2f611f63a3f0) },
+	{ imm_u64(0xf24a01a73cf2dccf), imm_u64(0xbc633b39673c8cec) },
+	{ imm_u64(0x976e41088617ca01), imm_u64(0xd5be0503e085d813) },
+	{ imm_u64(0xbd49d14aa79dbc82), imm_u64(0x4b2d8644d8a74e18) },
+	{ imm_u64(0xec9c459d51852ba2), imm_u64(0xddf8e7d60ed1219e) },
+	{ imm_u64(0x93e1ab8252f33b45), imm_u64(0xcabb90e5c942b503) },
+	{ imm_u64(0xb8da1662e7b00a17), imm_u64(0x3d6a751f3b936243) },
+	{ imm_u64(0xe7109bfba19c0c9d), imm_u64(0x0cc512670a783ad4) },
+	{ imm_u64(0x906a617d450187e2), imm_u64(0x27fb2b80668b24c5) },
+	{ imm_u64(0xb484f9dc9641e9da), imm_u64(0xb1f9f660802dedf6) },
+	{ imm_u64(0xe1a63853bbd26451), imm_u64(0x5e7873f8a0396973) },
+	{ imm_u64(0x8d07e33455637eb2), imm_u64(0xdb0b487b6423e1e8) },
+	{ imm_u64(0xb049dc016abc5e5f), imm_u64(0x91ce1a9a3d2cda62) },
+	{ imm_u64(0xdc5c5301c56b75f7), imm_u64(0x7641a140cc7810fb) },
+	{ imm_u64(0x89b9b3e11b6329ba), imm_u64(0xa9e904c87fcb0a9d) },
+	{ imm_u64(0xac2820d9623bf429), imm_u64(0x546345fa9fbdcd44) },
+	{ imm_u64(0xd732290fbacaf133), imm_u64(0xa97c177947ad4095) },
+	{ imm_u64(0x867f59a9d4bed6c0), imm_u64(0x49ed8eabcccc485d) },
+	{ imm_u64(0xa81f301449ee8c70), imm_u64(0x5c68f256bfff5a74) },
+	{ imm_u64(0xd226fc195c6a2f8c), imm_u64(0x73832eec6fff3111) },
+	{ imm_u64(0x83585d8fd9c25db7), imm_u64(0xc831fd53c5ff7eab) },
+	{ imm_u64(0xa42e74f3d032f525), imm_u64(0xba3e7ca8b77f5e55) },
+	{ imm_u64(0xcd3a1230c43fb26f), imm_u64(0x28ce1bd2e55f35eb) },
+	{ imm_u64(0x80444b5e7aa7cf85), imm_u64(0x7980d163cf5b81b3) },
+	{ imm_u64(0xa0555e361951c366), imm_u64(0xd7e105bcc332621f) },
+	{ imm_u64(0xc86ab5c39fa63440), imm_u64(0x8dd9472bf3fefaa7) },
+	{ imm_u64(0xfa856334878fc150), imm_u64(0xb14f98f6f0feb951) },
+	{ imm_u64(0x9c935e00d4b9d8d2), imm_u64(0x6ed1bf9a569f33d3) },
+	{ imm_u64(0xc3b8358109e84f07), imm_u64(0x0a862f80ec4700c8) },
+	{ imm_u64(0xf4a642e14c6262c8), imm_u64(0xcd27bb612758c0fa) },
+	{ imm_u64(0x98e7e9cccfbd7dbd), imm_u64(0x8038d51cb897789c) },
+	{ imm_u64(0xbf21e44003acdd2c), imm_u64(0xe0470a63e6bd56c3) },
+	{ imm_u64(0xeeea5d5004981478), imm_u64(0x1858ccfce06cac74) },
+	{ imm_u64(0x95527a5202df0ccb), imm_u64(0x0f37801e0c43ebc8) },
+	{ imm_u64(0xbaa718e68396cffd), imm_u64(0xd30560258f54e6ba) },
+	{ imm_u64(0xe950df20247c83fd), imm_u64(0x47c6b82ef32a2069) },
+	{ imm_u64(0x91d28b7416cdd27e), imm_u64(0x4cdc331d57fa5441) },
+	{ imm_u64(0xb6472e511c81471d), imm_u64(0xe0133fe4adf8e952) },
+	{ imm_u64(0xe3d8f9e563a198e5), imm_u64(0x58180fddd97723a6) },
+	{ imm_u64(0x8e679c2f5e44ff8f), imm_u64(0x570f09eaa7ea7648) },
+};
+
+struct parse_format {
+	u32 mbits;
+	u32 sign;
+	s32 bias;
+	s32 inf;
+	s32 minq;
+	s32 maxq;
+	s32 evenlo;
+	s32 evenhi;
+	u64 nan;
+};
+
+static const struct parse_format PARSE_F64 = { 52, 63, 1023, 0x7ff, -342, 308, -4, 23, imm_u64(0x7ff8000000000000) };
+static const struct parse_format PARSE_F32 = { 23, 31, 127, 0xff, -64, 38, -17, 10, 0x7fc00000 };
+
+/* Returns the bits of the float nearest to w * 10^q. */
+static u64 parse_lemire(u64 w, s64 q, const struct parse_format *f) {
+	const u64 *t;
+	u64 lo, hi, m, mask;
+	s32 lz, upper, shift, e2;
+	if (w == 0 || q < f->minq)
+		return 0;
+	if (q > f->maxq)
+		return (u64) f->inf << f->mbits;
+	lz = (s32) clz_u64(w);
+	w <<= lz;
+	t = PARSE_POW5_128[q + 342];
+	hi = mulwide_u64(w, t[0], &lo);
+	mask = ~imm_u64(0) >> (f->mbits + 3);
+	if ((hi & mask) == mask) {
+		u64 lo2, hi2 = mulwide_u64(w, t[1], &lo2);
+		(void) lo2;
+		lo += hi2;
+		hi += hi2 > lo;
+	}
+	upper = (s32) (hi >> 63);
+	shift = upper + 64 - (s32) f->mbits - 3;
+	m = hi >> shift;
+	e2 = ((((152170 + 65536) * (s32) q) >> 16) + 63) + upper - lz + f->bias;
+	if (e2 <= 0) {
+		if (-e2 + 1 >= 64)
+			return 0;
+		m >>= -e2 + 1;
+		m += m & 1;
+		m >>= 1;
+		return m;
+	}
+	/* An exact tie lands on an even mantissa; the low product bits can only
+	   be that small when 5^q fits in 64 bits. */
+	if (lo <= 1 && q >= f->evenlo && q <= f->evenhi && (m & 3) == 1 && (m << shift) == hi)
+		m &= ~imm_u64(1);
+	m += m & 1;
+	m >>= 1;
+	if (m >= imm_u64(2) << f->mbits) {
+		m = imm_u64(1) << f->mbits;
+		++e2;
+	}
+	m &= ~(imm_u64(1) << f->mbits);
+	if (e2 >= f->inf)
+		return (u64) f->inf << f->mbits;
+	return m | (u64) e2 << f->mbits;
+}
+
+/* Enough significant digits to round any f64 correctly. */
+#define PARSE_SLOW_DIGITS 800
+
+/* Rewrites the mantissa text as digits and an exponent, which reads the
+   same in every locale, keeping the first PARSE_SLOW_DIGITS digits and a
+   final 1 in place of any nonzero ones dropped. */
+static u64 parse_slow(const char *p, const char *end, s64 e, const struct parse_format *f) {
+	char buf[PARSE_SLOW_DIGITS + 2 + FORMAT_MAX_S64];
+	size_t n = 0;
+	bool point = false, sticky = false;
+	for (; p < end; ++p) {
+		if (*p == '.')
+			point = true;
+		else if (n == 0 && *p == '0')
+			e -= point;
+		else if (n < PARSE_SLOW_DIGITS) {
+			buf[n++] = *p;
+			e -= point;
+		} else {
+			sticky |= *p != '0';
+			e += !point;
+		}
+	}
+	if (sticky) {
+		buf[n++] = '1';
+		--e;
+	}
+	buf[n++] = 'e';
+	n += format_s64(buf + n, e);
+	buf[n] = 0;
+	if (f == &PARSE_F32) {
+		f32 v = strtof(buf, NULL);
+		u32 bits;
+		memcpy(&bits, &v, sizeof bits);
+		return bits;
+	} else {
+		f64 v = strtod(buf, NULL);
+		u64 bits;
+		memcpy(&bits, &v, sizeof bits);
+		return bits;
+	}
+}
+
+_parse_alwaysinline static bool parse_word(const char *p, const char *end, const char *word, size_t n) {
+	size_t i;
+	if ((size_t) (end - p) < n)
+		return false;
+	for (i = 0; i < n; ++i)
+		if ((p[i] | 0x20) != word[i])
+			return false;
+	return true;
+}
+
+static u32 parse_float(u64 *bits, size_t *used, const char *src, size_t size, const struct parse_format *f) {
+	const char *p = src, *end = src + size, *m, *d;
+	bool neg = false, trunc = false, digits;
+	u64 w = 0, sign;
+	s64 e = 0, ex = 0;
+	u32 nd = 0, c;
+
+	if (p < end && (*p == '-' || *p == '+'))
+		neg = *p++ == '-';
+	sign = (u64) neg << f->sign;
+	if (parse_word(p, end, "inf", 3)) {
+		*bits = sign | (u64) f->inf << f->mbits;
+		return parse_finish(used, src, p + (parse_word(p, end, "infinity", 8) ? 8 : 3), PARSE_OK);
+	}
+	if (parse_word(p, end, "nan", 3)) {
+		*bits = sign | f->nan;
+		return parse_finish(used, src, p + 3, PARSE_OK);
+	}
+
+	m = p;
+	while (p < end && *p == '0')
+		++p;
+	for (; end - p >= 8 && nd <= 11; p += 8, nd += 8) {
+		u64 x = _load_le64(p);
+		if (!parse_is8(x))
+			break;
+		w = w * 100000000 + parse_8(x);
+	}
+	for (; p < end && (c = parse_digit(*p)) < 10; ++p) {
+		if (nd < 19) {
+			w = w * 10 + c;
+			++nd;
+		} else {
+			trunc |= c != 0;
+			++e;
+		}
+	}
+	digits = p != m;
+	if (p < end && *p == '.') {
+		d = ++p;
+		if (nd == 0)
+			for (; p < end && *p == '0'; ++p)
+				--e;
+		for (; end - p >= 8 && nd <= 11; p += 8, nd += 8, e -= 8) {
+			u64 x = _load_le64(p);
+			if (!parse_is8(x))
+				break;
+			w = w * 100000000 + parse_8(x);
+		}
+		for (; p < end && (c = parse_digit(*p)) < 10; ++p) {
+			if (nd < 19) {
+				w = w * 10 + c;
+				++nd;
+				--e;
+			} else
+				trunc |= c != 0;
+		}
+		digits |= p != d;
+	}
+	if (!digits) {
+		*bits = 0;
+		return parse_finish(used, src, src, PARSE_INVALID);
+	}
+	d = p;
+	if (p < end && (*p | 0x20) == 'e') {
+		const char *q = p + 1;
+		bool eneg = false;
+		if (q < end && (*q == '-' || *q == '+'))
+			eneg = *q++ == '-';
+		if (q < end && parse_digit(*q) < 10) {
+			for (; q < end && (c = parse_digit(*q)) < 10; ++q)
+				if (ex < 100000000)
+					ex = ex * 10 + c;
+			if (eneg)
+				ex = -ex;
+			e += ex;
+			p = q;
+		}
+	}
+
+	*bits = parse_lemire(w, e, f);
+	if (trunc && parse_lemire(w + 1, e, f) != *bits)
+		*bits = parse_slow(m, d, ex, f);
+	if (*bits == (u64) f->inf << f->mbits) {
+		*bits |= sign;
+		return parse_finish(used, src, p, PARSE_OVERFLOW);
+	}
+	*bits |= sign;
+	return parse_finish(used, src, p, PARSE_OK);
+}
+
+u32 parse_f64(f64 *v, size_t *used, const char *src, size_t size) {
+	u64 bits;
+	u32 err = parse_float(&bits, used, src, size, &PARSE_F64);
+	memcpy(v, &bits, sizeof *v);
+	return err;
+}
+
+u32 parse_f32(f32 *v, size_t *used, const char *src, size_t size) {
+	u64 bits;
+	u32 err = parse_float(&bits, used, src, size, &PARSE_F32);
+	u32 b = (u32) bits;
+	memcpy(v, &b, sizeof *v);
+	return err;
+}
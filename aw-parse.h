@@ -0,0 +1,87 @@
+
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+#ifndef AW_PARSE_H
+#define AW_PARSE_H
+
+#include "aw-types.h"
+
+#include <stddef.h>
+
+#if defined(_parse_dllexport)
+# if defined(_MSC_VER)
+#  define _parse_api extern __declspec(dllexport)
+# elif defined(__GNUC__)
+#  define _parse_api __attribute__((visibility("default"))) extern
+# endif
+#elif defined(_parse_dllimport)
+# if defined(_MSC_VER)
+#  define _parse_api extern __declspec(dllimport)
+# endif
+#endif
+#ifndef _parse_api
+# define _parse_api extern
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+	PARSE_OK,
+	PARSE_INVALID,
+	PARSE_OVERFLOW,
+};
+
+/* Parsers read a number from the start of src[0..size), which needs no
+   terminator, and return an error code. *used receives the bytes consumed
+   and may be NULL. Nothing is skipped before the number: no whitespace and
+   no locale. An invalid input consumes nothing and stores zero. A number
+   out of range consumes all its digits, stores the nearest representable
+   value and returns PARSE_OVERFLOW.
+
+   Decimal integers take an optional '+', and the signed ones also '-'. Hex
+   takes an optional 0x or 0X prefix. Eight digits at a time are converted in a
+   64-bit register. */
+_parse_api u32 parse_u32(u32 *v, size_t *used, const char *src, size_t size);
+_parse_api u32 parse_s32(s32 *v, size_t *used, const char *src, size_t size);
+_parse_api u32 parse_u64(u64 *v, size_t *used, const char *src, size_t size);
+_parse_api u32 parse_s64(s64 *v, size_t *used, const char *src, size_t size);
+_parse_api u32 parse_x32(u32 *v, size_t *used, const char *src, size_t size);
+_parse_api u32 parse_x64(u64 *v, size_t *used, const char *src, size_t size);
+
+/* Floats take [+-]digits[.digits][(e|E)[+-]digits], either side of the
+   point may be empty but not both, and inf, infinity and nan in any case.
+   They round correctly to nearest even: the Eisel-Lemire algorithm settles
+   all inputs with up to 19 significant digits, and longer ones unless they
+   are within an ulp of a tie, which go to strtod. Results too large for
+   the type are infinite with PARSE_OVERFLOW. */
+_parse_api u32 parse_f32(f32 *v, size_t *used, const char *src, size_t size);
+_parse_api u32 parse_f64(f64 *v, size_t *used, const char *src, size_t size);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* AW_PARSE_H */
+
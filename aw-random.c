@@ -0,0 +1,303 @@
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+
+#include "aw-random.h"
+#include "aw-cpu.h"
+
+#include <string.h>
+
+static const u64 XOSHIRO256_JUMP[4] = {
+	imm_u64(0x180ec6d33cfd0aba), imm_u64(0xd5a61266f0c9392c),
+	imm_u64(0xa9582618e03fc9aa), imm_u64(0x39abdc4529b1661c),
+};
+
+static const u64 XOSHIRO256_LONG_JUMP[4] = {
+	imm_u64(0x76e15d3efefdcbbf), imm_u64(0xc5004e441c522fb3),
+	imm_u64(0x77710069854ee241), imm_u64(0x39109bb02acbe635),
+};
+
+/* 2^64 and 2^96 steps of xoshiro128. */
+static const u32 XOSHIRO128_JUMP[4] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+static const u32 XOSHIRO128_LONG_JUMP[4] = { 0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662 };
+
+/* A jump adds up the states at the steps picked by the bits of the jump
+   polynomial, which lands on the state that many steps ahead. */
+static void xoshiro256_jump_by(struct xoshiro256 *g, const u64 *poly) {
+	u64 t[4] = { 0, 0, 0, 0 };
+	u32 i, b, k;
+	for (i = 0; i < 4; ++i)
+		for (b = 0; b < 64; ++b) {
+			if (poly[i] >> b & 1)
+				for (k = 0; k < 4; ++k)
+					t[k] ^= g->s[k];
+			xoshiro256_next(g);
+		}
+	memcpy(g->s, t, sizeof t);
+}
+
+void xoshiro256_jump(struct xoshiro256 *g) { xoshiro256_jump_by(g, XOSHIRO256_JUMP); }
+void xoshiro256_long_jump(struct xoshiro256 *g) { xoshiro256_jump_by(g, XOSHIRO256_LONG_JUMP); }
+
+/* Composes delta steps of the LCG by squaring (Brown, "Random Number
+   Generation with Arbitrary Strides"). */
+void pcg32_advance(struct pcg32 *g, u64 delta) {
+	u64 mul = imm_u64(6364136223846793005), add = g->inc;
+	u64 acc_mul = 1, acc_add = 0;
+	for (; delta != 0; delta >>= 1) {
+		if (delta & 1) {
+			acc_mul *= mul;
+			acc_add = acc_add * mul + add;
+		}
+		add *= mul + 1;
+		mul *= mul;
+	}
+	g->state = acc_mul * g->state + acc_add;
+}
+
+/*
+ * Interleaved xoshiro128**
+ *
+ * State word i of lane k is s[i * lanes + k].
+ */
+
+static u32 xoshiro128_lane_next(u32 *s, size_t lanes, size_t k) {
+	u32 s0 = s[k], s1 = s[lanes + k], s2 = s[lanes * 2 + k], s3 = s[lanes * 3 + k];
+	u32 r = s1 * 5, t = s1 << 9;
+	r = (r << 7 | r >> 25) * 9;
+	s2 ^= s0;
+	s3 ^= s1;
+	s1 ^= s2;
+	s0 ^= s3;
+	s2 ^= t;
+	s3 = s3 << 11 | s3 >> 21;
+	s[k] = s0;
+	s[lanes + k] = s1;
+	s[lanes * 2 + k] = s2;
+	s[lanes * 3 + k] = s3;
+	return r;
+}
+
+static void xoshiro128_lane_jump(u32 *s, size_t lanes, size_t k, const u32 *poly) {
+	u32 t[4] = { 0, 0, 0, 0 };
+	u32 i, b, j;
+	for (i = 0; i < 4; ++i)
+		for (b = 0; b < 32; ++b) {
+			if (poly[i] >> b & 1)
+				for (j = 0; j < 4; ++j)
+					t[j] ^= s[lanes * j + k];
+			xoshiro128_lane_next(s, lanes, k);
+		}
+	for (j = 0; j < 4; ++j)
+		s[lanes * j + k] = t[j];
+}
+
+static void xoshiro128_seed(u32 *s, size_t lanes, u64 seed) {
+	u64 a = splitmix64(&seed), b = splitmix64(&seed);
+	size_t i, k;
+	s[0] = (u32) a;
+	s[lanes] = (u32) (a >> 32);
+	s[lanes * 2] = (u32) b;
+	s[lanes * 3] = (u32) (b >> 32);
+	for (k = 1; k < lanes; ++k) {
+		for (i = 0; i < 4; ++i)
+			s[lanes * i + k] = s[lanes * i + k - 1];
+		xoshiro128_lane_jump(s, lanes, k, XOSHIRO128_JUMP);
+	}
+}
+
+static void xoshiro128_jump(u32 *s, size_t lanes) {
+	size_t k;
+	for (k = 0; k < lanes; ++k)
+		xoshiro128_lane_jump(s, lanes, k, XOSHIRO128_LONG_JUMP);
+}
+
+/* Kernels write count values as u32 or, when real is set, as f32 in
+   [0, 1). */
+typedef void (*xoshiro128_fill_fn)(u32 *s, size_t lanes, void *dst, size_t count, bool real);
+
+_random_alwaysinline static u32 xoshiro128_float_bits(u32 r) {
+	f32 f = random_f32(r);
+	u32 u;
+	memcpy(&u, &f, sizeof u);
+	return u;
+}
+
+#if !defined(_have_simd_ops)
+static void xoshiro128_fill_scalar(u32 *s, size_t lanes, void *dst, size_t count, bool real) {
+	u32 *p = (u32 *) dst;
+	size_t i, k;
+	for (i = 0; i < count; i += lanes)
+		for (k = 0; k < lanes; ++k) {
+			u32 r = xoshiro128_lane_next(s, lanes, k);
+			if (i + k < count)
+				p[i + k] = real ? xoshiro128_float_bits(r) : r;
+		}
+}
+#else
+_random_alwaysinline static u32x4 xoshiro128_float_u32x4(u32x4 r) {
+	return f32x4_to_bits(mul_f32x4(s32x4_to_f32x4(srl_u32x4(r, 8)), set1_f32x4(1.f / 16777216.f)));
+}
+
+/* lanes is 4 or 8; the vectors for lanes 4 to 7 follow those for 0 to 3. */
+static void xoshiro128_fill_u32x4(u32 *s, size_t lanes, void *dst, size_t count, bool real) {
+	u32x4 v[2][4];
+	u32 tmp[8], *p = (u32 *) dst;
+	size_t n = lanes / 4, i, j, k;
+	for (j = 0; j < n; ++j)
+		for (k = 0; k < 4; ++k)
+			v[j][k] = loadu_u32x4(s + lanes * k + j * 4);
+	for (i = 0; i + lanes <= count; i += lanes)
+		for (j = 0; j < n; ++j) {
+			u32x4 r = xoshiro128_step_u32x4(v[j]);
+			storeu_u32x4(p + i + j * 4, real ? xoshiro128_float_u32x4(r) : r);
+		}
+	if (i < count) {
+		for (j = 0; j < n; ++j) {
+			u32x4 r = xoshiro128_step_u32x4(v[j]);
+			storeu_u32x4(tmp + j * 4, real ? xoshiro128_float_u32x4(r) : r);
+		}
+		memcpy(p + i, tmp, (count - i) * sizeof *p);
+	}
+	for (j = 0; j < n; ++j)
+		for (k = 0; k < 4; ++k)
+			storeu_u32x4(s + lanes * k + j * 4, v[j][k]);
+}
+#endif
+
+#if defined(_cpu_dispatch_x86)
+_cpu_target("avx2")
+_random_alwaysinline static __m256i xoshiro128_step_avx2(__m256i *s) {
+	__m256i r = _mm256_add_epi32(_mm256_slli_epi32(s[1], 2), s[1]);
+	__m256i t = _mm256_slli_epi32(s[1], 9);
+	r = _mm256_or_si256(_mm256_slli_epi32(r, 7), _mm256_srli_epi32(r, 25));
+	r = _mm256_add_epi32(_mm256_slli_epi32(r, 3), r);
+	s[2] = _mm256_xor_si256(s[2], s[0]);
+	s[3] = _mm256_xor_si256(s[3], s[1]);
+	s[1] = _mm256_xor_si256(s[1], s[2]);
+	s[0] = _mm256_xor_si256(s[0], s[3]);
+	s[2] = _mm256_xor_si256(s[2], t);
+	s[3] = _mm256_or_si256(_mm256_slli_epi32(s[3], 11), _mm256_srli_epi32(s[3], 21));
+	return r;
+}
+
+_cpu_target("avx2")
+_random_alwaysinline static __m256i xoshiro128_float_avx2(__m256i r) {
+	return _mm256_castps_si256(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(r, 8)), _mm256_set1_ps(1.f / 16777216.f)));
+}
+
+/* Two independent steps per iteration hide the latency of the chain. */
+_cpu_target("avx2")
+static void xoshiro128_fill_avx2(u32 *s, size_t lanes, void *dst, size_t count, bool real) {
+	__m256i v[4];
+	u32 tmp[8], *p = (u32 *) dst;
+	size_t i, k;
+	if (lanes != 8) {
+		xoshiro128_fill_u32x4(s, lanes, dst, count, real);
+		return;
+	}
+	for (k = 0; k < 4; ++k)
+		v[k] = _mm256_loadu_si256((const __m256i *) (s + 8 * k));
+	for (i = 0; i + 16 <= count; i += 16) {
+		__m256i a = xoshiro128_step_avx2(v);
+		__m256i b = xoshiro128_step_avx2(v);
+		if (real) {
+			a = xoshiro128_float_avx2(a);
+			b = xoshiro128_float_avx2(b);
+		}
+		_mm256_storeu_si256((__m256i *) (p + i), a);
+		_mm256_storeu_si256((__m256i *) (p + i + 8), b);
+	}
+	for (; i < count; i += 8) {
+		__m256i r = xoshiro128_step_avx2(v);
+		if (real)
+			r = xoshiro128_float_avx2(r);
+		if (i + 8 <= count)
+			_mm256_storeu_si256((__m256i *) (p + i), r);
+		else {
+			_mm256_storeu_si256((__m256i *) tmp, r);
+			memcpy(p + i, tmp, (count - i) * sizeof *p);
+		}
+	}
+	for (k = 0; k < 4; ++k)
+		_mm256_storeu_si256((__m256i *) (s + 8 * k), v[k]);
+}
+
+static void xoshiro128_fill_resolve(u32 *s, size_t lanes, void *dst, size_t count, bool real);
+static _cpu_ptr(xoshiro128_fill_fn) xoshiro128_fill_ptr = xoshiro128_fill_resolve;
+#define xoshiro128_fill _cpu_load_ptr(xoshiro128_fill_ptr)
+
+static void xoshiro128_fill_resolve(u32 *s, size_t lanes, void *dst, size_t count, bool real) {
+	xoshiro128_fill_fn fn = xoshiro128_fill_u32x4;
+	if (cpu_has(CPU_AVX2))
+		fn = xoshiro128_fill_avx2;
+	_cpu_store_ptr(xoshiro128_fill_ptr, fn);
+	fn(s, lanes, dst, count, real);
+}
+#elif defined(_have_simd_ops)
+# define xoshiro128_fill xoshiro128_fill_u32x4
+#else
+# define xoshiro128_fill xoshiro128_fill_scalar
+#endif
+
+/* Lemire's multiply-shift over the u32 sequence. A first pass only looks
+   for rejections, which are rare unless n is large; when there are some they
+   are squeezed out and the tail filled again. */
+static void xoshiro128_fill_below(u32 *s, size_t lanes, u32 *dst, size_t count, u32 n) {
+	size_t done = 0, i;
+	u32 t;
+	if (n == 0) {
+		memset(dst, 0, count * sizeof *dst);
+		return;
+	}
+	t = (0 - n) % n;
+	while (done < count) {
+		size_t j = done;
+		u32 rejected = 0;
+		xoshiro128_fill(s, lanes, dst + done, count - done, false);
+		for (i = done; i < count; ++i)
+			rejected |= (u32) ((u64) dst[i] * n) < t;
+		if (rejected == 0) {
+			for (i = done; i < count; ++i)
+				dst[i] = (u32) ((u64) dst[i] * n >> 32);
+			return;
+		}
+		for (i = done; i < count; ++i) {
+			u64 m = (u64) dst[i] * n;
+			dst[j] = (u32) (m >> 32);
+			j += (u32) m >= t;
+		}
+		done = j;
+	}
+}
+
+void xoshiro128x4_seed(struct xoshiro128x4 *g, u64 seed) { xoshiro128_seed(g->s[0], 4, seed); }
+void xoshiro128x4_jump(struct xoshiro128x4 *g) { xoshiro128_jump(g->s[0], 4); }
+void xoshiro128x4_fill_u32(struct xoshiro128x4 *g, u32 *dst, size_t count) { xoshiro128_fill(g->s[0], 4, dst, count, false); }
+void xoshiro128x4_fill_below(struct xoshiro128x4 *g, u32 *dst, size_t count, u32 n) { xoshiro128_fill_below(g->s[0], 4, dst, count, n); }
+void xoshiro128x4_fill_f32(struct xoshiro128x4 *g, f32 *dst, size_t count) { xoshiro128_fill(g->s[0], 4, dst, count, true); }
+
+void xoshiro128x8_seed(struct xoshiro128x8 *g, u64 seed) { xoshiro128_seed(g->s[0], 8, seed); }
+void xoshiro128x8_jump(struct xoshiro128x8 *g) { xoshiro128_jump(g->s[0], 8); }
+void xoshiro128x8_fill_u32(struct xoshiro128x8 *g, u32 *dst, size_t count) { xoshiro128_fill(g->s[0], 8, dst, count, false); }
+void xoshiro128x8_fill_below(struct xoshiro128x8 *g, u32 *dst, size_t count, u32 n) { xoshiro128_fill_below(g->s[0], 8, dst, count, n); }
+void xoshiro128x8_fill_f32(struct xoshiro128x8 *g, f32 *dst, size_t count) { xoshiro128_fill(g->s[0], 8, dst, count, true); }
@@ -0,0 +1,295 @@
+
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+#ifndef AW_RANDOM_H
+#define AW_RANDOM_H
+
+#include "aw-arith.h"
+#include "aw-simd.h"
+
+#include <stddef.h>
+
+#if defined(_random_dllexport)
+# if defined(_MSC_VER)
+#  define _random_api extern __declspec(dllexport)
+# elif defined(__GNUC__)
+#  define _random_api __attribute__((visibility("default"))) extern
+# endif
+#elif defined(_random_dllimport)
+# if defined(_MSC_VER)
+#  define _random_api extern __declspec(dllimport)
+# endif
+#endif
+#ifndef _random_api
+# define _random_api extern
+#endif
+
+#if defined(__GNUC__)
+# define _random_alwaysinline __attribute__((always_inline)) inline
+# define _random_unlikely(x) __builtin_expect(!!(x), 0)
+#elif defined(_MSC_VER)
+# define _random_alwaysinline __forceinline
+# define _random_unlikely(x) (x)
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Generators keep all their state in the struct, so each thread owns its
+   own and nothing is shared. None of them are fit for cryptography.
+
+   xoshiro256** (Blackman and Vigna) has a period of 2^256 - 1 and jump
+   functions that advance it by 2^128 or 2^192 outputs, which splits one
+   seed into non-overlapping streams for workers. pcg32 (O'Neill) yields
+   32 bits from 64 bits of state, has 2^63 selectable streams and can
+   advance by any distance in logarithmic time. wyrand (Wang Yi) is a
+   64-bit counter hashed by one wide multiply, the fastest of the three
+   where that multiply is cheap. Seeding goes through splitmix64, so any
+   seed, including 0, gives a good state. */
+struct xoshiro256 {
+	u64 s[4];
+};
+
+struct pcg32 {
+	u64 state;
+	u64 inc;
+};
+
+struct wyrand {
+	u64 s;
+};
+
+_random_alwaysinline static u64 splitmix64(u64 *s) {
+	u64 z = (*s += imm_u64(0x9e3779b97f4a7c15));
+	z = (z ^ (z >> 30)) * imm_u64(0xbf58476d1ce4e5b9);
+	z = (z ^ (z >> 27)) * imm_u64(0x94d049bb133111eb);
+	return z ^ (z >> 31);
+}
+
+/* Uniform floats in [0, 1) from the top 24 or 53 bits, so every value is
+   a multiple of 2^-24 or 2^-53 and 1 is never reached. */
+_random_alwaysinline static f32 random_f32(u32 bits) { return (f32) (bits >> 8) * (1.f / 16777216.f); }
+_random_alwaysinline static f64 random_f64(u64 bits) { return (f64) (bits >> 11) * (1. / 9007199254740992.); }
+
+_random_alwaysinline static void xoshiro256_seed(struct xoshiro256 *g, u64 seed) {
+	g->s[0] = splitmix64(&seed);
+	g->s[1] = splitmix64(&seed);
+	g->s[2] = splitmix64(&seed);
+	g->s[3] = splitmix64(&seed);
+}
+
+_random_alwaysinline static u64 xoshiro256_next(struct xoshiro256 *g) {
+	u64 *s = g->s;
+	u64 r = s[1] * 5, t = s[1] << 17;
+	r = (r << 7 | r >> 57) * 9;
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = s[3] << 45 | s[3] >> 19;
+	return r;
+}
+
+/* Advance by 2^128 and 2^192 outputs. Splitting copies the generator to
+   child and jumps the parent past everything the child can use. */
+_random_api void xoshiro256_jump(struct xoshiro256 *g);
+_random_api void xoshiro256_long_jump(struct xoshiro256 *g);
+
+_random_alwaysinline static void xoshiro256_split(struct xoshiro256 *child, struct xoshiro256 *g) {
+	*child = *g;
+	xoshiro256_jump(g);
+}
+
+/* The stream is chosen by the low 63 bits of seq. */
+_random_alwaysinline static void pcg32_seed(struct pcg32 *g, u64 seed, u64 seq) {
+	g->state = 0;
+	g->inc = seq << 1 | 1;
+	g->state = g->state * imm_u64(6364136223846793005) + g->inc;
+	g->state += seed;
+	g->state = g->state * imm_u64(6364136223846793005) + g->inc;
+}
+
+_random_alwaysinline static u32 pcg32_next(struct pcg32 *g) {
+	u64 s = g->state;
+	u32 x = (u32) (((s >> 18) ^ s) >> 27), r = (u32) (s >> 59);
+	g->state = s * imm_u64(6364136223846793005) + g->inc;
+	return x >> r | x << ((32 - r) & 31);
+}
+
+/* Moves the generator delta outputs ahead; a negative delta cast to u64
+   moves it back. */
+_random_api void pcg32_advance(struct pcg32 *g, u64 delta);
+
+/* Starts child on the stream and position picked by the parent's next
+   outputs. */
+_random_alwaysinline static void pcg32_split(struct pcg32 *child, struct pcg32 *g) {
+	u64 seed = (u64) pcg32_next(g) << 32, seq;
+	seed |= pcg32_next(g);
+	seq = (u64) pcg32_next(g) << 32;
+	seq |= pcg32_next(g);
+	pcg32_seed(child, seed, seq);
+}
+
+_random_alwaysinline static void wyrand_seed(struct wyrand *g, u64 seed) { g->s = splitmix64(&seed); }
+
+_random_alwaysinline static u64 wyrand_next(struct wyrand *g) {
+	u64 s = g->s += imm_u64(0xa0761d6478bd642f), lo, hi = mulwide_u64(s, s ^ imm_u64(0xe7037ed1a0b428db), &lo);
+	return hi ^ lo;
+}
+
+_random_alwaysinline static void wyrand_split(struct wyrand *child, struct wyrand *g) { wyrand_seed(child, wyrand_next(g)); }
+
+/* Integers in [0, n) without modulo bias (Lemire): the high half of a
+   random number times n, drawing again in the rare case that the low half
+   falls where some results would be over-represented. Bounds of 0 yield
+   0. */
+_random_alwaysinline static u64 xoshiro256_below(struct xoshiro256 *g, u64 n) {
+	u64 lo, hi = mulwide_u64(xoshiro256_next(g), n, &lo);
+	if (_random_unlikely(lo < n)) {
+		u64 t = (0 - n) % n;
+		while (lo < t)
+			hi = mulwide_u64(xoshiro256_next(g), n, &lo);
+	}
+	return hi;
+}
+
+_random_alwaysinline static u32 pcg32_below(struct pcg32 *g, u32 n) {
+	u64 m = (u64) pcg32_next(g) * n;
+	if (_random_unlikely((u32) m < n)) {
+		u32 t = (0 - n) % n;
+		while ((u32) m < t)
+			m = (u64) pcg32_next(g) * n;
+	}
+	return (u32) (m >> 32);
+}
+
+_random_alwaysinline static u64 wyrand_below(struct wyrand *g, u64 n) {
+	u64 lo, hi = mulwide_u64(wyrand_next(g), n, &lo);
+	if (_random_unlikely(lo < n)) {
+		u64 t = (0 - n) % n;
+		while (lo < t)
+			hi = mulwide_u64(wyrand_next(g), n, &lo);
+	}
+	return hi;
+}
+
+_random_alwaysinline static f32 xoshiro256_f32(struct xoshiro256 *g) { return random_f32((u32) (xoshiro256_next(g) >> 32)); }
+_random_alwaysinline static f64 xoshiro256_f64(struct xoshiro256 *g) { return random_f64(xoshiro256_next(g)); }
+_random_alwaysinline static f32 pcg32_f32(struct pcg32 *g) { return random_f32(pcg32_next(g)); }
+_random_alwaysinline static f64 pcg32_f64(struct pcg32 *g) { u64 hi = pcg32_next(g); return random_f64(hi << 32 | pcg32_next(g)); }
+_random_alwaysinline static f32 wyrand_f32(struct wyrand *g) { return random_f32((u32) (wyrand_next(g) >> 32)); }
+_random_alwaysinline static f64 wyrand_f64(struct wyrand *g) { return random_f64(wyrand_next(g)); }
+
+/* Four or eight interleaved xoshiro128** generators (32-bit words, period
+   2^128 - 1), one per vector lane. Seeding starts lane k 2^64 outputs
+   after lane k - 1, so the lanes never overlap; the jump moves every lane
+   on by 2^96, which gives each worker thread its own block of streams.
+
+   The fill functions write count values from consecutive steps, lane 0
+   first, and produce the same sequence whether they run on AVX2, SSE2,
+   NEON or plain C. A step only partly written is discarded. fill_below
+   maps that sequence to [0, n) with the same method as the scalar _below
+   functions, drops the rare values that would bias it and fills in from
+   further steps. */
+struct xoshiro128x4 {
+	u32 s[4][4];
+};
+
+struct xoshiro128x8 {
+	u32 s[4][8];
+};
+
+_random_api void xoshiro128x4_seed(struct xoshiro128x4 *g, u64 seed);
+_random_api void xoshiro128x4_jump(struct xoshiro128x4 *g);
+_random_api void xoshiro128x4_fill_u32(struct xoshiro128x4 *g, u32 *dst, size_t count);
+_random_api void xoshiro128x4_fill_below(struct xoshiro128x4 *g, u32 *dst, size_t count, u32 n);
+_random_api void xoshiro128x4_fill_f32(struct xoshiro128x4 *g, f32 *dst, size_t count);
+
+_random_api void xoshiro128x8_seed(struct xoshiro128x8 *g, u64 seed);
+_random_api void xoshiro128x8_jump(struct xoshiro128x8 *g);
+_random_api void xoshiro128x8_fill_u32(struct xoshiro128x8 *g, u32 *dst, size_t count);
+_random_api void xoshiro128x8_fill_below(struct xoshiro128x8 *g, u32 *dst, size_t count, u32 n);
+_random_api void xoshiro128x8_fill_f32(struct xoshiro128x8 *g, f32 *dst, size_t count);
+
+#if defined(_have_simd_ops)
+/* One step of all lanes, for use in vector code. */
+_random_alwaysinline static u32x4 xoshiro128_step_u32x4(u32x4 *s) {
+	u32x4 r = add_u32x4(sll_u32x4(s[1], 2), s[1]);
+	u32x4 t = sll_u32x4(s[1], 9);
+	r = or_u32x4(sll_u32x4(r, 7), srl_u32x4(r, 25));
+	r = add_u32x4(sll_u32x4(r, 3), r);
+	s[2] = xor_u32x4(s[2], s[0]);
+	s[3] = xor_u32x4(s[3], s[1]);
+	s[1] = xor_u32x4(s[1], s[2]);
+	s[0] = xor_u32x4(s[0], s[3]);
+	s[2] = xor_u32x4(s[2], t);
+	s[3] = or_u32x4(sll_u32x4(s[3], 11), srl_u32x4(s[3], 21));
+	return r;
+}
+
+_random_alwaysinline static u32x4 xoshiro128x4_next(struct xoshiro128x4 *g) {
+	u32x4 s[4], r;
+	u32 i;
+	for (i = 0; i < 4; ++i)
+		s[i] = loadu_u32x4(g->s[i]);
+	r = xoshiro128_step_u32x4(s);
+	for (i = 0; i < 4; ++i)
+		storeu_u32x4(g->s[i], s[i]);
+	return r;
+}
+#endif
+
+#if defined(_have_simd_ops_256) && defined(__AVX2__)
+_random_alwaysinline static u32x8 xoshiro128_step_u32x8(u32x8 *s) {
+	u32x8 r = add_u32x8(sll_u32x8(s[1], 2), s[1]);
+	u32x8 t = sll_u32x8(s[1], 9);
+	r = or_u32x8(sll_u32x8(r, 7), srl_u32x8(r, 25));
+	r = add_u32x8(sll_u32x8(r, 3), r);
+	s[2] = xor_u32x8(s[2], s[0]);
+	s[3] = xor_u32x8(s[3], s[1]);
+	s[1] = xor_u32x8(s[1], s[2]);
+	s[0] = xor_u32x8(s[0], s[3]);
+	s[2] = xor_u32x8(s[2], t);
+	s[3] = or_u32x8(sll_u32x8(s[3], 11), srl_u32x8(s[3], 21));
+	return r;
+}
+
+_random_alwaysinline static u32x8 xoshiro128x8_next(struct xoshiro128x8 *g) {
+	u32x8 s[4], r;
+	u32 i;
+	for (i = 0; i < 4; ++i)
+		s[i] = loadu_u32x8(g->s[i]);
+	r = xoshiro128_step_u32x8(s);
+	for (i = 0; i < 4; ++i)
+		storeu_u32x8(g->s[i], s[i]);
+	return r;
+}
+#endif
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* AW_RANDOM_H */
@@ -0,0 +1,640 @@
+
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+#ifndef AW_SIMD_H
+#define AW_SIMD_H
+
+#include "aw-types.h"
+
+#include <string.h>
+
+#if defined(__ARM_NEON) || defined(_M_ARM64) || defined(_M_ARM64EC)
+# include <arm_neon.h>
+#elif defined(__SPU__) || defined(__SPU)
+# include <spu_intrinsics.h>
+#elif defined(__PPU__) || defined(__ppc64__)
+# include <altivec.h>
+#endif
+
+#if defined(__GNUC__)
+# define _simd_alwaysinline __attribute__((always_inline)) inline
+#elif defined(_MSC_VER)
+# define _simd_alwaysinline __forceinline
+#endif
+
+#if defined(__SSE4_1__) || defined(__AVX__)
+# define _simd_sse41 1
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64) || defined(_M_ARM64EC)
+# define _simd_a64 1
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Lane-wise operations on f32x4 and u32x4, selected by the same target checks
+   that pick the types in aw-types.h. Comparisons return all-ones or all-zero
+   u32x4 lane masks for blend_*(). round_f32x4, trunc_f32x4, floor_f32x4 and
+   ceil_f32x4 return signed s32 lanes in a u32x4, s32x4_to_f32x4 converts them
+   back; round_f32x4 rounds halves to even on every target, like round_f32().
+   The loads and stores without a u suffix require 16-byte alignment. On
+   _M_PPC u32x4 is a plain array, which cannot be passed by value, so no
+   operations are defined there. */
+
+#if defined(__ARM_NEON) || defined(_M_ARM64) || defined(_M_ARM64EC)
+# define _have_simd_ops 1
+
+# if defined(_MSC_VER) && !defined(__clang__)
+#  define _simd_nu(a) (a)
+#  define _simd_nf(a) (a)
+#  define _simd_u(a) (a)
+#  define _simd_f(a) (a)
+# else
+#  define _simd_nu(a) ((uint32x4_t) (a))
+#  define _simd_nf(a) ((float32x4_t) (a))
+#  define _simd_u(a) ((u32x4) (a))
+#  define _simd_f(a) ((f32x4) (a))
+# endif
+
+_simd_alwaysinline static f32x4 zero_f32x4(void) { return _simd_f(vdupq_n_f32(0.f)); }
+_simd_alwaysinline static f32x4 set1_f32x4(f32 a) { return _simd_f(vdupq_n_f32(a)); }
+_simd_alwaysinline static f32x4 set_f32x4(f32 x, f32 y, f32 z, f32 w) { const f32 t[4] = {x, y, z, w}; return _simd_f(vld1q_f32(t)); }
+_simd_alwaysinline static f32x4 load_f32x4(const f32 *p) { return _simd_f(vld1q_f32(p)); }
+_simd_alwaysinline static f32x4 loadu_f32x4(const f32 *p) { return _simd_f(vld1q_f32(p)); }
+_simd_alwaysinline static void store_f32x4(f32 *p, f32x4 a) { vst1q_f32(p, _simd_nf(a)); }
+_simd_alwaysinline static void storeu_f32x4(f32 *p, f32x4 a) { vst1q_f32(p, _simd_nf(a)); }
+
+_simd_alwaysinline static u32x4 zero_u32x4(void) { return _simd_u(vdupq_n_u32(0)); }
+_simd_alwaysinline static u32x4 set1_u32x4(u32 a) { return _simd_u(vdupq_n_u32(a)); }
+_simd_alwaysinline static u32x4 set_u32x4(u32 x, u32 y, u32 z, u32 w) { const u32 t[4] = {x, y, z, w}; return _simd_u(vld1q_u32(t)); }
+_simd_alwaysinline static u32x4 load_u32x4(const u32 *p) { return _simd_u(vld1q_u32(p)); }
+_simd_alwaysinline static u32x4 loadu_u32x4(const u32 *p) { return _simd_u(vld1q_u32(p)); }
+_simd_alwaysinline static void store_u32x4(u32 *p, u32x4 a) { vst1q_u32(p, _simd_nu(a)); }
+_simd_alwaysinline static void storeu_u32x4(u32 *p, u32x4 a) { vst1q_u32(p, _simd_nu(a)); }
+
+_simd_alwaysinline static f32 lane0_f32x4(f32x4 a) { return vgetq_lane_f32(_simd_nf(a), 0); }
+_simd_alwaysinline static u32 lane0_u32x4(u32x4 a) { return vgetq_lane_u32(_simd_nu(a), 0); }
+
+_simd_alwaysinline static f32x4 bits_to_f32x4(u32x4 a) { return _simd_f(vreinterpretq_f32_u32(_simd_nu(a))); }
+_simd_alwaysinline static u32x4 f32x4_to_bits(f32x4 a) { return _simd_u(vreinterpretq_u32_f32(_simd_nf(a))); }
+
+_simd_alwaysinline static f32x4 add_f32x4(f32x4 a, f32x4 b) { return _simd_f(vaddq_f32(_simd_nf(a), _simd_nf(b))); }
+_simd_alwaysinline static f32x4 sub_f32x4(f32x4 a, f32x4 b) { return _simd_f(vsubq_f32(_simd_nf(a), _simd_nf(b))); }
+_simd_alwaysinline static f32x4 mul_f32x4(f32x4 a, f32x4 b) { return _simd_f(vmulq_f32(_simd_nf(a), _simd_nf(b))); }
+_simd_alwaysinline static f32x4 rcp_f32x4(f32x4 a) { return _simd_f(vrecpeq_f32(_simd_nf(a))); }
+_simd_alwaysinline static f32x4 rsqrt_f32x4(f32x4 a) { return _simd_f(vrsqrteq_f32(_simd_nf(a))); }
+# if defined(_simd_a64)
+_simd_alwaysinline static f32x4 div_f32x4(f32x4 a, f32x4 b) { return _simd_f(vdivq_f32(_simd_nf(a), _simd_nf(b))); }
+_simd_alwaysinline static f32x4 sqrt_f32x4(f32x4 a) { return _simd_f(vsqrtq_f32(_simd_nf(a))); }
+_simd_alwaysinline static f32x4 madd_f32x4(f32x4 a, f32x4 b, f32x4 c) { return _simd_f(vfmaq_f32(_simd_nf(c), _simd_nf(a), _simd_nf(b))); }
+# else
+_simd_alwaysinline static f32x4 div_f32x4(f32x4 a, f32x4 b) {
+	float32x4_t r = vrecpeq_f32(_simd_nf(b));
+	r = vmulq_f32(r, vrecpsq_f32(_simd_nf(b), r));
+	r = vmulq_f32(r, vrecpsq_f32(_simd_nf(b), r));
+	return _simd_f(vmulq_f32(_simd_nf(a), r));
+}
+_simd_alwaysinline static f32x4 sqrt_f32x4(f32x4 a) {
+	float32x4_t x = _simd_nf(a);
+	float32x4_t r = vrsqrteq_f32(x);
+	r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(x, r), r));
+	r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(x, r), r));
+	return _simd_f(vbslq_f32(vceqq_f32(x, vdupq_n_f32(0.f)), x, vmulq_f32(x, r)));
+}
+_simd_alwaysinline static f32x4 madd_f32x4(f32x4 a, f32x4 b, f32x4 c) { return _simd_f(vmlaq_f32(_simd_nf(c), _simd_nf(a), _simd_nf(b))); }
+# endif
+_simd_alwaysinline static f32x4 neg_f32x4(f32x4 a) { return _simd_f(vnegq_f32(_simd_nf(a))); }
+_simd_alwaysinline static f32x4 abs_f32x4(f32x4 a) { return _simd_f(vabsq_f32(_simd_nf(a))); }
+_simd_alwaysinline static f32x4 min_f32x4(f32x4 a, f32x4 b) { return _simd_f(vminq_f32(_simd_nf(a), _simd_nf(b))); }
+_simd_alwaysinline static f32x4 max_f32x4(f32x4 a, f32x4 b) { return _simd_f(vmaxq_f32(_simd_nf(a), _simd_nf(b))); }
+
+_simd_alwaysinline static u32x4 add_u32x4(u32x4 a, u32x4 b) { return _simd_u(vaddq_u32(_simd_nu(a), _simd_nu(b))); }
+_simd_alwaysinline static u32x4 sub_u32x4(u32x4 a, u32x4 b) { return _simd_u(vsubq_u32(_simd_nu(a), _simd_nu(b))); }
+_simd_alwaysinline static u32x4 mul_u32x4(u32x4 a, u32x4 b) { return _simd_u(vmulq_u32(_simd_nu(a), _simd_nu(b))); }
+_simd_alwaysinline static u32x4 and_u32x4(u32x4 a, u32x4 b) { return _simd_u(vandq_u32(_simd_nu(a), _simd_nu(b))); }
+_simd_alwaysinline static u32x4 or_u32x4(u32x4 a, u32x4 b) { return _simd_u(vorrq_u32(_simd_nu(a), _simd_nu(b))); }
+_simd_alwaysinline static u32x4 xor_u32x4(u32x4 a, u32x4 b) { return _simd_u(veorq_u32(_simd_nu(a), _simd_nu(b))); }
+_simd_alwaysinline static u32x4 andnot_u32x4(u32x4 a, u32x4 b) { return _simd_u(vbicq_u32(_simd_nu(a), _simd_nu(b))); }
+_simd_alwaysinline static u32x4 sll_u32x4(u32x4 a, s32 n) { return _simd_u(vshlq_u32(_simd_nu(a), vdupq_n_s32(n))); }
+_simd_alwaysinline static u32x4 srl_u32x4(u32x4 a, s32 n) { return _simd_u(vshlq_u32(_simd_nu(a), vdupq_n_s32(-n))); }
+_simd_alwaysinline static u32x4 sra_u32x4(u32x4 a, s32 n) {
+	return _simd_u(vreinterpretq_u32_s32(vshlq_s32(vreinterpretq_s32_u32(_simd_nu(a)), vdupq_n_s32(-n))));
+}
+_simd_alwaysinline static u32x4 min_u32x4(u32x4 a, u32x4 b) { return _simd_u(vminq_u32(_simd_nu(a), _simd_nu(b))); }
+_simd_alwaysinline static u32x4 max_u32x4(u32x4 a, u32x4 b) { return _simd_u(vmaxq_u32(_simd_nu(a), _simd_nu(b))); }
+
+_simd_alwaysinline static u32x4 cmpeq_f32x4(f32x4 a, f32x4 b) { return _simd_u(vceqq_f32(_simd_nf(a), _simd_nf(b))); }
+_simd_alwaysinline static u32x4 cmpgt_f32x4(f32x4 a, f32x4 b) { return _simd_u(vcgtq_f32(_simd_nf(a), _simd_nf(b))); }
+_simd_alwaysinline static u32x4 cmpge_f32x4(f32x4 a, f32x4 b) { return _simd_u(vcgeq_f32(_simd_nf(a), _simd_nf(b))); }
+_simd_alwaysinline static u32x4 cmpeq_u32x4(u32x4 a, u32x4 b) { return _simd_u(vceqq_u32(_simd_nu(a), _simd_nu(b))); }
+_simd_alwaysinline static u32x4 cmpgt_u32x4(u32x4 a, u32x4 b) { return _simd_u(vcgtq_u32(_simd_nu(a), _simd_nu(b))); }
+
+_simd_alwaysinline static f32x4 blend_f32x4(u32x4 m, f32x4 a, f32x4 b) { return _simd_f(vbslq_f32(_simd_nu(m), _simd_nf(a), _simd_nf(b))); }
+_simd_alwaysinline static u32x4 blend_u32x4(u32x4 m, u32x4 a, u32x4 b) { return _simd_u(vbslq_u32(_simd_nu(m), _simd_nu(a), _simd_nu(b))); }
+
+_simd_alwaysinline static u32 movemask_u32x4(u32x4 m) {
+	static const s32 shifts[4] = {0, 1, 2, 3};
+	uint32x4_t b = vshlq_u32(vshrq_n_u32(_simd_nu(m), 31), vld1q_s32(shifts));
+# if defined(_simd_a64)
+	return vaddvq_u32(b);
+# else
+	uint32x2_t h = vadd_u32(vget_low_u32(b), vget_high_u32(b));
+	return vget_lane_u32(vpadd_u32(h, h), 0);
+# endif
+}
+
+_simd_alwaysinline static u32x4 trunc_f32x4(f32x4 a) { return _simd_u(vreinterpretq_u32_s32(vcvtq_s32_f32(_simd_nf(a)))); }
+# if defined(_simd_a64)
+_simd_alwaysinline static u32x4 round_f32x4(f32x4 a) { return _simd_u(vreinterpretq_u32_s32(vcvtnq_s32_f32(_simd_nf(a)))); }
+#  define _have_simd_floor 1
+_simd_alwaysinline static u32x4 floor_f32x4(f32x4 a) { return _simd_u(vreinterpretq_u32_s32(vcvtmq_s32_f32(_simd_nf(a)))); }
+_simd_alwaysinline static u32x4 ceil_f32x4(f32x4 a) { return _simd_u(vreinterpretq_u32_s32(vcvtpq_s32_f32(_simd_nf(a)))); }
+# else
+/* Adding 2^23 with the sign of a leaves no fraction bits, so NEON's fixed
+   round-to-nearest mode rounds ties to even as the other targets do. Larger
+   values are whole already. */
+_simd_alwaysinline static u32x4 round_f32x4(f32x4 a) {
+	float32x4_t x = _simd_nf(a);
+	float32x4_t m = vreinterpretq_f32_u32(vorrq_u32(vandq_u32(vreinterpretq_u32_f32(x),
+		vdupq_n_u32(0x80000000u)), vdupq_n_u32(0x4b000000u)));
+	float32x4_t r = vbslq_f32(vcageq_f32(x, vdupq_n_f32(8388608.f)), x, vsubq_f32(vaddq_f32(x, m), m));
+	return _simd_u(vreinterpretq_u32_s32(vcvtq_s32_f32(r)));
+}
+# endif
+_simd_alwaysinline static f32x4 s32x4_to_f32x4(u32x4 a) { return _simd_f(vcvtq_f32_s32(vreinterpretq_s32_u32(_simd_nu(a)))); }
+
+# if defined(_MSC_VER) && !defined(__clang__)
+_simd_alwaysinline static uint8x16_t _simd_shuffle_index(int x, int y, int z, int w) {
+	const u8 t[16] = {
+		(u8) (x * 4), (u8) (x * 4 + 1), (u8) (x * 4 + 2), (u8) (x * 4 + 3),
+		(u8) (y * 4), (u8) (y * 4 + 1), (u8) (y * 4 + 2), (u8) (y * 4 + 3),
+		(u8) (z * 4), (u8) (z * 4 + 1), (u8) (z * 4 + 2), (u8) (z * 4 + 3),
+		(u8) (w * 4), (u8) (w * 4 + 1), (u8) (w * 4 + 2), (u8) (w * 4 + 3),
+	};
+	return vld1q_u8(t);
+}
+#  define shuffle_f32x4(a,x,y,z,w) vreinterpretq_f32_u8(vqtbl1q_u8(vreinterpretq_u8_f32(a), _simd_shuffle_index(x, y, z, w)))
+#  define shuffle_u32x4(a,x,y,z,w) vreinterpretq_u32_u8(vqtbl1q_u8(vreinterpretq_u8_u32(a), _simd_shuffle_index(x, y, z, w)))
+# elif defined(__clang__)
+#  define shuffle_f32x4(a,x,y,z,w) ((f32x4) __builtin_shufflevector((f32x4) (a), (f32x4) (a), x, y, z, w))
+#  define shuffle_u32x4(a,x,y,z,w) ((u32x4) __builtin_shufflevector((u32x4) (a), (u32x4) (a), x, y, z, w))
+# else
+#  define shuffle_f32x4(a,x,y,z,w) ((f32x4) __builtin_shuffle((f32x4) (a), (u32x4) {x, y, z, w}))
+#  define shuffle_u32x4(a,x,y,z,w) ((u32x4) __builtin_shuffle((u32x4) (a), (u32x4) {x, y, z, w}))
+# endif
+
+# if defined(_simd_a64)
+#  define _have_simd_hadd 1
+_simd_alwaysinline static f32 hadd_f32x4(f32x4 a) { return vaddvq_f32(_simd_nf(a)); }
+_simd_alwaysinline static f32 hmin_f32x4(f32x4 a) { return vminvq_f32(_simd_nf(a)); }
+_simd_alwaysinline static f32 hmax_f32x4(f32x4 a) { return vmaxvq_f32(_simd_nf(a)); }
+_simd_alwaysinline static u32 hadd_u32x4(u32x4 a) { return vaddvq_u32(_simd_nu(a)); }
+# endif
+
+#elif defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+# define _have_simd_ops 1
+
+_simd_alwaysinline static f32x4 zero_f32x4(void) { return _mm_setzero_ps(); }
+_simd_alwaysinline static f32x4 set1_f32x4(f32 a) { return _mm_set1_ps(a); }
+_simd_alwaysinline static f32x4 set_f32x4(f32 x, f32 y, f32 z, f32 w) { return _mm_setr_ps(x, y, z, w); }
+_simd_alwaysinline static f32x4 load_f32x4(const f32 *p) { return _mm_load_ps(p); }
+_simd_alwaysinline static f32x4 loadu_f32x4(const f32 *p) { return _mm_loadu_ps(p); }
+_simd_alwaysinline static void store_f32x4(f32 *p, f32x4 a) { _mm_store_ps(p, a); }
+_simd_alwaysinline static void storeu_f32x4(f32 *p, f32x4 a) { _mm_storeu_ps(p, a); }
+
+_simd_alwaysinline static u32x4 zero_u32x4(void) { return _mm_setzero_si128(); }
+_simd_alwaysinline static u32x4 set1_u32x4(u32 a) { return _mm_set1_epi32((int) a); }
+_simd_alwaysinline static u32x4 set_u32x4(u32 x, u32 y, u32 z, u32 w) { return _mm_setr_epi32((int) x, (int) y, (int) z, (int) w); }
+_simd_alwaysinline static u32x4 load_u32x4(const u32 *p) { return _mm_load_si128((const __m128i *) p); }
+_simd_alwaysinline static u32x4 loadu_u32x4(const u32 *p) { return _mm_loadu_si128((const __m128i *) p); }
+_simd_alwaysinline static void store_u32x4(u32 *p, u32x4 a) { _mm_store_si128((__m128i *) p, a); }
+_simd_alwaysinline static void storeu_u32x4(u32 *p, u32x4 a) { _mm_storeu_si128((__m128i *) p, a); }
+
+_simd_alwaysinline static f32 lane0_f32x4(f32x4 a) { return _mm_cvtss_f32(a); }
+_simd_alwaysinline static u32 lane0_u32x4(u32x4 a) { return (u32) _mm_cvtsi128_si32(a); }
+
+_simd_alwaysinline static f32x4 bits_to_f32x4(u32x4 a) { return _mm_castsi128_ps(a); }
+_simd_alwaysinline static u32x4 f32x4_to_bits(f32x4 a) { return _mm_castps_si128(a); }
+
+_simd_alwaysinline static f32x4 add_f32x4(f32x4 a, f32x4 b) { return _mm_add_ps(a, b); }
+_simd_alwaysinline static f32x4 sub_f32x4(f32x4 a, f32x4 b) { return _mm_sub_ps(a, b); }
+_simd_alwaysinline static f32x4 mul_f32x4(f32x4 a, f32x4 b) { return _mm_mul_ps(a, b); }
+_simd_alwaysinline static f32x4 div_f32x4(f32x4 a, f32x4 b) { return _mm_div_ps(a, b); }
+# if defined(__FMA__)
+_simd_alwaysinline static f32x4 madd_f32x4(f32x4 a, f32x4 b, f32x4 c) { return _mm_fmadd_ps(a, b, c); }
+# else
+_simd_alwaysinline static f32x4 madd_f32x4(f32x4 a, f32x4 b, f32x4 c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+# endif
+_simd_alwaysinline static f32x4 sqrt_f32x4(f32x4 a) { return _mm_sqrt_ps(a); }
+_simd_alwaysinline static f32x4 rcp_f32x4(f32x4 a) { return _mm_rcp_ps(a); }
+_simd_alwaysinline static f32x4 rsqrt_f32x4(f32x4 a) { return _mm_rsqrt_ps(a); }
+_simd_alwaysinline static f32x4 neg_f32x4(f32x4 a) { return _mm_xor_ps(a, _mm_set1_ps(-0.f)); }
+_simd_alwaysinline static f32x4 abs_f32x4(f32x4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+_simd_alwaysinline static f32x4 min_f32x4(f32x4 a, f32x4 b) { return _mm_min_ps(a, b); }
+_simd_alwaysinline static f32x4 max_f32x4(f32x4 a, f32x4 b) { return _mm_max_ps(a, b); }
+
+_simd_alwaysinline static u32x4 add_u32x4(u32x4 a, u32x4 b) { return _mm_add_epi32(a, b); }
+_simd_alwaysinline static u32x4 sub_u32x4(u32x4 a, u32x4 b) { return _mm_sub_epi32(a, b); }
+# if defined(_simd_sse41)
+_simd_alwaysinline static u32x4 mul_u32x4(u32x4 a, u32x4 b) { return _mm_mullo_epi32(a, b); }
+# else
+_simd_alwaysinline static u32x4 mul_u32x4(u32x4 a, u32x4 b) {
+	__m128i even = _mm_mul_epu32(a, b);
+	__m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+	return _mm_unpacklo_epi32(
+		_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+		_mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+# endif
+_simd_alwaysinline static u32x4 and_u32x4(u32x4 a, u32x4 b) { return _mm_and_si128(a, b); }
+_simd_alwaysinline static u32x4 or_u32x4(u32x4 a, u32x4 b) { return _mm_or_si128(a, b); }
+_simd_alwaysinline static u32x4 xor_u32x4(u32x4 a, u32x4 b) { return _mm_xor_si128(a, b); }
+_simd_alwaysinline static u32x4 andnot_u32x4(u32x4 a, u32x4 b) { return _mm_andnot_si128(b, a); }
+_simd_alwaysinline static u32x4 sll_u32x4(u32x4 a, s32 n) { return _mm_sll_epi32(a, _mm_cvtsi32_si128(n)); }
+_simd_alwaysinline static u32x4 srl_u32x4(u32x4 a, s32 n) { return _mm_srl_epi32(a, _mm_cvtsi32_si128(n)); }
+_simd_alwaysinline static u32x4 sra_u32x4(u32x4 a, s32 n) { return _mm_sra_epi32(a, _mm_cvtsi32_si128(n)); }
+
+_simd_alwaysinline static u32x4 cmpeq_f32x4(f32x4 a, f32x4 b) { return _mm_castps_si128(_mm_cmpeq_ps(a, b)); }
+_simd_alwaysinline static u32x4 cmpgt_f32x4(f32x4 a, f32x4 b) { return _mm_castps_si128(_mm_cmpgt_ps(a, b)); }
+_simd_alwaysinline static u32x4 cmpge_f32x4(f32x4 a, f32x4 b) { return _mm_castps_si128(_mm_cmpge_ps(a, b)); }
+_simd_alwaysinline static u32x4 cmpeq_u32x4(u32x4 a, u32x4 b) { return _mm_cmpeq_epi32(a, b); }
+_simd_alwaysinline static u32x4 cmpgt_u32x4(u32x4 a, u32x4 b) {
+	const __m128i bias = _mm_set1_epi32((int) 0x80000000);
+	return _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+}
+
+# if defined(_simd_sse41)
+_simd_alwaysinline static f32x4 blend_f32x4(u32x4 m, f32x4 a, f32x4 b) { return _mm_blendv_ps(b, a, _mm_castsi128_ps(m)); }
+_simd_alwaysinline static u32x4 blend_u32x4(u32x4 m, u32x4 a, u32x4 b) { return _mm_blendv_epi8(b, a, m); }
+_simd_alwaysinline static u32x4 min_u32x4(u32x4 a, u32x4 b) { return _mm_min_epu32(a, b); }
+_simd_alwaysinline static u32x4 max_u32x4(u32x4 a, u32x4 b) { return _mm_max_epu32(a, b); }
+# else
+_simd_alwaysinline static f32x4 blend_f32x4(u32x4 m, f32x4 a, f32x4 b) {
+	__m128 mf = _mm_castsi128_ps(m);
+	return _mm_or_ps(_mm_and_ps(mf, a), _mm_andnot_ps(mf, b));
+}
+_simd_alwaysinline static u32x4 blend_u32x4(u32x4 m, u32x4 a, u32x4 b) { return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b)); }
+_simd_alwaysinline static u32x4 min_u32x4(u32x4 a, u32x4 b) { return blend_u32x4(cmpgt_u32x4(a, b), b, a); }
+_simd_alwaysinline static u32x4 max_u32x4(u32x4 a, u32x4 b) { return blend_u32x4(cmpgt_u32x4(a, b), a, b); }
+# endif
+
+_simd_alwaysinline static u32 movemask_u32x4(u32x4 m) { return (u32) _mm_movemask_ps(_mm_castsi128_ps(m)); }
+
+_simd_alwaysinline static u32x4 trunc_f32x4(f32x4 a) { return _mm_cvttps_epi32(a); }
+_simd_alwaysinline static u32x4 round_f32x4(f32x4 a) { return _mm_cvtps_epi32(a); }
+# if defined(_simd_sse41)
+#  define _have_simd_floor 1
+_simd_alwaysinline static u32x4 floor_f32x4(f32x4 a) { return _mm_cvttps_epi32(_mm_floor_ps(a)); }
+_simd_alwaysinline static u32x4 ceil_f32x4(f32x4 a) { return _mm_cvttps_epi32(_mm_ceil_ps(a)); }
+# endif
+_simd_alwaysinline static f32x4 s32x4_to_f32x4(u32x4 a) { return _mm_cvtepi32_ps(a); }
+
+# define shuffle_f32x4(a,x,y,z,w) _mm_shuffle_ps((a), (a), _MM_SHUFFLE(w, z, y, x))
+# define shuffle_u32x4(a,x,y,z,w) _mm_shuffle_epi32((a), _MM_SHUFFLE(w, z, y, x))
+
+#elif defined(__SPU__) || defined(__SPU)
+# define _have_simd_ops 1
+
+_simd_alwaysinline static f32x4 zero_f32x4(void) { return spu_splats(0.f); }
+_simd_alwaysinline static f32x4 set1_f32x4(f32 a) { return spu_splats(a); }
+_simd_alwaysinline static f32x4 set_f32x4(f32 x, f32 y, f32 z, f32 w) { return (f32x4) {x, y, z, w}; }
+_simd_alwaysinline static f32x4 load_f32x4(const f32 *p) { return *(const f32x4 *) p; }
+_simd_alwaysinline static f32x4 loadu_f32x4(const f32 *p) { f32x4 a; memcpy(&a, p, 16); return a; }
+_simd_alwaysinline static void store_f32x4(f32 *p, f32x4 a) { *(f32x4 *) p = a; }
+_simd_alwaysinline static void storeu_f32x4(f32 *p, f32x4 a) { memcpy(p, &a, 16); }
+
+_simd_alwaysinline static u32x4 zero_u32x4(void) { return spu_splats(0u); }
+_simd_alwaysinline static u32x4 set1_u32x4(u32 a) { return spu_splats(a); }
+_simd_alwaysinline static u32x4 set_u32x4(u32 x, u32 y, u32 z, u32 w) { return (u32x4) {x, y, z, w}; }
+_simd_alwaysinline static u32x4 load_u32x4(const u32 *p) { return *(const u32x4 *) p; }
+_simd_alwaysinline static u32x4 loadu_u32x4(const u32 *p) { u32x4 a; memcpy(&a, p, 16); return a; }
+_simd_alwaysinline static void store_u32x4(u32 *p, u32x4 a) { *(u32x4 *) p = a; }
+_simd_alwaysinline static void storeu_u32x4(u32 *p, u32x4 a) { memcpy(p, &a, 16); }
+
+_simd_alwaysinline static f32 lane0_f32x4(f32x4 a) { return spu_extract(a, 0); }
+_simd_alwaysinline static u32 lane0_u32x4(u32x4 a) { return spu_extract(a, 0); }
+
+_simd_alwaysinline static f32x4 bits_to_f32x4(u32x4 a) { return (f32x4) a; }
+_simd_alwaysinline static u32x4 f32x4_to_bits(f32x4 a) { return (u32x4) a; }
+
+_simd_alwaysinline static f32x4 add_f32x4(f32x4 a, f32x4 b) { return spu_add(a, b); }
+_simd_alwaysinline static f32x4 sub_f32x4(f32x4 a, f32x4 b) { return spu_sub(a, b); }
+_simd_alwaysinline static f32x4 mul_f32x4(f32x4 a, f32x4 b) { return spu_mul(a, b); }
+_simd_alwaysinline static f32x4 madd_f32x4(f32x4 a, f32x4 b, f32x4 c) { return spu_madd(a, b, c); }
+_simd_alwaysinline static f32x4 rcp_f32x4(f32x4 a) { return spu_re(a); }
+_simd_alwaysinline static f32x4 rsqrt_f32x4(f32x4 a) { return spu_rsqrte(a); }
+_simd_alwaysinline static f32x4 div_f32x4(f32x4 a, f32x4 b) {
+	f32x4 r = spu_re(b);
+	r = spu_madd(spu_nmsub(b, r, spu_splats(1.f)), r, r);
+	return spu_mul(a, r);
+}
+_simd_alwaysinline static f32x4 sqrt_f32x4(f32x4 a) {
+	f32x4 r = spu_rsqrte(a);
+	f32x4 h = spu_mul(spu_splats(.5f), r);
+	r = spu_madd(spu_nmsub(spu_mul(a, r), r, spu_splats(1.f)), h, r);
+	return spu_sel(spu_mul(a, r), a, spu_cmpeq(a, spu_splats(0.f)));
+}
+_simd_alwaysinline static f32x4 neg_f32x4(f32x4 a) { return (f32x4) spu_xor((u32x4) a, spu_splats(0x80000000u)); }
+_simd_alwaysinline static f32x4 abs_f32x4(f32x4 a) { return (f32x4) spu_andc((u32x4) a, spu_splats(0x80000000u)); }
+_simd_alwaysinline static f32x4 min_f32x4(f32x4 a, f32x4 b) { return spu_sel(a, b, spu_cmpgt(a, b)); }
+_simd_alwaysinline static f32x4 max_f32x4(f32x4 a, f32x4 b) { return spu_sel(b, a, spu_cmpgt(a, b)); }
+
+_simd_alwaysinline static u32x4 add_u32x4(u32x4 a, u32x4 b) { return spu_add(a, b); }
+_simd_alwaysinline static u32x4 sub_u32x4(u32x4 a, u32x4 b) { return spu_sub(a, b); }
+_simd_alwaysinline static u32x4 mul_u32x4(u32x4 a, u32x4 b) { return a * b; }
+_simd_alwaysinline static u32x4 and_u32x4(u32x4 a, u32x4 b) { return spu_and(a, b); }
+_simd_alwaysinline static u32x4 or_u32x4(u32x4 a, u32x4 b) { return spu_or(a, b); }
+_simd_alwaysinline static u32x4 xor_u32x4(u32x4 a, u32x4 b) { return spu_xor(a, b); }
+_simd_alwaysinline static u32x4 andnot_u32x4(u32x4 a, u32x4 b) { return spu_andc(a, b); }
+_simd_alwaysinline static u32x4 sll_u32x4(u32x4 a, s32 n) { return spu_sl(a, (unsigned) n); }
+_simd_alwaysinline static u32x4 srl_u32x4(u32x4 a, s32 n) { return spu_rlmask(a, -n); }
+_simd_alwaysinline static u32x4 sra_u32x4(u32x4 a, s32 n) { return (u32x4) spu_rlmaska((vector signed int) a, -n); }
+
+_simd_alwaysinline static u32x4 cmpeq_f32x4(f32x4 a, f32x4 b) { return spu_cmpeq(a, b); }
+_simd_alwaysinline static u32x4 cmpgt_f32x4(f32x4 a, f32x4 b) { return spu_cmpgt(a, b); }
+_simd_alwaysinline static u32x4 cmpge_f32x4(f32x4 a, f32x4 b) { return spu_or(spu_cmpgt(a, b), spu_cmpeq(a, b)); }
+_simd_alwaysinline static u32x4 cmpeq_u32x4(u32x4 a, u32x4 b) { return spu_cmpeq(a, b); }
+_simd_alwaysinline static u32x4 cmpgt_u32x4(u32x4 a, u32x4 b) { return spu_cmpgt(a, b); }
+
+_simd_alwaysinline static f32x4 blend_f32x4(u32x4 m, f32x4 a, f32x4 b) { return spu_sel(b, a, m); }
+_simd_alwaysinline static u32x4 blend_u32x4(u32x4 m, u32x4 a, u32x4 b) { return spu_sel(b, a, m); }
+_simd_alwaysinline static u32x4 min_u32x4(u32x4 a, u32x4 b) { return spu_sel(a, b, spu_cmpgt(a, b)); }
+_simd_alwaysinline static u32x4 max_u32x4(u32x4 a, u32x4 b) { return spu_sel(b, a, spu_cmpgt(a, b)); }
+
+_simd_alwaysinline static u32 movemask_u32x4(u32x4 m) {
+	u32 g = spu_extract(spu_gather(m), 0);
+	return (g & 1) << 3 | (g & 2) << 1 | (g & 4) >> 1 | (g & 8) >> 3;
+}
+
+_simd_alwaysinline static u32x4 trunc_f32x4(f32x4 a) { return (u32x4) spu_convts(a, 0); }
+/* SPU single precision always rounds toward zero, so the fraction that
+   truncation leaves, which is exact, decides: over a half steps away from
+   zero, and exactly a half only onto an even result. */
+_simd_alwaysinline static u32x4 round_f32x4(f32x4 a) {
+	vector signed int t = spu_convts(a, 0);
+	f32x4 d = spu_sub(a, spu_convtf(t, 0));
+	u32x4 odd = spu_cmpeq(spu_and((u32x4) t, spu_splats(1u)), spu_splats(1u));
+	u32x4 up = spu_or(spu_cmpabsgt(d, spu_splats(.5f)), spu_and(spu_cmpabseq(d, spu_splats(.5f)), odd));
+	u32x4 step = spu_or((u32x4) spu_rlmaska((vector signed int) a, -31), spu_splats(1u));
+	return spu_add((u32x4) t, spu_and(up, step));
+}
+_simd_alwaysinline static f32x4 s32x4_to_f32x4(u32x4 a) { return spu_convtf((vector signed int) a, 0); }
+
+# define _simd_shuffle_pattern(x,y,z,w) ((vector unsigned char) { \
+	(x) * 4, (x) * 4 + 1, (x) * 4 + 2, (x) * 4 + 3, (y) * 4, (y) * 4 + 1, (y) * 4 + 2, (y) * 4 + 3, \
+	(z) * 4, (z) * 4 + 1, (z) * 4 + 2, (z) * 4 + 3, (w) * 4, (w) * 4 + 1, (w) * 4 + 2, (w) * 4 + 3})
+# define shuffle_f32x4(a,x,y,z,w) spu_shuffle((a), (a), _simd_shuffle_pattern(x, y, z, w))
+# define shuffle_u32x4(a,x,y,z,w) spu_shuffle((a), (a), _simd_shuffle_pattern(x, y, z, w))
+
+#elif defined(__PPU__) || defined(__ppc64__)
+# define _have_simd_ops 1
+
+_simd_alwaysinline static f32x4 zero_f32x4(void) { return (f32x4) vec_splat_u32(0); }
+_simd_alwaysinline static f32x4 set1_f32x4(f32 a) { return (f32x4) {a, a, a, a}; }
+_simd_alwaysinline static f32x4 set_f32x4(f32 x, f32 y, f32 z, f32 w) { return (f32x4) {x, y, z, w}; }
+_simd_alwaysinline static f32x4 load_f32x4(const f32 *p) { return vec_ld(0, p); }
+_simd_alwaysinline static f32x4 loadu_f32x4(const f32 *p) { f32x4 a; memcpy(&a, p, 16); return a; }
+_simd_alwaysinline static void store_f32x4(f32 *p, f32x4 a) { vec_st(a, 0, p); }
+_simd_alwaysinline static void storeu_f32x4(f32 *p, f32x4 a) { memcpy(p, &a, 16); }
+
+_simd_alwaysinline static u32x4 zero_u32x4(void) { return vec_splat_u32(0); }
+_simd_alwaysinline static u32x4 set1_u32x4(u32 a) { return (u32x4) {a, a, a, a}; }
+_simd_alwaysinline static u32x4 set_u32x4(u32 x, u32 y, u32 z, u32 w) { return (u32x4) {x, y, z, w}; }
+_simd_alwaysinline static u32x4 load_u32x4(const u32 *p) { return vec_ld(0, p); }
+_simd_alwaysinline static u32x4 loadu_u32x4(const u32 *p) { u32x4 a; memcpy(&a, p, 16); return a; }
+_simd_alwaysinline static void store_u32x4(u32 *p, u32x4 a) { vec_st(a, 0, p); }
+_simd_alwaysinline static void storeu_u32x4(u32 *p, u32x4 a) { memcpy(p, &a, 16); }
+
+_simd_alwaysinline static f32 lane0_f32x4(f32x4 a) { return vec_extract(a, 0); }
+_simd_alwaysinline static u32 lane0_u32x4(u32x4 a) { return vec_extract(a, 0); }
+
+_simd_alwaysinline static f32x4 bits_to_f32x4(u32x4 a) { return (f32x4) a; }
+_simd_alwaysinline static u32x4 f32x4_to_bits(f32x4 a) { return (u32x4) a; }
+
+_simd_alwaysinline static f32x4 add_f32x4(f32x4 a, f32x4 b) { return vec_add(a, b); }
+_simd_alwaysinline static f32x4 sub_f32x4(f32x4 a, f32x4 b) { return vec_sub(a, b); }
+_simd_alwaysinline static f32x4 mul_f32x4(f32x4 a, f32x4 b) { return vec_madd(a, b, set1_f32x4(-0.f)); }
+_simd_alwaysinline static f32x4 madd_f32x4(f32x4 a, f32x4 b, f32x4 c) { return vec_madd(a, b, c); }
+_simd_alwaysinline static f32x4 rcp_f32x4(f32x4 a) { return vec_re(a); }
+_simd_alwaysinline static f32x4 rsqrt_f32x4(f32x4 a) { return vec_rsqrte(a); }
+_simd_alwaysinline static f32x4 div_f32x4(f32x4 a, f32x4 b) {
+	f32x4 r = vec_re(b);
+	r = vec_madd(vec_nmsub(b, r, set1_f32x4(1.f)), r, r);
+	r = vec_madd(vec_nmsub(b, r, set1_f32x4(1.f)), r, r);
+	return vec_madd(a, r, set1_f32x4(-0.f));
+}
+_simd_alwaysinline static f32x4 sqrt_f32x4(f32x4 a) {
+	f32x4 r = vec_rsqrte(a);
+	f32x4 h = vec_madd(set1_f32x4(.5f), r, set1_f32x4(-0.f));
+	r = vec_madd(vec_nmsub(vec_madd(a, r, set1_f32x4(-0.f)), r, set1_f32x4(1.f)), h, r);
+	return vec_sel(vec_madd(a, r, set1_f32x4(-0.f)), a, (u32x4) vec_cmpeq(a, zero_f32x4()));
+}
+_simd_alwaysinline static f32x4 neg_f32x4(f32x4 a) { return (f32x4) vec_xor((u32x4) a, set1_u32x4(0x80000000u)); }
+_simd_alwaysinline static f32x4 abs_f32x4(f32x4 a) { return vec_abs(a); }
+_simd_alwaysinline static f32x4 min_f32x4(f32x4 a, f32x4 b) { return vec_min(a, b); }
+_simd_alwaysinline static f32x4 max_f32x4(f32x4 a, f32x4 b) { return vec_max(a, b); }
+
+_simd_alwaysinline static u32x4 add_u32x4(u32x4 a, u32x4 b) { return vec_add(a, b); }
+_simd_alwaysinline static u32x4 sub_u32x4(u32x4 a, u32x4 b) { return vec_sub(a, b); }
+_simd_alwaysinline static u32x4 mul_u32x4(u32x4 a, u32x4 b) { return a * b; }
+_simd_alwaysinline static u32x4 and_u32x4(u32x4 a, u32x4 b) { return vec_and(a, b); }
+_simd_alwaysinline static u32x4 or_u32x4(u32x4 a, u32x4 b) { return vec_or(a, b); }
+_simd_alwaysinline static u32x4 xor_u32x4(u32x4 a, u32x4 b) { return vec_xor(a, b); }
+_simd_alwaysinline static u32x4 andnot_u32x4(u32x4 a, u32x4 b) { return vec_andc(a, b); }
+_simd_alwaysinline static u32x4 sll_u32x4(u32x4 a, s32 n) { return vec_sl(a, set1_u32x4((u32) n)); }
+_simd_alwaysinline static u32x4 srl_u32x4(u32x4 a, s32 n) { return vec_sr(a, set1_u32x4((u32) n)); }
+_simd_alwaysinline static u32x4 sra_u32x4(u32x4 a, s32 n) { return (u32x4) vec_sra((vector signed int) a, set1_u32x4((u32) n)); }
+
+_simd_alwaysinline static u32x4 cmpeq_f32x4(f32x4 a, f32x4 b) { return (u32x4) vec_cmpeq(a, b); }
+_simd_alwaysinline static u32x4 cmpgt_f32x4(f32x4 a, f32x4 b) { return (u32x4) vec_cmpgt(a, b); }
+_simd_alwaysinline static u32x4 cmpge_f32x4(f32x4 a, f32x4 b) { return (u32x4) vec_cmpge(a, b); }
+_simd_alwaysinline static u32x4 cmpeq_u32x4(u32x4 a, u32x4 b) { return (u32x4) vec_cmpeq(a, b); }
+_simd_alwaysinline static u32x4 cmpgt_u32x4(u32x4 a, u32x4 b) { return (u32x4) vec_cmpgt(a, b); }
+
+_simd_alwaysinline static f32x4 blend_f32x4(u32x4 m, f32x4 a, f32x4 b) { return vec_sel(b, a, m); }
+_simd_alwaysinline static u32x4 blend_u32x4(u32x4 m, u32x4 a, u32x4 b) { return vec_sel(b, a, m); }
+_simd_alwaysinline static u32x4 min_u32x4(u32x4 a, u32x4 b) { return vec_min(a, b); }
+_simd_alwaysinline static u32x4 max_u32x4(u32x4 a, u32x4 b) { return vec_max(a, b); }
+
+_simd_alwaysinline static u32 movemask_u32x4(u32x4 m) {
+	u32x4 b = vec_sl(vec_sr(m, set1_u32x4(31)), set_u32x4(0, 1, 2, 3));
+	return vec_extract((u32x4) vec_sums((vector signed int) b, (vector signed int) zero_u32x4()), 3);
+}
+
+_simd_alwaysinline static u32x4 trunc_f32x4(f32x4 a) { return (u32x4) vec_cts(a, 0); }
+_simd_alwaysinline static u32x4 round_f32x4(f32x4 a) { return (u32x4) vec_cts(vec_round(a), 0); }
+_simd_alwaysinline static f32x4 s32x4_to_f32x4(u32x4 a) { return vec_ctf((vector signed int) a, 0); }
+
+# define _simd_shuffle_pattern(x,y,z,w) ((vector unsigned char) { \
+	(x) * 4, (x) * 4 + 1, (x) * 4 + 2, (x) * 4 + 3, (y) * 4, (y) * 4 + 1, (y) * 4 + 2, (y) * 4 + 3, \
+	(z) * 4, (z) * 4 + 1, (z) * 4 + 2, (z) * 4 + 3, (w) * 4, (w) * 4 + 1, (w) * 4 + 2, (w) * 4 + 3})
+# define shuffle_f32x4(a,x,y,z,w) vec_perm((a), (a), _simd_shuffle_pattern(x, y, z, w))
+# define shuffle_u32x4(a,x,y,z,w) vec_perm((a), (a), _simd_shuffle_pattern(x, y, z, w))
+#endif
+
+#if defined(_have_simd_ops)
+# define splat_f32x4(a,i) shuffle_f32x4(a, i, i, i, i)
+# define splat_u32x4(a,i) shuffle_u32x4(a, i, i, i, i)
+
+_simd_alwaysinline static u32x4 cmplt_f32x4(f32x4 a, f32x4 b) { return cmpgt_f32x4(b, a); }
+_simd_alwaysinline static u32x4 cmple_f32x4(f32x4 a, f32x4 b) { return cmpge_f32x4(b, a); }
+_simd_alwaysinline static u32x4 cmplt_u32x4(u32x4 a, u32x4 b) { return cmpgt_u32x4(b, a); }
+
+# if !defined(_have_simd_hadd)
+_simd_alwaysinline static f32 hadd_f32x4(f32x4 a) {
+	a = add_f32x4(a, shuffle_f32x4(a, 2, 3, 0, 1));
+	return lane0_f32x4(add_f32x4(a, shuffle_f32x4(a, 1, 0, 3, 2)));
+}
+_simd_alwaysinline static f32 hmin_f32x4(f32x4 a) {
+	a = min_f32x4(a, shuffle_f32x4(a, 2, 3, 0, 1));
+	return lane0_f32x4(min_f32x4(a, shuffle_f32x4(a, 1, 0, 3, 2)));
+}
+_simd_alwaysinline static f32 hmax_f32x4(f32x4 a) {
+	a = max_f32x4(a, shuffle_f32x4(a, 2, 3, 0, 1));
+	return lane0_f32x4(max_f32x4(a, shuffle_f32x4(a, 1, 0, 3, 2)));
+}
+_simd_alwaysinline static u32 hadd_u32x4(u32x4 a) {
+	a = add_u32x4(a, shuffle_u32x4(a, 2, 3, 0, 1));
+	return lane0_u32x4(add_u32x4(a, shuffle_u32x4(a, 1, 0, 3, 2)));
+}
+# endif
+
+/* A truncated lane is one too high below zero (floor) or one too low above
+   zero (ceil) when it is not exact; all-ones compare lanes are -1. */
+# if !defined(_have_simd_floor)
+_simd_alwaysinline static u32x4 floor_f32x4(f32x4 a) {
+	u32x4 t = trunc_f32x4(a);
+	return add_u32x4(t, cmpgt_f32x4(s32x4_to_f32x4(t), a));
+}
+_simd_alwaysinline static u32x4 ceil_f32x4(f32x4 a) {
+	u32x4 t = trunc_f32x4(a);
+	return sub_u32x4(t, cmplt_f32x4(s32x4_to_f32x4(t), a));
+}
+# endif
+
+/* Vector counterparts of the aw-arith.h scalar helpers. */
+_simd_alwaysinline static f32x4 sel_f32x4(f32x4 x, f32x4 a, f32x4 b) { return blend_f32x4(cmpge_f32x4(x, zero_f32x4()), a, b); }
+_simd_alwaysinline static f32x4 clamp_f32x4(f32x4 a, f32x4 mn, f32x4 mx) { return min_f32x4(max_f32x4(a, mn), mx); }
+_simd_alwaysinline static f32x4 saturate_f32x4(f32x4 a) { return clamp_f32x4(a, zero_f32x4(), set1_f32x4(1.f)); }
+_simd_alwaysinline static f32x4 lerp_f32x4(f32x4 t, f32x4 a, f32x4 b) { return madd_f32x4(t, sub_f32x4(b, a), a); }
+_simd_alwaysinline static f32x4 sqr_f32x4(f32x4 a) { return mul_f32x4(a, a); }
+_simd_alwaysinline static u32x4 clamp_u32x4(u32x4 a, u32x4 mn, u32x4 mx) { return min_u32x4(max_u32x4(a, mn), mx); }
+#endif /* defined(_have_simd_ops) */
+
+/* 256-bit operations, available when the translation unit targets AVX (and
+   AVX2 for the integer ones). Run-time dispatched kernels use intrinsics
+   directly instead. */
+#if defined(__AVX__) && defined(_have_simd_types_256)
+# define _have_simd_ops_256 1
+
+_simd_alwaysinline static f32x8 zero_f32x8(void) { return _mm256_setzero_ps(); }
+_simd_alwaysinline static f32x8 set1_f32x8(f32 a) { return _mm256_set1_ps(a); }
+_simd_alwaysinline static f32x8 load_f32x8(const f32 *p) { return _mm256_load_ps(p); }
+_simd_alwaysinline static f32x8 loadu_f32x8(const f32 *p) { return _mm256_loadu_ps(p); }
+_simd_alwaysinline static void store_f32x8(f32 *p, f32x8 a) { _mm256_store_ps(p, a); }
+_simd_alwaysinline static void storeu_f32x8(f32 *p, f32x8 a) { _mm256_storeu_ps(p, a); }
+
+_simd_alwaysinline static u32x8 zero_u32x8(void) { return _mm256_setzero_si256(); }
+_simd_alwaysinline static u32x8 set1_u32x8(u32 a) { return _mm256_set1_epi32((int) a); }
+_simd_alwaysinline static u32x8 load_u32x8(const u32 *p) { return _mm256_load_si256((const __m256i *) p); }
+_simd_alwaysinline static u32x8 loadu_u32x8(const u32 *p) { return _mm256_loadu_si256((const __m256i *) p); }
+_simd_alwaysinline static void store_u32x8(u32 *p, u32x8 a) { _mm256_store_si256((__m256i *) p, a); }
+_simd_alwaysinline static void storeu_u32x8(u32 *p, u32x8 a) { _mm256_storeu_si256((__m256i *) p, a); }
+
+_simd_alwaysinline static f32x8 bits_to_f32x8(u32x8 a) { return _mm256_castsi256_ps(a); }
+_simd_alwaysinline static u32x8 f32x8_to_bits(f32x8 a) { return _mm256_castps_si256(a); }
+
+_simd_alwaysinline static f32x8 add_f32x8(f32x8 a, f32x8 b) { return _mm256_add_ps(a, b); }
+_simd_alwaysinline static f32x8 sub_f32x8(f32x8 a, f32x8 b) { return _mm256_sub_ps(a, b); }
+_simd_alwaysinline static f32x8 mul_f32x8(f32x8 a, f32x8 b) { return _mm256_mul_ps(a, b); }
+_simd_alwaysinline static f32x8 div_f32x8(f32x8 a, f32x8 b) { return _mm256_div_ps(a, b); }
+# if defined(__FMA__)
+_simd_alwaysinline static f32x8 madd_f32x8(f32x8 a, f32x8 b, f32x8 c) { return _mm256_fmadd_ps(a, b, c); }
+# else
+_simd_alwaysinline static f32x8 madd_f32x8(f32x8 a, f32x8 b, f32x8 c) { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+# endif
+_simd_alwaysinline static f32x8 sqrt_f32x8(f32x8 a) { return _mm256_sqrt_ps(a); }
+_simd_alwaysinline static f32x8 rcp_f32x8(f32x8 a) { return _mm256_rcp_ps(a); }
+_simd_alwaysinline static f32x8 rsqrt_f32x8(f32x8 a) { return _mm256_rsqrt_ps(a); }
+_simd_alwaysinline static f32x8 neg_f32x8(f32x8 a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.f)); }
+_simd_alwaysinline static f32x8 abs_f32x8(f32x8 a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+_simd_alwaysinline static f32x8 min_f32x8(f32x8 a, f32x8 b) { return _mm256_min_ps(a, b); }
+_simd_alwaysinline static f32x8 max_f32x8(f32x8 a, f32x8 b) { return _mm256_max_ps(a, b); }
+
+_simd_alwaysinline static u32x8 cmpeq_f32x8(f32x8 a, f32x8 b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+_simd_alwaysinline static u32x8 cmpgt_f32x8(f32x8 a, f32x8 b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_GT_OQ)); }
+_simd_alwaysinline static u32x8 cmpge_f32x8(f32x8 a, f32x8 b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_GE_OQ)); }
+_simd_alwaysinline static u32x8 cmplt_f32x8(f32x8 a, f32x8 b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LT_OQ)); }
+_simd_alwaysinline static u32x8 cmple_f32x8(f32x8 a, f32x8 b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LE_OQ)); }
+
+_simd_alwaysinline static f32x8 blend_f32x8(u32x8 m, f32x8 a, f32x8 b) { return _mm256_blendv_ps(b, a, _mm256_castsi256_ps(m)); }
+_simd_alwaysinline static u32 movemask_u32x8(u32x8 m) { return (u32) _mm256_movemask_ps(_mm256_castsi256_ps(m)); }
+
+_simd_alwaysinline static u32x8 trunc_f32x8(f32x8 a) { return _mm256_cvttps_epi32(a); }
+_simd_alwaysinline static u32x8 round_f32x8(f32x8 a) { return _mm256_cvtps_epi32(a); }
+_simd_alwaysinline static u32x8 floor_f32x8(f32x8 a) { return _mm256_cvttps_epi32(_mm256_floor_ps(a)); }
+_simd_alwaysinline static u32x8 ceil_f32x8(f32x8 a) { return _mm256_cvttps_epi32(_mm256_ceil_ps(a)); }
+_simd_alwaysinline static f32x8 s32x8_to_f32x8(u32x8 a) { return _mm256_cvtepi32_ps(a); }
+
+_simd_alwaysinline static f32x4 lo_f32x8(f32x8 a) { return _mm256_castps256_ps128(a); }
+_simd_alwaysinline static f32x4 hi_f32x8(f32x8 a) { return _mm256_extractf128_ps(a, 1); }
+
+_simd_alwaysinline static f32 hadd_f32x8(f32x8 a) { return hadd_f32x4(add_f32x4(lo_f32x8(a), hi_f32x8(a))); }
+_simd_alwaysinline static f32 hmin_f32x8(f32x8 a) { return hmin_f32x4(min_f32x4(lo_f32x8(a), hi_f32x8(a))); }
+_simd_alwaysinline static f32 hmax_f32x8(f32x8 a) { return hmax_f32x4(max_f32x4(lo_f32x8(a), hi_f32x8(a))); }
+
+_simd_alwaysinline static f32x8 sel_f32x8(f32x8 x, f32x8 a, f32x8 b) { return blend_f32x8(cmpge_f32x8(x, zero_f32x8()), a, b); }
+_simd_alwaysinline static f32x8 clamp_f32x8(f32x8 a, f32x8 mn, f32x8 mx) { return min_f32x8(max_f32x8(a, mn), mx); }
+_simd_alwaysinline static f32x8 saturate_f32x8(f32x8 a) { return clamp_f32x8(a, zero_f32x8(), set1_f32x8(1.f)); }
+_simd_alwaysinline static f32x8 lerp_f32x8(f32x8 t, f32x8 a, f32x8 b) { return madd_f32x8(t, sub_f32x8(b, a), a); }
+_simd_alwaysinline static f32x8 sqr_f32x8(f32x8 a) { return mul_f32x8(a, a); }
+
+# if defined(__AVX2__)
+_simd_alwaysinline static u32x8 add_u32x8(u32x8 a, u32x8 b) { return _mm256_add_epi32(a, b); }
+_simd_alwaysinline static u32x8 sub_u32x8(u32x8 a, u32x8 b) { return _mm256_sub_epi32(a, b); }
+_simd_alwaysinline static u32x8 mul_u32x8(u32x8 a, u32x8 b) { return _mm256_mullo_epi32(a, b); }
+_simd_alwaysinline static u32x8 and_u32x8(u32x8 a, u32x8 b) { return _mm256_and_si256(a, b); }
+_simd_alwaysinline static u32x8 or_u32x8(u32x8 a, u32x8 b) { return _mm256_or_si256(a, b); }
+_simd_alwaysinline static u32x8 xor_u32x8(u32x8 a, u32x8 b) { return _mm256_xor_si256(a, b); }
+_simd_alwaysinline static u32x8 andnot_u32x8(u32x8 a, u32x8 b) { return _mm256_andnot_si256(b, a); }
+_simd_alwaysinline static u32x8 sll_u32x8(u32x8 a, s32 n) { return _mm256_sll_epi32(a, _mm_cvtsi32_si128(n)); }
+_simd_alwaysinline static u32x8 srl_u32x8(u32x8 a, s32 n) { return _mm256_srl_epi32(a, _mm_cvtsi32_si128(n)); }
+_simd_alwaysinline static u32x8 sra_u32x8(u32x8 a, s32 n) { return _mm256_sra_epi32(a, _mm_cvtsi32_si128(n)); }
+_simd_alwaysinline static u32x8 min_u32x8(u32x8 a, u32x8 b) { return _mm256_min_epu32(a, b); }
+_simd_alwaysinline static u32x8 max_u32x8(u32x8 a, u32x8 b) { return _mm256_max_epu32(a, b); }
+_simd_alwaysinline static u32x8 cmpeq_u32x8(u32x8 a, u32x8 b) { return _mm256_cmpeq_epi32(a, b); }
+_simd_alwaysinline static u32x8 cmpgt_u32x8(u32x8 a, u32x8 b) {
+	const __m256i bias = _mm256_set1_epi32((int) 0x80000000);
+	return _mm256_cmpgt_epi32(_mm256_xor_si256(a, bias), _mm256_xor_si256(b, bias));
+}
+_simd_alwaysinline static u32x8 blend_u32x8(u32x8 m, u32x8 a, u32x8 b) { return _mm256_blendv_epi8(b, a, m); }
+# endif
+#endif /* defined(__AVX__) && defined(_have_simd_types_256) */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* AW_SIMD_H */
+
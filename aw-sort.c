@@ -0,0 +1,516 @@
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+#include "aw-sort.h"
+#include "aw-arith.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+# include <windows.h>
+# define _sort_threads 1
+#elif defined(__unix__) || defined(__APPLE__)
+# include <pthread.h>
+# define _sort_threads 1
+#endif
+
+#define RADIX_BUCKETS 256
+#define RADIX_MAX_THREADS 64
+
+/* Below this many keys the passes over the histograms cost more than
+   sorting by insertion. */
+#define RADIX_SMALL 64
+
+enum { RADIX_UINT, RADIX_SINT, RADIX_FLOAT };
+enum { RADIX_COUNT_ALL, RADIX_COUNT, RADIX_SCATTER, RADIX_INSERT, RADIX_STOP };
+
+struct radix_crew;
+
+/* What every slice does in the current phase. Keys are width bytes wide and
+   move between src and dst, with the values when there are any. */
+struct radix_pass {
+	u8 *src;
+	u8 *dst;
+	u32 *srcvals;
+	u32 *dstvals;
+	u32 width;
+	u32 kind;
+	u32 digit;
+	u32 phase;
+	bool pairs;
+	struct radix_crew *crew;
+};
+
+/* One slice of the array: the counts of each byte of its keys, and where
+   in dst its keys with each value of the current byte go next. */
+struct radix_job {
+	const struct radix_pass *pass;
+	size_t begin;
+	size_t end;
+	size_t hist[8][RADIX_BUCKETS];
+	size_t pos[RADIX_BUCKETS];
+};
+
+/* Keys are read as unsigned integers that sort in the order wanted. */
+_sort_alwaysinline static u64 radix_key(const u8 *p, size_t i, u32 width, u32 kind) {
+	if (width == 4) {
+		u32 k;
+		memcpy(&k, p + i * 4, 4);
+		if (kind == RADIX_SINT)
+			k ^= 0x80000000;
+		else if (kind == RADIX_FLOAT)
+			k = (u32) sgnflip_s32((s32) k);
+		return k;
+	} else {
+		u64 k;
+		memcpy(&k, p + i * 8, 8);
+		if (kind == RADIX_SINT)
+			k ^= imm_u64(0x8000000000000000);
+		else if (kind == RADIX_FLOAT)
+			k = (u64) sgnflip_s64((s64) k);
+		return k;
+	}
+}
+
+_sort_alwaysinline static void radix_count_t(struct radix_job *j, u32 width, u32 kind, bool all) {
+	const u8 *src = j->pass->src;
+	size_t i, end = j->end;
+	if (all) {
+		memset(j->hist, 0, width * sizeof j->hist[0]);
+		for (i = j->begin; i < end; ++i) {
+			u64 k = radix_key(src, i, width, kind);
+			u32 d;
+			for (d = 0; d < width; ++d)
+				++j->hist[d][(k >> (d * 8)) & 0xff];
+		}
+	} else {
+		size_t *h = j->hist[j->pass->digit];
+		u32 shift = j->pass->digit * 8;
+		memset(h, 0, sizeof j->hist[0]);
+		for (i = j->begin; i < end; ++i)
+			++h[(radix_key(src, i, width, kind) >> shift) & 0xff];
+	}
+}
+
+/* The pass is read into locals first: the keys are stored as bytes, which
+   as far as the compiler knows could change it. */
+_sort_alwaysinline static void radix_scatter_t(struct radix_job *j, u32 width, u32 kind, bool pairs) {
+	const struct radix_pass *p = j->pass;
+	const u8 *src = p->src;
+	u8 *dst = p->dst;
+	const u32 *srcvals = p->srcvals;
+	u32 *dstvals = p->dstvals, shift = p->digit * 8;
+	size_t *pos = j->pos, i, end = j->end;
+	for (i = j->begin; i < end; ++i) {
+		size_t at = pos[(radix_key(src, i, width, kind) >> shift) & 0xff]++;
+		memcpy(dst + at * width, src + i * width, width);
+		if (pairs)
+			dstvals[at] = srcvals[i];
+	}
+}
+
+/* Sorts the slice of dst in place. */
+_sort_alwaysinline static void radix_insert_t(struct radix_job *j, u32 width, u32 kind, bool pairs) {
+	const struct radix_pass *p = j->pass;
+	u8 *a = p->dst, save[8];
+	u32 *v = p->dstvals, val;
+	size_t i, k, begin = j->begin, end = j->end;
+	for (i = begin + 1; i < end; ++i) {
+		u64 key = radix_key(a, i, width, kind);
+		if (radix_key(a, i - 1, width, kind) <= key)
+			continue;
+		memcpy(save, a + i * width, width);
+		val = pairs ? v[i] : 0;
+		for (k = i; k > begin && radix_key(a, k - 1, width, kind) > key; --k) {
+			memcpy(a + k * width, a + (k - 1) * width, width);
+			if (pairs)
+				v[k] = v[k - 1];
+		}
+		memcpy(a + k * width, save, width);
+		if (pairs)
+			v[k] = val;
+	}
+}
+
+_sort_alwaysinline static void radix_job_t(struct radix_job *j, u32 width, u32 kind) {
+	bool pairs = j->pass->pairs;
+	switch (j->pass->phase) {
+	case RADIX_COUNT_ALL: radix_count_t(j, width, kind, true); break;
+	case RADIX_COUNT: radix_count_t(j, width, kind, false); break;
+	case RADIX_SCATTER:
+		if (pairs)
+			radix_scatter_t(j, width, kind, true);
+		else
+			radix_scatter_t(j, width, kind, false);
+		break;
+	default:
+		if (pairs)
+			radix_insert_t(j, width, kind, true);
+		else
+			radix_insert_t(j, width, kind, false);
+		break;
+	}
+}
+
+static void radix_job_run(struct radix_job *j) {
+	u32 kind = j->pass->kind;
+	if (j->pass->width == 4)
+		switch (kind) {
+		case RADIX_UINT: radix_job_t(j, 4, RADIX_UINT); break;
+		case RADIX_SINT: radix_job_t(j, 4, RADIX_SINT); break;
+		default: radix_job_t(j, 4, RADIX_FLOAT); break;
+		}
+	else
+		switch (kind) {
+		case RADIX_UINT: radix_job_t(j, 8, RADIX_UINT); break;
+		case RADIX_SINT: radix_job_t(j, 8, RADIX_SINT); break;
+		default: radix_job_t(j, 8, RADIX_FLOAT); break;
+		}
+}
+
+#if defined(_WIN32)
+typedef HANDLE radix_thread;
+typedef CRITICAL_SECTION radix_mutex;
+typedef CONDITION_VARIABLE radix_cond;
+
+static DWORD WINAPI radix_thread_main(LPVOID j);
+
+static bool radix_thread_start(radix_thread *t, struct radix_job *j) {
+	*t = CreateThread(NULL, 0, radix_thread_main, j, 0, NULL);
+	return *t != NULL;
+}
+
+static void radix_thread_join(radix_thread t) {
+	WaitForSingleObject(t, INFINITE);
+	CloseHandle(t);
+}
+
+static bool radix_sync_init(radix_mutex *m, radix_cond *c) {
+	InitializeCriticalSection(m);
+	InitializeConditionVariable(c);
+	return true;
+}
+
+static void radix_sync_destroy(radix_mutex *m, radix_cond *c) {
+	(void) c;
+	DeleteCriticalSection(m);
+}
+
+static void radix_lock(radix_mutex *m) { EnterCriticalSection(m); }
+static void radix_unlock(radix_mutex *m) { LeaveCriticalSection(m); }
+static void radix_sleep(radix_cond *c, radix_mutex *m) { SleepConditionVariableCS(c, m, INFINITE); }
+static void radix_wake_all(radix_cond *c) { WakeAllConditionVariable(c); }
+#elif defined(_sort_threads)
+typedef pthread_t radix_thread;
+typedef pthread_mutex_t radix_mutex;
+typedef pthread_cond_t radix_cond;
+
+static void *radix_thread_main(void *j);
+
+static bool radix_thread_start(radix_thread *t, struct radix_job *j) { return pthread_create(t, NULL, radix_thread_main, j) == 0; }
+static void radix_thread_join(radix_thread t) { pthread_join(t, NULL); }
+
+static bool radix_sync_init(radix_mutex *m, radix_cond *c) {
+	if (pthread_mutex_init(m, NULL) != 0)
+		return false;
+	if (pthread_cond_init(c, NULL) != 0) {
+		pthread_mutex_destroy(m);
+		return false;
+	}
+	return true;
+}
+
+static void radix_sync_destroy(radix_mutex *m, radix_cond *c) {
+	pthread_cond_destroy(c);
+	pthread_mutex_destroy(m);
+}
+
+static void radix_lock(radix_mutex *m) { pthread_mutex_lock(m); }
+static void radix_unlock(radix_mutex *m) { pthread_mutex_unlock(m); }
+static void radix_sleep(radix_cond *c, radix_mutex *m) { pthread_cond_wait(c, m); }
+static void radix_wake_all(radix_cond *c) { pthread_cond_broadcast(c); }
+#endif
+
+#if defined(_sort_threads)
+/* The threads of one sort, started once and kept for all its phases. They
+   meet the calling thread at a barrier before each phase, so the pass is
+   set up, and after it, so the counts and keys are all in place. count is
+   how many take part in the barrier, the calling thread included; round
+   tells the sleepers of one meeting from those of the next. */
+struct radix_crew {
+	radix_thread threads[RADIX_MAX_THREADS];
+	radix_mutex lock;
+	radix_cond wake;
+	u32 workers;
+	u32 count;
+	u32 waiting;
+	u32 round;
+};
+
+static void radix_barrier_wait(struct radix_crew *c) {
+	radix_lock(&c->lock);
+	if (++c->waiting == c->count) {
+		c->waiting = 0;
+		++c->round;
+		radix_wake_all(&c->wake);
+	} else {
+		u32 round = c->round;
+		while (round == c->round)
+			radix_sleep(&c->wake, &c->lock);
+	}
+	radix_unlock(&c->lock);
+}
+
+static void radix_worker(struct radix_job *j) {
+	const struct radix_pass *p = j->pass;
+	for (;;) {
+		radix_barrier_wait(p->crew);
+		if (p->phase == RADIX_STOP)
+			return;
+		radix_job_run(j);
+		radix_barrier_wait(p->crew);
+	}
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI radix_thread_main(LPVOID j) {
+	radix_worker((struct radix_job *) j);
+	return 0;
+}
+#else
+static void *radix_thread_main(void *j) {
+	radix_worker((struct radix_job *) j);
+	return NULL;
+}
+#endif
+
+/* Starts a thread for each slice after the first. Each joins the barrier
+   before it starts, and none can pass it before the calling thread comes,
+   so one that fails to start simply leaves; its slice and those after it
+   are then done on the calling thread. */
+static void radix_crew_start(struct radix_crew *c, struct radix_job *jobs, u32 count) {
+	u32 t;
+	c->workers = 0;
+	c->count = 1;
+	c->waiting = 0;
+	c->round = 0;
+	if (!radix_sync_init(&c->lock, &c->wake))
+		return;
+	for (t = 1; t < count; ++t) {
+		radix_lock(&c->lock);
+		++c->count;
+		radix_unlock(&c->lock);
+		if (!radix_thread_start(&c->threads[t], &jobs[t])) {
+			radix_lock(&c->lock);
+			--c->count;
+			radix_unlock(&c->lock);
+			break;
+		}
+		++c->workers;
+	}
+	if (c->workers == 0)
+		radix_sync_destroy(&c->lock, &c->wake);
+}
+
+static void radix_crew_stop(struct radix_crew *c, struct radix_pass *p) {
+	u32 t;
+	if (c->workers == 0)
+		return;
+	p->phase = RADIX_STOP;
+	radix_barrier_wait(c);
+	for (t = 1; t <= c->workers; ++t)
+		radix_thread_join(c->threads[t]);
+	radix_sync_destroy(&c->lock, &c->wake);
+}
+#endif
+
+/* Runs the current phase on every slice, the first on the calling thread,
+   and returns when all are done. Slices without a thread are done here
+   too, so running out of threads only costs time. */
+static void radix_run(struct radix_job *jobs, u32 count) {
+	u32 t, first = 1;
+#if defined(_sort_threads)
+	struct radix_crew *c = jobs[0].pass->crew;
+	if (c != NULL && c->workers > 0) {
+		first += c->workers;
+		radix_barrier_wait(c);
+	}
+#endif
+	radix_job_run(&jobs[0]);
+	for (t = first; t < count; ++t)
+		radix_job_run(&jobs[t]);
+#if defined(_sort_threads)
+	if (c != NULL && c->workers > 0)
+		radix_barrier_wait(c);
+#endif
+}
+
+/* Whether every key has the same value in byte d, which makes its pass a
+   plain copy. The first value seen decides it. */
+static bool radix_uniform(const struct radix_job *jobs, u32 count, u32 d, size_t n) {
+	u32 b, t;
+	for (b = 0; b < RADIX_BUCKETS; ++b) {
+		size_t c = 0;
+		for (t = 0; t < count; ++t)
+			c += jobs[t].hist[d][b];
+		if (c != 0)
+			return c == n;
+	}
+	return true;
+}
+
+static bool radix_sort(u8 *keys, u32 *vals, u8 *tmp, u32 *tmpvals, size_t n, u32 width, u32 kind, u32 threads) {
+	struct radix_pass p;
+	struct radix_job one, *jobs = &one;
+#if defined(_sort_threads)
+	struct radix_crew crew;
+#endif
+	void *alloc = NULL;
+	size_t slice;
+	u32 count = 1, d, t;
+	bool moved = false;
+
+	p.width = width;
+	p.kind = kind;
+	p.pairs = vals != NULL;
+	p.crew = NULL;
+	one.pass = &p;
+	if (n <= RADIX_SMALL) {
+		p.dst = keys;
+		p.dstvals = vals;
+		p.phase = RADIX_INSERT;
+		one.begin = 0;
+		one.end = n;
+		radix_job_run(&one);
+		return true;
+	}
+
+	if (tmp == NULL || (p.pairs && tmpvals == NULL)) {
+		alloc = malloc(n * (width + (p.pairs ? 4 : 0)));
+		if (alloc == NULL)
+			return false;
+		tmp = (u8 *) alloc;
+		tmpvals = p.pairs ? (u32 *) (tmp + n * width) : NULL;
+	}
+
+	if (threads > 1 && n / RADIX_SORT_GRAIN > 1) {
+		count = threads < RADIX_MAX_THREADS ? threads : RADIX_MAX_THREADS;
+		if (count > n / RADIX_SORT_GRAIN)
+			count = (u32) (n / RADIX_SORT_GRAIN);
+		jobs = (struct radix_job *) malloc(count * sizeof *jobs);
+		if (jobs == NULL) {
+			jobs = &one;
+			count = 1;
+		}
+	}
+	slice = n / count;
+	for (t = 0; t < count; ++t) {
+		jobs[t].pass = &p;
+		jobs[t].begin = slice * t;
+		jobs[t].end = t + 1 < count ? slice * (t + 1) : n;
+	}
+#if defined(_sort_threads)
+	if (count > 1) {
+		p.crew = &crew;
+		radix_crew_start(&crew, jobs, count);
+	}
+#endif
+
+	/* The first count covers every byte. The totals per byte stay the same
+	   from pass to pass, but with more than one slice each slice's own
+	   counts change as keys move, so those are taken again. */
+	p.src = keys;
+	p.srcvals = vals;
+	p.dst = tmp;
+	p.dstvals = tmpvals;
+	p.phase = RADIX_COUNT_ALL;
+	radix_run(jobs, count);
+	for (d = 0; d < width; ++d) {
+		size_t at = 0;
+		u32 b;
+		u8 *swap;
+		u32 *swapvals;
+		if (radix_uniform(jobs, count, d, n))
+			continue;
+		p.digit = d;
+		if (count > 1 && moved) {
+			p.phase = RADIX_COUNT;
+			radix_run(jobs, count);
+		}
+		for (b = 0; b < RADIX_BUCKETS; ++b)
+			for (t = 0; t < count; ++t) {
+				jobs[t].pos[b] = at;
+				at += jobs[t].hist[d][b];
+			}
+		p.phase = RADIX_SCATTER;
+		radix_run(jobs, count);
+		swap = p.src, p.src = p.dst, p.dst = swap;
+		swapvals = p.srcvals, p.srcvals = p.dstvals, p.dstvals = swapvals;
+		moved = true;
+	}
+
+#if defined(_sort_threads)
+	if (p.crew != NULL)
+		radix_crew_stop(&crew, &p);
+#endif
+	if (p.src != keys) {
+		memcpy(keys, p.src, n * width);
+		if (p.pairs)
+			memcpy(vals, p.srcvals, n * sizeof *vals);
+	}
+	if (jobs != &one)
+		free(jobs);
+	free(alloc);
+	return true;
+}
+
+bool radix_sort_u32(u32 *keys, u32 *tmp, size_t n, u32 threads) { return radix_sort((u8 *) keys, NULL, (u8 *) tmp, NULL, n, 4, RADIX_UINT, threads); }
+bool radix_sort_s32(s32 *keys, s32 *tmp, size_t n, u32 threads) { return radix_sort((u8 *) keys, NULL, (u8 *) tmp, NULL, n, 4, RADIX_SINT, threads); }
+bool radix_sort_f32(f32 *keys, f32 *tmp, size_t n, u32 threads) { return radix_sort((u8 *) keys, NULL, (u8 *) tmp, NULL, n, 4, RADIX_FLOAT, threads); }
+bool radix_sort_u64(u64 *keys, u64 *tmp, size_t n, u32 threads) { return radix_sort((u8 *) keys, NULL, (u8 *) tmp, NULL, n, 8, RADIX_UINT, threads); }
+bool radix_sort_s64(s64 *keys, s64 *tmp, size_t n, u32 threads) { return radix_sort((u8 *) keys, NULL, (u8 *) tmp, NULL, n, 8, RADIX_SINT, threads); }
+bool radix_sort_f64(f64 *keys, f64 *tmp, size_t n, u32 threads) { return radix_sort((u8 *) keys, NULL, (u8 *) tmp, NULL, n, 8, RADIX_FLOAT, threads); }
+
+bool radix_sort_u32_pairs(u32 *keys, u32 *vals, u32 *tmp, u32 *tmpvals, size_t n, u32 threads) {
+	return radix_sort((u8 *) keys, vals, (u8 *) tmp, tmpvals, n, 4, RADIX_UINT, threads);
+}
+
+bool radix_sort_s32_pairs(s32 *keys, u32 *vals, s32 *tmp, u32 *tmpvals, size_t n, u32 threads) {
+	return radix_sort((u8 *) keys, vals, (u8 *) tmp, tmpvals, n, 4, RADIX_SINT, threads);
+}
+
+bool radix_sort_f32_pairs(f32 *keys, u32 *vals, f32 *tmp, u32 *tmpvals, size_t n, u32 threads) {
+	return radix_sort((u8 *) keys, vals, (u8 *) tmp, tmpvals, n, 4, RADIX_FLOAT, threads);
+}
+
+bool radix_sort_u64_pairs(u64 *keys, u32 *vals, u64 *tmp, u32 *tmpvals, size_t n, u32 threads) {
+	return radix_sort((u8 *) keys, vals, (u8 *) tmp, tmpvals, n, 8, RADIX_UINT, threads);
+}
+
+bool radix_sort_s64_pairs(s64 *keys, u32 *vals, s64 *tmp, u32 *tmpvals, size_t n, u32 threads) {
+	return radix_sort((u8 *) keys, vals, (u8 *) tmp, tmpvals, n, 8, RADIX_SINT, threads);
+}
+
+bool radix_sort_f64_pairs(f64 *keys, u32 *vals, f64 *tmp, u32 *tmpvals, size_t n, u32 threads) {
+	return radix_sort((u8 *) keys, vals, (u8 *) tmp, tmpvals, n, 8, RADIX_FLOAT, threads);
+}
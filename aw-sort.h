@@ -0,0 +1,99 @@
+
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+#ifndef AW_SORT_H
+#define AW_SORT_H
+
+#include "aw-types.h"
+
+#if !defined(_MSC_VER) || _MSC_VER >= 1800
+# include <stdbool.h>
+#endif
+#include <stddef.h>
+
+#if defined(_sort_dllexport)
+# if defined(_MSC_VER)
+#  define _sort_api extern __declspec(dllexport)
+# elif defined(__GNUC__)
+#  define _sort_api __attribute__((visibility("default"))) extern
+# endif
+#elif defined(_sort_dllimport)
+# if defined(_MSC_VER)
+#  define _sort_api extern __declspec(dllimport)
+# endif
+#endif
+#ifndef _sort_api
+# define _sort_api extern
+#endif
+
+#if defined(__GNUC__)
+# define _sort_alwaysinline __attribute__((always_inline)) inline
+#elif defined(_MSC_VER)
+# define _sort_alwaysinline __forceinline
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Stable least-significant-digit radix sorts, one byte of the key per
+   pass. A first pass counts every byte position at once; positions where
+   all keys share the same byte are skipped, so keys that span a narrow
+   range cost fewer passes. The passes move the keys back and forth between
+   keys and tmp, and the result always ends up in keys.
+
+   Signed keys sort in numeric order. Floats sort by sgnflip of their bits,
+   which is numeric order with -0 before +0, negative NaNs first and
+   positive NaNs last.
+
+   tmp must hold n keys and not overlap them. When it is NULL it is
+   allocated for the call, and false is returned only if that fails.
+
+   threads is the most threads to sort with, counting the caller. Each
+   counts and scatters its own slice of the array, and each pass waits for
+   them all; slices under RADIX_SORT_GRAIN keys are not worth a thread, so
+   smaller arrays use fewer. 0 and 1 sort on the calling thread. */
+#define RADIX_SORT_GRAIN 65536
+
+_sort_api bool radix_sort_u32(u32 *keys, u32 *tmp, size_t n, u32 threads);
+_sort_api bool radix_sort_s32(s32 *keys, s32 *tmp, size_t n, u32 threads);
+_sort_api bool radix_sort_f32(f32 *keys, f32 *tmp, size_t n, u32 threads);
+_sort_api bool radix_sort_u64(u64 *keys, u64 *tmp, size_t n, u32 threads);
+_sort_api bool radix_sort_s64(s64 *keys, s64 *tmp, size_t n, u32 threads);
+_sort_api bool radix_sort_f64(f64 *keys, f64 *tmp, size_t n, u32 threads);
+
+/* The same, carrying a 32-bit value along with each key, such as an index
+   into the records the keys came from. Keys that compare equal keep their
+   values in the original order. tmp and tmpvals are allocated together
+   when either is NULL. */
+_sort_api bool radix_sort_u32_pairs(u32 *keys, u32 *vals, u32 *tmp, u32 *tmpvals, size_t n, u32 threads);
+_sort_api bool radix_sort_s32_pairs(s32 *keys, u32 *vals, s32 *tmp, u32 *tmpvals, size_t n, u32 threads);
+_sort_api bool radix_sort_f32_pairs(f32 *keys, u32 *vals, f32 *tmp, u32 *tmpvals, size_t n, u32 threads);
+_sort_api bool radix_sort_u64_pairs(u64 *keys, u32 *vals, u64 *tmp, u32 *tmpvals, size_t n, u32 threads);
+_sort_api bool radix_sort_s64_pairs(s64 *keys, u32 *vals, s64 *tmp, u32 *tmpvals, size_t n, u32 threads);
+_sort_api bool radix_sort_f64_pairs(f64 *keys, u32 *vals, f64 *tmp, u32 *tmpvals, size_t n, u32 threads);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* AW_SORT_H */
@@ -36,10 +36,26 @@
 #endif /* _strings_nofeatures */
 
 #include "aw-strings.h"
+#include "aw-cpu.h"
+#include "aw-format.h"
+#include "aw-hash.h"
 
 #include <stdio.h>
-#if !defined(_WIN32)
-# include <strings.h>
+#include <stdlib.h>
+
+/* Scans read whole aligned blocks past the end of the data, which cannot
+   fault but which AddressSanitizer would report. */
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5)
+# define _strings_nosanitize __attribute__((no_sanitize_address))
+#else
+# define _strings_nosanitize
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define _strings_sse2 1
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(_M_ARM64EC)
+# include <arm_neon.h>
+# define _strings_neon 1
 #endif
 
 int _vstrscanf(const char *__restrict str, const char *__restrict format, va_list ap) {
@@ -126,32 +142,670 @@ bool _strcat(char* dst, size_t dstsize, const char* src) {
 #endif
 }
 
-int _strcasecmp(const char *s1, const char *s2) {
-#if !defined(_WIN32)
-	return strcasecmp(s1, s2);
+_strings_alwaysinline static u32 strings_fold(u8 c) { return c + ((u32) (u8) (c - 'A') < 26 ? 0x20 : 0); }
+
+_strings_alwaysinline static u32 strings_ctz(u64 a) {
+#if defined(__GNUC__)
+	return (u32) __builtin_ctzll(a);
+#elif defined(_M_X64) || defined(_M_ARM64) || defined(_M_ARM64EC)
+	unsigned long r;
+	_BitScanForward64(&r, a);
+	return (u32) r;
 #else
-	return _stricmp(s1, s2);
+	u32 r = 0;
+	for (; (a & 1) == 0; a >>= 1)
+		++r;
+	return r;
 #endif
 }
 
-int _strncasecmp(const char *s1, const char *s2, size_t n) {
-#if !defined(_WIN32)
-	return strncasecmp(s1, s2, n);
+/* 16-byte blocks compare into a bit mask with STRINGS_BITS bits per byte:
+   one from movemask on SSE2, four from a narrowing shift on NEON. */
+#if defined(_strings_sse2)
+# define STRINGS_BITS 1
+# define STRINGS_SHIFT 0
+typedef __m128i strings_vec;
+
+_strings_alwaysinline static strings_vec strings_load(const u8 *p) { return _mm_load_si128((const __m128i *) p); }
+_strings_alwaysinline static strings_vec strings_loadu(const u8 *p) { return _mm_loadu_si128((const __m128i *) p); }
+_strings_alwaysinline static strings_vec strings_set1(u8 c) { return _mm_set1_epi8((char) c); }
+_strings_alwaysinline static u64 strings_eq(strings_vec a, strings_vec b) { return (u32) _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)); }
+
+_strings_alwaysinline static strings_vec strings_foldv(strings_vec a) {
+	__m128i upper = _mm_cmplt_epi8(_mm_add_epi8(a, _mm_set1_epi8((char) (0x80 - 'A'))), _mm_set1_epi8(-0x80 + 26));
+	return _mm_add_epi8(a, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+#elif defined(_strings_neon)
+# define STRINGS_BITS 4
+# define STRINGS_SHIFT 2
+typedef uint8x16_t strings_vec;
+
+_strings_alwaysinline static strings_vec strings_load(const u8 *p) { return vld1q_u8(p); }
+_strings_alwaysinline static strings_vec strings_loadu(const u8 *p) { return vld1q_u8(p); }
+_strings_alwaysinline static strings_vec strings_set1(u8 c) { return vdupq_n_u8(c); }
+
+_strings_alwaysinline static u64 strings_eq(strings_vec a, strings_vec b) {
+	return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(vceqq_u8(a, b)), 4)), 0);
+}
+
+_strings_alwaysinline static strings_vec strings_foldv(strings_vec a) {
+	uint8x16_t upper = vcltq_u8(vsubq_u8(a, vdupq_n_u8('A')), vdupq_n_u8(26));
+	return vaddq_u8(a, vandq_u8(upper, vdupq_n_u8(0x20)));
+}
+#endif
+
+#if defined(_strings_sse2) || defined(_strings_neon)
+# define STRINGS_FULL (STRINGS_BITS == 1 ? imm_u64(0xffff) : ~imm_u64(0))
+# define STRINGS_LANE ((imm_u64(1) << STRINGS_BITS) - 1)
+
+/* Returns the offset of the first c in s[0..n), or n. The first block is
+   loaded from the aligned address below s and shifted into place. */
+_strings_nosanitize
+static size_t strings_scan_vec(const u8 *s, size_t n, u8 c) {
+	const strings_vec v = strings_set1(c);
+	size_t off = (uintptr_t) s & 15;
+	size_t i = 0;
+	u64 m = strings_eq(strings_load(s - off), v) >> (off * STRINGS_BITS);
+	if (m == 0)
+		for (i = 16 - off; i < n; i += 16)
+			if ((m = strings_eq(strings_load(s + i), v)) != 0)
+				break;
+	if (m != 0)
+		i += strings_ctz(m) >> STRINGS_SHIFT;
+	return i < n ? i : n;
+}
+
+/* Blocks of both strings are compared while neither crosses a page, so
+   reading past a terminator cannot fault; near page ends it goes bytewise. */
+_strings_nosanitize
+static int strings_casecmp(const u8 *a, const u8 *b, size_t n, bool term) {
+	const strings_vec zero = strings_set1(0);
+	size_t i = 0;
+	while (i < n) {
+		if ((term && (((uintptr_t) (a + i) & 4095) > 4096 - 16 || ((uintptr_t) (b + i) & 4095) > 4096 - 16)) ||
+				(!term && n - i < 16)) {
+			u32 c1 = strings_fold(a[i]);
+			u32 c2 = strings_fold(b[i]);
+			if (c1 != c2 || (term && c1 == 0))
+				return (int) c1 - (int) c2;
+			++i;
+		} else {
+			strings_vec x = strings_loadu(a + i);
+			strings_vec y = strings_loadu(b + i);
+			u64 m = ~strings_eq(strings_foldv(x), strings_foldv(y)) & STRINGS_FULL;
+			if (term)
+				m |= strings_eq(x, zero);
+			if (m == 0) {
+				i += 16;
+				continue;
+			}
+			i += strings_ctz(m) >> STRINGS_SHIFT;
+			if (i >= n)
+				return 0;
+			return (int) strings_fold(a[i]) - (int) strings_fold(b[i]);
+		}
+	}
+	return 0;
+}
+
+/* Candidates are positions whose first and last bytes match those of the
+   needle; only they are compared in full. Returns the first match found in
+   whole blocks, or NULL with *next set to where the blocks stopped. */
+static const u8 *strings_casemem_vec(const u8 *h, size_t hsize, const u8 *nd, size_t nsize, size_t *next) {
+	const strings_vec first = strings_set1((u8) strings_fold(nd[0]));
+	const strings_vec last = strings_set1((u8) strings_fold(nd[nsize - 1]));
+	size_t i = 0;
+	for (; i + nsize - 1 + 16 <= hsize; i += 16) {
+		u64 m = strings_eq(strings_foldv(strings_loadu(h + i)), first) &
+			strings_eq(strings_foldv(strings_loadu(h + i + nsize - 1)), last);
+		while (m != 0) {
+			u32 j = strings_ctz(m) >> STRINGS_SHIFT;
+			if (nsize <= 2 || strings_casecmp(h + i + j + 1, nd + 1, nsize - 2, false) == 0)
+				return h + i + j;
+			m &= ~(STRINGS_LANE << (j * STRINGS_BITS));
+		}
+	}
+	*next = i;
+	return NULL;
+}
 #else
-	return _strnicmp(s1, s2, n);
+static size_t strings_scan_vec(const u8 *s, size_t n, u8 c) {
+	size_t i = 0;
+	for (; i < n && s[i] != c; ++i)
+		;
+	return i;
+}
+
+static int strings_casecmp(const u8 *a, const u8 *b, size_t n, bool term) {
+	size_t i = 0;
+	for (; i < n; ++i) {
+		u32 c1 = strings_fold(a[i]);
+		u32 c2 = strings_fold(b[i]);
+		if (c1 != c2 || (term && c1 == 0))
+			return (int) c1 - (int) c2;
+	}
+	return 0;
+}
+
+static const u8 *strings_casemem_vec(const u8 *h, size_t hsize, const u8 *nd, size_t nsize, size_t *next) {
+	(void) h, (void) hsize, (void) nd, (void) nsize;
+	*next = 0;
+	return NULL;
+}
 #endif
+
+typedef size_t (*strings_scan_fn)(const u8 *s, size_t n, u8 c);
+typedef const u8 *(*strings_casemem_fn)(const u8 *h, size_t hsize, const u8 *nd, size_t nsize, size_t *next);
+
+#if defined(_cpu_dispatch_x86) && defined(_strings_sse2)
+_strings_nosanitize
+_cpu_target("avx2")
+static size_t strings_scan_avx2(const u8 *s, size_t n, u8 c) {
+	const __m256i v = _mm256_set1_epi8((char) c);
+	size_t off = (uintptr_t) s & 31;
+	size_t i = 0;
+	u32 m = (u32) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i *) (s - off)), v)) >> off;
+	if (m == 0)
+		for (i = 32 - off; i < n; i += 32)
+			if ((m = (u32) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i *) (s + i)), v))) != 0)
+				break;
+	if (m != 0)
+		i += strings_ctz(m);
+	return i < n ? i : n;
 }
 
-const char *_strcasestr(const char *haystack, const char *needle) {
-#if !defined(_WIN32) && !defined(__ORBIS__) && !defined(__PROSPERO__)
-	return strcasestr(haystack, needle);
+_cpu_target("avx2")
+static __m256i strings_foldv_avx2(__m256i a) {
+	__m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(-0x80 + 26), _mm256_add_epi8(a, _mm256_set1_epi8((char) (0x80 - 'A'))));
+	return _mm256_add_epi8(a, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+
+_cpu_target("avx2")
+static const u8 *strings_casemem_avx2(const u8 *h, size_t hsize, const u8 *nd, size_t nsize, size_t *next) {
+	const __m256i first = _mm256_set1_epi8((char) strings_fold(nd[0]));
+	const __m256i last = _mm256_set1_epi8((char) strings_fold(nd[nsize - 1]));
+	size_t i = 0;
+	for (; i + nsize - 1 + 32 <= hsize; i += 32) {
+		__m256i a = strings_foldv_avx2(_mm256_loadu_si256((const __m256i *) (h + i)));
+		__m256i b = strings_foldv_avx2(_mm256_loadu_si256((const __m256i *) (h + i + nsize - 1)));
+		u32 m = (u32) _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last)));
+		for (; m != 0; m &= m - 1) {
+			u32 j = strings_ctz(m);
+			if (nsize <= 2 || strings_casecmp(h + i + j + 1, nd + 1, nsize - 2, false) == 0)
+				return h + i + j;
+		}
+	}
+	*next = i;
+	return NULL;
+}
+
+static size_t strings_scan_resolve(const u8 *s, size_t n, u8 c);
+static const u8 *strings_casemem_resolve(const u8 *h, size_t hsize, const u8 *nd, size_t nsize, size_t *next);
+static _cpu_ptr(strings_scan_fn) strings_scan_kernel_ptr = strings_scan_resolve;
+#define strings_scan_kernel _cpu_load_ptr(strings_scan_kernel_ptr)
+static _cpu_ptr(strings_casemem_fn) strings_casemem_kernel_ptr = strings_casemem_resolve;
+#define strings_casemem_kernel _cpu_load_ptr(strings_casemem_kernel_ptr)
+
+static size_t strings_scan_resolve(const u8 *s, size_t n, u8 c) {
+	strings_scan_fn fn = cpu_has(CPU_AVX2) ? strings_scan_avx2 : strings_scan_vec;
+	_cpu_store_ptr(strings_scan_kernel_ptr, fn);
+	return fn(s, n, c);
+}
+
+static const u8 *strings_casemem_resolve(const u8 *h, size_t hsize, const u8 *nd, size_t nsize, size_t *next) {
+	strings_casemem_fn fn = cpu_has(CPU_AVX2) ? strings_casemem_avx2 : strings_casemem_vec;
+	_cpu_store_ptr(strings_casemem_kernel_ptr, fn);
+	return fn(h, hsize, nd, nsize, next);
+}
 #else
-	strings_ssize_t h = (strings_ssize_t) (haystack ? strlen(haystack) : 0);
-	strings_ssize_t n = (strings_ssize_t) (needle ? strlen(needle) : 0);
-	for (; h >= n; --h, ++haystack)
-		if (_strncasecmp(haystack, needle, n) == 0)
-			return haystack;
+# define strings_scan_kernel strings_scan_vec
+# define strings_casemem_kernel strings_casemem_vec
+#endif
+
+static size_t strings_scan(const u8 *s, size_t n, u8 c) {
+	if (n == 0)
+		return 0;
+	return strings_scan_kernel(s, n, c);
+}
+
+int _strcasecmp(const char *s1, const char *s2) {
+	return strings_casecmp((const u8 *) s1, (const u8 *) s2, SIZE_MAX, true);
+}
+
+int _strncasecmp(const char *s1, const char *s2, size_t n) {
+	return strings_casecmp((const u8 *) s1, (const u8 *) s2, n, true);
+}
+
+int _memcasecmp(const void *s1, const void *s2, size_t n) {
+	return strings_casecmp((const u8 *) s1, (const u8 *) s2, n, false);
+}
+
+const void *_memcasemem(const void *haystack, size_t hsize, const void *needle, size_t nsize) {
+	const u8 *h = (const u8 *) haystack;
+	const u8 *nd = (const u8 *) needle;
+	const u8 *p;
+	size_t i;
+	if (nsize == 0)
+		return h;
+	if (nsize > hsize)
+		return NULL;
+	if ((p = strings_casemem_kernel(h, hsize, nd, nsize, &i)) != NULL)
+		return p;
+	for (; i + nsize <= hsize; ++i)
+		if (strings_casecmp(h + i, nd, nsize, false) == 0)
+			return h + i;
 	return NULL;
+}
+
+const char *_strcasestr(const char *haystack, const char *needle) {
+	if (haystack == NULL || needle == NULL)
+		return NULL;
+	return (const char *) _memcasemem(haystack, _strlen(haystack), needle, _strlen(needle));
+}
+
+size_t _strlen(const char *str) {
+	return strings_scan((const u8 *) str, SIZE_MAX, 0);
+}
+
+size_t _strnlen(const char *str, size_t n) {
+	return strings_scan((const u8 *) str, n, 0);
+}
+
+const void *_memchr(const void *ptr, int c, size_t n) {
+	size_t i = strings_scan((const u8 *) ptr, n, (u8) c);
+	return i < n ? (const u8 *) ptr + i : NULL;
+}
+
+int strview_cmp(struct strview a, struct strview b) {
+	size_t n = a.len < b.len ? a.len : b.len;
+	int r = n != 0 ? memcmp(a.ptr, b.ptr, n) : 0;
+	return r != 0 ? r : (a.len > b.len) - (a.len < b.len);
+}
+
+int strview_casecmp(struct strview a, struct strview b) {
+	size_t n = a.len < b.len ? a.len : b.len;
+	int r = strings_casecmp((const u8 *) a.ptr, (const u8 *) b.ptr, n, false);
+	return r != 0 ? r : (a.len > b.len) - (a.len < b.len);
+}
+
+size_t strview_findchr(struct strview v, char c) {
+	size_t i = strings_scan((const u8 *) v.ptr, v.len, (u8) c);
+	return i < v.len ? i : STRVIEW_NPOS;
+}
+
+size_t strview_rfindchr(struct strview v, char c) {
+	size_t i = v.len;
+	while (i-- != 0)
+		if (v.ptr[i] == c)
+			return i;
+	return STRVIEW_NPOS;
+}
+
+size_t strview_find(struct strview v, struct strview needle) {
+	size_t i = 0;
+	if (needle.len == 0)
+		return 0;
+	while (needle.len <= v.len - i) {
+		size_t j = strings_scan((const u8 *) v.ptr + i, v.len - i - needle.len + 1, (u8) needle.ptr[0]);
+		if (j == v.len - i - needle.len + 1)
+			break;
+		i += j;
+		if (memcmp(v.ptr + i + 1, needle.ptr + 1, needle.len - 1) == 0)
+			return i;
+		++i;
+	}
+	return STRVIEW_NPOS;
+}
+
+size_t strview_casefind(struct strview v, struct strview needle) {
+	const char *p = (const char *) _memcasemem(v.ptr, v.len, needle.ptr, needle.len);
+	return p != NULL ? (size_t) (p - v.ptr) : STRVIEW_NPOS;
+}
+
+_strings_alwaysinline static bool strings_space(char c) { return c == ' ' || (u32) (u8) (c - '\t') < 5; }
+
+struct strview strview_ltrim(struct strview v) {
+	while (v.len != 0 && strings_space(v.ptr[0]))
+		++v.ptr, --v.len;
+	return v;
+}
+
+struct strview strview_rtrim(struct strview v) {
+	while (v.len != 0 && strings_space(v.ptr[v.len - 1]))
+		--v.len;
+	return v;
+}
+
+struct strview strview_trim(struct strview v) {
+	return strview_rtrim(strview_ltrim(v));
+}
+
+bool strsplit_next(struct strsplit *s, struct strview *token) {
+	struct strview v = s->rest;
+	size_t i;
+	if (s->done)
+		return false;
+	i = strings_scan((const u8 *) v.ptr, v.len, (u8) s->sep);
+	*token = strview_make(v.ptr, i);
+	if (i < v.len) {
+		s->rest = strview_make(v.ptr + i + 1, v.len - i - 1);
+	} else {
+		s->rest.len = 0;
+		s->done = true;
+	}
+	return true;
+}
+
+uint64_t strview_hash(struct strview v) {
+	return hash64(v.ptr, v.len, 0);
+}
+
+uint64_t strview_casehash(struct strview v) {
+	return hash64_case(v.ptr, v.len, 0);
+}
+
+bool strview_copy(char *dst, size_t dstsize, struct strview v) {
+	bool trunc = false;
+	if (dst == NULL || dstsize == 0)
+		return false;
+	if (v.len > dstsize - 1) {
+		v.len = dstsize - 1;
+		trunc = true;
+	}
+	if (v.len != 0)
+		memcpy(dst, v.ptr, v.len);
+	dst[v.len] = 0;
+	return !trunc;
+}
+
+enum {
+	STRBUF_HEAP,
+	STRBUF_FIXED,
+	STRBUF_ARENA,
+};
+
+void strbuf_init(struct strbuf *b) {
+	b->ptr = NULL;
+	b->len = 0;
+	b->cap = 0;
+	b->arena = NULL;
+	b->mode = STRBUF_HEAP;
+	b->trunc = false;
+}
+
+void strbuf_init_fixed(struct strbuf *b, char *buf, size_t size) {
+	strbuf_init(b);
+	b->ptr = buf;
+	b->cap = size;
+	b->mode = STRBUF_FIXED;
+	if (size != 0)
+		buf[0] = 0;
+}
+
+void strbuf_init_arena(struct strbuf *b, struct strarena *arena) {
+	strbuf_init(b);
+	b->arena = arena;
+	b->mode = STRBUF_ARENA;
+}
+
+/* Arena memory is only given back when it is the last allocation. */
+void strbuf_free(struct strbuf *b) {
+	if (b->mode == STRBUF_HEAP)
+		free(b->ptr);
+	else if (b->mode == STRBUF_ARENA && b->ptr + b->cap == b->arena->base + b->arena->used)
+		b->arena->used -= b->cap;
+	if (b->mode != STRBUF_FIXED) {
+		b->ptr = NULL;
+		b->cap = 0;
+	}
+	strbuf_reset(b);
+}
+
+/* Grows to at least twice the capacity; an arena builder that was the last
+   allocation grows in place. Returns the new capacity, which may fall short
+   of need when memory runs out. */
+static size_t strbuf_grow(struct strbuf *b, size_t need) {
+	size_t cap = b->cap * 2 > need ? b->cap * 2 : need;
+	char *p;
+	if (cap < 64)
+		cap = 64;
+	if (b->mode == STRBUF_HEAP) {
+		if ((p = (char *) realloc(b->ptr, cap)) == NULL)
+			return b->cap;
+	} else if (b->mode == STRBUF_ARENA) {
+		struct strarena *a = b->arena;
+		size_t avail = a->size - a->used;
+		if (b->ptr != NULL && b->ptr + b->cap == a->base + a->used) {
+			if (cap - b->cap > avail)
+				cap = b->cap + avail;
+			a->used += cap - b->cap;
+			return b->cap = cap;
+		}
+		if (cap > avail)
+			cap = avail;
+		if (cap <= b->cap)
+			return b->cap;
+		p = a->base + a->used;
+		a->used += cap;
+		if (b->cap != 0)
+			memcpy(p, b->ptr, b->len + 1);
+	} else
+		return b->cap;
+	if (b->cap == 0)
+		p[0] = 0;
+	b->ptr = p;
+	return b->cap = cap;
+}
+
+size_t strbuf_reserve(struct strbuf *b, size_t n) {
+	if (b->len + n + 1 > b->cap)
+		strbuf_grow(b, b->len + n + 1);
+	return b->cap != 0 ? b->cap - b->len - 1 : 0;
+}
+
+bool strbuf_append(struct strbuf *b, struct strview v) {
+	size_t n = strbuf_reserve(b, v.len);
+	if (n < v.len) {
+		v.len = n;
+		b->trunc = true;
+	}
+	if (v.len != 0) {
+		memcpy(b->ptr + b->len, v.ptr, v.len);
+		b->len += v.len;
+		b->ptr[b->len] = 0;
+	}
+	return !b->trunc;
+}
+
+bool strbuf_putc(struct strbuf *b, char c) {
+	if (b->len + 1 < b->cap || strbuf_reserve(b, 1) != 0) {
+		b->ptr[b->len++] = c;
+		b->ptr[b->len] = 0;
+	} else
+		b->trunc = true;
+	return !b->trunc;
+}
+
+bool strbuf_puts(struct strbuf *b, const char *str) {
+	return strbuf_append(b, strview_cstr(str));
+}
+
+bool strbuf_append_u64(struct strbuf *b, uint64_t value) {
+	char tmp[FORMAT_MAX_U64];
+	return strbuf_append(b, strview_make(tmp, format_u64(tmp, value)));
+}
+
+bool strbuf_append_s64(struct strbuf *b, int64_t value) {
+	char tmp[FORMAT_MAX_S64];
+	return strbuf_append(b, strview_make(tmp, format_s64(tmp, value)));
+}
+
+bool strbuf_append_f64(struct strbuf *b, double value) {
+	char tmp[FORMAT_MAX_F64];
+	return strbuf_append(b, strview_make(tmp, format_f64(tmp, value)));
+}
+
+bool strbuf_vprintf(struct strbuf *b, const char *__restrict format, va_list ap) {
+	size_t room = b->cap != 0 ? b->cap - b->len : 0;
+	va_list aq;
+	int n;
+	va_copy(aq, ap);
+	n = vsnprintf(room != 0 ? b->ptr + b->len : NULL, room, format, ap);
+	if (n >= 0 && (size_t) n >= room) {
+		room = strbuf_reserve(b, (size_t) n);
+		if (room < (size_t) n)
+			b->trunc = true;
+		if (b->cap != 0)
+			vsnprintf(b->ptr + b->len, (room < (size_t) n ? room : (size_t) n) + 1, format, aq);
+		else
+			n = 0;
+		if (room < (size_t) n)
+			n = (int) room;
+	}
+	va_end(aq);
+	if (n < 0) {
+		b->trunc = true;
+		n = 0;
+		if (b->cap != 0)
+			b->ptr[b->len] = 0;
+	}
+	b->len += (size_t) n;
+	return !b->trunc;
+}
+
+bool strbuf_printf(struct strbuf *b, const char *__restrict format, ...) {
+	va_list ap;
+	va_start(ap, format);
+	bool ok = strbuf_vprintf(b, format, ap);
+	va_end(ap);
+	return ok;
+}
+
+#if defined(__GNUC__)
+# define strintern_load(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+# define strintern_load_ptr(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+# define strintern_store_ptr(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+# define strintern_cas(p, e, d) __atomic_compare_exchange_n((p), &(e), (d), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#else
+/* Volatile accesses acquire and release under MSVC's default /volatile:ms. */
+# define strintern_load(p) (*(volatile const u64 *) (p))
+# define strintern_load_ptr(p) (*(const char *volatile const *) (p))
+# define strintern_store_ptr(p, v) (*(const char *volatile *) (p) = (v))
+_strings_alwaysinline static bool strintern_cas_msvc(u64 *p, u64 *e, u64 d) {
+	u64 old = (u64) _InterlockedCompareExchange64((volatile __int64 *) p, (__int64) d, (__int64) *e);
+	bool ok = old == *e;
+	*e = old;
+	return ok;
+}
+# define strintern_cas(p, e, d) strintern_cas_msvc((p), &(e), (d))
 #endif
+
+/* Takes n from the counter at p unless that would pass max. */
+static bool strintern_take(u64 *p, u64 n, u64 max, u64 *old) {
+	u64 v = strintern_load(p);
+	do {
+		if (n > max - v)
+			return false;
+	} while (!strintern_cas(p, v, v + n));
+	*old = v;
+	return true;
 }
 
+/* Gives back what strintern_take took, unless more was taken since. */
+static void strintern_untake(u64 *p, u64 n, u64 old) {
+	u64 v = old + n;
+	strintern_cas(p, v, old);
+}
+
+_strings_alwaysinline static u64 strintern_hash(const struct strintern *t, struct strview s) {
+	return t->nocase ? strview_casehash(s) : strview_hash(s);
+}
+
+_strings_alwaysinline static bool strintern_eq(const struct strintern *t, struct strview a, struct strview b) {
+	return t->nocase ? strview_caseeq(a, b) : strview_eq(a, b);
+}
+
+/* The table is at most half full, so probes stay short and always reach an
+   empty slot. */
+bool strintern_init(struct strintern *t, uint32_t maxstrs, size_t maxbytes, bool nocase) {
+	size_t n = 2;
+	memset(t, 0, sizeof *t);
+	if ((u64) maxstrs * 4 * sizeof *t->slots > SIZE_MAX)
+		return false;
+	while (n < (size_t) maxstrs * 2)
+		n *= 2;
+	t->slots = (u64 *) calloc(n, sizeof *t->slots);
+	t->strs = (struct strview *) calloc(maxstrs != 0 ? maxstrs : 1, sizeof *t->strs);
+	t->bytes = (char *) malloc(maxbytes != 0 ? maxbytes : 1);
+	if (t->slots == NULL || t->strs == NULL || t->bytes == NULL) {
+		strintern_free(t);
+		return false;
+	}
+	t->mask = n - 1;
+	t->maxstrs = maxstrs;
+	t->maxbytes = maxbytes;
+	t->nocase = nocase;
+	return true;
+}
+
+void strintern_free(struct strintern *t) {
+	free(t->slots);
+	free(t->strs);
+	free(t->bytes);
+	memset(t, 0, sizeof *t);
+}
+
+/* Slots hold the upper half of the hash above the handle. A string is
+   copied and given a handle before it is published with a release, so a
+   reader that sees the slot also sees the string. Slots are never cleared,
+   which lets a writer that loses a race for a slot simply check the
+   winner's string and move on. The pointer of each string is stored last,
+   and cleared again for a handle that ends up unused, so strintern_view
+   sees either a whole string or none. */
+uint32_t strintern_add(struct strintern *t, struct strview s) {
+	u64 hash = strintern_hash(t, s), tag = hash >> 32 << 32, slot, h = 0, off;
+	size_t i;
+	for (i = (size_t) hash & t->mask;; i = (i + 1) & t->mask) {
+		slot = strintern_load(&t->slots[i]);
+		while (slot == 0) {
+			if (h == 0) {
+				if (!strintern_take(&t->nbytes, (u64) s.len + 1, t->maxbytes, &off))
+					return STRINTERN_NONE;
+				if (!strintern_take(&t->nstrs, 1, t->maxstrs, &h)) {
+					strintern_untake(&t->nbytes, (u64) s.len + 1, off);
+					return STRINTERN_NONE;
+				}
+				if (s.len != 0)
+					memcpy(t->bytes + off, s.ptr, s.len);
+				t->bytes[off + s.len] = 0;
+				t->strs[h].len = s.len;
+				strintern_store_ptr(&t->strs[h++].ptr, t->bytes + off);
+			}
+			if (strintern_cas(&t->slots[i], slot, tag | h))
+				return (u32) h;
+		}
+		if ((slot & ~imm_u64(0xffffffff)) == tag && strintern_eq(t, t->strs[(u32) slot - 1], s)) {
+			if (h != 0)
+				strintern_store_ptr(&t->strs[h - 1].ptr, NULL);
+			return (u32) slot;
+		}
+	}
+}
+
+uint32_t strintern_find(const struct strintern *t, struct strview s) {
+	u64 hash = strintern_hash(t, s), tag = hash >> 32 << 32, slot;
+	size_t i;
+	for (i = (size_t) hash & t->mask;; i = (i + 1) & t->mask) {
+		if ((slot = strintern_load(&t->slots[i])) == 0)
+			return STRINTERN_NONE;
+		if ((slot & ~imm_u64(0xffffffff)) == tag && strintern_eq(t, t->strs[(u32) slot - 1], s))
+			return (u32) slot;
+	}
+}
+
+struct strview strintern_view(const struct strintern *t, uint32_t h) {
+	const char *ptr;
+	if (h == STRINTERN_NONE || h > strintern_load(&t->nstrs) || (ptr = strintern_load_ptr(&t->strs[h - 1].ptr)) == NULL)
+		return strview_make(NULL, 0);
+	return strview_make(ptr, t->strs[h - 1].len);
+}
@@ -50,6 +50,12 @@
 # define _strings_api extern
 #endif
 
+#if defined(__GNUC__)
+# define _strings_alwaysinline __attribute__((always_inline)) inline
+#elif defined(_MSC_VER)
+# define _strings_alwaysinline __forceinline
+#endif
+
 #if defined(__GNUC__)
 # define _strings_scanformat(a,b) __attribute__((format(__scanf__, a, b)))
 # define _strings_printformat(a,b) __attribute__((format(__printf__, a, b)))
@@ -83,10 +89,223 @@ _strings_api bool _strcpy(char *dst, size_t dstsize, const char *src);
 _strings_api bool _strncpy(char *dst, size_t dstsize, const char *src, size_t n);
 _strings_api bool _strcat(char* dst, size_t dstsize, const char* src);
 
+/* Case-insensitive functions fold ASCII letters only, so they behave the
+   same on every platform and in every locale. The pointer+length variants
+   never scan for a terminator. */
 _strings_api int _strcasecmp(const char *s1, const char *s2);
 _strings_api int _strncasecmp(const char *s1, const char *s2, size_t n);
+_strings_api int _memcasecmp(const void *s1, const void *s2, size_t n);
 
 _strings_api const char *_strcasestr(const char *haystack, const char *needle);
+_strings_api const void *_memcasemem(const void *haystack, size_t hsize, const void *needle, size_t nsize);
+
+/* Scans load whole aligned blocks, which may extend past the terminator or
+   the size but never into another page. */
+_strings_api size_t _strlen(const char *str);
+_strings_api size_t _strnlen(const char *str, size_t n);
+_strings_api const void *_memchr(const void *ptr, int c, size_t n);
+
+/* A view is a pointer and a length into memory owned by someone else, such
+   as a mapped file. No view function allocates or looks for a terminator,
+   and the pointer of an empty view may be anything, including NULL. Offsets
+   are returned as size_t, with STRVIEW_NPOS for not found. */
+struct strview {
+	const char *ptr;
+	size_t len;
+};
+
+#define STRVIEW_NPOS ((size_t) -1)
+#define STRVIEW_LIT(s) strview_make("" s, sizeof(s) - 1)
+
+_strings_alwaysinline static struct strview strview_make(const char *ptr, size_t len) {
+	struct strview v;
+	v.ptr = ptr;
+	v.len = len;
+	return v;
+}
+
+_strings_alwaysinline static struct strview strview_cstr(const char *str) { return strview_make(str, str ? _strlen(str) : 0); }
+_strings_alwaysinline static bool strview_empty(struct strview v) { return v.len == 0; }
+
+/* Sub-views clamp pos and len to the view instead of failing. */
+_strings_alwaysinline static struct strview strview_sub(struct strview v, size_t pos, size_t len) {
+	if (pos > v.len)
+		pos = v.len;
+	if (len > v.len - pos)
+		len = v.len - pos;
+	return strview_make(v.ptr + pos, len);
+}
+
+_strings_alwaysinline static struct strview strview_head(struct strview v, size_t len) { return strview_sub(v, 0, len); }
+_strings_alwaysinline static struct strview strview_tail(struct strview v, size_t pos) { return strview_sub(v, pos, STRVIEW_NPOS); }
+
+_strings_alwaysinline static bool strview_eq(struct strview a, struct strview b) {
+	return a.len == b.len && (a.len == 0 || memcmp(a.ptr, b.ptr, a.len) == 0);
+}
+
+_strings_alwaysinline static bool strview_caseeq(struct strview a, struct strview b) {
+	return a.len == b.len && _memcasecmp(a.ptr, b.ptr, a.len) == 0;
+}
+
+_strings_alwaysinline static bool strview_prefix(struct strview v, struct strview p) { return v.len >= p.len && strview_eq(strview_head(v, p.len), p); }
+_strings_alwaysinline static bool strview_suffix(struct strview v, struct strview s) { return v.len >= s.len && strview_eq(strview_tail(v, v.len - s.len), s); }
+_strings_alwaysinline static bool strview_caseprefix(struct strview v, struct strview p) { return v.len >= p.len && strview_caseeq(strview_head(v, p.len), p); }
+_strings_alwaysinline static bool strview_casesuffix(struct strview v, struct strview s) { return v.len >= s.len && strview_caseeq(strview_tail(v, v.len - s.len), s); }
+
+/* Byte order, with a proper prefix ordered first; the case variant folds
+   ASCII letters to lower case like _strcasecmp. */
+_strings_api int strview_cmp(struct strview a, struct strview b);
+_strings_api int strview_casecmp(struct strview a, struct strview b);
+
+_strings_api size_t strview_findchr(struct strview v, char c);
+_strings_api size_t strview_rfindchr(struct strview v, char c);
+_strings_api size_t strview_find(struct strview v, struct strview needle);
+_strings_api size_t strview_casefind(struct strview v, struct strview needle);
+
+/* Trimming removes ASCII space, tab, newline, vertical tab, form feed and
+   carriage return. */
+_strings_api struct strview strview_ltrim(struct strview v);
+_strings_api struct strview strview_rtrim(struct strview v);
+_strings_api struct strview strview_trim(struct strview v);
+
+/* A splitter hands out the tokens of a view up to each sep. An input of n
+   separators gives n + 1 tokens, so an empty view gives one empty token.
+   rest is what follows the last token handed out and is always a view;
+   done is set with the last token, which leaves rest empty, and next then
+   returns false:
+
+     struct strsplit s;
+     struct strview field;
+     strsplit_init(&s, line, ',');
+     while (strsplit_next(&s, &field))
+         ...                                                                */
+struct strsplit {
+	struct strview rest;
+	char sep;
+	bool done;
+};
+
+_strings_alwaysinline static void strsplit_init(struct strsplit *s, struct strview v, char sep) {
+	s->rest = v;
+	s->sep = sep;
+	s->done = false;
+}
+
+_strings_api bool strsplit_next(struct strsplit *s, struct strview *token);
+
+/* 64-bit hashes for tables keyed by views, the same as hash64() with a zero
+   seed; the case variant hashes the folded bytes, so views that compare
+   equal with strview_caseeq collide. */
+_strings_api uint64_t strview_hash(struct strview v);
+_strings_api uint64_t strview_casehash(struct strview v);
+
+/* Copies into a terminated buffer for APIs that need one; returns false
+   and truncates when the view does not fit. */
+_strings_api bool strview_copy(char *dst, size_t dstsize, struct strview v);
+
+/* An arena hands out memory from a caller-supplied buffer by bumping an
+   offset, and reset gives it all back at once. Builders drawing from an
+   arena must be initialized again after it is reset. */
+struct strarena {
+	char *base;
+	size_t size;
+	size_t used;
+};
+
+_strings_alwaysinline static void strarena_init(struct strarena *a, void *buf, size_t size) {
+	a->base = (char *) buf;
+	a->size = size;
+	a->used = 0;
+}
+
+_strings_alwaysinline static void strarena_reset(struct strarena *a) { a->used = 0; }
+
+/* A builder keeps its length and a terminator, so appends never rescan the
+   string. Its memory grows geometrically on the heap, comes from an arena,
+   or is a fixed buffer. When an append does not fit, it is truncated and
+   the sticky flag reported by strbuf_ok() is set, as with _strcpy. Reset
+   keeps the memory, so a builder reused on a hot path does not allocate
+   after warming up. */
+struct strbuf {
+	char *ptr;
+	size_t len;
+	size_t cap;
+	struct strarena *arena;
+	unsigned char mode;
+	bool trunc;
+};
+
+_strings_api void strbuf_init(struct strbuf *b);
+_strings_api void strbuf_init_fixed(struct strbuf *b, char *buf, size_t size);
+_strings_api void strbuf_init_arena(struct strbuf *b, struct strarena *arena);
+_strings_api void strbuf_free(struct strbuf *b);
+
+_strings_alwaysinline static void strbuf_reset(struct strbuf *b) {
+	b->len = 0;
+	b->trunc = false;
+	if (b->cap != 0)
+		b->ptr[0] = 0;
+}
+
+_strings_alwaysinline static bool strbuf_ok(const struct strbuf *b) { return !b->trunc; }
+_strings_alwaysinline static size_t strbuf_len(const struct strbuf *b) { return b->len; }
+_strings_alwaysinline static const char *strbuf_cstr(const struct strbuf *b) { return b->cap != 0 ? b->ptr : ""; }
+_strings_alwaysinline static struct strview strbuf_view(const struct strbuf *b) { return strview_make(b->ptr, b->len); }
+
+/* Makes room for n more bytes and returns how many fit. */
+_strings_api size_t strbuf_reserve(struct strbuf *b, size_t n);
+
+_strings_api bool strbuf_putc(struct strbuf *b, char c);
+_strings_api bool strbuf_append(struct strbuf *b, struct strview v);
+_strings_api bool strbuf_puts(struct strbuf *b, const char *str);
+_strings_api bool strbuf_append_s64(struct strbuf *b, int64_t value);
+_strings_api bool strbuf_append_u64(struct strbuf *b, uint64_t value);
+_strings_api bool strbuf_append_f64(struct strbuf *b, double value);
+
+_strings_printformat(2, 3)
+_strings_api bool strbuf_printf(struct strbuf *b, const char *__restrict format, ...);
+_strings_api bool strbuf_vprintf(struct strbuf *b, const char *__restrict format, va_list ap);
+
+/* An intern table maps strings to small nonzero handles, so that interned
+   strings compare equal exactly when their handles do. The strings are
+   copied, terminated, into one block that only grows, and stay put until
+   the table is freed. Capacity is fixed at init; adding to a full table
+   returns STRINTERN_NONE. In case-insensitive mode strings equal under
+   _memcasecmp share a handle and keep the spelling first added.
+
+   Any number of threads may add, find and look up handles at once without
+   locks. Threads racing to add the same new string all get one handle, but
+   the losers' copies are wasted, so handles may skip values. An add that
+   fails for want of room takes nothing, unless another add raced it. */
+struct strintern {
+	uint64_t *slots;
+	struct strview *strs;
+	char *bytes;
+	size_t mask;
+	uint64_t maxstrs;
+	uint64_t maxbytes;
+	uint64_t nstrs;
+	uint64_t nbytes;
+	bool nocase;
+};
+
+#define STRINTERN_NONE 0
+
+_strings_api bool strintern_init(struct strintern *t, uint32_t maxstrs, size_t maxbytes, bool nocase);
+_strings_api void strintern_free(struct strintern *t);
+
+_strings_api uint32_t strintern_add(struct strintern *t, struct strview s);
+_strings_api uint32_t strintern_find(const struct strintern *t, struct strview s);
+
+/* STRINTERN_NONE and handles the table never gave out yield an empty view.
+   So do a value skipped by a lost race, once the add that lost returns,
+   and a handle whose string is still being copied. */
+_strings_api struct strview strintern_view(const struct strintern *t, uint32_t h);
+
+_strings_alwaysinline static const char *strintern_cstr(const struct strintern *t, uint32_t h) {
+	const char *str = strintern_view(t, h).ptr;
+	return str != NULL ? str : "";
+}
 
 #ifdef __cplusplus
 } /* extern "C" */
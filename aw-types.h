@@ -109,6 +109,27 @@ typedef __vector4 f32x4;
 # endif
 #endif /* !defined(_have_simd_types) */
 
+/* The x86 compilers declare the 256- and 512-bit types whatever the target
+   flags, so run-time dispatched kernels can use them in any build. */
+#if !defined(_have_simd_types_256)
+# if (defined(__i386__) || defined(__x86_64__)) && \
+	(defined(__AVX__) || defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#  define _have_simd_types_256 1
+#  define _have_simd_types_512 1
+typedef __m256i u32x8;
+typedef __m256 f32x8;
+typedef __m512i u32x16;
+typedef __m512 f32x16;
+# elif (defined(_M_IX86) || defined(_M_X64)) && _MSC_VER >= 1900
+#  define _have_simd_types_256 1
+#  define _have_simd_types_512 1
+typedef __m256i u32x8;
+typedef __m256 f32x8;
+typedef __m512i u32x16;
+typedef __m512 f32x16;
+# endif
+#endif /* !defined(_have_simd_types_256) */
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
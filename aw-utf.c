@@ -0,0 +1,1123 @@
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+
+#include "aw-utf.h"
+#include "aw-cpu.h"
+#include "aw-endian.h"
+#include "aw-strings.h"
+
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define _utf_sse2 1
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && !defined(__ARM_BIG_ENDIAN)
+# include <arm_neon.h>
+# define _utf_neon 1
+#endif
+
+#define UTF_FOLD_MAX 0x1e921
+
+static const s32 UTF_FOLD_DELTA[99] = {
+	0, -42319, -42315, -42308, -42307, -42305, -42282, -42280,
+	-42261, -42258, -38864, -35384, -35332, -10815, -10783, -10782,
+	-10780, -10749, -10743, -10727, -8383, -8262, -7615, -7517,
+	-7173, -6222, -6221, -6212, -6211, -6210, -6204, -6180,
+	-3814, -3008, -268, -195, -163, -130, -128, -126,
+	-121, -112, -100, -97, -86, -74, -64, -60,
+	-58, -56, -54, -48, -30, -25, -22, -15,
+	-9, -8, -7, 1, 2, 8, 15, 16,
+	26, 28, 32, 34, 37, 38, 39, 40,
+	48, 63, 64, 69, 71, 79, 80, 116,
+	202, 203, 205, 206, 207, 209, 210, 211,
+	213, 214, 217, 218, 219, 775, 928, 7264,
+	10792, 10795, 35267,
+};
+
+static const u8 UTF_FOLD_STAGE1[979] = {
+	0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 11, 5, 5, 5, 5, 5, 12, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 13, 5, 5, 14, 15, 16, 17,
+	5, 5, 18, 19, 5, 5, 5, 5, 5, 20, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 21, 22, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 23, 24, 25, 26,
+	5, 5, 5, 5, 5, 5, 27, 28, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 29, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 30, 31, 32, 33, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 34, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 35, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 36, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 37,
+};
+
+static const u8 UTF_FOLD_STAGE2[38][128] = {
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66,
+		66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 93, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66,
+		66, 66, 66, 66, 66, 66, 66, 0, 66, 66, 66, 66, 66, 66, 66, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		0, 0, 59, 0, 59, 0, 59, 0, 0, 59, 0, 59, 0, 59, 0, 59,
+		0, 59, 0, 59, 0, 59, 0, 59, 0, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 40, 59, 0, 59, 0, 59, 0, 34,
+	},
+	{
+		0, 86, 59, 0, 59, 0, 83, 59, 0, 82, 82, 59, 0, 0, 77, 80,
+		81, 59, 0, 82, 84, 0, 87, 85, 59, 0, 0, 0, 87, 88, 0, 89,
+		59, 0, 59, 0, 59, 0, 91, 59, 0, 91, 0, 0, 59, 0, 91, 59,
+		0, 90, 90, 59, 0, 59, 0, 92, 59, 0, 0, 0, 59, 0, 0, 0,
+		0, 0, 0, 0, 60, 59, 0, 60, 59, 0, 60, 59, 0, 59, 0, 59,
+		0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		0, 60, 59, 0, 59, 0, 43, 49, 59, 0, 59, 0, 59, 0, 59, 0,
+	},
+	{
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		37, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 0, 0, 0, 0, 0, 0, 97, 59, 0, 36, 96, 0,
+		0, 59, 0, 35, 75, 76, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 79, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		59, 0, 59, 0, 0, 0, 59, 0, 0, 0, 0, 0, 0, 0, 0, 79,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 69, 0, 68, 68, 68, 0, 74, 0, 73, 73,
+		0, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66,
+		66, 66, 0, 66, 66, 66, 66, 66, 66, 66, 66, 66, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 59, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 61,
+		52, 53, 0, 0, 0, 55, 54, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		50, 51, 0, 0, 47, 46, 0, 59, 0, 58, 59, 0, 0, 37, 37, 37,
+	},
+	{
+		78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78,
+		66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66,
+		66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+	},
+	{
+		59, 0, 0, 0, 0, 0, 0, 0, 0, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		62, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+	},
+	{
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		0, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72,
+		72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72,
+		72, 72, 72, 72, 72, 72, 72, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95,
+		95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95,
+		95, 95, 95, 95, 95, 95, 0, 95, 0, 0, 0, 0, 0, 95, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 57, 57, 57, 57, 57, 57, 0, 0,
+	},
+	{
+		25, 26, 27, 29, 29, 28, 30, 31, 98, 0, 0, 0, 0, 0, 0, 0,
+		33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33,
+		33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33,
+		33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 0, 0, 33, 33, 33,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+	},
+	{
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 0, 0, 0, 0, 0, 48, 0, 0, 22, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 57, 57, 57, 57, 57, 57, 57, 57,
+		0, 0, 0, 0, 0, 0, 0, 0, 57, 57, 57, 57, 57, 57, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 57, 57, 57, 57, 57, 57, 57, 57,
+		0, 0, 0, 0, 0, 0, 0, 0, 57, 57, 57, 57, 57, 57, 57, 57,
+		0, 0, 0, 0, 0, 0, 0, 0, 57, 57, 57, 57, 57, 57, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 57, 0, 57, 0, 57, 0, 57,
+		0, 0, 0, 0, 0, 0, 0, 0, 57, 57, 57, 57, 57, 57, 57, 57,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 57, 57, 57, 57, 57, 57, 57, 57,
+		0, 0, 0, 0, 0, 0, 0, 0, 57, 57, 57, 57, 57, 57, 57, 57,
+		0, 0, 0, 0, 0, 0, 0, 0, 57, 57, 57, 57, 57, 57, 57, 57,
+		0, 0, 0, 0, 0, 0, 0, 0, 57, 57, 45, 45, 56, 0, 24, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 44, 44, 44, 44, 56, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 57, 57, 42, 42, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 57, 57, 41, 41, 58, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 38, 38, 39, 39, 56, 0, 0, 0,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 23, 0, 0, 0, 20, 21, 0, 0, 0, 0,
+		0, 0, 65, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		0, 0, 0, 59, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+		64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72,
+		72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72,
+		72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		59, 0, 18, 32, 19, 0, 0, 59, 0, 59, 0, 59, 0, 16, 17, 14,
+		15, 0, 59, 0, 0, 59, 0, 0, 0, 0, 0, 0, 0, 0, 13, 13,
+	},
+	{
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 0, 0, 0, 0, 0, 0, 0, 59, 0, 59, 0, 0,
+		0, 0, 59, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		0, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 59, 0, 59, 0, 12, 59, 0,
+	},
+	{
+		59, 0, 59, 0, 59, 0, 59, 0, 0, 0, 0, 59, 0, 7, 0, 0,
+		59, 0, 59, 0, 0, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 3, 1, 2, 5, 3, 0,
+		9, 6, 8, 94, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0, 59, 0,
+		59, 0, 59, 0, 51, 4, 11, 59, 0, 59, 0, 0, 0, 0, 0, 0,
+		59, 0, 0, 0, 0, 0, 59, 0, 59, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 59, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+	},
+	{
+		10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+		10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+		10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+		10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66,
+		66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71,
+		71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71,
+		71, 71, 71, 71, 71, 71, 71, 71, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71,
+		71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71,
+		71, 71, 71, 71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		70, 70, 70, 70, 70, 70, 70, 70, 70, 70, 70, 0, 70, 70, 70, 70,
+	},
+	{
+		70, 70, 70, 70, 70, 70, 70, 70, 70, 70, 70, 0, 70, 70, 70, 70,
+		70, 70, 70, 0, 70, 70, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+		74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+		74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+		74, 74, 74, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66,
+		66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66,
+		66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+	{
+		67, 67, 67, 67, 67, 67, 67, 67, 67, 67, 67, 67, 67, 67, 67, 67,
+		67, 67, 67, 67, 67, 67, 67, 67, 67, 67, 67, 67, 67, 67, 67, 67,
+		67, 67, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	},
+};
+
+/* Lookup tables of Keiser and Lemire, "Validating UTF-8 In Less Than One
+   Instruction Per Byte". Each bit is an error class; a byte pair is bad
+   when the classes of the first byte's nibbles and the second byte's high
+   nibble share a bit. Bit 7 marks a continuation after a continuation,
+   which is an error unless the byte two or three back starts a sequence
+   long enough. */
+#define UTF8_TOO_SHORT (1 << 0)
+#define UTF8_TOO_LONG (1 << 1)
+#define UTF8_OVERLONG_3 (1 << 2)
+#define UTF8_TOO_LARGE (1 << 3)
+#define UTF8_SURROGATE (1 << 4)
+#define UTF8_OVERLONG_2 (1 << 5)
+#define UTF8_TOO_LARGE_1000 (1 << 6)
+#define UTF8_OVERLONG_4 (1 << 6)
+#define UTF8_TWO_CONTS (1 << 7)
+#define UTF8_CARRY (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS)
+
+#if defined(_cpu_dispatch_x86) || defined(_utf_neon)
+static const u8 UTF8_BYTE1_HIGH[16] = {
+	UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+	UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+	UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+	UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+	UTF8_TOO_SHORT,
+	UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+	UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+};
+
+static const u8 UTF8_BYTE1_LOW[16] = {
+	UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,
+	UTF8_CARRY | UTF8_OVERLONG_2,
+	UTF8_CARRY,
+	UTF8_CARRY,
+	UTF8_CARRY | UTF8_TOO_LARGE,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+};
+
+static const u8 UTF8_BYTE2_HIGH[16] = {
+	UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+	UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+	UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+	UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE,
+	UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+	UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+	UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+};
+
+/* A block ending in the first bytes of a sequence needs another block:
+   subtracting these with saturation leaves them non-zero. */
+static const u8 UTF8_INCOMPLETE[32] = {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xdf, 0xbf,
+};
+#endif
+
+_utf_alwaysinline static u32 utf_ctz(u64 a) {
+#if defined(__GNUC__)
+	return (u32) __builtin_ctzll(a);
+#elif defined(_M_X64) || defined(_M_ARM64) || defined(_M_ARM64EC)
+	unsigned long r;
+	_BitScanForward64(&r, a);
+	return (u32) r;
+#else
+	u32 r = 0;
+	for (; (a & 1) == 0; a >>= 1)
+		++r;
+	return r;
+#endif
+}
+
+/* Decodes one well-formed sequence of at most n bytes into c and returns
+   its length, or 0 if it is not well formed. */
+_utf_alwaysinline static size_t utf8_decode(const u8 *p, size_t n, u32 *c) {
+	u32 b = p[0];
+	if (b < 0x80) {
+		*c = b;
+		return 1;
+	} else if (b < 0xc2) {
+		return 0;
+	} else if (b < 0xe0) {
+		if (n < 2 || (p[1] & 0xc0) != 0x80)
+			return 0;
+		*c = (b & 0x1f) << 6 | (p[1] & 0x3f);
+		return 2;
+	} else if (b < 0xf0) {
+		if (n < 3 || (p[1] & 0xc0) != 0x80 || (p[2] & 0xc0) != 0x80)
+			return 0;
+		b = (b & 0x0f) << 12 | (u32) (p[1] & 0x3f) << 6 | (p[2] & 0x3f);
+		if (b < 0x800 || (b >= 0xd800 && b < 0xe000))
+			return 0;
+		*c = b;
+		return 3;
+	} else if (b < 0xf5) {
+		if (n < 4 || (p[1] & 0xc0) != 0x80 || (p[2] & 0xc0) != 0x80 || (p[3] & 0xc0) != 0x80)
+			return 0;
+		b = (b & 0x07) << 18 | (u32) (p[1] & 0x3f) << 12 | (u32) (p[2] & 0x3f) << 6 | (p[3] & 0x3f);
+		if (b < 0x10000 || b > 0x10ffff)
+			return 0;
+		*c = b;
+		return 4;
+	}
+	return 0;
+}
+
+_utf_alwaysinline static size_t utf8_encode(u8 *p, u32 c) {
+	if (c < 0x80) {
+		p[0] = (u8) c;
+		return 1;
+	} else if (c < 0x800) {
+		p[0] = (u8) (0xc0 | c >> 6);
+		p[1] = (u8) (0x80 | (c & 0x3f));
+		return 2;
+	} else if (c < 0x10000) {
+		p[0] = (u8) (0xe0 | c >> 12);
+		p[1] = (u8) (0x80 | (c >> 6 & 0x3f));
+		p[2] = (u8) (0x80 | (c & 0x3f));
+		return 3;
+	}
+	p[0] = (u8) (0xf0 | c >> 18);
+	p[1] = (u8) (0x80 | (c >> 12 & 0x3f));
+	p[2] = (u8) (0x80 | (c >> 6 & 0x3f));
+	p[3] = (u8) (0x80 | (c & 0x3f));
+	return 4;
+}
+
+static size_t utf8_check(const u8 *p, size_t i, size_t n) {
+	u32 c;
+	while (i < n) {
+		size_t k;
+		if (n - i >= 8 && (_load_le64(p + i) & imm_u64(0x8080808080808080)) == 0) {
+			i += 8;
+			continue;
+		}
+		if ((k = utf8_decode(p + i, n - i, &c)) == 0)
+			return i;
+		i += k;
+	}
+	return n;
+}
+
+/* Block kernels report an error in the block at i, whose first invalid
+   sequence starts no earlier than the previous block: sequences that end
+   there were checked with it. Skipping the continuations of a sequence
+   that began before that gives a boundary to find the offset from. */
+#if defined(_cpu_dispatch_x86) || defined(_utf_neon)
+static size_t utf8_recheck(const u8 *p, size_t i, size_t block, size_t n) {
+	size_t k;
+	if (i < block)
+		return utf8_check(p, 0, n);
+	i -= block;
+	for (k = 0; k < 3 && i != 0 && (p[i] & 0xc0) == 0x80; ++k)
+		++i;
+	return utf8_check(p, i, n);
+}
+#endif
+
+typedef size_t (*utf8_validate_fn)(const u8 *p, size_t n);
+
+#if defined(_cpu_dispatch_x86)
+_cpu_target("ssse3")
+static size_t utf8_validate_ssse3(const u8 *p, size_t n) {
+	const __m128i high1 = _mm_loadu_si128((const __m128i *) UTF8_BYTE1_HIGH);
+	const __m128i low1 = _mm_loadu_si128((const __m128i *) UTF8_BYTE1_LOW);
+	const __m128i high2 = _mm_loadu_si128((const __m128i *) UTF8_BYTE2_HIGH);
+	const __m128i last = _mm_loadu_si128((const __m128i *) (UTF8_INCOMPLETE + 16));
+	const __m128i nibble = _mm_set1_epi8(0x0f), zero = _mm_setzero_si128();
+	__m128i prev = zero, incomplete = zero;
+	size_t i = 0;
+	u8 tail[16];
+	for (;; i += 16) {
+		__m128i in, err;
+		if (n - i >= 16) {
+			in = _mm_loadu_si128((const __m128i *) (p + i));
+		} else {
+			memset(tail, 0, sizeof tail);
+			memcpy(tail, p + i, n - i);
+			in = _mm_loadu_si128((const __m128i *) tail);
+		}
+		if (_mm_movemask_epi8(in) == 0) {
+			err = incomplete;
+			incomplete = zero;
+		} else {
+			__m128i prev1 = _mm_alignr_epi8(in, prev, 15);
+			__m128i prev2 = _mm_alignr_epi8(in, prev, 14);
+			__m128i prev3 = _mm_alignr_epi8(in, prev, 13);
+			__m128i sc = _mm_and_si128(_mm_and_si128(
+				_mm_shuffle_epi8(high1, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble)),
+				_mm_shuffle_epi8(low1, _mm_and_si128(prev1, nibble))),
+				_mm_shuffle_epi8(high2, _mm_and_si128(_mm_srli_epi16(in, 4), nibble)));
+			__m128i must23 = _mm_or_si128(_mm_subs_epu8(prev2, _mm_set1_epi8(0x60)), _mm_subs_epu8(prev3, _mm_set1_epi8(0x70)));
+			err = _mm_xor_si128(_mm_and_si128(must23, _mm_set1_epi8((char) 0x80)), sc);
+			incomplete = _mm_subs_epu8(in, last);
+		}
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(err, zero)) != 0xffff)
+			return utf8_recheck(p, i, 16, n);
+		if (n - i < 16)
+			return n;
+		prev = in;
+	}
+}
+
+_cpu_target("avx2")
+static size_t utf8_validate_avx2(const u8 *p, size_t n) {
+	const __m256i high1 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) UTF8_BYTE1_HIGH));
+	const __m256i low1 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) UTF8_BYTE1_LOW));
+	const __m256i high2 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) UTF8_BYTE2_HIGH));
+	const __m256i last = _mm256_loadu_si256((const __m256i *) UTF8_INCOMPLETE);
+	const __m256i nibble = _mm256_set1_epi8(0x0f), zero = _mm256_setzero_si256();
+	__m256i prev = zero, incomplete = zero;
+	size_t i = 0;
+	u8 tail[32];
+	for (;; i += 32) {
+		__m256i in, err;
+		if (n - i >= 32) {
+			in = _mm256_loadu_si256((const __m256i *) (p + i));
+		} else {
+			memset(tail, 0, sizeof tail);
+			memcpy(tail, p + i, n - i);
+			in = _mm256_loadu_si256((const __m256i *) tail);
+		}
+		if (_mm256_movemask_epi8(in) == 0) {
+			err = incomplete;
+			incomplete = zero;
+		} else {
+			__m256i cross = _mm256_permute2x128_si256(prev, in, 0x21);
+			__m256i prev1 = _mm256_alignr_epi8(in, cross, 15);
+			__m256i prev2 = _mm256_alignr_epi8(in, cross, 14);
+			__m256i prev3 = _mm256_alignr_epi8(in, cross, 13);
+			__m256i sc = _mm256_and_si256(_mm256_and_si256(
+				_mm256_shuffle_epi8(high1, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+				_mm256_shuffle_epi8(low1, _mm256_and_si256(prev1, nibble))),
+				_mm256_shuffle_epi8(high2, _mm256_and_si256(_mm256_srli_epi16(in, 4), nibble)));
+			__m256i must23 = _mm256_or_si256(_mm256_subs_epu8(prev2, _mm256_set1_epi8(0x60)), _mm256_subs_epu8(prev3, _mm256_set1_epi8(0x70)));
+			err = _mm256_xor_si256(_mm256_and_si256(must23, _mm256_set1_epi8((char) 0x80)), sc);
+			incomplete = _mm256_subs_epu8(in, last);
+		}
+		if (!_mm256_testz_si256(err, err))
+			return utf8_recheck(p, i, 32, n);
+		if (n - i < 32)
+			return n;
+		prev = in;
+	}
+}
+
+static size_t utf8_validate_scalar(const u8 *p, size_t n) { return utf8_check(p, 0, n); }
+
+static size_t utf8_validate_resolve(const u8 *p, size_t n);
+static _cpu_ptr(utf8_validate_fn) utf8_validate_kernel_ptr = utf8_validate_resolve;
+#define utf8_validate_kernel _cpu_load_ptr(utf8_validate_kernel_ptr)
+
+static size_t utf8_validate_resolve(const u8 *p, size_t n) {
+	utf8_validate_fn fn = utf8_validate_scalar;
+	if (cpu_has(CPU_AVX2))
+		fn = utf8_validate_avx2;
+	else if (cpu_has(CPU_SSSE3))
+		fn = utf8_validate_ssse3;
+	_cpu_store_ptr(utf8_validate_kernel_ptr, fn);
+	return fn(p, n);
+}
+#elif defined(_utf_neon)
+static size_t utf8_validate_kernel(const u8 *p, size_t n) {
+	const uint8x16_t high1 = vld1q_u8(UTF8_BYTE1_HIGH), low1 = vld1q_u8(UTF8_BYTE1_LOW);
+	const uint8x16_t high2 = vld1q_u8(UTF8_BYTE2_HIGH), last = vld1q_u8(UTF8_INCOMPLETE + 16);
+	const uint8x16_t nibble = vdupq_n_u8(0x0f), zero = vdupq_n_u8(0);
+	uint8x16_t prev = zero, incomplete = zero;
+	size_t i = 0;
+	u8 tail[16];
+	for (;; i += 16) {
+		uint8x16_t in, err;
+		if (n - i >= 16) {
+			in = vld1q_u8(p + i);
+		} else {
+			memset(tail, 0, sizeof tail);
+			memcpy(tail, p + i, n - i);
+			in = vld1q_u8(tail);
+		}
+		if (vmaxvq_u8(in) < 0x80) {
+			err = incomplete;
+			incomplete = zero;
+		} else {
+			uint8x16_t prev1 = vextq_u8(prev, in, 15);
+			uint8x16_t prev2 = vextq_u8(prev, in, 14);
+			uint8x16_t prev3 = vextq_u8(prev, in, 13);
+			uint8x16_t sc = vandq_u8(vandq_u8(
+				vqtbl1q_u8(high1, vshrq_n_u8(prev1, 4)),
+				vqtbl1q_u8(low1, vandq_u8(prev1, nibble))),
+				vqtbl1q_u8(high2, vshrq_n_u8(in, 4)));
+			uint8x16_t must23 = vorrq_u8(vqsubq_u8(prev2, vdupq_n_u8(0x60)), vqsubq_u8(prev3, vdupq_n_u8(0x70)));
+			err = veorq_u8(vandq_u8(must23, vdupq_n_u8(0x80)), sc);
+			incomplete = vqsubq_u8(in, last);
+		}
+		if (vmaxvq_u8(err) != 0)
+			return utf8_recheck(p, i, 16, n);
+		if (n - i < 16)
+			return n;
+		prev = in;
+	}
+}
+#else
+# define utf8_validate_kernel(p, n) utf8_check(p, 0, n)
+#endif
+
+size_t utf8_validate(const char *src, size_t size) {
+	return utf8_validate_kernel((const u8 *) src, size);
+}
+
+/* Counts the bytes that start a code point and, in quad, those that start
+   four-byte sequences, which take two UTF-16 units. Byte counters are
+   summed before they can wrap, after 255 blocks. */
+static size_t utf8_tally(const u8 *p, size_t n, size_t *quad) {
+	size_t i = 0, count = 0, four = 0;
+#if defined(_utf_sse2)
+	const __m128i cont = _mm_set1_epi8(-0x41), lead4 = _mm_set1_epi8((char) 0xf0), zero = _mm_setzero_si128();
+	while (n - i >= 16) {
+		__m128i a = zero, b = zero;
+		size_t k = (n - i) / 16;
+		if (k > 255)
+			k = 255;
+		for (; k != 0; --k, i += 16) {
+			__m128i x = _mm_loadu_si128((const __m128i *) (p + i));
+			a = _mm_sub_epi8(a, _mm_cmpgt_epi8(x, cont));
+			b = _mm_sub_epi8(b, _mm_cmpeq_epi8(_mm_max_epu8(x, lead4), x));
+		}
+		a = _mm_sad_epu8(a, zero);
+		b = _mm_sad_epu8(b, zero);
+		count += (u32) _mm_cvtsi128_si32(a) + (u32) _mm_cvtsi128_si32(_mm_unpackhi_epi64(a, a));
+		four += (u32) _mm_cvtsi128_si32(b) + (u32) _mm_cvtsi128_si32(_mm_unpackhi_epi64(b, b));
+	}
+#elif defined(_utf_neon)
+	const int8x16_t cont = vdupq_n_s8(-0x41);
+	const uint8x16_t lead4 = vdupq_n_u8(0xf0);
+	while (n - i >= 16) {
+		uint8x16_t a = vdupq_n_u8(0), b = vdupq_n_u8(0);
+		size_t k = (n - i) / 16;
+		if (k > 255)
+			k = 255;
+		for (; k != 0; --k, i += 16) {
+			uint8x16_t x = vld1q_u8(p + i);
+			a = vsubq_u8(a, vcgtq_s8(vreinterpretq_s8_u8(x), cont));
+			b = vsubq_u8(b, vcgeq_u8(x, lead4));
+		}
+		count += vaddlvq_u8(a);
+		four += vaddlvq_u8(b);
+	}
+#endif
+	for (; i < n; ++i) {
+		count += (p[i] & 0xc0) != 0x80;
+		four += p[i] >= 0xf0;
+	}
+	if (quad != NULL)
+		*quad = four;
+	return count;
+}
+
+size_t utf8_count(const char *src, size_t size) {
+	return utf8_tally((const u8 *) src, size, NULL);
+}
+
+size_t utf8_len_utf16(const char *src, size_t size) {
+	size_t four, count = utf8_tally((const u8 *) src, size, &four);
+	return count + four;
+}
+
+/* Each unit takes one byte more from U+0080 and another from U+0800, but
+   a surrogate pair takes four in all. Lane counters go down by up to two a
+   block, and are summed before they can wrap. */
+size_t utf16_len_utf8(const u16 *src, size_t count) {
+	size_t i = 0, size = count;
+#if defined(_utf_sse2)
+	const __m128i m1 = _mm_set1_epi16((short) 0xff80), m2 = _mm_set1_epi16((short) 0xf800);
+	const __m128i sur = _mm_set1_epi16((short) 0xd800), zero = _mm_setzero_si128();
+	while (count - i >= 8) {
+		__m128i a = zero;
+		size_t k = (count - i) / 8;
+		if (k > 16384)
+			k = 16384;
+		size += 2 * 8 * k;
+		for (; k != 0; --k, i += 8) {
+			__m128i x = _mm_loadu_si128((const __m128i *) (src + i)), h = _mm_and_si128(x, m2);
+			a = _mm_add_epi16(a, _mm_cmpeq_epi16(_mm_and_si128(x, m1), zero));
+			a = _mm_add_epi16(a, _mm_add_epi16(_mm_cmpeq_epi16(h, zero), _mm_cmpeq_epi16(h, sur)));
+		}
+		a = _mm_madd_epi16(a, _mm_set1_epi16(1));
+		a = _mm_add_epi32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2)));
+		a = _mm_add_epi32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1)));
+		size -= (u32) -_mm_cvtsi128_si32(a);
+	}
+#elif defined(_utf_neon)
+	const uint16x8_t m1 = vdupq_n_u16(0xff80), m2 = vdupq_n_u16(0xf800), sur = vdupq_n_u16(0xd800);
+	while (count - i >= 8) {
+		int16x8_t a = vdupq_n_s16(0);
+		size_t k = (count - i) / 8;
+		if (k > 16384)
+			k = 16384;
+		for (; k != 0; --k, i += 8) {
+			uint16x8_t x = vld1q_u16(src + i), h = vandq_u16(x, m2);
+			a = vaddq_s16(a, vreinterpretq_s16_u16(vtstq_u16(x, m1)));
+			a = vaddq_s16(a, vreinterpretq_s16_u16(vtstq_u16(x, m2)));
+			a = vsubq_s16(a, vreinterpretq_s16_u16(vceqq_u16(h, sur)));
+		}
+		size += (size_t) -vaddlvq_s16(a);
+	}
+#endif
+	for (; i < count; ++i) {
+		u32 c = src[i];
+		size += (c >= 0x80) + (c >= 0x800) - ((c & 0xf800) == 0xd800);
+	}
+	return size;
+}
+
+/* Runs of ASCII go a block at a time: the whole block is stored, and the
+   caller advances past the ASCII that leads it. */
+#if defined(_utf_sse2)
+# define _utf_simd 1
+
+_utf_alwaysinline static size_t utf8_ascii16(const u8 *p) {
+	return utf_ctz((u32) _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) p)) | 0x10000);
+}
+
+_utf_alwaysinline static size_t utf8_widen16(u16 *d, const u8 *p) {
+	__m128i x = _mm_loadu_si128((const __m128i *) p), zero = _mm_setzero_si128();
+	_mm_storeu_si128((__m128i *) d, _mm_unpacklo_epi8(x, zero));
+	_mm_storeu_si128((__m128i *) (d + 8), _mm_unpackhi_epi8(x, zero));
+	return utf_ctz((u32) _mm_movemask_epi8(x) | 0x10000);
+}
+
+_utf_alwaysinline static size_t utf16_narrow8(u8 *d, const u16 *p) {
+	__m128i x = _mm_loadu_si128((const __m128i *) p);
+	__m128i ascii = _mm_cmpeq_epi16(_mm_and_si128(x, _mm_set1_epi16((short) 0xff80)), _mm_setzero_si128());
+	_mm_storel_epi64((__m128i *) d, _mm_packus_epi16(x, x));
+	return utf_ctz(~(u32) _mm_movemask_epi8(ascii)) / 2;
+}
+
+_utf_alwaysinline static size_t utf8_lower16(u8 *d, const u8 *p) {
+	__m128i x = _mm_loadu_si128((const __m128i *) p);
+	__m128i upper = _mm_cmplt_epi8(_mm_add_epi8(x, _mm_set1_epi8((char) (0x80 - 'A'))), _mm_set1_epi8(-0x80 + 26));
+	_mm_storeu_si128((__m128i *) d, _mm_add_epi8(x, _mm_and_si128(upper, _mm_set1_epi8(0x20))));
+	return utf_ctz((u32) _mm_movemask_epi8(x) | 0x10000);
+}
+#elif defined(_utf_neon)
+# define _utf_simd 1
+
+/* The narrowing shift leaves four bits a byte of the high-bit mask. */
+_utf_alwaysinline static size_t utf8_leading(uint8x16_t x) {
+	u64 m = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(vcgeq_u8(x, vdupq_n_u8(0x80))), 4)), 0);
+	return m != 0 ? utf_ctz(m) / 4 : 16;
+}
+
+_utf_alwaysinline static size_t utf8_ascii16(const u8 *p) { return utf8_leading(vld1q_u8(p)); }
+
+_utf_alwaysinline static size_t utf8_widen16(u16 *d, const u8 *p) {
+	uint8x16_t x = vld1q_u8(p);
+	vst1q_u16(d, vmovl_u8(vget_low_u8(x)));
+	vst1q_u16(d + 8, vmovl_high_u8(x));
+	return utf8_leading(x);
+}
+
+_utf_alwaysinline static size_t utf16_narrow8(u8 *d, const u16 *p) {
+	uint16x8_t x = vld1q_u16(p);
+	u64 m = vget_lane_u64(vreinterpret_u64_u8(vmovn_u16(vcgeq_u16(x, vdupq_n_u16(0x80)))), 0);
+	vst1_u8(d, vmovn_u16(x));
+	return m != 0 ? utf_ctz(m) / 8 : 8;
+}
+
+_utf_alwaysinline static size_t utf8_lower16(u8 *d, const u8 *p) {
+	uint8x16_t x = vld1q_u8(p);
+	uint8x16_t upper = vcltq_u8(vsubq_u8(x, vdupq_n_u8('A')), vdupq_n_u8(26));
+	vst1q_u8(d, vaddq_u8(x, vandq_u8(upper, vdupq_n_u8(0x20))));
+	return utf8_leading(x);
+}
+#endif
+
+size_t utf8_to_utf16(u16 *dst, const char *src, size_t size) {
+	const u8 *p = (const u8 *) src;
+	size_t i = 0, o = 0, k;
+	u32 c;
+	while (i < size) {
+#if defined(_utf_simd)
+		if (size - i >= 16) {
+			k = utf8_widen16(dst + o, p + i);
+			i += k;
+			o += k;
+			if (k == 16)
+				continue;
+		}
+#endif
+		if ((k = utf8_decode(p + i, size - i, &c)) == 0)
+			return UTF_ERROR;
+		i += k;
+		if (c < 0x10000) {
+			dst[o++] = (u16) c;
+		} else {
+			c -= 0x10000;
+			dst[o++] = (u16) (0xd800 | c >> 10);
+			dst[o++] = (u16) (0xdc00 | (c & 0x3ff));
+		}
+	}
+	return o;
+}
+
+size_t utf16_to_utf8(char *dst, const u16 *src, size_t count) {
+	u8 *d = (u8 *) dst;
+	size_t i = 0, o = 0;
+	while (i < count) {
+		u32 c;
+#if defined(_utf_simd)
+		if (count - i >= 8) {
+			size_t k = utf16_narrow8(d + o, src + i);
+			i += k;
+			o += k;
+			if (k == 8)
+				continue;
+		}
+#endif
+		c = src[i++];
+		if ((c & 0xf800) == 0xd800) {
+			if (c > 0xdbff || i == count || (src[i] & 0xfc00) != 0xdc00)
+				return UTF_ERROR;
+			c = 0x10000 + ((c & 0x3ff) << 10 | (src[i++] & 0x3ff));
+		}
+		o += utf8_encode(d + o, c);
+	}
+	return o;
+}
+
+u32 utf_fold(u32 c) {
+	if (c > UTF_FOLD_MAX)
+		return c;
+	return (u32) ((s32) c + UTF_FOLD_DELTA[UTF_FOLD_STAGE2[UTF_FOLD_STAGE1[c >> 7]][c & 127]]);
+}
+
+/* Folding never moves a code point to a longer sequence but for U+023A and
+   U+023E, which go from two bytes to three; a block store stays in bounds. */
+size_t utf8_fold(char *dst, const char *src, size_t size) {
+	const u8 *p = (const u8 *) src;
+	u8 *d = (u8 *) dst;
+	size_t i = 0, o = 0, k;
+	u32 c;
+	while (i < size) {
+#if defined(_utf_simd)
+		if (size - i >= 16) {
+			k = utf8_lower16(d + o, p + i);
+			i += k;
+			o += k;
+			if (k == 16)
+				continue;
+		}
+#endif
+		if (p[i] < 0x80) {
+			c = p[i++];
+			d[o++] = (u8) (c + ((u32) (u8) (c - 'A') < 26 ? 0x20 : 0));
+		} else if ((k = utf8_decode(p + i, size - i, &c)) == 0) {
+			d[o++] = p[i++];
+		} else {
+			i += k;
+			o += utf8_encode(d + o, utf_fold(c));
+		}
+	}
+	return o;
+}
+
+static size_t utf8_ascii(const u8 *p, size_t n) {
+	size_t i = 0;
+#if defined(_utf_simd)
+	for (; n - i >= 16; i += 16) {
+		size_t k = utf8_ascii16(p + i);
+		if (k != 16)
+			return i + k;
+	}
+#endif
+	while (i < n && p[i] < 0x80)
+		++i;
+	return i;
+}
+
+/* Bytes that are not valid UTF-8 sort after every code point, by value. */
+_utf_alwaysinline static u32 utf8_next(const u8 *p, size_t n, size_t *i) {
+	u32 c;
+	size_t k = utf8_decode(p + *i, n - *i, &c);
+	if (k == 0) {
+		*i += 1;
+		return 0x110000 + p[*i - 1];
+	}
+	*i += k;
+	return utf_fold(c);
+}
+
+int utf8_casecmp(const char *s1, size_t size1, const char *s2, size_t size2) {
+	const u8 *a = (const u8 *) s1;
+	const u8 *b = (const u8 *) s2;
+	size_t i = 0, j = 0;
+	while (i < size1 && j < size2) {
+		u32 c1, c2;
+		if ((a[i] | b[j]) < 0x80) {
+			size_t k = utf8_ascii(a + i, size1 - i);
+			int r;
+			k = utf8_ascii(b + j, k < size2 - j ? k : size2 - j);
+			if ((r = _memcasecmp(a + i, b + j, k)) != 0)
+				return r;
+			i += k;
+			j += k;
+			continue;
+		}
+		c1 = utf8_next(a, size1, &i);
+		c2 = utf8_next(b, size2, &j);
+		if (c1 != c2)
+			return c1 < c2 ? -1 : 1;
+	}
+	return (i < size1) - (j < size2);
+}
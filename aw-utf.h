@@ -0,0 +1,101 @@
+
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+#ifndef AW_UTF_H
+#define AW_UTF_H
+
+#include "aw-types.h"
+
+#if !defined(_MSC_VER) || _MSC_VER >= 1800
+# include <stdbool.h>
+#endif
+#include <stddef.h>
+
+#if defined(_utf_dllexport)
+# if defined(_MSC_VER)
+#  define _utf_api extern __declspec(dllexport)
+# elif defined(__GNUC__)
+#  define _utf_api __attribute__((visibility("default"))) extern
+# endif
+#elif defined(_utf_dllimport)
+# if defined(_MSC_VER)
+#  define _utf_api extern __declspec(dllimport)
+# endif
+#endif
+#ifndef _utf_api
+# define _utf_api extern
+#endif
+
+#if defined(__GNUC__)
+# define _utf_alwaysinline __attribute__((always_inline)) inline
+#elif defined(_MSC_VER)
+# define _utf_alwaysinline __forceinline
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UTF_ERROR ((size_t) -1)
+
+/* Returns size when src is valid UTF-8, and otherwise the offset of the
+   first invalid sequence. Valid means well-formed as in RFC 3629: no
+   overlong forms, surrogates or code points past U+10FFFF. Blocks of 16 or
+   32 bytes are checked at once with the lookup method of Keiser and Lemire,
+   on SSSE3, AVX2 or NEON. */
+_utf_api size_t utf8_validate(const char *src, size_t size);
+
+_utf_alwaysinline static bool utf8_valid(const char *src, size_t size) { return utf8_validate(src, size) == size; }
+
+/* Counts the code points of valid UTF-8. */
+_utf_api size_t utf8_count(const char *src, size_t size);
+
+/* UTF-16 is in host byte order, as wchar_t on Windows. The length
+   functions give the exact output size for valid input. Conversions
+   validate as they go and return the length written, or UTF_ERROR for
+   invalid UTF-8 or an unpaired surrogate; dst must have room for size
+   units from UTF-8, or 3 * count bytes from UTF-16. Runs of ASCII are
+   converted a vector at a time. */
+_utf_api size_t utf8_len_utf16(const char *src, size_t size);
+_utf_api size_t utf16_len_utf8(const u16 *src, size_t count);
+_utf_api size_t utf8_to_utf16(u16 *dst, const char *src, size_t size);
+_utf_api size_t utf16_to_utf8(char *dst, const u16 *src, size_t count);
+
+/* Simple case folding from the Unicode 14.0 CaseFolding.txt (status C and
+   S), which maps each code point to one code point and so never changes
+   the length of a string in code points. Folding UTF-8 may change its
+   length in bytes, by up to half again; bytes that are not valid UTF-8 are
+   copied unchanged. The comparison orders by folded code point, which for
+   ASCII is the order of _strcasecmp, and skips through ASCII runs with
+   _memcasecmp. */
+#define UTF8_FOLD_MAX(size) ((size) + (size) / 2)
+
+_utf_api u32 utf_fold(u32 c);
+_utf_api size_t utf8_fold(char *dst, const char *src, size_t size);
+_utf_api int utf8_casecmp(const char *s1, size_t size1, const char *s2, size_t size2);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* AW_UTF_H */
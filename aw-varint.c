@@ -0,0 +1,763 @@
+
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+#include "aw-varint.h"
+#include "aw-endian.h"
+
+#include <string.h>
+
+#if defined(__SSSE3__)
+# include <tmmintrin.h>
+# define _varint_ssse3 1
+#elif defined(__SSE2__) || defined(_M_X64)
+# include <emmintrin.h>
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64) || defined(_M_ARM64EC)
+# include <arm_neon.h>
+# define _varint_neon 1
+#endif
+
+#if defined(_varint_ssse3) || defined(_varint_neon)
+static const s8 streamvbyte_decode_shuffle[256][16] = {
+	{ 0, -1, -1, -1, 1, -1, -1, -1, 2, -1, -1, -1, 3, -1, -1, -1 },
+	{ 0, 1, -1, -1, 2, -1, -1, -1, 3, -1, -1, -1, 4, -1, -1, -1 },
+	{ 0, 1, 2, -1, 3, -1, -1, -1, 4, -1, -1, -1, 5, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, -1, -1, -1, 5, -1, -1, -1, 6, -1, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, -1, -1, 3, -1, -1, -1, 4, -1, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, -1, -1, 4, -1, -1, -1, 5, -1, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, -1, -1, 5, -1, -1, -1, 6, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, -1, -1, 6, -1, -1, -1, 7, -1, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, -1, 4, -1, -1, -1, 5, -1, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, -1, 5, -1, -1, -1, 6, -1, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, -1, 6, -1, -1, -1, 7, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, -1, 7, -1, -1, -1, 8, -1, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, 4, 5, -1, -1, -1, 6, -1, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, 5, 6, -1, -1, -1, 7, -1, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, 6, 7, -1, -1, -1, 8, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, -1, -1, -1, 9, -1, -1, -1 },
+	{ 0, -1, -1, -1, 1, -1, -1, -1, 2, 3, -1, -1, 4, -1, -1, -1 },
+	{ 0, 1, -1, -1, 2, -1, -1, -1, 3, 4, -1, -1, 5, -1, -1, -1 },
+	{ 0, 1, 2, -1, 3, -1, -1, -1, 4, 5, -1, -1, 6, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, -1, -1, -1, 5, 6, -1, -1, 7, -1, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, -1, -1, 3, 4, -1, -1, 5, -1, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, -1, -1, 4, 5, -1, -1, 6, -1, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, -1, -1, 5, 6, -1, -1, 7, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, -1, -1, 6, 7, -1, -1, 8, -1, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, -1, 4, 5, -1, -1, 6, -1, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, -1, 5, 6, -1, -1, 7, -1, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, -1, -1, 8, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, -1, 7, 8, -1, -1, 9, -1, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, 4, 5, 6, -1, -1, 7, -1, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, 5, 6, 7, -1, -1, 8, -1, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, 6, 7, 8, -1, -1, 9, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, -1, -1, 10, -1, -1, -1 },
+	{ 0, -1, -1, -1, 1, -1, -1, -1, 2, 3, 4, -1, 5, -1, -1, -1 },
+	{ 0, 1, -1, -1, 2, -1, -1, -1, 3, 4, 5, -1, 6, -1, -1, -1 },
+	{ 0, 1, 2, -1, 3, -1, -1, -1, 4, 5, 6, -1, 7, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, -1, -1, -1, 5, 6, 7, -1, 8, -1, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, -1, -1, 3, 4, 5, -1, 6, -1, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, -1, -1, 4, 5, 6, -1, 7, -1, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, -1, -1, 5, 6, 7, -1, 8, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, -1, -1, 6, 7, 8, -1, 9, -1, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, -1, 4, 5, 6, -1, 7, -1, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, -1, 5, 6, 7, -1, 8, -1, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, -1, 7, 8, 9, -1, 10, -1, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, 4, 5, 6, 7, -1, 8, -1, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, 5, 6, 7, 8, -1, 9, -1, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, 6, 7, 8, 9, -1, 10, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, -1, 11, -1, -1, -1 },
+	{ 0, -1, -1, -1, 1, -1, -1, -1, 2, 3, 4, 5, 6, -1, -1, -1 },
+	{ 0, 1, -1, -1, 2, -1, -1, -1, 3, 4, 5, 6, 7, -1, -1, -1 },
+	{ 0, 1, 2, -1, 3, -1, -1, -1, 4, 5, 6, 7, 8, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, -1, -1, -1, 5, 6, 7, 8, 9, -1, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, -1, -1, 3, 4, 5, 6, 7, -1, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, -1, -1, 4, 5, 6, 7, 8, -1, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, -1, -1, 5, 6, 7, 8, 9, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, -1, -1, 6, 7, 8, 9, 10, -1, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, -1, 4, 5, 6, 7, 8, -1, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, -1, 5, 6, 7, 8, 9, -1, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, 9, 10, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, -1, 7, 8, 9, 10, 11, -1, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, 4, 5, 6, 7, 8, 9, -1, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, 5, 6, 7, 8, 9, 10, -1, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, 6, 7, 8, 9, 10, 11, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, -1, -1, -1 },
+	{ 0, -1, -1, -1, 1, -1, -1, -1, 2, -1, -1, -1, 3, 4, -1, -1 },
+	{ 0, 1, -1, -1, 2, -1, -1, -1, 3, -1, -1, -1, 4, 5, -1, -1 },
+	{ 0, 1, 2, -1, 3, -1, -1, -1, 4, -1, -1, -1, 5, 6, -1, -1 },
+	{ 0, 1, 2, 3, 4, -1, -1, -1, 5, -1, -1, -1, 6, 7, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, -1, -1, 3, -1, -1, -1, 4, 5, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, -1, -1, 4, -1, -1, -1, 5, 6, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, -1, -1, 5, -1, -1, -1, 6, 7, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, -1, -1, 6, -1, -1, -1, 7, 8, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, -1, 4, -1, -1, -1, 5, 6, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, -1, 5, -1, -1, -1, 6, 7, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, -1, 6, -1, -1, -1, 7, 8, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, -1, 7, -1, -1, -1, 8, 9, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, 4, 5, -1, -1, -1, 6, 7, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, 5, 6, -1, -1, -1, 7, 8, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, 6, 7, -1, -1, -1, 8, 9, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, -1, -1, -1, 9, 10, -1, -1 },
+	{ 0, -1, -1, -1, 1, -1, -1, -1, 2, 3, -1, -1, 4, 5, -1, -1 },
+	{ 0, 1, -1, -1, 2, -1, -1, -1, 3, 4, -1, -1, 5, 6, -1, -1 },
+	{ 0, 1, 2, -1, 3, -1, -1, -1, 4, 5, -1, -1, 6, 7, -1, -1 },
+	{ 0, 1, 2, 3, 4, -1, -1, -1, 5, 6, -1, -1, 7, 8, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, -1, -1, 3, 4, -1, -1, 5, 6, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, -1, -1, 4, 5, -1, -1, 6, 7, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, -1, -1, 5, 6, -1, -1, 7, 8, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, -1, -1, 6, 7, -1, -1, 8, 9, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, -1, 4, 5, -1, -1, 6, 7, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, -1, 5, 6, -1, -1, 7, 8, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, -1, -1, 8, 9, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, -1, 7, 8, -1, -1, 9, 10, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, 4, 5, 6, -1, -1, 7, 8, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, 5, 6, 7, -1, -1, 8, 9, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, 6, 7, 8, -1, -1, 9, 10, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, -1, -1, 10, 11, -1, -1 },
+	{ 0, -1, -1, -1, 1, -1, -1, -1, 2, 3, 4, -1, 5, 6, -1, -1 },
+	{ 0, 1, -1, -1, 2, -1, -1, -1, 3, 4, 5, -1, 6, 7, -1, -1 },
+	{ 0, 1, 2, -1, 3, -1, -1, -1, 4, 5, 6, -1, 7, 8, -1, -1 },
+	{ 0, 1, 2, 3, 4, -1, -1, -1, 5, 6, 7, -1, 8, 9, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, -1, -1, 3, 4, 5, -1, 6, 7, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, -1, -1, 4, 5, 6, -1, 7, 8, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, -1, -1, 5, 6, 7, -1, 8, 9, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, -1, -1, 6, 7, 8, -1, 9, 10, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, -1, 4, 5, 6, -1, 7, 8, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, -1, 5, 6, 7, -1, 8, 9, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, -1, 7, 8, 9, -1, 10, 11, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, 4, 5, 6, 7, -1, 8, 9, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, 5, 6, 7, 8, -1, 9, 10, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, 6, 7, 8, 9, -1, 10, 11, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, -1, 11, 12, -1, -1 },
+	{ 0, -1, -1, -1, 1, -1, -1, -1, 2, 3, 4, 5, 6, 7, -1, -1 },
+	{ 0, 1, -1, -1, 2, -1, -1, -1, 3, 4, 5, 6, 7, 8, -1, -1 },
+	{ 0, 1, 2, -1, 3, -1, -1, -1, 4, 5, 6, 7, 8, 9, -1, -1 },
+	{ 0, 1, 2, 3, 4, -1, -1, -1, 5, 6, 7, 8, 9, 10, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, -1, -1, 3, 4, 5, 6, 7, 8, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, -1, -1, 4, 5, 6, 7, 8, 9, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, -1, -1, 5, 6, 7, 8, 9, 10, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, -1, -1, 6, 7, 8, 9, 10, 11, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, -1, 4, 5, 6, 7, 8, 9, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, -1, 5, 6, 7, 8, 9, 10, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, 9, 10, 11, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, -1, 7, 8, 9, 10, 11, 12, -1, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, -1, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, -1, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, -1, -1 },
+	{ 0, -1, -1, -1, 1, -1, -1, -1, 2, -1, -1, -1, 3, 4, 5, -1 },
+	{ 0, 1, -1, -1, 2, -1, -1, -1, 3, -1, -1, -1, 4, 5, 6, -1 },
+	{ 0, 1, 2, -1, 3, -1, -1, -1, 4, -1, -1, -1, 5, 6, 7, -1 },
+	{ 0, 1, 2, 3, 4, -1, -1, -1, 5, -1, -1, -1, 6, 7, 8, -1 },
+	{ 0, -1, -1, -1, 1, 2, -1, -1, 3, -1, -1, -1, 4, 5, 6, -1 },
+	{ 0, 1, -1, -1, 2, 3, -1, -1, 4, -1, -1, -1, 5, 6, 7, -1 },
+	{ 0, 1, 2, -1, 3, 4, -1, -1, 5, -1, -1, -1, 6, 7, 8, -1 },
+	{ 0, 1, 2, 3, 4, 5, -1, -1, 6, -1, -1, -1, 7, 8, 9, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, -1, 4, -1, -1, -1, 5, 6, 7, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, -1, 5, -1, -1, -1, 6, 7, 8, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, -1, 6, -1, -1, -1, 7, 8, 9, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, -1, 7, -1, -1, -1, 8, 9, 10, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, 4, 5, -1, -1, -1, 6, 7, 8, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, 5, 6, -1, -1, -1, 7, 8, 9, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, 6, 7, -1, -1, -1, 8, 9, 10, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, -1, -1, -1, 9, 10, 11, -1 },
+	{ 0, -1, -1, -1, 1, -1, -1, -1, 2, 3, -1, -1, 4, 5, 6, -1 },
+	{ 0, 1, -1, -1, 2, -1, -1, -1, 3, 4, -1, -1, 5, 6, 7, -1 },
+	{ 0, 1, 2, -1, 3, -1, -1, -1, 4, 5, -1, -1, 6, 7, 8, -1 },
+	{ 0, 1, 2, 3, 4, -1, -1, -1, 5, 6, -1, -1, 7, 8, 9, -1 },
+	{ 0, -1, -1, -1, 1, 2, -1, -1, 3, 4, -1, -1, 5, 6, 7, -1 },
+	{ 0, 1, -1, -1, 2, 3, -1, -1, 4, 5, -1, -1, 6, 7, 8, -1 },
+	{ 0, 1, 2, -1, 3, 4, -1, -1, 5, 6, -1, -1, 7, 8, 9, -1 },
+	{ 0, 1, 2, 3, 4, 5, -1, -1, 6, 7, -1, -1, 8, 9, 10, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, -1, 4, 5, -1, -1, 6, 7, 8, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, -1, 5, 6, -1, -1, 7, 8, 9, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, -1, -1, 8, 9, 10, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, -1, 7, 8, -1, -1, 9, 10, 11, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, 4, 5, 6, -1, -1, 7, 8, 9, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, 5, 6, 7, -1, -1, 8, 9, 10, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, 6, 7, 8, -1, -1, 9, 10, 11, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, -1, -1, 10, 11, 12, -1 },
+	{ 0, -1, -1, -1, 1, -1, -1, -1, 2, 3, 4, -1, 5, 6, 7, -1 },
+	{ 0, 1, -1, -1, 2, -1, -1, -1, 3, 4, 5, -1, 6, 7, 8, -1 },
+	{ 0, 1, 2, -1, 3, -1, -1, -1, 4, 5, 6, -1, 7, 8, 9, -1 },
+	{ 0, 1, 2, 3, 4, -1, -1, -1, 5, 6, 7, -1, 8, 9, 10, -1 },
+	{ 0, -1, -1, -1, 1, 2, -1, -1, 3, 4, 5, -1, 6, 7, 8, -1 },
+	{ 0, 1, -1, -1, 2, 3, -1, -1, 4, 5, 6, -1, 7, 8, 9, -1 },
+	{ 0, 1, 2, -1, 3, 4, -1, -1, 5, 6, 7, -1, 8, 9, 10, -1 },
+	{ 0, 1, 2, 3, 4, 5, -1, -1, 6, 7, 8, -1, 9, 10, 11, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, -1, 4, 5, 6, -1, 7, 8, 9, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, -1, 5, 6, 7, -1, 8, 9, 10, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, -1, 7, 8, 9, -1, 10, 11, 12, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, 4, 5, 6, 7, -1, 8, 9, 10, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, 5, 6, 7, 8, -1, 9, 10, 11, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, 6, 7, 8, 9, -1, 10, 11, 12, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, -1, 11, 12, 13, -1 },
+	{ 0, -1, -1, -1, 1, -1, -1, -1, 2, 3, 4, 5, 6, 7, 8, -1 },
+	{ 0, 1, -1, -1, 2, -1, -1, -1, 3, 4, 5, 6, 7, 8, 9, -1 },
+	{ 0, 1, 2, -1, 3, -1, -1, -1, 4, 5, 6, 7, 8, 9, 10, -1 },
+	{ 0, 1, 2, 3, 4, -1, -1, -1, 5, 6, 7, 8, 9, 10, 11, -1 },
+	{ 0, -1, -1, -1, 1, 2, -1, -1, 3, 4, 5, 6, 7, 8, 9, -1 },
+	{ 0, 1, -1, -1, 2, 3, -1, -1, 4, 5, 6, 7, 8, 9, 10, -1 },
+	{ 0, 1, 2, -1, 3, 4, -1, -1, 5, 6, 7, 8, 9, 10, 11, -1 },
+	{ 0, 1, 2, 3, 4, 5, -1, -1, 6, 7, 8, 9, 10, 11, 12, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, -1, 4, 5, 6, 7, 8, 9, 10, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, -1, 5, 6, 7, 8, 9, 10, 11, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, 9, 10, 11, 12, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, -1, 7, 8, 9, 10, 11, 12, 13, -1 },
+	{ 0, -1, -1, -1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, -1 },
+	{ 0, 1, -1, -1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, -1 },
+	{ 0, 1, 2, -1, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, -1 },
+	{ 0, -1, -1, -1, 1, -1, -1, -1, 2, -1, -1, -1, 3, 4, 5, 6 },
+	{ 0, 1, -1, -1, 2, -1, -1, -1, 3, -1, -1, -1, 4, 5, 6, 7 },
+	{ 0, 1, 2, -1, 3, -1, -1, -1, 4, -1, -1, -1, 5, 6, 7, 8 },
+	{ 0, 1, 2, 3, 4, -1, -1, -1, 5, -1, -1, -1, 6, 7, 8, 9 },
+	{ 0, -1, -1, -1, 1, 2, -1, -1, 3, -1, -1, -1, 4, 5, 6, 7 },
+	{ 0, 1, -1, -1, 2, 3, -1, -1, 4, -1, -1, -1, 5, 6, 7, 8 },
+	{ 0, 1, 2, -1, 3, 4, -1, -1, 5, -1, -1, -1, 6, 7, 8, 9 },
+	{ 0, 1, 2, 3, 4, 5, -1, -1, 6, -1, -1, -1, 7, 8, 9, 10 },
+	{ 0, -1, -1, -1, 1, 2, 3, -1, 4, -1, -1, -1, 5, 6, 7, 8 },
+	{ 0, 1, -1, -1, 2, 3, 4, -1, 5, -1, -1, -1, 6, 7, 8, 9 },
+	{ 0, 1, 2, -1, 3, 4, 5, -1, 6, -1, -1, -1, 7, 8, 9, 10 },
+	{ 0, 1, 2, 3, 4, 5, 6, -1, 7, -1, -1, -1, 8, 9, 10, 11 },
+	{ 0, -1, -1, -1, 1, 2, 3, 4, 5, -1, -1, -1, 6, 7, 8, 9 },
+	{ 0, 1, -1, -1, 2, 3, 4, 5, 6, -1, -1, -1, 7, 8, 9, 10 },
+	{ 0, 1, 2, -1, 3, 4, 5, 6, 7, -1, -1, -1, 8, 9, 10, 11 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, -1, -1, -1, 9, 10, 11, 12 },
+	{ 0, -1, -1, -1, 1, -1, -1, -1, 2, 3, -1, -1, 4, 5, 6, 7 },
+	{ 0, 1, -1, -1, 2, -1, -1, -1, 3, 4, -1, -1, 5, 6, 7, 8 },
+	{ 0, 1, 2, -1, 3, -1, -1, -1, 4, 5, -1, -1, 6, 7, 8, 9 },
+	{ 0, 1, 2, 3, 4, -1, -1, -1, 5, 6, -1, -1, 7, 8, 9, 10 },
+	{ 0, -1, -1, -1, 1, 2, -1, -1, 3, 4, -1, -1, 5, 6, 7, 8 },
+	{ 0, 1, -1, -1, 2, 3, -1, -1, 4, 5, -1, -1, 6, 7, 8, 9 },
+	{ 0, 1, 2, -1, 3, 4, -1, -1, 5, 6, -1, -1, 7, 8, 9, 10 },
+	{ 0, 1, 2, 3, 4, 5, -1, -1, 6, 7, -1, -1, 8, 9, 10, 11 },
+	{ 0, -1, -1, -1, 1, 2, 3, -1, 4, 5, -1, -1, 6, 7, 8, 9 },
+	{ 0, 1, -1, -1, 2, 3, 4, -1, 5, 6, -1, -1, 7, 8, 9, 10 },
+	{ 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, -1, -1, 8, 9, 10, 11 },
+	{ 0, 1, 2, 3, 4, 5, 6, -1, 7, 8, -1, -1, 9, 10, 11, 12 },
+	{ 0, -1, -1, -1, 1, 2, 3, 4, 5, 6, -1, -1, 7, 8, 9, 10 },
+	{ 0, 1, -1, -1, 2, 3, 4, 5, 6, 7, -1, -1, 8, 9, 10, 11 },
+	{ 0, 1, 2, -1, 3, 4, 5, 6, 7, 8, -1, -1, 9, 10, 11, 12 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, -1, -1, 10, 11, 12, 13 },
+	{ 0, -1, -1, -1, 1, -1, -1, -1, 2, 3, 4, -1, 5, 6, 7, 8 },
+	{ 0, 1, -1, -1, 2, -1, -1, -1, 3, 4, 5, -1, 6, 7, 8, 9 },
+	{ 0, 1, 2, -1, 3, -1, -1, -1, 4, 5, 6, -1, 7, 8, 9, 10 },
+	{ 0, 1, 2, 3, 4, -1, -1, -1, 5, 6, 7, -1, 8, 9, 10, 11 },
+	{ 0, -1, -1, -1, 1, 2, -1, -1, 3, 4, 5, -1, 6, 7, 8, 9 },
+	{ 0, 1, -1, -1, 2, 3, -1, -1, 4, 5, 6, -1, 7, 8, 9, 10 },
+	{ 0, 1, 2, -1, 3, 4, -1, -1, 5, 6, 7, -1, 8, 9, 10, 11 },
+	{ 0, 1, 2, 3, 4, 5, -1, -1, 6, 7, 8, -1, 9, 10, 11, 12 },
+	{ 0, -1, -1, -1, 1, 2, 3, -1, 4, 5, 6, -1, 7, 8, 9, 10 },
+	{ 0, 1, -1, -1, 2, 3, 4, -1, 5, 6, 7, -1, 8, 9, 10, 11 },
+	{ 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, 12 },
+	{ 0, 1, 2, 3, 4, 5, 6, -1, 7, 8, 9, -1, 10, 11, 12, 13 },
+	{ 0, -1, -1, -1, 1, 2, 3, 4, 5, 6, 7, -1, 8, 9, 10, 11 },
+	{ 0, 1, -1, -1, 2, 3, 4, 5, 6, 7, 8, -1, 9, 10, 11, 12 },
+	{ 0, 1, 2, -1, 3, 4, 5, 6, 7, 8, 9, -1, 10, 11, 12, 13 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, -1, 11, 12, 13, 14 },
+	{ 0, -1, -1, -1, 1, -1, -1, -1, 2, 3, 4, 5, 6, 7, 8, 9 },
+	{ 0, 1, -1, -1, 2, -1, -1, -1, 3, 4, 5, 6, 7, 8, 9, 10 },
+	{ 0, 1, 2, -1, 3, -1, -1, -1, 4, 5, 6, 7, 8, 9, 10, 11 },
+	{ 0, 1, 2, 3, 4, -1, -1, -1, 5, 6, 7, 8, 9, 10, 11, 12 },
+	{ 0, -1, -1, -1, 1, 2, -1, -1, 3, 4, 5, 6, 7, 8, 9, 10 },
+	{ 0, 1, -1, -1, 2, 3, -1, -1, 4, 5, 6, 7, 8, 9, 10, 11 },
+	{ 0, 1, 2, -1, 3, 4, -1, -1, 5, 6, 7, 8, 9, 10, 11, 12 },
+	{ 0, 1, 2, 3, 4, 5, -1, -1, 6, 7, 8, 9, 10, 11, 12, 13 },
+	{ 0, -1, -1, -1, 1, 2, 3, -1, 4, 5, 6, 7, 8, 9, 10, 11 },
+	{ 0, 1, -1, -1, 2, 3, 4, -1, 5, 6, 7, 8, 9, 10, 11, 12 },
+	{ 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, 9, 10, 11, 12, 13 },
+	{ 0, 1, 2, 3, 4, 5, 6, -1, 7, 8, 9, 10, 11, 12, 13, 14 },
+	{ 0, -1, -1, -1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 },
+	{ 0, 1, -1, -1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13 },
+	{ 0, 1, 2, -1, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+};
+
+static const s8 streamvbyte_encode_shuffle[256][16] = {
+	{ 0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 8, 12, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 7, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 7, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 7, 8, 12, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 12, -1, -1, -1, -1, -1, -1 },
+	{ 0, 4, 8, 9, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 8, 9, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 8, 9, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 8, 9, 12, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 8, 9, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 8, 9, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 8, 9, 12, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 8, 9, 12, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 8, 9, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 8, 9, 12, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 8, 9, 12, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 8, 9, 12, -1, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 7, 8, 9, 12, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 7, 8, 9, 12, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 7, 8, 9, 12, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 12, -1, -1, -1, -1, -1 },
+	{ 0, 4, 8, 9, 10, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 8, 9, 10, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 8, 9, 10, 12, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 8, 9, 10, 12, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 8, 9, 10, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 8, 9, 10, 12, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 8, 9, 10, 12, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 8, 9, 10, 12, -1, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 8, 9, 10, 12, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 8, 9, 10, 12, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 8, 9, 10, 12, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 7, 8, 9, 10, 12, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 7, 8, 9, 10, 12, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 7, 8, 9, 10, 12, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 12, -1, -1, -1, -1 },
+	{ 0, 4, 8, 9, 10, 11, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 8, 9, 10, 11, 12, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 8, 9, 10, 11, 12, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 8, 9, 10, 11, 12, -1, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 8, 9, 10, 11, 12, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 8, 9, 10, 11, 12, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 8, 9, 10, 11, 12, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 8, 9, 10, 11, 12, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 8, 9, 10, 11, 12, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 8, 9, 10, 11, 12, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 8, 9, 10, 11, 12, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 8, 9, 10, 11, 12, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 7, 8, 9, 10, 11, 12, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 7, 8, 9, 10, 11, 12, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, -1, -1, -1 },
+	{ 0, 4, 8, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 8, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 8, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 8, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 8, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 8, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 8, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 8, 12, 13, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 8, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 8, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 8, 12, 13, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 8, 12, 13, -1, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 7, 8, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 7, 8, 12, 13, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 7, 8, 12, 13, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 13, -1, -1, -1, -1, -1 },
+	{ 0, 4, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 8, 9, 12, 13, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 7, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 7, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 7, 8, 9, 12, 13, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 12, 13, -1, -1, -1, -1 },
+	{ 0, 4, 8, 9, 10, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 8, 9, 10, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 8, 9, 10, 12, 13, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 8, 9, 10, 12, 13, -1, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 8, 9, 10, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 8, 9, 10, 12, 13, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 8, 9, 10, 12, 13, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 8, 9, 10, 12, 13, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 8, 9, 10, 12, 13, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 8, 9, 10, 12, 13, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 8, 9, 10, 12, 13, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 7, 8, 9, 10, 12, 13, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 7, 8, 9, 10, 12, 13, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 7, 8, 9, 10, 12, 13, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 12, 13, -1, -1, -1 },
+	{ 0, 4, 8, 9, 10, 11, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 8, 9, 10, 11, 12, 13, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 8, 9, 10, 11, 12, 13, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 8, 9, 10, 11, 12, 13, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 8, 9, 10, 11, 12, 13, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 8, 9, 10, 11, 12, 13, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 8, 9, 10, 11, 12, 13, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 8, 9, 10, 11, 12, 13, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 8, 9, 10, 11, 12, 13, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 8, 9, 10, 11, 12, 13, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 8, 9, 10, 11, 12, 13, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 8, 9, 10, 11, 12, 13, -1, -1, -1 },
+	{ 0, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, -1, -1 },
+	{ 0, 4, 8, 12, 13, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 8, 12, 13, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 8, 12, 13, 14, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 8, 12, 13, 14, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 8, 12, 13, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 8, 12, 13, 14, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 8, 12, 13, 14, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 8, 12, 13, 14, -1, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 8, 12, 13, 14, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 8, 12, 13, 14, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 8, 12, 13, 14, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 8, 12, 13, 14, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 7, 8, 12, 13, 14, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 7, 8, 12, 13, 14, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 7, 8, 12, 13, 14, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 13, 14, -1, -1, -1, -1 },
+	{ 0, 4, 8, 9, 12, 13, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 8, 9, 12, 13, 14, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 8, 9, 12, 13, 14, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 8, 9, 12, 13, 14, -1, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 8, 9, 12, 13, 14, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 8, 9, 12, 13, 14, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 8, 9, 12, 13, 14, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 8, 9, 12, 13, 14, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 8, 9, 12, 13, 14, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 8, 9, 12, 13, 14, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 8, 9, 12, 13, 14, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 8, 9, 12, 13, 14, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 7, 8, 9, 12, 13, 14, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 7, 8, 9, 12, 13, 14, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 7, 8, 9, 12, 13, 14, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 12, 13, 14, -1, -1, -1 },
+	{ 0, 4, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1 },
+	{ 0, 4, 5, 6, 7, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 7, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 7, 8, 9, 10, 12, 13, 14, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 12, 13, 14, -1, -1 },
+	{ 0, 4, 8, 9, 10, 11, 12, 13, 14, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 8, 9, 10, 11, 12, 13, 14, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 8, 9, 10, 11, 12, 13, 14, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 8, 9, 10, 11, 12, 13, 14, -1, -1, -1, -1 },
+	{ 0, 4, 5, 8, 9, 10, 11, 12, 13, 14, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 8, 9, 10, 11, 12, 13, 14, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 8, 9, 10, 11, 12, 13, 14, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 8, 9, 10, 11, 12, 13, 14, -1, -1, -1 },
+	{ 0, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, -1, -1 },
+	{ 0, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, -1 },
+	{ 0, 4, 8, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 8, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 8, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 8, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 8, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 8, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 8, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 8, 12, 13, 14, 15, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 8, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 8, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 8, 12, 13, 14, 15, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 8, 12, 13, 14, 15, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 7, 8, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 7, 8, 12, 13, 14, 15, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 7, 8, 12, 13, 14, 15, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 13, 14, 15, -1, -1, -1 },
+	{ 0, 4, 8, 9, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 8, 9, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 8, 9, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 8, 9, 12, 13, 14, 15, -1, -1, -1, -1, -1 },
+	{ 0, 4, 5, 8, 9, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 8, 9, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 8, 9, 12, 13, 14, 15, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 8, 9, 12, 13, 14, 15, -1, -1, -1, -1 },
+	{ 0, 4, 5, 6, 8, 9, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 8, 9, 12, 13, 14, 15, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 8, 9, 12, 13, 14, 15, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 8, 9, 12, 13, 14, 15, -1, -1, -1 },
+	{ 0, 4, 5, 6, 7, 8, 9, 12, 13, 14, 15, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 7, 8, 9, 12, 13, 14, 15, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 7, 8, 9, 12, 13, 14, 15, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 12, 13, 14, 15, -1, -1 },
+	{ 0, 4, 8, 9, 10, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 8, 9, 10, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 8, 9, 10, 12, 13, 14, 15, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 8, 9, 10, 12, 13, 14, 15, -1, -1, -1, -1 },
+	{ 0, 4, 5, 8, 9, 10, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 8, 9, 10, 12, 13, 14, 15, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 8, 9, 10, 12, 13, 14, 15, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 8, 9, 10, 12, 13, 14, 15, -1, -1, -1 },
+	{ 0, 4, 5, 6, 8, 9, 10, 12, 13, 14, 15, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 8, 9, 10, 12, 13, 14, 15, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, 15, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 8, 9, 10, 12, 13, 14, 15, -1, -1 },
+	{ 0, 4, 5, 6, 7, 8, 9, 10, 12, 13, 14, 15, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 7, 8, 9, 10, 12, 13, 14, 15, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 7, 8, 9, 10, 12, 13, 14, 15, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 12, 13, 14, 15, -1 },
+	{ 0, 4, 8, 9, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 8, 9, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 8, 9, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 8, 9, 10, 11, 12, 13, 14, 15, -1, -1, -1 },
+	{ 0, 4, 5, 8, 9, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 8, 9, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 8, 9, 10, 11, 12, 13, 14, 15, -1, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 8, 9, 10, 11, 12, 13, 14, 15, -1, -1 },
+	{ 0, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, 15, -1, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, 15, -1, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, 15, -1 },
+	{ 0, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, -1, -1, -1 },
+	{ 0, 1, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, -1, -1 },
+	{ 0, 1, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, -1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+};
+
+static const u8 streamvbyte_length[256] = {
+	4, 5, 6, 7, 5, 6, 7, 8, 6, 7, 8, 9, 7, 8, 9, 10,
+	5, 6, 7, 8, 6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11,
+	6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12,
+	7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13,
+	5, 6, 7, 8, 6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11,
+	6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12,
+	7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13,
+	8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14,
+	6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12,
+	7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13,
+	8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14,
+	9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15,
+	7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13,
+	8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14,
+	9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15,
+	10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16,
+};
+#endif /* defined(_varint_ssse3) || defined(_varint_neon) */
+
+size_t varint_encode_u32_array(u8 *dst, const u32 *src, size_t count) {
+	u8 *p = dst;
+	size_t i;
+	for (i = 0; i < count; ++i)
+		p += varint_encode_u32(p, src[i]);
+	return (size_t) (p - dst);
+}
+
+size_t varint_encode_u64_array(u8 *dst, const u64 *src, size_t count) {
+	u8 *p = dst;
+	size_t i;
+	for (i = 0; i < count; ++i)
+		p += varint_encode_u64(p, src[i]);
+	return (size_t) (p - dst);
+}
+
+/* Decodes one value from a full 8-byte window: the terminator is found from the
+   inverted continuation bits and the 7-bit groups are gathered with shifts, so
+   there is no per-byte loop. A fifth byte may only carry the top four bits. */
+_varint_alwaysinline static size_t varint_decode_u32_word(u32 *v, const u8 *src) {
+	u64 w = _load_le64(src);
+	u64 stop = ~w & imm_u64(0x0000008080808080);
+	if (stop == 0)
+		return 0;
+	w &= stop ^ (stop - 1);
+	if ((w >> 36 & 7) != 0)
+		return 0;
+	*v = (u32) (
+		(w & 0x7f) |
+		(w >> 1 & 0x3f80) |
+		(w >> 2 & 0x1fc000) |
+		(w >> 3 & 0xfe00000) |
+		(w >> 4 & 0xf0000000));
+	return (ctz_u64(stop) + 1) >> 3;
+}
+
+size_t varint_decode_u32_array(u32 *dst, size_t count, const u8 *src, size_t size) {
+	const u8 *p = src;
+	const u8 *end = src + size;
+	size_t i = 0;
+	size_t n;
+
+#if defined(__SSE2__) || defined(_M_X64)
+	/* Runs of single-byte values, the common case for deltas, are widened
+	   eight at a time straight from the continuation bit mask. */
+	const __m128i zero = _mm_setzero_si128();
+	while (i + 8 <= count && end - p >= 16) {
+		__m128i b = _mm_loadu_si128((const __m128i *) p);
+		if ((_mm_movemask_epi8(b) & 0xff) == 0) {
+			__m128i h = _mm_unpacklo_epi8(b, zero);
+			_mm_storeu_si128((__m128i *) (dst + i), _mm_unpacklo_epi16(h, zero));
+			_mm_storeu_si128((__m128i *) (dst + i + 4), _mm_unpackhi_epi16(h, zero));
+			i += 8;
+			p += 8;
+			continue;
+		}
+		if ((n = varint_decode_u32_word(dst + i, p)) == 0)
+			return 0;
+		++i;
+		p += n;
+	}
+#endif
+	for (; i < count && end - p >= 8; ++i, p += n)
+		if ((n = varint_decode_u32_word(dst + i, p)) == 0)
+			return 0;
+	for (; i < count; ++i, p += n)
+		if ((n = varint_decode_u32(dst + i, p, (size_t) (end - p))) == 0)
+			return 0;
+	return (size_t) (p - src);
+}
+
+size_t varint_decode_u64_array(u64 *dst, size_t count, const u8 *src, size_t size) {
+	const u8 *p = src;
+	const u8 *end = src + size;
+	size_t i;
+	size_t n;
+	for (i = 0; i < count; ++i, p += n)
+		if ((n = varint_decode_u64(dst + i, p, (size_t) (end - p))) == 0)
+			return 0;
+	return (size_t) (p - src);
+}
+
+_varint_alwaysinline static u32 streamvbyte_code(u32 v) {
+	return (u32) (v > 0xff) + (u32) (v > 0xffff) + (u32) (v > 0xffffff);
+}
+
+#if defined(_varint_ssse3)
+/* Moves bits 0-3 to bits 0, 2, 4 and 6. */
+_varint_alwaysinline static u32 streamvbyte_spread(u32 x) {
+	x = (x | x << 2) & 0x33;
+	return (x | x << 1) & 0x55;
+}
+#endif
+
+size_t streamvbyte_encode(u8 *dst, const u32 *src, size_t count) {
+	u8 *ctrl = dst;
+	u8 *data = dst + (count + 3) / 4;
+	size_t i = 0;
+
+	/* Each group stores a full 16 bytes, which stays inside
+	   streamvbyte_max_size() as long as four values remain. */
+#if defined(_varint_ssse3)
+	const __m128i bias = _mm_set1_epi32((int) 0x80000000);
+	const __m128i lim1 = _mm_set1_epi32((int) (0x000000ff ^ 0x80000000));
+	const __m128i lim2 = _mm_set1_epi32((int) (0x0000ffff ^ 0x80000000));
+	const __m128i lim3 = _mm_set1_epi32((int) (0x00ffffff ^ 0x80000000));
+	for (; i + 4 <= count; i += 4) {
+		u32x4 v = _mm_loadu_si128((const __m128i *) (src + i));
+		u32x4 x = _mm_xor_si128(v, bias);
+		u32x4 len = _mm_sub_epi32(_mm_setzero_si128(), _mm_add_epi32(_mm_add_epi32(
+			_mm_cmpgt_epi32(x, lim1), _mm_cmpgt_epi32(x, lim2)), _mm_cmpgt_epi32(x, lim3)));
+		u32 lo = (u32) _mm_movemask_ps(_mm_castsi128_ps(_mm_slli_epi32(len, 31)));
+		u32 hi = (u32) _mm_movemask_ps(_mm_castsi128_ps(_mm_slli_epi32(len, 30)));
+		u32 code = streamvbyte_spread(lo) | streamvbyte_spread(hi) << 1;
+		ctrl[i >> 2] = (u8) code;
+		_mm_storeu_si128((__m128i *) data, _mm_shuffle_epi8(v,
+			_mm_loadu_si128((const __m128i *) streamvbyte_encode_shuffle[code])));
+		data += streamvbyte_length[code];
+	}
+#elif defined(_varint_neon)
+	static const s32 shifts[4] = {0, 2, 4, 6};
+	const int32x4_t shift = vld1q_s32(shifts);
+	for (; i + 4 <= count; i += 4) {
+		uint32x4_t v = vld1q_u32(src + i);
+		uint32x4_t len = vaddq_u32(vaddq_u32(
+			vshrq_n_u32(vcgtq_u32(v, vdupq_n_u32(0x000000ff)), 31),
+			vshrq_n_u32(vcgtq_u32(v, vdupq_n_u32(0x0000ffff)), 31)),
+			vshrq_n_u32(vcgtq_u32(v, vdupq_n_u32(0x00ffffff)), 31));
+		u32 code = vaddvq_u32(vshlq_u32(len, shift));
+		ctrl[i >> 2] = (u8) code;
+		vst1q_u8(data, vqtbl1q_u8(vreinterpretq_u8_u32(v),
+			vreinterpretq_u8_s8(vld1q_s8(streamvbyte_encode_shuffle[code]))));
+		data += streamvbyte_length[code];
+	}
+#endif
+	if (i < count)
+		memset(ctrl + (i >> 2), 0, (count + 3) / 4 - (i >> 2));
+	for (; i < count; ++i) {
+		u32 code = streamvbyte_code(src[i]);
+		ctrl[i >> 2] |= (u8) (code << ((i & 3) * 2));
+		_store_le32(data, src[i]);
+		data += code + 1;
+	}
+	return (size_t) (data - dst);
+}
+
+size_t streamvbyte_decode(u32 *dst, size_t count, const u8 *src, size_t size) {
+	const u8 *ctrl = src;
+	const u8 *data = src + (count + 3) / 4;
+	const u8 *end = src + size;
+	size_t i = 0;
+
+	if (size < (count + 3) / 4)
+		return 0;
+
+#if defined(_varint_ssse3)
+	for (; i + 4 <= count && end - data >= 16; i += 4) {
+		u32 code = ctrl[i >> 2];
+		u32x4 v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) data),
+			_mm_loadu_si128((const __m128i *) streamvbyte_decode_shuffle[code]));
+		_mm_storeu_si128((__m128i *) (dst + i), v);
+		data += streamvbyte_length[code];
+	}
+#elif defined(_varint_neon)
+	for (; i + 4 <= count && end - data >= 16; i += 4) {
+		u32 code = ctrl[i >> 2];
+		uint8x16_t v = vqtbl1q_u8(vld1q_u8(data),
+			vreinterpretq_u8_s8(vld1q_s8(streamvbyte_decode_shuffle[code])));
+		vst1q_u32(dst + i, vreinterpretq_u32_u8(v));
+		data += streamvbyte_length[code];
+	}
+#endif
+	for (; i < count; ++i) {
+		u32 len = ((ctrl[i >> 2] >> ((i & 3) * 2)) & 3) + 1;
+		u32 v = 0;
+		u32 j;
+		if ((size_t) (end - data) < len)
+			return 0;
+		for (j = 0; j < len; ++j)
+			v |= (u32) data[j] << (8 * j);
+		dst[i] = v;
+		data += len;
+	}
+	return (size_t) (data - src);
+}
@@ -0,0 +1,150 @@
+
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+#ifndef AW_VARINT_H
+#define AW_VARINT_H
+
+#include "aw-arith.h"
+
+#include <stddef.h>
+
+#if defined(_varint_dllexport)
+# if defined(_MSC_VER)
+#  define _varint_api extern __declspec(dllexport)
+# elif defined(__GNUC__)
+#  define _varint_api __attribute__((visibility("default"))) extern
+# endif
+#elif defined(_varint_dllimport)
+# if defined(_MSC_VER)
+#  define _varint_api extern __declspec(dllimport)
+# endif
+#endif
+#ifndef _varint_api
+# define _varint_api extern
+#endif
+
+#if defined(__GNUC__)
+# define _varint_alwaysinline __attribute__((always_inline)) inline
+#elif defined(_MSC_VER)
+# define _varint_alwaysinline __forceinline
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VARINT_MAX32 5
+#define VARINT_MAX64 10
+
+_varint_alwaysinline static u32 zigzag_s32(s32 v) { return ((u32) v << 1) ^ (u32) asr31(v); }
+_varint_alwaysinline static u64 zigzag_s64(s64 v) { return ((u64) v << 1) ^ (u64) asr63(v); }
+_varint_alwaysinline static s32 unzigzag_s32(u32 v) { return (s32) (v >> 1) ^ -(s32) (v & 1); }
+_varint_alwaysinline static s64 unzigzag_s64(u64 v) { return (s64) (v >> 1) ^ -(s64) (v & 1); }
+
+_varint_alwaysinline static size_t varint_size_u32(u32 v) {
+	return (38 - clz_u32(v | 1)) / 7;
+}
+
+_varint_alwaysinline static size_t varint_size_u64(u64 v) {
+	u32 hi = (u32) (v >> 32);
+	u32 bits = hi ? 64 - clz_u32(hi) : 32 - clz_u32((u32) v | 1);
+	return (bits + 6) / 7;
+}
+
+/* LEB128. Encoders write at most VARINT_MAX32/VARINT_MAX64 bytes and return
+   the number written; decoders return the number of bytes consumed, or 0 if
+   the input is truncated, longer than the type allows, or has bits set in
+   the last byte past the width of the type. */
+_varint_alwaysinline static size_t varint_encode_u32(u8 *dst, u32 v) {
+	size_t n = 0;
+	for (; v >= 0x80; v >>= 7)
+		dst[n++] = (u8) (v | 0x80);
+	dst[n++] = (u8) v;
+	return n;
+}
+
+_varint_alwaysinline static size_t varint_encode_u64(u8 *dst, u64 v) {
+	size_t n = 0;
+	for (; v >= 0x80; v >>= 7)
+		dst[n++] = (u8) (v | 0x80);
+	dst[n++] = (u8) v;
+	return n;
+}
+
+_varint_alwaysinline static size_t varint_decode_u32(u32 *v, const u8 *src, size_t size) {
+	u32 r = 0;
+	size_t i;
+	if (size > VARINT_MAX32)
+		size = VARINT_MAX32;
+	for (i = 0; i < size; ++i) {
+		r |= (u32) (src[i] & 0x7f) << (7 * i);
+		if (src[i] < 0x80) {
+			if (i == VARINT_MAX32 - 1 && src[i] > 0x0f)
+				return 0;
+			*v = r;
+			return i + 1;
+		}
+	}
+	return 0;
+}
+
+_varint_alwaysinline static size_t varint_decode_u64(u64 *v, const u8 *src, size_t size) {
+	u64 r = 0;
+	size_t i;
+	if (size > VARINT_MAX64)
+		size = VARINT_MAX64;
+	for (i = 0; i < size; ++i) {
+		r |= (u64) (src[i] & 0x7f) << (7 * i);
+		if (src[i] < 0x80) {
+			if (i == VARINT_MAX64 - 1 && src[i] > 0x01)
+				return 0;
+			*v = r;
+			return i + 1;
+		}
+	}
+	return 0;
+}
+
+/* Bulk LEB128. Decoders return the number of bytes consumed, or 0 if fewer
+   than count values could be decoded from size bytes. */
+_varint_api size_t varint_encode_u32_array(u8 *dst, const u32 *src, size_t count);
+_varint_api size_t varint_decode_u32_array(u32 *dst, size_t count, const u8 *src, size_t size);
+_varint_api size_t varint_encode_u64_array(u8 *dst, const u64 *src, size_t count);
+_varint_api size_t varint_decode_u64_array(u64 *dst, size_t count, const u8 *src, size_t size);
+
+/* Stream VByte: a block of 2-bit length codes, four per byte, followed by the
+   1-4 little-endian data bytes of each value. Both directions run four values
+   per shuffle. The encoder stores whole 16-byte groups and 4-byte values
+   past the end of what it returns, so dst must have streamvbyte_max_size()
+   bytes however short the encoding turns out. */
+_varint_alwaysinline static size_t streamvbyte_max_size(size_t count) { return (count + 3) / 4 + count * 4; }
+
+_varint_api size_t streamvbyte_encode(u8 *dst, const u32 *src, size_t count);
+_varint_api size_t streamvbyte_decode(u32 *dst, size_t count, const u8 *src, size_t size);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* AW_VARINT_H */
+
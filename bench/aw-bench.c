@@ -0,0 +1,1083 @@
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+/* Microbenchmarks. Each one runs a loop over in-cache data, calibrated to a
+   fixed time and repeated, and reports the fastest run in ns per operation,
+   bytes per second where it moves bytes, and cycles and instructions per
+   operation from perf_event_open where Linux allows it. Names ending in
+   .ref run a naive or compiler-builtin version of the same work, and .loop
+   a batch function done with the scalar helper, for comparison.
+
+     aw-bench [--json | --csv] [--quick] [--time ms] [--list] [filter...]
+
+   JSON Lines and CSV carry one record per benchmark for regression
+   tracking; filters select benchmarks whose name contains any of them. */
+
+#include "aw-arith.h"
+#include "aw-bitset.h"
+#include "aw-bitstream.h"
+#include "aw-bytes.h"
+#include "aw-checksum.h"
+#include "aw-cpu.h"
+#include "aw-endian.h"
+#include "aw-format.h"
+#include "aw-hash.h"
+#include "aw-parse.h"
+#include "aw-random.h"
+#include "aw-sort.h"
+#include "aw-strings.h"
+#include "aw-utf.h"
+#include "aw-varint.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+# include <windows.h>
+#else
+# include <time.h>
+#endif
+
+#if defined(__linux__)
+# include <linux/perf_event.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+# define BENCH_PERF 1
+#endif
+
+#if defined(_MSC_VER)
+# include <intrin.h>
+#endif
+
+#define countof(a) (sizeof (a) / sizeof (a)[0])
+
+/* Hides the contents of p from the optimizer, so loop bodies are not hoisted
+   out of the repeat loop or folded into constants. */
+#if defined(__GNUC__)
+# define BENCH_OPAQUE(p) __asm__ __volatile__("" : "+r"(p) : : "memory")
+#elif defined(_MSC_VER)
+# define BENCH_OPAQUE(p) _ReadWriteBarrier()
+#else
+# define BENCH_OPAQUE(p) ((void) 0)
+#endif
+
+#define BENCH_N 4096
+#define BENCH_BYTES (64 * 1024)
+
+static u32 bench_u32[BENCH_N];
+static u64 bench_u64[BENCH_N];
+static f32 bench_f32[BENCH_N];
+static q16 bench_q16[BENCH_N];
+static q32 bench_q32[BENCH_N];
+static u32 bench_dst32[BENCH_N];
+static u64 bench_dst64[BENCH_N];
+static q16 bench_dst16[BENCH_N];
+static f32 bench_dstf[BENCH_N];
+static char bench_text[BENCH_BYTES + 1];
+static char bench_upper[BENCH_BYTES + 1];
+static char bench_utf8[BENCH_BYTES];
+static u8 bench_bytes[BENCH_N * 10];
+static size_t bench_bytes_size;
+static char bench_numbers[BENCH_N][24];
+static u32 bench_number_len[BENCH_N];
+static struct strintern bench_intern;
+static struct strview bench_words[BENCH_N];
+static struct bitset_index bench_index;
+
+static volatile u64 bench_sink;
+
+/* Divisors are read through a volatile so the compiler cannot specialise
+   the reference division for a known constant. */
+static volatile u32 bench_div32 = 1000003;
+static volatile u64 bench_div64 = imm_u64(1000000000039);
+
+/*
+ * Scalar helpers over BENCH_N elements per iteration
+ */
+
+#define BENCH_MAP(fn, T, src, expr) \
+static u64 fn(u64 iters) { \
+	u64 acc = 0; \
+	while (iters--) { \
+		const T *p = src; \
+		size_t i; \
+		BENCH_OPAQUE(p); \
+		for (i = 0; i < BENCH_N; ++i) { \
+			T x = p[i], y = p[(i + 1) & (BENCH_N - 1)]; \
+			(void) y; \
+			acc += (u64) (expr); \
+		} \
+	} \
+	return acc; \
+}
+
+static u32 ref_clz_u32(u32 a) {
+#if defined(__GNUC__)
+	return a != 0 ? (u32) __builtin_clz(a) : 32;
+#else
+	u32 n = 0;
+	for (; n < 32 && !(a >> (31 - n) & 1); ++n)
+		;
+	return n;
+#endif
+}
+
+static u32 ref_clz_u64(u64 a) {
+#if defined(__GNUC__)
+	return a != 0 ? (u32) __builtin_clzll(a) : 64;
+#else
+	u32 hi = (u32) (a >> 32);
+	return hi != 0 ? ref_clz_u32(hi) : 32 + ref_clz_u32((u32) a);
+#endif
+}
+
+static u32 ref_popcount_u64(u64 a) {
+	u32 n = 0;
+	for (; a != 0; a &= a - 1)
+		++n;
+	return n;
+}
+
+static u32 ref_byteswap32(u32 v) {
+	return v >> 24 | (v >> 8 & 0xff00) | (v << 8 & 0xff0000) | v << 24;
+}
+
+BENCH_MAP(bench_sel_s32, u32, bench_u32, sel_s32((s32) x, (s32) y, (s32) x))
+BENCH_MAP(bench_sel_s32_ref, u32, bench_u32, (s32) x >= 0 ? (s32) y : (s32) x)
+BENCH_MAP(bench_min_u32, u32, bench_u32, min_u32(x, y))
+BENCH_MAP(bench_min_u32_ref, u32, bench_u32, x < y ? x : y)
+BENCH_MAP(bench_clamp_s32, u32, bench_u32, clamp_s32((s32) x, -1000000, 1000000))
+BENCH_MAP(bench_clamp_s32_ref, u32, bench_u32, (s32) x < -1000000 ? -1000000 : (s32) x > 1000000 ? 1000000 : (s32) x)
+BENCH_MAP(bench_abs_s32, u32, bench_u32, abs_s32((s32) x))
+BENCH_MAP(bench_abs_s32_ref, u32, bench_u32, (s32) x < 0 ? 0 - x : x)
+BENCH_MAP(bench_clz_u32, u32, bench_u32, clz_u32(x))
+BENCH_MAP(bench_clz_u32_ref, u32, bench_u32, ref_clz_u32(x))
+BENCH_MAP(bench_ctz_u32, u32, bench_u32, ctz_u32(x))
+BENCH_MAP(bench_clz_u64, u64, bench_u64, clz_u64(x))
+BENCH_MAP(bench_clz_u64_ref, u64, bench_u64, ref_clz_u64(x))
+BENCH_MAP(bench_ctz_u64, u64, bench_u64, ctz_u64(x))
+BENCH_MAP(bench_popcount_u64, u64, bench_u64, popcount_u64(x))
+BENCH_MAP(bench_popcount_u64_ref, u64, bench_u64, ref_popcount_u64(x))
+BENCH_MAP(bench_nthbit_u64, u64, bench_u64, x != 0 ? nthbit_u64(x, (u32) y % popcount_u64(x)) : 0)
+BENCH_MAP(bench_bitswap_u32, u32, bench_u32, bitswap_u32(x))
+BENCH_MAP(bench_trunc_f32, f32, bench_f32, trunc_f32(x))
+BENCH_MAP(bench_trunc_f32_ref, f32, bench_f32, (s32) x)
+BENCH_MAP(bench_round_f32, f32, bench_f32, round_f32(x))
+BENCH_MAP(bench_round_f32_ref, f32, bench_f32, lrintf(x))
+BENCH_MAP(bench_floor_f32, f32, bench_f32, floor_f32(x))
+BENCH_MAP(bench_floor_f32_ref, f32, bench_f32, (s32) floorf(x))
+BENCH_MAP(bench_mul_q32, q32, bench_q32, mul_q32(x, y, 16))
+BENCH_MAP(bench_mulsat_q32, q32, bench_q32, mulsat_q32(x, y, 16))
+BENCH_MAP(bench_byteswap32, u32, bench_u32, _byteswap32(x))
+BENCH_MAP(bench_byteswap32_ref, u32, bench_u32, ref_byteswap32(x))
+BENCH_MAP(bench_byteswap64, u64, bench_u64, _byteswap64(x))
+
+static u64 bench_mulwide_u64(u64 iters) {
+	u64 acc = 0, lo;
+	while (iters--) {
+		const u64 *p = bench_u64;
+		size_t i;
+		BENCH_OPAQUE(p);
+		for (i = 0; i < BENCH_N; ++i)
+			acc += mulwide_u64(p[i], p[(i + 1) & (BENCH_N - 1)], &lo) ^ lo;
+	}
+	return acc;
+}
+
+static u64 bench_reduce_u32(u64 iters) {
+	u64 acc = 0;
+	u32 n = bench_div32;
+	while (iters--) {
+		const u32 *p = bench_u32;
+		size_t i;
+		BENCH_OPAQUE(p);
+		for (i = 0; i < BENCH_N; ++i)
+			acc += reduce_u32(p[i], n);
+	}
+	return acc;
+}
+
+#define BENCH_DIV(fn, T, src, make, expr) \
+static u64 fn(u64 iters) { \
+	u64 acc = 0; \
+	T d = (T) (sizeof (T) == 4 ? bench_div32 : bench_div64); \
+	make; \
+	(void) d; \
+	while (iters--) { \
+		const T *p = src; \
+		size_t i; \
+		BENCH_OPAQUE(p); \
+		for (i = 0; i < BENCH_N; ++i) { \
+			T x = p[i]; \
+			acc += (u64) (expr); \
+		} \
+	} \
+	return acc; \
+}
+
+BENCH_DIV(bench_fastdiv_u32, u32, bench_u32, struct divider_u32 dv = divider_u32_make(d), fastdiv_u32(x, dv))
+BENCH_DIV(bench_fastmod_u32, u32, bench_u32, struct divider_u32 dv = divider_u32_make(d), fastmod_u32(x, dv))
+BENCH_DIV(bench_div_u32_ref, u32, bench_u32, (void) 0, x / d)
+BENCH_DIV(bench_mod_u32_ref, u32, bench_u32, (void) 0, x % d)
+BENCH_DIV(bench_fastdiv_u64, u64, bench_u64, struct divider_u64 dv = divider_u64_make(d), fastdiv_u64(x, dv))
+BENCH_DIV(bench_fastdivbf_u64, u64, bench_u64, struct divider_u64 dv = divider_u64_make(d), fastdivbf_u64(x, dv))
+BENCH_DIV(bench_div_u64_ref, u64, bench_u64, (void) 0, x / d)
+
+/*
+ * Batch functions against the same work done one element at a time
+ */
+
+#define BENCH_BATCH(fn, body) \
+static u64 fn(u64 iters) { \
+	while (iters--) { \
+		size_t i; \
+		(void) i; \
+		void *p = bench_dst32; \
+		body; \
+		BENCH_OPAQUE(p); \
+	} \
+	return bench_dst32[7] + bench_dst64[7] + (u64) bench_dst16[7] + (u64) bench_dstf[7]; \
+}
+
+BENCH_BATCH(bench_round_f32_array, round_f32_array((s32 *) bench_dst32, bench_f32, BENCH_N))
+BENCH_BATCH(bench_round_f32_loop, for (i = 0; i < BENCH_N; ++i) bench_dst32[i] = (u32) round_f32(bench_f32[i]))
+BENCH_BATCH(bench_floor_f32_array, floor_f32_array((s32 *) bench_dst32, bench_f32, BENCH_N))
+BENCH_BATCH(bench_floor_f32_loop, for (i = 0; i < BENCH_N; ++i) bench_dst32[i] = (u32) floor_f32(bench_f32[i]))
+BENCH_BATCH(bench_f32_to_q32_array, f32_to_q32_array((q32 *) bench_dst32, bench_f32, BENCH_N, 8))
+BENCH_BATCH(bench_f32_to_q32_loop, for (i = 0; i < BENCH_N; ++i) bench_dst32[i] = (u32) f32_to_q32(bench_f32[i], 8))
+BENCH_BATCH(bench_q32_to_f32_array, q32_to_f32_array(bench_dstf, bench_q32, BENCH_N, 16))
+BENCH_BATCH(bench_q32_to_f32_loop, for (i = 0; i < BENCH_N; ++i) bench_dstf[i] = q32_to_f32(bench_q32[i], 16))
+BENCH_BATCH(bench_mul_q32_array, mul_q32_array((q32 *) bench_dst32, bench_q32, bench_q32 + 1, BENCH_N - 1, 16))
+BENCH_BATCH(bench_mul_q32_loop, for (i = 0; i < BENCH_N - 1; ++i) bench_dst32[i] = (u32) mul_q32(bench_q32[i], bench_q32[i + 1], 16))
+BENCH_BATCH(bench_mulsat_q16_array, mulsat_q16_array(bench_dst16, bench_q16, bench_q16 + 1, BENCH_N - 1, 8))
+BENCH_BATCH(bench_mulsat_q16_loop, for (i = 0; i < BENCH_N - 1; ++i) bench_dst16[i] = mulsat_q16(bench_q16[i], bench_q16[i + 1], 8))
+BENCH_BATCH(bench_addsat_q32_array, addsat_q32_array((q32 *) bench_dst32, bench_q32, bench_q32 + 1, BENCH_N - 1))
+BENCH_BATCH(bench_addsat_q32_loop, for (i = 0; i < BENCH_N - 1; ++i) bench_dst32[i] = (u32) addsat_q32(bench_q32[i], bench_q32[i + 1]))
+BENCH_BATCH(bench_fastdiv_u32_array, fastdiv_u32_array(bench_dst32, bench_u32, BENCH_N, divider_u32_make(bench_div32)))
+BENCH_BATCH(bench_fastdiv_u32_loop, { struct divider_u32 d = divider_u32_make(bench_div32);
+	for (i = 0; i < BENCH_N; ++i) bench_dst32[i] = fastdiv_u32(bench_u32[i], d); })
+BENCH_BATCH(bench_byteswap16_array, _byteswap16_array((u16 *) bench_dst16, (const u16 *) bench_q16, BENCH_N))
+BENCH_BATCH(bench_byteswap32_array, _byteswap32_array(bench_dst32, bench_u32, BENCH_N))
+BENCH_BATCH(bench_byteswap32_loop, for (i = 0; i < BENCH_N; ++i) bench_dst32[i] = _byteswap32(bench_u32[i]))
+BENCH_BATCH(bench_byteswap64_array, _byteswap64_array(bench_dst64, bench_u64, BENCH_N))
+BENCH_BATCH(bench_byteswap64_loop, for (i = 0; i < BENCH_N; ++i) bench_dst64[i] = _byteswap64(bench_u64[i]))
+BENCH_BATCH(bench_load_be32_loop, for (i = 0; i < BENCH_N; ++i) bench_dst32[i] = _load_be32((const u8 *) bench_u32 + 4 * i))
+
+/*
+ * Bitsets of BENCH_N words
+ */
+
+BENCH_BATCH(bench_bitset_count, bench_dst64[7] = bitset_count(bench_u64, BENCH_N))
+BENCH_BATCH(bench_bitset_count_loop, { u64 c = 0; for (i = 0; i < BENCH_N; ++i) c += popcount_u64(bench_u64[i]); bench_dst64[7] = c; })
+BENCH_BATCH(bench_bitset_and, bench_dst64[7] = bitset_and(bench_dst64, bench_dst64, bench_u64, BENCH_N))
+BENCH_BATCH(bench_bitset_and_loop, { u64 c = 0; for (i = 0; i < BENCH_N; ++i) c += popcount_u64(bench_dst64[i] &= bench_u64[i]); bench_dst64[7] = c; })
+BENCH_BATCH(bench_bitset_xor, bench_dst64[7] = bitset_xor(bench_dst64, bench_dst64, bench_u64, BENCH_N))
+BENCH_BATCH(bench_bitset_extract, bench_dst64[7] = bitset_extract(bench_dst32, bench_u64, BENCH_N / 64, 0))
+
+static u64 bench_bitset_iter(u64 iters) {
+	u64 acc = 0;
+	while (iters--) {
+		const u64 *p = bench_u64;
+		struct bitset_iter it;
+		size_t i;
+		BENCH_OPAQUE(p);
+		bitset_iter_init(&it, p, BENCH_N);
+		while (bitset_iter_next(&it, &i))
+			acc += i;
+	}
+	return acc;
+}
+
+static u64 bench_bitset_iter_ref(u64 iters) {
+	u64 acc = 0;
+	while (iters--) {
+		const u64 *p = bench_u64;
+		size_t i;
+		BENCH_OPAQUE(p);
+		for (i = 0; i < BENCH_N * 64; ++i)
+			if (bitset_test(p, i))
+				acc += i;
+	}
+	return acc;
+}
+
+/* Positions are scattered over the whole set with a multiplicative hash. */
+static u64 bench_bitset_rank(u64 iters) {
+	u64 acc = 0;
+	while (iters--) {
+		const u32 *p = bench_u32;
+		size_t i;
+		BENCH_OPAQUE(p);
+		for (i = 0; i < BENCH_N; ++i)
+			acc += bitset_rank(&bench_index, (p[i] * 2654435761u) % (BENCH_N * 64));
+	}
+	return acc;
+}
+
+static u64 bench_bitset_select(u64 iters) {
+	u64 acc = 0;
+	size_t n = bitset_index_count(&bench_index);
+	while (iters--) {
+		const u32 *p = bench_u32;
+		size_t i;
+		BENCH_OPAQUE(p);
+		for (i = 0; i < BENCH_N; ++i)
+			acc += bitset_select(&bench_index, (size_t) ((u64) (p[i] * 2654435761u) * n >> 32));
+	}
+	return acc;
+}
+
+/*
+ * Strings, one call per operation
+ */
+
+static size_t ref_strlen(const char *s) {
+	const char *p = s;
+	while (*p)
+		++p;
+	return (size_t) (p - s);
+}
+
+static int ref_memcasecmp(const char *a, const char *b, size_t n) {
+	size_t i;
+	for (i = 0; i < n; ++i) {
+		int x = (u8) a[i], y = (u8) b[i];
+		x += ((u32) (x - 'A') < 26) << 5;
+		y += ((u32) (y - 'A') < 26) << 5;
+		if (x != y)
+			return x - y;
+	}
+	return 0;
+}
+
+#define BENCH_CALL(fn, expr) \
+static u64 fn(u64 iters) { \
+	u64 acc = 0; \
+	while (iters--) { \
+		const char *t = bench_text, *u = bench_upper; \
+		BENCH_OPAQUE(t); \
+		BENCH_OPAQUE(u); \
+		acc += (u64) (expr); \
+	} \
+	return acc; \
+}
+
+/* The texts hold a terminator at 64 bytes and at BENCH_BYTES. */
+BENCH_CALL(bench_strlen_64, _strlen(t + BENCH_BYTES - 64))
+BENCH_CALL(bench_strlen_64_ref, ref_strlen(t + BENCH_BYTES - 64))
+BENCH_CALL(bench_strlen_4k, _strlen(t + BENCH_BYTES - 4096))
+BENCH_CALL(bench_strlen_4k_ref, ref_strlen(t + BENCH_BYTES - 4096))
+BENCH_CALL(bench_strlen_4k_libc, strlen(t + BENCH_BYTES - 4096))
+BENCH_CALL(bench_memchr_4k, (size_t) _memchr(t, '#', 4096))
+BENCH_CALL(bench_memchr_4k_libc, (size_t) memchr(t, '#', 4096))
+BENCH_CALL(bench_memcasecmp_16, _memcasecmp(t, u, 16))
+BENCH_CALL(bench_memcasecmp_16_ref, ref_memcasecmp(t, u, 16))
+BENCH_CALL(bench_memcasecmp_4k, _memcasecmp(t, u, 4096))
+BENCH_CALL(bench_memcasecmp_4k_ref, ref_memcasecmp(t, u, 4096))
+BENCH_CALL(bench_strcasecmp_64, _strcasecmp(t + BENCH_BYTES - 64, u + BENCH_BYTES - 64))
+BENCH_CALL(bench_memcasemem_4k, (size_t) _memcasemem(t, 4096, "NEEDLE#", 7))
+BENCH_CALL(bench_strview_find_4k, strview_find(strview_make(t, 4096), STRVIEW_LIT("needle#")))
+BENCH_CALL(bench_strview_findchr_4k, strview_findchr(strview_make(t, 4096), '#'))
+BENCH_CALL(bench_strview_rfindchr_4k, strview_rfindchr(strview_make(t, 4096), '#'))
+BENCH_CALL(bench_strview_hash_16, strview_hash(strview_make(t, 16)))
+BENCH_CALL(bench_strview_casehash_16, strview_casehash(strview_make(u, 16)))
+
+static u64 bench_strintern_find(u64 iters) {
+	u64 acc = 0;
+	while (iters--) {
+		const struct strview *w = bench_words;
+		size_t i;
+		BENCH_OPAQUE(w);
+		for (i = 0; i < 256; ++i)
+			acc += strintern_find(&bench_intern, w[i * 13 % BENCH_N]);
+	}
+	return acc;
+}
+
+static u64 bench_strbuf_append_u64(u64 iters) {
+	struct strbuf b;
+	char buf[256 * 24];
+	u64 acc = 0;
+	strbuf_init_fixed(&b, buf, sizeof buf);
+	while (iters--) {
+		const u64 *p = bench_u64;
+		size_t i;
+		BENCH_OPAQUE(p);
+		strbuf_reset(&b);
+		for (i = 0; i < 256; ++i)
+			strbuf_append_u64(&b, p[i]);
+		acc += strbuf_len(&b);
+	}
+	return acc;
+}
+
+/*
+ * Bulk byte routines in the other modules, for context
+ */
+
+BENCH_CALL(bench_crc32_64k, checksum_crc32(0, t, BENCH_BYTES))
+BENCH_CALL(bench_crc32c_64k, checksum_crc32c(0, t, BENCH_BYTES))
+BENCH_CALL(bench_adler32_64k, checksum_adler32(1, t, BENCH_BYTES))
+BENCH_CALL(bench_hash64_16, hash64(t, 16, 0))
+BENCH_CALL(bench_hash64_64k, hash64(t, BENCH_BYTES, 0))
+BENCH_CALL(bench_utf8_validate_ascii, utf8_validate(t, BENCH_BYTES))
+BENCH_CALL(bench_utf8_validate_mixed, utf8_validate(bench_utf8, BENCH_BYTES))
+
+static u64 bench_format_u64(u64 iters) {
+	char buf[FORMAT_MAX_U64];
+	u64 acc = 0;
+	while (iters--) {
+		const u64 *p = bench_u64;
+		size_t i;
+		BENCH_OPAQUE(p);
+		for (i = 0; i < 256; ++i)
+			acc += format_u64(buf, p[i]) + (u8) buf[0];
+	}
+	return acc;
+}
+
+static u64 bench_parse_u64(u64 iters) {
+	u64 acc = 0, v;
+	while (iters--) {
+		size_t i;
+		for (i = 0; i < 256; ++i) {
+			parse_u64(&v, NULL, bench_numbers[i], bench_number_len[i]);
+			acc += v;
+		}
+		BENCH_OPAQUE(acc);
+	}
+	return acc;
+}
+
+static u64 bench_parse_u64_ref(u64 iters) {
+	u64 acc = 0;
+	while (iters--) {
+		size_t i;
+		for (i = 0; i < 256; ++i)
+			acc += strtoull(bench_numbers[i], NULL, 10);
+		BENCH_OPAQUE(acc);
+	}
+	return acc;
+}
+
+BENCH_BATCH(bench_varint_encode_u32_array, bench_bytes_size = varint_encode_u32_array(bench_bytes, bench_u32, BENCH_N))
+BENCH_BATCH(bench_varint_decode_u32_array, varint_decode_u32_array(bench_dst32, BENCH_N, bench_bytes, bench_bytes_size))
+
+/*
+ * Bit streams: BENCH_N fields of 1 to 16 bits, 4352 bytes in all
+ */
+
+#define BENCH_BITS_BYTES (BENCH_N / 16 * 136 / 8)
+
+static u8 bench_bitbuf[BENCH_BITS_BYTES + 8];
+
+#define BENCH_BITS(order) \
+static u64 bench_bits_write_##order(u64 iters) { \
+	u64 acc = 0; \
+	while (iters--) { \
+		const u32 *p = bench_u32; \
+		struct bitwriter w; \
+		size_t i; \
+		BENCH_OPAQUE(p); \
+		bitwriter_init(&w, bench_bitbuf, sizeof bench_bitbuf); \
+		for (i = 0; i < BENCH_N; ++i) \
+			bits_write_##order(&w, p[i] & ((2u << (i & 15)) - 1), 1 + (u32) (i & 15)); \
+		acc += bitwriter_finish_##order(&w); \
+	} \
+	return acc; \
+} \
+static u64 bench_bits_read_##order(u64 iters) { \
+	u64 acc = 0; \
+	while (iters--) { \
+		const u8 *p = bench_bitbuf; \
+		struct bitreader r; \
+		size_t i; \
+		BENCH_OPAQUE(p); \
+		bitreader_init(&r, p, BENCH_BITS_BYTES); \
+		for (i = 0; i < BENCH_N; ++i) \
+			acc += bits_read_##order(&r, 1 + (u32) (i & 15)); \
+	} \
+	return acc; \
+}
+
+BENCH_BITS(lsb)
+BENCH_BITS(msb)
+
+/*
+ * Random numbers, BENCH_N per iteration
+ */
+
+static struct xoshiro256 bench_xoshiro256;
+static struct pcg32 bench_pcg32;
+static struct wyrand bench_wyrand;
+static struct xoshiro128x8 bench_xoshiro128x8;
+
+BENCH_BATCH(bench_xoshiro256_next, for (i = 0; i < BENCH_N; ++i) bench_dst64[i] = xoshiro256_next(&bench_xoshiro256))
+BENCH_BATCH(bench_pcg32_next, for (i = 0; i < BENCH_N; ++i) bench_dst32[i] = pcg32_next(&bench_pcg32))
+BENCH_BATCH(bench_wyrand_next, for (i = 0; i < BENCH_N; ++i) bench_dst64[i] = wyrand_next(&bench_wyrand))
+BENCH_BATCH(bench_xoshiro256_below, { u64 d = bench_div64;
+	for (i = 0; i < BENCH_N; ++i) bench_dst64[i] = xoshiro256_below(&bench_xoshiro256, d); })
+BENCH_BATCH(bench_xoshiro256_below_ref, { u64 d = bench_div64;
+	for (i = 0; i < BENCH_N; ++i) bench_dst64[i] = xoshiro256_next(&bench_xoshiro256) % d; })
+BENCH_BATCH(bench_xoshiro128x8_fill_u32, xoshiro128x8_fill_u32(&bench_xoshiro128x8, bench_dst32, BENCH_N))
+BENCH_BATCH(bench_xoshiro128x8_fill_u32_ref, for (i = 0; i < BENCH_N; ++i) bench_dst32[i] = (u32) rand())
+BENCH_BATCH(bench_xoshiro128x8_fill_below, xoshiro128x8_fill_below(&bench_xoshiro128x8, bench_dst32, BENCH_N, 1000))
+BENCH_BATCH(bench_xoshiro128x8_fill_f32, xoshiro128x8_fill_f32(&bench_xoshiro128x8, bench_dstf, BENCH_N))
+BENCH_BATCH(bench_xoshiro128x8_fill_f32_loop, for (i = 0; i < BENCH_N; ++i) bench_dstf[i] = pcg32_f32(&bench_pcg32))
+
+/*
+ * Sorting: BENCH_N keys in cache, and a million depths with their indices
+ * to show the threads. Each iteration copies the input first.
+ */
+
+#define BENCH_SORT_N (1 << 20)
+
+static u32 bench_sort_tmp32[BENCH_N];
+static f32 bench_sort_depth[BENCH_SORT_N];
+static f32 bench_sort_keys[BENCH_SORT_N];
+static f32 bench_sort_tmpkeys[BENCH_SORT_N];
+static u32 bench_sort_ids[BENCH_SORT_N];
+static u32 bench_sort_tmpids[BENCH_SORT_N];
+
+struct bench_sort_item {
+	f32 key;
+	u32 id;
+};
+
+static struct bench_sort_item bench_sort_items[BENCH_SORT_N];
+
+static int bench_cmp_u32(const void *a, const void *b) {
+	u32 x = *(const u32 *) a, y = *(const u32 *) b;
+	return (x > y) - (x < y);
+}
+
+static int bench_cmp_item(const void *a, const void *b) {
+	const struct bench_sort_item *x = (const struct bench_sort_item *) a, *y = (const struct bench_sort_item *) b;
+	return (x->key > y->key) - (x->key < y->key);
+}
+
+static void bench_sort_depths(u32 threads) {
+	size_t i;
+	memcpy(bench_sort_keys, bench_sort_depth, sizeof bench_sort_keys);
+	for (i = 0; i < BENCH_SORT_N; ++i)
+		bench_sort_ids[i] = (u32) i;
+	radix_sort_f32_pairs(bench_sort_keys, bench_sort_ids, bench_sort_tmpkeys, bench_sort_tmpids, BENCH_SORT_N, threads);
+}
+
+static void bench_sort_depths_ref(void) {
+	size_t i;
+	for (i = 0; i < BENCH_SORT_N; ++i) {
+		bench_sort_items[i].key = bench_sort_depth[i];
+		bench_sort_items[i].id = (u32) i;
+	}
+	qsort(bench_sort_items, BENCH_SORT_N, sizeof *bench_sort_items, bench_cmp_item);
+}
+
+BENCH_BATCH(bench_radix_sort_u32, { memcpy(bench_dst32, bench_u32, sizeof bench_dst32); radix_sort_u32(bench_dst32, bench_sort_tmp32, BENCH_N, 1); })
+BENCH_BATCH(bench_radix_sort_u32_ref, { memcpy(bench_dst32, bench_u32, sizeof bench_dst32); qsort(bench_dst32, BENCH_N, 4, bench_cmp_u32); })
+BENCH_BATCH(bench_radix_sort_f32, { memcpy(bench_dstf, bench_f32, sizeof bench_dstf); radix_sort_f32(bench_dstf, (f32 *) bench_sort_tmp32, BENCH_N, 1); })
+BENCH_BATCH(bench_radix_sort_u64, { memcpy(bench_dst64, bench_u64, sizeof bench_dst64); radix_sort_u64(bench_dst64, NULL, BENCH_N, 1); })
+BENCH_BATCH(bench_radix_sort_f32_pairs_1m, bench_sort_depths(1))
+BENCH_BATCH(bench_radix_sort_f32_pairs_1m_t4, bench_sort_depths(4))
+BENCH_BATCH(bench_radix_sort_f32_pairs_1m_ref, bench_sort_depths_ref())
+
+/*
+ * Hex and Base64 over the text, decoding what the encoders wrote
+ */
+
+static char bench_hex[BENCH_BYTES * 2];
+static char bench_base64[BENCH_BYTES / 3 * 4 + 4];
+static u8 bench_decoded[BENCH_BYTES];
+
+static size_t ref_hex_encode(char *dst, const char *src, size_t size) {
+	char buf[3];
+	size_t i;
+	for (i = 0; i < size; ++i) {
+		snprintf(buf, sizeof buf, "%02x", (u8) src[i]);
+		dst[i * 2] = buf[0];
+		dst[i * 2 + 1] = buf[1];
+	}
+	return size * 2;
+}
+
+BENCH_CALL(bench_hex_encode, hex_encode(bench_hex, t, BENCH_BYTES, false))
+BENCH_CALL(bench_hex_encode_ref, ref_hex_encode(bench_hex, t, BENCH_BYTES))
+BENCH_CALL(bench_hex_decode, hex_decode(bench_decoded, bench_hex, BENCH_BYTES * 2))
+BENCH_CALL(bench_base64_encode, base64_encode(bench_base64, t, BENCH_BYTES, 0))
+BENCH_CALL(bench_base64_decode, base64_decode(bench_decoded, bench_base64, base64_encoded_size(BENCH_BYTES, 0), 0))
+
+struct bench {
+	const char *name;
+	u64 (*fn)(u64 iters);
+	u32 ops;
+	u32 bytes;
+};
+
+static const struct bench benches[] = {
+	{ "arith/sel_s32", bench_sel_s32, BENCH_N, 0 },
+	{ "arith/sel_s32.ref", bench_sel_s32_ref, BENCH_N, 0 },
+	{ "arith/min_u32", bench_min_u32, BENCH_N, 0 },
+	{ "arith/min_u32.ref", bench_min_u32_ref, BENCH_N, 0 },
+	{ "arith/clamp_s32", bench_clamp_s32, BENCH_N, 0 },
+	{ "arith/clamp_s32.ref", bench_clamp_s32_ref, BENCH_N, 0 },
+	{ "arith/abs_s32", bench_abs_s32, BENCH_N, 0 },
+	{ "arith/abs_s32.ref", bench_abs_s32_ref, BENCH_N, 0 },
+	{ "arith/clz_u32", bench_clz_u32, BENCH_N, 0 },
+	{ "arith/clz_u32.ref", bench_clz_u32_ref, BENCH_N, 0 },
+	{ "arith/ctz_u32", bench_ctz_u32, BENCH_N, 0 },
+	{ "arith/clz_u64", bench_clz_u64, BENCH_N, 0 },
+	{ "arith/clz_u64.ref", bench_clz_u64_ref, BENCH_N, 0 },
+	{ "arith/ctz_u64", bench_ctz_u64, BENCH_N, 0 },
+	{ "arith/popcount_u64", bench_popcount_u64, BENCH_N, 0 },
+	{ "arith/popcount_u64.ref", bench_popcount_u64_ref, BENCH_N, 0 },
+	{ "arith/bitswap_u32", bench_bitswap_u32, BENCH_N, 0 },
+	{ "arith/trunc_f32", bench_trunc_f32, BENCH_N, 0 },
+	{ "arith/trunc_f32.ref", bench_trunc_f32_ref, BENCH_N, 0 },
+	{ "arith/round_f32", bench_round_f32, BENCH_N, 0 },
+	{ "arith/round_f32.ref", bench_round_f32_ref, BENCH_N, 0 },
+	{ "arith/floor_f32", bench_floor_f32, BENCH_N, 0 },
+	{ "arith/floor_f32.ref", bench_floor_f32_ref, BENCH_N, 0 },
+	{ "arith/mul_q32", bench_mul_q32, BENCH_N, 0 },
+	{ "arith/mulsat_q32", bench_mulsat_q32, BENCH_N, 0 },
+	{ "arith/mulwide_u64", bench_mulwide_u64, BENCH_N, 0 },
+	{ "arith/reduce_u32", bench_reduce_u32, BENCH_N, 0 },
+	{ "arith/fastdiv_u32", bench_fastdiv_u32, BENCH_N, 0 },
+	{ "arith/fastdiv_u32.ref", bench_div_u32_ref, BENCH_N, 0 },
+	{ "arith/fastmod_u32", bench_fastmod_u32, BENCH_N, 0 },
+	{ "arith/fastmod_u32.ref", bench_mod_u32_ref, BENCH_N, 0 },
+	{ "arith/fastdiv_u64", bench_fastdiv_u64, BENCH_N, 0 },
+	{ "arith/fastdivbf_u64", bench_fastdivbf_u64, BENCH_N, 0 },
+	{ "arith/fastdiv_u64.ref", bench_div_u64_ref, BENCH_N, 0 },
+	{ "arith/round_f32_array", bench_round_f32_array, BENCH_N, BENCH_N * 4 },
+	{ "arith/round_f32_array.loop", bench_round_f32_loop, BENCH_N, BENCH_N * 4 },
+	{ "arith/floor_f32_array", bench_floor_f32_array, BENCH_N, BENCH_N * 4 },
+	{ "arith/floor_f32_array.loop", bench_floor_f32_loop, BENCH_N, BENCH_N * 4 },
+	{ "arith/f32_to_q32_array", bench_f32_to_q32_array, BENCH_N, BENCH_N * 4 },
+	{ "arith/f32_to_q32_array.loop", bench_f32_to_q32_loop, BENCH_N, BENCH_N * 4 },
+	{ "arith/q32_to_f32_array", bench_q32_to_f32_array, BENCH_N, BENCH_N * 4 },
+	{ "arith/q32_to_f32_array.loop", bench_q32_to_f32_loop, BENCH_N, BENCH_N * 4 },
+	{ "arith/mul_q32_array", bench_mul_q32_array, BENCH_N - 1, (BENCH_N - 1) * 4 },
+	{ "arith/mul_q32_array.loop", bench_mul_q32_loop, BENCH_N - 1, (BENCH_N - 1) * 4 },
+	{ "arith/mulsat_q16_array", bench_mulsat_q16_array, BENCH_N - 1, (BENCH_N - 1) * 2 },
+	{ "arith/mulsat_q16_array.loop", bench_mulsat_q16_loop, BENCH_N - 1, (BENCH_N - 1) * 2 },
+	{ "arith/addsat_q32_array", bench_addsat_q32_array, BENCH_N - 1, (BENCH_N - 1) * 4 },
+	{ "arith/addsat_q32_array.loop", bench_addsat_q32_loop, BENCH_N - 1, (BENCH_N - 1) * 4 },
+	{ "arith/fastdiv_u32_array", bench_fastdiv_u32_array, BENCH_N, BENCH_N * 4 },
+	{ "arith/fastdiv_u32_array.loop", bench_fastdiv_u32_loop, BENCH_N, BENCH_N * 4 },
+	{ "bitset/nthbit_u64", bench_nthbit_u64, BENCH_N, 0 },
+	{ "bitset/count", bench_bitset_count, BENCH_N, BENCH_N * 8 },
+	{ "bitset/count.loop", bench_bitset_count_loop, BENCH_N, BENCH_N * 8 },
+	{ "bitset/and", bench_bitset_and, BENCH_N, BENCH_N * 8 },
+	{ "bitset/and.loop", bench_bitset_and_loop, BENCH_N, BENCH_N * 8 },
+	{ "bitset/xor", bench_bitset_xor, BENCH_N, BENCH_N * 8 },
+	{ "bitset/extract", bench_bitset_extract, BENCH_N / 64, BENCH_N / 8 },
+	{ "bitset/iter", bench_bitset_iter, BENCH_N * 64, BENCH_N * 8 },
+	{ "bitset/iter.ref", bench_bitset_iter_ref, BENCH_N * 64, BENCH_N * 8 },
+	{ "bitset/rank", bench_bitset_rank, BENCH_N, 0 },
+	{ "bitset/select", bench_bitset_select, BENCH_N, 0 },
+	{ "endian/byteswap32", bench_byteswap32, BENCH_N, 0 },
+	{ "endian/byteswap32.ref", bench_byteswap32_ref, BENCH_N, 0 },
+	{ "endian/byteswap64", bench_byteswap64, BENCH_N, 0 },
+	{ "endian/byteswap16_array", bench_byteswap16_array, BENCH_N, BENCH_N * 2 },
+	{ "endian/byteswap32_array", bench_byteswap32_array, BENCH_N, BENCH_N * 4 },
+	{ "endian/byteswap32_array.loop", bench_byteswap32_loop, BENCH_N, BENCH_N * 4 },
+	{ "endian/byteswap64_array", bench_byteswap64_array, BENCH_N, BENCH_N * 8 },
+	{ "endian/byteswap64_array.loop", bench_byteswap64_loop, BENCH_N, BENCH_N * 8 },
+	{ "endian/load_be32.loop", bench_load_be32_loop, BENCH_N, BENCH_N * 4 },
+	{ "strings/strlen_64", bench_strlen_64, 1, 64 },
+	{ "strings/strlen_64.ref", bench_strlen_64_ref, 1, 64 },
+	{ "strings/strlen_4k", bench_strlen_4k, 1, 4096 },
+	{ "strings/strlen_4k.ref", bench_strlen_4k_ref, 1, 4096 },
+	{ "strings/strlen_4k.libc", bench_strlen_4k_libc, 1, 4096 },
+	{ "strings/memchr_4k", bench_memchr_4k, 1, 4096 },
+	{ "strings/memchr_4k.libc", bench_memchr_4k_libc, 1, 4096 },
+	{ "strings/memcasecmp_16", bench_memcasecmp_16, 1, 16 },
+	{ "strings/memcasecmp_16.ref", bench_memcasecmp_16_ref, 1, 16 },
+	{ "strings/memcasecmp_4k", bench_memcasecmp_4k, 1, 4096 },
+	{ "strings/memcasecmp_4k.ref", bench_memcasecmp_4k_ref, 1, 4096 },
+	{ "strings/strcasecmp_64", bench_strcasecmp_64, 1, 64 },
+	{ "strings/memcasemem_4k", bench_memcasemem_4k, 1, 4096 },
+	{ "strings/strview_find_4k", bench_strview_find_4k, 1, 4096 },
+	{ "strings/strview_findchr_4k", bench_strview_findchr_4k, 1, 4096 },
+	{ "strings/strview_rfindchr_4k", bench_strview_rfindchr_4k, 1, 4096 },
+	{ "strings/strview_hash_16", bench_strview_hash_16, 1, 16 },
+	{ "strings/strview_casehash_16", bench_strview_casehash_16, 1, 16 },
+	{ "strings/strintern_find", bench_strintern_find, 256, 0 },
+	{ "strings/strbuf_append_u64", bench_strbuf_append_u64, 256, 0 },
+	{ "checksum/crc32_64k", bench_crc32_64k, 1, BENCH_BYTES },
+	{ "checksum/crc32c_64k", bench_crc32c_64k, 1, BENCH_BYTES },
+	{ "checksum/adler32_64k", bench_adler32_64k, 1, BENCH_BYTES },
+	{ "hash/hash64_16", bench_hash64_16, 1, 16 },
+	{ "hash/hash64_64k", bench_hash64_64k, 1, BENCH_BYTES },
+	{ "utf/utf8_validate_ascii", bench_utf8_validate_ascii, 1, BENCH_BYTES },
+	{ "utf/utf8_validate_mixed", bench_utf8_validate_mixed, 1, BENCH_BYTES },
+	{ "format/format_u64", bench_format_u64, 256, 0 },
+	{ "parse/parse_u64", bench_parse_u64, 256, 0 },
+	{ "parse/parse_u64.ref", bench_parse_u64_ref, 256, 0 },
+	{ "varint/encode_u32_array", bench_varint_encode_u32_array, BENCH_N, BENCH_N * 4 },
+	{ "varint/decode_u32_array", bench_varint_decode_u32_array, BENCH_N, BENCH_N * 4 },
+	{ "bitstream/write_lsb", bench_bits_write_lsb, BENCH_N, BENCH_BITS_BYTES },
+	{ "bitstream/write_msb", bench_bits_write_msb, BENCH_N, BENCH_BITS_BYTES },
+	{ "bitstream/read_lsb", bench_bits_read_lsb, BENCH_N, BENCH_BITS_BYTES },
+	{ "bitstream/read_msb", bench_bits_read_msb, BENCH_N, BENCH_BITS_BYTES },
+	{ "random/xoshiro256_next", bench_xoshiro256_next, BENCH_N, BENCH_N * 8 },
+	{ "random/pcg32_next", bench_pcg32_next, BENCH_N, BENCH_N * 4 },
+	{ "random/wyrand_next", bench_wyrand_next, BENCH_N, BENCH_N * 8 },
+	{ "random/xoshiro256_below", bench_xoshiro256_below, BENCH_N, 0 },
+	{ "random/xoshiro256_below.ref", bench_xoshiro256_below_ref, BENCH_N, 0 },
+	{ "random/xoshiro128x8_fill_u32", bench_xoshiro128x8_fill_u32, BENCH_N, BENCH_N * 4 },
+	{ "random/xoshiro128x8_fill_u32.ref", bench_xoshiro128x8_fill_u32_ref, BENCH_N, BENCH_N * 4 },
+	{ "random/xoshiro128x8_fill_below", bench_xoshiro128x8_fill_below, BENCH_N, BENCH_N * 4 },
+	{ "random/xoshiro128x8_fill_f32", bench_xoshiro128x8_fill_f32, BENCH_N, BENCH_N * 4 },
+	{ "random/xoshiro128x8_fill_f32.loop", bench_xoshiro128x8_fill_f32_loop, BENCH_N, BENCH_N * 4 },
+	{ "sort/radix_sort_u32", bench_radix_sort_u32, BENCH_N, BENCH_N * 4 },
+	{ "sort/radix_sort_u32.ref", bench_radix_sort_u32_ref, BENCH_N, BENCH_N * 4 },
+	{ "sort/radix_sort_f32", bench_radix_sort_f32, BENCH_N, BENCH_N * 4 },
+	{ "sort/radix_sort_u64", bench_radix_sort_u64, BENCH_N, BENCH_N * 8 },
+	{ "sort/radix_sort_f32_pairs_1m", bench_radix_sort_f32_pairs_1m, BENCH_SORT_N, BENCH_SORT_N * 8 },
+	{ "sort/radix_sort_f32_pairs_1m.t4", bench_radix_sort_f32_pairs_1m_t4, BENCH_SORT_N, BENCH_SORT_N * 8 },
+	{ "sort/radix_sort_f32_pairs_1m.ref", bench_radix_sort_f32_pairs_1m_ref, BENCH_SORT_N, BENCH_SORT_N * 8 },
+	{ "bytes/hex_encode", bench_hex_encode, 1, BENCH_BYTES },
+	{ "bytes/hex_encode.ref", bench_hex_encode_ref, 1, BENCH_BYTES },
+	{ "bytes/hex_decode", bench_hex_decode, 1, BENCH_BYTES },
+	{ "bytes/base64_encode", bench_base64_encode, 1, BENCH_BYTES },
+	{ "bytes/base64_decode", bench_base64_decode, 1, BENCH_BYTES },
+};
+
+/*
+ * Timing and counters
+ */
+
+static u64 bench_now_ns(void) {
+#if defined(_WIN32)
+	LARGE_INTEGER t, f;
+	QueryPerformanceCounter(&t);
+	QueryPerformanceFrequency(&f);
+	return (u64) ((double) t.QuadPart * 1e9 / (double) f.QuadPart);
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64) ts.tv_sec * 1000000000u + (u64) ts.tv_nsec;
+#endif
+}
+
+/* Cycles and instructions in user space for this thread. Either counter may
+   be missing: no Linux, perf_event_paranoid, or a virtual machine without a
+   PMU. */
+enum { BENCH_CYCLES, BENCH_INSTRUCTIONS, BENCH_COUNTERS };
+
+static int bench_fds[BENCH_COUNTERS] = { -1, -1 };
+
+static void bench_perf_open(void) {
+#if defined(BENCH_PERF)
+	static const u64 configs[BENCH_COUNTERS] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS };
+	int k;
+	for (k = 0; k < BENCH_COUNTERS; ++k) {
+		struct perf_event_attr a;
+		memset(&a, 0, sizeof a);
+		a.type = PERF_TYPE_HARDWARE;
+		a.size = sizeof a;
+		a.config = configs[k];
+		a.disabled = 1;
+		a.exclude_kernel = 1;
+		a.exclude_hv = 1;
+		bench_fds[k] = (int) syscall(SYS_perf_event_open, &a, 0, -1, -1, 0);
+	}
+#endif
+}
+
+static void bench_perf_start(void) {
+#if defined(BENCH_PERF)
+	int k;
+	for (k = 0; k < BENCH_COUNTERS; ++k) {
+		if (bench_fds[k] >= 0) {
+			ioctl(bench_fds[k], PERF_EVENT_IOC_RESET, 0);
+			ioctl(bench_fds[k], PERF_EVENT_IOC_ENABLE, 0);
+		}
+	}
+#endif
+}
+
+static void bench_perf_stop(s64 counts[BENCH_COUNTERS]) {
+	int k;
+	for (k = 0; k < BENCH_COUNTERS; ++k) {
+		counts[k] = -1;
+#if defined(BENCH_PERF)
+		if (bench_fds[k] >= 0) {
+			u64 v;
+			ioctl(bench_fds[k], PERF_EVENT_IOC_DISABLE, 0);
+			if (read(bench_fds[k], &v, sizeof v) == (ssize_t) sizeof v)
+				counts[k] = (s64) v;
+		}
+#endif
+	}
+}
+
+struct bench_result {
+	f64 ns;
+	f64 cycles;
+	f64 instructions;
+	u64 iters;
+};
+
+/* Doubles the iteration count until a run takes a tenth of the target,
+   scales it to the target, and keeps the fastest of reps runs. */
+static struct bench_result bench_run(const struct bench *b, f64 target_ns, int reps) {
+	struct bench_result r;
+	u64 iters = 1, t;
+	int k;
+
+	for (;;) {
+		t = bench_now_ns();
+		bench_sink += b->fn(iters);
+		t = bench_now_ns() - t;
+		if ((f64) t >= target_ns / 10 || iters >= (imm_u64(1) << 40))
+			break;
+		iters *= 2;
+	}
+	iters = (u64) ((f64) iters * target_ns / ((f64) t + 1));
+	iters += iters == 0;
+
+	r.ns = r.cycles = r.instructions = -1;
+	r.iters = iters;
+	for (k = 0; k < reps; ++k) {
+		s64 counts[BENCH_COUNTERS];
+		f64 ops = (f64) iters * b->ops;
+		bench_perf_start();
+		t = bench_now_ns();
+		bench_sink += b->fn(iters);
+		t = bench_now_ns() - t;
+		bench_perf_stop(counts);
+		if (r.ns < 0 || (f64) t / ops < r.ns) {
+			r.ns = (f64) t / ops;
+			r.cycles = counts[BENCH_CYCLES] >= 0 ? (f64) counts[BENCH_CYCLES] / ops : -1;
+			r.instructions = counts[BENCH_INSTRUCTIONS] >= 0 ? (f64) counts[BENCH_INSTRUCTIONS] / ops : -1;
+		}
+	}
+	return r;
+}
+
+/*
+ * Setup and output
+ */
+
+static u64 bench_seed = imm_u64(0x2545f4914f6cdd1d);
+
+static u64 bench_rand(void) {
+	u64 z = (bench_seed += imm_u64(0x9e3779b97f4a7c15));
+	z = (z ^ (z >> 30)) * imm_u64(0xbf58476d1ce4e5b9);
+	z = (z ^ (z >> 27)) * imm_u64(0x94d049bb133111eb);
+	return z ^ (z >> 31);
+}
+
+static void bench_init(void) {
+	static char words[BENCH_N * 16];
+	size_t i, n = 0;
+
+	for (i = 0; i < BENCH_N; ++i) {
+		u64 r = bench_rand();
+		bench_u32[i] = (u32) r >> (r >> 59);
+		bench_u64[i] = bench_rand() >> (r >> 58);
+		bench_f32[i] = (f32) (s32) (r >> 40) / 1024.f - 8192.f;
+		bench_q16[i] = (q16) r;
+		bench_q32[i] = (q32) (r >> 16);
+		bench_number_len[i] = (u32) format_u64(bench_numbers[i], bench_u64[i]);
+		bench_numbers[i][bench_number_len[i]] = 0;
+	}
+
+	/* Printable ASCII without '#', so searches run to the end. */
+	for (i = 0; i < BENCH_BYTES; ++i) {
+		bench_text[i] = (char) ('$' + bench_rand() % 90);
+		bench_upper[i] = (char) (bench_text[i] >= 'a' && bench_text[i] <= 'z' ? bench_text[i] - 32 : bench_text[i]);
+	}
+	bench_text[BENCH_BYTES] = bench_upper[BENCH_BYTES] = 0;
+
+	/* Two-, three- and four-byte sequences among the ASCII. */
+	while (n + 4 <= BENCH_BYTES) {
+		u32 r = (u32) bench_rand() % 8;
+		if (r < 5) {
+			bench_utf8[n++] = (char) ('a' + r);
+		} else if (r == 5) {
+			bench_utf8[n++] = (char) 0xc3;
+			bench_utf8[n++] = (char) 0xa9;
+		} else if (r == 6) {
+			bench_utf8[n++] = (char) 0xe2;
+			bench_utf8[n++] = (char) 0x82;
+			bench_utf8[n++] = (char) 0xac;
+		} else {
+			bench_utf8[n++] = (char) 0xf0;
+			bench_utf8[n++] = (char) 0x9f;
+			bench_utf8[n++] = (char) 0x98;
+			bench_utf8[n++] = (char) 0x80;
+		}
+	}
+	for (; n < BENCH_BYTES; ++n)
+		bench_utf8[n] = ' ';
+
+	strintern_init(&bench_intern, BENCH_N, sizeof words, false);
+	for (i = 0, n = 0; i < BENCH_N; ++i) {
+		size_t len = 4 + (size_t) (bench_rand() % 12);
+		memcpy(words + n, bench_text + n, len);
+		bench_words[i] = strview_make(words + n, len);
+		if (i % 2 == 0)
+			strintern_add(&bench_intern, bench_words[i]);
+		n += len;
+	}
+
+	bench_bytes_size = varint_encode_u32_array(bench_bytes, bench_u32, BENCH_N);
+	for (i = 0; i < sizeof bench_bitbuf; ++i)
+		bench_bitbuf[i] = (u8) bench_rand();
+	bitset_index_init(&bench_index, bench_u64, BENCH_N);
+	xoshiro256_seed(&bench_xoshiro256, bench_rand());
+	pcg32_seed(&bench_pcg32, bench_rand(), bench_rand());
+	wyrand_seed(&bench_wyrand, bench_rand());
+	xoshiro128x8_seed(&bench_xoshiro128x8, bench_rand());
+	for (i = 0; i < BENCH_SORT_N; ++i)
+		bench_sort_depth[i] = (f32) (bench_rand() >> 40) * (1.f / 16777216.f) * 1000.f;
+	hex_encode(bench_hex, bench_text, BENCH_BYTES, false);
+	base64_encode(bench_base64, bench_text, BENCH_BYTES, 0);
+}
+
+enum { BENCH_TEXT, BENCH_JSON, BENCH_CSV };
+
+static void bench_print_value(int format, f64 v, int prec) {
+	if (v < 0)
+		fputs(format == BENCH_JSON ? "null" : format == BENCH_CSV ? "" : "       -", stdout);
+	else if (format == BENCH_TEXT)
+		printf("%8.*f", prec, v);
+	else
+		printf("%.*f", prec, v);
+}
+
+static void bench_print(int format, const struct bench *b, const struct bench_result *r) {
+	f64 bps = b->bytes != 0 ? (f64) b->bytes / b->ops / r->ns * 1e9 : -1;
+	f64 ipc = r->cycles > 0 && r->instructions >= 0 ? r->instructions / r->cycles : -1;
+
+	switch (format) {
+	case BENCH_JSON:
+		printf("{\"name\":\"%s\",\"cpu\":\"%08x\",\"iters\":%llu,\"ops\":%u,\"ns_per_op\":",
+			b->name, cpu_features(), (unsigned long long) r->iters, b->ops);
+		bench_print_value(format, r->ns, 4);
+		fputs(",\"bytes_per_s\":", stdout);
+		bench_print_value(format, bps, 0);
+		fputs(",\"cycles_per_op\":", stdout);
+		bench_print_value(format, r->cycles, 4);
+		fputs(",\"instructions_per_op\":", stdout);
+		bench_print_value(format, r->instructions, 4);
+		fputs(",\"ipc\":", stdout);
+		bench_print_value(format, ipc, 3);
+		fputs("}\n", stdout);
+		break;
+	case BENCH_CSV:
+		printf("%s,%08x,%llu,%u,", b->name, cpu_features(), (unsigned long long) r->iters, b->ops);
+		bench_print_value(format, r->ns, 4);
+		putchar(',');
+		bench_print_value(format, bps, 0);
+		putchar(',');
+		bench_print_value(format, r->cycles, 4);
+		putchar(',');
+		bench_print_value(format, r->instructions, 4);
+		putchar(',');
+		bench_print_value(format, ipc, 3);
+		putchar('\n');
+		break;
+	default:
+		printf("%-34s", b->name);
+		bench_print_value(format, r->ns, 3);
+		fputs(" ns ", stdout);
+		bench_print_value(format, bps >= 0 ? bps / 1e9 : -1, 2);
+		fputs(" GB/s ", stdout);
+		bench_print_value(format, r->cycles, 2);
+		fputs(" cyc ", stdout);
+		bench_print_value(format, r->instructions, 2);
+		fputs(" ins ", stdout);
+		bench_print_value(format, ipc, 2);
+		fputs(" ipc\n", stdout);
+		break;
+	}
+	fflush(stdout);
+}
+
+static bool bench_selected(const char *name, int argc, char *argv[], int first) {
+	int k;
+	bool any = false;
+	for (k = first; k < argc; ++k) {
+		if (argv[k][0] == '-' || strcmp(argv[k - 1], "--time") == 0)
+			continue;
+		any = true;
+		if (strstr(name, argv[k]) != NULL)
+			return true;
+	}
+	return !any;
+}
+
+int main(int argc, char *argv[]) {
+	int format = BENCH_TEXT, reps = 5, k;
+	f64 target_ns = 100e6;
+	bool list = false;
+	size_t i;
+
+	for (k = 1; k < argc; ++k) {
+		if (strcmp(argv[k], "--json") == 0)
+			format = BENCH_JSON;
+		else if (strcmp(argv[k], "--csv") == 0)
+			format = BENCH_CSV;
+		else if (strcmp(argv[k], "--quick") == 0)
+			target_ns = 1e6, reps = 1;
+		else if (strcmp(argv[k], "--time") == 0 && k + 1 < argc)
+			target_ns = atof(argv[++k]) * 1e6;
+		else if (strcmp(argv[k], "--list") == 0)
+			list = true;
+		else if (argv[k][0] == '-') {
+			fprintf(stderr, "usage: %s [--json | --csv] [--quick] [--time ms] [--list] [filter...]\n", argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (list) {
+		for (i = 0; i < countof(benches); ++i)
+			puts(benches[i].name);
+		return EXIT_SUCCESS;
+	}
+
+	bench_init();
+	bench_perf_open();
+
+	if (format == BENCH_CSV)
+		puts("name,cpu,iters,ops,ns_per_op,bytes_per_s,cycles_per_op,instructions_per_op,ipc");
+	else if (format == BENCH_TEXT && (bench_fds[BENCH_CYCLES] < 0 || bench_fds[BENCH_INSTRUCTIONS] < 0))
+		fputs("aw-bench: hardware counters unavailable, reporting time only\n", stderr);
+
+	for (i = 0; i < countof(benches); ++i) {
+		const struct bench *b = &benches[i];
+		struct bench_result r;
+		if (!bench_selected(b->name, argc, argv, 1))
+			continue;
+		r = bench_run(b, target_ns, reps);
+		bench_print(format, b, &r);
+	}
+
+	strintern_free(&bench_intern);
+	return EXIT_SUCCESS;
+}
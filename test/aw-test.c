@@ -0,0 +1,2971 @@
+/*
+   Copyright (c) 2014-2025 Malte Hildingsson, malte (at) afterwi.se
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+   THE SOFTWARE.
+ */
+
+/* Differential tests: every fast path is checked against a naive reference
+   written for clarity, over edge cases and seeded random input. Run under
+   AW_CPU_MASK to cover each dispatch level; a seed may be given as the
+   first argument to vary the random input. */
+
+#include "aw-approx.h"
+#include "aw-arith.h"
+#include "aw-bitset.h"
+#include "aw-bitstream.h"
+#include "aw-bytes.h"
+#include "aw-bytestream.h"
+#include "aw-checksum.h"
+#include "aw-cpu.h"
+#include "aw-endian.h"
+#include "aw-format.h"
+#include "aw-hash.h"
+#include "aw-parse.h"
+#include "aw-random.h"
+#include "aw-simd.h"
+#include "aw-sort.h"
+#include "aw-strings.h"
+#include "aw-utf.h"
+#include "aw-varint.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__) || defined(__APPLE__)
+# include <sys/mman.h>
+# include <unistd.h>
+# define TEST_GUARD_PAGES 1
+#endif
+#if !defined(_WIN32)
+# include <pthread.h>
+# define TEST_THREADS 1
+#endif
+
+#define countof(a) (sizeof (a) / sizeof (a)[0])
+
+#define TEST_ITERS 100000
+#define TEST_MAX_REPORTS 50
+
+static unsigned long test_checks;
+static unsigned long test_failures;
+static const char *test_section;
+
+static void test_fail(int line, const char *expr, const char *format, ...) {
+	va_list ap;
+
+	if (++test_failures > TEST_MAX_REPORTS)
+		return;
+
+	fprintf(stderr, "%s:%d: %s: check failed: %s", __FILE__, line, test_section, expr);
+	if (format != NULL) {
+		fputs(" [", stderr);
+		va_start(ap, format);
+		vfprintf(stderr, format, ap);
+		va_end(ap);
+		fputc(']', stderr);
+	}
+	fputc('\n', stderr);
+}
+
+#define CHECK(cond) do { \
+	++test_checks; \
+	if (!(cond)) \
+		test_fail(__LINE__, #cond, NULL); \
+} while (0)
+
+#define CHECKF(cond, ...) do { \
+	++test_checks; \
+	if (!(cond)) \
+		test_fail(__LINE__, #cond, __VA_ARGS__); \
+} while (0)
+
+/* splitmix64 */
+static u64 test_seed = imm_u64(0x853c49e6748fea9b);
+
+static u64 test_rand(void) {
+	u64 z = (test_seed += imm_u64(0x9e3779b97f4a7c15));
+	z = (z ^ (z >> 30)) * imm_u64(0xbf58476d1ce4e5b9);
+	z = (z ^ (z >> 27)) * imm_u64(0x94d049bb133111eb);
+	return z ^ (z >> 31);
+}
+
+static u32 test_below(u32 n) { return (u32) ((test_rand() >> 32) * n >> 32); }
+
+static const u32 test_edge_u32[] = {
+	0, 1, 2, 3, 7, 0x7f, 0x80, 0xff, 0x100, 0x7fff, 0x8000, 0xffff, 0x10000,
+	0x7fffffff, 0x80000000, 0x80000001, 0xfffffffe, 0xffffffff,
+};
+
+static const u64 test_edge_u64[] = {
+	0, 1, 2, 3, 7, 0xff, 0xffff, 0x7fffffff, 0x80000000, 0xffffffff,
+	imm_u64(0x100000000), imm_u64(0x7fffffffffffffff), imm_u64(0x8000000000000000),
+	imm_u64(0x8000000000000001), imm_u64(0xfffffffffffffffe), imm_u64(0xffffffffffffffff),
+};
+
+/* Edge values, small numbers and full-width ones in equal measure. */
+static u32 test_u32(void) {
+	u64 r = test_rand();
+	switch (r & 3) {
+	case 0: return test_edge_u32[(r >> 8) % countof(test_edge_u32)];
+	case 1: return (u32) (r >> 32) >> ((r >> 2) & 31);
+	default: return (u32) (r >> 32);
+	}
+}
+
+static u64 test_u64(void) {
+	u64 r = test_rand();
+	switch (r & 3) {
+	case 0: return test_edge_u64[(r >> 8) % countof(test_edge_u64)];
+	case 1: return test_rand() >> ((r >> 2) & 63);
+	default: return test_rand();
+	}
+}
+
+static f32 test_f32(f32 range) {
+	u64 r = test_rand();
+	f32 f = (f32) (r >> 40) / (f32) (1 << 24);
+	switch (r & 3) {
+	case 0: return (f32) (s32) (test_below(64) - 32) * .5f;
+	case 1: return (f32) (s32) (test_below(2000) - 1000) + (r & 4 ? .5f : -.5f);
+	default: return (f * 2.f - 1.f) * range;
+	}
+}
+
+static void test_fill(void *dst, size_t size) {
+	u8 *p = (u8 *) dst;
+	size_t i;
+	for (i = 0; i < size; ++i)
+		p[i] = (u8) test_rand();
+}
+
+static int test_sign(s64 v) { return (v > 0) - (v < 0); }
+
+/* Array lengths around every vector width, then some long ones. */
+static const size_t test_counts[] = {
+	0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 127, 128, 129, 255, 1000, 4099,
+};
+
+#define TEST_ARRAY 4160
+
+/*
+ * Arithmetic
+ */
+
+static u64 ref_mulwide_u64(u64 a, u64 b, u64 *lo) {
+	u64 al = (u32) a, ah = a >> 32, bl = (u32) b, bh = b >> 32;
+	u64 ll = al * bl, lh = al * bh, hl = ah * bl, hh = ah * bh;
+	u64 mid = (ll >> 32) + (u32) lh + (u32) hl;
+	*lo = (mid << 32) | (u32) ll;
+	return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+}
+
+static u32 ref_clz_u64(u64 a) {
+	u32 n = 0;
+	for (; n < 64 && !(a >> (63 - n) & 1); ++n)
+		;
+	return n;
+}
+
+static u32 ref_ctz_u64(u64 a) {
+	u32 n = 0;
+	for (; n < 64 && !(a >> n & 1); ++n)
+		;
+	return n;
+}
+
+static u32 ref_popcount_u64(u64 a) {
+	u32 n = 0;
+	for (; a != 0; a >>= 1)
+		n += (u32) (a & 1);
+	return n;
+}
+
+static void test_arith_select(void) {
+	int i;
+	test_section = "arith/select";
+	for (i = 0; i < TEST_ITERS; ++i) {
+		u32 x = test_u32(), a = test_u32(), b = test_u32();
+		u64 x64 = test_u64(), a64 = test_u64(), b64 = test_u64();
+		s32 sx = (s32) x, sa = (s32) a, sb = (s32) b;
+		s64 sx64 = (s64) x64, sa64 = (s64) a64, sb64 = (s64) b64;
+
+		CHECKF(sel_s32(sx, sa, sb) == (sx >= 0 ? sa : sb), "%d %d %d", sx, sa, sb);
+		CHECKF(sel_u32(x, a, b) == ((s32) x >= 0 ? a : b), "%u %u %u", x, a, b);
+		CHECK(sel_s64(sx64, sa64, sb64) == (sx64 >= 0 ? sa64 : sb64));
+		CHECK(sel_u64(x64, a64, b64) == ((s64) x64 >= 0 ? a64 : b64));
+		CHECKF(selgtz_s32(sx, sa, sb) == (sx > 0 ? sa : sb), "%d %d %d", sx, sa, sb);
+		CHECKF(selgtz_u32(x, a, b) == ((s32) x > 0 ? a : b), "%u %u %u", x, a, b);
+		CHECK(selgtz_s64(sx64, sa64, sb64) == (sx64 > 0 ? sa64 : sb64));
+		CHECK(selgtz_u64(x64, a64, b64) == ((s64) x64 > 0 ? a64 : b64));
+		CHECK(selltz_s32(sx, sa, sb) == (sx < 0 ? sa : sb));
+		CHECK(selltz_u32(x, a, b) == ((s32) x < 0 ? a : b));
+		CHECK(selltz_s64(sx64, sa64, sb64) == (sx64 < 0 ? sa64 : sb64));
+		CHECK(selltz_u64(x64, a64, b64) == ((s64) x64 < 0 ? a64 : b64));
+		CHECK(selz_s32(sx, sa, sb) == (sx == 0 ? sa : sb));
+		CHECK(selz_u32(x, a, b) == (x == 0 ? a : b));
+		CHECK(selz_s64(sx64, sa64, sb64) == (sx64 == 0 ? sa64 : sb64));
+		CHECK(selz_u64(x64, a64, b64) == (x64 == 0 ? a64 : b64));
+
+		CHECKF(min_u32(a, b) == (a < b ? a : b), "%u %u", a, b);
+		CHECKF(max_u32(a, b) == (a < b ? b : a), "%u %u", a, b);
+		CHECK(min_u64(a64, b64) == (a64 < b64 ? a64 : b64));
+		CHECK(max_u64(a64, b64) == (a64 < b64 ? b64 : a64));
+		CHECK(min_s32(sa, sb) == (sa < sb ? sa : sb));
+		CHECK(max_s32(sa, sb) == (sa < sb ? sb : sa));
+		CHECK(clamp_s32(sx, min_s32(sa, sb), max_s32(sa, sb)) ==
+			(sx < min_s32(sa, sb) ? min_s32(sa, sb) : sx > max_s32(sa, sb) ? max_s32(sa, sb) : sx));
+		CHECK(clamp_u32(x, min_u32(a, b), max_u32(a, b)) ==
+			(x < min_u32(a, b) ? min_u32(a, b) : x > max_u32(a, b) ? max_u32(a, b) : x));
+
+		if (sx != INT_MIN) {
+			CHECK(abs_s32(sx) == (sx < 0 ? -sx : sx));
+			CHECK(sgn_s32(sx) == test_sign(sx));
+		}
+		if (sx64 != LLONG_MIN)
+			CHECK(abs_s64(sx64) == (sx64 < 0 ? -sx64 : sx64));
+
+		/* Wrapping counters take indices below 2^31. */
+		{
+			u32 mx = a >> 1, v = b >> 1;
+			v = mx != 0 ? v % (mx + 1) : 0;
+			CHECK(incwrap_u32(v, mx) == (v == mx ? 0 : v + 1));
+			CHECK(decwrap_u32(v, mx) == (v == 0 ? mx : v - 1));
+		}
+
+		CHECK(sgnflip_s32(sx) == (s32) (x ^ (sx < 0 ? 0xffffffff : 0x80000000)));
+		CHECK(invsgnflip_s32(sgnflip_s32(sx)) == sx);
+		CHECK(sgnflip_s64(sx64) == (s64) (x64 ^ (sx64 < 0 ? imm_u64(0xffffffffffffffff) : imm_u64(0x8000000000000000))));
+		CHECK(invsgnflip_s64(sgnflip_s64(sx64)) == sx64);
+	}
+
+	/* sgnflip maps the float order onto the unsigned integer order. */
+	for (i = 0; i < TEST_ITERS; ++i) {
+		union { f32 f; s32 s; } a, b;
+		a.f = test_f32(1e6f);
+		b.f = test_f32(1e6f);
+		if (a.f != b.f)
+			CHECKF(((u32) sgnflip_s32(a.s) < (u32) sgnflip_s32(b.s)) == (a.f < b.f), "%g %g", a.f, b.f);
+	}
+	for (i = 0; i < TEST_ITERS; ++i) {
+		union { f64 f; s64 s; } a, b;
+		a.f = (f64) test_f32(1e6f) * (f64) test_f32(1e6f);
+		b.f = (f64) test_f32(1e6f) * (f64) test_f32(1e6f);
+		if (a.f != b.f)
+			CHECKF(((u64) sgnflip_s64(a.s) < (u64) sgnflip_s64(b.s)) == (a.f < b.f), "%g %g", a.f, b.f);
+	}
+}
+
+static void test_arith_bits(void) {
+	u32 i, n;
+	test_section = "arith/bits";
+	for (i = 0; i < TEST_ITERS; ++i) {
+		u32 a = test_u32();
+		u64 b = test_u64();
+		u32 ref_clz = 0, ref_ctz = 0, ref_pow2 = 0, ref_swap = 0;
+
+		for (; ref_clz < 32 && !(a >> (31 - ref_clz) & 1); ++ref_clz)
+			;
+		for (; ref_ctz < 32 && !(a >> ref_ctz & 1); ++ref_ctz)
+			;
+		for (n = 0; n < 32; ++n)
+			ref_swap |= (a >> n & 1) << (31 - n);
+
+		CHECKF(clz_u32(a) == ref_clz, "%#x", a);
+		CHECKF(ctz_u32(a) == ref_ctz, "%#x", a);
+		CHECKF(clz_u64(b) == ref_clz_u64(b), "%#llx", (unsigned long long) b);
+		CHECKF(ctz_u64(b) == ref_ctz_u64(b), "%#llx", (unsigned long long) b);
+		CHECKF(popcount_u32(a) == ref_popcount_u64(a), "%#x", a);
+		CHECKF(popcount_u64(b) == ref_popcount_u64(b), "%#llx", (unsigned long long) b);
+		CHECKF(bitswap_u32(a) == ref_swap, "%#x", a);
+		CHECK(bitswap_u8((u8) a) == (u8) (ref_swap >> 24));
+		CHECK(bitswap_u16((u16) a) == (u16) (ref_swap >> 16));
+		CHECK(bitswap_u64(b) >> 32 == bitswap_u32((u32) b));
+		CHECK(ispow2_u32(a) == ((a & (a - 1)) == 0));
+
+		if (a != 0)
+			ref_pow2 = 1u << (31 - ref_clz);
+		CHECKF(floorpow2_u32(a) == ref_pow2, "%#x", a);
+		if (a <= 0x80000000) {
+			for (ref_pow2 = 1; ref_pow2 < a; ref_pow2 <<= 1)
+				;
+			CHECKF(ceilpow2_u32(a) == (a == 0 ? 0 : ref_pow2), "%#x", a);
+		}
+	}
+}
+
+static void test_arith_round(void) {
+	static f32 src[TEST_ARRAY];
+	static s32 dst[TEST_ARRAY];
+	size_t c, i;
+	int k;
+	test_section = "arith/round";
+
+	for (k = 0; k < TEST_ITERS; ++k) {
+		f32 f = test_f32(k & 1 ? 2.1e9f : 1e4f);
+		f64 g = (f64) f * 3.;
+		CHECKF(trunc_f32(f) == (s32) truncf(f), "%.9g", f);
+		CHECKF(round_f32(f) == (s32) rintf(f), "%.9g", f);
+		CHECKF(floor_f32(f) == (s32) floorf(f), "%.9g", f);
+		CHECKF(ceil_f32(f) == (s32) ceilf(f), "%.9g", f);
+		CHECKF(trunc_f64(g) == (s64) trunc(g), "%.17g", g);
+		CHECKF(round_f64(g) == (s64) rint(g), "%.17g", g);
+		CHECKF(floor_f64(g) == (s64) floor(g), "%.17g", g);
+		CHECKF(ceil_f64(g) == (s64) ceil(g), "%.17g", g);
+		if (f > 0.f && f < 1e30f) {
+			int e;
+			frexpf(f, &e);
+			CHECKF(log2_f32(f) == e - 1, "%.9g", f);
+		}
+	}
+
+	for (c = 0; c < countof(test_counts); ++c) {
+		size_t n = test_counts[c];
+		for (i = 0; i < n; ++i)
+			src[i] = test_f32(i & 1 ? 2.1e9f : 100.f);
+
+		trunc_f32_array(dst, src, n);
+		for (i = 0; i < n; ++i)
+			CHECKF(dst[i] == (s32) truncf(src[i]), "n=%u i=%u %.9g", (unsigned) n, (unsigned) i, src[i]);
+		round_f32_array(dst, src, n);
+		for (i = 0; i < n; ++i)
+			CHECKF(dst[i] == (s32) rintf(src[i]), "n=%u i=%u %.9g", (unsigned) n, (unsigned) i, src[i]);
+		floor_f32_array(dst, src, n);
+		for (i = 0; i < n; ++i)
+			CHECKF(dst[i] == (s32) floorf(src[i]), "n=%u i=%u %.9g", (unsigned) n, (unsigned) i, src[i]);
+		ceil_f32_array(dst, src, n);
+		for (i = 0; i < n; ++i)
+			CHECKF(dst[i] == (s32) ceilf(src[i]), "n=%u i=%u %.9g", (unsigned) n, (unsigned) i, src[i]);
+	}
+
+	/* Halves round to even wherever they fall: in the widest blocks, in the
+	   four-lane loop and in the scalar tail. Halved, the same values are
+	   halves again as q32 with one fraction bit. */
+	{
+		static const f32 ties[8] = { .5f, 1.5f, 2.5f, -.5f, -1.5f, -2.5f, .49999997f, 8388607.5f };
+		static q32 q[39];
+		for (i = 0; i < 39; ++i)
+			src[i] = ties[i % 8];
+		round_f32_array(dst, src, 39);
+		for (i = 0; i < 39; ++i)
+			CHECKF(dst[i] == (s32) rintf(src[i]), "i=%u %.9g", (unsigned) i, src[i]);
+		for (i = 0; i < 39; ++i)
+			src[i] = ties[i % 8] * .5f;
+		f32_to_q32_array(q, src, 39, 1);
+		for (i = 0; i < 39; ++i)
+			CHECKF(q[i] == dst[i], "i=%u %.9g", (unsigned) i, src[i]);
+	}
+}
+
+/* The batch conversions saturate; the scalar ones leave that to the caller.
+   q32 saturates at the largest f32 below 2^31. */
+static s64 ref_f32_to_q(f32 f, f32 scale, s64 lo, s64 hi) {
+	f64 v = rint((f64) (f * scale));
+	return v <= (f64) lo ? lo : v >= (f64) hi ? hi : (s64) v;
+}
+
+static void test_arith_fixed(void) {
+	static f32 fs[TEST_ARRAY], fd[TEST_ARRAY];
+	static q16 x16[TEST_ARRAY], y16[TEST_ARRAY], d16[TEST_ARRAY];
+	static q32 x32[TEST_ARRAY], y32[TEST_ARRAY], d32[TEST_ARRAY];
+	static q64 x64[TEST_ARRAY], y64[TEST_ARRAY], d64[TEST_ARRAY];
+	static f64 gs[TEST_ARRAY], gd[TEST_ARRAY];
+	size_t c, i;
+	int k;
+	test_section = "arith/fixed";
+
+	for (k = 0; k < TEST_ITERS; ++k) {
+		q64 a = (q64) test_u64(), b = (q64) test_u64();
+		s64 frac = 1 + test_below(62);
+		u64 lo, hi = ref_mulwide_u64((u64) a, (u64) b, &lo), rlo;
+
+		CHECK(mulwide_u64((u64) a, (u64) b, &rlo) == hi && rlo == lo);
+#if defined(__SIZEOF_INT128__)
+		{
+			__int128 p = (__int128) a * b, r = p >> frac;
+			s64 rhi = (s64) (u64) (p >> 64);
+			u64 q, rem;
+			CHECK(mulwide_s64(a, b, &rlo) == rhi && rlo == (u64) p);
+			CHECKF(mul_q64(a, b, frac) == (q64) r, "%lld %lld %d", (long long) a, (long long) b, (int) frac);
+			CHECKF(mulsat_q64(a, b, frac) == (r > Q64_MAX ? Q64_MAX : r < Q64_MIN ? Q64_MIN : (q64) r),
+				"%lld %lld %d", (long long) a, (long long) b, (int) frac);
+			if (b != 0) {
+				/* Small divisors make quotients that overflow. */
+				q64 e = (b >> test_below(63)) | 1;
+				__int128 n = (__int128) a * ((__int128) 1 << frac), qd = n / b, qe = n / e;
+				CHECKF(div_q64(a, b, frac) == (q64) (u64) qd, "%lld %lld %d", (long long) a, (long long) b, (int) frac);
+				CHECKF(div_q64(a, e, frac) == (q64) (u64) qe, "%lld %lld %d", (long long) a, (long long) e, (int) frac);
+				CHECK(divsat_q64(a, b, frac) == (qd > Q64_MAX ? Q64_MAX : qd < Q64_MIN ? Q64_MIN : (q64) qd));
+				CHECK(divsat_q64(a, e, frac) == (qe > Q64_MAX ? Q64_MAX : qe < Q64_MIN ? Q64_MIN : (q64) qe));
+			}
+			CHECK(divsat_q64(a, 0, frac) == (a < 0 ? Q64_MIN : Q64_MAX));
+			if ((u64) b != 0 && hi < (u64) b) {
+				unsigned __int128 n = (unsigned __int128) hi << 64 | lo;
+				q = divwide_u64(hi, lo, (u64) b, &rem);
+				CHECK(q == (u64) (n / (u64) b) && rem == (u64) (n % (u64) b));
+			}
+		}
+#else
+		if ((u64) b != 0 && hi < (u64) b) {
+			u64 q, rem, phi, plo;
+			q = divwide_u64(hi, lo, (u64) b, &rem);
+			phi = ref_mulwide_u64(q, (u64) b, &plo);
+			plo += rem;
+			phi += plo < rem;
+			CHECK(phi == hi && plo == lo && rem < (u64) b);
+		}
+#endif
+		CHECK(addsat_q64(a, b) == (b > 0 && a > Q64_MAX - b ? Q64_MAX : b < 0 && a < Q64_MIN - b ? Q64_MIN : a + b));
+		CHECK(subsat_q64(a, b) == (b < 0 && a > Q64_MAX + b ? Q64_MAX : b > 0 && a < Q64_MIN + b ? Q64_MIN : a - b));
+	}
+
+	for (c = 0; c < countof(test_counts); ++c) {
+		size_t n = test_counts[c];
+		s16 fr16 = (s16) (1 + test_below(14));
+		s32 fr32 = (s32) (1 + test_below(30));
+		s64 fr64 = (s64) (1 + test_below(62));
+		f32 scale16 = ldexpf(1.f, fr16), scale32 = ldexpf(1.f, fr32);
+
+		for (i = 0; i < n; ++i) {
+			fs[i] = test_f32(i & 1 ? 1e5f : 4.f);
+			gs[i] = (f64) fs[i] * 1e3;
+			x16[i] = (q16) test_u32();
+			y16[i] = (q16) (test_u32() | 1);
+			x32[i] = (q32) test_u32();
+			y32[i] = (q32) (test_u32() | 1);
+			x64[i] = (q64) test_u64();
+			y64[i] = (q64) (test_u64() | 1);
+		}
+
+		f32_to_q16_array(d16, fs, n, fr16);
+		for (i = 0; i < n; ++i)
+			CHECKF(d16[i] == ref_f32_to_q(fs[i], scale16, Q16_MIN, Q16_MAX), "%.9g %d", fs[i], fr16);
+		q16_to_f32_array(fd, x16, n, fr16);
+		for (i = 0; i < n; ++i)
+			CHECK(fd[i] == q16_to_f32(x16[i], fr16));
+		add_q16_array(d16, x16, y16, n);
+		for (i = 0; i < n; ++i)
+			CHECK(d16[i] == add_q16(x16[i], y16[i]));
+		sub_q16_array(d16, x16, y16, n);
+		for (i = 0; i < n; ++i)
+			CHECK(d16[i] == sub_q16(x16[i], y16[i]));
+		mul_q16_array(d16, x16, y16, n, fr16);
+		for (i = 0; i < n; ++i)
+			CHECK(d16[i] == mul_q16(x16[i], y16[i], fr16));
+		div_q16_array(d16, x16, y16, n, fr16);
+		for (i = 0; i < n; ++i)
+			CHECK(d16[i] == div_q16(x16[i], y16[i], fr16));
+		addsat_q16_array(d16, x16, y16, n);
+		for (i = 0; i < n; ++i)
+			CHECK(d16[i] == clamp_s32(x16[i] + y16[i], Q16_MIN, Q16_MAX));
+		subsat_q16_array(d16, x16, y16, n);
+		for (i = 0; i < n; ++i)
+			CHECK(d16[i] == clamp_s32(x16[i] - y16[i], Q16_MIN, Q16_MAX));
+		mulsat_q16_array(d16, x16, y16, n, fr16);
+		for (i = 0; i < n; ++i)
+			CHECK(d16[i] == clamp_s32((x16[i] * y16[i]) >> fr16, Q16_MIN, Q16_MAX));
+		divsat_q16_array(d16, x16, y16, n, fr16);
+		for (i = 0; i < n; ++i)
+			CHECK(d16[i] == clamp_s32((x16[i] * (1 << fr16)) / y16[i], Q16_MIN, Q16_MAX));
+
+		f32_to_q32_array(d32, fs, n, fr32);
+		for (i = 0; i < n; ++i)
+			CHECKF(d32[i] == ref_f32_to_q(fs[i], scale32, Q32_MIN, 2147483520), "%.9g %d", fs[i], fr32);
+		q32_to_f32_array(fd, x32, n, fr32);
+		for (i = 0; i < n; ++i)
+			CHECK(fd[i] == (f32) x32[i] * ldexpf(1.f, -fr32));
+		add_q32_array(d32, x32, y32, n);
+		for (i = 0; i < n; ++i)
+			CHECK(d32[i] == (q32) ((u32) x32[i] + (u32) y32[i]));
+		sub_q32_array(d32, x32, y32, n);
+		for (i = 0; i < n; ++i)
+			CHECK(d32[i] == (q32) ((u32) x32[i] - (u32) y32[i]));
+		mul_q32_array(d32, x32, y32, n, fr32);
+		for (i = 0; i < n; ++i)
+			CHECK(d32[i] == (q32) (((s64) x32[i] * y32[i]) >> fr32));
+		div_q32_array(d32, x32, y32, n, fr32);
+		for (i = 0; i < n; ++i)
+			CHECK(d32[i] == (q32) ((s64) x32[i] * ((s64) 1 << fr32) / y32[i]));
+		addsat_q32_array(d32, x32, y32, n);
+		for (i = 0; i < n; ++i)
+			CHECK(d32[i] == clamp_s64((s64) x32[i] + y32[i], Q32_MIN, Q32_MAX));
+		subsat_q32_array(d32, x32, y32, n);
+		for (i = 0; i < n; ++i)
+			CHECK(d32[i] == clamp_s64((s64) x32[i] - y32[i], Q32_MIN, Q32_MAX));
+		mulsat_q32_array(d32, x32, y32, n, fr32);
+		for (i = 0; i < n; ++i)
+			CHECK(d32[i] == clamp_s64(((s64) x32[i] * y32[i]) >> fr32, Q32_MIN, Q32_MAX));
+		divsat_q32_array(d32, x32, y32, n, fr32);
+		for (i = 0; i < n; ++i)
+			CHECK(d32[i] == clamp_s64((s64) x32[i] * ((s64) 1 << fr32) / y32[i], Q32_MIN, Q32_MAX));
+
+		f64_to_q64_array(d64, gs, n, fr64);
+		for (i = 0; i < n; ++i) {
+			f64 v = rint(gs[i] * ldexp(1., (int) fr64));
+			CHECK(d64[i] == (v >= 9223372036854775808. ? Q64_MAX : v <= -9223372036854775808. ? Q64_MIN : (q64) v));
+		}
+		q64_to_f64_array(gd, x64, n, fr64);
+		for (i = 0; i < n; ++i)
+			CHECK(gd[i] == (f64) x64[i] * ldexp(1., (int) -fr64));
+		add_q64_array(d64, x64, y64, n);
+		for (i = 0; i < n; ++i)
+			CHECK(d64[i] == (q64) ((u64) x64[i] + (u64) y64[i]));
+		sub_q64_array(d64, x64, y64, n);
+		for (i = 0; i < n; ++i)
+			CHECK(d64[i] == (q64) ((u64) x64[i] - (u64) y64[i]));
+		mul_q64_array(d64, x64, y64, n, fr64);
+		for (i = 0; i < n; ++i)
+			CHECK(d64[i] == mul_q64(x64[i], y64[i], fr64));
+		addsat_q64_array(d64, x64, y64, n);
+		for (i = 0; i < n; ++i)
+			CHECK(d64[i] == addsat_q64(x64[i], y64[i]));
+		subsat_q64_array(d64, x64, y64, n);
+		for (i = 0; i < n; ++i)
+			CHECK(d64[i] == subsat_q64(x64[i], y64[i]));
+		mulsat_q64_array(d64, x64, y64, n, fr64);
+		for (i = 0; i < n; ++i)
+			CHECK(d64[i] == mulsat_q64(x64[i], y64[i], fr64));
+		div_q64_array(d64, x64, y64, n, fr64);
+		for (i = 0; i < n; ++i)
+			CHECK(d64[i] == div_q64(x64[i], y64[i], fr64));
+		divsat_q64_array(d64, x64, y64, n, fr64);
+		for (i = 0; i < n; ++i)
+			CHECK(d64[i] == divsat_q64(x64[i], y64[i], fr64));
+	}
+}
+
+static void test_arith_div(void) {
+	static u32 src[TEST_ARRAY], dst[TEST_ARRAY];
+	size_t c, i;
+	int k, j;
+	test_section = "arith/div";
+
+	for (k = 0; k < 4000; ++k) {
+		u32 d = k < (int) countof(test_edge_u32) ? test_edge_u32[k] : test_u32();
+		u64 d64 = k < (int) countof(test_edge_u64) ? test_edge_u64[k] : test_u64();
+		struct divider_u32 du;
+		struct divider_s32 ds;
+		struct divider_u64 du64;
+		struct divider_s64 ds64;
+
+		d += d == 0;
+		d64 += d64 == 0;
+		du = divider_u32_make(d);
+		ds = divider_s32_make((s32) d);
+		du64 = divider_u64_make(d64);
+		ds64 = divider_s64_make((s64) d64);
+
+		for (j = 0; j < 64; ++j) {
+			u32 x = j < (int) countof(test_edge_u32) ? test_edge_u32[j] : test_u32();
+			u64 x64 = j < (int) countof(test_edge_u64) ? test_edge_u64[j] : test_u64();
+			s32 sx = (s32) x, sd = (s32) d;
+			s64 sx64 = (s64) x64, sd64 = (s64) d64;
+
+			CHECKF(fastdiv_u32(x, du) == x / d, "%u / %u", x, d);
+			CHECKF(fastmod_u32(x, du) == x % d, "%u %% %u", x, d);
+			CHECKF(fastdiv_u64(x64, du64) == x64 / d64, "%llu / %llu", (unsigned long long) x64, (unsigned long long) d64);
+			CHECKF(fastdivbf_u64(x64, du64) == x64 / d64, "%llu / %llu", (unsigned long long) x64, (unsigned long long) d64);
+			CHECKF(fastmod_u64(x64, du64) == x64 % d64, "%llu %% %llu", (unsigned long long) x64, (unsigned long long) d64);
+			if (!(sx == INT_MIN && sd == -1)) {
+				CHECKF(fastdiv_s32(sx, ds) == sx / sd, "%d / %d", sx, sd);
+				CHECKF(fastmod_s32(sx, ds) == sx % sd, "%d %% %d", sx, sd);
+			}
+			if (!(sx64 == LLONG_MIN && sd64 == -1)) {
+				CHECKF(fastdiv_s64(sx64, ds64) == sx64 / sd64, "%lld / %lld", (long long) sx64, (long long) sd64);
+				CHECKF(fastdivbf_s64(sx64, ds64) == sx64 / sd64, "%lld / %lld", (long long) sx64, (long long) sd64);
+				CHECKF(fastmod_s64(sx64, ds64) == sx64 % sd64, "%lld %% %lld", (long long) sx64, (long long) sd64);
+			}
+			CHECK(reduce_u32(x, d) == (u32) ((u64) x * d >> 32));
+			CHECK(reduce_u64(x64, d64) == ref_mulwide_u64(x64, d64, &x64));
+		}
+	}
+
+	for (c = 0; c < countof(test_counts); ++c) {
+		size_t n = test_counts[c];
+		for (k = 0; k < 8; ++k) {
+			u32 d = k < 2 ? (u32) k + 1 : k == 2 ? 0x80000000 : k == 3 ? 0xffffffff : test_u32() | 1;
+			s32 sd = k == 3 ? INT_MIN : k == 4 ? -1 : (s32) d;
+			struct divider_u32 du = divider_u32_make(d);
+			struct divider_s32 ds = divider_s32_make(sd);
+
+			for (i = 0; i < n; ++i)
+				src[i] = test_u32();
+			fastdiv_u32_array(dst, src, n, du);
+			for (i = 0; i < n; ++i)
+				CHECKF(dst[i] == src[i] / d, "n=%u %u / %u", (unsigned) n, src[i], d);
+
+			for (i = 0; i < n; ++i)
+				if (sd == -1 && src[i] == 0x80000000)
+					src[i] = 0;
+			fastdiv_s32_array((s32 *) dst, (const s32 *) src, n, ds);
+			for (i = 0; i < n; ++i)
+				CHECKF((s32) dst[i] == (s32) src[i] / sd, "n=%u %d / %d", (unsigned) n, (s32) src[i], sd);
+		}
+	}
+}
+
+/*
+ * SIMD lanes
+ */
+
+#if defined(_have_simd_ops)
+static f32 test_fa[4], test_fb[4], test_fc[4], test_fr[4];
+static u32 test_ua[4], test_ub[4], test_ur[4];
+
+/* Each lane of a vector operation against the scalar expression over the
+   same lanes of a, b and c; i names the lane. */
+#define CHECK_F32X4(vec, ref) do { \
+	storeu_f32x4(test_fr, vec); \
+	for (i = 0; i < 4; ++i) \
+		CHECKF(test_fr[i] == (ref), "%s lane %u: %.9g %.9g -> %.9g", #vec, i, test_fa[i], test_fb[i], test_fr[i]); \
+} while (0)
+
+#define CHECK_F32X4_NEAR(vec, ref, tol) do { \
+	storeu_f32x4(test_fr, vec); \
+	for (i = 0; i < 4; ++i) \
+		CHECKF(fabs(test_fr[i] - (ref)) <= (tol), "%s lane %u: %.9g %.9g -> %.9g", #vec, i, test_fa[i], test_fb[i], test_fr[i]); \
+} while (0)
+
+#define CHECK_U32X4(vec, ref) do { \
+	storeu_u32x4(test_ur, vec); \
+	for (i = 0; i < 4; ++i) \
+		CHECKF(test_ur[i] == (u32) (ref), "%s lane %u: %#x %#x -> %#x", #vec, i, test_ua[i], test_ub[i], test_ur[i]); \
+} while (0)
+
+#define TEST_MASK(c) ((c) ? 0xffffffffu : 0u)
+
+static void test_simd(void) {
+	static const u32 shuffles[][4] = { { 0, 1, 2, 3 }, { 3, 2, 1, 0 }, { 1, 0, 3, 2 }, { 2, 2, 0, 1 } };
+	union { f32x4 v; f32 f[4]; } af;
+	union { u32x4 v; u32 u[4]; } au;
+	unsigned i;
+	int k;
+	test_section = "simd";
+
+	for (k = 0; k < TEST_ITERS / 4; ++k) {
+		f32x4 a, b, c;
+		u32x4 x, y, m;
+		s32 n = (s32) test_below(32);
+		f64 sum;
+
+		for (i = 0; i < 4; ++i) {
+			test_fa[i] = test_f32(k & 1 ? 1e4f : 2.1e9f);
+			test_fb[i] = test_f32(1e4f);
+			test_fc[i] = test_f32(1e4f);
+			test_ua[i] = test_u32();
+			test_ub[i] = test_u32();
+		}
+		for (i = 0; i < 4; ++i) {
+			/* Equal lanes now and then for the compares, and no zero to
+			   divide by. */
+			if (k & 2)
+				test_fb[i] = test_fa[(i + k) & 3];
+			if (k & 4)
+				test_ub[i] = test_ua[(i + k) & 3];
+			if (test_fb[i] == 0.f)
+				test_fb[i] = 1.f;
+		}
+		a = loadu_f32x4(test_fa);
+		b = loadu_f32x4(test_fb);
+		c = loadu_f32x4(test_fc);
+		x = loadu_u32x4(test_ua);
+		y = loadu_u32x4(test_ub);
+		m = sra_u32x4(y, 31);
+
+		CHECK_F32X4(add_f32x4(a, b), test_fa[i] + test_fb[i]);
+		CHECK_F32X4(sub_f32x4(a, b), test_fa[i] - test_fb[i]);
+		CHECK_F32X4(mul_f32x4(a, b), test_fa[i] * test_fb[i]);
+		CHECK_F32X4_NEAR(div_f32x4(a, b), (f64) test_fa[i] / test_fb[i], fabs((f64) test_fa[i] / test_fb[i]) * 3e-7);
+		CHECK_F32X4_NEAR(madd_f32x4(a, b, c), (f64) test_fa[i] * test_fb[i] + test_fc[i],
+			(fabs((f64) test_fa[i] * test_fb[i]) + fabs(test_fc[i])) * 1.2e-7);
+		CHECK_F32X4_NEAR(sqrt_f32x4(abs_f32x4(a)), sqrt(fabs(test_fa[i])), sqrt(fabs(test_fa[i])) * 3e-7);
+		CHECK_F32X4_NEAR(rcp_f32x4(b), 1. / test_fb[i], fabs(1. / test_fb[i]) * 4e-3);
+		CHECK_F32X4_NEAR(rsqrt_f32x4(abs_f32x4(b)), 1. / sqrt(fabs(test_fb[i])), 1. / sqrt(fabs(test_fb[i])) * 4e-3);
+		CHECK_F32X4(neg_f32x4(a), -test_fa[i]);
+		CHECK_F32X4(abs_f32x4(a), fabsf(test_fa[i]));
+		CHECK_F32X4(min_f32x4(a, b), test_fa[i] < test_fb[i] ? test_fa[i] : test_fb[i]);
+		CHECK_F32X4(max_f32x4(a, b), test_fa[i] > test_fb[i] ? test_fa[i] : test_fb[i]);
+		CHECK_F32X4(sqr_f32x4(a), test_fa[i] * test_fa[i]);
+		CHECK_F32X4(sel_f32x4(a, b, c), test_fa[i] >= 0.f ? test_fb[i] : test_fc[i]);
+		CHECK_F32X4(clamp_f32x4(a, set1_f32x4(-100.f), set1_f32x4(100.f)), test_fa[i] < -100.f ? -100.f : test_fa[i] > 100.f ? 100.f : test_fa[i]);
+		CHECK_F32X4(saturate_f32x4(a), test_fa[i] < 0.f ? 0.f : test_fa[i] > 1.f ? 1.f : test_fa[i]);
+		CHECK_F32X4_NEAR(lerp_f32x4(set1_f32x4(.25f), b, c), test_fb[i] + .25 * ((f64) test_fc[i] - test_fb[i]),
+			(fabs(test_fb[i]) + fabs(test_fc[i])) * 2.4e-7);
+		CHECK_F32X4(blend_f32x4(m, a, b), (s32) test_ub[i] < 0 ? test_fa[i] : test_fb[i]);
+
+		CHECK_U32X4(cmpeq_f32x4(a, b), TEST_MASK(test_fa[i] == test_fb[i]));
+		CHECK_U32X4(cmpgt_f32x4(a, b), TEST_MASK(test_fa[i] > test_fb[i]));
+		CHECK_U32X4(cmpge_f32x4(a, b), TEST_MASK(test_fa[i] >= test_fb[i]));
+		CHECK_U32X4(cmplt_f32x4(a, b), TEST_MASK(test_fa[i] < test_fb[i]));
+		CHECK_U32X4(cmple_f32x4(a, b), TEST_MASK(test_fa[i] <= test_fb[i]));
+
+		CHECK_U32X4(trunc_f32x4(a), (s32) truncf(test_fa[i]));
+		CHECK_U32X4(round_f32x4(a), (s32) rintf(test_fa[i]));
+		CHECK_U32X4(floor_f32x4(a), (s32) floorf(test_fa[i]));
+		CHECK_U32X4(ceil_f32x4(a), (s32) ceilf(test_fa[i]));
+		CHECK_F32X4(s32x4_to_f32x4(x), (f32) (s32) test_ua[i]);
+		CHECK_U32X4(f32x4_to_bits(bits_to_f32x4(x)), test_ua[i]);
+
+		CHECK_U32X4(add_u32x4(x, y), test_ua[i] + test_ub[i]);
+		CHECK_U32X4(sub_u32x4(x, y), test_ua[i] - test_ub[i]);
+		CHECK_U32X4(mul_u32x4(x, y), test_ua[i] * test_ub[i]);
+		CHECK_U32X4(and_u32x4(x, y), test_ua[i] & test_ub[i]);
+		CHECK_U32X4(or_u32x4(x, y), test_ua[i] | test_ub[i]);
+		CHECK_U32X4(xor_u32x4(x, y), test_ua[i] ^ test_ub[i]);
+		CHECK_U32X4(andnot_u32x4(x, y), test_ua[i] & ~test_ub[i]);
+		CHECK_U32X4(sll_u32x4(x, n), test_ua[i] << n);
+		CHECK_U32X4(srl_u32x4(x, n), test_ua[i] >> n);
+		CHECK_U32X4(sra_u32x4(x, n), test_ua[i] >> 31 ? ~(~test_ua[i] >> n) : test_ua[i] >> n);
+		CHECK_U32X4(min_u32x4(x, y), test_ua[i] < test_ub[i] ? test_ua[i] : test_ub[i]);
+		CHECK_U32X4(max_u32x4(x, y), test_ua[i] > test_ub[i] ? test_ua[i] : test_ub[i]);
+		CHECK_U32X4(clamp_u32x4(x, set1_u32x4(1000), set1_u32x4(0x80000000u)),
+			test_ua[i] < 1000 ? 1000 : test_ua[i] > 0x80000000u ? 0x80000000u : test_ua[i]);
+		CHECK_U32X4(cmpeq_u32x4(x, y), TEST_MASK(test_ua[i] == test_ub[i]));
+		CHECK_U32X4(cmpgt_u32x4(x, y), TEST_MASK(test_ua[i] > test_ub[i]));
+		CHECK_U32X4(cmplt_u32x4(x, y), TEST_MASK(test_ua[i] < test_ub[i]));
+		CHECK_U32X4(blend_u32x4(m, x, y), (s32) test_ub[i] < 0 ? test_ua[i] : test_ub[i]);
+
+		CHECK(movemask_u32x4(m) == (test_ub[0] >> 31 | test_ub[1] >> 31 << 1 | test_ub[2] >> 31 << 2 | test_ub[3] >> 31 << 3));
+		CHECK(hadd_u32x4(x) == test_ua[0] + test_ua[1] + test_ua[2] + test_ua[3]);
+		sum = (f64) test_fa[0] + test_fa[1] + test_fa[2] + test_fa[3];
+		CHECKF(fabs(hadd_f32x4(a) - sum) <= (fabs(test_fa[0]) + fabs(test_fa[1]) + fabs(test_fa[2]) + fabs(test_fa[3])) * 1.2e-7,
+			"%.9g %.9g", hadd_f32x4(a), sum);
+		for (i = 1, af.f[0] = af.f[1] = test_fa[0]; i < 4; ++i) {
+			af.f[0] = test_fa[i] < af.f[0] ? test_fa[i] : af.f[0];
+			af.f[1] = test_fa[i] > af.f[1] ? test_fa[i] : af.f[1];
+		}
+		CHECK(hmin_f32x4(a) == af.f[0] && hmax_f32x4(a) == af.f[1]);
+		CHECK(lane0_f32x4(a) == test_fa[0] && lane0_u32x4(x) == test_ua[0]);
+	}
+
+	/* Constructors, aligned loads and stores, and the shuffles with constant
+	   lane numbers. */
+	for (i = 0; i < 4; ++i) {
+		test_fa[i] = (f32) i + .5f;
+		test_ua[i] = 0x1000u + i;
+	}
+	CHECK_F32X4(set_f32x4(.5f, 1.5f, 2.5f, 3.5f), test_fa[i]);
+	CHECK_U32X4(set_u32x4(0x1000, 0x1001, 0x1002, 0x1003), test_ua[i]);
+	CHECK_F32X4(set1_f32x4(2.5f), 2.5f);
+	CHECK_U32X4(set1_u32x4(7), 7);
+	CHECK_F32X4(zero_f32x4(), 0.f);
+	CHECK_U32X4(zero_u32x4(), 0);
+	store_f32x4(af.f, loadu_f32x4(test_fa));
+	store_u32x4(au.u, loadu_u32x4(test_ua));
+	CHECK_F32X4(load_f32x4(af.f), test_fa[i]);
+	CHECK_U32X4(load_u32x4(au.u), test_ua[i]);
+	CHECK_F32X4(shuffle_f32x4(load_f32x4(af.f), 0, 1, 2, 3), test_fa[shuffles[0][i]]);
+	CHECK_F32X4(shuffle_f32x4(load_f32x4(af.f), 3, 2, 1, 0), test_fa[shuffles[1][i]]);
+	CHECK_U32X4(shuffle_u32x4(load_u32x4(au.u), 1, 0, 3, 2), test_ua[shuffles[2][i]]);
+	CHECK_U32X4(shuffle_u32x4(load_u32x4(au.u), 2, 2, 0, 1), test_ua[shuffles[3][i]]);
+	CHECK_F32X4(splat_f32x4(load_f32x4(af.f), 2), test_fa[2]);
+	CHECK_U32X4(splat_u32x4(load_u32x4(au.u), 3), test_ua[3]);
+}
+#endif
+
+/*
+ * Approximations
+ */
+
+#if defined(_have_simd_ops_256) && defined(__AVX2__)
+# define TEST_APPROX_WIDTHS 3
+#elif defined(_have_simd_ops)
+# define TEST_APPROX_WIDTHS 2
+#else
+# define TEST_APPROX_WIDTHS 1
+#endif
+
+#if defined(_arith_sse2)
+# define TEST_FASTINVSQRT_REL 3.3e-4
+#else
+# define TEST_FASTINVSQRT_REL 1.8e-3
+#endif
+
+enum { TEST_ULP, TEST_ABS, TEST_REL };
+
+static f32 test_approx_x[TEST_ARRAY], test_approx_y[TEST_ARRAY];
+static f32 test_approx_out[3][TEST_ARRAY];
+static f64 test_approx_ref[TEST_ARRAY];
+
+static f32 test_uniform(f64 lo, f64 hi) { return (f32) (lo + (f64) (test_rand() >> 11) * (hi - lo) / 9007199254740992.); }
+
+/* Runs the scalar, f32x4 and f32x8 forms over the same input. */
+#if TEST_APPROX_WIDTHS >= 2
+# define TEST_APPROX_X4(stmt) stmt
+#else
+# define TEST_APPROX_X4(stmt)
+#endif
+#if TEST_APPROX_WIDTHS >= 3
+# define TEST_APPROX_X8(stmt) stmt
+#else
+# define TEST_APPROX_X8(stmt)
+#endif
+
+#define TEST_APPROX1(f) do { \
+	for (i = 0; i < TEST_ARRAY; ++i) \
+		test_approx_out[0][i] = f##_f32(test_approx_x[i]); \
+	TEST_APPROX_X4(for (i = 0; i < TEST_ARRAY; i += 4) \
+		storeu_f32x4(test_approx_out[1] + i, f##_f32x4(loadu_f32x4(test_approx_x + i)));) \
+	TEST_APPROX_X8(for (i = 0; i < TEST_ARRAY; i += 8) \
+		storeu_f32x8(test_approx_out[2] + i, f##_f32x8(loadu_f32x8(test_approx_x + i)));) \
+} while (0)
+
+#define TEST_APPROX2(f) do { \
+	for (i = 0; i < TEST_ARRAY; ++i) \
+		test_approx_out[0][i] = f##_f32(test_approx_x[i], test_approx_y[i]); \
+	TEST_APPROX_X4(for (i = 0; i < TEST_ARRAY; i += 4) \
+		storeu_f32x4(test_approx_out[1] + i, f##_f32x4(loadu_f32x4(test_approx_x + i), loadu_f32x4(test_approx_y + i)));) \
+	TEST_APPROX_X8(for (i = 0; i < TEST_ARRAY; i += 8) \
+		storeu_f32x8(test_approx_out[2] + i, f##_f32x8(loadu_f32x8(test_approx_x + i), loadu_f32x8(test_approx_y + i)));) \
+} while (0)
+
+/* Error against the double precision result, in units in the last place of
+   the f32 nearest to it, absolute or relative. Where the result is zero the
+   error is absolute. */
+static void test_approx_check(const char *name, int kind, f64 bound) {
+	static const char *const widths[] = { "f32", "f32x4", "f32x8" };
+	int w, e;
+	size_t i;
+	for (w = 0; w < TEST_APPROX_WIDTHS; ++w)
+		for (i = 0; i < TEST_ARRAY; ++i) {
+			f64 ref = test_approx_ref[i];
+			f64 err = fabs((f64) test_approx_out[w][i] - ref);
+			if (kind == TEST_ULP && ref != 0.) {
+				frexp(ref, &e);
+				err = ldexp(err, 24 - e);
+			} else if (kind == TEST_REL && ref != 0.)
+				err /= fabs(ref);
+			CHECKF(err <= bound, "%s_%s %.9g %.9g err %.3g", name, widths[w], test_approx_x[i], test_approx_y[i], err);
+		}
+}
+
+static void test_approx(void) {
+	size_t i;
+	int k;
+	test_section = "approx";
+
+	for (k = 0; k < TEST_ITERS; k += TEST_ARRAY) {
+		for (i = 0; i < TEST_ARRAY; ++i)
+			test_approx_x[i] = test_uniform(-PI, PI);
+		for (i = 0; i < TEST_ARRAY; ++i)
+			test_approx_ref[i] = sin(test_approx_x[i]);
+		TEST_APPROX1(sin);
+		test_approx_check("sin", TEST_ULP, 1.5);
+		for (i = 0; i < TEST_ARRAY; ++i)
+			test_approx_ref[i] = cos(test_approx_x[i]);
+		TEST_APPROX1(cos);
+		test_approx_check("cos", TEST_ULP, 1.5);
+
+		for (i = 0; i < TEST_ARRAY; ++i) {
+			test_approx_x[i] = test_uniform(-8192., 8192.);
+			test_approx_ref[i] = sin(test_approx_x[i]);
+		}
+		TEST_APPROX1(sin);
+		test_approx_check("sin", TEST_ABS, 9e-8);
+		TEST_APPROX1(fastsin);
+		test_approx_check("fastsin", TEST_ABS, 1.4e-5);
+		for (i = 0; i < TEST_ARRAY; ++i)
+			test_approx_ref[i] = cos(test_approx_x[i]);
+		TEST_APPROX1(cos);
+		test_approx_check("cos", TEST_ABS, 9e-8);
+		TEST_APPROX1(fastcos);
+		test_approx_check("fastcos", TEST_ABS, 1.4e-5);
+
+		for (i = 0; i < TEST_ARRAY; ++i) {
+			test_approx_x[i] = test_uniform(-126., 126.);
+			test_approx_ref[i] = exp2(test_approx_x[i]);
+		}
+		TEST_APPROX1(exp2);
+		test_approx_check("exp2", TEST_ULP, 1.2);
+		TEST_APPROX1(fastexp2);
+		test_approx_check("fastexp2", TEST_REL, 1.1e-4);
+		for (i = 0; i < TEST_ARRAY; ++i) {
+			test_approx_x[i] = test_uniform(-87., 88.);
+			test_approx_ref[i] = exp(test_approx_x[i]);
+		}
+		TEST_APPROX1(exp);
+		test_approx_check("exp", TEST_ULP, 1.2);
+		TEST_APPROX1(fastexp);
+		test_approx_check("fastexp", TEST_REL, 1.1e-4);
+
+		/* Logarithms over every normal exponent, then around 1. */
+		for (i = 0; i < TEST_ARRAY; ++i) {
+			test_approx_x[i] = (f32) exp2(test_uniform(-126., 128.));
+			test_approx_ref[i] = log2(test_approx_x[i]);
+		}
+		TEST_APPROX1(flog2);
+		test_approx_check("flog2", TEST_ULP, 2.);
+		TEST_APPROX1(fastflog2);
+		test_approx_check("fastflog2", TEST_ABS, 3.5e-5);
+		for (i = 0; i < TEST_ARRAY; ++i)
+			test_approx_ref[i] = log(test_approx_x[i]);
+		TEST_APPROX1(log);
+		test_approx_check("log", TEST_ULP, 2.);
+		TEST_APPROX1(fastlog);
+		test_approx_check("fastlog", TEST_ABS, 3.5e-5);
+		for (i = 0; i < TEST_ARRAY; ++i) {
+			test_approx_x[i] = test_uniform(.5, 2.);
+			test_approx_ref[i] = log2(test_approx_x[i]);
+		}
+		TEST_APPROX1(flog2);
+		test_approx_check("flog2", TEST_ABS, 1e-7);
+		for (i = 0; i < TEST_ARRAY; ++i)
+			test_approx_ref[i] = log(test_approx_x[i]);
+		TEST_APPROX1(log);
+		test_approx_check("log", TEST_ABS, 1e-7);
+
+		for (i = 0; i < TEST_ARRAY; ++i) {
+			test_approx_x[i] = (f32) exp2(test_uniform(-126., 128.));
+			test_approx_ref[i] = 1. / sqrt(test_approx_x[i]);
+		}
+		TEST_APPROX1(invsqrt);
+		test_approx_check("invsqrt", TEST_ULP, 5.);
+		TEST_APPROX1(fastinvsqrt);
+		test_approx_check("fastinvsqrt", TEST_REL, TEST_FASTINVSQRT_REL);
+
+		/* atan2(y, x) takes y first; the quadrant comes from both signs,
+		   including those of zero. */
+		for (i = 0; i < TEST_ARRAY; ++i) {
+			test_approx_x[i] = i % 64 == 0 ? (i & 64 ? -0.f : 0.f) : test_uniform(-1., 1.);
+			test_approx_y[i] = i % 64 == 32 ? (i & 64 ? -0.f : 0.f) : test_uniform(-1., 1.) * (f32) (i & 1 ? 1e-3 : 1.);
+			test_approx_ref[i] = atan2(test_approx_x[i], test_approx_y[i]);
+		}
+		TEST_APPROX2(atan2);
+		test_approx_check("atan2", TEST_ULP, 2.3);
+		TEST_APPROX2(fastatan2);
+		test_approx_check("fastatan2", TEST_REL, 2.6e-4);
+
+		for (i = 0; i < TEST_ARRAY; ++i) {
+			f64 l;
+			test_approx_x[i] = (f32) exp2(test_uniform(-64., 64.));
+			l = fabs(log2(test_approx_x[i]));
+			test_approx_y[i] = test_uniform(-1., 1.) * (f32) (l * 16. > 33. ? 33. / l : 16.);
+			test_approx_ref[i] = pow(test_approx_x[i], test_approx_y[i]);
+		}
+		TEST_APPROX2(pow);
+		test_approx_check("pow", TEST_REL, 2.8e-6);
+		TEST_APPROX2(fastpow);
+		test_approx_check("fastpow", TEST_REL, 4.4e-4);
+	}
+}
+
+/*
+ * Bitsets
+ */
+
+/* Random words, sparse and dense ones, and runs of empty words with a bit
+   here and there to stretch the distance between select samples. */
+static void test_bits(u64 *b, size_t words, int density) {
+	size_t i;
+	for (i = 0; i < words; ++i)
+		switch (density) {
+		case 0: b[i] = test_rand(); break;
+		case 1: b[i] = test_rand() & test_rand() & test_rand(); break;
+		case 2: b[i] = test_rand() | test_rand() | test_rand(); break;
+		default: b[i] = test_below(97) == 0 ? imm_u64(1) << test_below(64) : 0; break;
+		}
+}
+
+static void test_bitset(void) {
+	static u64 x[TEST_ARRAY], y[TEST_ARRAY], dst[TEST_ARRAY], ref[TEST_ARRAY];
+	static u32 pos[TEST_ARRAY * 64], got[TEST_ARRAY * 64];
+	static u64 big[1 << 16];
+	struct bitset_index index;
+	struct bitset_iter it;
+	size_t c, i, j, n, words;
+	int d, op;
+	test_section = "bitset";
+
+	for (i = 0; i < TEST_ITERS; ++i) {
+		u64 v = test_u64();
+		u32 k = 0;
+		if (v == 0)
+			continue;
+		n = test_below(popcount_u64(v));
+		for (j = 0; j < 64; ++j)
+			if ((v >> j & 1) != 0 && k++ == n)
+				break;
+		CHECKF(nthbit_u64(v, (u32) n) == j, "%#llx %u", (unsigned long long) v, (unsigned) n);
+	}
+
+	for (c = 0; c < countof(test_counts); ++c)
+		for (d = 0; d < 4; ++d) {
+			size_t ones = 0, r = 0;
+			words = test_counts[c];
+			test_bits(x, words, d);
+			test_bits(y, words, (d + 1) & 3);
+			for (i = 0; i < words; ++i)
+				ones += ref_popcount_u64(x[i]);
+			CHECKF(bitset_count(x, words) == ones, "n=%u", (unsigned) words);
+
+			for (op = 0; op < 5; ++op) {
+				size_t rc = 0, cnt = 0;
+				for (i = 0; i < words; ++i) {
+					ref[i] = op == 1 ? x[i] | y[i] : op == 2 ? x[i] ^ y[i] : op == 3 ? x[i] & ~y[i] : x[i] & y[i];
+					rc += ref_popcount_u64(ref[i]);
+				}
+				memcpy(dst, x, words * 8);
+				switch (op) {
+				case 0: cnt = bitset_and(dst, dst, y, words); break;
+				case 1: cnt = bitset_or(dst, dst, y, words); break;
+				case 2: cnt = bitset_xor(dst, dst, y, words); break;
+				case 3: cnt = bitset_andnot(dst, dst, y, words); break;
+				default: cnt = bitset_and_count(x, y, words); break;
+				}
+				CHECKF(cnt == rc && memcmp(dst, op < 4 ? ref : x, words * 8) == 0, "n=%u op=%d", (unsigned) words, op);
+			}
+
+			bitset_iter_init(&it, x, words);
+			for (i = 0, n = 0; i < words * 64; ++i)
+				if (bitset_test(x, i)) {
+					CHECKF(bitset_iter_next(&it, &j) && j == i, "n=%u %u", (unsigned) words, (unsigned) i);
+					pos[n++] = (u32) i;
+				}
+			CHECK(!bitset_iter_next(&it, &j));
+			CHECKF(bitset_extract(got, x, words, 5) == n, "n=%u", (unsigned) words);
+			for (i = 0; i < n; ++i)
+				CHECKF(got[i] == pos[i] + 5, "n=%u %u", (unsigned) words, (unsigned) i);
+
+			for (i = 0, j = 0; i <= words * 64 + 1; i += 1 + test_below(70)) {
+				while (j < n && pos[j] < i)
+					++j;
+				CHECKF(bitset_next(x, words, i) == (j < n ? pos[j] : words * 64), "n=%u %u", (unsigned) words, (unsigned) i);
+			}
+
+			if (!bitset_index_init(&index, x, words)) {
+				CHECK(!"bitset_index_init");
+				continue;
+			}
+			CHECK(bitset_index_count(&index) == ones);
+			for (i = 0; i <= words * 64; ++i) {
+				CHECKF(bitset_rank(&index, i) == r, "n=%u %u", (unsigned) words, (unsigned) i);
+				if (i < words * 64 && bitset_test(x, i))
+					++r;
+			}
+			for (j = 0; j < n; ++j)
+				CHECKF(bitset_select(&index, j) == pos[j], "n=%u %u", (unsigned) words, (unsigned) j);
+			CHECK(bitset_select(&index, n) == words * 64);
+			bitset_index_free(&index);
+		}
+
+	/* Bits set, cleared and flipped one at a time. */
+	memset(x, 0, sizeof x);
+	memset(y, 0, sizeof y);
+	for (i = 0; i < TEST_ITERS; ++i) {
+		size_t k = test_below(TEST_ARRAY * 64);
+		u64 m = imm_u64(1) << (k % 64);
+		bool v = (test_rand() & 1) != 0;
+		switch (i % 4) {
+		case 0: bitset_set(x, k); y[k / 64] |= m; break;
+		case 1: bitset_clear(x, k); y[k / 64] &= ~m; break;
+		case 2: bitset_flip(x, k); y[k / 64] ^= m; break;
+		default: bitset_assign(x, k, v); y[k / 64] = v ? y[k / 64] | m : y[k / 64] & ~m; break;
+		}
+		CHECK(bitset_test(x, k) == ((y[k / 64] & m) != 0));
+	}
+	CHECK(memcmp(x, y, sizeof x) == 0);
+
+	/* Long empty stretches between samples in the second half. */
+	memset(big, 0, sizeof big);
+	for (i = 0, n = 0; i < countof(big) * 64; i += 1 + test_below(i < countof(big) * 32 ? 100 : 100000), ++n)
+		bitset_set(big, i);
+	if (bitset_index_init(&index, big, countof(big))) {
+		CHECK(bitset_index_count(&index) == n && bitset_count(big, countof(big)) == n);
+		for (i = 0, j = 0; i < countof(big) * 64; ++i)
+			if (bitset_test(big, i)) {
+				CHECKF(bitset_select(&index, j) == i && bitset_rank(&index, i) == j, "%u", (unsigned) i);
+				++j;
+			}
+		bitset_index_free(&index);
+	} else
+		CHECK(!"bitset_index_init");
+}
+
+/*
+ * Byte order
+ */
+
+static u64 ref_byteswap(u64 v, unsigned size) {
+	u64 r = 0;
+	unsigned i;
+	for (i = 0; i < size; ++i)
+		r |= (v >> (8 * i) & 0xff) << (8 * (size - 1 - i));
+	return r;
+}
+
+static void test_endian(void) {
+	static u8 src[TEST_ARRAY * 8 + 8], dst[TEST_ARRAY * 8 + 8];
+	size_t c, i;
+	int k;
+	test_section = "endian";
+
+	for (k = 0; k < TEST_ITERS; ++k) {
+		u64 v = test_u64();
+		u8 b[8], r[8];
+		u64 be = 0, le = 0;
+		CHECK(_byteswap16((u16) v) == ref_byteswap(v & 0xffff, 2));
+		CHECK(_byteswap32((u32) v) == ref_byteswap(v & 0xffffffff, 4));
+		CHECK(_byteswap64(v) == ref_byteswap(v, 8));
+
+		for (i = 0; i < 8; ++i) {
+			b[i] = (u8) test_rand();
+			be = be << 8 | b[i];
+			le |= (u64) b[i] << (8 * i);
+		}
+		CHECK(_load_be16(b) == be >> 48 && _load_le16(b) == (u16) le);
+		CHECK(_load_be32(b) == be >> 32 && _load_le32(b) == (u32) le);
+		CHECK(_load_be64(b) == be && _load_le64(b) == le);
+		_store_be64(r, be);
+		CHECK(memcmp(r, b, 8) == 0);
+		_store_le64(r, le);
+		CHECK(memcmp(r, b, 8) == 0);
+		_store_be32(r, (u32) (be >> 32));
+		CHECK(memcmp(r, b, 4) == 0);
+		_store_le32(r, (u32) le);
+		CHECK(memcmp(r, b, 4) == 0);
+		_store_be16(r, (u16) (be >> 48));
+		CHECK(memcmp(r, b, 2) == 0);
+		_store_le16(r, (u16) le);
+		CHECK(memcmp(r, b, 2) == 0);
+	}
+
+	/* Unaligned out-of-place, then in place. */
+	for (c = 0; c < countof(test_counts); ++c) {
+		size_t n = test_counts[c], off = test_below(8);
+		u32 t32;
+		u64 t64;
+		test_fill(src, sizeof src);
+
+		_byteswap16_array(dst + off, src + off, n);
+		for (i = 0; i < n; ++i)
+			CHECK(_load_le16(dst + off + 2 * i) == _load_be16(src + off + 2 * i));
+		_byteswap32_array(dst + off, src + off, n);
+		for (i = 0; i < n; ++i)
+			CHECKF(_load_le32(dst + off + 4 * i) == _load_be32(src + off + 4 * i), "n=%u i=%u", (unsigned) n, (unsigned) i);
+		_byteswap64_array(dst + off, src + off, n);
+		for (i = 0; i < n; ++i)
+			CHECKF(_load_le64(dst + off + 8 * i) == _load_be64(src + off + 8 * i), "n=%u i=%u", (unsigned) n, (unsigned) i);
+
+		memcpy(dst, src, sizeof src);
+		_byteswap32_array(dst, dst, n);
+		for (i = 0; i < n; ++i)
+			CHECK(_load_le32(dst + 4 * i) == _load_be32(src + 4 * i));
+		memcpy(dst, src, sizeof src);
+		_byteswap64_array(dst, dst, n);
+		for (i = 0; i < n; ++i)
+			CHECK(_load_le64(dst + 8 * i) == _load_be64(src + 8 * i));
+
+		_ltoh32_array(dst, src, n);
+		for (i = 0; i < n; ++i) {
+			memcpy(&t32, dst + 4 * i, 4);
+			CHECK(t32 == _load_le32(src + 4 * i));
+		}
+		_btoh64_array(dst, src, n);
+		for (i = 0; i < n; ++i) {
+			memcpy(&t64, dst + 8 * i, 8);
+			CHECK(t64 == _load_be64(src + 8 * i));
+		}
+	}
+}
+
+/*
+ * Byte and bit streams
+ */
+
+enum {
+	TEST_BS_U8, TEST_BS_U16LE, TEST_BS_U32LE, TEST_BS_U64LE, TEST_BS_U16BE, TEST_BS_U32BE, TEST_BS_U64BE,
+	TEST_BS_S8, TEST_BS_S16BE, TEST_BS_S32LE, TEST_BS_S64BE, TEST_BS_F32LE, TEST_BS_F64BE,
+	TEST_BS_BYTES, TEST_BS_SPAN, TEST_BS_COUNT
+};
+
+struct test_bs_op {
+	int kind;
+	u32 size;
+	u64 value;
+	u8 bytes[12];
+};
+
+static u32 test_bs_size(const struct test_bs_op *op) {
+	static const u8 sizes[TEST_BS_BYTES] = { 1, 2, 4, 8, 2, 4, 8, 1, 2, 4, 8, 4, 8 };
+	return op->kind < TEST_BS_BYTES ? sizes[op->kind] : op->size;
+}
+
+static bool test_bs_be(int kind) {
+	return kind == TEST_BS_U16BE || kind == TEST_BS_U32BE || kind == TEST_BS_U64BE ||
+		kind == TEST_BS_S16BE || kind == TEST_BS_S64BE || kind == TEST_BS_F64BE;
+}
+
+/* The bytes one op should leave, one at a time. */
+static void ref_bs_put(u8 *p, const struct test_bs_op *op) {
+	u32 n = test_bs_size(op), i;
+	if (op->kind >= TEST_BS_BYTES)
+		memcpy(p, op->bytes, n);
+	else
+		for (i = 0; i < n; ++i)
+			p[test_bs_be(op->kind) ? n - 1 - i : i] = (u8) (op->value >> (8 * i));
+}
+
+static void test_bs_write(struct bytewriter *w, const struct test_bs_op *op) {
+	f32 f;
+	f64 d;
+	u32 u;
+	void *p;
+	switch (op->kind) {
+	case TEST_BS_U8: write_u8(w, (u8) op->value); break;
+	case TEST_BS_U16LE: write_u16_le(w, (u16) op->value); break;
+	case TEST_BS_U32LE: write_u32_le(w, (u32) op->value); break;
+	case TEST_BS_U64LE: write_u64_le(w, op->value); break;
+	case TEST_BS_U16BE: write_u16_be(w, (u16) op->value); break;
+	case TEST_BS_U32BE: write_u32_be(w, (u32) op->value); break;
+	case TEST_BS_U64BE: write_u64_be(w, op->value); break;
+	case TEST_BS_S8: write_s8(w, (s8) op->value); break;
+	case TEST_BS_S16BE: write_s16_be(w, (s16) op->value); break;
+	case TEST_BS_S32LE: write_s32_le(w, (s32) op->value); break;
+	case TEST_BS_S64BE: write_s64_be(w, (s64) op->value); break;
+	case TEST_BS_F32LE: u = (u32) op->value; memcpy(&f, &u, 4); write_f32_le(w, f); break;
+	case TEST_BS_F64BE: memcpy(&d, &op->value, 8); write_f64_be(w, d); break;
+	case TEST_BS_BYTES: write_bytes(w, op->bytes, op->size); break;
+	default:
+		if ((p = write_reserve(w, op->size)) != NULL)
+			memcpy(p, op->bytes, op->size);
+	}
+}
+
+/* Reads back one op and returns whether it gave what was written, or zeros
+   where fail is set. */
+static bool test_bs_read(struct bytereader *r, const struct test_bs_op *op, bool fail) {
+	static const u8 zeros[12];
+	u64 v = fail ? 0 : op->value, w;
+	u8 buf[12];
+	const void *p;
+	f32 f;
+	f64 d;
+	switch (op->kind) {
+	case TEST_BS_U8: return read_u8(r) == (u8) v;
+	case TEST_BS_U16LE: return read_u16_le(r) == (u16) v;
+	case TEST_BS_U32LE: return read_u32_le(r) == (u32) v;
+	case TEST_BS_U64LE: return read_u64_le(r) == v;
+	case TEST_BS_U16BE: return read_u16_be(r) == (u16) v;
+	case TEST_BS_U32BE: return read_u32_be(r) == (u32) v;
+	case TEST_BS_U64BE: return read_u64_be(r) == v;
+	case TEST_BS_S8: return read_s8(r) == (s8) v;
+	case TEST_BS_S16BE: return read_s16_be(r) == (s16) v;
+	case TEST_BS_S32LE: return read_s32_le(r) == (s32) v;
+	case TEST_BS_S64BE: return read_s64_be(r) == (s64) v;
+	case TEST_BS_F32LE: f = read_f32_le(r); memcpy(&w, &f, 4); return (u32) w == (u32) v;
+	case TEST_BS_F64BE: d = read_f64_be(r); memcpy(&w, &d, 8); return w == v;
+	case TEST_BS_BYTES:
+		read_bytes(r, buf, op->size);
+		return memcmp(buf, fail ? zeros : op->bytes, op->size) == 0;
+	default:
+		if ((op->size & 1) != 0) {
+			read_skip(r, op->size);
+			return true;
+		}
+		p = read_span(r, op->size);
+		return fail ? p == NULL : p != NULL && memcmp(p, op->bytes, op->size) == 0;
+	}
+}
+
+static void test_bytestream(void) {
+	enum { OPS = 24, CAP = 128 };
+	static struct test_bs_op ops[OPS];
+	static u8 buf[CAP + 16], expect[CAP + 16];
+	int k;
+	test_section = "bytestream";
+
+	for (k = 0; k < TEST_ITERS / 10; ++k) {
+		size_t size = test_below(k & 1 ? CAP : 24), pos = 0, rsize, i;
+		u32 nops = 1 + test_below(OPS), j;
+		struct bytewriter w;
+		struct bytereader r;
+		bool err = false, ok = true;
+
+		for (j = 0; j < nops; ++j) {
+			ops[j].kind = (int) test_below(TEST_BS_COUNT);
+			ops[j].size = test_below(13);
+			ops[j].value = test_u64();
+			if (ops[j].kind == TEST_BS_F32LE || ops[j].kind == TEST_BS_F64BE)
+				ops[j].value &= ~(imm_u64(1) << (ops[j].kind == TEST_BS_F32LE ? 30 : 62));
+			test_fill(ops[j].bytes, sizeof ops[j].bytes);
+		}
+
+		/* Writes stop at the end with the flag set and nothing past it;
+		   a later write that fits is dropped all the same. */
+		memset(buf, 0xa5, sizeof buf);
+		memset(expect, 0xa5, sizeof expect);
+		bytewriter_init(&w, buf, size);
+		for (j = 0; j < nops; ++j) {
+			u32 n = test_bs_size(&ops[j]);
+			test_bs_write(&w, &ops[j]);
+			if (size - pos < n) {
+				pos = size;
+				err = true;
+			} else {
+				ref_bs_put(expect + pos, &ops[j]);
+				pos += n;
+			}
+			ok &= bytewriter_size(&w) == pos && bytewriter_remaining(&w) == size - pos && bytewriter_ok(&w) == !err;
+		}
+		CHECKF(ok, "size=%u ops=%u", (unsigned) size, nops);
+		CHECKF(memcmp(buf, expect, sizeof buf) == 0, "size=%u ops=%u", (unsigned) size, nops);
+
+		/* Read back from what was written, cut short now and then. The
+		   first overrun moves the cursor to the end, so reads after it give
+		   zeros, and skips and spans of zero bytes still succeed. */
+		rsize = k & 2 ? test_below((u32) pos + 1) : pos;
+		bytereader_init(&r, buf, rsize);
+		for (j = 0, i = 0, err = false; j < nops; ++j) {
+			u32 n = test_bs_size(&ops[j]);
+			bool fail = rsize - i < n;
+			if (fail) {
+				i = rsize;
+				err = true;
+			} else
+				i += n;
+			ok &= test_bs_read(&r, &ops[j], fail) && bytereader_remaining(&r) == rsize - i && bytereader_ok(&r) == !err;
+		}
+		CHECKF(ok, "size=%u ops=%u read %u", (unsigned) size, nops, (unsigned) rsize);
+	}
+}
+
+/* Naive bit-at-a-time streams. LSB order fills each byte from bit 0 and
+   takes fields low bit first, MSB order fills from bit 7 and takes fields
+   high bit first. Bits past the end read as zero. */
+static void ref_bits_put(u8 *p, size_t pos, u64 v, u32 n, bool msb) {
+	u32 i;
+	for (i = 0; i < n; ++i, ++pos) {
+		u32 bit = (u32) (v >> (msb ? n - 1 - i : i)) & 1;
+		p[pos >> 3] |= (u8) (bit << (msb ? 7 - (pos & 7) : pos & 7));
+	}
+}
+
+static u64 ref_bits_get(const u8 *p, size_t size, size_t pos, u32 n, bool msb) {
+	u64 v = 0;
+	u32 i;
+	for (i = 0; i < n; ++i, ++pos) {
+		u64 bit = (pos >> 3) < size ? (u64) (p[pos >> 3] >> (msb ? 7 - (pos & 7) : pos & 7)) & 1 : 0;
+		v |= bit << (msb ? n - 1 - i : i);
+	}
+	return v;
+}
+
+static void test_bitstream(void) {
+	enum { CAP = 160 };
+	static u8 buf[CAP + 16], expect[64 * 8];
+	static u32 widths[64];
+	static u64 values[64];
+	int k;
+	test_section = "bitstream";
+
+	for (k = 0; k < TEST_ITERS / 10; ++k) {
+		bool msb = (k & 1) != 0;
+		u32 nfields = 1 + test_below(64), j, n;
+		size_t size = test_below(CAP), pos = 0, bytes, written;
+		struct bitwriter w;
+		struct bitreader r;
+		bool ok = true;
+		u64 v, rev;
+
+		for (j = 0; j < nfields; ++j) {
+			widths[j] = k & 2 ? 1 + test_below(BITSTREAM_MAX_WRITE) : 1 + test_below(12);
+			values[j] = test_u64() & (~imm_u64(0) >> (64 - widths[j]));
+		}
+
+		/* Writes both ways against the naive writer; past the end the
+		   writer stores what fits and sets the flag. */
+		memset(buf, 0xa5, sizeof buf);
+		memset(expect, 0, sizeof expect);
+		bitwriter_init(&w, buf, size);
+		for (j = 0; j < nfields; ++j) {
+			if (msb)
+				bits_write_msb(&w, values[j], widths[j]);
+			else
+				bits_write_lsb(&w, values[j], widths[j]);
+			ref_bits_put(expect, pos, values[j], widths[j], msb);
+			pos += widths[j];
+		}
+		written = msb ? bitwriter_finish_msb(&w) : bitwriter_finish_lsb(&w);
+		bytes = (pos + 7) >> 3;
+		CHECKF(bitwriter_ok(&w) == (bytes <= size) && written == (bytes <= size ? bytes : size),
+			"msb=%d size=%u bytes=%u written=%u", msb, (unsigned) size, (unsigned) bytes, (unsigned) written);
+		CHECKF(memcmp(buf, expect, written) == 0, "msb=%d size=%u", msb, (unsigned) size);
+		for (j = (u32) size; j < sizeof buf; ++j)
+			ok &= buf[j] == 0xa5;
+		CHECKF(ok, "msb=%d wrote past %u bytes", msb, (unsigned) size);
+		ok = true;
+
+		/* Reads random bytes in either order, field by field, by peeking
+		   after a refill, and across byte alignment, past the end too. */
+		test_fill(buf, sizeof buf);
+		size = test_below(CAP);
+		bitreader_init(&r, buf, size);
+		for (j = 0, pos = 0; j < nfields; ++j) {
+			n = k & 2 ? 1 + test_below(BITSTREAM_MAX_READ) : widths[j];
+			switch (test_below(8)) {
+			case 0:
+				if (msb)
+					bitreader_refill_msb(&r);
+				else
+					bitreader_refill_lsb(&r);
+				v = msb ? bits_peek_msb(&r, n) : bits_peek_lsb(&r, n);
+				ok &= v == ref_bits_get(buf, size, pos, n, msb);
+				n = 1 + test_below(n);
+				if (msb)
+					bits_consume_msb(&r, n);
+				else
+					bits_consume_lsb(&r, n);
+				break;
+			case 1:
+				bitreader_align(&r);
+				pos = (pos + 7) & ~(size_t) 7;
+				n = 0;
+				break;
+			default:
+				v = msb ? bits_read_msb(&r, n) : bits_read_lsb(&r, n);
+				ok &= v == ref_bits_get(buf, size, pos, n, msb);
+			}
+			pos += n;
+			ok &= bitreader_tell(&r) == pos && bitreader_ok(&r) == (pos <= size * 8);
+		}
+		CHECKF(ok, "msb=%d size=%u fields=%u", msb, (unsigned) size, nfields);
+
+		v = test_u64() & (~imm_u64(0) >> test_below(64));
+		n = 64 - clz_u64(v | 1) + test_below(8);
+		n = n > 64 ? 64 : n;
+		for (j = 0, rev = 0; j < n; ++j)
+			rev |= (v >> j & 1) << (n - 1 - j);
+		CHECKF(bitstream_bitreverse(v, n) == rev, "%#llx %u", (unsigned long long) v, n);
+		CHECK(bitstream_bitreverse(v, 0) == 0);
+	}
+}
+
+/*
+ * Strings
+ */
+
+static int ref_lower(int c) { return c >= 'A' && c <= 'Z' ? c + 32 : c; }
+
+static int ref_memcasecmp(const void *s1, const void *s2, size_t n) {
+	const u8 *a = (const u8 *) s1, *b = (const u8 *) s2;
+	size_t i;
+	for (i = 0; i < n; ++i)
+		if (ref_lower(a[i]) != ref_lower(b[i]))
+			return ref_lower(a[i]) - ref_lower(b[i]);
+	return 0;
+}
+
+static size_t ref_find(const char *h, size_t hn, const char *n, size_t nn, bool nocase) {
+	size_t i;
+	for (i = 0; i + nn <= hn; ++i)
+		if (nocase ? ref_memcasecmp(h + i, n, nn) == 0 : memcmp(h + i, n, nn) == 0)
+			return i;
+	return STRVIEW_NPOS;
+}
+
+static bool ref_space(int c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+/* Few distinct letters in both cases, so that random strings match often. */
+static void test_text(char *dst, size_t size) {
+	static const char alphabet[] = "aAbBzZ@[`{ \t\x80\xff";
+	size_t i;
+	for (i = 0; i < size; ++i)
+		dst[i] = alphabet[test_below(sizeof alphabet - 1)];
+}
+
+static void test_strings_compare(void) {
+	static char a[512], b[512];
+	int k;
+	test_section = "strings/compare";
+
+	for (k = 0; k < TEST_ITERS / 4; ++k) {
+		size_t n = test_below(k & 1 ? 300 : 40), m, i;
+		test_text(a, n);
+		for (i = 0; i < n; ++i)
+			b[i] = (char) (test_below(2) && (a[i] | 32) >= 'a' && (a[i] | 32) <= 'z' ? a[i] ^ 32 : a[i]);
+		if (n > 0 && test_below(2))
+			b[test_below((u32) n)] = "aZ\x80 "[test_below(4)];
+
+		CHECKF(test_sign(_memcasecmp(a, b, n)) == test_sign(ref_memcasecmp(a, b, n)), "n=%u", (unsigned) n);
+		CHECK(strview_caseeq(strview_make(a, n), strview_make(b, n)) == (ref_memcasecmp(a, b, n) == 0));
+
+		/* Terminated forms stop at the first NUL. */
+		m = test_below((u32) n + 1);
+		a[n] = b[n] = 0;
+		if (m < n)
+			a[m] = b[m] = 0;
+		CHECK(test_sign(_strcasecmp(a, b)) == test_sign(ref_memcasecmp(a, b, m < n ? m + 1 : n + 1)));
+		CHECK(test_sign(_strncasecmp(a, b, m)) == test_sign(ref_memcasecmp(a, b, m)));
+
+		{
+			size_t na = test_below((u32) n + 1), nb = test_below((u32) n + 1), l = na < nb ? na : nb;
+			int r = memcmp(a, b, l), rc = ref_memcasecmp(a, b, l);
+			int ref = r != 0 ? r : (na > nb) - (na < nb);
+			int refc = rc != 0 ? rc : (na > nb) - (na < nb);
+			CHECK(test_sign(strview_cmp(strview_make(a, na), strview_make(b, nb))) == test_sign(ref));
+			CHECK(test_sign(strview_casecmp(strview_make(a, na), strview_make(b, nb))) == test_sign(refc));
+			CHECK(strview_prefix(strview_make(a, na), strview_make(b, nb)) == (nb <= na && memcmp(a, b, nb) == 0));
+			CHECK(strview_caseprefix(strview_make(a, na), strview_make(b, nb)) == (nb <= na && ref_memcasecmp(a, b, nb) == 0));
+			CHECK(strview_suffix(strview_make(a, na), strview_make(b + nb - l, l)) == (memcmp(a + na - l, b + nb - l, l) == 0));
+		}
+	}
+}
+
+/* Buffers that end at an unmapped page catch scans that read too far. */
+static char *test_page;
+static size_t test_page_size;
+
+static char *test_page_end(size_t size) {
+	return test_page + test_page_size - size;
+}
+
+static void test_page_init(void) {
+#if defined(TEST_GUARD_PAGES)
+	test_page_size = (size_t) sysconf(_SC_PAGESIZE);
+	test_page = (char *) mmap(NULL, 2 * test_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (test_page != (char *) MAP_FAILED && mprotect(test_page + test_page_size, test_page_size, PROT_NONE) == 0)
+		return;
+#endif
+	test_page_size = 4096;
+	test_page = (char *) malloc(test_page_size);
+}
+
+static void test_strings_search(void) {
+	static char h[1024], nd[64];
+	size_t n, i, k;
+	int j;
+	test_section = "strings/search";
+
+	for (n = 0; n < 600; ++n) {
+		char *s = test_page_end(n + 1);
+		test_fill(s, n + 1);
+		for (i = 0; i < n; ++i)
+			s[i] |= 1;
+		s[n] = 0;
+
+		CHECKF(_strlen(s) == n, "n=%u", (unsigned) n);
+		k = test_below((u32) n + 2);
+		CHECKF(_strnlen(s, k) == (k < n ? k : n), "n=%u k=%u", (unsigned) n, (unsigned) k);
+
+		for (j = 0; j < 4; ++j) {
+			size_t len = n + 1 - test_below((u32) n + 2) / 2;
+			const char *p = test_page_end(len);
+			char c = j == 0 ? 0 : p[len ? test_below((u32) len) : 0];
+			size_t ref = STRVIEW_NPOS, rref = STRVIEW_NPOS;
+			if (j == 3)
+				c = (char) 0xfe;
+			for (i = 0; i < len; ++i) {
+				if (p[i] == c) {
+					if (ref == STRVIEW_NPOS)
+						ref = i;
+					rref = i;
+				}
+			}
+			CHECKF(_memchr(p, (u8) c, len) == (ref != STRVIEW_NPOS ? p + ref : NULL), "len=%u", (unsigned) len);
+			CHECKF(strview_findchr(strview_make(p, len), c) == ref, "len=%u", (unsigned) len);
+			CHECKF(strview_rfindchr(strview_make(p, len), c) == rref, "len=%u", (unsigned) len);
+		}
+	}
+
+	for (j = 0; j < TEST_ITERS / 10; ++j) {
+		size_t hn = test_below(j & 1 ? 1000 : 80), nn = test_below(j & 2 ? 40 : 6);
+		size_t ref, cref;
+		char *hp;
+		test_text(h, hn);
+		if (nn <= hn && test_below(4) != 0) {
+			memcpy(nd, h + test_below((u32) (hn - nn + 1)), nn);
+			for (i = 0; i < nn; ++i)
+				if (test_below(2) && (nd[i] | 32) >= 'a' && (nd[i] | 32) <= 'z')
+					nd[i] ^= 32;
+		} else {
+			test_text(nd, nn);
+		}
+
+		ref = ref_find(h, hn, nd, nn, false);
+		cref = ref_find(h, hn, nd, nn, true);
+		CHECKF(strview_find(strview_make(h, hn), strview_make(nd, nn)) == ref, "hn=%u nn=%u", (unsigned) hn, (unsigned) nn);
+		CHECKF(strview_casefind(strview_make(h, hn), strview_make(nd, nn)) == cref, "hn=%u nn=%u", (unsigned) hn, (unsigned) nn);
+		CHECKF(_memcasemem(h, hn, nd, nn) == (cref != STRVIEW_NPOS ? h + cref : NULL), "hn=%u nn=%u", (unsigned) hn, (unsigned) nn);
+
+		/* The haystack again at the end of the page, terminated. */
+		hp = test_page_end(hn + 1);
+		memcpy(hp, h, hn);
+		hp[hn] = 0;
+		for (i = 0; i < hn; ++i)
+			hp[i] |= hp[i] == 0;
+		for (i = 0; i < nn; ++i)
+			nd[i] |= nd[i] == 0;
+		nd[nn] = 0;
+		cref = ref_find(hp, hn, nd, nn, true);
+		CHECKF(_strcasestr(hp, nd) == (cref != STRVIEW_NPOS ? hp + cref : NULL), "hn=%u nn=%u", (unsigned) hn, (unsigned) nn);
+	}
+}
+
+static void test_strings_view(void) {
+	static const char alphabet[] = " \t\n\r\v\fa,Bc";
+	static char s[256], lower[256], out[300];
+	int k;
+	test_section = "strings/view";
+
+	for (k = 0; k < TEST_ITERS / 4; ++k) {
+		size_t n = test_below(k & 1 ? 200 : 12), i, b, e, tokens, start;
+		struct strview v = strview_make(s, n), t, tok;
+		struct strsplit split;
+		bool ok = true;
+
+		for (i = 0; i < n; ++i) {
+			s[i] = alphabet[test_below(sizeof alphabet - 1)];
+			lower[i] = (char) ref_lower((u8) s[i]);
+		}
+
+		for (b = 0; b < n && ref_space((u8) s[b]); ++b)
+			;
+		for (e = n; e > b && ref_space((u8) s[e - 1]); --e)
+			;
+		t = strview_trim(v);
+		CHECK(t.len == e - b && (t.len == 0 || t.ptr == s + b));
+		t = strview_ltrim(v);
+		CHECK(t.len == n - b && (t.len == 0 || t.ptr == s + b));
+		for (e = n; e > 0 && ref_space((u8) s[e - 1]); --e)
+			;
+		t = strview_rtrim(v);
+		CHECK(t.len == e && (t.len == 0 || t.ptr == s));
+
+		strsplit_init(&split, v, ',');
+		tokens = 0;
+		start = 0;
+		while (strsplit_next(&split, &tok)) {
+			for (i = start; i < n && s[i] != ','; ++i)
+				;
+			ok &= tok.len == i - start && (tok.len == 0 || tok.ptr == s + start);
+			start = i + 1;
+			++tokens;
+		}
+		for (i = 0, e = 1; i < n; ++i)
+			e += s[i] == ',';
+		CHECKF(ok && tokens == e, "n=%u tokens=%u", (unsigned) n, (unsigned) tokens);
+		CHECK(split.done && split.rest.len == 0 && !strsplit_next(&split, &tok));
+
+		CHECK(strview_hash(v) == hash64(s, n, 0));
+		CHECK(strview_casehash(v) == hash64(lower, n, 0));
+		CHECK(strview_casehash(v) == hash64_case(s, n, 0));
+
+		i = test_below(sizeof out);
+		memset(out, 0x55, sizeof out);
+		ok = strview_copy(out, i, v);
+		CHECK(ok == (n < i));
+		if (i > 0) {
+			e = n < i ? n : i - 1;
+			CHECK(memcmp(out, s, e) == 0 && out[e] == 0);
+		}
+	}
+
+	/* A view of nothing at all still holds one empty token. */
+	{
+		struct strsplit split;
+		struct strview tok;
+		size_t tokens = 0;
+		strsplit_init(&split, strview_make(NULL, 0), ',');
+		while (strsplit_next(&split, &tok))
+			tokens += tok.len == 0 ? 1 : 100;
+		CHECKF(tokens == 1, "tokens=%u", (unsigned) tokens);
+	}
+}
+
+static void test_strings_buf(void) {
+	static char ref[8192], piece[128], fixed[64];
+	struct strbuf b, f;
+	int k;
+	test_section = "strings/buf";
+
+	for (k = 0; k < 200; ++k) {
+		size_t len = 0, fsize = 1 + test_below(sizeof fixed - 1);
+		int j;
+
+		strbuf_init(&b);
+		strbuf_init_fixed(&f, fixed, fsize);
+		for (j = 0; j < 40; ++j) {
+			size_t n;
+			switch (test_below(6)) {
+			case 0:
+				n = test_below(sizeof piece);
+				test_text(piece, n);
+				strbuf_append(&b, strview_make(piece, n));
+				strbuf_append(&f, strview_make(piece, n));
+				break;
+			case 1:
+				piece[0] = (char) ('a' + test_below(26));
+				n = 1;
+				strbuf_putc(&b, piece[0]);
+				strbuf_putc(&f, piece[0]);
+				break;
+			case 2: {
+				u64 v = test_u64();
+				n = (size_t) sprintf(piece, "%llu", (unsigned long long) v);
+				strbuf_append_u64(&b, v);
+				strbuf_append_u64(&f, v);
+				break;
+			}
+			case 3: {
+				s64 v = (s64) test_u64();
+				n = (size_t) sprintf(piece, "%lld", (long long) v);
+				strbuf_append_s64(&b, v);
+				strbuf_append_s64(&f, v);
+				break;
+			}
+			case 4: {
+				f64 v = (f64) test_f32(1e9f) / 7.;
+				n = format_f64(piece, v);
+				strbuf_append_f64(&b, v);
+				strbuf_append_f64(&f, v);
+				break;
+			}
+			default: {
+				unsigned v = test_u32();
+				n = (size_t) sprintf(piece, "<%08x|%5d>", v, (int) (v & 0xffff));
+				strbuf_printf(&b, "<%08x|%5d>", v, (int) (v & 0xffff));
+				strbuf_printf(&f, "<%08x|%5d>", v, (int) (v & 0xffff));
+				break;
+			}
+			}
+			memcpy(ref + len, piece, n);
+			len += n;
+		}
+
+		CHECK(strbuf_ok(&b) && strbuf_len(&b) == len);
+		CHECK(memcmp(strbuf_cstr(&b), ref, len) == 0 && strbuf_cstr(&b)[len] == 0);
+		CHECKF(strbuf_ok(&f) == (len < fsize), "len=%u size=%u", (unsigned) len, (unsigned) fsize);
+		CHECK(strbuf_len(&f) < fsize && memcmp(strbuf_cstr(&f), ref, strbuf_len(&f)) == 0);
+		CHECK(strbuf_cstr(&f)[strbuf_len(&f)] == 0);
+		strbuf_free(&b);
+	}
+}
+
+#if defined(TEST_THREADS)
+enum { TEST_INTERN_THREADS = 4, TEST_INTERN_WORDS = 2000 };
+
+struct test_intern_job {
+	struct strintern *t;
+	const struct strview *words;
+	u32 handles[TEST_INTERN_WORDS];
+	u32 id;
+	u32 errors;
+};
+
+/* Each thread walks the words in its own order, adding and finding, and
+   looks up handles that other threads may be adding at that moment. Odd
+   threads add the words with their case flipped. */
+static void *test_intern_main(void *arg) {
+	struct test_intern_job *j = (struct test_intern_job *) arg;
+	static const u32 steps[TEST_INTERN_THREADS] = { 1, 3, 7, 11 };
+	char flipped[32];
+	u32 k, w, h, f, e;
+
+	for (k = 0; k < 3 * TEST_INTERN_WORDS; ++k) {
+		struct strview s = j->words[w = (k * steps[j->id] + j->id * 500) % TEST_INTERN_WORDS], v;
+		if (j->id & 1) {
+			for (e = 0; e < s.len; ++e)
+				flipped[e] = (char) (s.ptr[e] >= 'A' ? s.ptr[e] ^ 32 : s.ptr[e]);
+			s = strview_make(flipped, s.len);
+		}
+		f = strintern_find(j->t, s);
+		h = strintern_add(j->t, s);
+		j->errors += h == STRINTERN_NONE || (f != STRINTERN_NONE && f != h);
+		j->errors += j->handles[w] != 0 && j->handles[w] != h;
+		j->errors += strintern_find(j->t, s) != h;
+		j->handles[w] = h;
+
+		v = strintern_view(j->t, (k * 2654435761u >> 21) % TEST_INTERN_WORDS + 1);
+		j->errors += v.len != 0 && (strintern_find(j->t, v) == STRINTERN_NONE || v.ptr[v.len] != 0);
+	}
+	return NULL;
+}
+
+static void test_strings_intern_threads(void) {
+	static char text[TEST_INTERN_WORDS * 16];
+	static struct strview words[TEST_INTERN_WORDS];
+	static struct test_intern_job jobs[TEST_INTERN_THREADS];
+	pthread_t threads[TEST_INTERN_THREADS];
+	struct strintern t;
+	size_t used = 0, live;
+	u32 i, k;
+	int mode;
+
+	for (i = 0; i < TEST_INTERN_WORDS; ++i) {
+		size_t n = (size_t) sprintf(text + used, "Word%uX", (unsigned) i);
+		words[i] = strview_make(text + used, n);
+		used += n;
+	}
+
+	for (mode = 0; mode < 2; ++mode) {
+		bool nocase = mode != 0;
+		/* Lost races waste handles and bytes, so leave room for them. */
+		CHECK(strintern_init(&t, TEST_INTERN_WORDS * 4, sizeof text * 4, nocase));
+		memset(jobs, 0, sizeof jobs);
+		for (k = 0; k < TEST_INTERN_THREADS; ++k) {
+			jobs[k].t = &t;
+			jobs[k].words = words;
+			jobs[k].id = k;
+			CHECK(pthread_create(&threads[k], NULL, test_intern_main, &jobs[k]) == 0);
+		}
+		for (k = 0; k < TEST_INTERN_THREADS; ++k)
+			pthread_join(threads[k], NULL);
+
+		/* Odd threads interned other strings unless the case is folded. */
+		for (k = 0; k < TEST_INTERN_THREADS; ++k) {
+			CHECKF(jobs[k].errors == 0, "nocase=%d thread %u: %u errors", mode, (unsigned) k, (unsigned) jobs[k].errors);
+			for (i = 0; i < TEST_INTERN_WORDS; ++i)
+				CHECK(jobs[k].handles[i] == jobs[(k & 1) == 0 || nocase ? 0 : 1].handles[i]);
+		}
+		for (i = 0; i < TEST_INTERN_WORDS; ++i) {
+			struct strview v = strintern_view(&t, jobs[0].handles[i]);
+			CHECK(strintern_find(&t, words[i]) == jobs[0].handles[i]);
+			CHECK(nocase ? strview_caseeq(v, words[i]) : strview_eq(v, words[i]));
+		}
+
+		/* Every handle is a distinct string or was skipped. */
+		for (i = 1, live = 0; i <= t.nstrs; ++i) {
+			struct strview v = strintern_view(&t, i);
+			if (v.len != 0) {
+				CHECK(strintern_find(&t, v) == i);
+				++live;
+			}
+		}
+		CHECKF(live == (nocase ? 1u : 2u) * TEST_INTERN_WORDS, "nocase=%d live=%u", mode, (unsigned) live);
+		strintern_free(&t);
+	}
+}
+#endif
+
+static void test_strings_intern(void) {
+	enum { N = 3000 };
+	static char text[N * 24];
+	static struct strview strs[N];
+	static u32 handles[N];
+	struct strintern t;
+	int mode;
+	test_section = "strings/intern";
+
+	for (mode = 0; mode < 2; ++mode) {
+		bool nocase = mode != 0;
+		size_t used = 0, i, j;
+
+		CHECK(strintern_init(&t, N, sizeof text, nocase));
+		for (i = 0; i < N; ++i) {
+			/* Every third string repeats an earlier one, with its case flipped. */
+			if (i > 0 && i % 3 == 0) {
+				struct strview o = strs[test_below((u32) i)];
+				for (j = 0; j < o.len; ++j)
+					text[used + j] = (char) (nocase && (o.ptr[j] | 32) >= 'a' && (o.ptr[j] | 32) <= 'z' ? o.ptr[j] ^ 32 : o.ptr[j]);
+				strs[i] = strview_make(text + used, o.len);
+			} else {
+				size_t n = test_below(20);
+				test_text(text + used, n);
+				strs[i] = strview_make(text + used, n);
+			}
+			used += strs[i].len;
+			handles[i] = strintern_add(&t, strs[i]);
+			CHECK(handles[i] != STRINTERN_NONE);
+		}
+
+		for (i = 0; i < N; ++i) {
+			struct strview v = strintern_view(&t, handles[i]);
+			CHECK(strintern_find(&t, strs[i]) == handles[i]);
+			CHECK(nocase ? strview_caseeq(v, strs[i]) : strview_eq(v, strs[i]));
+			CHECK(strintern_cstr(&t, handles[i])[v.len] == 0);
+			for (j = 0; j < 4; ++j) {
+				size_t o = test_below((u32) i + 1);
+				bool same = nocase ? strview_caseeq(strs[o], strs[i]) : strview_eq(strs[o], strs[i]);
+				CHECK((handles[o] == handles[i]) == same);
+			}
+		}
+		CHECK(strintern_find(&t, STRVIEW_LIT("not interned, far too long")) == STRINTERN_NONE);
+		strintern_free(&t);
+	}
+
+	/* A full table refuses new strings without using up room: out of
+	   handles, the bytes stay free, and out of bytes, the handles do. */
+	CHECK(strintern_init(&t, 4, 64, false));
+	CHECK(strintern_add(&t, STRVIEW_LIT("a")) == 1);
+	CHECK(strintern_add(&t, STRVIEW_LIT("b")) == 2);
+	CHECK(strintern_add(&t, STRVIEW_LIT("c")) == 3);
+	CHECK(strintern_add(&t, STRVIEW_LIT("d")) == 4);
+	CHECK(strintern_add(&t, STRVIEW_LIT("e")) == STRINTERN_NONE);
+	CHECK(strintern_add(&t, STRVIEW_LIT("fgh")) == STRINTERN_NONE);
+	CHECK(t.nstrs == 4 && t.nbytes == 8);
+	CHECK(strintern_add(&t, STRVIEW_LIT("c")) == 3);
+	CHECK(strintern_find(&t, STRVIEW_LIT("e")) == STRINTERN_NONE);
+	CHECK(strintern_view(&t, 5).len == 0);
+	strintern_free(&t);
+
+	CHECK(strintern_init(&t, 8, 6, false));
+	CHECK(strintern_add(&t, STRVIEW_LIT("abc")) == 1);
+	CHECK(strintern_add(&t, STRVIEW_LIT("de")) == STRINTERN_NONE);
+	CHECK(t.nstrs == 1 && t.nbytes == 4);
+	CHECK(strintern_add(&t, STRVIEW_LIT("d")) == 2);
+	CHECK(strintern_add(&t, STRVIEW_LIT("")) == STRINTERN_NONE);
+	CHECK(strintern_find(&t, STRVIEW_LIT("abc")) == 1);
+	strintern_free(&t);
+
+#if defined(TEST_THREADS)
+	test_strings_intern_threads();
+#endif
+}
+
+/*
+ * Checksums and hashes
+ */
+
+static u32 ref_crc(u32 poly, u32 crc, const u8 *p, size_t n) {
+	size_t i;
+	int k;
+	crc = ~crc;
+	for (i = 0; i < n; ++i) {
+		crc ^= p[i];
+		for (k = 0; k < 8; ++k)
+			crc = crc >> 1 ^ (poly & -(crc & 1));
+	}
+	return ~crc;
+}
+
+static u32 ref_adler32(u32 adler, const u8 *p, size_t n) {
+	u32 a = adler & 0xffff, b = adler >> 16;
+	size_t i;
+	for (i = 0; i < n; ++i) {
+		a = (a + p[i]) % 65521;
+		b = (b + a) % 65521;
+	}
+	return b << 16 | a;
+}
+
+static void test_checksum(void) {
+	static u8 buf[70000];
+	size_t c;
+	test_section = "checksum";
+
+	CHECK(checksum_crc32(0, "123456789", 9) == 0xcbf43926);
+	CHECK(checksum_crc32c(0, "123456789", 9) == 0xe3069283);
+	CHECK(checksum_adler32(1, "Wikipedia", 9) == 0x11e60398);
+
+	test_fill(buf, sizeof buf);
+	for (c = 0; c < countof(test_counts) + 8; ++c) {
+		size_t n = c < countof(test_counts) ? test_counts[c] : 5000 + test_below(sizeof buf - 5016);
+		size_t off = test_below(16), cut = test_below((u32) n + 1);
+		const u8 *p = buf + off;
+		u32 crc, crcc, adler;
+
+		/* All ones pushes the Adler-32 sums to their largest. */
+		if (c == countof(test_counts))
+			memset(buf, 0xff, sizeof buf);
+		crc = ref_crc(0xedb88320, 0, p, n);
+		crcc = ref_crc(0x82f63b78, 0, p, n);
+		adler = ref_adler32(1, p, n);
+
+		CHECKF(checksum_crc32(0, p, n) == crc, "n=%u", (unsigned) n);
+		CHECKF(checksum_crc32c(0, p, n) == crcc, "n=%u", (unsigned) n);
+		CHECKF(checksum_adler32(1, p, n) == adler, "n=%u", (unsigned) n);
+
+		CHECK(checksum_crc32(checksum_crc32(0, p, cut), p + cut, n - cut) == crc);
+		CHECK(checksum_crc32c(checksum_crc32c(0, p, cut), p + cut, n - cut) == crcc);
+		CHECK(checksum_adler32(checksum_adler32(1, p, cut), p + cut, n - cut) == adler);
+
+		CHECK(checksum_crc32_combine(checksum_crc32(0, p, cut), checksum_crc32(0, p + cut, n - cut), n - cut) == crc);
+		CHECK(checksum_crc32c_combine(checksum_crc32c(0, p, cut), checksum_crc32c(0, p + cut, n - cut), n - cut) == crcc);
+		CHECK(checksum_adler32_combine(checksum_adler32(1, p, cut), checksum_adler32(1, p + cut, n - cut), n - cut) == adler);
+	}
+}
+
+/* XXH3_64bits_withSeed and XXH3_128bits_withSeed of bytes (i * 31 + 7). */
+static const struct {
+	u32 size;
+	u64 seed;
+	u64 h64;
+	u64 lo;
+	u64 hi;
+} test_xxh3[] = {
+	{ 0, 0x0ull, 0x2d06800538d394c2ull, 0x6001c324468d497full, 0x99aa06d3014798d8ull },
+	{ 0, 0x9e3779b97f4a7c15ull, 0x602b0e2cd6662c8bull, 0x4ca5176998171787ull, 0xd142977a2cca554bull },
+	{ 1, 0x0ull, 0x4c5cca45d0f4811full, 0x4c5cca45d0f4811full, 0x495b62073ef70ca4ull },
+	{ 1, 0x9e3779b97f4a7c15ull, 0x2f3acd3805f81de3ull, 0x2f3acd3805f81de3ull, 0x00a711eb5a736b26ull },
+	{ 3, 0x0ull, 0x15f7093b173d005cull, 0x15f7093b173d005cull, 0x46f66cb935381565ull },
+	{ 3, 0x9e3779b97f4a7c15ull, 0x079dd5d54d89480aull, 0x079dd5d54d89480aull, 0xbf6c84df5f76651dull },
+	{ 4, 0x0ull, 0xdca012f95811b6b9ull, 0xb987ca5d9241572aull, 0x7fefeeffb4d0eab3ull },
+	{ 4, 0x9e3779b97f4a7c15ull, 0x1a246e2efb9c9b2eull, 0x64e9e646b51d20e4ull, 0xb51a3f0020dfa57eull },
+	{ 8, 0x0ull, 0xdec6a9a43575982eull, 0x56bb836ceb6d4baaull, 0x803c675a846cc6c2ull },
+	{ 8, 0x9e3779b97f4a7c15ull, 0x19ef7d3919108affull, 0x3edb070ecf3a9343ull, 0xc3612dc11470e721ull },
+	{ 9, 0x0ull, 0xcbe393399f17ffbdull, 0x4376673580310154ull, 0xd46556872d230f22ull },
+	{ 9, 0x9e3779b97f4a7c15ull, 0x9c98d3e24dc54d34ull, 0x2d1266ad8e2a983eull, 0xd073a967e56faabbull },
+	{ 16, 0x0ull, 0x7e484c18d74895d0ull, 0xf853dd94614dfa07ull, 0x650fe308c566747dull },
+	{ 16, 0x9e3779b97f4a7c15ull, 0xa106510078b0a252ull, 0x4e683254a04c377full, 0xbe0f27bac4d1f58full },
+	{ 17, 0x0ull, 0x208bde5ee2bed407ull, 0x78c349fe81b2f26cull, 0x18217300b5132d5aull },
+	{ 17, 0x9e3779b97f4a7c15ull, 0x0b2caf8bf9648effull, 0xec6d60966729df8dull, 0x81d87d7004dc4f98ull },
+	{ 128, 0x0ull, 0xf92b70eaa21a6288ull, 0x1e04fad9f0cacb4dull, 0xb4f87b99d2db8a51ull },
+	{ 128, 0x9e3779b97f4a7c15ull, 0x95425530beb89fe8ull, 0x8dd13adf89d20a39ull, 0xf1355c6816c0b724ull },
+	{ 129, 0x0ull, 0xf8f76713f2bb60faull, 0xc51bc887976aef63ull, 0x6881633650cd8924ull },
+	{ 129, 0x9e3779b97f4a7c15ull, 0x29fa850b97ed9666ull, 0xa1c74215b3db7ab4ull, 0xb8c736db70349640ull },
+	{ 240, 0x0ull, 0xccc7375172c41f03ull, 0x93e173833f75ab66ull, 0xde57aab31e77a2ffull },
+	{ 240, 0x9e3779b97f4a7c15ull, 0x2d882e7899ff64ccull, 0xde896b7f1ae3bc6full, 0x5b131678a4a9b8f4ull },
+	{ 241, 0x0ull, 0x0b3b630948ce4a00ull, 0x0b3b630948ce4a00ull, 0x92b991a7192f3f08ull },
+	{ 241, 0x9e3779b97f4a7c15ull, 0x422e82e8913e49e0ull, 0x422e82e8913e49e0ull, 0xc39cbfb460caf47eull },
+	{ 1024, 0x0ull, 0x23bc880ebf0d29c6ull, 0x23bc880ebf0d29c6ull, 0x4c17271c906df792ull },
+	{ 1024, 0x9e3779b97f4a7c15ull, 0x7e249adc60e1f9b4ull, 0x7e249adc60e1f9b4ull, 0x927c8d2b50d33f53ull },
+	{ 5000, 0x0ull, 0x559fff92c2b7f8eeull, 0x559fff92c2b7f8eeull, 0x3bf60aa89c7feeaaull },
+	{ 5000, 0x9e3779b97f4a7c15ull, 0xd5959148128ebcabull, 0xd5959148128ebcabull, 0xb31ee1f8ea37cc11ull },
+};
+
+static void test_hash(void) {
+	static u8 buf[5000], lower[5000];
+	struct hash_state s;
+	size_t c, i;
+	int k;
+	test_section = "hash";
+
+	for (i = 0; i < sizeof buf; ++i)
+		buf[i] = (u8) (i * 31 + 7);
+	for (c = 0; c < countof(test_xxh3); ++c) {
+		struct hash128 h = hash128(buf, test_xxh3[c].size, test_xxh3[c].seed);
+		CHECKF(hash64(buf, test_xxh3[c].size, test_xxh3[c].seed) == test_xxh3[c].h64, "size=%u", test_xxh3[c].size);
+		CHECKF(h.lo == test_xxh3[c].lo && h.hi == test_xxh3[c].hi, "size=%u", test_xxh3[c].size);
+	}
+
+	/* Streaming in random pieces matches one shot; case variants match
+	   hashing the folded bytes. */
+	for (k = 0; k < 2000; ++k) {
+		size_t n = test_below(k & 1 ? sizeof buf : 300), done = 0;
+		u64 seed = k & 2 ? test_u64() : 0;
+		struct hash128 h, hc;
+		bool folded = (k & 4) != 0;
+
+		test_text((char *) buf, n);
+		for (i = 0; i < n; ++i)
+			lower[i] = (u8) ref_lower(buf[i]);
+
+		hash_init(&s, seed);
+		while (done < n) {
+			size_t piece = test_below(test_below(2) ? 8 : 400) + 1;
+			if (piece > n - done)
+				piece = n - done;
+			if (folded)
+				hash_update_case(&s, buf + done, piece);
+			else
+				hash_update(&s, buf + done, piece);
+			done += piece;
+		}
+
+		h = hash128(folded ? lower : buf, n, seed);
+		hc = hash_final128(&s);
+		CHECKF(hash_final64(&s) == hash64(folded ? lower : buf, n, seed), "n=%u", (unsigned) n);
+		CHECKF(hc.lo == h.lo && hc.hi == h.hi, "n=%u", (unsigned) n);
+		CHECK(hash64_case(buf, n, seed) == hash64(lower, n, seed));
+		hc = hash128_case(buf, n, seed);
+		h = hash128(lower, n, seed);
+		CHECK(hc.lo == h.lo && hc.hi == h.hi);
+	}
+}
+
+/*
+ * Unicode
+ */
+
+/* Decodes one well-formed sequence, or returns 0. */
+static size_t ref_utf8_next(const u8 *s, size_t n, u32 *cp) {
+	u32 c = s[0], min;
+	size_t len, i;
+	if (c < 0x80) {
+		*cp = c;
+		return 1;
+	}
+	if (c >= 0xc2 && c <= 0xdf)
+		len = 2, min = 0x80, c &= 0x1f;
+	else if (c >= 0xe0 && c <= 0xef)
+		len = 3, min = 0x800, c &= 0x0f;
+	else if (c >= 0xf0 && c <= 0xf4)
+		len = 4, min = 0x10000, c &= 0x07;
+	else
+		return 0;
+	if (n < len)
+		return 0;
+	for (i = 1; i < len; ++i) {
+		if ((s[i] & 0xc0) != 0x80)
+			return 0;
+		c = c << 6 | (s[i] & 0x3f);
+	}
+	if (c < min || c > 0x10ffff || (c >= 0xd800 && c < 0xe000))
+		return 0;
+	*cp = c;
+	return len;
+}
+
+static size_t ref_utf8_put(u8 *d, u32 c) {
+	if (c < 0x80) {
+		d[0] = (u8) c;
+		return 1;
+	}
+	if (c < 0x800) {
+		d[0] = (u8) (0xc0 | c >> 6);
+		d[1] = (u8) (0x80 | (c & 0x3f));
+		return 2;
+	}
+	if (c < 0x10000) {
+		d[0] = (u8) (0xe0 | c >> 12);
+		d[1] = (u8) (0x80 | (c >> 6 & 0x3f));
+		d[2] = (u8) (0x80 | (c & 0x3f));
+		return 3;
+	}
+	d[0] = (u8) (0xf0 | c >> 18);
+	d[1] = (u8) (0x80 | (c >> 12 & 0x3f));
+	d[2] = (u8) (0x80 | (c >> 6 & 0x3f));
+	d[3] = (u8) (0x80 | (c & 0x3f));
+	return 4;
+}
+
+/* Runs of ASCII between code points from every range, and now and then a
+   random byte. */
+static size_t test_utf8_text(u8 *dst, size_t max, bool noise) {
+	static const u32 ranges[][2] = {
+		{ 0x80, 0x7ff }, { 0x800, 0xd7ff }, { 0xe000, 0xffff }, { 0x10000, 0x10ffff },
+		{ 0xc0, 0x24f }, { 0x370, 0x52f },
+	};
+	size_t n = 0;
+	while (n + 4 <= max) {
+		u32 r = test_below(100);
+		if (r < 50) {
+			dst[n++] = (u8) (0x20 + test_below(0x5f));
+		} else if (noise && r < 52) {
+			dst[n++] = (u8) test_rand();
+		} else {
+			u32 k = test_below(countof(ranges));
+			n += ref_utf8_put(dst + n, ranges[k][0] + test_below(ranges[k][1] - ranges[k][0] + 1));
+		}
+		if (test_below(64) == 0)
+			break;
+	}
+	return n;
+}
+
+static void test_utf(void) {
+	static u8 s[4096], t[4096], ref8[3 * 4096];
+	static u16 u16s[4096], ref16[4096];
+	static char out[3 * 4096];
+	int k;
+	test_section = "utf";
+
+	for (k = 0; k < 20000; ++k) {
+		size_t n = test_utf8_text(s, k & 1 ? sizeof s : 64, (k & 6) == 0), i = 0, len;
+		size_t bad = n, count = 0, n16 = 0, nf = 0, r;
+		u32 cp;
+		int ref;
+
+		while (i < n) {
+			len = ref_utf8_next(s + i, n - i, &cp);
+			if (len == 0) {
+				if (bad == n)
+					bad = i;
+				t[nf++] = s[i++];
+				continue;
+			}
+			if (bad == n) {
+				++count;
+				if (cp >= 0x10000) {
+					ref16[n16++] = (u16) (0xd800 + ((cp - 0x10000) >> 10));
+					ref16[n16++] = (u16) (0xdc00 + ((cp - 0x10000) & 0x3ff));
+				} else {
+					ref16[n16++] = (u16) cp;
+				}
+			}
+			nf += ref_utf8_put(t + nf, utf_fold(cp));
+			i += len;
+		}
+
+		CHECKF(utf8_validate((const char *) s, n) == bad, "n=%u", (unsigned) n);
+		r = utf8_fold(out, (const char *) s, n);
+		CHECKF(r == nf && memcmp(out, t, nf) == 0, "n=%u", (unsigned) n);
+		if (bad == n) {
+			CHECK(utf8_count((const char *) s, n) == count);
+			CHECK(utf8_len_utf16((const char *) s, n) == n16);
+			r = utf8_to_utf16(u16s, (const char *) s, n);
+			CHECKF(r == n16 && memcmp(u16s, ref16, n16 * 2) == 0, "n=%u", (unsigned) n);
+			CHECK(utf16_len_utf8(ref16, n16) == n);
+			r = utf16_to_utf8(out, ref16, n16);
+			CHECKF(r == n && memcmp(out, s, n) == 0, "n=%u", (unsigned) n);
+		} else {
+			CHECK(utf8_to_utf16(u16s, (const char *) s, n) == UTF_ERROR);
+		}
+
+		/* An unpaired surrogate anywhere fails the conversion. */
+		if (n16 > 0 && bad == n) {
+			size_t at = test_below((u32) n16);
+			u16 save = ref16[at];
+			ref16[at] = (u16) (0xd800 + test_below(0x800));
+			if (!((ref16[at] < 0xdc00 && at + 1 < n16 && ref16[at + 1] >= 0xdc00 && ref16[at + 1] < 0xe000) ||
+			      (ref16[at] >= 0xdc00 && at > 0 && ref16[at - 1] >= 0xd800 && ref16[at - 1] < 0xdc00)))
+				CHECK(utf16_to_utf8(out, ref16, n16) == UTF_ERROR);
+			ref16[at] = save;
+		}
+
+		/* The comparison orders by folded code point, bytes of invalid
+		   sequences after all of them. */
+		memcpy(ref8, s, n);
+		len = n;
+		if (n > 0 && test_below(2))
+			len = test_below((u32) n + 1);
+		for (i = 0; i < len; ++i)
+			if (ref8[i] < 0x80 && test_below(2))
+				ref8[i] = (u8) ((ref8[i] | 32) >= 'a' && (ref8[i] | 32) <= 'z' ? ref8[i] ^ 32 : ref8[i]);
+		if (len > 0 && test_below(4) == 0)
+			ref8[test_below((u32) len)] = (u8) (0x20 + test_below(0x5f));
+		{
+			size_t a = 0, b = 0;
+			ref = 0;
+			while (ref == 0 && a < n && b < len) {
+				u32 ca, cb;
+				size_t la = ref_utf8_next(s + a, n - a, &ca), lb = ref_utf8_next(ref8 + b, len - b, &cb);
+				ca = la ? utf_fold(ca) : 0x110000u + s[a];
+				cb = lb ? utf_fold(cb) : 0x110000u + ref8[b];
+				a += la ? la : 1;
+				b += lb ? lb : 1;
+				ref = (ca > cb) - (ca < cb);
+			}
+			if (ref == 0)
+				ref = (a < n) - (b < len);
+		}
+		CHECKF(test_sign(utf8_casecmp((const char *) s, n, (const char *) ref8, len)) == ref, "n=%u len=%u", (unsigned) n, (unsigned) len);
+	}
+
+	for (k = 0; k < 0x110000; ++k) {
+		u32 f = utf_fold((u32) k);
+		if (k < 0x80)
+			CHECK(f == (u32) ref_lower(k));
+		CHECKF(utf_fold(f) == f, "%#x", k);
+	}
+}
+
+/*
+ * Formatting and parsing
+ */
+
+/* Significant digits of a formatted float. */
+static int test_digits(const char *s, size_t n) {
+	size_t i, first = n, last = 0;
+	int digits;
+	for (i = 0; i < n && s[i] != 'e'; ++i) {
+		if (s[i] >= '1' && s[i] <= '9') {
+			if (first == n)
+				first = i;
+			last = i;
+		}
+	}
+	if (first == n)
+		return 1;
+	digits = (int) (last - first + 1);
+	for (i = first; i < last; ++i)
+		digits -= s[i] == '.';
+	return digits;
+}
+
+static void test_format(void) {
+	char buf[64], ref[64];
+	int k;
+	test_section = "format";
+
+	for (k = 0; k < TEST_ITERS; ++k) {
+		u64 v = test_u64();
+		u32 w = (u32) v;
+		size_t n;
+
+		n = format_u32(buf, w);
+		CHECK(n == (size_t) sprintf(ref, "%u", w) && memcmp(buf, ref, n) == 0);
+		n = format_s32(buf, (s32) w);
+		CHECK(n == (size_t) sprintf(ref, "%d", (s32) w) && memcmp(buf, ref, n) == 0);
+		n = format_u64(buf, v);
+		CHECK(n == (size_t) sprintf(ref, "%llu", (unsigned long long) v) && memcmp(buf, ref, n) == 0);
+		n = format_s64(buf, (s64) v);
+		CHECK(n == (size_t) sprintf(ref, "%lld", (long long) v) && memcmp(buf, ref, n) == 0);
+		n = format_x32(buf, w);
+		CHECK(n == (size_t) sprintf(ref, "%x", w) && memcmp(buf, ref, n) == 0);
+		n = format_x64(buf, v);
+		CHECK(n == (size_t) sprintf(ref, "%llx", (unsigned long long) v) && memcmp(buf, ref, n) == 0);
+	}
+
+	/* Floats read back exactly, with as few digits as %.*e needs. */
+	for (k = 0; k < TEST_ITERS; ++k) {
+		union { f64 f; u64 u; } d;
+		union { f32 f; u32 u; } s;
+		int p;
+		size_t n;
+
+		d.u = test_rand();
+		s.u = (u32) test_rand();
+		if (k & 1) {
+			d.f = (f64) (s64) test_u32() / (f64) (1 + test_below(1000));
+			s.f = (f32) d.f;
+		}
+
+		if (d.f == d.f && d.f - d.f == 0) {
+			n = format_f64(buf, d.f);
+			buf[n] = 0;
+			CHECKF(strtod(buf, NULL) == d.f, "%s", buf);
+			for (p = 1; p < 17; ++p) {
+				sprintf(ref, "%.*e", p - 1, d.f);
+				if (strtod(ref, NULL) == d.f)
+					break;
+			}
+			CHECKF(test_digits(buf, n) == p, "%s %s", buf, ref);
+		}
+		if (s.f == s.f && s.f - s.f == 0) {
+			n = format_f32(buf, s.f);
+			buf[n] = 0;
+			CHECKF(strtof(buf, NULL) == s.f, "%s", buf);
+			for (p = 1; p < 9; ++p) {
+				sprintf(ref, "%.*e", p - 1, (f64) s.f);
+				if (strtof(ref, NULL) == s.f)
+					break;
+			}
+			CHECKF(test_digits(buf, n) == p, "%s %s", buf, ref);
+		}
+	}
+}
+
+static void test_parse(void) {
+	char buf[96];
+	int k;
+	test_section = "parse";
+
+	for (k = 0; k < TEST_ITERS; ++k) {
+		size_t n = 0, digits = 1 + test_below(k & 1 ? 24 : 12), used, i;
+		unsigned long long ull;
+		long long ll;
+		u64 v;
+		s64 sv;
+		u32 err, w;
+		s32 sw;
+		bool neg = test_below(2) != 0;
+
+		if (neg)
+			buf[n++] = '-';
+		for (i = 0; i < digits; ++i)
+			buf[n++] = (char) ('0' + (i == 0 && test_below(2) ? 1 + test_below(9) : test_below(10)));
+		buf[n] = test_below(2) ? 'x' : 0;
+
+		errno = 0;
+		ull = strtoull(buf + neg, NULL, 10);
+		err = parse_u64(&v, &used, buf + neg, n - neg);
+		CHECKF(err == (errno == ERANGE ? PARSE_OVERFLOW : PARSE_OK) && v == ull && used == n - neg, "%.*s", (int) n, buf);
+		if (!neg) {
+			err = parse_u32(&w, &used, buf, n);
+			CHECKF(err == (ull > 0xffffffff ? PARSE_OVERFLOW : PARSE_OK) && w == (ull > 0xffffffff ? 0xffffffff : ull), "%.*s", (int) n, buf);
+		}
+
+		errno = 0;
+		ll = strtoll(buf, NULL, 10);
+		err = parse_s64(&sv, &used, buf, n);
+		CHECKF(err == (errno == ERANGE ? PARSE_OVERFLOW : PARSE_OK) && sv == ll && used == n, "%.*s", (int) n, buf);
+		err = parse_s32(&sw, &used, buf, n);
+		CHECKF(err == (ll < INT_MIN || ll > INT_MAX ? PARSE_OVERFLOW : PARSE_OK) &&
+			sw == (ll < INT_MIN ? INT_MIN : ll > INT_MAX ? INT_MAX : ll), "%.*s", (int) n, buf);
+
+		n = (size_t) sprintf(buf, test_below(2) ? "%llx" : "0x%llX", (unsigned long long) (v = test_u64()));
+		err = parse_x64(&v, &used, buf, n);
+		CHECKF(err == PARSE_OK && v == strtoull(buf, NULL, 16) && used == n, "%s", buf);
+	}
+
+	CHECK(parse_u64(&(u64) { 1 }, NULL, "", 0) == PARSE_INVALID);
+	CHECK(parse_u64(&(u64) { 1 }, NULL, " 1", 2) == PARSE_INVALID);
+	CHECK(parse_s64(&(s64) { 1 }, NULL, "-", 1) == PARSE_INVALID);
+
+	/* Decimal strings of up to 30 digits with exponents across the whole
+	   range, including subnormals and overflow. */
+	for (k = 0; k < TEST_ITERS; ++k) {
+		size_t n = 0, digits = 1 + test_below(k & 1 ? 30 : 17), used, i, point = test_below((u32) digits + 1);
+		int e = (int) test_below(k & 2 ? 700 : 80) - (k & 2 ? 350 : 40);
+		f64 d, rd;
+		f32 f, rf;
+		u32 err;
+
+		if (test_below(2))
+			buf[n++] = '-';
+		for (i = 0; i < digits; ++i) {
+			if (i == point && i > 0)
+				buf[n++] = '.';
+			buf[n++] = (char) ('0' + test_below(10));
+		}
+		n += (size_t) sprintf(buf + n, "e%d", e);
+
+		errno = 0;
+		rd = strtod(buf, NULL);
+		err = parse_f64(&d, &used, buf, n);
+		CHECKF(memcmp(&d, &rd, sizeof d) == 0 && used == n, "%s", buf);
+		CHECKF(err == (rd - rd != 0 ? PARSE_OVERFLOW : PARSE_OK), "%s", buf);
+
+		rf = strtof(buf, NULL);
+		err = parse_f32(&f, &used, buf, n);
+		CHECKF(memcmp(&f, &rf, sizeof f) == 0 && used == n, "%s", buf);
+		CHECKF(err == (rf - rf != 0 ? PARSE_OVERFLOW : PARSE_OK), "%s", buf);
+	}
+}
+
+/*
+ * Variable-length integers
+ */
+
+static void test_varint(void) {
+	static u32 src[TEST_ARRAY], dst[TEST_ARRAY];
+	static u64 src64[TEST_ARRAY], dst64[TEST_ARRAY];
+	static u8 enc[TEST_ARRAY * 10 + 16], ref[TEST_ARRAY * 10 + 16];
+	size_t c, i;
+	test_section = "varint";
+
+	for (c = 0; c < countof(test_counts); ++c) {
+		size_t n = test_counts[c], size, rsize = 0, m;
+		bool small = (c & 1) != 0;
+
+		for (i = 0; i < n; ++i) {
+			src[i] = small ? test_u32() & 0x3ff : test_u32();
+			src64[i] = small ? test_u64() & 0xfffff : test_u64();
+		}
+
+		for (i = 0; i < n; ++i)
+			rsize += varint_encode_u32(ref + rsize, src[i]);
+		size = varint_encode_u32_array(enc, src, n);
+		CHECKF(size == rsize && memcmp(enc, ref, size) == 0, "n=%u", (unsigned) n);
+		CHECKF(varint_decode_u32_array(dst, n, enc, size) == size && memcmp(dst, src, n * 4) == 0, "n=%u", (unsigned) n);
+		if (n > 0)
+			CHECK(varint_decode_u32_array(dst, n, enc, size - 1) == 0);
+
+		for (i = 0, rsize = 0; i < n; ++i)
+			rsize += varint_encode_u64(ref + rsize, src64[i]);
+		size = varint_encode_u64_array(enc, src64, n);
+		CHECKF(size == rsize && memcmp(enc, ref, size) == 0, "n=%u", (unsigned) n);
+		CHECKF(varint_decode_u64_array(dst64, n, enc, size) == size && memcmp(dst64, src64, n * 8) == 0, "n=%u", (unsigned) n);
+		if (n > 0)
+			CHECK(varint_decode_u64_array(dst64, n, enc, size - 1) == 0);
+
+		/* Stream VByte, laid out by hand. */
+		m = (n + 3) / 4;
+		memset(ref, 0, m);
+		for (i = 0, rsize = m; i < n; ++i) {
+			u32 len = src[i] > 0xffffff ? 4 : src[i] > 0xffff ? 3 : src[i] > 0xff ? 2 : 1;
+			ref[i / 4] |= (u8) ((len - 1) << (2 * (i % 4)));
+			_store_le32(ref + rsize, src[i]);
+			rsize += len;
+		}
+		size = streamvbyte_encode(enc, src, n);
+		CHECKF(size == rsize && size <= streamvbyte_max_size(n) && memcmp(enc, ref, size) == 0, "n=%u", (unsigned) n);
+		CHECKF(streamvbyte_decode(dst, n, enc, size) == size && memcmp(dst, src, n * 4) == 0, "n=%u", (unsigned) n);
+	}
+
+	for (i = 0; i < (size_t) TEST_ITERS; ++i) {
+		s64 v = (s64) test_u64();
+		s32 w = (s32) test_u32();
+		CHECK(zigzag_s64(v) == (v < 0 ? ~((u64) v << 1) : (u64) v << 1));
+		CHECK(zigzag_s32(w) == (w < 0 ? ~((u32) w << 1) : (u32) w << 1));
+		CHECK(unzigzag_s64(zigzag_s64(v)) == v && unzigzag_s32(zigzag_s32(w)) == w);
+		CHECK(varint_size_u64((u64) v) == varint_encode_u64(enc, (u64) v));
+		CHECK(varint_size_u32((u32) w) == varint_encode_u32(enc, (u32) w));
+	}
+
+	/* The last byte may not carry bits past the width of the type, in the
+	   single decoders and in both array paths. */
+	memset(enc, 0, 32);
+	memcpy(enc, "\xff\xff\xff\xff\x0f", 5);
+	CHECK(varint_decode_u32(dst, enc, 5) == 5 && dst[0] == 0xffffffff);
+	CHECK(varint_decode_u32_array(dst, 1, enc, 5) == 5 && varint_decode_u32_array(dst, 1, enc, 16) == 5);
+	for (i = 0x10; i < 0x80; i += 0x10) {
+		enc[4] = (u8) i;
+		CHECKF(varint_decode_u32(dst, enc, 5) == 0, "%#x", (unsigned) i);
+		CHECKF(varint_decode_u32_array(dst, 1, enc, 5) == 0 && varint_decode_u32_array(dst, 1, enc, 16) == 0, "%#x", (unsigned) i);
+	}
+	memset(enc, 0xff, 9);
+	enc[9] = 0x01;
+	CHECK(varint_decode_u64(dst64, enc, 10) == 10 && dst64[0] == ~imm_u64(0));
+	for (i = 0x02; i < 0x80; i <<= 1) {
+		enc[9] = (u8) i;
+		CHECKF(varint_decode_u64(dst64, enc, 10) == 0 && varint_decode_u64_array(dst64, 1, enc, 10) == 0, "%#x", (unsigned) i);
+	}
+}
+
+/*
+ * Random numbers
+ */
+
+static u32 ref_xoshiro128(u32 *s) {
+	u32 r = s[1] * 5, t = s[1] << 9;
+	r = (r << 7 | r >> 25) * 9;
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = s[3] << 11 | s[3] >> 21;
+	return r;
+}
+
+/* Steps each lane on its own and lays the outputs out as the fills do. */
+static void ref_xoshiro128_fill(u32 *s, size_t lanes, u32 *dst, size_t count) {
+	size_t i, j, k;
+	for (i = 0; i < count; i += lanes)
+		for (k = 0; k < lanes; ++k) {
+			u32 l[4], r;
+			for (j = 0; j < 4; ++j)
+				l[j] = s[j * lanes + k];
+			r = ref_xoshiro128(l);
+			for (j = 0; j < 4; ++j)
+				s[j * lanes + k] = l[j];
+			if (i + k < count)
+				dst[i + k] = r;
+		}
+}
+
+static void test_random(void) {
+	static const u64 xoshiro256_ref[4] = { 0x2d00, 0, 0x5a007080, imm_u64(0x10e0000000009d80) };
+	static const u64 xoshiro256_jump_ref[4] = {
+		imm_u64(0x8c7a153956b5f3d1), imm_u64(0x701f1a713401d85e),
+		imm_u64(0x6527f66a65469085), imm_u64(0x8386b786c4408050),
+	};
+	static const u32 pcg32_ref[6] = { 0xa15c02b7, 0x7b47f409, 0xba1d3330, 0x83d2f293, 0xbfa4784b, 0xcbed606e };
+	static const u64 wyrand_ref[3] = { imm_u64(0x111cb3a78f59a58e), imm_u64(0xceabd938ff4e856d), imm_u64(0x61fb51318f47d2a4) };
+	static const u32 lanes_ref[2][4] = {
+		{ 0x7b1dcdaf, 0xe220a839, 0xa1b965f4, 0x6e789e6a },
+		{ 0xe8ad2042, 0x2070022f, 0x3528a847, 0xbe31d5d0 },
+	};
+	static u32 dst[TEST_ARRAY], ref[TEST_ARRAY], kept[TEST_ARRAY];
+	static f32 dstf[TEST_ARRAY];
+	struct xoshiro256 x, x2;
+	struct pcg32 p, p2;
+	struct wyrand w, w2;
+	struct xoshiro128x4 v4;
+	struct xoshiro128x8 v8;
+	u32 hist[10] = { 0 }, s[32];
+	size_t c, i, j, k;
+	test_section = "random";
+
+	x.s[0] = 1, x.s[1] = 2, x.s[2] = 3, x.s[3] = 4;
+	for (i = 0; i < 4; ++i)
+		CHECKF(xoshiro256_next(&x) == xoshiro256_ref[i], "%u", (unsigned) i);
+	x.s[0] = 1, x.s[1] = 2, x.s[2] = 3, x.s[3] = 4;
+	xoshiro256_split(&x2, &x);
+	CHECK(memcmp(x.s, xoshiro256_jump_ref, sizeof x.s) == 0);
+	CHECK(x2.s[0] == 1 && x2.s[1] == 2 && x2.s[2] == 3 && x2.s[3] == 4);
+	x2 = x;
+	xoshiro256_long_jump(&x2);
+	CHECK(memcmp(&x, &x2, sizeof x) != 0);
+
+	pcg32_seed(&p, 42, 54);
+	for (i = 0; i < 6; ++i)
+		CHECKF(pcg32_next(&p) == pcg32_ref[i], "%u", (unsigned) i);
+	for (i = 0; i < 1000; ++i) {
+		u64 n = test_below(300);
+		p2 = p;
+		for (j = 0; j < n; ++j)
+			pcg32_next(&p2);
+		pcg32_advance(&p, n);
+		CHECK(p.state == p2.state);
+		pcg32_advance(&p2, 0 - n);
+		pcg32_advance(&p2, n);
+		CHECK(p.state == p2.state);
+	}
+	pcg32_split(&p2, &p);
+	CHECK(p2.inc != p.inc && pcg32_next(&p2) != pcg32_next(&p));
+
+	w.s = 0;
+	for (i = 0; i < 3; ++i)
+		CHECKF(wyrand_next(&w) == wyrand_ref[i], "%u", (unsigned) i);
+	wyrand_split(&w2, &w);
+	CHECK(wyrand_next(&w2) != wyrand_next(&w));
+
+	xoshiro256_seed(&x, test_rand());
+	pcg32_seed(&p, test_rand(), test_rand());
+	wyrand_seed(&w, test_rand());
+	for (i = 0; i < TEST_ITERS; ++i) {
+		u64 n = test_u64(), lo, hi;
+		u32 n32 = test_u32();
+		f32 f = i % 3 == 0 ? xoshiro256_f32(&x) : i % 3 == 1 ? pcg32_f32(&p) : wyrand_f32(&w);
+		f64 d = i % 3 == 0 ? xoshiro256_f64(&x) : i % 3 == 1 ? pcg32_f64(&p) : wyrand_f64(&w);
+		CHECKF(f >= 0.f && f < 1.f && d >= 0. && d < 1., "%g %g", (double) f, d);
+
+		/* The bounded draws against the method spelled out on a copy. */
+		x2 = x;
+		hi = ref_mulwide_u64(xoshiro256_next(&x2), n, &lo);
+		while (n != 0 && lo < (0 - n) % n)
+			hi = ref_mulwide_u64(xoshiro256_next(&x2), n, &lo);
+		CHECKF(xoshiro256_below(&x, n) == hi && memcmp(&x, &x2, sizeof x) == 0, "%#llx", (unsigned long long) n);
+
+		w2 = w;
+		hi = ref_mulwide_u64(wyrand_next(&w2), n, &lo);
+		while (n != 0 && lo < (0 - n) % n)
+			hi = ref_mulwide_u64(wyrand_next(&w2), n, &lo);
+		CHECKF(wyrand_below(&w, n) == hi && w.s == w2.s, "%#llx", (unsigned long long) n);
+
+		p2 = p;
+		lo = (u64) pcg32_next(&p2) * n32;
+		while (n32 != 0 && (u32) lo < (0 - n32) % n32)
+			lo = (u64) pcg32_next(&p2) * n32;
+		CHECKF(pcg32_below(&p, n32) == (u32) (lo >> 32) && p.state == p2.state, "%#x", n32);
+
+		++hist[pcg32_below(&p, 10)];
+	}
+	for (i = 0; i < 10; ++i)
+		CHECKF(hist[i] > TEST_ITERS / 10 * 95 / 100 && hist[i] < TEST_ITERS / 10 * 105 / 100, "%u: %u", (unsigned) i, hist[i]);
+
+	/* Lane 0 comes from splitmix64, the others one jump apart. */
+	xoshiro128x4_seed(&v4, 0);
+	xoshiro128x8_seed(&v8, 0);
+	for (i = 0; i < 4; ++i) {
+		CHECK(v4.s[i][0] == lanes_ref[0][i] && v4.s[i][1] == lanes_ref[1][i]);
+		for (k = 0; k < 4; ++k)
+			CHECK(v8.s[i][k] == v4.s[i][k]);
+	}
+	memcpy(s, v8.s, sizeof v8.s);
+	xoshiro128x8_jump(&v8);
+	CHECK(memcmp(s, v8.s, sizeof v8.s) != 0);
+
+	for (c = 0; c < countof(test_counts); ++c) {
+		size_t n = test_counts[c];
+		u32 bound = c % 3 == 0 ? 0x80000001 : c % 3 == 1 ? 1000 : test_u32();
+
+		xoshiro128x4_seed(&v4, test_rand());
+		memcpy(s, v4.s, sizeof v4.s);
+		xoshiro128x4_fill_u32(&v4, dst, n);
+		ref_xoshiro128_fill(s, 4, ref, n);
+		CHECKF(memcmp(dst, ref, n * 4) == 0 && memcmp(v4.s, s, sizeof v4.s) == 0, "n=%u", (unsigned) n);
+
+		xoshiro128x8_seed(&v8, test_rand());
+		memcpy(s, v8.s, sizeof v8.s);
+		xoshiro128x8_fill_u32(&v8, dst, n);
+		ref_xoshiro128_fill(s, 8, ref, n);
+		CHECKF(memcmp(dst, ref, n * 4) == 0 && memcmp(v8.s, s, sizeof v8.s) == 0, "n=%u", (unsigned) n);
+
+		xoshiro128x8_fill_f32(&v8, dstf, n);
+		ref_xoshiro128_fill(s, 8, ref, n);
+		for (i = 0; i < n; ++i)
+			CHECKF(dstf[i] == random_f32(ref[i]), "n=%u %u", (unsigned) n, (unsigned) i);
+
+		/* Values that would bias the result are dropped from the stream
+		   and the tail refilled; a bound just over 2^31 drops half. */
+		xoshiro128x8_fill_below(&v8, dst, n, bound);
+		if (bound == 0)
+			memset(kept, 0, n * 4);
+		else
+			for (j = 0; j < n; ) {
+				size_t m = n - j;
+				ref_xoshiro128_fill(s, 8, ref, m);
+				for (i = 0; i < m; ++i) {
+					u64 prod = (u64) ref[i] * bound;
+					if ((u32) prod >= (0 - bound) % bound)
+						kept[j++] = (u32) (prod >> 32);
+				}
+			}
+		CHECKF(memcmp(dst, kept, n * 4) == 0 && memcmp(v8.s, s, sizeof v8.s) == 0, "n=%u %#x", (unsigned) n, bound);
+		for (i = 0; i < n; ++i)
+			CHECKF(dst[i] < bound || bound == 0, "n=%u %u", (unsigned) n, dst[i]);
+	}
+}
+
+/*
+ * Sorting
+ */
+
+/* u32, s32, f32, u64, s64 and f64 keys, in the order of the sorts. */
+enum { TEST_SORT_TYPES = 6 };
+
+#define TEST_SORT_BIG (RADIX_SORT_GRAIN * 4 + 1001)
+
+struct ref_sort_item {
+	u64 key;
+	u32 index;
+};
+
+static int ref_sort_cmp(const void *a, const void *b) {
+	const struct ref_sort_item *x = (const struct ref_sort_item *) a, *y = (const struct ref_sort_item *) b;
+	if (x->key != y->key)
+		return x->key < y->key ? -1 : 1;
+	return x->index < y->index ? -1 : x->index > y->index;
+}
+
+/* The key as an unsigned integer in the order the sort should produce. */
+static u64 ref_sort_key(const u8 *keys, size_t i, int type) {
+	u32 k32;
+	u64 k64;
+	memcpy(&k32, keys + i * 4, 4);
+	memcpy(&k64, keys + i * 8, 8);
+	switch (type) {
+	case 0: return k32;
+	case 1: return k32 ^ 0x80000000;
+	case 2: return (u32) sgnflip_s32((s32) k32);
+	case 3: return k64;
+	case 4: return k64 ^ imm_u64(0x8000000000000000);
+	default: return (u64) sgnflip_s64((s64) k64);
+	}
+}
+
+/* Random bits, a narrow range with many repeats, one value throughout, and
+   edge values: zeros of both signs, infinities, NaNs and denormals for the
+   floats. */
+static void test_sort_keys(u8 *keys, size_t n, int type, int dist) {
+	static const u32 special32[] = { 0, 0x80000000, 0x7f800000, 0xff800000, 0x7fc00000, 0xffc00000, 1, 0x80000001 };
+	static const u64 special64[] = {
+		0, imm_u64(0x8000000000000000), imm_u64(0x7ff0000000000000), imm_u64(0xfff0000000000000),
+		imm_u64(0x7ff8000000000000), imm_u64(0xfff8000000000000), 1, imm_u64(0x8000000000000001),
+	};
+	u64 c = test_rand();
+	bool real = type == 2 || type == 5;
+	size_t i;
+	for (i = 0; i < n; ++i) {
+		u64 v;
+		f64 d = 0;
+		switch (dist) {
+		case 0: v = test_rand(); break;
+		case 1:
+			v = (u64) ((s64) test_below(1000) - 500);
+			d = (f64) (s64) v * .25;
+			break;
+		case 2: v = c; break;
+		default:
+			if (!real || test_below(4) == 0)
+				v = !real ? test_u64() : type == 2 ? special32[test_below(8)] : special64[test_below(8)];
+			else
+				v = 0, d = (f64) test_f32(1e6f) * 1e3;
+			break;
+		}
+		if (real && d != 0) {
+			f32 f = (f32) d;
+			u32 w;
+			memcpy(&w, &f, 4);
+			memcpy(&v, &d, 8);
+			if (type == 2)
+				v = w;
+		}
+		if (type < 3) {
+			u32 w = (u32) v;
+			memcpy(keys + i * 4, &w, 4);
+		} else
+			memcpy(keys + i * 8, &v, 8);
+	}
+}
+
+static bool test_sort_call(int type, u8 *keys, u32 *vals, u8 *tmp, u32 *tmpvals, size_t n, u32 threads) {
+	switch (type) {
+	case 0: return vals != NULL ? radix_sort_u32_pairs((u32 *) keys, vals, (u32 *) tmp, tmpvals, n, threads) : radix_sort_u32((u32 *) keys, (u32 *) tmp, n, threads);
+	case 1: return vals != NULL ? radix_sort_s32_pairs((s32 *) keys, vals, (s32 *) tmp, tmpvals, n, threads) : radix_sort_s32((s32 *) keys, (s32 *) tmp, n, threads);
+	case 2: return vals != NULL ? radix_sort_f32_pairs((f32 *) keys, vals, (f32 *) tmp, tmpvals, n, threads) : radix_sort_f32((f32 *) keys, (f32 *) tmp, n, threads);
+	case 3: return vals != NULL ? radix_sort_u64_pairs((u64 *) keys, vals, (u64 *) tmp, tmpvals, n, threads) : radix_sort_u64((u64 *) keys, (u64 *) tmp, n, threads);
+	case 4: return vals != NULL ? radix_sort_s64_pairs((s64 *) keys, vals, (s64 *) tmp, tmpvals, n, threads) : radix_sort_s64((s64 *) keys, (s64 *) tmp, n, threads);
+	default: return vals != NULL ? radix_sort_f64_pairs((f64 *) keys, vals, (f64 *) tmp, tmpvals, n, threads) : radix_sort_f64((f64 *) keys, (f64 *) tmp, n, threads);
+	}
+}
+
+/* Sorts a copy of orig and checks it against qsort on (key, index), which
+   is the stable order. */
+static void test_sort_one(const u8 *orig, size_t n, int type, int dist, bool pairs, bool scratch, u32 threads) {
+	static u64 keys[TEST_SORT_BIG], tmp[TEST_SORT_BIG];
+	static u32 vals[TEST_SORT_BIG], tmpvals[TEST_SORT_BIG];
+	static struct ref_sort_item ref[TEST_SORT_BIG];
+	size_t width = type < 3 ? 4 : 8, i, bad = n;
+	memcpy(keys, orig, n * width);
+	for (i = 0; i < n; ++i) {
+		vals[i] = (u32) i;
+		ref[i].key = ref_sort_key(orig, i, type);
+		ref[i].index = (u32) i;
+	}
+	qsort(ref, n, sizeof *ref, ref_sort_cmp);
+	if (!test_sort_call(type, (u8 *) keys, pairs ? vals : NULL, scratch ? (u8 *) tmp : NULL, scratch ? tmpvals : NULL, n, threads)) {
+		CHECK(!"radix_sort");
+		return;
+	}
+	for (i = 0; i < n && bad == n; ++i)
+		if (memcmp((const u8 *) keys + i * width, orig + ref[i].index * width, width) != 0 || (pairs && vals[i] != ref[i].index))
+			bad = i;
+	CHECKF(bad == n, "type=%d dist=%d n=%u pairs=%d threads=%u at %u", type, dist, (unsigned) n, pairs, threads, (unsigned) bad);
+}
+
+static void test_sort(void) {
+	static u64 orig[TEST_SORT_BIG];
+	size_t c;
+	int type, dist;
+	test_section = "sort";
+
+	for (type = 0; type < TEST_SORT_TYPES; ++type)
+		for (dist = 0; dist < 4; ++dist) {
+			for (c = 0; c < countof(test_counts); ++c) {
+				size_t n = test_counts[c];
+				test_sort_keys((u8 *) orig, n, type, dist);
+				test_sort_one((const u8 *) orig, n, type, dist, false, (c & 1) != 0, 1);
+				test_sort_one((const u8 *) orig, n, type, dist, true, (c & 1) == 0, 1);
+			}
+
+			/* Enough keys for four slices, and the same on one thread. */
+			if (dist != 2) {
+				test_sort_keys((u8 *) orig, TEST_SORT_BIG, type, dist);
+				test_sort_one((const u8 *) orig, TEST_SORT_BIG, type, dist, (dist & 1) != 0, true, 4);
+				test_sort_one((const u8 *) orig, TEST_SORT_BIG, type, dist, (dist & 1) == 0, false, type == 0 ? 1 : 100);
+			}
+		}
+}
+
+/*
+ * Hex and Base64
+ */
+
+static size_t ref_base64_encode(char *dst, const u8 *src, size_t size, u32 flags) {
+	const char *tail = (flags & BASE64_URL) != 0 ? "-_" : "+/";
+	size_t i, n = 0;
+	u32 bits = 0, acc = 0;
+	for (i = 0; i < size; ++i) {
+		acc = acc << 8 | src[i];
+		for (bits += 8; bits >= 6; bits -= 6) {
+			u32 v = acc >> (bits - 6) & 0x3f;
+			dst[n++] = (char) (v < 26 ? 'A' + v : v < 52 ? 'a' + v - 26 : v < 62 ? '0' + v - 52 : (u32) tail[v - 62]);
+		}
+	}
+	if (bits != 0) {
+		u32 v = acc << (6 - bits) & 0x3f;
+		dst[n++] = (char) (v < 26 ? 'A' + v : v < 52 ? 'a' + v - 26 : v < 62 ? '0' + v - 52 : (u32) tail[v - 62]);
+	}
+	while ((flags & BASE64_NOPAD) == 0 && n % 4 != 0)
+		dst[n++] = '=';
+	return n;
+}
+
+static void test_bytes(void) {
+	static const char *const rfc[7][2] = {
+		{ "", "" }, { "f", "Zg==" }, { "fo", "Zm8=" }, { "foo", "Zm9v" },
+		{ "foob", "Zm9vYg==" }, { "fooba", "Zm9vYmE=" }, { "foobar", "Zm9vYmFy" },
+	};
+	static const char *const bad[] = {
+		"Zg", "Zg=", "Zg===", "Z===", "Zh==", "Zm9=", "Zm8=Zm8=", "=Zm8", "Zm 9v", "Zm9v\n",
+	};
+	static u8 src[TEST_ARRAY + 1], dst[TEST_ARRAY + 1];
+	static char text[TEST_ARRAY * 2 + 8], ref[TEST_ARRAY * 2 + 8];
+	size_t c, i, k, n;
+	u32 flags;
+	test_section = "bytes";
+
+	for (i = 0; i < 7; ++i) {
+		size_t size = strlen(rfc[i][0]), len = strlen(rfc[i][1]);
+		CHECKF(base64_encode(text, rfc[i][0], size, 0) == len && memcmp(text, rfc[i][1], len) == 0, "%s", rfc[i][0]);
+		CHECKF(base64_decode(dst, rfc[i][1], len, 0) == size && memcmp(dst, rfc[i][0], size) == 0, "%s", rfc[i][1]);
+		CHECK(base64_encoded_size(size, 0) == len && base64_decoded_size(rfc[i][1], len) == size);
+	}
+	for (i = 0; i < countof(bad); ++i)
+		CHECKF(base64_decode(dst, bad[i], strlen(bad[i]), 0) == BYTES_ERROR, "%s", bad[i]);
+	CHECK(base64_decode(dst, "Zg", 2, BASE64_NOPAD) == 1 && dst[0] == 'f');
+	CHECK(base64_decode(dst, "Zg==", 4, BASE64_NOPAD) == BYTES_ERROR);
+	CHECK(base64_decode(dst, "Zm9vY", 5, BASE64_NOPAD) == BYTES_ERROR);
+	CHECK(base64_decode(dst, "-_8=", 4, BASE64_URL) == 2 && dst[0] == 0xfb && dst[1] == 0xff);
+	CHECK(base64_decode(dst, "+/8=", 4, BASE64_URL) == BYTES_ERROR && base64_decode(dst, "-_8=", 4, 0) == BYTES_ERROR);
+
+	CHECK(hex_encode(text, "\x01\xab\xff", 3, false) == 6 && memcmp(text, "01abff", 6) == 0);
+	CHECK(hex_encode(text, "\x01\xab\xff", 3, true) == 6 && memcmp(text, "01ABFF", 6) == 0);
+	CHECK(hex_decode(dst, "01aBfF", 6) == 3 && memcmp(dst, "\x01\xab\xff", 3) == 0);
+	CHECK(hex_decode(dst, "01a", 3) == BYTES_ERROR && hex_decode(dst, "0g", 2) == BYTES_ERROR);
+
+	for (c = 0; c < countof(test_counts); ++c) {
+		n = test_counts[c];
+		test_fill(src, n);
+
+		/* Hex in both cases, decoded with the cases mixed, and with one bad
+		   character anywhere. */
+		for (i = 0; i < n; ++i)
+			snprintf(ref + i * 2, 3, "%02X", src[i]);
+		CHECKF(hex_encode(text, src, n, true) == n * 2 && memcmp(text, ref, n * 2) == 0, "n=%u", (unsigned) n);
+		for (i = 0; i < n; ++i)
+			snprintf(ref + i * 2, 3, "%02x", src[i]);
+		CHECKF(hex_encode(text, src, n, false) == n * 2 && memcmp(text, ref, n * 2) == 0, "n=%u", (unsigned) n);
+		for (i = 0; i < n * 2; i += 3)
+			ref[i] = (char) (ref[i] >= 'a' ? ref[i] - 32 : ref[i]);
+		CHECKF(hex_decode(dst, ref, n * 2) == n && memcmp(dst, src, n) == 0, "n=%u", (unsigned) n);
+		if (n != 0) {
+			static const char nondigits[] = "/:@G`g\x80\xff ";
+			k = test_below((u32) n * 2);
+			ref[k] = nondigits[test_below(sizeof nondigits - 1)];
+			CHECKF(hex_decode(dst, ref, n * 2) == BYTES_ERROR, "n=%u at %u", (unsigned) n, (unsigned) k);
+		}
+
+		for (flags = 0; flags < 4; ++flags) {
+			size_t len = ref_base64_encode(ref, src, n, flags);
+			memset(text, 0, len + 1);
+			CHECKF(base64_encode(text, src, n, flags) == len && base64_encoded_size(n, flags) == len, "n=%u flags=%u", (unsigned) n, flags);
+			CHECKF(memcmp(text, ref, len) == 0 && text[len] == 0, "n=%u flags=%u", (unsigned) n, flags);
+			CHECKF(base64_decoded_size(text, len) == n, "n=%u flags=%u", (unsigned) n, flags);
+			dst[n] = 0x5a;
+			CHECKF(base64_decode(dst, text, len, flags) == n && memcmp(dst, src, n) == 0 && dst[n] == 0x5a, "n=%u flags=%u", (unsigned) n, flags);
+
+			/* A character outside the alphabet at every position, and one
+			   from the other alphabet. */
+			for (k = 0; k < len; k += n < 100 ? 1 : 1 + test_below(50)) {
+				char save = text[k];
+				text[k] = (char) "!.*\0\x7f\x80\xc0\xff"[k % 8];
+				CHECKF(base64_decode(dst, text, len, flags) == BYTES_ERROR, "n=%u flags=%u at %u", (unsigned) n, flags, (unsigned) k);
+				text[k] = (flags & BASE64_URL) != 0 ? (k & 1 ? '+' : '/') : (k & 1 ? '-' : '_');
+				CHECKF(base64_decode(dst, text, len, flags) == BYTES_ERROR, "n=%u flags=%u at %u", (unsigned) n, flags, (unsigned) k);
+				text[k] = save;
+			}
+
+			/* The other padding convention, and stray bits past the end. */
+			if (n % 3 != 0) {
+				CHECKF(base64_decode(dst, text, len, flags ^ BASE64_NOPAD) == BYTES_ERROR, "n=%u flags=%u", (unsigned) n, flags);
+				k = n / 3 * 4 + n % 3;
+				++text[k];
+				CHECKF(base64_decode(dst, text, len, flags) == BYTES_ERROR, "n=%u flags=%u", (unsigned) n, flags);
+				--text[k];
+			}
+		}
+	}
+}
+
+int main(int argc, char *argv[]) {
+	if (argc > 1)
+		test_seed = strtoull(argv[1], NULL, 0);
+
+	test_page_init();
+
+	test_arith_select();
+	test_arith_bits();
+	test_arith_round();
+	test_arith_fixed();
+	test_arith_div();
+#if defined(_have_simd_ops)
+	test_simd();
+#endif
+	test_approx();
+	test_bitset();
+	test_endian();
+	test_bytestream();
+	test_bitstream();
+	test_strings_compare();
+	test_strings_search();
+	test_strings_view();
+	test_strings_buf();
+	test_strings_intern();
+	test_checksum();
+	test_hash();
+	test_utf();
+	test_format();
+	test_parse();
+	test_varint();
+	test_random();
+	test_sort();
+	test_bytes();
+
+	printf("aw-test: cpu %08x, %lu checks, %lu failed\n", cpu_features(), test_checks, test_failures);
+	return test_failures != 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}